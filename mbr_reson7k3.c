@@ -36,6 +36,7 @@
 #include "mb_format.h"
 #include "mb_io.h"
 #include "mb_define.h"
+#include "mb_process.h"
 #include "mbsys_reson7k3.h"
 
 /* include for byte swapping */
@@ -46,6 +47,55 @@
 //#define MBR_RESON7KR_DEBUG2 1
 //#define MBR_RESON7KR_DEBUG3 1
 
+/* parallel encoding of the records of each ping and the ordered write
+    queue on output are built unless turned off here */
+//#define MBR_RESON7KR_NO_PTHREADS 1
+#ifndef MBR_RESON7KR_NO_PTHREADS
+#define MBR_RESON7KR_PTHREADS 1
+#endif
+#ifdef MBR_RESON7KR_PTHREADS
+#include <pthread.h>
+
+/* work shared by the threads encoding the records of one ping */
+struct mbr_reson7kr_encodework_struct {
+	int verbose;
+	void *store_ptr;
+	s7k_encodeping *encodeping;
+	int next;
+	pthread_mutex_t mutex;
+};
+void *mbr_reson7kr_wr_encodethread(void *work_ptr);
+
+/* ordered write queue - pings written wait in a ring of nslot slots while
+    a pool of nthreads threads encodes them, and are written to the file in
+    order by the calling thread. A ping is only queued once its buffers are
+    sized, so the encoders never allocate, and the caller waits for the
+    oldest ping to be written when every slot is taken */
+#define MBR_RESON7KR_WRITESLOT_EMPTY 0
+#define MBR_RESON7KR_WRITESLOT_QUEUED 1
+#define MBR_RESON7KR_WRITESLOT_ENCODING 2
+#define MBR_RESON7KR_WRITESLOT_ENCODED 3
+struct mbr_reson7kr_writequeue_struct {
+	int verbose;
+	int nslot;
+	int nthreads;
+	void *slot_store[MBSYS_RESON7K_WRITEQUEUE_MAX];
+	s7k_encodeping slot_encodeping[MBSYS_RESON7K_WRITEQUEUE_MAX];
+	int slot_state[MBSYS_RESON7K_WRITEQUEUE_MAX];
+	int head;
+	int count;
+	int stop;
+	pthread_t threads[MBSYS_RESON7K_WRITEQUEUE_MAX];
+	pthread_mutex_t mutex;
+	pthread_cond_t queued;
+	pthread_cond_t encoded;
+};
+void *mbr_reson7kr_wr_queuethread(void *queue_ptr);
+int mbr_reson7kr_wr_queueping(int verbose, void *mbio_ptr, void *store_ptr, int *error);
+int mbr_reson7kr_wr_queuecommit(int verbose, void *mbio_ptr, int nkeep, int wait, int *error);
+int mbr_reson7kr_wr_queuefree(int verbose, void *mbio_ptr, int *error);
+#endif
+
 /* essential function prototypes */
 int mbr_register_reson7kr(int verbose, void *mbio_ptr, int *error);
 int mbr_info_reson7kr(int verbose, int *system, int *beams_bath_max, int *beams_amp_max, int *pixels_ss_max, char *format_name,
@@ -113,6 +163,7 @@ int mbr_reson7kr_rd_v2detection(int verbose, char *buffer, void *store_ptr, int
 int mbr_reson7kr_rd_v2rawdetection(int verbose, char *buffer, void *store_ptr, int *error);
 int mbr_reson7kr_rd_v2snippet(int verbose, char *buffer, void *store_ptr, int *error);
 int mbr_reson7kr_rd_calibratedsnippet(int verbose, char *buffer, void *store_ptr, int *error);
+int mbr_reson7kr_rd_compressedwatercolumn(int verbose, char *buffer, void *store_ptr, int *error);
 int mbr_reson7kr_rd_installation(int verbose, char *buffer, void *store_ptr, int *error);
 int mbr_reson7kr_rd_systemeventmessage(int verbose, char *buffer, void *store_ptr, int *error);
 int mbr_reson7kr_rd_fileheader(int verbose, char *buffer, void *store_ptr, int *error);
@@ -124,7 +175,19 @@ int mbr_reson7kr_rd_soundvelocity(int verbose, char *buffer, void *store_ptr, in
 int mbr_reson7kr_rd_absorptionloss(int verbose, char *buffer, void *store_ptr, int *error);
 int mbr_reson7kr_rd_spreadingloss(int verbose, char *buffer, void *store_ptr, int *error);
 
+int mbr_reson7kr_scan_ancillary(int verbose, void *mbio_ptr, void *preprocess_pars_ptr, int *nrecord, int *error);
+int mbr_reson7kr_scan_grow(int verbose, int n, int *nalloc, double **array0, double **array1, double **array2,
+                           double **array3, double **array4, int *error);
+int mbr_reson7kr_rd_fileindex(int verbose, void *mbio_ptr, int *error);
+int mbr_reson7kr_seek_record(int verbose, void *mbio_ptr, int irecord, int *error);
+int mbr_reson7kr_find_time(s7k_fileindex *fileindex, double time_d);
+int mbr_reson7kr_seek_time(int verbose, void *mbio_ptr, double time_d, int *error);
+int mbr_reson7kr_open_window(int verbose, void *mbio_ptr, double time_start, double time_end, int *error);
+
 int mbr_reson7kr_wr_data(int verbose, void *mbio_ptr, void *store_ptr, int *error);
+int mbr_reson7kr_wr_rawrecord(int verbose, void *mbio_ptr, void *store_ptr, int recordid, int *written, int *error);
+int mbr_reson7kr_wr_putrecord(int verbose, void *mbio_ptr, char *buffer, size_t *write_len, int *error);
+int mbr_reson7kr_wr_filecatalog(int verbose, void *mbio_ptr, int *error);
 int mbr_reson7kr_wr_header(int verbose, char *buffer, int *index, s7k_header *header, int *error);
 
 int mbr_reson7kr_wr_reference(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error);
@@ -170,6 +233,18 @@ int mbr_reson7kr_wr_image(int verbose, int *bufferalloc, char **bufferptr, void
 int mbr_reson7kr_wr_v2pingmotion(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error);
 int mbr_reson7kr_wr_v2detectionsetup(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error);
 int mbr_reson7kr_wr_v2beamformed(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error);
+int mbr_reson7kr_wr_compressedwatercolumn(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, unsigned int flags,
+                                          int nbottom, int *bottom, int nsample, unsigned short *magnitude, short *phasesample,
+                                          int *size, int *error);
+int mbr_reson7kr_wr_compressedbottom(int verbose, void *store_ptr, unsigned int flags, int nbottom, int *bottom, int *size,
+                                     int *ncompressedmax, int *error);
+int mbr_reson7kr_wr_dbtable(int verbose, int *error);
+int mbr_reson7kr_wr_sizeping(int verbose, void *store_ptr, void *ostore_ptr, s7k_encodeping *encodeping, int *error);
+int mbr_reson7kr_wr_recordsize(int verbose, void *store_ptr, int recordid, int *size, int *error);
+int mbr_reson7kr_wr_encodeping(int verbose, void *store_ptr, s7k_encodeping *encodeping, int nthreads, int *error);
+int mbr_reson7kr_wr_encoderecord(int verbose, void *store_ptr, s7k_encodeping *encodeping, s7k_encodebuffer *encodebuffer,
+                                 int *error);
+int mbr_reson7kr_wr_commitping(int verbose, void *mbio_ptr, void *store_ptr, s7k_encodeping *encodeping, int *error);
 int mbr_reson7kr_wr_v2bite(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error);
 int mbr_reson7kr_wr_v27kcenterversion(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error);
 int mbr_reson7kr_wr_v28kwetendversion(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error);
@@ -191,6 +266,15 @@ int mbr_reson7kr_wr_spreadingloss(int verbose, int *bufferalloc, char **bufferpt
 
 static char rcs_id[] = "$Id: mbr_reson7kr.c 2335 2018-05-06 23:24:33Z caress $";
 
+/* 16 bit magnitude to 8 bit dB conversion used for 7042 output - built
+   once when the format is registered so that the encoders only read it */
+static mb_u_char mbr_reson7kr_dbtable[65536];
+static int mbr_reson7kr_dbtable_set = MB_NO;
+#ifdef MBR_RESON7KR_PTHREADS
+static pthread_once_t mbr_reson7kr_dbtable_once = PTHREAD_ONCE_INIT;
+#endif
+void mbr_reson7kr_dbtable_init(void);
+
 /*--------------------------------------------------------------------*/
 int mbr_register_reson7kr(int verbose, void *mbio_ptr, int *error) {
 	char *function_name = "mbr_register_reson7kr";
@@ -208,6 +292,9 @@ int mbr_register_reson7kr(int verbose, void *mbio_ptr, int *error) {
 	/* get mb_io_ptr */
 	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
 
+	/* build the 7042 dB conversion table */
+	status = mbr_reson7kr_wr_dbtable(verbose, error);
+
 	/* set format info parameters */
 	status = mbr_info_reson7kr(
 	    verbose, &mb_io_ptr->system, &mb_io_ptr->beams_bath_max, &mb_io_ptr->beams_amp_max, &mb_io_ptr->pixels_ss_max,
@@ -501,6 +588,14 @@ int mbr_dem_reson7kr(int verbose, void *mbio_ptr, int *error) {
 	/* get pointers to mbio descriptor */
 	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
 
+#ifdef MBR_RESON7KR_PTHREADS
+	/* write out the pings still in the write queue and stop its encoders */
+	status = mbr_reson7kr_wr_queuefree(verbose, mbio_ptr, error);
+#endif
+
+	/* if records have been written append the file catalog */
+	status = mbr_reson7kr_wr_filecatalog(verbose, mbio_ptr, error);
+
 	/* deallocate memory for data descriptor */
 	status = mbsys_reson7k_deall(verbose, mbio_ptr, &mb_io_ptr->store_data, error);
 
@@ -534,12 +629,9 @@ int mbr_rt_reson7kr(int verbose, void *mbio_ptr, void *store_ptr, int *error) {
 	int interp_error = MB_ERROR_NO_ERROR;
 	struct mb_io_struct *mb_io_ptr;
 	struct mbsys_reson7k_struct *store;
+	struct mbsys_reson7k_struct *ostore;
 	s7kr_position *position;
 	s7kr_navigation *navigation;
-	s7kr_attitude *attitude;
-	s7kr_heading *dheading;
-	s7kr_rollpitchheave *rollpitchheave;
-	s7kr_customattitude *customattitude;
 	s7kr_altitude *altitude;
 	s7kr_depth *depth;
 	s7kr_volatilesettings *volatilesettings;
@@ -557,6 +649,7 @@ int mbr_rt_reson7kr(int verbose, void *mbio_ptr, void *store_ptr, int *error) {
 	int ss_source;
 	double speed, heading, longitude, latitude;
 	double roll, pitch, heave;
+	double attitude[MBSYS_RESON7K_TSERIES_FIELDS];
 	double sonar_depth, sonar_altitude;
 	double soundspeed, alpha, beta, theta, phi;
 	double rr, xx, zz;
@@ -576,13 +669,22 @@ int mbr_rt_reson7kr(int verbose, void *mbio_ptr, void *store_ptr, int *error) {
 	/* get pointers to mbio descriptor */
 	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
 
-	/* read next data from file */
+	/* read next data from file - within a time window the pings before its
+	    start are skipped, and the first ping after its end ends the file */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+	ostore = (struct mbsys_reson7k_struct *)mb_io_ptr->store_data;
 	status = mbr_reson7kr_rd_data(verbose, mbio_ptr, store_ptr, error);
+	while (status == MB_SUCCESS && ostore->window == MB_YES && store->kind == MB_DATA_DATA &&
+	       store->time_d < ostore->window_start)
+		status = mbr_reson7kr_rd_data(verbose, mbio_ptr, store_ptr, error);
+	if (status == MB_SUCCESS && ostore->window == MB_YES && store->kind == MB_DATA_DATA && store->time_d > ostore->window_end) {
+		status = MB_FAILURE;
+		*error = MB_ERROR_EOF;
+	}
 
 	/* get pointers to data structures */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
 	position = &store->position;
-	attitude = &store->attitude;
 	volatilesettings = &store->volatilesettings;
 	beamgeometry = &store->beamgeometry;
 	bathymetry = &store->bathymetry;
@@ -610,6 +712,8 @@ int mbr_rt_reson7kr(int verbose, void *mbio_ptr, void *store_ptr, int *error) {
 		position = &(store->position);
 		mb_navint_add(verbose, mbio_ptr, store->time_d, (double)(RTD * position->longitude), (double)(RTD * position->latitude),
 		              error);
+		mbsys_reson7k_tseries_add(verbose, mbio_ptr, MBSYS_RESON7K_TSERIES_NAV, store->time_d,
+		                          (double)(RTD * position->longitude), (double)(RTD * position->latitude), 0.0, error);
 	}
 
 	/* save nav and attitude if bluefin data */
@@ -624,16 +728,30 @@ int mbr_rt_reson7kr(int verbose, void *mbio_ptr, void *store_ptr, int *error) {
 			mb_attint_add(verbose, mbio_ptr, (double)(bluefin->nav[i].position_time), (double)(0.0),
 			              (double)(RTD * bluefin->nav[i].roll), (double)(RTD * bluefin->nav[i].pitch), error);
 			mb_hedint_add(verbose, mbio_ptr, (double)(bluefin->nav[i].position_time), (double)(RTD * bluefin->nav[i].yaw), error);
+			mbsys_reson7k_tseries_add(verbose, mbio_ptr, MBSYS_RESON7K_TSERIES_NAV, (double)(bluefin->nav[i].position_time),
+			                          (double)(RTD * bluefin->nav[i].longitude), (double)(RTD * bluefin->nav[i].latitude), 0.0,
+			                          error);
+			mbsys_reson7k_tseries_add(verbose, mbio_ptr, MBSYS_RESON7K_TSERIES_ATTITUDE,
+			                          (double)(bluefin->nav[i].position_time), (double)(RTD * bluefin->nav[i].roll),
+			                          (double)(RTD * bluefin->nav[i].pitch), (double)(0.0), error);
+			mbsys_reson7k_tseries_add(verbose, mbio_ptr, MBSYS_RESON7K_TSERIES_HEADING, (double)(bluefin->nav[i].position_time),
+			                          (double)(RTD * bluefin->nav[i].yaw), 0.0, 0.0, error);
 			if (mb_io_ptr->nsonardepth == 0 ||
 			    (bluefin->nav[i].depth != mb_io_ptr->sonardepth_sonardepth[mb_io_ptr->nsonardepth - 1])) {
 				if (bluefin->nav[i].depth_time <= 0.0)
 					bluefin->nav[i].depth_time = bluefin->nav[i].position_time;
 				mb_depint_add(verbose, mbio_ptr, (double)(bluefin->nav[i].depth_time), (double)(bluefin->nav[i].depth), error);
+				mbsys_reson7k_tseries_add(verbose, mbio_ptr, MBSYS_RESON7K_TSERIES_SONARDEPTH,
+				                          (double)(bluefin->nav[i].depth_time), (double)(bluefin->nav[i].depth), 0.0, 0.0,
+				                          error);
 			}
 			if (bluefin->nav[i].altitude > 0.0 && bluefin->nav[i].altitude < 250.0 &&
 			    (i == 0 || bluefin->nav[i].altitude != bluefin->nav[i - 1].altitude)) {
 				mb_altint_add(verbose, mbio_ptr, (double)(bluefin->nav[i].position_time), (double)(bluefin->nav[i].altitude),
 				              error);
+				mbsys_reson7k_tseries_add(verbose, mbio_ptr, MBSYS_RESON7K_TSERIES_ALTITUDE,
+				                          (double)(bluefin->nav[i].position_time), (double)(bluefin->nav[i].altitude), 0.0,
+				                          0.0, error);
 			}
 		}
 	}
@@ -645,56 +763,17 @@ int mbr_rt_reson7kr(int verbose, void *mbio_ptr, void *store_ptr, int *error) {
 		mb_navint_add(verbose, mbio_ptr, store->time_d, (double)(RTD * navigation->longitude),
 		              (double)(RTD * navigation->latitude), error);
 		mb_hedint_add(verbose, mbio_ptr, store->time_d, (double)(RTD * navigation->heading), error);
+		mbsys_reson7k_tseries_add(verbose, mbio_ptr, MBSYS_RESON7K_TSERIES_NAV, store->time_d,
+		                          (double)(RTD * navigation->longitude), (double)(RTD * navigation->latitude),
+		                          (double)(3.6 * navigation->speed), error);
+		mbsys_reson7k_tseries_add(verbose, mbio_ptr, MBSYS_RESON7K_TSERIES_HEADING, store->time_d,
+		                          (double)(RTD * navigation->heading), 0.0, 0.0, error);
 	}
 
-	/* save attitude if attitude record */
-	if (status == MB_SUCCESS && store->kind == MB_DATA_ATTITUDE && store->type == R7KRECID_Attitude) {
-		/* get attitude structure */
-		attitude = &(store->attitude);
-
-		/* add latest attitude samples */
-		for (i = 0; i < attitude->n; i++) {
-			mb_attint_add(verbose, mbio_ptr, (double)(store->time_d + 0.001 * ((double)attitude->delta_time[i])),
-			              (double)(attitude->heave[i]), (double)(RTD * attitude->roll[i]), (double)(RTD * attitude->pitch[i]),
-			              error);
-			mb_hedint_add(verbose, mbio_ptr, (double)(store->time_d + 0.001 * ((double)attitude->delta_time[i])),
-			              (double)(RTD * attitude->heading[i]), error);
-		}
-	}
-
-	/* else save attitude if rollpitchheave record */
-	else if (status == MB_SUCCESS && store->kind == MB_DATA_ATTITUDE && store->type == R7KRECID_RollPitchHeave) {
-		/* get attitude structure */
-		rollpitchheave = &(store->rollpitchheave);
-
-		/* add latest attitude samples */
-		mb_attint_add(verbose, mbio_ptr, (double)(store->time_d), (double)(rollpitchheave->heave),
-		              (double)(RTD * rollpitchheave->roll), (double)(RTD * rollpitchheave->pitch), error);
-	}
-
-	/* else save attitude if customattitude record */
-	else if (status == MB_SUCCESS && store->kind == MB_DATA_ATTITUDE && store->type == R7KRECID_CustomAttitude) {
-		/* get attitude structure */
-		customattitude = &(store->customattitude);
-
-		/* add latest attitude samples */
-		for (i = 0; i < customattitude->n; i++) {
-			mb_attint_add(verbose, mbio_ptr, (double)(store->time_d + ((double)i) / ((double)customattitude->frequency)),
-			              (double)(customattitude->heave[i]), (double)(RTD * customattitude->roll[i]),
-			              (double)(RTD * customattitude->pitch[i]), error);
-			mb_hedint_add(verbose, mbio_ptr, (double)(store->time_d + ((double)i) / ((double)customattitude->frequency)),
-			              (double)(RTD * customattitude->heading[i]), error);
-		}
-	}
-
-	/* save heading if heading record */
-	if (status == MB_SUCCESS && store->kind == MB_DATA_HEADING && store->type == R7KRECID_Heading) {
-		/* get attitude structure */
-		dheading = &(store->heading);
-
-		/* add latest heading sample */
-		mb_hedint_add(verbose, mbio_ptr, (double)(store->time_d), (double)(RTD * dheading->heading), error);
-	}
+	/* save attitude and heading if attitude or heading record - the whole
+	    series of the record is appended to the interpolation buffers at once */
+	if (status == MB_SUCCESS && (store->kind == MB_DATA_ATTITUDE || store->kind == MB_DATA_HEADING))
+		status = mbsys_reson7k_attitude_append_record(verbose, mbio_ptr, store_ptr, error);
 
 	/* save altitude if altitude record */
 	if (status == MB_SUCCESS && store->kind == MB_DATA_ALTITUDE && store->type == R7KRECID_Altitude) {
@@ -703,6 +782,8 @@ int mbr_rt_reson7kr(int verbose, void *mbio_ptr, void *store_ptr, int *error) {
 
 		/* add latest altitude sample */
 		mb_altint_add(verbose, mbio_ptr, (double)(store->time_d), (double)(altitude->altitude), error);
+		mbsys_reson7k_tseries_add(verbose, mbio_ptr, MBSYS_RESON7K_TSERIES_ALTITUDE, (double)(store->time_d),
+		                          (double)(altitude->altitude), 0.0, 0.0, error);
 	}
 
 	/* save sonardepth if depth record */
@@ -711,8 +792,11 @@ int mbr_rt_reson7kr(int verbose, void *mbio_ptr, void *store_ptr, int *error) {
 		depth = &(store->depth);
 
 		/* add latest depth sample if sensor depth, not water depth */
-		if (depth->descriptor == 0 && depth->depth != 0.0)
+		if (depth->descriptor == 0 && depth->depth != 0.0) {
 			mb_depint_add(verbose, mbio_ptr, (double)(store->time_d), (double)(depth->depth), error);
+			mbsys_reson7k_tseries_add(verbose, mbio_ptr, MBSYS_RESON7K_TSERIES_SONARDEPTH, (double)(store->time_d),
+			                          (double)(depth->depth), 0.0, 0.0, error);
+		}
 	}
 
 #ifdef MBR_RESON7KR_DEBUG2
@@ -744,19 +828,30 @@ int mbr_rt_reson7kr(int verbose, void *mbio_ptr, void *store_ptr, int *error) {
 
 #ifdef MBR_RESON7KR_DEBUG
 	if (status == MB_SUCCESS && store->kind == MB_DATA_DATA)
-		fprintf(stderr, "\nPING: store->read_bathymetry:%d ping_number:%d\n\n", store->read_bathymetry,
+		fprintf(stderr, "\nPING: store->read_mask:0x%5.5x ping_number:%d\n\n", store->read_mask,
 		        v2rawdetection->ping_number);
 #endif
 
+	/* the bathymetry and beam geometry may be completed below, so they must
+	    not be shared with copies of this store made from an earlier ping */
+	if (status == MB_SUCCESS && store->kind == MB_DATA_DATA) {
+		status = mbsys_reson7k_unshare_payload(verbose, store_ptr, R7KSHARE_Bathymetry, MB_YES, error);
+		if (status == MB_SUCCESS)
+			status = mbsys_reson7k_unshare_payload(verbose, store_ptr, R7KSHARE_BeamGeometry, MB_YES, error);
+	}
+
 	/* calculate bathymetry if only raw detects are available */
-	if (status == MB_SUCCESS && store->kind == MB_DATA_DATA && store->read_bathymetry == MB_NO &&
-	    store->read_v2rawdetection == MB_YES) {
+	if (status == MB_SUCCESS && store->kind == MB_DATA_DATA && !(store->read_mask & R7KREAD_Bathymetry) &&
+	    (store->read_mask & R7KREAD_V2RawDetection)) {
 		bathymetry->header = v2rawdetection->header;
 		bathymetry->header.RecordType = R7KRECID_7kBathymetricData;
 		bathymetry->serial_number = v2rawdetection->serial_number;
 		bathymetry->ping_number = v2rawdetection->ping_number;
 		bathymetry->multi_ping = v2rawdetection->multi_ping;
-		bathymetry->number_beams = v2rawdetection->beam_descriptor[v2rawdetection->number_beams-1] + 1;
+		bathymetry->number_beams = 0;
+		for (i = 0; i < v2rawdetection->number_beams; i++)
+			bathymetry->number_beams = MAX(bathymetry->number_beams, v2rawdetection->beam_descriptor[i] + 1);
+		status = mbsys_reson7k_alloc_bathymetry(verbose, bathymetry, bathymetry->number_beams, error);
 		bathymetry->layer_comp_flag = 0;
 		bathymetry->sound_vel_flag = 0;
 		if (volatilesettings->sound_velocity > 0.0)
@@ -766,18 +861,19 @@ int mbr_rt_reson7kr(int verbose, void *mbio_ptr, void *store_ptr, int *error) {
 		else
 			bathymetry->sound_velocity = 1500.0;
 		bathymetry->optionaldata = MB_NO;
-		store->read_bathymetry = MB_YES;
+		store->read_mask |= R7KREAD_Bathymetry;
 	}
 
 	/* else calculate bathymetry if only detects are available */
-	else if (status == MB_SUCCESS && store->kind == MB_DATA_DATA && store->read_bathymetry == MB_NO &&
-	         store->read_v2detection == MB_YES) {
+	else if (status == MB_SUCCESS && store->kind == MB_DATA_DATA && !(store->read_mask & R7KREAD_Bathymetry) &&
+	         (store->read_mask & R7KREAD_V2Detection)) {
 		bathymetry->header = v2detection->header;
 		bathymetry->header.RecordType = R7KRECID_7kBathymetricData;
 		bathymetry->serial_number = v2detection->serial_number;
 		bathymetry->ping_number = v2detection->ping_number;
 		bathymetry->multi_ping = v2detection->multi_ping;
 		bathymetry->number_beams = v2detection->number_beams;
+		status = mbsys_reson7k_alloc_bathymetry(verbose, bathymetry, bathymetry->number_beams, error);
 		bathymetry->layer_comp_flag = 0;
 		bathymetry->sound_vel_flag = 0;
 		if (volatilesettings->sound_velocity > 0.0)
@@ -787,23 +883,39 @@ int mbr_rt_reson7kr(int verbose, void *mbio_ptr, void *store_ptr, int *error) {
 		else
 			bathymetry->sound_velocity = 1500.0;
 		bathymetry->optionaldata = MB_NO;
-		store->read_bathymetry = MB_YES;
+		store->read_mask |= R7KREAD_Bathymetry;
+	}
+
+	/* the beam geometry must cover every beam of the bathymetry, and the
+	    mbio beam arrays must be large enough for pings with more beams
+	    than the nominal maximum */
+	if (status == MB_SUCCESS && store->kind == MB_DATA_DATA) {
+		status = mbsys_reson7k_alloc_beamgeometry(verbose, beamgeometry, bathymetry->number_beams, error);
+		if (bathymetry->number_beams > mb_io_ptr->beams_bath_max) {
+			mb_io_ptr->beams_bath_max = bathymetry->number_beams;
+			mb_io_ptr->beams_amp_max = bathymetry->number_beams;
+		}
 	}
 
 	/* get optional values in bathymetry record if needed */
 	if (status == MB_SUCCESS && store->kind == MB_DATA_DATA && bathymetry->optionaldata == MB_NO) {
+		/* the bathymetry record no longer matches the bytes read */
+		mbsys_reson7k_rawrecord_modified(verbose, store_ptr, R7KRECID_7kBathymetricData, error);
+
 		/* get navigation */
 		speed = 0.0;
 		longitude = 0.0;
 		latitude = 0.0;
 		heading = 0.0;
 		sonar_depth = 0.0;
-		interp_status = mb_hedint_interp(verbose, mbio_ptr, store->time_d, &heading, &interp_error);
+		interp_status = mbsys_reson7k_tseries_interp(verbose, &(ostore->tseries[MBSYS_RESON7K_TSERIES_HEADING]), store->time_d,
+		                                             &heading, &interp_error);
 		if (interp_status == MB_SUCCESS)
-			interp_status =
-			    mb_navint_interp(verbose, mbio_ptr, store->time_d, heading, speed, &longitude, &latitude, &speed, &interp_error);
+			interp_status = mbsys_reson7k_tseries_nav(verbose, &(ostore->tseries[MBSYS_RESON7K_TSERIES_NAV]), store->time_d,
+			                                          heading, speed, &longitude, &latitude, &speed, &interp_error);
 		if (interp_status == MB_SUCCESS)
-			interp_status = mb_depint_interp(verbose, mbio_ptr, store->time_d, &sonar_depth, &interp_error);
+			interp_status = mbsys_reson7k_tseries_interp(verbose, &(ostore->tseries[MBSYS_RESON7K_TSERIES_SONARDEPTH]),
+			                                             store->time_d, &sonar_depth, &interp_error);
 
 		/* if the optional data are not all available, this ping
 		    is not useful. Just use null values here and catch
@@ -817,20 +929,27 @@ int mbr_rt_reson7kr(int verbose, void *mbio_ptr, void *store_ptr, int *error) {
 		    } */
 
 		/* get altitude */
-		interp_status = mb_altint_interp(verbose, mbio_ptr, store->time_d, &sonar_altitude, &interp_error);
+		interp_status = mbsys_reson7k_tseries_interp(verbose, &(ostore->tseries[MBSYS_RESON7K_TSERIES_ALTITUDE]), store->time_d,
+		                                             &sonar_altitude, &interp_error);
 		if (interp_status == MB_FAILURE) {
 			/* set altitude data to zero */
 			sonar_altitude = 0.0;
 		}
 
 		/* get attitude */
-		interp_status = mb_attint_interp(verbose, mbio_ptr, store->time_d, &heave, &roll, &pitch, &interp_error);
+		interp_status = mbsys_reson7k_tseries_interp(verbose, &(ostore->tseries[MBSYS_RESON7K_TSERIES_ATTITUDE]), store->time_d,
+		                                             attitude, &interp_error);
 		if (interp_status == MB_FAILURE) {
 			/* set nav & attitude data to zero */
 			roll = 0.0;
 			pitch = 0.0;
 			heave = 0.0;
 		}
+		else {
+			roll = attitude[0];
+			pitch = attitude[1];
+			heave = attitude[2];
+		}
 
 		/* calculate the optional values in the bathymetry record */
 		bathymetry->longitude = DTR * longitude;
@@ -856,7 +975,7 @@ int mbr_rt_reson7kr(int verbose, void *mbio_ptr, void *store_ptr, int *error) {
 		   cases that must be handled */
 
 		/* case of v2rawdetection record */
-		if (store->read_v2rawdetection == MB_YES) {
+		if (store->read_mask & R7KREAD_V2RawDetection) {
 			/* initialize all of the beams */
 			for (i = 0; i < bathymetry->number_beams; i++) {
 				bathymetry->quality[i] = 0;
@@ -891,7 +1010,7 @@ int mbr_rt_reson7kr(int verbose, void *mbio_ptr, void *store_ptr, int *error) {
 		}
 
 		/* case of v2detection record with v2detectionsetup */
-		else if (store->read_v2detection == MB_YES && store->read_v2detectionsetup == MB_YES) {
+		else if ((store->read_mask & R7KREAD_V2Detection) && (store->read_mask & R7KREAD_V2DetectionSetup)) {
 			/* now loop over the detects */
 			for (j = 0; j < v2detection->number_beams; j++) {
 				i = v2detectionsetup->beam_descriptor[j];
@@ -916,7 +1035,7 @@ int mbr_rt_reson7kr(int verbose, void *mbio_ptr, void *store_ptr, int *error) {
 		}
 
 		/* case of v2detection record alone */
-		else if (store->read_v2detection == MB_YES) {
+		else if (store->read_mask & R7KREAD_V2Detection) {
 			/* now loop over the detects */
 			for (j = 0; j < v2detection->number_beams; j++) {
 				i = j;
@@ -943,7 +1062,8 @@ int mbr_rt_reson7kr(int verbose, void *mbio_ptr, void *store_ptr, int *error) {
 		/* else default case of beamgeometry record */
 		else {
 			/* loop over all beams */
-            bathymetry->number_beams = beamgeometry->number_beams;
+			bathymetry->number_beams = beamgeometry->number_beams;
+			status = mbsys_reson7k_alloc_bathymetry(verbose, bathymetry, bathymetry->number_beams, error);
 			for (i = 0; i < bathymetry->number_beams; i++) {
 				if ((bathymetry->quality[i] & 15) > 0) {
 					alpha = RTD * (beamgeometry->angle_alongtrack[i] + bathymetry->pitch + volatilesettings->steering_vertical);
@@ -982,16 +1102,18 @@ int mbr_rt_reson7kr(int verbose, void *mbio_ptr, void *store_ptr, int *error) {
 	}
 
 	/* generate processed sidescan if needed */
-	if (status == MB_SUCCESS && store->kind == MB_DATA_DATA && store->read_bathymetry == MB_YES &&
-	    store->read_processedsidescan == MB_NO) {
+	if (status == MB_SUCCESS && store->kind == MB_DATA_DATA && (store->read_mask & R7KREAD_Bathymetry) &&
+	    !(store->read_mask & R7KREAD_ProcessedSidescan)) {
 		/* set source of processed sidescan to be best available data */
-		if (store->read_calibratedsnippet == MB_YES)
+		if (store->read_mask & R7KREAD_CalibratedSnippet)
 			ss_source = R7KRECID_7kCalibratedSnippetData;
-		else if (store->read_v2snippet == MB_YES)
+		else if (store->read_mask & R7KREAD_V2Snippet)
 			ss_source = R7KRECID_7kV2SnippetData;
-		else if (store->read_beam == MB_YES)
+		else if (store->read_mask & R7KREAD_Beam)
 			ss_source = R7KRECID_7kBeamData;
-		else if (store->read_backscatter == MB_YES)
+		else if (store->read_mask & R7KREAD_CompressedWaterColumn)
+			ss_source = R7KRECID_7kCompressedWaterColumn;
+		else if (store->read_mask & R7KREAD_Backscatter)
 			ss_source = R7KRECID_7kBackscatterImageData;
 		else
 			ss_source = 0;
@@ -1059,6 +1181,7 @@ int mbr_reson7kr_rd_data(int verbose, void *mbio_ptr, void *store_ptr, int *erro
 	int status = MB_SUCCESS;
 	struct mb_io_struct *mb_io_ptr;
 	struct mbsys_reson7k_struct *store;
+	struct mbsys_reson7k_struct *ostore;
 	s7k_header *header;
 	s7kr_fsdwss *fsdwsslo;
 	s7kr_fsdwss *fsdwsshi;
@@ -1096,10 +1219,12 @@ int mbr_reson7kr_rd_data(int verbose, void *mbio_ptr, void *store_ptr, int *erro
 	int *nbadrec;
 	int skip;
 	int ping_record;
+	u32 completemask;
 	int time_j[5], time_i[7];
 	double time_d;
 	int nscan;
 	int version_major, version_minor, version_svn;
+	int rawerror = MB_ERROR_NO_ERROR;
 	int i;
 
 	/* print input debug statements */
@@ -1119,6 +1244,9 @@ int mbr_reson7kr_rd_data(int verbose, void *mbio_ptr, void *store_ptr, int *erro
 	store = (struct mbsys_reson7k_struct *)store_ptr;
 	mbfp = mb_io_ptr->mbfp;
 
+	/* get pointer to the internal store holding the input options */
+	ostore = (struct mbsys_reson7k_struct *)mb_io_ptr->store_data;
+
 	/* get saved values */
 	save_flag = (int *)&mb_io_ptr->save_flag;
 	current_ping = (int *)&mb_io_ptr->save14;
@@ -1233,7 +1361,7 @@ Have a nice day...\n");
 			    *recordid == R7KRECID_7kV2PingMotion || *recordid == R7KRECID_7kV2DetectionSetup ||
 			    *recordid == R7KRECID_7kV2BeamformedData || *recordid == R7KRECID_7kV2Detection ||
 			    *recordid == R7KRECID_7kV2RawDetection || *recordid == R7KRECID_7kV2SnippetData ||
-			    *recordid == R7KRECID_7kCalibratedSnippetData) {
+			    *recordid == R7KRECID_7kCalibratedSnippetData || *recordid == R7KRECID_7kCompressedWaterColumn) {
 				/* check for ping number */
 				ping_record = MB_YES;
 				mbr_reson7kr_chk_pingnumber(verbose, *recordid, buffer, new_ping);
@@ -1250,12 +1378,7 @@ Have a nice day...\n");
 #ifdef MBR_RESON7KR_DEBUG2
 				fprintf(stderr, "called mbr_reson7kr_chk_pingnumber recordid:%d last_ping:%d new_ping:%d\n", *recordid,
 				        *last_ping, *new_ping);
-				fprintf(stderr, "current ping:%d records read: %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d\n",
-				        store->current_ping_number, store->read_volatilesettings, store->read_matchfilter,
-				        store->read_beamgeometry, store->read_remotecontrolsettings, store->read_bathymetry,
-				        store->read_backscatter, store->read_beam, store->read_verticaldepth, store->read_tvg, store->read_image,
-				        store->read_v2pingmotion, store->read_v2detectionsetup, store->read_v2beamformed, store->read_v2detection,
-				        store->read_v2rawdetection, store->read_v2snippet, store->read_processedsidescan);
+				fprintf(stderr, "current ping:%d records read: 0x%5.5x\n", store->current_ping_number, store->read_mask);
 #endif
 
 				/* determine if record is continuation of the last ping
@@ -1264,7 +1387,7 @@ Have a nice day...\n");
 				    last ping as fully read */
 				if (*last_ping >= 0 && *new_ping >= 0 && *last_ping != *new_ping) {
 					/* good ping if bathymetry record is read */
-					if (store->read_bathymetry == MB_YES) {
+					if (store->read_mask & R7KREAD_Bathymetry) {
 						done = MB_YES;
 						store->kind = MB_DATA_DATA;
 						*save_flag = MB_YES;
@@ -1286,7 +1409,7 @@ Have a nice day...\n");
 					}
 
 					/* good ping if at least the detects are available */
-					else if (store->read_v2detection == MB_YES) {
+					else if (store->read_mask & R7KREAD_V2Detection) {
 						done = MB_YES;
 						store->kind = MB_DATA_DATA;
 						*save_flag = MB_YES;
@@ -1308,7 +1431,7 @@ Have a nice day...\n");
 					}
 
 					/* good ping if at least the raw detects are available */
-					else if (store->read_v2rawdetection == MB_YES) {
+					else if (store->read_mask & R7KREAD_V2RawDetection) {
 						done = MB_YES;
 						store->kind = MB_DATA_DATA;
 						*save_flag = MB_YES;
@@ -1344,24 +1467,11 @@ Have a nice day...\n");
 					done = MB_NO;
 					*current_ping = -1;
 					*last_ping = *new_ping;
-					store->read_volatilesettings = MB_NO;
-					store->read_matchfilter = MB_NO;
-					store->read_beamgeometry = MB_NO;
-					store->read_bathymetry = MB_NO;
-					store->read_remotecontrolsettings = MB_NO;
-					store->read_backscatter = MB_NO;
-					store->read_beam = MB_NO;
-					store->read_verticaldepth = MB_NO;
-					store->read_tvg = MB_NO;
-					store->read_image = MB_NO;
-					store->read_v2pingmotion = MB_NO;
-					store->read_v2detectionsetup = MB_NO;
-					store->read_v2beamformed = MB_NO;
-					store->read_v2detection = MB_NO;
-					store->read_v2rawdetection = MB_NO;
-					store->read_v2snippet = MB_NO;
-					store->read_calibratedsnippet = MB_NO;
-					store->read_processedsidescan = MB_NO;
+					store->read_mask = 0;
+					for (i = 0; i < R7KRAW_Other; i++) {
+						store->rawrecord[i].recordid = R7KRECID_None;
+						store->rawrecord[i].size = 0;
+					}
 				}
 			}
 		}
@@ -1527,6 +1637,11 @@ Have a nice day...\n");
 
 		/* if needed parse the data record */
 		if (status == MB_SUCCESS && done == MB_NO) {
+			/* keep the record bytes as read so that the record can be
+			    passed through unchanged on output if it is not modified */
+			if (*recordid != R7KRECID_7kFileHeader)
+				mbsys_reson7k_rawrecord_save(verbose, store_ptr, *recordid, buffer, *size, &rawerror);
+
 			if (*recordid == R7KRECID_7kFileHeader) {
 				status = mbr_reson7kr_rd_fileheader(verbose, buffer, store_ptr, error);
 				(*fileheaders)++;
@@ -1818,14 +1933,14 @@ Have a nice day...\n");
 			else if (*recordid == R7KRECID_ProcessedSidescan) {
 				status = mbr_reson7kr_rd_processedsidescan(verbose, buffer, store_ptr, error);
 				if (status == MB_SUCCESS) {
-					store->read_processedsidescan = MB_YES;
+					store->read_mask |= R7KREAD_ProcessedSidescan;
 					store->nrec_processedsidescan++;
 				}
 			}
 			else if (*recordid == R7KRECID_7kVolatileSonarSettings) {
 				status = mbr_reson7kr_rd_volatilesonarsettings(verbose, buffer, store_ptr, error);
 				if (status == MB_SUCCESS) {
-					store->read_volatilesettings = MB_YES;
+					store->read_mask |= R7KREAD_VolatileSettings;
 					store->nrec_volatilesonarsettings++;
 				}
 			}
@@ -1839,7 +1954,7 @@ Have a nice day...\n");
 			else if (*recordid == R7KRECID_7kMatchFilter) {
 				status = mbr_reson7kr_rd_matchfilter(verbose, buffer, store_ptr, error);
 				if (status == MB_SUCCESS) {
-					store->read_matchfilter = MB_YES;
+					store->read_mask |= R7KREAD_MatchFilter;
 					store->nrec_matchfilter++;
 				}
 			}
@@ -1853,7 +1968,7 @@ Have a nice day...\n");
 			else if (*recordid == R7KRECID_7kBeamGeometry) {
 				status = mbr_reson7kr_rd_beamgeometry(verbose, buffer, store_ptr, error);
 				if (status == MB_SUCCESS) {
-					store->read_beamgeometry = MB_YES;
+					store->read_mask |= R7KREAD_BeamGeometry;
 					done = MB_NO;
 					store->nrec_beamgeometry++;
 
@@ -1873,7 +1988,7 @@ Have a nice day...\n");
 			else if (*recordid == R7KRECID_7kBathymetricData) {
 				status = mbr_reson7kr_rd_bathymetry(verbose, buffer, store_ptr, error);
 				if (status == MB_SUCCESS) {
-					store->read_bathymetry = MB_YES;
+					store->read_mask |= R7KREAD_Bathymetry;
 					store->nrec_bathymetry++;
 
 					/* if needed use most recent Edgetech timestamp to fix 7k time */
@@ -1894,6 +2009,7 @@ Have a nice day...\n");
 						header->s7kTime.Hours = store->time_i[3];
 						header->s7kTime.Minutes = store->time_i[4];
 						header->s7kTime.Seconds = store->time_i[5] + 0.000001 * store->time_i[6];
+						mbsys_reson7k_rawrecord_modified(verbose, store_ptr, *recordid, &rawerror);
 #ifdef MBR_RESON7KR_DEBUG2
 						fprintf(stderr,
 						        "TIME CORRECTION: R7KRECID_7kBathymetricData:        7Ktime(%4.4d/%2.2d/%2.2d "
@@ -1909,7 +2025,7 @@ Have a nice day...\n");
 			else if (*recordid == R7KRECID_7kBackscatterImageData) {
 				status = mbr_reson7kr_rd_backscatter(verbose, buffer, store_ptr, error);
 				if (status == MB_SUCCESS) {
-					store->read_backscatter = MB_YES;
+					store->read_mask |= R7KREAD_Backscatter;
 					store->nrec_backscatter++;
 
 					/* if needed use most recent Edgetech timestamp to fix 7k time */
@@ -1930,6 +2046,7 @@ Have a nice day...\n");
 						header->s7kTime.Hours = store->time_i[3];
 						header->s7kTime.Minutes = store->time_i[4];
 						header->s7kTime.Seconds = store->time_i[5] + 0.000001 * store->time_i[6];
+						mbsys_reson7k_rawrecord_modified(verbose, store_ptr, *recordid, &rawerror);
 #ifdef MBR_RESON7KR_DEBUG2
 						fprintf(stderr,
 						        "TIME CORRECTION: R7KRECID_7kBackscatterImageData:   7Ktime(%4.4d/%2.2d/%2.2d "
@@ -1943,7 +2060,7 @@ Have a nice day...\n");
 			else if (*recordid == R7KRECID_7kBeamData) {
 				status = mbr_reson7kr_rd_beam(verbose, buffer, store_ptr, error);
 				if (status == MB_SUCCESS) {
-					store->read_beam = MB_YES;
+					store->read_mask |= R7KREAD_Beam;
 					store->nrec_beam++;
 
 					/* if needed use most recent Edgetech timestamp to fix 7k time */
@@ -1964,6 +2081,7 @@ Have a nice day...\n");
 						header->s7kTime.Hours = store->time_i[3];
 						header->s7kTime.Minutes = store->time_i[4];
 						header->s7kTime.Seconds = store->time_i[5] + 0.000001 * store->time_i[6];
+						mbsys_reson7k_rawrecord_modified(verbose, store_ptr, *recordid, &rawerror);
 #ifdef MBR_RESON7KR_DEBUG2
 						fprintf(stderr,
 						        "TIME CORRECTION: R7KRECID_7kBeamData: 7Ktime(%4.4d/%2.2d/%2.2d %2.2d:%2.2d:%2.2d.%6.6d) "
@@ -1977,21 +2095,21 @@ Have a nice day...\n");
 			else if (*recordid == R7KRECID_7kVerticalDepth) {
 				status = mbr_reson7kr_rd_verticaldepth(verbose, buffer, store_ptr, error);
 				if (status == MB_SUCCESS) {
-					store->read_verticaldepth = MB_YES;
+					store->read_mask |= R7KREAD_VerticalDepth;
 					store->nrec_verticaldepth++;
 				}
 			}
 			else if (*recordid == R7KRECID_7kTVGData) {
 				status = mbr_reson7kr_rd_tvg(verbose, buffer, store_ptr, error);
 				if (status == MB_SUCCESS) {
-					store->read_tvg = MB_YES;
+					store->read_mask |= R7KREAD_Tvg;
 					store->nrec_tvg++;
 				}
 			}
 			else if (*recordid == R7KRECID_7kImageData) {
 				status = mbr_reson7kr_rd_image(verbose, buffer, store_ptr, error);
 				if (status == MB_SUCCESS) {
-					store->read_image = MB_YES;
+					store->read_mask |= R7KREAD_Image;
 					store->nrec_image++;
 
 					/* if needed use most recent Edgetech timestamp to fix 7k time */
@@ -2012,6 +2130,7 @@ Have a nice day...\n");
 						header->s7kTime.Hours = store->time_i[3];
 						header->s7kTime.Minutes = store->time_i[4];
 						header->s7kTime.Seconds = store->time_i[5] + 0.000001 * store->time_i[6];
+						mbsys_reson7k_rawrecord_modified(verbose, store_ptr, *recordid, &rawerror);
 #ifdef MBR_RESON7KR_DEBUG2
 						fprintf(stderr,
 						        "TIME CORRECTION: R7KRECID_7kImageData:              7Ktime(%4.4d/%2.2d/%2.2d "
@@ -2025,21 +2144,21 @@ Have a nice day...\n");
 			else if (*recordid == R7KRECID_7kV2PingMotion) {
 				status = mbr_reson7kr_rd_v2pingmotion(verbose, buffer, store_ptr, error);
 				if (status == MB_SUCCESS) {
-					store->read_v2pingmotion = MB_YES;
+					store->read_mask |= R7KREAD_V2PingMotion;
 					store->nrec_v2pingmotion++;
 				}
 			}
 			else if (*recordid == R7KRECID_7kV2DetectionSetup) {
 				status = mbr_reson7kr_rd_v2detectionsetup(verbose, buffer, store_ptr, error);
 				if (status == MB_SUCCESS) {
-					store->read_v2detectionsetup = MB_YES;
+					store->read_mask |= R7KREAD_V2DetectionSetup;
 					store->nrec_v2detectionsetup++;
 				}
 			}
 			else if (*recordid == R7KRECID_7kV2BeamformedData) {
 				status = mbr_reson7kr_rd_v2beamformed(verbose, buffer, store_ptr, error);
 				if (status == MB_SUCCESS) {
-					store->read_v2beamformed = MB_YES;
+					store->read_mask |= R7KREAD_V2Beamformed;
 					store->nrec_v2beamformed++;
 				}
 			}
@@ -2067,31 +2186,38 @@ Have a nice day...\n");
 			else if (*recordid == R7KRECID_7kV2Detection) {
 				status = mbr_reson7kr_rd_v2detection(verbose, buffer, store_ptr, error);
 				if (status == MB_SUCCESS) {
-					store->read_v2detection = MB_YES;
+					store->read_mask |= R7KREAD_V2Detection;
 					store->nrec_v2detection++;
 				}
 			}
 			else if (*recordid == R7KRECID_7kV2RawDetection) {
 				status = mbr_reson7kr_rd_v2rawdetection(verbose, buffer, store_ptr, error);
 				if (status == MB_SUCCESS) {
-					store->read_v2rawdetection = MB_YES;
+					store->read_mask |= R7KREAD_V2RawDetection;
 					store->nrec_v2rawdetection++;
 				}
 			}
 			else if (*recordid == R7KRECID_7kV2SnippetData) {
 				status = mbr_reson7kr_rd_v2snippet(verbose, buffer, store_ptr, error);
 				if (status == MB_SUCCESS) {
-					store->read_v2snippet = MB_YES;
+					store->read_mask |= R7KREAD_V2Snippet;
 					store->nrec_v2snippet++;
 				}
 			}
 			else if (*recordid == R7KRECID_7kCalibratedSnippetData) {
 				status = mbr_reson7kr_rd_calibratedsnippet(verbose, buffer, store_ptr, error);
 				if (status == MB_SUCCESS) {
-					store->read_calibratedsnippet = MB_YES;
+					store->read_mask |= R7KREAD_CalibratedSnippet;
 					store->nrec_calibratedsnippet++;
 				}
 			}
+			else if (*recordid == R7KRECID_7kCompressedWaterColumn) {
+				status = mbr_reson7kr_rd_compressedwatercolumn(verbose, buffer, store_ptr, error);
+				if (status == MB_SUCCESS) {
+					store->read_mask |= R7KREAD_CompressedWaterColumn;
+					store->nrec_compressedwatercolumn++;
+				}
+			}
 			else if (*recordid == R7KRECID_7kInstallationParameters) {
 				status = mbr_reson7kr_rd_installation(verbose, buffer, store_ptr, error);
 				if (status == MB_SUCCESS) {
@@ -2109,7 +2235,7 @@ Have a nice day...\n");
 			else if (*recordid == R7KRECID_7kRemoteControlSonarSettings) {
 				status = mbr_reson7kr_rd_remotecontrolsettings(verbose, buffer, store_ptr, error);
 				if (status == MB_SUCCESS) {
-					store->read_remotecontrolsettings = MB_YES;
+					store->read_mask |= R7KREAD_RemoteControlSettings;
 					done = MB_NO;
 					store->nrec_remotecontrolsettings++;
 				}
@@ -2163,20 +2289,17 @@ Have a nice day...\n");
 #endif
 				done = MB_NO;
 				store->nrec_other++;
+				store->rawrecord[R7KRAW_Other].recordid = R7KRECID_None;
 			}
 
-			/* check if ping record is known to be done */
-			if (status == MB_SUCCESS && ping_record == MB_YES && store->read_v2detectionsetup == MB_YES) {
-				if (status == MB_SUCCESS && ping_record == MB_YES && store->read_volatilesettings == MB_YES &&
-				    store->read_matchfilter == MB_YES && store->read_beamgeometry == MB_YES && store->read_bathymetry == MB_YES &&
-				    store->read_remotecontrolsettings == MB_YES && store->read_backscatter == MB_YES &&
-				    store->read_beam == MB_YES &&
-				    store->read_verticaldepth == MB_YES
-				    /* && store->read_tvg == MB_YES */
-				    && store->read_image == MB_YES && store->read_v2pingmotion == MB_YES &&
-				    store->read_v2detectionsetup == MB_YES && store->read_v2beamformed == MB_YES &&
-				    store->read_v2detection == MB_YES && store->read_v2rawdetection == MB_YES &&
-				    store->read_v2snippet == MB_YES) {
+			/* check if ping record is known to be done - only if a completion
+			    mask has been set for the file (e.g. for live data), a ping is
+			    complete once all of the records in the mask are read. Otherwise
+			    a ping ends when the first record of the next ping arrives, so
+			    that records logged after the detections are not dropped */
+			if (status == MB_SUCCESS && ping_record == MB_YES && ostore->pingcomplete_mask != 0) {
+				completemask = ostore->pingcomplete_mask;
+				if ((store->read_mask & completemask) == completemask) {
 					done = MB_YES;
 					*current_ping = *last_ping;
 					*last_ping = -1;
@@ -2223,11 +2346,8 @@ Have a nice day...\n");
 if (*save_flag == MB_YES)
 fprintf(stderr,"RECORD SAVED\n");
 else
-fprintf(stderr,"status:%d recordid:%d ping_record:%d current:%d last:%d new:%d  done:%d recs:%d %d %d %d %d %d %d %d %d\n",
-status,*recordid,ping_record,*current_ping,*last_ping,*new_ping,done,
-store->read_volatilesettings,store->read_matchfilter,
-store->read_beamgeometry,store->read_bathymetry,store->read_backscatter,
-store->read_beam,store->read_verticaldepth,store->read_tvg,store->read_image);
+fprintf(stderr,"status:%d recordid:%d ping_record:%d current:%d last:%d new:%d  done:%d recs:0x%5.5x\n",
+status,*recordid,ping_record,*current_ping,*last_ping,*new_ping,done,store->read_mask);
 }*/
 #endif
 	}
@@ -2327,6 +2447,7 @@ int mbr_reson7kr_chk_header(int verbose, void *mbio_ptr, char *buffer, int *reco
 	         *recordid != R7KRECID_7kV27kCenterVersion && *recordid != R7KRECID_7kV28kWetEndVersion &&
 	         *recordid != R7KRECID_7kV2Detection && *recordid != R7KRECID_7kV2RawDetection &&
 	         *recordid != R7KRECID_7kV2SnippetData && *recordid != R7KRECID_7kCalibratedSnippetData &&
+	         *recordid != R7KRECID_7kCompressedWaterColumn &&
 	         *recordid != R7KRECID_7kInstallationParameters && *recordid != R7KRECID_7kSystemEventMessage &&
 	         *recordid != R7KRECID_7kDataStorageStatus && *recordid != R7KRECID_7kFileHeader && *recordid != R7KRECID_7kTrigger &&
 	         *recordid != R7KRECID_7kTriggerSequenceSetup && *recordid != R7KRECID_7kTriggerSequenceDone &&
@@ -2585,6 +2706,11 @@ int mbr_reson7kr_chk_pingnumber(int verbose, int recordid, char *buffer, int *pi
 		mb_get_binary_int(MB_YES, &buffer[index], ping_number);
 		status = MB_SUCCESS;
 	}
+	else if (recordid == R7KRECID_7kCompressedWaterColumn) {
+		index = offset + 12;
+		mb_get_binary_int(MB_YES, &buffer[index], ping_number);
+		status = MB_SUCCESS;
+	}
 	else if (recordid == R7KRECID_7kRemoteControlSonarSettings) {
 		index = offset + 12;
 		mb_get_binary_int(MB_YES, &buffer[index], ping_number);
@@ -3433,6 +3559,9 @@ int mbr_reson7kr_rd_motion(int verbose, char *buffer, void *store_ptr, int *erro
 	motion = &(store->motion);
 	header = &(motion->header);
 
+	/* arrays shared with copies of this store are left to the copies */
+	status = mbsys_reson7k_unshare_payload(verbose, store_ptr, R7KSHARE_Motion, MB_NO, error);
+
 	/* extract the header */
 	index = 0;
 	status = mbr_reson7kr_rd_header(verbose, buffer, &index, header, error);
@@ -3659,6 +3788,9 @@ int mbr_reson7kr_rd_svp(int verbose, char *buffer, void *store_ptr, int *error)
 	svp = &(store->svp);
 	header = &(svp->header);
 
+	/* arrays shared with copies of this store are left to the copies */
+	status = mbsys_reson7k_unshare_payload(verbose, store_ptr, R7KSHARE_Svp, MB_NO, error);
+
 	/* extract the header */
 	index = 0;
 	status = mbr_reson7kr_rd_header(verbose, buffer, &index, header, error);
@@ -3773,6 +3905,9 @@ int mbr_reson7kr_rd_ctd(int verbose, char *buffer, void *store_ptr, int *error)
 	ctd = &(store->ctd);
 	header = &(ctd->header);
 
+	/* arrays shared with copies of this store are left to the copies */
+	status = mbsys_reson7k_unshare_payload(verbose, store_ptr, R7KSHARE_Ctd, MB_NO, error);
+
 	/* extract the header */
 	index = 0;
 	status = mbr_reson7kr_rd_header(verbose, buffer, &index, header, error);
@@ -4424,6 +4559,9 @@ int mbr_reson7kr_rd_attitude(int verbose, char *buffer, void *store_ptr, int *er
 	attitude = &(store->attitude);
 	header = &(attitude->header);
 
+	/* arrays shared with copies of this store are left to the copies */
+	status = mbsys_reson7k_unshare_payload(verbose, store_ptr, R7KSHARE_Attitude, MB_NO, error);
+
 	/* extract the header */
 	index = 0;
 	status = mbr_reson7kr_rd_header(verbose, buffer, &index, header, error);
@@ -5029,6 +5167,10 @@ int mbr_reson7kr_rd_fsdwsslo(int verbose, char *buffer, void *store_ptr, int *er
 	bathymetry = &(store->bathymetry);
 	bluefin = &(store->bluefin);
 
+	/* arrays shared with copies of this store are duplicated, as a record
+	    may not fill every channel */
+	status = mbsys_reson7k_unshare_payload(verbose, store_ptr, R7KSHARE_FsdwssLo, MB_YES, error);
+
 	/* extract the header */
 	index = 0;
 	status = mbr_reson7kr_rd_header(verbose, buffer, &index, header, error);
@@ -5335,6 +5477,10 @@ int mbr_reson7kr_rd_fsdwsshi(int verbose, char *buffer, void *store_ptr, int *er
 	header = &(fsdwsshi->header);
 	bathymetry = &(store->bathymetry);
 
+	/* arrays shared with copies of this store are duplicated, as a record
+	    may not fill every channel */
+	status = mbsys_reson7k_unshare_payload(verbose, store_ptr, R7KSHARE_FsdwssHi, MB_YES, error);
+
 	/* extract the header */
 	index = 0;
 	status = mbr_reson7kr_rd_header(verbose, buffer, &index, header, error);
@@ -5506,6 +5652,10 @@ int mbr_reson7kr_rd_fsdwsb(int verbose, char *buffer, void *store_ptr, int *erro
 	header = &(fsdwsb->header);
 	bathymetry = &store->bathymetry;
 
+	/* arrays shared with copies of this store are duplicated, as a record
+	    may not fill every channel */
+	status = mbsys_reson7k_unshare_payload(verbose, store_ptr, R7KSHARE_Fsdwsb, MB_YES, error);
+
 	/* extract the header */
 	index = 0;
 	status = mbr_reson7kr_rd_header(verbose, buffer, &index, header, error);
@@ -6359,6 +6509,9 @@ int mbr_reson7kr_rd_configuration(int verbose, char *buffer, void *store_ptr, in
 	configuration = &(store->configuration);
 	header = &(configuration->header);
 
+	/* arrays shared with copies of this store are left to the copies */
+	status = mbsys_reson7k_unshare_payload(verbose, store_ptr, R7KSHARE_Configuration, MB_NO, error);
+
 	/* extract the header */
 	index = 0;
 	status = mbr_reson7kr_rd_header(verbose, buffer, &index, header, error);
@@ -6370,8 +6523,26 @@ int mbr_reson7kr_rd_configuration(int verbose, char *buffer, void *store_ptr, in
 	mb_get_binary_int(MB_YES, &buffer[index], &(configuration->number_devices));
 	index += 4;
 
+	/* allocate memory for the devices if needed */
+	if (status == MB_SUCCESS && configuration->nalloc < configuration->number_devices) {
+		status = mb_reallocd(verbose, __FILE__, __LINE__, configuration->number_devices * sizeof(s7k_device),
+		                     (void **)&(configuration->device), error);
+		if (status == MB_SUCCESS) {
+			for (i = configuration->nalloc; i < configuration->number_devices; i++) {
+				configuration->device[i].info_length = 0;
+				configuration->device[i].info_alloc = 0;
+				configuration->device[i].info = NULL;
+			}
+			configuration->nalloc = configuration->number_devices;
+		}
+		else {
+			configuration->nalloc = 0;
+			configuration->number_devices = 0;
+		}
+	}
+
 	/* extract the data for each device */
-	for (i = 0; i < configuration->number_devices; i++) {
+	for (i = 0; i < configuration->number_devices && status == MB_SUCCESS; i++) {
 		device = &(configuration->device[i]);
 		mb_get_binary_int(MB_YES, &buffer[index], &(device->magic_number));
 		index += 4;
@@ -6665,6 +6836,9 @@ int mbr_reson7kr_rd_beamgeometry(int verbose, char *buffer, void *store_ptr, int
 	beamgeometry = &(store->beamgeometry);
 	header = &(beamgeometry->header);
 
+	/* arrays shared with copies of this store are left to the copies */
+	status = mbsys_reson7k_unshare_payload(verbose, store_ptr, R7KSHARE_BeamGeometry, MB_NO, error);
+
 	/* extract the header */
 	index = 0;
 	status = mbr_reson7kr_rd_header(verbose, buffer, &index, header, error);
@@ -6676,6 +6850,10 @@ int mbr_reson7kr_rd_beamgeometry(int verbose, char *buffer, void *store_ptr, int
 	mb_get_binary_int(MB_YES, &buffer[index], &(beamgeometry->number_beams));
 	index += 4;
 
+	/* make sure the beam arrays are large enough */
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_alloc_beamgeometry(verbose, beamgeometry, beamgeometry->number_beams, error);
+
 	/* extract the data */
 	for (i = 0; i < beamgeometry->number_beams; i++) {
 		mb_get_binary_float(MB_YES, &buffer[index], &(beamgeometry->angle_alongtrack[i]));
@@ -6860,6 +7038,9 @@ int mbr_reson7kr_rd_bathymetry(int verbose, char *buffer, void *store_ptr, int *
 	bathymetry = &(store->bathymetry);
 	header = &(bathymetry->header);
 
+	/* arrays shared with copies of this store are left to the copies */
+	status = mbsys_reson7k_unshare_payload(verbose, store_ptr, R7KSHARE_Bathymetry, MB_NO, error);
+
 	/* extract the header */
 	index = 0;
 	status = mbr_reson7kr_rd_header(verbose, buffer, &index, header, error);
@@ -6875,6 +7056,10 @@ int mbr_reson7kr_rd_bathymetry(int verbose, char *buffer, void *store_ptr, int *
 	mb_get_binary_int(MB_YES, &buffer[index], &(bathymetry->number_beams));
 	index += 4;
 
+	/* make sure the beam arrays are large enough */
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_alloc_bathymetry(verbose, bathymetry, bathymetry->number_beams, error);
+
 	/* deal with version 5 records */
 	if (header->Version >= 5) {
 		bathymetry->layer_comp_flag = buffer[index];
@@ -6998,7 +7183,7 @@ int mbr_reson7kr_rd_bathymetry(int verbose, char *buffer, void *store_ptr, int *
 		bathymetry->pitch = 0.0;
 		bathymetry->heave = 0.0;
 		bathymetry->vehicle_height = 0.0;
-		for (i = 0; i < MBSYS_RESON7K_MAX_BEAMS; i++) {
+		for (i = 0; i < bathymetry->nalloc; i++) {
 			bathymetry->depth[i] = 0.0;
 			bathymetry->acrosstrack[i] = 0.0;
 			bathymetry->alongtrack[i] = 0.0;
@@ -7082,6 +7267,9 @@ int mbr_reson7kr_rd_backscatter(int verbose, char *buffer, void *store_ptr, int
 	backscatter = &(store->backscatter);
 	header = &(backscatter->header);
 
+	/* arrays shared with copies of this store are left to the copies */
+	status = mbsys_reson7k_unshare_payload(verbose, store_ptr, R7KSHARE_Backscatter, MB_NO, error);
+
 	/* extract the header */
 	index = 0;
 	status = mbr_reson7kr_rd_header(verbose, buffer, &index, header, error);
@@ -7286,6 +7474,9 @@ int mbr_reson7kr_rd_beam(int verbose, char *buffer, void *store_ptr, int *error)
 	beam = &(store->beam);
 	header = &(beam->header);
 
+	/* arrays shared with copies of this store are left to the copies */
+	status = mbsys_reson7k_unshare_payload(verbose, store_ptr, R7KSHARE_Beam, MB_NO, error);
+
 	/* extract the header */
 	index = 0;
 	status = mbr_reson7kr_rd_header(verbose, buffer, &index, header, error);
@@ -7588,6 +7779,9 @@ int mbr_reson7kr_rd_tvg(int verbose, char *buffer, void *store_ptr, int *error)
 	tvg = &(store->tvg);
 	header = &(tvg->header);
 
+	/* arrays shared with copies of this store are left to the copies */
+	status = mbsys_reson7k_unshare_payload(verbose, store_ptr, R7KSHARE_Tvg, MB_NO, error);
+
 	/* extract the header */
 	index = 0;
 	status = mbr_reson7kr_rd_header(verbose, buffer, &index, header, error);
@@ -7697,6 +7891,9 @@ int mbr_reson7kr_rd_image(int verbose, char *buffer, void *store_ptr, int *error
 	image = &(store->image);
 	header = &(image->header);
 
+	/* arrays shared with copies of this store are left to the copies */
+	status = mbsys_reson7k_unshare_payload(verbose, store_ptr, R7KSHARE_Image, MB_NO, error);
+
 	/* extract the header */
 	index = 0;
 	status = mbr_reson7kr_rd_header(verbose, buffer, &index, header, error);
@@ -8021,6 +8218,10 @@ int mbr_reson7kr_rd_v2detectionsetup(int verbose, char *buffer, void *store_ptr,
 		index += 4;
 	}
 
+	/* allocate memory for the beams if needed */
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_alloc_v2detectionsetup(verbose, v2detectionsetup, v2detectionsetup->number_beams, error);
+
 	/* extract v2detectionsetup data */
 	for (i = 0; i < v2detectionsetup->number_beams; i++) {
 		mb_get_binary_short(MB_YES, &buffer[index], &(v2detectionsetup->beam_descriptor[i]));
@@ -8614,6 +8815,10 @@ int mbr_reson7kr_rd_v2detection(int verbose, char *buffer, void *store_ptr, int
 		index++;
 	}
 
+	/* allocate memory for the detections if needed */
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_alloc_v2detection(verbose, v2detection, v2detection->number_beams, error);
+
 	/* extract the data */
 	for (i = 0; i < v2detection->number_beams; i++) {
 		mb_get_binary_float(MB_YES, &buffer[index], &(v2detection->range[i]));
@@ -8739,6 +8944,10 @@ int mbr_reson7kr_rd_v2rawdetection(int verbose, char *buffer, void *store_ptr, i
 		index++;
 	}
 
+	/* allocate memory for the detections if needed */
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_alloc_v2rawdetection(verbose, v2rawdetection, v2rawdetection->number_beams, error);
+
 	/* extract the data */
 	for (i = 0; i < v2rawdetection->number_beams; i++) {
 		mb_get_binary_short(MB_YES, &buffer[index], &(v2rawdetection->beam_descriptor[i]));
@@ -8778,11 +8987,12 @@ int mbr_reson7kr_rd_v2rawdetection(int verbose, char *buffer, void *store_ptr, i
 		store->kind = MB_DATA_NONE;
 	}
 
-	/* check for broken record */
+	/* check for broken record - the detections must lie within the beams
+	    of the ping; with no bathymetry or beam geometry read the beams are
+	    set from the detections */
 	for (i = 0; i < v2rawdetection->number_beams; i++) {
-		if ((v2rawdetection->beam_descriptor[i] > MBSYS_RESON7K_MAX_BEAMS) ||
-		    (store->read_bathymetry == MB_YES && v2rawdetection->beam_descriptor[i] > bathymetry->number_beams) ||
-		    (store->read_beamgeometry == MB_YES && v2rawdetection->beam_descriptor[i] > beamgeometry->number_beams)) {
+		if (((store->read_mask & R7KREAD_Bathymetry) && v2rawdetection->beam_descriptor[i] >= bathymetry->number_beams) ||
+		    ((store->read_mask & R7KREAD_BeamGeometry) && v2rawdetection->beam_descriptor[i] >= beamgeometry->number_beams)) {
 			status = MB_FAILURE;
 			*error = MB_ERROR_UNINTELLIGIBLE;
 		}
@@ -9084,6 +9294,160 @@ int mbr_reson7kr_rd_calibratedsnippet(int verbose, char *buffer, void *store_ptr
 	return (status);
 }
 /*--------------------------------------------------------------------*/
+int mbr_reson7kr_rd_compressedwatercolumn(int verbose, char *buffer, void *store_ptr, int *error) {
+	char *function_name = "mbr_reson7kr_rd_compressedwatercolumn";
+	int status = MB_SUCCESS;
+	struct mbsys_reson7k_struct *store;
+	s7k_header *header;
+	s7kr_compressedwatercolumn *compressedwatercolumn;
+	s7k_compressedwatercolumndata *compressedwatercolumndata;
+	int samplesize;
+	int nbytes;
+	int index;
+	int time_j[5];
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       buffer:     %p\n", (void *)buffer);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+	}
+
+	/* get pointer to raw data structure */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+	compressedwatercolumn = &(store->compressedwatercolumn);
+	header = &(compressedwatercolumn->header);
+
+	/* extract the header */
+	index = 0;
+	status = mbr_reson7kr_rd_header(verbose, buffer, &index, header, error);
+
+	/* extract the data */
+	index = header->Offset + 4;
+	mb_get_binary_long(MB_YES, &buffer[index], &(compressedwatercolumn->serial_number));
+	index += 8;
+	mb_get_binary_int(MB_YES, &buffer[index], &(compressedwatercolumn->ping_number));
+	index += 4;
+	mb_get_binary_short(MB_YES, &buffer[index], &(compressedwatercolumn->multi_ping));
+	index += 2;
+	mb_get_binary_short(MB_YES, &buffer[index], &(compressedwatercolumn->number_beams));
+	index += 2;
+	mb_get_binary_int(MB_YES, &buffer[index], &(compressedwatercolumn->samples));
+	index += 4;
+	mb_get_binary_int(MB_YES, &buffer[index], &(compressedwatercolumn->compressed_samples));
+	index += 4;
+	mb_get_binary_int(MB_YES, &buffer[index], &(compressedwatercolumn->flags));
+	index += 4;
+	mb_get_binary_int(MB_YES, &buffer[index], &(compressedwatercolumn->first_sample));
+	index += 4;
+	mb_get_binary_float(MB_YES, &buffer[index], &(compressedwatercolumn->sample_rate));
+	index += 4;
+	mb_get_binary_float(MB_YES, &buffer[index], &(compressedwatercolumn->compression_factor));
+	index += 4;
+	mb_get_binary_int(MB_YES, &buffer[index], &(compressedwatercolumn->reserved));
+	index += 4;
+
+	/* get the size of each sample from the flags */
+	if (compressedwatercolumn->flags & R7KWC_32BIT)
+		samplesize = (compressedwatercolumn->flags & R7KWC_MAGNITUDEONLY) ? 4 : 5;
+	else if (compressedwatercolumn->flags & R7KWC_8BITDB)
+		samplesize = (compressedwatercolumn->flags & R7KWC_MAGNITUDEONLY) ? 1 : 2;
+	else
+		samplesize = (compressedwatercolumn->flags & R7KWC_MAGNITUDEONLY) ? 2 : 4;
+
+	/* allocate memory for the beams if needed */
+	if (status == MB_SUCCESS && compressedwatercolumn->nalloc < compressedwatercolumn->number_beams) {
+		status = mb_reallocd(verbose, __FILE__, __LINE__,
+		                     compressedwatercolumn->number_beams * sizeof(s7k_compressedwatercolumndata),
+		                     (void **)&(compressedwatercolumn->compressedwatercolumndata), error);
+		if (status == MB_SUCCESS) {
+			for (i = compressedwatercolumn->nalloc; i < compressedwatercolumn->number_beams; i++) {
+				compressedwatercolumn->compressedwatercolumndata[i].samples = 0;
+				compressedwatercolumn->compressedwatercolumndata[i].nalloc = 0;
+				compressedwatercolumn->compressedwatercolumndata[i].sample = NULL;
+			}
+			compressedwatercolumn->nalloc = compressedwatercolumn->number_beams;
+		}
+		else {
+			compressedwatercolumn->nalloc = 0;
+		}
+	}
+
+	/* loop over all beams - the samples are kept as read and only the
+	    samples actually used are converted (e.g. by mbsys_reson7k_makess()) */
+	for (i = 0; i < compressedwatercolumn->number_beams && status == MB_SUCCESS; i++) {
+		compressedwatercolumndata = &(compressedwatercolumn->compressedwatercolumndata[i]);
+		mb_get_binary_short(MB_YES, &buffer[index], &(compressedwatercolumndata->beam_number));
+		index += 2;
+		if (compressedwatercolumn->flags & R7KWC_SEGMENTNUMBERS) {
+			compressedwatercolumndata->segment_number = buffer[index];
+			index++;
+		}
+		else
+			compressedwatercolumndata->segment_number = 0;
+		mb_get_binary_int(MB_YES, &buffer[index], &(compressedwatercolumndata->samples));
+		index += 4;
+
+		/* allocate memory for the samples if needed */
+		nbytes = compressedwatercolumndata->samples * samplesize;
+		if (compressedwatercolumndata->nalloc < nbytes) {
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nbytes, (void **)&(compressedwatercolumndata->sample), error);
+			if (status == MB_SUCCESS)
+				compressedwatercolumndata->nalloc = nbytes;
+			else
+				compressedwatercolumndata->nalloc = 0;
+		}
+		if (status == MB_SUCCESS) {
+			memcpy((void *)compressedwatercolumndata->sample, (const void *)&buffer[index], (size_t)nbytes);
+			index += nbytes;
+		}
+	}
+
+	/* set kind */
+	if (status == MB_SUCCESS) {
+		/* set kind */
+		store->kind = MB_DATA_DATA;
+		store->type = R7KRECID_7kCompressedWaterColumn;
+
+		/* get the time */
+		time_j[0] = header->s7kTime.Year;
+		time_j[1] = header->s7kTime.Day;
+		time_j[2] = 60 * header->s7kTime.Hours + header->s7kTime.Minutes;
+		time_j[3] = (int)header->s7kTime.Seconds;
+		time_j[4] = (int)(1000000 * (header->s7kTime.Seconds - time_j[3]));
+		mb_get_itime(verbose, time_j, store->time_i);
+		mb_get_time(verbose, store->time_i, &(store->time_d));
+	}
+	else {
+		store->kind = MB_DATA_NONE;
+	}
+
+/* print out the results */
+#ifdef MBR_RESON7KR_DEBUG
+	fprintf(stderr,
+	        "R7KRECID_7kCompressedWaterColumn:            7Ktime(%4.4d/%2.2d/%2.2d %2.2d:%2.2d:%2.2d.%6.6d) ping:%d size:%d "
+	        "index:%d\n",
+	        store->time_i[0], store->time_i[1], store->time_i[2], store->time_i[3], store->time_i[4], store->time_i[5],
+	        store->time_i[6], compressedwatercolumn->ping_number, header->Size, index);
+#endif
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:  %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
 int mbr_reson7kr_rd_installation(int verbose, char *buffer, void *store_ptr, int *error) {
 	char *function_name = "mbr_reson7kr_rd_installation";
 	int status = MB_SUCCESS;
@@ -9263,9 +9627,13 @@ int mbr_reson7kr_rd_fileheader(int verbose, char *buffer, void *store_ptr, int *
 	fileheader = &(store->fileheader);
 	header = &(fileheader->header);
 
+	/* the subsystems are about to be overwritten */
+	status = mbsys_reson7k_unshare_payload(verbose, store_ptr, R7KSHARE_FileHeader, MB_NO, error);
+
 	/* extract the header */
 	index = 0;
-	status = mbr_reson7kr_rd_header(verbose, buffer, &index, header, error);
+	if (status == MB_SUCCESS)
+		status = mbr_reson7kr_rd_header(verbose, buffer, &index, header, error);
 
 	/* extract the data */
 	index = header->Offset + 4;
@@ -9301,7 +9669,21 @@ int mbr_reson7kr_rd_fileheader(int verbose, char *buffer, void *store_ptr, int *
 		fileheader->notes[i] = buffer[index];
 		index++;
 	}
-	for (i = 0; i < fileheader->number_subsystems; i++) {
+
+	/* allocate memory for the subsystems if needed */
+	if (status == MB_SUCCESS && fileheader->nalloc < fileheader->number_subsystems) {
+		status = mb_reallocd(verbose, __FILE__, __LINE__, fileheader->number_subsystems * sizeof(s7kr_subsystem),
+		                     (void **)&(fileheader->subsystem), error);
+		if (status == MB_SUCCESS)
+			fileheader->nalloc = fileheader->number_subsystems;
+		else {
+			fileheader->nalloc = 0;
+			fileheader->number_subsystems = 0;
+		}
+	}
+
+	/* extract the data for each subsystem */
+	for (i = 0; i < fileheader->number_subsystems && status == MB_SUCCESS; i++) {
 		subsystem = &(fileheader->subsystem[i]);
 		mb_get_binary_int(MB_YES, &buffer[index], &(subsystem->device_identifier));
 		index += 4;
@@ -9312,6 +9694,21 @@ int mbr_reson7kr_rd_fileheader(int verbose, char *buffer, void *store_ptr, int *
 		index += 2;
 	}
 
+	/* get the file catalog location if present */
+	if (header->OffsetToOptionalData > 0 && header->Size >= header->OffsetToOptionalData + R7KOPTSIZE_7kFileHeader) {
+		index = header->OffsetToOptionalData;
+		mb_get_binary_int(MB_YES, &buffer[index], &(fileheader->catalog_size));
+		index += 4;
+		mb_get_binary_long(MB_YES, &buffer[index], (mb_s_long *)&(fileheader->catalog_offset));
+		index += 8;
+		fileheader->optionaldata = MB_YES;
+	}
+	else {
+		fileheader->optionaldata = MB_NO;
+		fileheader->catalog_size = 0;
+		fileheader->catalog_offset = 0;
+	}
+
 	/* set kind */
 	if (status == MB_SUCCESS) {
 		/* set kind */
@@ -9385,6 +9782,9 @@ int mbr_reson7kr_rd_systemeventmessage(int verbose, char *buffer, void *store_pt
 	systemeventmessage = &(store->systemeventmessage);
 	header = &(systemeventmessage->header);
 
+	/* arrays shared with copies of this store are left to the copies */
+	status = mbsys_reson7k_unshare_payload(verbose, store_ptr, R7KSHARE_SystemEventMessage, MB_NO, error);
+
 	/* extract the header */
 	index = 0;
 	status = mbr_reson7kr_rd_header(verbose, buffer, &index, header, error);
@@ -10140,6 +10540,7 @@ int mbr_reson7kr_wr_data(int verbose, void *mbio_ptr, void *store_ptr, int *erro
 	int status = MB_SUCCESS;
 	struct mb_io_struct *mb_io_ptr;
 	struct mbsys_reson7k_struct *store;
+	struct mbsys_reson7k_struct *ostore;
 	FILE *mbfp;
 	char **bufferptr;
 	char *buffer;
@@ -10147,6 +10548,7 @@ int mbr_reson7kr_wr_data(int verbose, void *mbio_ptr, void *store_ptr, int *erro
 	int *fileheaders;
 	int size;
 	size_t write_len;
+	int rawwritten;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -10165,12 +10567,21 @@ int mbr_reson7kr_wr_data(int verbose, void *mbio_ptr, void *store_ptr, int *erro
 	store = (struct mbsys_reson7k_struct *)store_ptr;
 	mbfp = mb_io_ptr->mbfp;
 
+	/* get pointer to the internal store holding the output options */
+	ostore = (struct mbsys_reson7k_struct *)mb_io_ptr->store_data;
+
 	/* get saved values */
 	bufferptr = (char **)&mb_io_ptr->saveptr1;
 	buffer = (char *)*bufferptr;
 	bufferalloc = (int *)&mb_io_ptr->save6;
 	fileheaders = (int *)&mb_io_ptr->save12;
 
+#ifdef MBR_RESON7KR_PTHREADS
+	/* pings still in the write queue go out before any other record */
+	if (ostore->writequeue != NULL && (store->kind != MB_DATA_DATA || *fileheaders == 0))
+		status = mbr_reson7kr_wr_queuecommit(verbose, mbio_ptr, 0, MB_YES, error);
+#endif
+
 	/* write fileheader if needed */
 	if (status == MB_SUCCESS && (store->type == R7KRECID_7kFileHeader || *fileheaders == 0)) {
 #ifdef MBR_RESON7KR_DEBUG2
@@ -10184,256 +10595,33 @@ int mbr_reson7kr_wr_data(int verbose, void *mbio_ptr, void *store_ptr, int *erro
 		if (status == MB_SUCCESS) {
 			buffer = (char *)*bufferptr;
 			write_len = (size_t)size;
-			status = mb_fileio_put(verbose, mbio_ptr, buffer, &write_len, error);
+			status = mbr_reson7kr_wr_putrecord(verbose, mbio_ptr, buffer, &write_len, error);
 			store->nrec_fileheader++;
 		}
 	}
 
-	/* call appropriate writing routines for ping data */
+	/* write the ping data - the records of the ping are encoded into
+	    separate buffers (in parallel if enabled) and then written in order;
+	    records not modified since they were read are passed through unchanged.
+	    If the write queue is enabled the ping is handed to the queue instead
+	    and written once it has been encoded */
 	if (status == MB_SUCCESS && store->kind == MB_DATA_DATA) {
-		/* Reson 7k volatile sonar settings (record 7000) */
-		if (status == MB_SUCCESS && store->read_volatilesettings == MB_YES) {
-			store->type = R7KRECID_7kVolatileSonarSettings;
-#ifdef MBR_RESON7KR_DEBUG2
-			fprintf(stderr, "Writing record id: %4.4X | %d", R7KRECID_7kVolatileSonarSettings, R7KRECID_7kVolatileSonarSettings);
-			fprintf(stderr, " R7KRECID_7kVolatileSonarSettings\n");
-#endif
-			status = mbr_reson7kr_wr_volatilesonarsettings(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-			buffer = (char *)*bufferptr;
-			write_len = (size_t)size;
-			status = mb_fileio_put(verbose, mbio_ptr, buffer, &write_len, error);
-		}
-		/* Reson 7k match filter (record 7002) */
-		if (status == MB_SUCCESS && store->read_matchfilter == MB_YES) {
-			store->type = R7KRECID_7kMatchFilter;
-#ifdef MBR_RESON7KR_DEBUG2
-			fprintf(stderr, "Writing record id: %4.4X | %d", R7KRECID_7kMatchFilter, R7KRECID_7kMatchFilter);
-			fprintf(stderr, " R7KRECID_7kMatchFilter\n");
-#endif
-			status = mbr_reson7kr_wr_matchfilter(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-			buffer = (char *)*bufferptr;
-			write_len = (size_t)size;
-			status = mb_fileio_put(verbose, mbio_ptr, buffer, &write_len, error);
-		}
-
-		/* Reson 7k beam geometry (record 7004) */
-		if (status == MB_SUCCESS && store->read_beamgeometry == MB_YES) {
-			store->type = R7KRECID_7kBeamGeometry;
-#ifdef MBR_RESON7KR_DEBUG2
-			fprintf(stderr, "Writing record id: %4.4X | %d", R7KRECID_7kBeamGeometry, R7KRECID_7kBeamGeometry);
-			fprintf(stderr, " R7KRECID_7kBeamGeometry\n");
-#endif
-			status = mbr_reson7kr_wr_beamgeometry(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-			buffer = (char *)*bufferptr;
-			write_len = (size_t)size;
-			status = mb_fileio_put(verbose, mbio_ptr, buffer, &write_len, error);
-		}
-
-		/* Reson 7k remote control settings (record 7503) */
-		if (status == MB_SUCCESS && store->read_remotecontrolsettings == MB_YES) {
-			store->type = R7KRECID_7kRemoteControlSonarSettings;
-#ifdef MBR_RESON7KR_DEBUG2
-			fprintf(stderr, "Writing record id: %4.4X | %d", R7KRECID_7kRemoteControlSonarSettings,
-			        R7KRECID_7kRemoteControlSonarSettings);
-			fprintf(stderr, " R7KRECID_7kRemoteControlSonarSettings\n");
-#endif
-			status = mbr_reson7kr_wr_remotecontrolsettings(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-			buffer = (char *)*bufferptr;
-			write_len = (size_t)size;
-			status = mb_fileio_put(verbose, mbio_ptr, buffer, &write_len, error);
-		}
-
-		/* Reson 7k bathymetry (record 7006) */
-		if (status == MB_SUCCESS && store->read_bathymetry == MB_YES) {
-			store->type = R7KRECID_7kBathymetricData;
-#ifdef MBR_RESON7KR_DEBUG2
-			fprintf(stderr, "Writing record id: %4.4X | %d", R7KRECID_7kBathymetricData, R7KRECID_7kBathymetricData);
-			fprintf(stderr, " R7KRECID_7kBathymetricData\n");
+#ifdef MBR_RESON7KR_PTHREADS
+		if (ostore->writequeue_depth > 0)
+			status = mbr_reson7kr_wr_queueping(verbose, mbio_ptr, store_ptr, error);
+		else
 #endif
-
-			/*mbsys_reson7k_print_bathymetry(verbose, &(store->bathymetry), error);*/
-
-			status = mbr_reson7kr_wr_bathymetry(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-			buffer = (char *)*bufferptr;
-			write_len = (size_t)size;
-			status = mb_fileio_put(verbose, mbio_ptr, buffer, &write_len, error);
+		{
+			status = mbr_reson7kr_wr_sizeping(verbose, store_ptr, (void *)ostore, &(ostore->encodeping), error);
+			if (status == MB_SUCCESS)
+				status = mbr_reson7kr_wr_encodeping(verbose, store_ptr, &(ostore->encodeping), ostore->encode_threads, error);
+			if (status == MB_SUCCESS)
+				status = mbr_reson7kr_wr_commitping(verbose, mbio_ptr, store_ptr, &(ostore->encodeping), error);
 		}
+	}
 
-		/* Processed sidescan - MB-System extension to 7k format (record 3199) */
-		if (status == MB_SUCCESS && store->read_processedsidescan == MB_YES) {
-			store->type = R7KRECID_ProcessedSidescan;
-#ifdef MBR_RESON7KR_DEBUG2
-			fprintf(stderr, "Writing record id: %4.4X | %d", R7KRECID_ProcessedSidescan, R7KRECID_ProcessedSidescan);
-			fprintf(stderr, " R7KRECID_ProcessedSidescan\n");
-#endif
-
-			/*mbsys_reson7k_print_processedsidescan(verbose, &(store->processedsidescan), error);*/
-
-			status = mbr_reson7kr_wr_processedsidescan(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-			buffer = (char *)*bufferptr;
-			write_len = (size_t)size;
-			status = mb_fileio_put(verbose, mbio_ptr, buffer, &write_len, error);
-		}
-
-		/* Reson 7k backscatter imagery data (record 7007) */
-		if (status == MB_SUCCESS && store->read_backscatter == MB_YES) {
-			store->type = R7KRECID_7kBackscatterImageData;
-#ifdef MBR_RESON7KR_DEBUG2
-			fprintf(stderr, "Writing record id: %4.4X | %d", R7KRECID_7kBackscatterImageData, R7KRECID_7kBackscatterImageData);
-			fprintf(stderr, " R7KRECID_7kBackscatterImageData\n");
-#endif
-			status = mbr_reson7kr_wr_backscatter(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-			buffer = (char *)*bufferptr;
-			write_len = (size_t)size;
-			status = mb_fileio_put(verbose, mbio_ptr, buffer, &write_len, error);
-		}
-
-		/* Reson 7k beam data (record 7008) */
-		if (status == MB_SUCCESS && store->read_beam == MB_YES) {
-			store->type = R7KRECID_7kBeamData;
-#ifdef MBR_RESON7KR_DEBUG2
-			fprintf(stderr, "Writing record id: %4.4X | %d", R7KRECID_7kBeamData, R7KRECID_7kBeamData);
-			fprintf(stderr, " R7KRECID_7kBeamData\n");
-#endif
-			status = mbr_reson7kr_wr_beam(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-			buffer = (char *)*bufferptr;
-			write_len = (size_t)size;
-			status = mb_fileio_put(verbose, mbio_ptr, buffer, &write_len, error);
-		}
-
-		/* Reson 7k vertical depth (record 7009) */
-		if (status == MB_SUCCESS && store->read_verticaldepth == MB_YES) {
-			store->type = R7KRECID_7kVerticalDepth;
-#ifdef MBR_RESON7KR_DEBUG2
-			fprintf(stderr, "Writing record id: %4.4X | %d", R7KRECID_7kVerticalDepth, R7KRECID_7kVerticalDepth);
-			fprintf(stderr, " R7KRECID_7kVerticalDepth\n");
-#endif
-			status = mbr_reson7kr_wr_verticaldepth(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-			buffer = (char *)*bufferptr;
-			write_len = (size_t)size;
-			status = mb_fileio_put(verbose, mbio_ptr, buffer, &write_len, error);
-		}
-
-		/* Reson 7k tvg data (record 7010) */
-		if (status == MB_SUCCESS && store->read_tvg == MB_YES) {
-			store->type = R7KRECID_7kTVGData;
-#ifdef MBR_RESON7KR_DEBUG2
-			fprintf(stderr, "Writing record id: %4.4X | %d", R7KRECID_7kTVGData, R7KRECID_7kTVGData);
-			fprintf(stderr, " R7KRECID_7kTVGData\n");
-#endif
-			status = mbr_reson7kr_wr_tvg(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-			buffer = (char *)*bufferptr;
-			write_len = (size_t)size;
-			status = mb_fileio_put(verbose, mbio_ptr, buffer, &write_len, error);
-		}
-
-		/* Reson 7k image data (record 7011) */
-		if (status == MB_SUCCESS && store->read_image == MB_YES) {
-			store->type = R7KRECID_7kImageData;
-#ifdef MBR_RESON7KR_DEBUG2
-			fprintf(stderr, "Writing record id: %4.4X | %d", R7KRECID_7kImageData, R7KRECID_7kImageData);
-			fprintf(stderr, " R7KRECID_7kImageData\n");
-#endif
-			status = mbr_reson7kr_wr_image(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-			buffer = (char *)*bufferptr;
-			write_len = (size_t)size;
-			status = mb_fileio_put(verbose, mbio_ptr, buffer, &write_len, error);
-		}
-
-		/* Reson 7k Ping motion (record 7012) */
-		if (status == MB_SUCCESS && store->read_v2pingmotion == MB_YES) {
-			store->type = R7KRECID_7kV2PingMotion;
-#ifdef MBR_RESON7KR_DEBUG2
-			fprintf(stderr, "Writing record id: %4.4X | %d", R7KRECID_7kV2PingMotion, R7KRECID_7kV2PingMotion);
-			fprintf(stderr, " R7KRECID_7kV2PingMotion\n");
-#endif
-			status = mbr_reson7kr_wr_v2pingmotion(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-			buffer = (char *)*bufferptr;
-			write_len = (size_t)size;
-			status = mb_fileio_put(verbose, mbio_ptr, buffer, &write_len, error);
-		}
-
-		/* Reson 7k detection setup (record 7017) */
-		if (status == MB_SUCCESS && store->read_v2detectionsetup == MB_YES) {
-			store->type = R7KRECID_7kV2DetectionSetup;
-#ifdef MBR_RESON7KR_DEBUG2
-			fprintf(stderr, "Writing record id: %4.4X | %d", R7KRECID_7kV2DetectionSetup, R7KRECID_7kV2DetectionSetup);
-			fprintf(stderr, " R7KRECID_7kV2DetectionSetup\n");
-#endif
-			status = mbr_reson7kr_wr_v2detectionsetup(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-			buffer = (char *)*bufferptr;
-			write_len = (size_t)size;
-			status = mb_fileio_put(verbose, mbio_ptr, buffer, &write_len, error);
-		}
-
-		/* Reson 7k beamformed magnitude and phase data (record 7018) */
-		if (status == MB_SUCCESS && store->read_v2beamformed == MB_YES) {
-			store->type = R7KRECID_7kV2BeamformedData;
-#ifdef MBR_RESON7KR_DEBUG2
-			fprintf(stderr, "Writing record id: %4.4X | %d", R7KRECID_7kV2BeamformedData, R7KRECID_7kV2BeamformedData);
-			fprintf(stderr, " R7KRECID_7kV2BeamformedData\n");
-#endif
-			status = mbr_reson7kr_wr_v2beamformed(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-			buffer = (char *)*bufferptr;
-			write_len = (size_t)size;
-			status = mb_fileio_put(verbose, mbio_ptr, buffer, &write_len, error);
-		}
-
-		/* Reson 7k version 2 detection (record 7026) */
-		if (status == MB_SUCCESS && store->read_v2detection == MB_YES) {
-			store->type = R7KRECID_7kV2Detection;
-#ifdef MBR_RESON7KR_DEBUG2
-			fprintf(stderr, "Writing record id: %4.4X | %d", R7KRECID_7kV2Detection, R7KRECID_7kV2Detection);
-			fprintf(stderr, " R7KRECID_7kV2Detection\n");
-#endif
-			status = mbr_reson7kr_wr_v2detection(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-			buffer = (char *)*bufferptr;
-			write_len = (size_t)size;
-			status = mb_fileio_put(verbose, mbio_ptr, buffer, &write_len, error);
-		}
-
-		/* Reson 7k version 2 raw detection (record 7027) */
-		if (status == MB_SUCCESS && store->read_v2rawdetection == MB_YES) {
-			store->type = R7KRECID_7kV2RawDetection;
-#ifdef MBR_RESON7KR_DEBUG2
-			fprintf(stderr, "Writing record id: %4.4X | %d", R7KRECID_7kV2RawDetection, R7KRECID_7kV2RawDetection);
-			fprintf(stderr, " R7KRECID_7kV2RawDetection\n");
-#endif
-			status = mbr_reson7kr_wr_v2rawdetection(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-			buffer = (char *)*bufferptr;
-			write_len = (size_t)size;
-			status = mb_fileio_put(verbose, mbio_ptr, buffer, &write_len, error);
-		}
-
-		/* Reson 7k version 2 snippet (record 7028) */
-		if (status == MB_SUCCESS && store->read_v2snippet == MB_YES) {
-			store->type = R7KRECID_7kV2SnippetData;
-#ifdef MBR_RESON7KR_DEBUG2
-			fprintf(stderr, "Writing record id: %4.4X | %d", R7KRECID_7kV2SnippetData, R7KRECID_7kV2SnippetData);
-			fprintf(stderr, " R7KRECID_7kV2SnippetData\n");
-#endif
-			status = mbr_reson7kr_wr_v2snippet(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-			buffer = (char *)*bufferptr;
-			write_len = (size_t)size;
-			status = mb_fileio_put(verbose, mbio_ptr, buffer, &write_len, error);
-		}
-
-		/* Reson 7k calibrated snippet (record 7058) */
-		if (status == MB_SUCCESS && store->read_calibratedsnippet == MB_YES) {
-			store->type = R7KRECID_7kCalibratedSnippetData;
-#ifdef MBR_RESON7KR_DEBUG2
-			fprintf(stderr, "Writing record id: %4.4X | %d", R7KRECID_7kCalibratedSnippetData, R7KRECID_7kCalibratedSnippetData);
-			fprintf(stderr, " R7KRECID_7kCalibratedSnippetData\n");
-#endif
-			status = mbr_reson7kr_wr_calibratedsnippet(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-			buffer = (char *)*bufferptr;
-			write_len = (size_t)size;
-			status = mb_fileio_put(verbose, mbio_ptr, buffer, &write_len, error);
-		}
-	}
-
-	/* call appropriate writing routine for other records */
-	else if (status == MB_SUCCESS && store->type != R7KRECID_7kFileHeader) {
+	/* call appropriate writing routine for other records */
+	else if (status == MB_SUCCESS && store->type != R7KRECID_7kFileHeader) {
 #ifdef MBR_RESON7KR_DEBUG2
 		fprintf(stderr, "Writing record id: %4.4X | %d", store->type, store->type);
 		if (store->type == R7KRECID_ReferencePoint)
@@ -10569,134 +10757,138 @@ int mbr_reson7kr_wr_data(int verbose, void *mbio_ptr, void *store_ptr, int *erro
 		if (store->type == R7KRECID_8100SonarData)
 			fprintf(stderr, " R7KRECID_8100SonarData\n");
 #endif
-		if (store->type == R7KRECID_ReferencePoint) {
-			status = mbr_reson7kr_wr_reference(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_UncalibratedSensorOffset) {
-			status = mbr_reson7kr_wr_sensoruncal(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_CalibratedSensorOffset) {
-			status = mbr_reson7kr_wr_sensorcal(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_Position) {
-			status = mbr_reson7kr_wr_position(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_CustomAttitude) {
-			status = mbr_reson7kr_wr_customattitude(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_Tide) {
-			status = mbr_reson7kr_wr_tide(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_Altitude) {
-			status = mbr_reson7kr_wr_altitude(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_MotionOverGround) {
-			status = mbr_reson7kr_wr_motion(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_Depth) {
-			status = mbr_reson7kr_wr_depth(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_SoundVelocityProfile) {
-			status = mbr_reson7kr_wr_svp(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_CTD) {
-			status = mbr_reson7kr_wr_ctd(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_Geodesy) {
-			status = mbr_reson7kr_wr_geodesy(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_RollPitchHeave) {
-			status = mbr_reson7kr_wr_rollpitchheave(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_Heading) {
-			status = mbr_reson7kr_wr_heading(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_SurveyLine) {
-			status = mbr_reson7kr_wr_surveyline(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_Navigation) {
-			status = mbr_reson7kr_wr_navigation(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_Attitude) {
-			status = mbr_reson7kr_wr_attitude(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_Rec1022) {
-			status = mbr_reson7kr_wr_rec1022(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_FSDWsidescan && store->sstype == R7KRECID_FSDWsidescanLo) {
-			status = mbr_reson7kr_wr_fsdwsslo(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_FSDWsidescan && store->sstype == R7KRECID_FSDWsidescanHi) {
-			status = mbr_reson7kr_wr_fsdwsshi(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_FSDWsubbottom) {
-			status = mbr_reson7kr_wr_fsdwsb(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_Bluefin) {
-			status = mbr_reson7kr_wr_bluefin(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_ProcessedSidescan) {
-			status = mbr_reson7kr_wr_processedsidescan(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_7kVolatileSonarSettings) {
-			status = mbr_reson7kr_wr_volatilesonarsettings(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_7kConfiguration) {
-			status = mbr_reson7kr_wr_configuration(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_7kV2FirmwareHardwareConfiguration) {
-			status = mbr_reson7kr_wr_v2firmwarehardwareconfiguration(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_7kCalibrationData) {
-			status = mbr_reson7kr_wr_calibration(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_7kV2BITEData) {
-			status = mbr_reson7kr_wr_v2bite(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_7kV27kCenterVersion) {
-			status = mbr_reson7kr_wr_v27kcenterversion(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_7kV28kWetEndVersion) {
-			status = mbr_reson7kr_wr_v28kwetendversion(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_7kInstallationParameters) {
-			status = mbr_reson7kr_wr_installation(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_7kSystemEventMessage) {
-			status = mbr_reson7kr_wr_systemeventmessage(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_7kRemoteControlSonarSettings) {
-			status = mbr_reson7kr_wr_remotecontrolsettings(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_7kReserved) {
-			status = mbr_reson7kr_wr_reserved(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_7kRoll) {
-			status = mbr_reson7kr_wr_roll(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_7kPitch) {
-			status = mbr_reson7kr_wr_pitch(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_7kSoundVelocity) {
-			status = mbr_reson7kr_wr_soundvelocity(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_7kAbsorptionLoss) {
-			status = mbr_reson7kr_wr_absorptionloss(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else if (store->type == R7KRECID_7kSpreadingLoss) {
-			status = mbr_reson7kr_wr_spreadingloss(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
-		}
-		else {
-			fprintf(stderr, "call nothing bad kind: %d type %x\n", store->kind, store->type);
-			status = MB_FAILURE;
-			*error = MB_ERROR_BAD_KIND;
-		}
+		/* pass the record through unchanged if it has not been modified */
+		status = mbr_reson7kr_wr_rawrecord(verbose, mbio_ptr, store_ptr, store->type, &rawwritten, error);
+		if (status == MB_SUCCESS && rawwritten == MB_NO) {
+			if (store->type == R7KRECID_ReferencePoint) {
+				status = mbr_reson7kr_wr_reference(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_UncalibratedSensorOffset) {
+				status = mbr_reson7kr_wr_sensoruncal(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_CalibratedSensorOffset) {
+				status = mbr_reson7kr_wr_sensorcal(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_Position) {
+				status = mbr_reson7kr_wr_position(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_CustomAttitude) {
+				status = mbr_reson7kr_wr_customattitude(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_Tide) {
+				status = mbr_reson7kr_wr_tide(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_Altitude) {
+				status = mbr_reson7kr_wr_altitude(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_MotionOverGround) {
+				status = mbr_reson7kr_wr_motion(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_Depth) {
+				status = mbr_reson7kr_wr_depth(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_SoundVelocityProfile) {
+				status = mbr_reson7kr_wr_svp(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_CTD) {
+				status = mbr_reson7kr_wr_ctd(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_Geodesy) {
+				status = mbr_reson7kr_wr_geodesy(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_RollPitchHeave) {
+				status = mbr_reson7kr_wr_rollpitchheave(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_Heading) {
+				status = mbr_reson7kr_wr_heading(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_SurveyLine) {
+				status = mbr_reson7kr_wr_surveyline(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_Navigation) {
+				status = mbr_reson7kr_wr_navigation(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_Attitude) {
+				status = mbr_reson7kr_wr_attitude(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_Rec1022) {
+				status = mbr_reson7kr_wr_rec1022(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_FSDWsidescan && store->sstype == R7KRECID_FSDWsidescanLo) {
+				status = mbr_reson7kr_wr_fsdwsslo(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_FSDWsidescan && store->sstype == R7KRECID_FSDWsidescanHi) {
+				status = mbr_reson7kr_wr_fsdwsshi(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_FSDWsubbottom) {
+				status = mbr_reson7kr_wr_fsdwsb(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_Bluefin) {
+				status = mbr_reson7kr_wr_bluefin(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_ProcessedSidescan) {
+				status = mbr_reson7kr_wr_processedsidescan(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_7kVolatileSonarSettings) {
+				status = mbr_reson7kr_wr_volatilesonarsettings(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_7kConfiguration) {
+				status = mbr_reson7kr_wr_configuration(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_7kV2FirmwareHardwareConfiguration) {
+				status = mbr_reson7kr_wr_v2firmwarehardwareconfiguration(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_7kCalibrationData) {
+				status = mbr_reson7kr_wr_calibration(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_7kV2BITEData) {
+				status = mbr_reson7kr_wr_v2bite(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_7kV27kCenterVersion) {
+				status = mbr_reson7kr_wr_v27kcenterversion(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_7kV28kWetEndVersion) {
+				status = mbr_reson7kr_wr_v28kwetendversion(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_7kInstallationParameters) {
+				status = mbr_reson7kr_wr_installation(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_7kSystemEventMessage) {
+				status = mbr_reson7kr_wr_systemeventmessage(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_7kRemoteControlSonarSettings) {
+				status = mbr_reson7kr_wr_remotecontrolsettings(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_7kReserved) {
+				status = mbr_reson7kr_wr_reserved(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_7kRoll) {
+				status = mbr_reson7kr_wr_roll(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_7kPitch) {
+				status = mbr_reson7kr_wr_pitch(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_7kSoundVelocity) {
+				status = mbr_reson7kr_wr_soundvelocity(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_7kAbsorptionLoss) {
+				status = mbr_reson7kr_wr_absorptionloss(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else if (store->type == R7KRECID_7kSpreadingLoss) {
+				status = mbr_reson7kr_wr_spreadingloss(verbose, bufferalloc, bufferptr, store_ptr, &size, error);
+			}
+			else {
+				fprintf(stderr, "call nothing bad kind: %d type %x\n", store->kind, store->type);
+				status = MB_FAILURE;
+				*error = MB_ERROR_BAD_KIND;
+			}
 
-		/* finally write the record to the output file */
-		if (status == MB_SUCCESS) {
-			buffer = (char *)*bufferptr;
-			write_len = (size_t)size;
-			status = mb_fileio_put(verbose, mbio_ptr, buffer, &write_len, error);
+			/* finally write the record to the output file */
+			if (status == MB_SUCCESS) {
+				buffer = (char *)*bufferptr;
+				write_len = (size_t)size;
+				status = mbr_reson7kr_wr_putrecord(verbose, mbio_ptr, buffer, &write_len, error);
+			}
 		}
 	}
 
@@ -10717,10 +10909,9 @@ int mbr_reson7kr_wr_data(int verbose, void *mbio_ptr, void *store_ptr, int *erro
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_header(int verbose, char *buffer, int *index, s7k_header *header, int *error) {
-	char *function_name = "mbr_reson7kr_wr_header";
+int mbr_reson7kr_wr_dbtable(int verbose, int *error) {
+	char *function_name = "mbr_reson7kr_wr_dbtable";
 	int status = MB_SUCCESS;
-	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -10728,76 +10919,20 @@ int mbr_reson7kr_wr_header(int verbose, char *buffer, int *index, s7k_header *he
 		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
-		fprintf(stderr, "dbg2       buffer:     %p\n", (void *)buffer);
-		fprintf(stderr, "dbg2       index:      %d\n", *index);
-		fprintf(stderr, "dbg2       header:     %p\n", (void *)header);
-	}
-
-	/* set some important values */
-	header->Version = 5;
-	header->Offset = 60;
-	header->SyncPattern = 0x0000ffff;
-	header->Reserved = 0;
-	for (i = 0; i < 8; i++) {
-		header->PreviousRecord[i] = -1;
-		header->NextRecord[i] = -1;
 	}
-	header->Flags = 0;
-	header->Reserved2 = 0;
 
-/* print out the data to be output */
-#ifdef MBR_RESON7KR_DEBUG2
-	if (verbose > 0)
+	/* tabulate the conversion once rather than computing it per sample */
+#ifdef MBR_RESON7KR_PTHREADS
+	pthread_once(&mbr_reson7kr_dbtable_once, mbr_reson7kr_dbtable_init);
 #else
-	if (verbose >= 2)
+	if (mbr_reson7kr_dbtable_set == MB_NO)
+		mbr_reson7kr_dbtable_init();
 #endif
-		mbsys_reson7k_print_header(verbose, header, error);
-
-	/* insert the header */
-	mb_put_binary_short(MB_YES, header->Version, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, header->Offset, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_int(MB_YES, header->SyncPattern, &buffer[*index]);
-	*index += 4;
-	mb_put_binary_int(MB_YES, header->Size, &buffer[*index]);
-	*index += 4;
-	mb_put_binary_int(MB_YES, header->OffsetToOptionalData, &buffer[*index]);
-	*index += 4;
-	mb_put_binary_int(MB_YES, header->OptionalDataIdentifier, &buffer[*index]);
-	*index += 4;
-	mb_put_binary_short(MB_YES, header->s7kTime.Year, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, header->s7kTime.Day, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_float(MB_YES, header->s7kTime.Seconds, &buffer[*index]);
-	*index += 4;
-	buffer[*index] = header->s7kTime.Hours;
-	(*index)++;
-	buffer[*index] = header->s7kTime.Minutes;
-	(*index)++;
-	mb_put_binary_short(MB_YES, header->Reserved, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_int(MB_YES, header->RecordType, &buffer[*index]);
-	*index += 4;
-	mb_put_binary_int(MB_YES, header->DeviceId, &buffer[*index]);
-	*index += 4;
-	mb_put_binary_short(MB_YES, header->Reserved2, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, header->SystemEnumerator, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_int(MB_YES, header->RecordNumber, &buffer[*index]);
-	*index += 4;
-	mb_put_binary_short(MB_YES, header->Flags, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, header->Reserved3, &buffer[*index]);
-	*index += 2;
 
 	/* print output debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       index:      %d\n", *index);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:  %d\n", status);
@@ -10807,16 +10942,30 @@ int mbr_reson7kr_wr_header(int verbose, char *buffer, int *index, s7k_header *he
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_reference(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_reference";
+void mbr_reson7kr_dbtable_init(void) {
+	int i;
+
+	/* the 8 bit magnitude is 20*log10 of the 16 bit magnitude expressed in
+	    1/256 dB steps and truncated to the upper byte (i.e. whole dB) */
+	mbr_reson7kr_dbtable[0] = 0;
+	for (i = 1; i < 65536; i++)
+		mbr_reson7kr_dbtable[i] = (mb_u_char)(((unsigned int)(256.0 * 20.0 * log10((double)i))) >> 8);
+	mbr_reson7kr_dbtable_set = MB_YES;
+}
+/*--------------------------------------------------------------------*/
+int mbr_reson7kr_wr_sizeping(int verbose, void *store_ptr, void *ostore_ptr, s7k_encodeping *encodeping, int *error) {
+	char *function_name = "mbr_reson7kr_wr_sizeping";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
-	s7k_header *header;
-	s7kr_reference *reference;
-	unsigned int checksum;
-	int index;
-	char *buffer;
-	int i;
+	struct mbsys_reson7k_struct *ostore;
+	s7k_rawrecord *rawrecord;
+	s7k_encodebuffer *encodebuffer;
+	int recordid;
+	int size;
+	int nbottom;
+	int ncompressedmax;
+	int divisor;
+	int i, j;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -10824,83 +10973,116 @@ int mbr_reson7kr_wr_reference(int verbose, int *bufferalloc, char **bufferptr, v
 		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
-		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
-		fprintf(stderr, "dbg2       bufferptr:  %p\n", (void *)bufferptr);
 		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       ostore_ptr: %p\n", (void *)ostore_ptr);
+		fprintf(stderr, "dbg2       encodeping: %p\n", (void *)encodeping);
 	}
 
-	/* get pointer to raw data structure */
+	/* get pointers to the store being written and the internal store
+	    holding the output settings */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	reference = &(store->reference);
-	header = &(reference->header);
-
-/* print out the data to be output */
-#ifdef MBR_RESON7KR_DEBUG2
-	if (verbose > 0)
-#else
-	if (verbose >= 2)
-#endif
-		mbsys_reson7k_print_reference(verbose, reference, error);
-
-	/* figure out size of output record */
-	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_ReferencePoint;
-
-	/* allocate memory to write rest of record if necessary */
-	if (*bufferalloc < *size) {
-		status = mb_reallocd(verbose, __FILE__, __LINE__, *size, (void **)bufferptr, error);
-		if (status != MB_SUCCESS) {
-			*bufferalloc = 0;
+	ostore = (struct mbsys_reson7k_struct *)ostore_ptr;
+
+	/* list the ping records to be written in output order - the bits of
+	    the ping record registry are in output order */
+	encodeping->nrecord = 0;
+	encodeping->flags = ostore->compresswatercolumn_flags;
+	for (i = 0; i < R7KRAW_Other; i++) {
+		if (store->read_mask & (1u << i)) {
+			recordid = mbsys_reson7k_rawrecord_id(i);
+			if (recordid == R7KRECID_7kV2BeamformedData && ostore->compresswatercolumn == MB_YES)
+				recordid = R7KRECID_7kCompressedWaterColumn;
+			encodeping->recordids[encodeping->nrecord] = recordid;
+			encodeping->nrecord++;
+		}
+	}
+
+	/* set up the encoding buffers - records that can be passed through
+	    unchanged are not encoded. Each buffer is sized here on the calling
+	    thread to the exact size of the record it will hold, so that the
+	    encoders never allocate, since mb_reallocd is not thread safe. For
+	    7042 output the last sample kept in each beam is also found here,
+	    and the sample scratch covers the longest beam after downsampling */
+	for (i = 0; i < encodeping->nrecord; i++) {
+		encodebuffer = &(encodeping->encodebuffer[i]);
+		recordid = encodeping->recordids[i];
+		if (recordid == R7KRECID_7kCompressedWaterColumn)
+			rawrecord = &(store->rawrecord[R7KRAW_BeamformedData]);
+		else
+			rawrecord = &(store->rawrecord[mbsys_reson7k_rawrecord_index(recordid)]);
+		encodebuffer->status = MB_SUCCESS;
+		encodebuffer->error = MB_ERROR_NO_ERROR;
+		encodebuffer->size = 0;
+		size = 0;
+		if (rawrecord->recordid == recordid && rawrecord->modified == MB_NO && rawrecord->size > 0) {
+			encodebuffer->recordid = R7KRECID_None;
+		}
+		else if (recordid == R7KRECID_7kCompressedWaterColumn) {
+			encodebuffer->recordid = recordid;
+			nbottom = store->bathymetry.number_beams;
+			if (store->read_mask & R7KREAD_V2Beamformed)
+				for (j = 0; j < store->v2beamformed.number_beams; j++)
+					nbottom = MAX(nbottom, store->v2beamformed.amplitudephase[j].beam_number + 1);
+			if (store->read_mask & R7KREAD_V2RawDetection)
+				for (j = 0; j < store->v2rawdetection.number_beams; j++)
+					nbottom = MAX(nbottom, store->v2rawdetection.beam_descriptor[j] + 1);
+			if (encodeping->nbottom < nbottom) {
+				encodebuffer->status = mb_reallocd(verbose, __FILE__, __LINE__, nbottom * sizeof(int),
+				                                   (void **)&(encodeping->bottom), &(encodebuffer->error));
+				if (encodebuffer->status == MB_SUCCESS)
+					encodeping->nbottom = nbottom;
+				else
+					encodeping->nbottom = 0;
+			}
+			if (encodebuffer->status == MB_SUCCESS)
+				encodebuffer->status =
+				    mbr_reson7kr_wr_compressedbottom(verbose, store_ptr, encodeping->flags, encodeping->nbottom,
+				                                     encodeping->bottom, &size, &ncompressedmax, &(encodebuffer->error));
+
+			/* downsampling gathers the output samples of one beam at a time */
+			divisor = (encodeping->flags & R7KWC_DIVISOR_MASK) >> R7KWC_DIVISOR_SHIFT;
+			if ((encodeping->flags & R7KWC_DOWNSAMPLE_MASK) == R7KWC_DOWNSAMPLE_NONE || divisor < 2)
+				ncompressedmax = 0;
+			if (encodebuffer->status == MB_SUCCESS && encodeping->nsample < ncompressedmax) {
+				encodebuffer->status = mb_reallocd(verbose, __FILE__, __LINE__, ncompressedmax * sizeof(unsigned short),
+				                                   (void **)&(encodeping->magnitude), &(encodebuffer->error));
+				if (encodebuffer->status == MB_SUCCESS)
+					encodebuffer->status = mb_reallocd(verbose, __FILE__, __LINE__, ncompressedmax * sizeof(short),
+					                                   (void **)&(encodeping->phase), &(encodebuffer->error));
+				if (encodebuffer->status == MB_SUCCESS)
+					encodeping->nsample = ncompressedmax;
+				else
+					encodeping->nsample = 0;
+			}
 		}
 		else {
-			*bufferalloc = *size;
+			encodebuffer->recordid = recordid;
+			encodebuffer->status = mbr_reson7kr_wr_recordsize(verbose, store_ptr, recordid, &size, &(encodebuffer->error));
 		}
-	}
-
-	/* proceed to write if buffer allocated */
-	if (status == MB_SUCCESS) {
-		/* get buffer for writing */
-		buffer = (char *)*bufferptr;
-
-		/* insert the header */
-		index = 0;
-		status = mbr_reson7kr_wr_header(verbose, buffer, &index, header, error);
-
-		/* insert the data */
-		mb_put_binary_float(MB_YES, reference->offset_x, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, reference->offset_y, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, reference->offset_z, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, reference->water_z, &buffer[index]);
-		index += 4;
-
-		/* reset the header size value */
-		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
-
-		/* now add the checksum */
-		checksum = 0;
-		for (i = 0; i < index; i++)
-			checksum += (unsigned char)buffer[i];
-		mb_put_binary_int(MB_YES, checksum, &buffer[index]);
-		index += 4;
 
-		/* check size */
-		if (*size != index) {
-			fprintf(stderr, "Bad size comparison: file:%s line:%d size:%d index:%d\n", __FILE__, __LINE__, *size, index);
-			status = MB_FAILURE;
-			*error = MB_ERROR_BAD_DATA;
-			*size = 0;
+		/* the buffer only grows, so it holds at least the exact size */
+		if (encodebuffer->recordid != R7KRECID_None && encodebuffer->status == MB_SUCCESS && encodebuffer->nalloc < size) {
+			encodebuffer->status =
+			    mb_reallocd(verbose, __FILE__, __LINE__, size, (void **)&(encodebuffer->buffer), &(encodebuffer->error));
+			if (encodebuffer->status == MB_SUCCESS)
+				encodebuffer->nalloc = size;
+			else
+				encodebuffer->nalloc = 0;
 		}
 	}
 
+	/* the status of each record is checked as it is written */
+	status = MB_SUCCESS;
+	*error = MB_ERROR_NO_ERROR;
+
 	/* print output debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
-		fprintf(stderr, "dbg2       size:       %d\n", *size);
+		fprintf(stderr, "dbg2       nrecord:    %d\n", encodeping->nrecord);
+		for (i = 0; i < encodeping->nrecord; i++)
+			fprintf(stderr, "dbg2       recordids[%2d]: %d nalloc:%d\n", i, encodeping->recordids[i],
+			        encodeping->encodebuffer[i].nalloc);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:  %d\n", status);
@@ -10910,15 +11092,18 @@ int mbr_reson7kr_wr_reference(int verbose, int *bufferalloc, char **bufferptr, v
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_sensoruncal(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_sensoruncal";
+int mbr_reson7kr_wr_recordsize(int verbose, void *store_ptr, int recordid, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_recordsize";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
-	s7k_header *header;
-	s7kr_sensoruncal *sensoruncal;
-	unsigned int checksum;
-	int index;
-	char *buffer;
+	s7kr_beam *beam;
+	s7kr_v2pingmotion *v2pingmotion;
+	s7kr_v2snippet *v2snippet;
+	s7kr_calibratedsnippet *calibratedsnippet;
+	int sample_type_amp;
+	int sample_type_phase;
+	int sample_type_iandq;
+	int sample_size;
 	int i;
 
 	/* print input debug statements */
@@ -10927,87 +11112,138 @@ int mbr_reson7kr_wr_sensoruncal(int verbose, int *bufferalloc, char **bufferptr,
 		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
-		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
-		fprintf(stderr, "dbg2       bufferptr:  %p\n", (void *)bufferptr);
 		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       recordid:   %d\n", recordid);
 	}
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	sensoruncal = &(store->sensoruncal);
-	header = &(sensoruncal->header);
-
-/* print out the data to be output */
-#ifdef MBR_RESON7KR_DEBUG2
-	if (verbose > 0)
-#else
-	if (verbose >= 2)
-#endif
-		mbsys_reson7k_print_sensoruncal(verbose, sensoruncal, error);
 
-	/* figure out size of output record */
+	/* figure out the size of the output record exactly as the writer of
+	    the record type does, so that its buffer can be allocated before it
+	    is encoded - 7042 output is sized by mbr_reson7kr_wr_compressedbottom() */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_UncalibratedSensorOffset;
-
-	/* allocate memory to write rest of record if necessary */
-	if (*bufferalloc < *size) {
-		status = mb_reallocd(verbose, __FILE__, __LINE__, *size, (void **)bufferptr, error);
-		if (status != MB_SUCCESS) {
-			*bufferalloc = 0;
-		}
-		else {
-			*bufferalloc = *size;
-		}
+	if (recordid == R7KRECID_7kVolatileSonarSettings) {
+		*size += R7KHDRSIZE_7kVolatileSonarSettings;
 	}
-
-	/* proceed to write if buffer allocated */
-	if (status == MB_SUCCESS) {
-		/* get buffer for writing */
-		buffer = (char *)*bufferptr;
-
-		/* insert the header */
-		index = 0;
-		status = mbr_reson7kr_wr_header(verbose, buffer, &index, header, error);
-
-		/* insert the data */
-		index = header->Offset + 4;
-		mb_put_binary_float(MB_YES, sensoruncal->offset_x, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, sensoruncal->offset_y, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, sensoruncal->offset_z, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, sensoruncal->offset_roll, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, sensoruncal->offset_pitch, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, sensoruncal->offset_yaw, &buffer[index]);
-		index += 4;
-
-		/* reset the header size value */
-		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
-
-		/* now add the checksum */
-		checksum = 0;
-		for (i = 0; i < index; i++)
-			checksum += (unsigned char)buffer[i];
-		mb_put_binary_int(MB_YES, checksum, &buffer[index]);
-		index += 4;
-
-		/* check size */
-		if (*size != index) {
-			fprintf(stderr, "Bad size comparison: file:%s line:%d size:%d index:%d\n", __FILE__, __LINE__, *size, index);
-			status = MB_FAILURE;
-			*error = MB_ERROR_BAD_DATA;
-			*size = 0;
-		}
+	else if (recordid == R7KRECID_7kMatchFilter) {
+		*size += R7KHDRSIZE_7kMatchFilter;
+	}
+	else if (recordid == R7KRECID_7kBeamGeometry) {
+		*size += R7KHDRSIZE_7kBeamGeometry;
+		*size += store->beamgeometry.number_beams * 16;
+	}
+	else if (recordid == R7KRECID_7kRemoteControlSonarSettings) {
+		*size += R7KHDRSIZE_7kRemoteControlSonarSettings;
+	}
+	else if (recordid == R7KRECID_7kBathymetricData) {
+		*size += R7KHDRSIZE_7kBathymetricData;
+		*size += store->bathymetry.number_beams * 17;
+		if (store->bathymetry.optionaldata == MB_YES)
+			*size += 45 + store->bathymetry.number_beams * 20;
+	}
+	else if (recordid == R7KRECID_ProcessedSidescan) {
+		*size += R7KHDRSIZE_ProcessedSidescan;
+		*size += store->processedsidescan.number_pixels * 8;
+	}
+	else if (recordid == R7KRECID_7kBackscatterImageData) {
+		*size += R7KHDRSIZE_7kBackscatterImageData;
+		*size += 2 * store->backscatter.number_samples * store->backscatter.sample_size;
+		if (store->backscatter.header.OffsetToOptionalData > 0)
+			*size += 28;
+	}
+	else if (recordid == R7KRECID_7kBeamData) {
+		beam = &(store->beam);
+		*size += R7KHDRSIZE_7kBeamData;
+		sample_type_amp = beam->sample_type & 15;
+		sample_type_phase = (beam->sample_type >> 4) & 15;
+		sample_type_iandq = (beam->sample_type >> 8) & 15;
+		sample_size = 0;
+		if (sample_type_amp == 1)
+			sample_size += 1;
+		else if (sample_type_amp == 2)
+			sample_size += 2;
+		else if (sample_type_amp == 3)
+			sample_size += 4;
+		if (sample_type_phase == 1)
+			sample_size += 1;
+		else if (sample_type_phase == 2)
+			sample_size += 2;
+		else if (sample_type_phase == 3)
+			sample_size += 4;
+		if (sample_type_iandq == 1)
+			sample_size += 4;
+		else if (sample_type_iandq == 2)
+			sample_size += 8;
+		for (i = 0; i < beam->number_beams; i++)
+			*size += 10 + sample_size * (beam->snippets[i].end_sample - beam->snippets[i].begin_sample + 1);
+		if (beam->header.OffsetToOptionalData > 0)
+			*size += 24 + beam->number_beams * 12;
+	}
+	else if (recordid == R7KRECID_7kVerticalDepth) {
+		*size += R7KHDRSIZE_7kVerticalDepth;
+	}
+	else if (recordid == R7KRECID_7kTVGData) {
+		*size += R7KHDRSIZE_7kTVGData;
+		*size += store->tvg.n * sizeof(float);
+	}
+	else if (recordid == R7KRECID_7kImageData) {
+		*size += R7KHDRSIZE_7kImageData;
+		*size += store->image.width * store->image.height * store->image.color_depth;
+	}
+	else if (recordid == R7KRECID_7kV2PingMotion) {
+		v2pingmotion = &(store->v2pingmotion);
+		*size += R7KHDRSIZE_7kV2PingMotion;
+		if (v2pingmotion->flags & 1)
+			*size += sizeof(float);
+		if (v2pingmotion->flags & 2)
+			*size += sizeof(float) * v2pingmotion->n;
+		if (v2pingmotion->flags & 4)
+			*size += sizeof(float) * v2pingmotion->n;
+		if (v2pingmotion->flags & 8)
+			*size += sizeof(float) * v2pingmotion->n;
+	}
+	else if (recordid == R7KRECID_7kV2DetectionSetup) {
+		*size += R7KHDRSIZE_7kV2DetectionSetup;
+		*size += store->v2detectionsetup.number_beams * store->v2detectionsetup.data_field_size;
+	}
+	else if (recordid == R7KRECID_7kV2BeamformedData) {
+		*size += R7KHDRSIZE_7kV2BeamformedData;
+		*size += 2 * sizeof(short) * store->v2beamformed.number_beams * store->v2beamformed.number_samples;
+	}
+	else if (recordid == R7KRECID_7kV2Detection) {
+		*size += R7KHDRSIZE_7kV2Detection;
+		*size += store->v2detection.number_beams * store->v2detection.data_field_size;
+	}
+	else if (recordid == R7KRECID_7kV2RawDetection) {
+		*size += R7KHDRSIZE_7kV2RawDetection;
+		*size += store->v2rawdetection.number_beams * store->v2rawdetection.data_field_size;
+	}
+	else if (recordid == R7KRECID_7kV2SnippetData) {
+		v2snippet = &(store->v2snippet);
+		*size += R7KHDRSIZE_7kV2SnippetData;
+		for (i = 0; i < v2snippet->number_beams; i++)
+			*size += R7KRDTSIZE_7kV2SnippetTimeseries + sizeof(short) * (v2snippet->snippettimeseries[i].end_sample -
+			                                                              v2snippet->snippettimeseries[i].begin_sample + 1);
+	}
+	else if (recordid == R7KRECID_7kCalibratedSnippetData) {
+		calibratedsnippet = &(store->calibratedsnippet);
+		*size += R7KHDRSIZE_7kCalibratedSnippetData;
+		for (i = 0; i < calibratedsnippet->number_beams; i++)
+			*size += R7KRDTSIZE_7kCalibratedSnippetTimeseries +
+			         sizeof(float) * (calibratedsnippet->calibratedsnippettimeseries[i].end_sample -
+			                          calibratedsnippet->calibratedsnippettimeseries[i].begin_sample + 1);
+	}
+	else {
+		*size = 0;
+		status = MB_FAILURE;
+		*error = MB_ERROR_BAD_KIND;
 	}
 
 	/* print output debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
 		fprintf(stderr, "dbg2       size:       %d\n", *size);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
@@ -11018,15 +11254,15 @@ int mbr_reson7kr_wr_sensoruncal(int verbose, int *bufferalloc, char **bufferptr,
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_sensorcal(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_sensorcal";
+int mbr_reson7kr_wr_encodeping(int verbose, void *store_ptr, s7k_encodeping *encodeping, int nthreads, int *error) {
+	char *function_name = "mbr_reson7kr_wr_encodeping";
 	int status = MB_SUCCESS;
-	struct mbsys_reson7k_struct *store;
-	s7k_header *header;
-	s7kr_sensorcal *sensorcal;
-	unsigned int checksum;
-	int index;
-	char *buffer;
+	s7k_encodebuffer *encodebuffer;
+#ifdef MBR_RESON7KR_PTHREADS
+	struct mbr_reson7kr_encodework_struct work;
+	pthread_t threads[R7KRAW_Other];
+	int nencode;
+#endif
 	int i;
 
 	/* print input debug statements */
@@ -11035,79 +11271,224 @@ int mbr_reson7kr_wr_sensorcal(int verbose, int *bufferalloc, char **bufferptr, v
 		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
-		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
-		fprintf(stderr, "dbg2       bufferptr:  %p\n", (void *)bufferptr);
 		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       encodeping: %p\n", (void *)encodeping);
+		fprintf(stderr, "dbg2       nrecord:    %d\n", encodeping->nrecord);
+		fprintf(stderr, "dbg2       nthreads:   %d\n", nthreads);
+	}
+
+#ifdef MBR_RESON7KR_PTHREADS
+	/* encode the records in parallel - each thread takes the next record
+	    not yet encoded, and each record is encoded into its own buffer from
+	    its own part of the store, so the order of writing is kept */
+	nencode = 0;
+	for (i = 0; i < encodeping->nrecord; i++)
+		if (encodeping->encodebuffer[i].recordid != R7KRECID_None && encodeping->encodebuffer[i].status == MB_SUCCESS)
+			nencode++;
+	nthreads = MIN(nthreads, nencode) - 1;
+	if (nthreads > 0) {
+		work.verbose = verbose;
+		work.store_ptr = store_ptr;
+		work.encodeping = encodeping;
+		work.next = 0;
+		pthread_mutex_init(&work.mutex, NULL);
+		for (i = 0; i < nthreads; i++) {
+			if (pthread_create(&threads[i], NULL, mbr_reson7kr_wr_encodethread, (void *)&work) != 0)
+				break;
+		}
+		nthreads = i;
+		mbr_reson7kr_wr_encodethread((void *)&work);
+		for (i = 0; i < nthreads; i++)
+			pthread_join(threads[i], NULL);
+		pthread_mutex_destroy(&work.mutex);
 	}
-
-	/* get pointer to raw data structure */
-	store = (struct mbsys_reson7k_struct *)store_ptr;
-	sensorcal = &(store->sensorcal);
-	header = &(sensorcal->header);
-
-/* print out the data to be output */
-#ifdef MBR_RESON7KR_DEBUG2
-	if (verbose > 0)
-#else
-	if (verbose >= 2)
+	else
 #endif
-		mbsys_reson7k_print_sensorcal(verbose, sensorcal, error);
-
-	/* figure out size of output record */
-	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_CalibratedSensorOffset;
-
-	/* allocate memory to write rest of record if necessary */
-	if (*bufferalloc < *size) {
-		status = mb_reallocd(verbose, __FILE__, __LINE__, *size, (void **)bufferptr, error);
-		if (status != MB_SUCCESS) {
-			*bufferalloc = 0;
-		}
-		else {
-			*bufferalloc = *size;
+	{
+		/* encode the records in turn */
+		for (i = 0; i < encodeping->nrecord; i++) {
+			encodebuffer = &(encodeping->encodebuffer[i]);
+			if (encodebuffer->recordid != R7KRECID_None && encodebuffer->status == MB_SUCCESS)
+				mbr_reson7kr_wr_encoderecord(verbose, store_ptr, encodeping, encodebuffer, &(encodebuffer->error));
 		}
 	}
 
-	/* proceed to write if buffer allocated */
-	if (status == MB_SUCCESS) {
-		/* get buffer for writing */
-		buffer = (char *)*bufferptr;
-
-		/* insert the header */
-		index = 0;
-		status = mbr_reson7kr_wr_header(verbose, buffer, &index, header, error);
+	/* the status of each record is checked as it is written */
+	status = MB_SUCCESS;
+	*error = MB_ERROR_NO_ERROR;
 
-		/* insert the data */
-		index = header->Offset + 4;
-		mb_put_binary_float(MB_YES, sensorcal->offset_x, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, sensorcal->offset_y, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, sensorcal->offset_z, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, sensorcal->offset_roll, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, sensorcal->offset_pitch, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, sensorcal->offset_yaw, &buffer[index]);
-		index += 4;
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:  %d\n", status);
+	}
 
-		/* reset the header size value */
-		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+#ifdef MBR_RESON7KR_PTHREADS
+void *mbr_reson7kr_wr_encodethread(void *work_ptr) {
+	struct mbr_reson7kr_encodework_struct *work;
+	s7k_encodebuffer *encodebuffer;
+	int i;
 
-		/* now add the checksum */
-		checksum = 0;
-		for (i = 0; i < index; i++)
-			checksum += (unsigned char)buffer[i];
-		mb_put_binary_int(MB_YES, checksum, &buffer[index]);
-		index += 4;
+	work = (struct mbr_reson7kr_encodework_struct *)work_ptr;
 
-		/* check size */
-		if (*size != index) {
-			fprintf(stderr, "Bad size comparison: file:%s line:%d size:%d index:%d\n", __FILE__, __LINE__, *size, index);
-			status = MB_FAILURE;
-			*error = MB_ERROR_BAD_DATA;
-			*size = 0;
+	/* take records until none are left */
+	while (MB_YES) {
+		pthread_mutex_lock(&work->mutex);
+		i = work->next;
+		work->next++;
+		pthread_mutex_unlock(&work->mutex);
+		if (i >= work->encodeping->nrecord)
+			break;
+		encodebuffer = &(work->encodeping->encodebuffer[i]);
+		if (encodebuffer->recordid != R7KRECID_None && encodebuffer->status == MB_SUCCESS)
+			mbr_reson7kr_wr_encoderecord(work->verbose, work->store_ptr, work->encodeping, encodebuffer,
+			                             &(encodebuffer->error));
+	}
+
+	return (NULL);
+}
+/*--------------------------------------------------------------------*/
+#endif
+int mbr_reson7kr_wr_encoderecord(int verbose, void *store_ptr, s7k_encodeping *encodeping, s7k_encodebuffer *encodebuffer,
+                                 int *error) {
+	char *function_name = "mbr_reson7kr_wr_encoderecord";
+	int status = MB_SUCCESS;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
+		fprintf(stderr, "dbg2       store_ptr:    %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       encodeping:   %p\n", (void *)encodeping);
+		fprintf(stderr, "dbg2       encodebuffer: %p\n", (void *)encodebuffer);
+		fprintf(stderr, "dbg2       recordid:     %d\n", encodebuffer->recordid);
+	}
+
+	/* call the encoder for this record type */
+	if (encodebuffer->recordid == R7KRECID_7kVolatileSonarSettings)
+		status = mbr_reson7kr_wr_volatilesonarsettings(verbose, &(encodebuffer->nalloc), &(encodebuffer->buffer), store_ptr,
+		                                               &(encodebuffer->size), error);
+	else if (encodebuffer->recordid == R7KRECID_7kMatchFilter)
+		status = mbr_reson7kr_wr_matchfilter(verbose, &(encodebuffer->nalloc), &(encodebuffer->buffer), store_ptr,
+		                                     &(encodebuffer->size), error);
+	else if (encodebuffer->recordid == R7KRECID_7kBeamGeometry)
+		status = mbr_reson7kr_wr_beamgeometry(verbose, &(encodebuffer->nalloc), &(encodebuffer->buffer), store_ptr,
+		                                      &(encodebuffer->size), error);
+	else if (encodebuffer->recordid == R7KRECID_7kRemoteControlSonarSettings)
+		status = mbr_reson7kr_wr_remotecontrolsettings(verbose, &(encodebuffer->nalloc), &(encodebuffer->buffer), store_ptr,
+		                                               &(encodebuffer->size), error);
+	else if (encodebuffer->recordid == R7KRECID_7kBathymetricData)
+		status = mbr_reson7kr_wr_bathymetry(verbose, &(encodebuffer->nalloc), &(encodebuffer->buffer), store_ptr,
+		                                    &(encodebuffer->size), error);
+	else if (encodebuffer->recordid == R7KRECID_ProcessedSidescan)
+		status = mbr_reson7kr_wr_processedsidescan(verbose, &(encodebuffer->nalloc), &(encodebuffer->buffer), store_ptr,
+		                                           &(encodebuffer->size), error);
+	else if (encodebuffer->recordid == R7KRECID_7kBackscatterImageData)
+		status = mbr_reson7kr_wr_backscatter(verbose, &(encodebuffer->nalloc), &(encodebuffer->buffer), store_ptr,
+		                                     &(encodebuffer->size), error);
+	else if (encodebuffer->recordid == R7KRECID_7kBeamData)
+		status = mbr_reson7kr_wr_beam(verbose, &(encodebuffer->nalloc), &(encodebuffer->buffer), store_ptr,
+		                              &(encodebuffer->size), error);
+	else if (encodebuffer->recordid == R7KRECID_7kVerticalDepth)
+		status = mbr_reson7kr_wr_verticaldepth(verbose, &(encodebuffer->nalloc), &(encodebuffer->buffer), store_ptr,
+		                                       &(encodebuffer->size), error);
+	else if (encodebuffer->recordid == R7KRECID_7kTVGData)
+		status = mbr_reson7kr_wr_tvg(verbose, &(encodebuffer->nalloc), &(encodebuffer->buffer), store_ptr,
+		                             &(encodebuffer->size), error);
+	else if (encodebuffer->recordid == R7KRECID_7kImageData)
+		status = mbr_reson7kr_wr_image(verbose, &(encodebuffer->nalloc), &(encodebuffer->buffer), store_ptr,
+		                               &(encodebuffer->size), error);
+	else if (encodebuffer->recordid == R7KRECID_7kV2PingMotion)
+		status = mbr_reson7kr_wr_v2pingmotion(verbose, &(encodebuffer->nalloc), &(encodebuffer->buffer), store_ptr,
+		                                      &(encodebuffer->size), error);
+	else if (encodebuffer->recordid == R7KRECID_7kV2DetectionSetup)
+		status = mbr_reson7kr_wr_v2detectionsetup(verbose, &(encodebuffer->nalloc), &(encodebuffer->buffer), store_ptr,
+		                                          &(encodebuffer->size), error);
+	else if (encodebuffer->recordid == R7KRECID_7kCompressedWaterColumn)
+		status = mbr_reson7kr_wr_compressedwatercolumn(verbose, &(encodebuffer->nalloc), &(encodebuffer->buffer), store_ptr,
+		                                               encodeping->flags, encodeping->nbottom, encodeping->bottom,
+		                                               encodeping->nsample, encodeping->magnitude, encodeping->phase,
+		                                               &(encodebuffer->size), error);
+	else if (encodebuffer->recordid == R7KRECID_7kV2BeamformedData)
+		status = mbr_reson7kr_wr_v2beamformed(verbose, &(encodebuffer->nalloc), &(encodebuffer->buffer), store_ptr,
+		                                      &(encodebuffer->size), error);
+	else if (encodebuffer->recordid == R7KRECID_7kV2Detection)
+		status = mbr_reson7kr_wr_v2detection(verbose, &(encodebuffer->nalloc), &(encodebuffer->buffer), store_ptr,
+		                                     &(encodebuffer->size), error);
+	else if (encodebuffer->recordid == R7KRECID_7kV2RawDetection)
+		status = mbr_reson7kr_wr_v2rawdetection(verbose, &(encodebuffer->nalloc), &(encodebuffer->buffer), store_ptr,
+		                                        &(encodebuffer->size), error);
+	else if (encodebuffer->recordid == R7KRECID_7kV2SnippetData)
+		status = mbr_reson7kr_wr_v2snippet(verbose, &(encodebuffer->nalloc), &(encodebuffer->buffer), store_ptr,
+		                                   &(encodebuffer->size), error);
+	else if (encodebuffer->recordid == R7KRECID_7kCalibratedSnippetData)
+		status = mbr_reson7kr_wr_calibratedsnippet(verbose, &(encodebuffer->nalloc), &(encodebuffer->buffer), store_ptr,
+		                                           &(encodebuffer->size), error);
+	else {
+		status = MB_FAILURE;
+		*error = MB_ERROR_BAD_KIND;
+	}
+	encodebuffer->status = status;
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       size:       %d\n", encodebuffer->size);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:  %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbr_reson7kr_wr_commitping(int verbose, void *mbio_ptr, void *store_ptr, s7k_encodeping *encodeping, int *error) {
+	char *function_name = "mbr_reson7kr_wr_commitping";
+	int status = MB_SUCCESS;
+	s7k_encodebuffer *encodebuffer;
+	size_t write_len;
+	int rawwritten;
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       encodeping: %p\n", (void *)encodeping);
+		fprintf(stderr, "dbg2       nrecord:    %d\n", encodeping->nrecord);
+	}
+
+	/* write the records in order - passed through as read, or as encoded */
+	for (i = 0; i < encodeping->nrecord && status == MB_SUCCESS; i++) {
+#ifdef MBR_RESON7KR_DEBUG2
+		fprintf(stderr, "Writing record id: %4.4X | %d\n", encodeping->recordids[i], encodeping->recordids[i]);
+#endif
+		encodebuffer = &(encodeping->encodebuffer[i]);
+		if (encodebuffer->recordid == R7KRECID_None) {
+			status = mbr_reson7kr_wr_rawrecord(verbose, mbio_ptr, store_ptr, encodeping->recordids[i], &rawwritten, error);
+		}
+		else if (encodebuffer->status != MB_SUCCESS) {
+			status = encodebuffer->status;
+			*error = encodebuffer->error;
+		}
+		else {
+			write_len = (size_t)encodebuffer->size;
+			status = mbr_reson7kr_wr_putrecord(verbose, mbio_ptr, encodebuffer->buffer, &write_len, error);
 		}
 	}
 
@@ -11115,8 +11496,6 @@ int mbr_reson7kr_wr_sensorcal(int verbose, int *bufferalloc, char **bufferptr, v
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
-		fprintf(stderr, "dbg2       size:       %d\n", *size);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:  %d\n", status);
@@ -11126,15 +11505,17 @@ int mbr_reson7kr_wr_sensorcal(int verbose, int *bufferalloc, char **bufferptr, v
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_position(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_position";
+#ifdef MBR_RESON7KR_PTHREADS
+int mbr_reson7kr_wr_queueping(int verbose, void *mbio_ptr, void *store_ptr, int *error) {
+	char *function_name = "mbr_reson7kr_wr_queueping";
 	int status = MB_SUCCESS;
+	struct mb_io_struct *mb_io_ptr;
 	struct mbsys_reson7k_struct *store;
-	s7k_header *header;
-	s7kr_position *position;
-	unsigned int checksum;
-	int index;
-	char *buffer;
+	struct mbsys_reson7k_struct *ostore;
+	struct mbsys_reson7k_struct *slotstore;
+	struct mbr_reson7kr_writequeue_struct *queue;
+	int islot;
+	int free_error;
 	int i;
 
 	/* print input debug statements */
@@ -11143,94 +11524,203 @@ int mbr_reson7kr_wr_position(int verbose, int *bufferalloc, char **bufferptr, vo
 		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
-		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
-		fprintf(stderr, "dbg2       bufferptr:  %p\n", (void *)bufferptr);
+		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
 		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
 	}
 
-	/* get pointer to raw data structure */
+	/* get pointers to mbio descriptor, the store being written and the
+	    internal store holding the queue */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	position = &(store->position);
-	header = &(position->header);
+	ostore = (struct mbsys_reson7k_struct *)mb_io_ptr->store_data;
 
-/* print out the data to be output */
-#ifdef MBR_RESON7KR_DEBUG2
-	if (verbose > 0)
-#else
-	if (verbose >= 2)
-#endif
-		mbsys_reson7k_print_position(verbose, position, error);
+	/* set up the queue and start the encoders with the first ping - the
+	    slots hold stores of their own to take the pings handed over */
+	if (ostore->writequeue == NULL) {
+		status = mb_mallocd(verbose, __FILE__, __LINE__, sizeof(struct mbr_reson7kr_writequeue_struct),
+		                    (void **)&(ostore->writequeue), error);
+		if (status == MB_SUCCESS) {
+			queue = (struct mbr_reson7kr_writequeue_struct *)ostore->writequeue;
+			memset(queue, 0, sizeof(struct mbr_reson7kr_writequeue_struct));
+			queue->verbose = verbose;
+			queue->nslot = ostore->writequeue_depth;
+			queue->head = 0;
+			queue->count = 0;
+			queue->stop = MB_NO;
+			for (i = 0; i < queue->nslot && status == MB_SUCCESS; i++) {
+				queue->slot_state[i] = MBR_RESON7KR_WRITESLOT_EMPTY;
+				status = mbsys_reson7k_alloc(verbose, mbio_ptr, &(queue->slot_store[i]), error);
+			}
+			pthread_mutex_init(&queue->mutex, NULL);
+			pthread_cond_init(&queue->queued, NULL);
+			pthread_cond_init(&queue->encoded, NULL);
+			queue->nthreads = MAX(1, MIN(ostore->encode_threads, queue->nslot));
+			for (i = 0; i < queue->nthreads && status == MB_SUCCESS; i++) {
+				if (pthread_create(&queue->threads[i], NULL, mbr_reson7kr_wr_queuethread, (void *)queue) != 0)
+					break;
+			}
+			queue->nthreads = i;
+			if (status != MB_SUCCESS)
+				mbr_reson7kr_wr_queuefree(verbose, mbio_ptr, &free_error);
+		}
+		if (status != MB_SUCCESS)
+			ostore->writequeue_depth = 0;
+	}
+	queue = (struct mbr_reson7kr_writequeue_struct *)ostore->writequeue;
 
-	/* figure out size of output record */
-	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_Position;
+	/* wait for a free slot - when every slot is taken the oldest ping is
+	    written first, which holds the caller back to the pace of the encoders */
+	if (status == MB_SUCCESS)
+		status = mbr_reson7kr_wr_queuecommit(verbose, mbio_ptr, queue->nslot - 1, MB_YES, error);
 
-	/* allocate memory to write rest of record if necessary */
-	if (*bufferalloc < *size) {
-		status = mb_reallocd(verbose, __FILE__, __LINE__, *size, (void **)bufferptr, error);
-		if (status != MB_SUCCESS) {
-			*bufferalloc = 0;
+	/* hand the ping over to the next slot - the ping records are exchanged
+	    rather than copied, leaving the store with the records of a ping
+	    already written to be reused by the next read, and the buffers of the
+	    slot are sized here so that the encoders never allocate */
+	if (status == MB_SUCCESS) {
+		islot = (queue->head + queue->count) % queue->nslot;
+		slotstore = (struct mbsys_reson7k_struct *)queue->slot_store[islot];
+		status = mbsys_reson7k_swap_ping(verbose, store_ptr, (void *)slotstore, error);
+		slotstore->kind = store->kind;
+		slotstore->type = store->type;
+		slotstore->time_d = store->time_d;
+		for (i = 0; i < 7; i++)
+			slotstore->time_i[i] = store->time_i[i];
+		if (status == MB_SUCCESS)
+			status = mbr_reson7kr_wr_sizeping(verbose, (void *)slotstore, (void *)ostore, &(queue->slot_encodeping[islot]), error);
+
+		/* with no encoder running the ping is encoded here */
+		if (status == MB_SUCCESS && queue->nthreads == 0) {
+			status = mbr_reson7kr_wr_encodeping(verbose, (void *)slotstore, &(queue->slot_encodeping[islot]), 1, error);
+			queue->slot_state[islot] = MBR_RESON7KR_WRITESLOT_ENCODED;
+			queue->count++;
 		}
-		else {
-			*bufferalloc = *size;
+		else if (status == MB_SUCCESS) {
+			pthread_mutex_lock(&queue->mutex);
+			queue->slot_state[islot] = MBR_RESON7KR_WRITESLOT_QUEUED;
+			queue->count++;
+			pthread_cond_signal(&queue->queued);
+			pthread_mutex_unlock(&queue->mutex);
 		}
 	}
 
-	/* proceed to write if buffer allocated */
-	if (status == MB_SUCCESS) {
-		/* get buffer for writing */
-		buffer = (char *)*bufferptr;
+	/* write out whatever pings are already encoded without waiting */
+	if (status == MB_SUCCESS)
+		status = mbr_reson7kr_wr_queuecommit(verbose, mbio_ptr, 0, MB_NO, error);
 
-		/* insert the header */
-		index = 0;
-		status = mbr_reson7kr_wr_header(verbose, buffer, &index, header, error);
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:  %d\n", status);
+	}
 
-		/* insert the data */
-		index = header->Offset + 4;
-		mb_put_binary_int(MB_YES, position->datum, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, position->latency, &buffer[index]);
-		index += 4;
-		mb_put_binary_double(MB_YES, position->latitude, &buffer[index]);
-		index += 8;
-		mb_put_binary_double(MB_YES, position->longitude, &buffer[index]);
-		index += 8;
-		mb_put_binary_double(MB_YES, position->height, &buffer[index]);
-		index += 8;
-		buffer[index] = position->type;
-		index++;
-		buffer[index] = position->utm_zone;
-		index++;
-		buffer[index] = position->quality;
-		index++;
-		buffer[index] = position->method;
-		index++;
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+void *mbr_reson7kr_wr_queuethread(void *queue_ptr) {
+	struct mbr_reson7kr_writequeue_struct *queue;
+	int islot;
+	int error;
+	int i;
 
-		/* reset the header size value */
-		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
+	queue = (struct mbr_reson7kr_writequeue_struct *)queue_ptr;
+
+	/* encode the oldest queued ping until told to stop - a ping is only
+	    queued with its buffers sized, so nothing is allocated here */
+	pthread_mutex_lock(&queue->mutex);
+	while (MB_YES) {
+		islot = -1;
+		while (islot < 0) {
+			for (i = 0; i < queue->count && islot < 0; i++) {
+				if (queue->slot_state[(queue->head + i) % queue->nslot] == MBR_RESON7KR_WRITESLOT_QUEUED)
+					islot = (queue->head + i) % queue->nslot;
+			}
+			if (islot < 0 && queue->stop == MB_YES)
+				break;
+			if (islot < 0)
+				pthread_cond_wait(&queue->queued, &queue->mutex);
+		}
+		if (islot < 0)
+			break;
+		queue->slot_state[islot] = MBR_RESON7KR_WRITESLOT_ENCODING;
+		pthread_mutex_unlock(&queue->mutex);
 
-		/* now add the checksum */
-		checksum = 0;
-		for (i = 0; i < index; i++)
-			checksum += (unsigned char)buffer[i];
-		mb_put_binary_int(MB_YES, checksum, &buffer[index]);
-		index += 4;
+		mbr_reson7kr_wr_encodeping(queue->verbose, queue->slot_store[islot], &(queue->slot_encodeping[islot]), 1, &error);
 
-		/* check size */
-		if (*size != index) {
-			fprintf(stderr, "Bad size comparison: file:%s line:%d size:%d index:%d\n", __FILE__, __LINE__, *size, index);
-			status = MB_FAILURE;
-			*error = MB_ERROR_BAD_DATA;
-			*size = 0;
-		}
+		pthread_mutex_lock(&queue->mutex);
+		queue->slot_state[islot] = MBR_RESON7KR_WRITESLOT_ENCODED;
+		pthread_cond_broadcast(&queue->encoded);
+	}
+	pthread_mutex_unlock(&queue->mutex);
+
+	return (NULL);
+}
+/*--------------------------------------------------------------------*/
+int mbr_reson7kr_wr_queuecommit(int verbose, void *mbio_ptr, int nkeep, int wait, int *error) {
+	char *function_name = "mbr_reson7kr_wr_queuecommit";
+	int status = MB_SUCCESS;
+	int commit_status;
+	struct mb_io_struct *mb_io_ptr;
+	struct mbsys_reson7k_struct *ostore;
+	struct mbr_reson7kr_writequeue_struct *queue;
+	int islot;
+	int encoded;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       nkeep:      %d\n", nkeep);
+		fprintf(stderr, "dbg2       wait:       %d\n", wait);
+	}
+
+	/* get pointers to mbio descriptor and the queue */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+	ostore = (struct mbsys_reson7k_struct *)mb_io_ptr->store_data;
+	queue = (struct mbr_reson7kr_writequeue_struct *)ostore->writequeue;
+
+	/* write the oldest pings in order until no more than nkeep are left -
+	    waiting for each to be encoded if wait is set, otherwise stopping at
+	    the first one still being encoded. Only this thread writes to the
+	    file, so the order of the pings is kept */
+	while (queue != NULL && queue->count > nkeep) {
+		islot = queue->head;
+		pthread_mutex_lock(&queue->mutex);
+		while (wait == MB_YES && queue->slot_state[islot] != MBR_RESON7KR_WRITESLOT_ENCODED)
+			pthread_cond_wait(&queue->encoded, &queue->mutex);
+		encoded = (queue->slot_state[islot] == MBR_RESON7KR_WRITESLOT_ENCODED);
+		pthread_mutex_unlock(&queue->mutex);
+		if (!encoded)
+			break;
+
+		/* a ping that fails to write is dropped from the queue */
+		commit_status = mbr_reson7kr_wr_commitping(verbose, mbio_ptr, queue->slot_store[islot],
+		                                           &(queue->slot_encodeping[islot]), error);
+		if (commit_status != MB_SUCCESS)
+			status = commit_status;
+
+		pthread_mutex_lock(&queue->mutex);
+		queue->slot_state[islot] = MBR_RESON7KR_WRITESLOT_EMPTY;
+		queue->head = (queue->head + 1) % queue->nslot;
+		queue->count--;
+		pthread_mutex_unlock(&queue->mutex);
+		if (status != MB_SUCCESS)
+			break;
 	}
 
 	/* print output debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
-		fprintf(stderr, "dbg2       size:       %d\n", *size);
+		if (queue != NULL)
+			fprintf(stderr, "dbg2       count:      %d\n", queue->count);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:  %d\n", status);
@@ -11240,15 +11730,13 @@ int mbr_reson7kr_wr_position(int verbose, int *bufferalloc, char **bufferptr, vo
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_customattitude(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_customattitude";
+int mbr_reson7kr_wr_queuefree(int verbose, void *mbio_ptr, int *error) {
+	char *function_name = "mbr_reson7kr_wr_queuefree";
 	int status = MB_SUCCESS;
-	struct mbsys_reson7k_struct *store;
-	s7k_header *header;
-	s7kr_customattitude *customattitude;
-	unsigned int checksum;
-	int index;
-	char *buffer;
+	int free_status;
+	struct mb_io_struct *mb_io_ptr;
+	struct mbsys_reson7k_struct *ostore;
+	struct mbr_reson7kr_writequeue_struct *queue;
 	int i;
 
 	/* print input debug statements */
@@ -11257,141 +11745,94 @@ int mbr_reson7kr_wr_customattitude(int verbose, int *bufferalloc, char **bufferp
 		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
-		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
-		fprintf(stderr, "dbg2       bufferptr:  %p\n", (void *)bufferptr);
+		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+	}
+
+	/* get pointers to mbio descriptor and the queue */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+	ostore = (struct mbsys_reson7k_struct *)mb_io_ptr->store_data;
+	queue = (struct mbr_reson7kr_writequeue_struct *)ostore->writequeue;
+
+	if (queue != NULL) {
+		/* write out the pings still queued */
+		status = mbr_reson7kr_wr_queuecommit(verbose, mbio_ptr, 0, MB_YES, error);
+
+		/* stop the encoders */
+		pthread_mutex_lock(&queue->mutex);
+		queue->stop = MB_YES;
+		pthread_cond_broadcast(&queue->queued);
+		pthread_mutex_unlock(&queue->mutex);
+		for (i = 0; i < queue->nthreads; i++)
+			pthread_join(queue->threads[i], NULL);
+		pthread_mutex_destroy(&queue->mutex);
+		pthread_cond_destroy(&queue->queued);
+		pthread_cond_destroy(&queue->encoded);
+
+		/* free the slots and the queue */
+		for (i = 0; i < queue->nslot; i++) {
+			if (queue->slot_store[i] != NULL)
+				free_status = mbsys_reson7k_deall(verbose, mbio_ptr, &(queue->slot_store[i]), error);
+			free_status = mbsys_reson7k_free_encodeping(verbose, &(queue->slot_encodeping[i]), error);
+		}
+		free_status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(ostore->writequeue), error);
+		if (status == MB_SUCCESS && free_status != MB_SUCCESS)
+			status = free_status;
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:  %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+#endif
+/*--------------------------------------------------------------------*/
+int mbr_reson7kr_wr_rawrecord(int verbose, void *mbio_ptr, void *store_ptr, int recordid, int *written, int *error) {
+	char *function_name = "mbr_reson7kr_wr_rawrecord";
+	int status = MB_SUCCESS;
+	struct mbsys_reson7k_struct *store;
+	s7k_rawrecord *rawrecord;
+	size_t write_len;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
 		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       recordid:   %d\n", recordid);
 	}
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	customattitude = &(store->customattitude);
-	header = &(customattitude->header);
+	rawrecord = &(store->rawrecord[mbsys_reson7k_rawrecord_index(recordid)]);
 
-/* print out the data to be output */
+	/* write the record bytes as read if they are held and still valid */
+	*written = MB_NO;
+	if (rawrecord->recordid == recordid && recordid != R7KRECID_None && rawrecord->modified == MB_NO &&
+	    rawrecord->size > 0) {
 #ifdef MBR_RESON7KR_DEBUG2
-	if (verbose > 0)
-#else
-	if (verbose >= 2)
+		fprintf(stderr, "Passing through record id: %4.4X | %d size:%d\n", recordid, recordid, rawrecord->size);
 #endif
-		mbsys_reson7k_print_customattitude(verbose, customattitude, error);
-
-	/* figure out size of output record */
-	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_CustomAttitude;
-	if (customattitude->bitfield & 1)
-		*size += customattitude->n * sizeof(float);
-	if (customattitude->bitfield & 2)
-		*size += customattitude->n * sizeof(float);
-	if (customattitude->bitfield & 4)
-		*size += customattitude->n * sizeof(float);
-	if (customattitude->bitfield & 8)
-		*size += customattitude->n * sizeof(float);
-	if (customattitude->bitfield & 16)
-		*size += customattitude->n * sizeof(float);
-	if (customattitude->bitfield & 32)
-		*size += customattitude->n * sizeof(float);
-	if (customattitude->bitfield & 64)
-		*size += customattitude->n * sizeof(float);
-	if (customattitude->bitfield & 128)
-		*size += customattitude->n * sizeof(float);
-
-	/* allocate memory to write rest of record if necessary */
-	if (*bufferalloc < *size) {
-		status = mb_reallocd(verbose, __FILE__, __LINE__, *size, (void **)bufferptr, error);
-		if (status != MB_SUCCESS) {
-			*bufferalloc = 0;
-		}
-		else {
-			*bufferalloc = *size;
-		}
-	}
-
-	/* proceed to write if buffer allocated */
-	if (status == MB_SUCCESS) {
-		/* get buffer for writing */
-		buffer = (char *)*bufferptr;
-
-		/* insert the header */
-		index = 0;
-		status = mbr_reson7kr_wr_header(verbose, buffer, &index, header, error);
-
-		/* insert the data */
-		index = header->Offset + 4;
-		customattitude->bitfield = (mb_u_char)buffer[index];
-		index++;
-		customattitude->reserved = (mb_u_char)buffer[index];
-		index++;
-		mb_put_binary_short(MB_YES, customattitude->n, &buffer[index]);
-		index += 2;
-		mb_put_binary_float(MB_YES, customattitude->frequency, &buffer[index]);
-		index += 4;
-
-		if (customattitude->bitfield & 1)
-			for (i = 0; i < customattitude->n; i++) {
-				mb_put_binary_float(MB_YES, customattitude->pitch[i], &buffer[index]);
-				index += 4;
-			}
-		if (customattitude->bitfield & 2)
-			for (i = 0; i < customattitude->n; i++) {
-				mb_put_binary_float(MB_YES, customattitude->roll[i], &buffer[index]);
-				index += 4;
-			}
-		if (customattitude->bitfield & 4)
-			for (i = 0; i < customattitude->n; i++) {
-				mb_put_binary_float(MB_YES, customattitude->heading[i], &buffer[index]);
-				index += 4;
-			}
-		if (customattitude->bitfield & 8)
-			for (i = 0; i < customattitude->n; i++) {
-				mb_put_binary_float(MB_YES, customattitude->heave[i], &buffer[index]);
-				index += 4;
-			}
-		if (customattitude->bitfield & 16)
-			for (i = 0; i < customattitude->n; i++) {
-				mb_put_binary_float(MB_YES, customattitude->pitchrate[i], &buffer[index]);
-				index += 4;
-			}
-		if (customattitude->bitfield & 32)
-			for (i = 0; i < customattitude->n; i++) {
-				mb_put_binary_float(MB_YES, customattitude->rollrate[i], &buffer[index]);
-				index += 4;
-			}
-		if (customattitude->bitfield & 64)
-			for (i = 0; i < customattitude->n; i++) {
-				mb_put_binary_float(MB_YES, customattitude->headingrate[i], &buffer[index]);
-				index += 4;
-			}
-		if (customattitude->bitfield & 128)
-			for (i = 0; i < customattitude->n; i++) {
-				mb_put_binary_float(MB_YES, customattitude->heaverate[i], &buffer[index]);
-				index += 4;
-			}
-
-		/* reset the header size value */
-		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
-
-		/* now add the checksum */
-		checksum = 0;
-		for (i = 0; i < index; i++)
-			checksum += (unsigned char)buffer[i];
-		mb_put_binary_int(MB_YES, checksum, &buffer[index]);
-		index += 4;
-
-		/* check size */
-		if (*size != index) {
-			fprintf(stderr, "Bad size comparison: file:%s line:%d size:%d index:%d\n", __FILE__, __LINE__, *size, index);
-			status = MB_FAILURE;
-			*error = MB_ERROR_BAD_DATA;
-			*size = 0;
-		}
+		write_len = (size_t)rawrecord->size;
+		status = mbr_reson7kr_wr_putrecord(verbose, mbio_ptr, rawrecord->buffer, &write_len, error);
+		if (status == MB_SUCCESS)
+			*written = MB_YES;
 	}
 
 	/* print output debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
-		fprintf(stderr, "dbg2       size:       %d\n", *size);
+		fprintf(stderr, "dbg2       written:    %d\n", *written);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:  %d\n", status);
@@ -11401,16 +11842,18 @@ int mbr_reson7kr_wr_customattitude(int verbose, int *bufferalloc, char **bufferp
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_tide(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_tide";
+int mbr_reson7kr_wr_putrecord(int verbose, void *mbio_ptr, char *buffer, size_t *write_len, int *error) {
+	char *function_name = "mbr_reson7kr_wr_putrecord";
 	int status = MB_SUCCESS;
-	struct mbsys_reson7k_struct *store;
-	s7k_header *header;
-	s7kr_tide *tide;
-	unsigned int checksum;
+	struct mb_io_struct *mb_io_ptr;
+	struct mbsys_reson7k_struct *ostore;
+	s7kr_filecatalogrecord *filecatalogrecord;
+	s7kr_filecatalogrecorddata *filecatalogrecorddata;
+	s7k_filecatalogwrite *filecatalogwrite;
+	s7k_header header;
 	int index;
-	char *buffer;
-	int i;
+	int nalloc;
+	int error_catalog = MB_ERROR_NO_ERROR;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -11418,98 +11861,82 @@ int mbr_reson7kr_wr_tide(int verbose, int *bufferalloc, char **bufferptr, void *
 		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
-		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
-		fprintf(stderr, "dbg2       bufferptr:  %p\n", (void *)bufferptr);
-		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       buffer:     %p\n", (void *)buffer);
+		fprintf(stderr, "dbg2       write_len:  %zu\n", *write_len);
 	}
 
-	/* get pointer to raw data structure */
-	store = (struct mbsys_reson7k_struct *)store_ptr;
-	tide = &(store->tide);
-	header = &(tide->header);
-
-/* print out the data to be output */
-#ifdef MBR_RESON7KR_DEBUG2
-	if (verbose > 0)
-#else
-	if (verbose >= 2)
-#endif
-		mbsys_reson7k_print_tide(verbose, tide, error);
-
-	/* figure out size of output record */
-	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_Tide;
+	/* get pointer to mbio descriptor */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
 
-	/* allocate memory to write rest of record if necessary */
-	if (*bufferalloc < *size) {
-		status = mb_reallocd(verbose, __FILE__, __LINE__, *size, (void **)bufferptr, error);
-		if (status != MB_SUCCESS) {
-			*bufferalloc = 0;
+	/* the catalog is kept in the internal store of the output descriptor
+	    because the store passed to the writer may change from call to call */
+	ostore = (struct mbsys_reson7k_struct *)mb_io_ptr->store_data;
+	filecatalogrecord = &(ostore->filecatalogrecord);
+	filecatalogwrite = &(ostore->filecatalogwrite);
+
+	/* write the record */
+	status = mb_fileio_put(verbose, mbio_ptr, buffer, write_len, error);
+
+	/* add the record to the file catalog */
+	if (status == MB_SUCCESS && *write_len >= MBSYS_RESON7K_RECORDHEADER_SIZE) {
+		/* grow the catalog - at least doubling so that long files do not
+		    reallocate and copy the catalog over and over */
+		if (filecatalogrecord->nalloc <= filecatalogrecord->records_n) {
+			nalloc = MAX(MBSYS_RESON7K_BUFFER_STARTSIZE / R7KRDTSIZE_7kFileCatalogRecord, 2 * filecatalogrecord->nalloc);
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(s7kr_filecatalogrecorddata),
+			                     (void **)&(filecatalogrecord->filecatalogrecorddata), &error_catalog);
+			if (status == MB_SUCCESS) {
+				filecatalogrecord->nalloc = nalloc;
+			}
+			else {
+				filecatalogrecord->records_n = 0;
+				filecatalogrecord->nalloc = 0;
+			}
 		}
-		else {
-			*bufferalloc = *size;
+		if (status == MB_SUCCESS) {
+			index = 0;
+			mbr_reson7kr_rd_header(verbose, buffer, &index, &header, &error_catalog);
+			filecatalogrecorddata = &(filecatalogrecord->filecatalogrecorddata[filecatalogrecord->records_n]);
+			filecatalogrecorddata->size = (u32)*write_len;
+			filecatalogrecorddata->offset = filecatalogwrite->offset;
+			filecatalogrecorddata->record_type = header.RecordType;
+			filecatalogrecorddata->device_id = header.DeviceId;
+			filecatalogrecorddata->system_enumerator = header.SystemEnumerator;
+			filecatalogrecorddata->s7ktime = header.s7kTime;
+			filecatalogrecorddata->record_count = header.FragmentedTotal;
+			memset(filecatalogrecorddata->reserved, 0, sizeof(filecatalogrecorddata->reserved));
+			filecatalogrecord->records_n++;
+
+			/* keep a copy of the first file header so that its catalog
+			    pointer can be filled in once the file is complete */
+			if (header.RecordType == R7KRECID_7kFileHeader && filecatalogwrite->fileheader_size == 0) {
+				if (filecatalogwrite->fileheader_nalloc < (int)*write_len) {
+					status = mb_reallocd(verbose, __FILE__, __LINE__, *write_len, (void **)&(filecatalogwrite->fileheader),
+					                     &error_catalog);
+					if (status == MB_SUCCESS)
+						filecatalogwrite->fileheader_nalloc = (int)*write_len;
+					else
+						filecatalogwrite->fileheader_nalloc = 0;
+				}
+				if (status == MB_SUCCESS) {
+					memcpy(filecatalogwrite->fileheader, buffer, *write_len);
+					filecatalogwrite->fileheader_size = (int)*write_len;
+					filecatalogwrite->fileheader_offset = filecatalogwrite->offset;
+				}
+			}
 		}
-	}
-
-	/* proceed to write if buffer allocated */
-	if (status == MB_SUCCESS) {
-		/* get buffer for writing */
-		buffer = (char *)*bufferptr;
-
-		/* insert the header */
-		index = 0;
-		status = mbr_reson7kr_wr_header(verbose, buffer, &index, header, error);
-
-		/* insert the data */
-		index = header->Offset + 4;
-		mb_put_binary_float(MB_YES, tide->tide, &buffer[index]);
-		index += 4;
-		mb_put_binary_short(MB_YES, tide->source, &buffer[index]);
-		index += 2;
-		buffer[index] = tide->flags;
-		index++;
-		mb_get_binary_short(MB_YES, &buffer[index], &(tide->gauge));
-		index += 2;
-		mb_get_binary_int(MB_YES, &buffer[index], &(tide->datum));
-		index += 4;
-		mb_get_binary_float(MB_YES, &buffer[index], &(tide->latency));
-		index += 4;
-		mb_get_binary_double(MB_YES, &buffer[index], &(tide->latitude));
-		index += 8;
-		mb_get_binary_double(MB_YES, &buffer[index], &(tide->longitude));
-		index += 8;
-		mb_get_binary_double(MB_YES, &buffer[index], &(tide->height));
-		index += 8;
-		buffer[index] = tide->type;
-		index++;
-		buffer[index] = tide->utm_zone;
-		index++;
-
-		/* reset the header size value */
-		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
-
-		/* now add the checksum */
-		checksum = 0;
-		for (i = 0; i < index; i++)
-			checksum += (unsigned char)buffer[i];
-		mb_put_binary_int(MB_YES, checksum, &buffer[index]);
-		index += 4;
+		filecatalogwrite->offset += *write_len;
 
-		/* check size */
-		if (*size != index) {
-			fprintf(stderr, "Bad size comparison: file:%s line:%d size:%d index:%d\n", __FILE__, __LINE__, *size, index);
-			status = MB_FAILURE;
-			*error = MB_ERROR_BAD_DATA;
-			*size = 0;
-		}
+		/* failure to catalog the record does not fail the write */
+		status = MB_SUCCESS;
 	}
 
 	/* print output debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
-		fprintf(stderr, "dbg2       size:       %d\n", *size);
+		fprintf(stderr, "dbg2       records_n:  %d\n", filecatalogrecord->records_n);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:  %d\n", status);
@@ -11519,15 +11946,23 @@ int mbr_reson7kr_wr_tide(int verbose, int *bufferalloc, char **bufferptr, void *
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_altitude(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_altitude";
+int mbr_reson7kr_wr_filecatalog(int verbose, void *mbio_ptr, int *error) {
+	char *function_name = "mbr_reson7kr_wr_filecatalog";
 	int status = MB_SUCCESS;
-	struct mbsys_reson7k_struct *store;
+	struct mb_io_struct *mb_io_ptr;
+	struct mbsys_reson7k_struct *ostore;
+	s7kr_filecatalogrecord *filecatalogrecord;
+	s7kr_filecatalogrecorddata *filecatalogrecorddata;
+	s7k_filecatalogwrite *filecatalogwrite;
 	s7k_header *header;
-	s7kr_altitude *altitude;
+	char **bufferptr;
+	char *buffer;
+	int *bufferalloc;
 	unsigned int checksum;
+	size_t write_len;
+	u64 catalog_offset;
+	int size;
 	int index;
-	char *buffer;
 	int i;
 
 	/* print input debug statements */
@@ -11536,78 +11971,172 @@ int mbr_reson7kr_wr_altitude(int verbose, int *bufferalloc, char **bufferptr, vo
 		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
-		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
-		fprintf(stderr, "dbg2       bufferptr:  %p\n", (void *)bufferptr);
-		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
 	}
 
-	/* get pointer to raw data structure */
-	store = (struct mbsys_reson7k_struct *)store_ptr;
-	altitude = &(store->altitude);
-	header = &(altitude->header);
+	/* get pointer to mbio descriptor */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
 
-/* print out the data to be output */
-#ifdef MBR_RESON7KR_DEBUG2
-	if (verbose > 0)
-#else
-	if (verbose >= 2)
-#endif
-		mbsys_reson7k_print_altitude(verbose, altitude, error);
+	/* get pointers to the catalog held in the internal store */
+	ostore = (struct mbsys_reson7k_struct *)mb_io_ptr->store_data;
+	filecatalogrecord = &(ostore->filecatalogrecord);
+	filecatalogwrite = &(ostore->filecatalogwrite);
+	header = &(filecatalogrecord->header);
 
-	/* figure out size of output record */
-	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_Altitude;
+	/* get saved values */
+	bufferptr = (char **)&mb_io_ptr->saveptr1;
+	bufferalloc = (int *)&mb_io_ptr->save6;
 
-	/* allocate memory to write rest of record if necessary */
-	if (*bufferalloc < *size) {
-		status = mb_reallocd(verbose, __FILE__, __LINE__, *size, (void **)bufferptr, error);
-		if (status != MB_SUCCESS) {
-			*bufferalloc = 0;
-		}
-		else {
-			*bufferalloc = *size;
-		}
+	/* nothing to do unless records have been written */
+	if (ostore == NULL || filecatalogrecord->records_n == 0 || mb_io_ptr->mbfp == NULL) {
+		status = MB_SUCCESS;
 	}
 
-	/* proceed to write if buffer allocated */
-	if (status == MB_SUCCESS) {
-		/* get buffer for writing */
-		buffer = (char *)*bufferptr;
+	else {
+		/* figure out size of output record */
+		size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
+		size += R7KHDRSIZE_7kFileCatalogRecord;
+		size += filecatalogrecord->records_n * R7KRDTSIZE_7kFileCatalogRecord;
+
+		/* set the record header - time tagged with the last record written */
+		filecatalogrecorddata = &(filecatalogrecord->filecatalogrecorddata[filecatalogrecord->records_n - 1]);
+		header->Size = size;
+		header->OffsetToOptionalData = 0;
+		header->OptionalDataIdentifier = 0;
+		header->s7kTime = filecatalogrecorddata->s7ktime;
+		header->RecordType = R7KRECID_7kFileCatalogRecord;
+		header->DeviceId = 0;
+		header->SystemEnumerator = 0;
+		header->RecordNumber = filecatalogrecord->records_n;
+		header->Reserved3 = 0;
+		header->Reserved4 = 0;
+		header->FragmentedTotal = 0;
+		header->FragmentNumber = 0;
+		filecatalogrecord->size = R7KHDRSIZE_7kFileCatalogRecord;
+		filecatalogrecord->version = 1;
+		filecatalogrecord->reserved = 0;
 
-		/* insert the header */
-		index = 0;
-		status = mbr_reson7kr_wr_header(verbose, buffer, &index, header, error);
+		/* allocate memory to write the record if necessary */
+		if (*bufferalloc < size) {
+			status = mb_reallocd(verbose, __FILE__, __LINE__, size, (void **)bufferptr, error);
+			if (status != MB_SUCCESS)
+				*bufferalloc = 0;
+			else
+				*bufferalloc = size;
+		}
 
-		/* insert the data */
-		index = header->Offset + 4;
-		mb_put_binary_float(MB_YES, altitude->altitude, &buffer[index]);
-		index += 4;
+		/* proceed to write if buffer allocated */
+		if (status == MB_SUCCESS) {
+			/* get buffer for writing */
+			buffer = (char *)*bufferptr;
 
-		/* reset the header size value */
-		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
+			/* insert the header */
+			index = 0;
+			status = mbr_reson7kr_wr_header(verbose, buffer, &index, header, error);
 
-		/* now add the checksum */
-		checksum = 0;
-		for (i = 0; i < index; i++)
-			checksum += (unsigned char)buffer[i];
-		mb_put_binary_int(MB_YES, checksum, &buffer[index]);
-		index += 4;
+			/* insert the record type header */
+			index = header->Offset + 4;
+			mb_put_binary_int(MB_YES, filecatalogrecord->size, &buffer[index]);
+			index += 4;
+			mb_put_binary_short(MB_YES, filecatalogrecord->version, &buffer[index]);
+			index += 2;
+			mb_put_binary_int(MB_YES, filecatalogrecord->records_n, &buffer[index]);
+			index += 4;
+			mb_put_binary_int(MB_YES, filecatalogrecord->reserved, &buffer[index]);
+			index += 4;
 
-		/* check size */
-		if (*size != index) {
-			fprintf(stderr, "Bad size comparison: file:%s line:%d size:%d index:%d\n", __FILE__, __LINE__, *size, index);
-			status = MB_FAILURE;
-			*error = MB_ERROR_BAD_DATA;
-			*size = 0;
+			/* insert the catalog entries */
+			for (i = 0; i < filecatalogrecord->records_n; i++) {
+				filecatalogrecorddata = &(filecatalogrecord->filecatalogrecorddata[i]);
+				mb_put_binary_int(MB_YES, filecatalogrecorddata->size, &buffer[index]);
+				index += 4;
+				mb_put_binary_long(MB_YES, filecatalogrecorddata->offset, &buffer[index]);
+				index += 8;
+				mb_put_binary_short(MB_YES, filecatalogrecorddata->record_type, &buffer[index]);
+				index += 2;
+				mb_put_binary_short(MB_YES, filecatalogrecorddata->device_id, &buffer[index]);
+				index += 2;
+				mb_put_binary_short(MB_YES, filecatalogrecorddata->system_enumerator, &buffer[index]);
+				index += 2;
+				mb_put_binary_short(MB_YES, filecatalogrecorddata->s7ktime.Year, &buffer[index]);
+				index += 2;
+				mb_put_binary_short(MB_YES, filecatalogrecorddata->s7ktime.Day, &buffer[index]);
+				index += 2;
+				mb_put_binary_float(MB_YES, filecatalogrecorddata->s7ktime.Seconds, &buffer[index]);
+				index += 4;
+				buffer[index] = filecatalogrecorddata->s7ktime.Hours;
+				index++;
+				buffer[index] = filecatalogrecorddata->s7ktime.Minutes;
+				index++;
+				mb_put_binary_int(MB_YES, filecatalogrecorddata->record_count, &buffer[index]);
+				index += 4;
+				memset(&buffer[index], 0, 16);
+				index += 16;
+			}
+
+			/* reset the header size value */
+			mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
+
+			/* now add the checksum */
+			checksum = 0;
+			for (i = 0; i < index; i++)
+				checksum += (unsigned char)buffer[i];
+			mb_put_binary_int(MB_YES, checksum, &buffer[index]);
+			index += 4;
+
+			/* check size */
+			if (size != index) {
+				fprintf(stderr, "Bad size comparison: file:%s line:%d size:%d index:%d\n", __FILE__, __LINE__, size, index);
+				status = MB_FAILURE;
+				*error = MB_ERROR_BAD_DATA;
+			}
+		}
+
+		/* append the catalog to the file */
+		if (status == MB_SUCCESS) {
+#ifdef MBR_RESON7KR_DEBUG2
+			fprintf(stderr, "Writing record id: %4.4X | %d", R7KRECID_7kFileCatalogRecord, R7KRECID_7kFileCatalogRecord);
+			fprintf(stderr, " R7KRECID_7kFileCatalogRecord records:%d\n", filecatalogrecord->records_n);
+#endif
+			catalog_offset = filecatalogwrite->offset;
+			write_len = (size_t)size;
+			status = mb_fileio_put(verbose, mbio_ptr, buffer, &write_len, error);
+			if (status == MB_SUCCESS)
+				filecatalogwrite->offset += write_len;
+		}
+
+		/* point the file header at the catalog - this requires the output
+		    to be seekable, otherwise the catalog is left for a scan to find */
+		if (status == MB_SUCCESS && filecatalogwrite->fileheader_size > 0) {
+			buffer = filecatalogwrite->fileheader;
+			mb_get_binary_int(MB_YES, &buffer[12], &index);
+			if (index > 0 && index + R7KOPTSIZE_7kFileHeader + MBSYS_RESON7K_RECORDTAIL_SIZE <= filecatalogwrite->fileheader_size) {
+				mb_put_binary_int(MB_YES, (unsigned int)size, &buffer[index]);
+				mb_put_binary_long(MB_YES, (mb_s_long)catalog_offset, &buffer[index + 4]);
+				index = filecatalogwrite->fileheader_size - MBSYS_RESON7K_RECORDTAIL_SIZE;
+				checksum = 0;
+				for (i = 0; i < index; i++)
+					checksum += (unsigned char)buffer[i];
+				mb_put_binary_int(MB_YES, checksum, &buffer[index]);
+				if (fseeko(mb_io_ptr->mbfp, (off_t)filecatalogwrite->fileheader_offset, SEEK_SET) == 0) {
+					if (fwrite(buffer, 1, (size_t)filecatalogwrite->fileheader_size, mb_io_ptr->mbfp) !=
+					    (size_t)filecatalogwrite->fileheader_size) {
+						status = MB_FAILURE;
+						*error = MB_ERROR_WRITE_FAIL;
+					}
+					fseeko(mb_io_ptr->mbfp, 0, SEEK_END);
+				}
+			}
 		}
+
+		/* the catalog has been written */
+		filecatalogrecord->records_n = 0;
 	}
 
 	/* print output debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
-		fprintf(stderr, "dbg2       size:       %d\n", *size);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:  %d\n", status);
@@ -11617,12 +12146,102 @@ int mbr_reson7kr_wr_altitude(int verbose, int *bufferalloc, char **bufferptr, vo
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_motion(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_motion";
+int mbr_reson7kr_wr_header(int verbose, char *buffer, int *index, s7k_header *header, int *error) {
+	char *function_name = "mbr_reson7kr_wr_header";
+	int status = MB_SUCCESS;
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       buffer:     %p\n", (void *)buffer);
+		fprintf(stderr, "dbg2       index:      %d\n", *index);
+		fprintf(stderr, "dbg2       header:     %p\n", (void *)header);
+	}
+
+	/* set some important values */
+	header->Version = 5;
+	header->Offset = 60;
+	header->SyncPattern = 0x0000ffff;
+	header->Reserved = 0;
+	for (i = 0; i < 8; i++) {
+		header->PreviousRecord[i] = -1;
+		header->NextRecord[i] = -1;
+	}
+	header->Flags = 0;
+	header->Reserved2 = 0;
+
+/* print out the data to be output */
+#ifdef MBR_RESON7KR_DEBUG2
+	if (verbose > 0)
+#else
+	if (verbose >= 2)
+#endif
+		mbsys_reson7k_print_header(verbose, header, error);
+
+	/* insert the header */
+	mb_put_binary_short(MB_YES, header->Version, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, header->Offset, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_int(MB_YES, header->SyncPattern, &buffer[*index]);
+	*index += 4;
+	mb_put_binary_int(MB_YES, header->Size, &buffer[*index]);
+	*index += 4;
+	mb_put_binary_int(MB_YES, header->OffsetToOptionalData, &buffer[*index]);
+	*index += 4;
+	mb_put_binary_int(MB_YES, header->OptionalDataIdentifier, &buffer[*index]);
+	*index += 4;
+	mb_put_binary_short(MB_YES, header->s7kTime.Year, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, header->s7kTime.Day, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_float(MB_YES, header->s7kTime.Seconds, &buffer[*index]);
+	*index += 4;
+	buffer[*index] = header->s7kTime.Hours;
+	(*index)++;
+	buffer[*index] = header->s7kTime.Minutes;
+	(*index)++;
+	mb_put_binary_short(MB_YES, header->Reserved, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_int(MB_YES, header->RecordType, &buffer[*index]);
+	*index += 4;
+	mb_put_binary_int(MB_YES, header->DeviceId, &buffer[*index]);
+	*index += 4;
+	mb_put_binary_short(MB_YES, header->Reserved2, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, header->SystemEnumerator, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_int(MB_YES, header->RecordNumber, &buffer[*index]);
+	*index += 4;
+	mb_put_binary_short(MB_YES, header->Flags, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, header->Reserved3, &buffer[*index]);
+	*index += 2;
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       index:      %d\n", *index);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:  %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbr_reson7kr_wr_reference(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_reference";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_motion *motion;
+	s7kr_reference *reference;
 	unsigned int checksum;
 	int index;
 	char *buffer;
@@ -11641,8 +12260,8 @@ int mbr_reson7kr_wr_motion(int verbose, int *bufferalloc, char **bufferptr, void
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	motion = &(store->motion);
-	header = &(motion->header);
+	reference = &(store->reference);
+	header = &(reference->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -11650,15 +12269,11 @@ int mbr_reson7kr_wr_motion(int verbose, int *bufferalloc, char **bufferptr, void
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_motion(verbose, motion, error);
+		mbsys_reson7k_print_reference(verbose, reference, error);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_MotionOverGround;
-	if (motion->bitfield & 1)
-		*size += 3 * motion->n * sizeof(float);
-	if (motion->bitfield & 2)
-		*size += 3 * motion->n * sizeof(float);
+	*size += R7KHDRSIZE_ReferencePoint;
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -11681,44 +12296,14 @@ int mbr_reson7kr_wr_motion(int verbose, int *bufferalloc, char **bufferptr, void
 		status = mbr_reson7kr_wr_header(verbose, buffer, &index, header, error);
 
 		/* insert the data */
-		index = header->Offset + 4;
-		motion->bitfield = (mb_u_char)buffer[index];
-		index++;
-		motion->reserved = (mb_u_char)buffer[index];
-		index++;
-		mb_put_binary_short(MB_YES, motion->n, &buffer[index]);
-		index += 2;
-		mb_put_binary_float(MB_YES, motion->frequency, &buffer[index]);
+		mb_put_binary_float(MB_YES, reference->offset_x, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, reference->offset_y, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, reference->offset_z, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, reference->water_z, &buffer[index]);
 		index += 4;
-
-		if (motion->bitfield & 1) {
-			for (i = 0; i < motion->n; i++) {
-				mb_put_binary_float(MB_YES, motion->x[i], &buffer[index]);
-				index += 4;
-			}
-			for (i = 0; i < motion->n; i++) {
-				mb_put_binary_float(MB_YES, motion->y[i], &buffer[index]);
-				index += 4;
-			}
-			for (i = 0; i < motion->n; i++) {
-				mb_put_binary_float(MB_YES, motion->z[i], &buffer[index]);
-				index += 4;
-			}
-		}
-		if (motion->bitfield & 2) {
-			for (i = 0; i < motion->n; i++) {
-				mb_put_binary_float(MB_YES, motion->xa[i], &buffer[index]);
-				index += 4;
-			}
-			for (i = 0; i < motion->n; i++) {
-				mb_put_binary_float(MB_YES, motion->ya[i], &buffer[index]);
-				index += 4;
-			}
-			for (i = 0; i < motion->n; i++) {
-				mb_put_binary_float(MB_YES, motion->za[i], &buffer[index]);
-				index += 4;
-			}
-		}
 
 		/* reset the header size value */
 		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
@@ -11754,12 +12339,12 @@ int mbr_reson7kr_wr_motion(int verbose, int *bufferalloc, char **bufferptr, void
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_depth(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_depth";
+int mbr_reson7kr_wr_sensoruncal(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_sensoruncal";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_depth *depth;
+	s7kr_sensoruncal *sensoruncal;
 	unsigned int checksum;
 	int index;
 	char *buffer;
@@ -11778,8 +12363,8 @@ int mbr_reson7kr_wr_depth(int verbose, int *bufferalloc, char **bufferptr, void
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	depth = &(store->depth);
-	header = &(depth->header);
+	sensoruncal = &(store->sensoruncal);
+	header = &(sensoruncal->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -11787,11 +12372,11 @@ int mbr_reson7kr_wr_depth(int verbose, int *bufferalloc, char **bufferptr, void
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_depth(verbose, depth, error);
+		mbsys_reson7k_print_sensoruncal(verbose, sensoruncal, error);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_Depth;
+	*size += R7KHDRSIZE_UncalibratedSensorOffset;
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -11815,15 +12400,19 @@ int mbr_reson7kr_wr_depth(int verbose, int *bufferalloc, char **bufferptr, void
 
 		/* insert the data */
 		index = header->Offset + 4;
-		depth->descriptor = (mb_u_char)buffer[index];
-		index++;
-		depth->correction = (mb_u_char)buffer[index];
-		index++;
-		mb_put_binary_short(MB_YES, depth->reserved, &buffer[index]);
-		index += 2;
-		mb_put_binary_float(MB_YES, depth->depth, &buffer[index]);
+		mb_put_binary_float(MB_YES, sensoruncal->offset_x, &buffer[index]);
 		index += 4;
-
+		mb_put_binary_float(MB_YES, sensoruncal->offset_y, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, sensoruncal->offset_z, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, sensoruncal->offset_roll, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, sensoruncal->offset_pitch, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, sensoruncal->offset_yaw, &buffer[index]);
+		index += 4;
+
 		/* reset the header size value */
 		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
 
@@ -11858,12 +12447,12 @@ int mbr_reson7kr_wr_depth(int verbose, int *bufferalloc, char **bufferptr, void
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_svp(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_svp";
+int mbr_reson7kr_wr_sensorcal(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_sensorcal";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_svp *svp;
+	s7kr_sensorcal *sensorcal;
 	unsigned int checksum;
 	int index;
 	char *buffer;
@@ -11882,8 +12471,8 @@ int mbr_reson7kr_wr_svp(int verbose, int *bufferalloc, char **bufferptr, void *s
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	svp = &(store->svp);
-	header = &(svp->header);
+	sensorcal = &(store->sensorcal);
+	header = &(sensorcal->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -11891,12 +12480,11 @@ int mbr_reson7kr_wr_svp(int verbose, int *bufferalloc, char **bufferptr, void *s
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_svp(verbose, svp, error);
+		mbsys_reson7k_print_sensorcal(verbose, sensorcal, error);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_SoundVelocityProfile;
-	*size += R7KRDTSIZE_SoundVelocityProfile * svp->n;
+	*size += R7KHDRSIZE_CalibratedSensorOffset;
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -11920,25 +12508,18 @@ int mbr_reson7kr_wr_svp(int verbose, int *bufferalloc, char **bufferptr, void *s
 
 		/* insert the data */
 		index = header->Offset + 4;
-		svp->position_flag = (mb_u_char)buffer[index];
-		index++;
-		svp->reserved1 = (mb_u_char)buffer[index];
-		index++;
-		mb_put_binary_short(MB_YES, svp->reserved2, &buffer[index]);
-		index += 2;
-		mb_put_binary_double(MB_YES, svp->latitude, &buffer[index]);
-		index += 8;
-		mb_put_binary_double(MB_YES, svp->longitude, &buffer[index]);
-		index += 8;
-		mb_put_binary_int(MB_YES, svp->n, &buffer[index]);
+		mb_put_binary_float(MB_YES, sensorcal->offset_x, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, sensorcal->offset_y, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, sensorcal->offset_z, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, sensorcal->offset_roll, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, sensorcal->offset_pitch, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, sensorcal->offset_yaw, &buffer[index]);
 		index += 4;
-
-		for (i = 0; i < svp->n; i++) {
-			mb_put_binary_float(MB_YES, svp->depth[i], &buffer[index]);
-			index += 4;
-			mb_put_binary_float(MB_YES, svp->sound_velocity[i], &buffer[index]);
-			index += 4;
-		}
 
 		/* reset the header size value */
 		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
@@ -11974,12 +12555,12 @@ int mbr_reson7kr_wr_svp(int verbose, int *bufferalloc, char **bufferptr, void *s
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_ctd(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_ctd";
+int mbr_reson7kr_wr_position(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_position";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_ctd *ctd;
+	s7kr_position *position;
 	unsigned int checksum;
 	int index;
 	char *buffer;
@@ -11998,8 +12579,8 @@ int mbr_reson7kr_wr_ctd(int verbose, int *bufferalloc, char **bufferptr, void *s
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	ctd = &(store->ctd);
-	header = &(ctd->header);
+	position = &(store->position);
+	header = &(position->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -12007,12 +12588,11 @@ int mbr_reson7kr_wr_ctd(int verbose, int *bufferalloc, char **bufferptr, void *s
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_ctd(verbose, ctd, error);
+		mbsys_reson7k_print_position(verbose, position, error);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_CTD;
-	*size += ctd->n * R7KRDTSIZE_CTD;
+	*size += R7KHDRSIZE_Position;
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -12036,43 +12616,24 @@ int mbr_reson7kr_wr_ctd(int verbose, int *bufferalloc, char **bufferptr, void *s
 
 		/* insert the data */
 		index = header->Offset + 4;
-		mb_put_binary_float(MB_YES, ctd->frequency, &buffer[index]);
+		mb_put_binary_int(MB_YES, position->datum, &buffer[index]);
 		index += 4;
-		buffer[index] = ctd->velocity_source_flag;
-		index++;
-		buffer[index] = ctd->velocity_algorithm;
-		index++;
-		buffer[index] = ctd->conductivity_flag;
+		mb_put_binary_float(MB_YES, position->latency, &buffer[index]);
+		index += 4;
+		mb_put_binary_double(MB_YES, position->latitude, &buffer[index]);
+		index += 8;
+		mb_put_binary_double(MB_YES, position->longitude, &buffer[index]);
+		index += 8;
+		mb_put_binary_double(MB_YES, position->height, &buffer[index]);
+		index += 8;
+		buffer[index] = position->type;
 		index++;
-		buffer[index] = ctd->pressure_flag;
+		buffer[index] = position->utm_zone;
 		index++;
-		buffer[index] = ctd->position_flag;
+		buffer[index] = position->quality;
 		index++;
-		buffer[index] = ctd->validity;
+		buffer[index] = position->method;
 		index++;
-		mb_put_binary_short(MB_YES, ctd->reserved, &buffer[index]);
-		index += 2;
-		mb_put_binary_double(MB_YES, ctd->latitude, &buffer[index]);
-		index += 8;
-		mb_put_binary_double(MB_YES, ctd->longitude, &buffer[index]);
-		index += 8;
-		mb_put_binary_float(MB_YES, ctd->sample_rate, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, ctd->n, &buffer[index]);
-		index += 4;
-
-		for (i = 0; i < ctd->n; i++) {
-			mb_put_binary_float(MB_YES, ctd->conductivity_salinity[i], &buffer[index]);
-			index += 4;
-			mb_put_binary_float(MB_YES, ctd->temperature[i], &buffer[index]);
-			index += 4;
-			mb_put_binary_float(MB_YES, ctd->pressure_depth[i], &buffer[index]);
-			index += 4;
-			mb_put_binary_float(MB_YES, ctd->sound_velocity[i], &buffer[index]);
-			index += 4;
-			mb_put_binary_float(MB_YES, ctd->absorption[i], &buffer[index]);
-			index += 4;
-		}
 
 		/* reset the header size value */
 		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
@@ -12108,12 +12669,12 @@ int mbr_reson7kr_wr_ctd(int verbose, int *bufferalloc, char **bufferptr, void *s
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_geodesy(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_geodesy";
+int mbr_reson7kr_wr_customattitude(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_customattitude";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_geodesy *geodesy;
+	s7kr_customattitude *customattitude;
 	unsigned int checksum;
 	int index;
 	char *buffer;
@@ -12132,8 +12693,8 @@ int mbr_reson7kr_wr_geodesy(int verbose, int *bufferalloc, char **bufferptr, voi
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	geodesy = &(store->geodesy);
-	header = &(geodesy->header);
+	customattitude = &(store->customattitude);
+	header = &(customattitude->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -12141,11 +12702,27 @@ int mbr_reson7kr_wr_geodesy(int verbose, int *bufferalloc, char **bufferptr, voi
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_geodesy(verbose, geodesy, error);
+		mbsys_reson7k_print_customattitude(verbose, customattitude, error);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_Geodesy;
+	*size += R7KHDRSIZE_CustomAttitude;
+	if (customattitude->bitfield & 1)
+		*size += customattitude->n * sizeof(float);
+	if (customattitude->bitfield & 2)
+		*size += customattitude->n * sizeof(float);
+	if (customattitude->bitfield & 4)
+		*size += customattitude->n * sizeof(float);
+	if (customattitude->bitfield & 8)
+		*size += customattitude->n * sizeof(float);
+	if (customattitude->bitfield & 16)
+		*size += customattitude->n * sizeof(float);
+	if (customattitude->bitfield & 32)
+		*size += customattitude->n * sizeof(float);
+	if (customattitude->bitfield & 64)
+		*size += customattitude->n * sizeof(float);
+	if (customattitude->bitfield & 128)
+		*size += customattitude->n * sizeof(float);
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -12169,68 +12746,55 @@ int mbr_reson7kr_wr_geodesy(int verbose, int *bufferalloc, char **bufferptr, voi
 
 		/* insert the data */
 		index = header->Offset + 4;
-		for (i = 0; i < 32; i++) {
-			geodesy->spheroid[i] = (mb_u_char)buffer[index];
-			index++;
-		}
-		mb_put_binary_double(MB_YES, geodesy->semimajoraxis, &buffer[index]);
-		index += 8;
-		mb_put_binary_double(MB_YES, geodesy->flattening, &buffer[index]);
-		index += 8;
-		for (i = 0; i < 16; i++) {
-			geodesy->reserved1[i] = (mb_u_char)buffer[index];
-			index++;
-		}
-		for (i = 0; i < 32; i++) {
-			geodesy->datum[i] = (mb_u_char)buffer[index];
-			index++;
-		}
-		mb_put_binary_int(MB_YES, geodesy->calculation_method, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, geodesy->number_parameters, &buffer[index]);
-		index += 4;
-		mb_put_binary_double(MB_YES, geodesy->dx, &buffer[index]);
-		index += 8;
-		mb_put_binary_double(MB_YES, geodesy->dy, &buffer[index]);
-		index += 8;
-		mb_put_binary_double(MB_YES, geodesy->dz, &buffer[index]);
-		index += 8;
-		mb_put_binary_double(MB_YES, geodesy->rx, &buffer[index]);
-		index += 8;
-		mb_put_binary_double(MB_YES, geodesy->ry, &buffer[index]);
-		index += 8;
-		mb_put_binary_double(MB_YES, geodesy->rz, &buffer[index]);
-		index += 8;
-		mb_put_binary_double(MB_YES, geodesy->scale, &buffer[index]);
-		index += 8;
-		for (i = 0; i < 35; i++) {
-			geodesy->reserved2[i] = (mb_u_char)buffer[index];
-			index++;
-		}
-		for (i = 0; i < 32; i++) {
-			geodesy->grid_name[i] = (mb_u_char)buffer[index];
-			index++;
-		}
-		geodesy->distance_units = (mb_u_char)buffer[index];
+		customattitude->bitfield = (mb_u_char)buffer[index];
 		index++;
-		geodesy->angular_units = (mb_u_char)buffer[index];
+		customattitude->reserved = (mb_u_char)buffer[index];
 		index++;
-		mb_put_binary_double(MB_YES, geodesy->latitude_origin, &buffer[index]);
-		index += 8;
-		mb_put_binary_double(MB_YES, geodesy->central_meriidan, &buffer[index]);
-		index += 8;
-		mb_put_binary_double(MB_YES, geodesy->false_easting, &buffer[index]);
-		index += 8;
-		mb_put_binary_double(MB_YES, geodesy->false_northing, &buffer[index]);
-		index += 8;
-		mb_put_binary_double(MB_YES, geodesy->central_scale_factor, &buffer[index]);
-		index += 8;
-		mb_put_binary_int(MB_YES, geodesy->custum_identifier, &buffer[index]);
+		mb_put_binary_short(MB_YES, customattitude->n, &buffer[index]);
+		index += 2;
+		mb_put_binary_float(MB_YES, customattitude->frequency, &buffer[index]);
 		index += 4;
-		for (i = 0; i < 50; i++) {
-			geodesy->reserved3[i] = (mb_u_char)buffer[index];
-			index++;
-		}
+
+		if (customattitude->bitfield & 1)
+			for (i = 0; i < customattitude->n; i++) {
+				mb_put_binary_float(MB_YES, customattitude->pitch[i], &buffer[index]);
+				index += 4;
+			}
+		if (customattitude->bitfield & 2)
+			for (i = 0; i < customattitude->n; i++) {
+				mb_put_binary_float(MB_YES, customattitude->roll[i], &buffer[index]);
+				index += 4;
+			}
+		if (customattitude->bitfield & 4)
+			for (i = 0; i < customattitude->n; i++) {
+				mb_put_binary_float(MB_YES, customattitude->heading[i], &buffer[index]);
+				index += 4;
+			}
+		if (customattitude->bitfield & 8)
+			for (i = 0; i < customattitude->n; i++) {
+				mb_put_binary_float(MB_YES, customattitude->heave[i], &buffer[index]);
+				index += 4;
+			}
+		if (customattitude->bitfield & 16)
+			for (i = 0; i < customattitude->n; i++) {
+				mb_put_binary_float(MB_YES, customattitude->pitchrate[i], &buffer[index]);
+				index += 4;
+			}
+		if (customattitude->bitfield & 32)
+			for (i = 0; i < customattitude->n; i++) {
+				mb_put_binary_float(MB_YES, customattitude->rollrate[i], &buffer[index]);
+				index += 4;
+			}
+		if (customattitude->bitfield & 64)
+			for (i = 0; i < customattitude->n; i++) {
+				mb_put_binary_float(MB_YES, customattitude->headingrate[i], &buffer[index]);
+				index += 4;
+			}
+		if (customattitude->bitfield & 128)
+			for (i = 0; i < customattitude->n; i++) {
+				mb_put_binary_float(MB_YES, customattitude->heaverate[i], &buffer[index]);
+				index += 4;
+			}
 
 		/* reset the header size value */
 		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
@@ -12255,6 +12819,8 @@ int mbr_reson7kr_wr_geodesy(int verbose, int *bufferalloc, char **bufferptr, voi
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
+		fprintf(stderr, "dbg2       size:       %d\n", *size);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:  %d\n", status);
@@ -12264,12 +12830,12 @@ int mbr_reson7kr_wr_geodesy(int verbose, int *bufferalloc, char **bufferptr, voi
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_rollpitchheave(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_rollpitchheave";
+int mbr_reson7kr_wr_tide(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_tide";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_rollpitchheave *rollpitchheave;
+	s7kr_tide *tide;
 	unsigned int checksum;
 	int index;
 	char *buffer;
@@ -12288,8 +12854,8 @@ int mbr_reson7kr_wr_rollpitchheave(int verbose, int *bufferalloc, char **bufferp
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	rollpitchheave = &(store->rollpitchheave);
-	header = &(rollpitchheave->header);
+	tide = &(store->tide);
+	header = &(tide->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -12297,11 +12863,11 @@ int mbr_reson7kr_wr_rollpitchheave(int verbose, int *bufferalloc, char **bufferp
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_rollpitchheave(verbose, rollpitchheave, error);
+		mbsys_reson7k_print_tide(verbose, tide, error);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_RollPitchHeave;
+	*size += R7KHDRSIZE_Tide;
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -12325,12 +12891,28 @@ int mbr_reson7kr_wr_rollpitchheave(int verbose, int *bufferalloc, char **bufferp
 
 		/* insert the data */
 		index = header->Offset + 4;
-		mb_put_binary_float(MB_YES, rollpitchheave->roll, &buffer[index]);
+		mb_put_binary_float(MB_YES, tide->tide, &buffer[index]);
 		index += 4;
-		mb_put_binary_float(MB_YES, rollpitchheave->pitch, &buffer[index]);
+		mb_put_binary_short(MB_YES, tide->source, &buffer[index]);
+		index += 2;
+		buffer[index] = tide->flags;
+		index++;
+		mb_get_binary_short(MB_YES, &buffer[index], &(tide->gauge));
+		index += 2;
+		mb_get_binary_int(MB_YES, &buffer[index], &(tide->datum));
 		index += 4;
-		mb_put_binary_float(MB_YES, rollpitchheave->heave, &buffer[index]);
+		mb_get_binary_float(MB_YES, &buffer[index], &(tide->latency));
 		index += 4;
+		mb_get_binary_double(MB_YES, &buffer[index], &(tide->latitude));
+		index += 8;
+		mb_get_binary_double(MB_YES, &buffer[index], &(tide->longitude));
+		index += 8;
+		mb_get_binary_double(MB_YES, &buffer[index], &(tide->height));
+		index += 8;
+		buffer[index] = tide->type;
+		index++;
+		buffer[index] = tide->utm_zone;
+		index++;
 
 		/* reset the header size value */
 		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
@@ -12355,6 +12937,8 @@ int mbr_reson7kr_wr_rollpitchheave(int verbose, int *bufferalloc, char **bufferp
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
+		fprintf(stderr, "dbg2       size:       %d\n", *size);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:  %d\n", status);
@@ -12364,12 +12948,12 @@ int mbr_reson7kr_wr_rollpitchheave(int verbose, int *bufferalloc, char **bufferp
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_heading(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_heading";
+int mbr_reson7kr_wr_altitude(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_altitude";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_heading *heading;
+	s7kr_altitude *altitude;
 	unsigned int checksum;
 	int index;
 	char *buffer;
@@ -12388,8 +12972,8 @@ int mbr_reson7kr_wr_heading(int verbose, int *bufferalloc, char **bufferptr, voi
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	heading = &(store->heading);
-	header = &(heading->header);
+	altitude = &(store->altitude);
+	header = &(altitude->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -12397,11 +12981,11 @@ int mbr_reson7kr_wr_heading(int verbose, int *bufferalloc, char **bufferptr, voi
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_heading(verbose, heading, error);
+		mbsys_reson7k_print_altitude(verbose, altitude, error);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_Heading;
+	*size += R7KHDRSIZE_Altitude;
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -12425,7 +13009,7 @@ int mbr_reson7kr_wr_heading(int verbose, int *bufferalloc, char **bufferptr, voi
 
 		/* insert the data */
 		index = header->Offset + 4;
-		mb_put_binary_float(MB_YES, heading->heading, &buffer[index]);
+		mb_put_binary_float(MB_YES, altitude->altitude, &buffer[index]);
 		index += 4;
 
 		/* reset the header size value */
@@ -12451,6 +13035,8 @@ int mbr_reson7kr_wr_heading(int verbose, int *bufferalloc, char **bufferptr, voi
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
+		fprintf(stderr, "dbg2       size:       %d\n", *size);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:  %d\n", status);
@@ -12460,12 +13046,12 @@ int mbr_reson7kr_wr_heading(int verbose, int *bufferalloc, char **bufferptr, voi
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_surveyline(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_surveyline";
+int mbr_reson7kr_wr_motion(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_motion";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_surveyline *surveyline;
+	s7kr_motion *motion;
 	unsigned int checksum;
 	int index;
 	char *buffer;
@@ -12484,8 +13070,8 @@ int mbr_reson7kr_wr_surveyline(int verbose, int *bufferalloc, char **bufferptr,
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	surveyline = &(store->surveyline);
-	header = &(surveyline->header);
+	motion = &(store->motion);
+	header = &(motion->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -12493,12 +13079,15 @@ int mbr_reson7kr_wr_surveyline(int verbose, int *bufferalloc, char **bufferptr,
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_surveyline(verbose, surveyline, error);
+		mbsys_reson7k_print_motion(verbose, motion, error);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_SurveyLine;
-	*size += surveyline->n * R7KRDTSIZE_SurveyLine;
+	*size += R7KHDRSIZE_MotionOverGround;
+	if (motion->bitfield & 1)
+		*size += 3 * motion->n * sizeof(float);
+	if (motion->bitfield & 2)
+		*size += 3 * motion->n * sizeof(float);
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -12522,21 +13111,42 @@ int mbr_reson7kr_wr_surveyline(int verbose, int *bufferalloc, char **bufferptr,
 
 		/* insert the data */
 		index = header->Offset + 4;
-		mb_put_binary_short(MB_YES, surveyline->n, &buffer[index]);
-		index += 2;
-		mb_put_binary_short(MB_YES, surveyline->type, &buffer[index]);
+		motion->bitfield = (mb_u_char)buffer[index];
+		index++;
+		motion->reserved = (mb_u_char)buffer[index];
+		index++;
+		mb_put_binary_short(MB_YES, motion->n, &buffer[index]);
 		index += 2;
-		mb_put_binary_float(MB_YES, surveyline->turnradius, &buffer[index]);
+		mb_put_binary_float(MB_YES, motion->frequency, &buffer[index]);
 		index += 4;
-		for (i = 0; i < 64; i++) {
-			buffer[index] = (char)surveyline->name[i];
-			index++;
+
+		if (motion->bitfield & 1) {
+			for (i = 0; i < motion->n; i++) {
+				mb_put_binary_float(MB_YES, motion->x[i], &buffer[index]);
+				index += 4;
+			}
+			for (i = 0; i < motion->n; i++) {
+				mb_put_binary_float(MB_YES, motion->y[i], &buffer[index]);
+				index += 4;
+			}
+			for (i = 0; i < motion->n; i++) {
+				mb_put_binary_float(MB_YES, motion->z[i], &buffer[index]);
+				index += 4;
+			}
 		}
-		for (i = 0; i < surveyline->n; i++) {
-			mb_put_binary_double(MB_YES, surveyline->latitude[i], &buffer[index]);
-			index += 8;
-			mb_put_binary_double(MB_YES, surveyline->longitude[i], &buffer[index]);
-			index += 8;
+		if (motion->bitfield & 2) {
+			for (i = 0; i < motion->n; i++) {
+				mb_put_binary_float(MB_YES, motion->xa[i], &buffer[index]);
+				index += 4;
+			}
+			for (i = 0; i < motion->n; i++) {
+				mb_put_binary_float(MB_YES, motion->ya[i], &buffer[index]);
+				index += 4;
+			}
+			for (i = 0; i < motion->n; i++) {
+				mb_put_binary_float(MB_YES, motion->za[i], &buffer[index]);
+				index += 4;
+			}
 		}
 
 		/* reset the header size value */
@@ -12562,6 +13172,8 @@ int mbr_reson7kr_wr_surveyline(int verbose, int *bufferalloc, char **bufferptr,
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
+		fprintf(stderr, "dbg2       size:       %d\n", *size);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:  %d\n", status);
@@ -12571,12 +13183,12 @@ int mbr_reson7kr_wr_surveyline(int verbose, int *bufferalloc, char **bufferptr,
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_navigation(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_navigation";
+int mbr_reson7kr_wr_depth(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_depth";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_navigation *navigation;
+	s7kr_depth *depth;
 	unsigned int checksum;
 	int index;
 	char *buffer;
@@ -12595,8 +13207,8 @@ int mbr_reson7kr_wr_navigation(int verbose, int *bufferalloc, char **bufferptr,
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	navigation = &(store->navigation);
-	header = &(navigation->header);
+	depth = &(store->depth);
+	header = &(depth->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -12604,11 +13216,11 @@ int mbr_reson7kr_wr_navigation(int verbose, int *bufferalloc, char **bufferptr,
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_navigation(verbose, navigation, error);
+		mbsys_reson7k_print_depth(verbose, depth, error);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_Navigation;
+	*size += R7KHDRSIZE_Depth;
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -12632,23 +13244,13 @@ int mbr_reson7kr_wr_navigation(int verbose, int *bufferalloc, char **bufferptr,
 
 		/* insert the data */
 		index = header->Offset + 4;
-		buffer[index] = (mb_u_char)navigation->vertical_reference;
+		depth->descriptor = (mb_u_char)buffer[index];
 		index++;
-		mb_put_binary_double(MB_YES, navigation->latitude, &buffer[index]);
-		index += 8;
-		mb_put_binary_double(MB_YES, navigation->longitude, &buffer[index]);
-		index += 8;
-		mb_put_binary_float(MB_YES, navigation->position_accuracy, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, navigation->height, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, navigation->height_accuracy, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, navigation->speed, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, navigation->course, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, navigation->heading, &buffer[index]);
+		depth->correction = (mb_u_char)buffer[index];
+		index++;
+		mb_put_binary_short(MB_YES, depth->reserved, &buffer[index]);
+		index += 2;
+		mb_put_binary_float(MB_YES, depth->depth, &buffer[index]);
 		index += 4;
 
 		/* reset the header size value */
@@ -12674,6 +13276,8 @@ int mbr_reson7kr_wr_navigation(int verbose, int *bufferalloc, char **bufferptr,
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
+		fprintf(stderr, "dbg2       size:       %d\n", *size);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:  %d\n", status);
@@ -12683,12 +13287,12 @@ int mbr_reson7kr_wr_navigation(int verbose, int *bufferalloc, char **bufferptr,
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_attitude(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_attitude";
+int mbr_reson7kr_wr_svp(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_svp";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_attitude *attitude;
+	s7kr_svp *svp;
 	unsigned int checksum;
 	int index;
 	char *buffer;
@@ -12707,8 +13311,8 @@ int mbr_reson7kr_wr_attitude(int verbose, int *bufferalloc, char **bufferptr, vo
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	attitude = &(store->attitude);
-	header = &(attitude->header);
+	svp = &(store->svp);
+	header = &(svp->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -12716,12 +13320,12 @@ int mbr_reson7kr_wr_attitude(int verbose, int *bufferalloc, char **bufferptr, vo
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_attitude(verbose, attitude, error);
+		mbsys_reson7k_print_svp(verbose, svp, error);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_Attitude;
-	*size += attitude->n * R7KRDTSIZE_Attitude;
+	*size += R7KHDRSIZE_SoundVelocityProfile;
+	*size += R7KRDTSIZE_SoundVelocityProfile * svp->n;
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -12745,18 +13349,23 @@ int mbr_reson7kr_wr_attitude(int verbose, int *bufferalloc, char **bufferptr, vo
 
 		/* insert the data */
 		index = header->Offset + 4;
-		buffer[index] = attitude->n;
+		svp->position_flag = (mb_u_char)buffer[index];
 		index++;
-		for (i = 0; i < attitude->n; i++) {
-			mb_put_binary_short(MB_YES, attitude->delta_time[i], &buffer[index]);
-			index += 2;
-			mb_put_binary_float(MB_YES, attitude->roll[i], &buffer[index]);
-			index += 4;
-			mb_put_binary_float(MB_YES, attitude->pitch[i], &buffer[index]);
-			index += 4;
-			mb_put_binary_float(MB_YES, attitude->heave[i], &buffer[index]);
+		svp->reserved1 = (mb_u_char)buffer[index];
+		index++;
+		mb_put_binary_short(MB_YES, svp->reserved2, &buffer[index]);
+		index += 2;
+		mb_put_binary_double(MB_YES, svp->latitude, &buffer[index]);
+		index += 8;
+		mb_put_binary_double(MB_YES, svp->longitude, &buffer[index]);
+		index += 8;
+		mb_put_binary_int(MB_YES, svp->n, &buffer[index]);
+		index += 4;
+
+		for (i = 0; i < svp->n; i++) {
+			mb_put_binary_float(MB_YES, svp->depth[i], &buffer[index]);
 			index += 4;
-			mb_put_binary_float(MB_YES, attitude->heading[i], &buffer[index]);
+			mb_put_binary_float(MB_YES, svp->sound_velocity[i], &buffer[index]);
 			index += 4;
 		}
 
@@ -12783,6 +13392,8 @@ int mbr_reson7kr_wr_attitude(int verbose, int *bufferalloc, char **bufferptr, vo
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
+		fprintf(stderr, "dbg2       size:       %d\n", *size);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:  %d\n", status);
@@ -12792,12 +13403,12 @@ int mbr_reson7kr_wr_attitude(int verbose, int *bufferalloc, char **bufferptr, vo
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_rec1022(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_rec1022";
+int mbr_reson7kr_wr_ctd(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_ctd";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_rec1022 *rec1022;
+	s7kr_ctd *ctd;
 	unsigned int checksum;
 	int index;
 	char *buffer;
@@ -12816,8 +13427,8 @@ int mbr_reson7kr_wr_rec1022(int verbose, int *bufferalloc, char **bufferptr, voi
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	rec1022 = &(store->rec1022);
-	header = &(rec1022->header);
+	ctd = &(store->ctd);
+	header = &(ctd->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -12825,11 +13436,12 @@ int mbr_reson7kr_wr_rec1022(int verbose, int *bufferalloc, char **bufferptr, voi
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_rec1022(verbose, rec1022, error);
+		mbsys_reson7k_print_ctd(verbose, ctd, error);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_Rec1022;
+	*size += R7KHDRSIZE_CTD;
+	*size += ctd->n * R7KRDTSIZE_CTD;
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -12853,9 +13465,42 @@ int mbr_reson7kr_wr_rec1022(int verbose, int *bufferalloc, char **bufferptr, voi
 
 		/* insert the data */
 		index = header->Offset + 4;
-		for (i = 0; i < R7KHDRSIZE_Rec1022; i++) {
-			buffer[index] = rec1022->data[i];
-			index++;
+		mb_put_binary_float(MB_YES, ctd->frequency, &buffer[index]);
+		index += 4;
+		buffer[index] = ctd->velocity_source_flag;
+		index++;
+		buffer[index] = ctd->velocity_algorithm;
+		index++;
+		buffer[index] = ctd->conductivity_flag;
+		index++;
+		buffer[index] = ctd->pressure_flag;
+		index++;
+		buffer[index] = ctd->position_flag;
+		index++;
+		buffer[index] = ctd->validity;
+		index++;
+		mb_put_binary_short(MB_YES, ctd->reserved, &buffer[index]);
+		index += 2;
+		mb_put_binary_double(MB_YES, ctd->latitude, &buffer[index]);
+		index += 8;
+		mb_put_binary_double(MB_YES, ctd->longitude, &buffer[index]);
+		index += 8;
+		mb_put_binary_float(MB_YES, ctd->sample_rate, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, ctd->n, &buffer[index]);
+		index += 4;
+
+		for (i = 0; i < ctd->n; i++) {
+			mb_put_binary_float(MB_YES, ctd->conductivity_salinity[i], &buffer[index]);
+			index += 4;
+			mb_put_binary_float(MB_YES, ctd->temperature[i], &buffer[index]);
+			index += 4;
+			mb_put_binary_float(MB_YES, ctd->pressure_depth[i], &buffer[index]);
+			index += 4;
+			mb_put_binary_float(MB_YES, ctd->sound_velocity[i], &buffer[index]);
+			index += 4;
+			mb_put_binary_float(MB_YES, ctd->absorption[i], &buffer[index]);
+			index += 4;
 		}
 
 		/* reset the header size value */
@@ -12881,6 +13526,8 @@ int mbr_reson7kr_wr_rec1022(int verbose, int *bufferalloc, char **bufferptr, voi
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
+		fprintf(stderr, "dbg2       size:       %d\n", *size);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:  %d\n", status);
@@ -12890,11 +13537,15 @@ int mbr_reson7kr_wr_rec1022(int verbose, int *bufferalloc, char **bufferptr, voi
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_fsdwchannel(int verbose, int data_format, char *buffer, int *index, s7k_fsdwchannel *fsdwchannel,
-                                int *error) {
-	char *function_name = "mbr_reson7kr_wr_fsdwchannel";
+int mbr_reson7kr_wr_geodesy(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_geodesy";
 	int status = MB_SUCCESS;
-	short *shortptr;
+	struct mbsys_reson7k_struct *store;
+	s7k_header *header;
+	s7kr_geodesy *geodesy;
+	unsigned int checksum;
+	int index;
+	char *buffer;
 	int i;
 
 	/* print input debug statements */
@@ -12903,89 +13554,129 @@ int mbr_reson7kr_wr_fsdwchannel(int verbose, int data_format, char *buffer, int
 		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
-		fprintf(stderr, "dbg2       data_format:%d\n", data_format);
-		fprintf(stderr, "dbg2       index:      %d\n", *index);
-		fprintf(stderr, "dbg2       fsdwchannel:%p\n", (void *)fsdwchannel);
+		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
+		fprintf(stderr, "dbg2       bufferptr:  %p\n", (void *)bufferptr);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
 	}
 
-	/* print out the data to be output */
-	/*mbsys_reson7k_print_fsdwchannel(verbose, data_format, fsdwchannel, error);*/
+	/* get pointer to raw data structure */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+	geodesy = &(store->geodesy);
+	header = &(geodesy->header);
 
-	/* extract the channel header */
-	buffer[*index] = fsdwchannel->number;
-	(*index)++;
-	buffer[*index] = fsdwchannel->type;
-	(*index)++;
-	buffer[*index] = fsdwchannel->data_type;
-	(*index)++;
-	buffer[*index] = fsdwchannel->polarity;
-	(*index)++;
-	buffer[*index] = fsdwchannel->bytespersample;
-	(*index)++;
-	for (i = 0; i < 3; i++) {
-		buffer[*index] = fsdwchannel->reserved1[i];
-		(*index)++;
-	}
-	mb_put_binary_int(MB_YES, fsdwchannel->number_samples, &buffer[*index]);
-	*index += 4;
-	mb_put_binary_int(MB_YES, fsdwchannel->start_time, &buffer[*index]);
-	*index += 4;
-	mb_put_binary_int(MB_YES, fsdwchannel->sample_interval, &buffer[*index]);
-	*index += 4;
-	mb_put_binary_float(MB_YES, fsdwchannel->range, &buffer[*index]);
-	*index += 4;
-	mb_put_binary_float(MB_YES, fsdwchannel->voltage, &buffer[*index]);
-	*index += 4;
-	for (i = 0; i < 16; i++) {
-		buffer[*index] = fsdwchannel->name[i];
-		(*index)++;
-	}
-	for (i = 0; i < 20; i++) {
-		buffer[*index] = fsdwchannel->reserved2[i];
-		(*index)++;
+/* print out the data to be output */
+#ifdef MBR_RESON7KR_DEBUG2
+	if (verbose > 0)
+#else
+	if (verbose >= 2)
+#endif
+		mbsys_reson7k_print_geodesy(verbose, geodesy, error);
+
+	/* figure out size of output record */
+	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
+	*size += R7KHDRSIZE_Geodesy;
+
+	/* allocate memory to write rest of record if necessary */
+	if (*bufferalloc < *size) {
+		status = mb_reallocd(verbose, __FILE__, __LINE__, *size, (void **)bufferptr, error);
+		if (status != MB_SUCCESS) {
+			*bufferalloc = 0;
+		}
+		else {
+			*bufferalloc = *size;
+		}
 	}
 
-	/* copy over the data */
+	/* proceed to write if buffer allocated */
 	if (status == MB_SUCCESS) {
-		if (fsdwchannel->bytespersample == 1) {
-			for (i = 0; i < fsdwchannel->number_samples; i++) {
-				buffer[*index] = fsdwchannel->data[i];
-				(*index)++;
-			}
+		/* get buffer for writing */
+		buffer = (char *)*bufferptr;
+
+		/* insert the header */
+		index = 0;
+		status = mbr_reson7kr_wr_header(verbose, buffer, &index, header, error);
+
+		/* insert the data */
+		index = header->Offset + 4;
+		for (i = 0; i < 32; i++) {
+			geodesy->spheroid[i] = (mb_u_char)buffer[index];
+			index++;
 		}
-		else if (fsdwchannel->bytespersample == 2) {
-			shortptr = (short *)fsdwchannel->data;
-			for (i = 0; i < fsdwchannel->number_samples; i++) {
-				/*srptr = (short *) &(buffer[*index]);
-				urptr = (unsigned short *) &(buffer[*index]);*/
-				mb_put_binary_short(MB_YES, shortptr[i], &buffer[*index]);
-				*index += 2;
-				/*ssptr = (short *) &(shortptr[i]);
-				usptr = (unsigned short *) &(shortptr[i]);
-				fprintf(stderr,"sample:%5d   raw:%6d %6d   swapped:%6d %6d\n",
-				i,*srptr,*urptr,*ssptr,*usptr);*/
-			}
+		mb_put_binary_double(MB_YES, geodesy->semimajoraxis, &buffer[index]);
+		index += 8;
+		mb_put_binary_double(MB_YES, geodesy->flattening, &buffer[index]);
+		index += 8;
+		for (i = 0; i < 16; i++) {
+			geodesy->reserved1[i] = (mb_u_char)buffer[index];
+			index++;
 		}
-		else if (fsdwchannel->bytespersample == 4) {
-			shortptr = (short *)fsdwchannel->data;
-			for (i = 0; i < fsdwchannel->number_samples; i++) {
-				/*srptr = (short *) &(buffer[*index]);
-				urptr = (unsigned short *) &(buffer[*index]);*/
-				mb_put_binary_short(MB_YES, shortptr[2 * i], &buffer[*index]);
-				*index += 2;
-				/*ssptr = (short *) &(shortptr[2*i]);
-				usptr = (unsigned short *) &(shortptr[2*i]);
-				fprintf(stderr,"sample:%5d   IMAGINARY: raw:%6d %6d   swapped:%6d %6d",
-				i,*srptr,*urptr,*ssptr,*usptr);
-				srptr = (short *) &(buffer[*index]);
-				urptr = (unsigned short *) &(buffer[*index]);*/
-				mb_put_binary_short(MB_YES, shortptr[2 * i + 1], &buffer[*index]);
-				*index += 2;
-				/*ssptr = (short *) &(shortptr[2*i+1]);
-				usptr = (unsigned short *) &(shortptr[2*i+1]);
-				fprintf(stderr,"    REAL: raw:%6d %6d   swapped:%6d %6d\n",
-				*srptr,*urptr,*ssptr,*usptr);*/
-			}
+		for (i = 0; i < 32; i++) {
+			geodesy->datum[i] = (mb_u_char)buffer[index];
+			index++;
+		}
+		mb_put_binary_int(MB_YES, geodesy->calculation_method, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, geodesy->number_parameters, &buffer[index]);
+		index += 4;
+		mb_put_binary_double(MB_YES, geodesy->dx, &buffer[index]);
+		index += 8;
+		mb_put_binary_double(MB_YES, geodesy->dy, &buffer[index]);
+		index += 8;
+		mb_put_binary_double(MB_YES, geodesy->dz, &buffer[index]);
+		index += 8;
+		mb_put_binary_double(MB_YES, geodesy->rx, &buffer[index]);
+		index += 8;
+		mb_put_binary_double(MB_YES, geodesy->ry, &buffer[index]);
+		index += 8;
+		mb_put_binary_double(MB_YES, geodesy->rz, &buffer[index]);
+		index += 8;
+		mb_put_binary_double(MB_YES, geodesy->scale, &buffer[index]);
+		index += 8;
+		for (i = 0; i < 35; i++) {
+			geodesy->reserved2[i] = (mb_u_char)buffer[index];
+			index++;
+		}
+		for (i = 0; i < 32; i++) {
+			geodesy->grid_name[i] = (mb_u_char)buffer[index];
+			index++;
+		}
+		geodesy->distance_units = (mb_u_char)buffer[index];
+		index++;
+		geodesy->angular_units = (mb_u_char)buffer[index];
+		index++;
+		mb_put_binary_double(MB_YES, geodesy->latitude_origin, &buffer[index]);
+		index += 8;
+		mb_put_binary_double(MB_YES, geodesy->central_meriidan, &buffer[index]);
+		index += 8;
+		mb_put_binary_double(MB_YES, geodesy->false_easting, &buffer[index]);
+		index += 8;
+		mb_put_binary_double(MB_YES, geodesy->false_northing, &buffer[index]);
+		index += 8;
+		mb_put_binary_double(MB_YES, geodesy->central_scale_factor, &buffer[index]);
+		index += 8;
+		mb_put_binary_int(MB_YES, geodesy->custum_identifier, &buffer[index]);
+		index += 4;
+		for (i = 0; i < 50; i++) {
+			geodesy->reserved3[i] = (mb_u_char)buffer[index];
+			index++;
+		}
+
+		/* reset the header size value */
+		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
+
+		/* now add the checksum */
+		checksum = 0;
+		for (i = 0; i < index; i++)
+			checksum += (unsigned char)buffer[i];
+		mb_put_binary_int(MB_YES, checksum, &buffer[index]);
+		index += 4;
+
+		/* check size */
+		if (*size != index) {
+			fprintf(stderr, "Bad size comparison: file:%s line:%d size:%d index:%d\n", __FILE__, __LINE__, *size, index);
+			status = MB_FAILURE;
+			*error = MB_ERROR_BAD_DATA;
+			*size = 0;
 		}
 	}
 
@@ -12993,7 +13684,6 @@ int mbr_reson7kr_wr_fsdwchannel(int verbose, int data_format, char *buffer, int
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       index:      %d\n", *index);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:  %d\n", status);
@@ -13003,9 +13693,15 @@ int mbr_reson7kr_wr_fsdwchannel(int verbose, int data_format, char *buffer, int
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_fsdwssheader(int verbose, char *buffer, int *index, s7k_fsdwssheader *fsdwssheader, int *error) {
-	char *function_name = "mbr_reson7kr_wr_fsdwssheader";
+int mbr_reson7kr_wr_rollpitchheave(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_rollpitchheave";
 	int status = MB_SUCCESS;
+	struct mbsys_reson7k_struct *store;
+	s7k_header *header;
+	s7kr_rollpitchheave *rollpitchheave;
+	unsigned int checksum;
+	int index;
+	char *buffer;
 	int i;
 
 	/* print input debug statements */
@@ -13013,88 +13709,81 @@ int mbr_reson7kr_wr_fsdwssheader(int verbose, char *buffer, int *index, s7k_fsdw
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
 		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:        %d\n", verbose);
-		fprintf(stderr, "dbg2       buffer:         %p\n", (void *)buffer);
-		fprintf(stderr, "dbg2       index:          %d\n", *index);
-		fprintf(stderr, "dbg2       fsdwssheader:   %p\n", (void *)fsdwssheader);
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
+		fprintf(stderr, "dbg2       bufferptr:  %p\n", (void *)bufferptr);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
 	}
 
-	/* print out the data to be output */
-	/*mbsys_reson7k_print_fsdwssheader(verbose, fsdwssheader, error);*/
+	/* get pointer to raw data structure */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+	rollpitchheave = &(store->rollpitchheave);
+	header = &(rollpitchheave->header);
 
-	/* extract the Edgetech sidescan header */
-	mb_put_binary_short(MB_YES, fsdwssheader->subsystem, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwssheader->channelNum, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_int(MB_YES, fsdwssheader->pingNum, &buffer[*index]);
-	*index += 4;
-	mb_put_binary_short(MB_YES, fsdwssheader->packetNum, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwssheader->trigSource, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_int(MB_YES, fsdwssheader->samples, &buffer[*index]);
-	*index += 4;
-	mb_put_binary_int(MB_YES, fsdwssheader->sampleInterval, &buffer[*index]);
-	*index += 4;
-	mb_put_binary_int(MB_YES, fsdwssheader->startDepth, &buffer[*index]);
-	*index += 4;
-	mb_put_binary_short(MB_YES, fsdwssheader->weightingFactor, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwssheader->ADCGain, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwssheader->ADCMax, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwssheader->rangeSetting, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwssheader->pulseID, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwssheader->markNumber, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwssheader->dataFormat, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwssheader->reserved, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_int(MB_YES, fsdwssheader->millisecondsToday, &buffer[*index]);
-	*index += 4;
-	mb_put_binary_short(MB_YES, fsdwssheader->year, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwssheader->day, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwssheader->hour, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwssheader->minute, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwssheader->second, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwssheader->heading, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwssheader->pitch, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwssheader->roll, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwssheader->heave, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwssheader->yaw, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_int(MB_YES, fsdwssheader->depth, &buffer[*index]);
-	*index += 4;
-	mb_put_binary_short(MB_YES, fsdwssheader->temperature, &buffer[*index]);
-	*index += 2;
-	for (i = 0; i < 2; i++) {
-		buffer[*index] = fsdwssheader->reserved2[i];
-		(*index)++;
+/* print out the data to be output */
+#ifdef MBR_RESON7KR_DEBUG2
+	if (verbose > 0)
+#else
+	if (verbose >= 2)
+#endif
+		mbsys_reson7k_print_rollpitchheave(verbose, rollpitchheave, error);
+
+	/* figure out size of output record */
+	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
+	*size += R7KHDRSIZE_RollPitchHeave;
+
+	/* allocate memory to write rest of record if necessary */
+	if (*bufferalloc < *size) {
+		status = mb_reallocd(verbose, __FILE__, __LINE__, *size, (void **)bufferptr, error);
+		if (status != MB_SUCCESS) {
+			*bufferalloc = 0;
+		}
+		else {
+			*bufferalloc = *size;
+		}
+	}
+
+	/* proceed to write if buffer allocated */
+	if (status == MB_SUCCESS) {
+		/* get buffer for writing */
+		buffer = (char *)*bufferptr;
+
+		/* insert the header */
+		index = 0;
+		status = mbr_reson7kr_wr_header(verbose, buffer, &index, header, error);
+
+		/* insert the data */
+		index = header->Offset + 4;
+		mb_put_binary_float(MB_YES, rollpitchheave->roll, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, rollpitchheave->pitch, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, rollpitchheave->heave, &buffer[index]);
+		index += 4;
+
+		/* reset the header size value */
+		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
+
+		/* now add the checksum */
+		checksum = 0;
+		for (i = 0; i < index; i++)
+			checksum += (unsigned char)buffer[i];
+		mb_put_binary_int(MB_YES, checksum, &buffer[index]);
+		index += 4;
+
+		/* check size */
+		if (*size != index) {
+			fprintf(stderr, "Bad size comparison: file:%s line:%d size:%d index:%d\n", __FILE__, __LINE__, *size, index);
+			status = MB_FAILURE;
+			*error = MB_ERROR_BAD_DATA;
+			*size = 0;
+		}
 	}
-	mb_put_binary_int(MB_YES, fsdwssheader->longitude, &buffer[*index]);
-	*index += 4;
-	mb_put_binary_int(MB_YES, fsdwssheader->latitude, &buffer[*index]);
-	*index += 4;
 
 	/* print output debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       index:      %d\n", *index);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:  %d\n", status);
@@ -13104,170 +13793,1584 @@ int mbr_reson7kr_wr_fsdwssheader(int verbose, char *buffer, int *index, s7k_fsdw
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_fsdwsegyheader(int verbose, char *buffer, int *index, s7k_fsdwsegyheader *fsdwsegyheader, int *error) {
-	char *function_name = "mbr_reson7kr_wr_fsdwsegyheader";
+int mbr_reson7kr_wr_heading(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_heading";
+	int status = MB_SUCCESS;
+	struct mbsys_reson7k_struct *store;
+	s7k_header *header;
+	s7kr_heading *heading;
+	unsigned int checksum;
+	int index;
+	char *buffer;
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
+		fprintf(stderr, "dbg2       bufferptr:  %p\n", (void *)bufferptr);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+	}
+
+	/* get pointer to raw data structure */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+	heading = &(store->heading);
+	header = &(heading->header);
+
+/* print out the data to be output */
+#ifdef MBR_RESON7KR_DEBUG2
+	if (verbose > 0)
+#else
+	if (verbose >= 2)
+#endif
+		mbsys_reson7k_print_heading(verbose, heading, error);
+
+	/* figure out size of output record */
+	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
+	*size += R7KHDRSIZE_Heading;
+
+	/* allocate memory to write rest of record if necessary */
+	if (*bufferalloc < *size) {
+		status = mb_reallocd(verbose, __FILE__, __LINE__, *size, (void **)bufferptr, error);
+		if (status != MB_SUCCESS) {
+			*bufferalloc = 0;
+		}
+		else {
+			*bufferalloc = *size;
+		}
+	}
+
+	/* proceed to write if buffer allocated */
+	if (status == MB_SUCCESS) {
+		/* get buffer for writing */
+		buffer = (char *)*bufferptr;
+
+		/* insert the header */
+		index = 0;
+		status = mbr_reson7kr_wr_header(verbose, buffer, &index, header, error);
+
+		/* insert the data */
+		index = header->Offset + 4;
+		mb_put_binary_float(MB_YES, heading->heading, &buffer[index]);
+		index += 4;
+
+		/* reset the header size value */
+		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
+
+		/* now add the checksum */
+		checksum = 0;
+		for (i = 0; i < index; i++)
+			checksum += (unsigned char)buffer[i];
+		mb_put_binary_int(MB_YES, checksum, &buffer[index]);
+		index += 4;
+
+		/* check size */
+		if (*size != index) {
+			fprintf(stderr, "Bad size comparison: file:%s line:%d size:%d index:%d\n", __FILE__, __LINE__, *size, index);
+			status = MB_FAILURE;
+			*error = MB_ERROR_BAD_DATA;
+			*size = 0;
+		}
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:  %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbr_reson7kr_wr_surveyline(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_surveyline";
 	int status = MB_SUCCESS;
+	struct mbsys_reson7k_struct *store;
+	s7k_header *header;
+	s7kr_surveyline *surveyline;
+	unsigned int checksum;
+	int index;
+	char *buffer;
 	int i;
 
-	/* print input debug statements */
-	if (verbose >= 2) {
-		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
-		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
-		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:        %d\n", verbose);
-		fprintf(stderr, "dbg2       buffer:         %p\n", (void *)buffer);
-		fprintf(stderr, "dbg2       index:          %d\n", *index);
-		fprintf(stderr, "dbg2       fsdwsegyheader: %p\n", (void *)fsdwsegyheader);
-	}
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
+		fprintf(stderr, "dbg2       bufferptr:  %p\n", (void *)bufferptr);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+	}
+
+	/* get pointer to raw data structure */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+	surveyline = &(store->surveyline);
+	header = &(surveyline->header);
+
+/* print out the data to be output */
+#ifdef MBR_RESON7KR_DEBUG2
+	if (verbose > 0)
+#else
+	if (verbose >= 2)
+#endif
+		mbsys_reson7k_print_surveyline(verbose, surveyline, error);
+
+	/* figure out size of output record */
+	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
+	*size += R7KHDRSIZE_SurveyLine;
+	*size += surveyline->n * R7KRDTSIZE_SurveyLine;
+
+	/* allocate memory to write rest of record if necessary */
+	if (*bufferalloc < *size) {
+		status = mb_reallocd(verbose, __FILE__, __LINE__, *size, (void **)bufferptr, error);
+		if (status != MB_SUCCESS) {
+			*bufferalloc = 0;
+		}
+		else {
+			*bufferalloc = *size;
+		}
+	}
+
+	/* proceed to write if buffer allocated */
+	if (status == MB_SUCCESS) {
+		/* get buffer for writing */
+		buffer = (char *)*bufferptr;
+
+		/* insert the header */
+		index = 0;
+		status = mbr_reson7kr_wr_header(verbose, buffer, &index, header, error);
+
+		/* insert the data */
+		index = header->Offset + 4;
+		mb_put_binary_short(MB_YES, surveyline->n, &buffer[index]);
+		index += 2;
+		mb_put_binary_short(MB_YES, surveyline->type, &buffer[index]);
+		index += 2;
+		mb_put_binary_float(MB_YES, surveyline->turnradius, &buffer[index]);
+		index += 4;
+		for (i = 0; i < 64; i++) {
+			buffer[index] = (char)surveyline->name[i];
+			index++;
+		}
+		for (i = 0; i < surveyline->n; i++) {
+			mb_put_binary_double(MB_YES, surveyline->latitude[i], &buffer[index]);
+			index += 8;
+			mb_put_binary_double(MB_YES, surveyline->longitude[i], &buffer[index]);
+			index += 8;
+		}
+
+		/* reset the header size value */
+		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
+
+		/* now add the checksum */
+		checksum = 0;
+		for (i = 0; i < index; i++)
+			checksum += (unsigned char)buffer[i];
+		mb_put_binary_int(MB_YES, checksum, &buffer[index]);
+		index += 4;
+
+		/* check size */
+		if (*size != index) {
+			fprintf(stderr, "Bad size comparison: file:%s line:%d size:%d index:%d\n", __FILE__, __LINE__, *size, index);
+			status = MB_FAILURE;
+			*error = MB_ERROR_BAD_DATA;
+			*size = 0;
+		}
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:  %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbr_reson7kr_wr_navigation(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_navigation";
+	int status = MB_SUCCESS;
+	struct mbsys_reson7k_struct *store;
+	s7k_header *header;
+	s7kr_navigation *navigation;
+	unsigned int checksum;
+	int index;
+	char *buffer;
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
+		fprintf(stderr, "dbg2       bufferptr:  %p\n", (void *)bufferptr);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+	}
+
+	/* get pointer to raw data structure */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+	navigation = &(store->navigation);
+	header = &(navigation->header);
+
+/* print out the data to be output */
+#ifdef MBR_RESON7KR_DEBUG2
+	if (verbose > 0)
+#else
+	if (verbose >= 2)
+#endif
+		mbsys_reson7k_print_navigation(verbose, navigation, error);
+
+	/* figure out size of output record */
+	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
+	*size += R7KHDRSIZE_Navigation;
+
+	/* allocate memory to write rest of record if necessary */
+	if (*bufferalloc < *size) {
+		status = mb_reallocd(verbose, __FILE__, __LINE__, *size, (void **)bufferptr, error);
+		if (status != MB_SUCCESS) {
+			*bufferalloc = 0;
+		}
+		else {
+			*bufferalloc = *size;
+		}
+	}
+
+	/* proceed to write if buffer allocated */
+	if (status == MB_SUCCESS) {
+		/* get buffer for writing */
+		buffer = (char *)*bufferptr;
+
+		/* insert the header */
+		index = 0;
+		status = mbr_reson7kr_wr_header(verbose, buffer, &index, header, error);
+
+		/* insert the data */
+		index = header->Offset + 4;
+		buffer[index] = (mb_u_char)navigation->vertical_reference;
+		index++;
+		mb_put_binary_double(MB_YES, navigation->latitude, &buffer[index]);
+		index += 8;
+		mb_put_binary_double(MB_YES, navigation->longitude, &buffer[index]);
+		index += 8;
+		mb_put_binary_float(MB_YES, navigation->position_accuracy, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, navigation->height, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, navigation->height_accuracy, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, navigation->speed, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, navigation->course, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, navigation->heading, &buffer[index]);
+		index += 4;
+
+		/* reset the header size value */
+		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
+
+		/* now add the checksum */
+		checksum = 0;
+		for (i = 0; i < index; i++)
+			checksum += (unsigned char)buffer[i];
+		mb_put_binary_int(MB_YES, checksum, &buffer[index]);
+		index += 4;
+
+		/* check size */
+		if (*size != index) {
+			fprintf(stderr, "Bad size comparison: file:%s line:%d size:%d index:%d\n", __FILE__, __LINE__, *size, index);
+			status = MB_FAILURE;
+			*error = MB_ERROR_BAD_DATA;
+			*size = 0;
+		}
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:  %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbr_reson7kr_wr_attitude(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_attitude";
+	int status = MB_SUCCESS;
+	struct mbsys_reson7k_struct *store;
+	s7k_header *header;
+	s7kr_attitude *attitude;
+	unsigned int checksum;
+	int index;
+	char *buffer;
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
+		fprintf(stderr, "dbg2       bufferptr:  %p\n", (void *)bufferptr);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+	}
+
+	/* get pointer to raw data structure */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+	attitude = &(store->attitude);
+	header = &(attitude->header);
+
+/* print out the data to be output */
+#ifdef MBR_RESON7KR_DEBUG2
+	if (verbose > 0)
+#else
+	if (verbose >= 2)
+#endif
+		mbsys_reson7k_print_attitude(verbose, attitude, error);
+
+	/* figure out size of output record */
+	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
+	*size += R7KHDRSIZE_Attitude;
+	*size += attitude->n * R7KRDTSIZE_Attitude;
+
+	/* allocate memory to write rest of record if necessary */
+	if (*bufferalloc < *size) {
+		status = mb_reallocd(verbose, __FILE__, __LINE__, *size, (void **)bufferptr, error);
+		if (status != MB_SUCCESS) {
+			*bufferalloc = 0;
+		}
+		else {
+			*bufferalloc = *size;
+		}
+	}
+
+	/* proceed to write if buffer allocated */
+	if (status == MB_SUCCESS) {
+		/* get buffer for writing */
+		buffer = (char *)*bufferptr;
+
+		/* insert the header */
+		index = 0;
+		status = mbr_reson7kr_wr_header(verbose, buffer, &index, header, error);
+
+		/* insert the data */
+		index = header->Offset + 4;
+		buffer[index] = attitude->n;
+		index++;
+		for (i = 0; i < attitude->n; i++) {
+			mb_put_binary_short(MB_YES, attitude->delta_time[i], &buffer[index]);
+			index += 2;
+			mb_put_binary_float(MB_YES, attitude->roll[i], &buffer[index]);
+			index += 4;
+			mb_put_binary_float(MB_YES, attitude->pitch[i], &buffer[index]);
+			index += 4;
+			mb_put_binary_float(MB_YES, attitude->heave[i], &buffer[index]);
+			index += 4;
+			mb_put_binary_float(MB_YES, attitude->heading[i], &buffer[index]);
+			index += 4;
+		}
+
+		/* reset the header size value */
+		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
+
+		/* now add the checksum */
+		checksum = 0;
+		for (i = 0; i < index; i++)
+			checksum += (unsigned char)buffer[i];
+		mb_put_binary_int(MB_YES, checksum, &buffer[index]);
+		index += 4;
+
+		/* check size */
+		if (*size != index) {
+			fprintf(stderr, "Bad size comparison: file:%s line:%d size:%d index:%d\n", __FILE__, __LINE__, *size, index);
+			status = MB_FAILURE;
+			*error = MB_ERROR_BAD_DATA;
+			*size = 0;
+		}
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:  %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbr_reson7kr_wr_rec1022(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_rec1022";
+	int status = MB_SUCCESS;
+	struct mbsys_reson7k_struct *store;
+	s7k_header *header;
+	s7kr_rec1022 *rec1022;
+	unsigned int checksum;
+	int index;
+	char *buffer;
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
+		fprintf(stderr, "dbg2       bufferptr:  %p\n", (void *)bufferptr);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+	}
+
+	/* get pointer to raw data structure */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+	rec1022 = &(store->rec1022);
+	header = &(rec1022->header);
+
+/* print out the data to be output */
+#ifdef MBR_RESON7KR_DEBUG2
+	if (verbose > 0)
+#else
+	if (verbose >= 2)
+#endif
+		mbsys_reson7k_print_rec1022(verbose, rec1022, error);
+
+	/* figure out size of output record */
+	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
+	*size += R7KHDRSIZE_Rec1022;
+
+	/* allocate memory to write rest of record if necessary */
+	if (*bufferalloc < *size) {
+		status = mb_reallocd(verbose, __FILE__, __LINE__, *size, (void **)bufferptr, error);
+		if (status != MB_SUCCESS) {
+			*bufferalloc = 0;
+		}
+		else {
+			*bufferalloc = *size;
+		}
+	}
+
+	/* proceed to write if buffer allocated */
+	if (status == MB_SUCCESS) {
+		/* get buffer for writing */
+		buffer = (char *)*bufferptr;
+
+		/* insert the header */
+		index = 0;
+		status = mbr_reson7kr_wr_header(verbose, buffer, &index, header, error);
+
+		/* insert the data */
+		index = header->Offset + 4;
+		for (i = 0; i < R7KHDRSIZE_Rec1022; i++) {
+			buffer[index] = rec1022->data[i];
+			index++;
+		}
+
+		/* reset the header size value */
+		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
+
+		/* now add the checksum */
+		checksum = 0;
+		for (i = 0; i < index; i++)
+			checksum += (unsigned char)buffer[i];
+		mb_put_binary_int(MB_YES, checksum, &buffer[index]);
+		index += 4;
+
+		/* check size */
+		if (*size != index) {
+			fprintf(stderr, "Bad size comparison: file:%s line:%d size:%d index:%d\n", __FILE__, __LINE__, *size, index);
+			status = MB_FAILURE;
+			*error = MB_ERROR_BAD_DATA;
+			*size = 0;
+		}
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:  %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbr_reson7kr_wr_fsdwchannel(int verbose, int data_format, char *buffer, int *index, s7k_fsdwchannel *fsdwchannel,
+                                int *error) {
+	char *function_name = "mbr_reson7kr_wr_fsdwchannel";
+	int status = MB_SUCCESS;
+	short *shortptr;
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       data_format:%d\n", data_format);
+		fprintf(stderr, "dbg2       index:      %d\n", *index);
+		fprintf(stderr, "dbg2       fsdwchannel:%p\n", (void *)fsdwchannel);
+	}
+
+	/* print out the data to be output */
+	/*mbsys_reson7k_print_fsdwchannel(verbose, data_format, fsdwchannel, error);*/
+
+	/* extract the channel header */
+	buffer[*index] = fsdwchannel->number;
+	(*index)++;
+	buffer[*index] = fsdwchannel->type;
+	(*index)++;
+	buffer[*index] = fsdwchannel->data_type;
+	(*index)++;
+	buffer[*index] = fsdwchannel->polarity;
+	(*index)++;
+	buffer[*index] = fsdwchannel->bytespersample;
+	(*index)++;
+	for (i = 0; i < 3; i++) {
+		buffer[*index] = fsdwchannel->reserved1[i];
+		(*index)++;
+	}
+	mb_put_binary_int(MB_YES, fsdwchannel->number_samples, &buffer[*index]);
+	*index += 4;
+	mb_put_binary_int(MB_YES, fsdwchannel->start_time, &buffer[*index]);
+	*index += 4;
+	mb_put_binary_int(MB_YES, fsdwchannel->sample_interval, &buffer[*index]);
+	*index += 4;
+	mb_put_binary_float(MB_YES, fsdwchannel->range, &buffer[*index]);
+	*index += 4;
+	mb_put_binary_float(MB_YES, fsdwchannel->voltage, &buffer[*index]);
+	*index += 4;
+	for (i = 0; i < 16; i++) {
+		buffer[*index] = fsdwchannel->name[i];
+		(*index)++;
+	}
+	for (i = 0; i < 20; i++) {
+		buffer[*index] = fsdwchannel->reserved2[i];
+		(*index)++;
+	}
+
+	/* copy over the data */
+	if (status == MB_SUCCESS) {
+		if (fsdwchannel->bytespersample == 1) {
+			for (i = 0; i < fsdwchannel->number_samples; i++) {
+				buffer[*index] = fsdwchannel->data[i];
+				(*index)++;
+			}
+		}
+		else if (fsdwchannel->bytespersample == 2) {
+			shortptr = (short *)fsdwchannel->data;
+			for (i = 0; i < fsdwchannel->number_samples; i++) {
+				/*srptr = (short *) &(buffer[*index]);
+				urptr = (unsigned short *) &(buffer[*index]);*/
+				mb_put_binary_short(MB_YES, shortptr[i], &buffer[*index]);
+				*index += 2;
+				/*ssptr = (short *) &(shortptr[i]);
+				usptr = (unsigned short *) &(shortptr[i]);
+				fprintf(stderr,"sample:%5d   raw:%6d %6d   swapped:%6d %6d\n",
+				i,*srptr,*urptr,*ssptr,*usptr);*/
+			}
+		}
+		else if (fsdwchannel->bytespersample == 4) {
+			shortptr = (short *)fsdwchannel->data;
+			for (i = 0; i < fsdwchannel->number_samples; i++) {
+				/*srptr = (short *) &(buffer[*index]);
+				urptr = (unsigned short *) &(buffer[*index]);*/
+				mb_put_binary_short(MB_YES, shortptr[2 * i], &buffer[*index]);
+				*index += 2;
+				/*ssptr = (short *) &(shortptr[2*i]);
+				usptr = (unsigned short *) &(shortptr[2*i]);
+				fprintf(stderr,"sample:%5d   IMAGINARY: raw:%6d %6d   swapped:%6d %6d",
+				i,*srptr,*urptr,*ssptr,*usptr);
+				srptr = (short *) &(buffer[*index]);
+				urptr = (unsigned short *) &(buffer[*index]);*/
+				mb_put_binary_short(MB_YES, shortptr[2 * i + 1], &buffer[*index]);
+				*index += 2;
+				/*ssptr = (short *) &(shortptr[2*i+1]);
+				usptr = (unsigned short *) &(shortptr[2*i+1]);
+				fprintf(stderr,"    REAL: raw:%6d %6d   swapped:%6d %6d\n",
+				*srptr,*urptr,*ssptr,*usptr);*/
+			}
+		}
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       index:      %d\n", *index);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:  %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbr_reson7kr_wr_fsdwssheader(int verbose, char *buffer, int *index, s7k_fsdwssheader *fsdwssheader, int *error) {
+	char *function_name = "mbr_reson7kr_wr_fsdwssheader";
+	int status = MB_SUCCESS;
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:        %d\n", verbose);
+		fprintf(stderr, "dbg2       buffer:         %p\n", (void *)buffer);
+		fprintf(stderr, "dbg2       index:          %d\n", *index);
+		fprintf(stderr, "dbg2       fsdwssheader:   %p\n", (void *)fsdwssheader);
+	}
+
+	/* print out the data to be output */
+	/*mbsys_reson7k_print_fsdwssheader(verbose, fsdwssheader, error);*/
+
+	/* extract the Edgetech sidescan header */
+	mb_put_binary_short(MB_YES, fsdwssheader->subsystem, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwssheader->channelNum, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_int(MB_YES, fsdwssheader->pingNum, &buffer[*index]);
+	*index += 4;
+	mb_put_binary_short(MB_YES, fsdwssheader->packetNum, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwssheader->trigSource, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_int(MB_YES, fsdwssheader->samples, &buffer[*index]);
+	*index += 4;
+	mb_put_binary_int(MB_YES, fsdwssheader->sampleInterval, &buffer[*index]);
+	*index += 4;
+	mb_put_binary_int(MB_YES, fsdwssheader->startDepth, &buffer[*index]);
+	*index += 4;
+	mb_put_binary_short(MB_YES, fsdwssheader->weightingFactor, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwssheader->ADCGain, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwssheader->ADCMax, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwssheader->rangeSetting, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwssheader->pulseID, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwssheader->markNumber, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwssheader->dataFormat, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwssheader->reserved, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_int(MB_YES, fsdwssheader->millisecondsToday, &buffer[*index]);
+	*index += 4;
+	mb_put_binary_short(MB_YES, fsdwssheader->year, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwssheader->day, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwssheader->hour, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwssheader->minute, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwssheader->second, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwssheader->heading, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwssheader->pitch, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwssheader->roll, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwssheader->heave, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwssheader->yaw, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_int(MB_YES, fsdwssheader->depth, &buffer[*index]);
+	*index += 4;
+	mb_put_binary_short(MB_YES, fsdwssheader->temperature, &buffer[*index]);
+	*index += 2;
+	for (i = 0; i < 2; i++) {
+		buffer[*index] = fsdwssheader->reserved2[i];
+		(*index)++;
+	}
+	mb_put_binary_int(MB_YES, fsdwssheader->longitude, &buffer[*index]);
+	*index += 4;
+	mb_put_binary_int(MB_YES, fsdwssheader->latitude, &buffer[*index]);
+	*index += 4;
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       index:      %d\n", *index);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:  %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbr_reson7kr_wr_fsdwsegyheader(int verbose, char *buffer, int *index, s7k_fsdwsegyheader *fsdwsegyheader, int *error) {
+	char *function_name = "mbr_reson7kr_wr_fsdwsegyheader";
+	int status = MB_SUCCESS;
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:        %d\n", verbose);
+		fprintf(stderr, "dbg2       buffer:         %p\n", (void *)buffer);
+		fprintf(stderr, "dbg2       index:          %d\n", *index);
+		fprintf(stderr, "dbg2       fsdwsegyheader: %p\n", (void *)fsdwsegyheader);
+	}
+
+	/* print out the data to be output */
+	/*mbsys_reson7k_print_fsdwsegyheader(verbose, fsdwsegyheader, error);*/
+
+	/* extract the Edgetech segy header */
+	mb_put_binary_int(MB_YES, fsdwsegyheader->sequenceNumber, &buffer[*index]);
+	*index += 4;
+	mb_put_binary_int(MB_YES, fsdwsegyheader->startDepth, &buffer[*index]);
+	*index += 4;
+	mb_put_binary_int(MB_YES, fsdwsegyheader->pingNum, &buffer[*index]);
+	*index += 4;
+	mb_put_binary_int(MB_YES, fsdwsegyheader->channelNum, &buffer[*index]);
+	*index += 4;
+	for (i = 0; i < 6; i++) {
+		mb_put_binary_short(MB_YES, fsdwsegyheader->unused1[i], &buffer[*index]);
+		*index += 2;
+	}
+	mb_put_binary_short(MB_YES, fsdwsegyheader->traceIDCode, &buffer[*index]);
+	*index += 2;
+	for (i = 0; i < 2; i++) {
+		mb_put_binary_short(MB_YES, fsdwsegyheader->unused2[i], &buffer[*index]);
+		*index += 2;
+	}
+	mb_put_binary_short(MB_YES, fsdwsegyheader->dataFormat, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->NMEAantennaeR, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->NMEAantennaeO, &buffer[*index]);
+	*index += 2;
+	for (i = 0; i < 32; i++) {
+		buffer[*index] = fsdwsegyheader->RS232[i];
+		(*index)++;
+	}
+	mb_put_binary_int(MB_YES, fsdwsegyheader->sourceCoordX, &buffer[*index]);
+	*index += 4;
+	mb_put_binary_int(MB_YES, fsdwsegyheader->sourceCoordY, &buffer[*index]);
+	*index += 4;
+	mb_put_binary_int(MB_YES, fsdwsegyheader->groupCoordX, &buffer[*index]);
+	*index += 4;
+	mb_put_binary_int(MB_YES, fsdwsegyheader->groupCoordY, &buffer[*index]);
+	*index += 4;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->coordUnits, &buffer[*index]);
+	*index += 2;
+	for (i = 0; i < 24; i++) {
+		buffer[*index] = fsdwsegyheader->annotation[i];
+		(*index)++;
+	}
+	mb_put_binary_short(MB_YES, fsdwsegyheader->samples, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_int(MB_YES, fsdwsegyheader->sampleInterval, &buffer[*index]);
+	*index += 4;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->ADCGain, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->pulsePower, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->correlated, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->startFreq, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->endFreq, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->sweepLength, &buffer[*index]);
+	*index += 2;
+	for (i = 0; i < 4; i++) {
+		mb_put_binary_short(MB_YES, fsdwsegyheader->unused7[i], &buffer[*index]);
+		*index += 2;
+	}
+	mb_put_binary_short(MB_YES, fsdwsegyheader->aliasFreq, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->pulseID, &buffer[*index]);
+	*index += 2;
+	for (i = 0; i < 6; i++) {
+		mb_put_binary_short(MB_YES, fsdwsegyheader->unused8[i], &buffer[*index]);
+		*index += 2;
+	}
+	mb_put_binary_short(MB_YES, fsdwsegyheader->year, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->day, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->hour, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->minute, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->second, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->timeBasis, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->weightingFactor, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->unused9, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->heading, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->pitch, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->roll, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->temperature, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->heaveCompensation, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->trigSource, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->markNumber, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->NMEAHour, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->NMEAMinutes, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->NMEASeconds, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->NMEACourse, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->NMEASpeed, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->NMEADay, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->NMEAYear, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_int(MB_YES, fsdwsegyheader->millisecondsToday, &buffer[*index]);
+	*index += 4;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->ADCMax, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->calConst, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->vehicleID, &buffer[*index]);
+	*index += 2;
+	for (i = 0; i < 6; i++) {
+		buffer[*index] = fsdwsegyheader->softwareVersion[i];
+		(*index)++;
+	}
+	mb_put_binary_int(MB_YES, fsdwsegyheader->sphericalCorrection, &buffer[*index]);
+	*index += 4;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->packetNum, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->ADCDecimation, &buffer[*index]);
+	*index += 2;
+	mb_put_binary_short(MB_YES, fsdwsegyheader->decimation, &buffer[*index]);
+	*index += 2;
+	for (i = 0; i < 7; i++) {
+		mb_put_binary_short(MB_YES, fsdwsegyheader->unuseda[i], &buffer[*index]);
+		*index += 2;
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       index:      %d\n", *index);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:  %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbr_reson7kr_wr_fsdwsslo(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_fsdwsslo";
+	int status = MB_SUCCESS;
+	struct mbsys_reson7k_struct *store;
+	s7k_header *header;
+	s7kr_fsdwss *fsdwsslo;
+	s7k_fsdwchannel *fsdwchannel;
+	s7k_fsdwssheader *fsdwssheader;
+	s7kr_bathymetry *bathymetry;
+	s7kr_bluefin *bluefin;
+	unsigned int checksum;
+	int index;
+	char *buffer;
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
+		fprintf(stderr, "dbg2       bufferptr:  %p\n", (void *)bufferptr);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+	}
+
+	/* get pointer to raw data structure */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+	fsdwsslo = &(store->fsdwsslo);
+	header = &(fsdwsslo->header);
+	bathymetry = &(store->bathymetry);
+	bluefin = &(store->bluefin);
+
+/* print out the data to be output */
+#ifdef MBR_RESON7KR_DEBUG2
+	if (verbose > 0)
+#else
+	if (verbose >= 2)
+#endif
+		mbsys_reson7k_print_fsdwss(verbose, fsdwsslo, error);
+#ifdef MBR_RESON7KR_DEBUG2
+	for (i = 0; i < fsdwsslo->number_channels; i++) {
+		fsdwchannel = &(fsdwsslo->channel[i]);
+		fsdwssheader = &(fsdwsslo->ssheader[i]);
+		fprintf(stderr,
+		        "SSLO: 7Ktime(%4.4d/%2.2d/%2.2d %2.2d:%2.2d:%2.2d.%6.6d) FSDWtime(%4.4d-%3.3d %2.2d:%2.2d:%2.2d.%3.3d) ping:%d "
+		        "%d chan:%d %d sampint:%d %d\n",
+		        store->time_i[0], store->time_i[1], store->time_i[2], store->time_i[3], store->time_i[4], store->time_i[5],
+		        store->time_i[6], fsdwssheader->year, fsdwssheader->day, fsdwssheader->hour, fsdwssheader->minute,
+		        fsdwssheader->second, fsdwssheader->millisecondsToday - 1000 * (int)(0.001 * fsdwssheader->millisecondsToday),
+		        fsdwsslo->ping_number, fsdwssheader->pingNum, fsdwchannel->number, fsdwssheader->channelNum,
+		        fsdwchannel->sample_interval, fsdwssheader->sampleInterval);
+	}
+#endif
+
+	/* figure out size of output record */
+	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
+	*size += R7KHDRSIZE_FSDWsidescan;
+	for (i = 0; i < fsdwsslo->number_channels; i++) {
+		*size += R7KHDRSIZE_FSDWchannelinfo;
+		*size += R7KHDRSIZE_FSDWssheader;
+		fsdwchannel = &(fsdwsslo->channel[i]);
+		*size += fsdwchannel->bytespersample * fsdwchannel->number_samples;
+	}
+
+	/* allocate memory to write rest of record if necessary */
+	if (*bufferalloc < *size) {
+		status = mb_reallocd(verbose, __FILE__, __LINE__, *size, (void **)bufferptr, error);
+		if (status != MB_SUCCESS) {
+			*bufferalloc = 0;
+		}
+		else {
+			*bufferalloc = *size;
+		}
+	}
+
+	/* proceed to write if buffer allocated */
+	if (status == MB_SUCCESS) {
+		/* get buffer for writing */
+		buffer = (char *)*bufferptr;
+
+		/* insert the header */
+		index = 0;
+		status = mbr_reson7kr_wr_header(verbose, buffer, &index, header, error);
+
+		/* insert the data */
+		index = header->Offset + 4;
+		mb_put_binary_int(MB_YES, fsdwsslo->msec_timestamp, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, fsdwsslo->ping_number, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, fsdwsslo->number_channels, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, fsdwsslo->total_bytes, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, fsdwsslo->data_format, &buffer[index]);
+		index += 4;
+		index += 12;
+		for (i = 0; i < 2; i++) {
+			fsdwchannel = &(fsdwsslo->channel[i]);
+			mbr_reson7kr_wr_fsdwchannel(verbose, fsdwsslo->data_format, buffer, &index, fsdwchannel, error);
+		}
+		/*fprintf(stderr,"In mbr_reson7kr_wr_fsdwsslo: index:%d OffsetToOptionalData:%d\n",
+		index, header->OffsetToOptionalData);
+		    index = header->OffsetToOptionalData;*/
+		for (i = 0; i < 2; i++) {
+			fsdwssheader = &(fsdwsslo->ssheader[i]);
+			mbr_reson7kr_wr_fsdwssheader(verbose, buffer, &index, fsdwssheader, error);
+		}
+
+		/* reset the header size value */
+		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
+
+		/* now add the checksum */
+		checksum = 0;
+		for (i = 0; i < index; i++)
+			checksum += (unsigned char)buffer[i];
+		mb_put_binary_int(MB_YES, checksum, &buffer[index]);
+		index += 4;
+
+		/* check size */
+		if (*size != index) {
+			fprintf(stderr, "Bad size comparison: file:%s line:%d size:%d index:%d\n", __FILE__, __LINE__, *size, index);
+			status = MB_FAILURE;
+			*error = MB_ERROR_BAD_DATA;
+			*size = 0;
+		}
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
+		fprintf(stderr, "dbg2       size:       %d\n", *size);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:  %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbr_reson7kr_wr_fsdwsshi(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_fsdwsshi";
+	int status = MB_SUCCESS;
+	struct mbsys_reson7k_struct *store;
+	s7k_header *header;
+	s7kr_fsdwss *fsdwsshi;
+	s7k_fsdwchannel *fsdwchannel;
+	s7k_fsdwssheader *fsdwssheader;
+	unsigned int checksum;
+	int index;
+	char *buffer;
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
+		fprintf(stderr, "dbg2       bufferptr:  %p\n", (void *)bufferptr);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+	}
+
+	/* get pointer to raw data structure */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+	fsdwsshi = &(store->fsdwsshi);
+	header = &(fsdwsshi->header);
+
+/* print out the data to be output */
+#ifdef MBR_RESON7KR_DEBUG2
+	if (verbose > 0)
+#else
+	if (verbose >= 2)
+#endif
+		mbsys_reson7k_print_fsdwss(verbose, fsdwsshi, error);
+#ifdef MBR_RESON7KR_DEBUG2
+	for (i = 0; i < fsdwsshi->number_channels; i++) {
+		fsdwchannel = &(fsdwsshi->channel[i]);
+		fsdwssheader = &(fsdwsshi->ssheader[i]);
+		fprintf(stderr,
+		        "SSHI: 7Ktime(%4.4d/%2.2d/%2.2d %2.2d:%2.2d:%2.2d.%6.6d) FSDWtime(%4.4d-%3.3d %2.2d:%2.2d:%2.2d.%3.3d) ping:%d "
+		        "%d chan:%d %d sampint:%d %d\n",
+		        store->time_i[0], store->time_i[1], store->time_i[2], store->time_i[3], store->time_i[4], store->time_i[5],
+		        store->time_i[6], fsdwssheader->year, fsdwssheader->day, fsdwssheader->hour, fsdwssheader->minute,
+		        fsdwssheader->second, fsdwssheader->millisecondsToday - 1000 * (int)(0.001 * fsdwssheader->millisecondsToday),
+		        fsdwsshi->ping_number, fsdwssheader->pingNum, fsdwchannel->number, fsdwssheader->channelNum,
+		        fsdwchannel->sample_interval, fsdwssheader->sampleInterval);
+	}
+#endif
+
+	/* figure out size of output record */
+	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
+	*size += R7KHDRSIZE_FSDWsidescan;
+	for (i = 0; i < fsdwsshi->number_channels; i++) {
+		*size += R7KHDRSIZE_FSDWchannelinfo;
+		*size += R7KHDRSIZE_FSDWssheader;
+		fsdwchannel = &(fsdwsshi->channel[i]);
+		*size += fsdwchannel->bytespersample * fsdwchannel->number_samples;
+	}
+
+	/* allocate memory to write rest of record if necessary */
+	if (*bufferalloc < *size) {
+		status = mb_reallocd(verbose, __FILE__, __LINE__, *size, (void **)bufferptr, error);
+		if (status != MB_SUCCESS) {
+			*bufferalloc = 0;
+		}
+		else {
+			*bufferalloc = *size;
+		}
+	}
+
+	/* proceed to write if buffer allocated */
+	if (status == MB_SUCCESS) {
+		/* get buffer for writing */
+		buffer = (char *)*bufferptr;
+
+		/* insert the header */
+		index = 0;
+		status = mbr_reson7kr_wr_header(verbose, buffer, &index, header, error);
+
+		/* insert the data */
+		index = header->Offset + 4;
+		mb_put_binary_int(MB_YES, fsdwsshi->msec_timestamp, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, fsdwsshi->ping_number, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, fsdwsshi->number_channels, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, fsdwsshi->total_bytes, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, fsdwsshi->data_format, &buffer[index]);
+		index += 4;
+		index += 12;
+		for (i = 0; i < 2; i++) {
+			fsdwchannel = &(fsdwsshi->channel[i]);
+			mbr_reson7kr_wr_fsdwchannel(verbose, fsdwsshi->data_format, buffer, &index, fsdwchannel, error);
+		}
+		/*fprintf(stderr,"In mbr_reson7kr_wr_fsdwsshi: index:%d OffsetToOptionalData:%d\n",
+		index, header->OffsetToOptionalData);
+		    index = header->OffsetToOptionalData;*/
+		for (i = 0; i < 2; i++) {
+			fsdwssheader = &(fsdwsshi->ssheader[i]);
+			mbr_reson7kr_wr_fsdwssheader(verbose, buffer, &index, fsdwssheader, error);
+		}
+
+		/* reset the header size value */
+		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
+
+		/* now add the checksum */
+		checksum = 0;
+		for (i = 0; i < index; i++)
+			checksum += (unsigned char)buffer[i];
+		mb_put_binary_int(MB_YES, checksum, &buffer[index]);
+		index += 4;
+
+		/* check size */
+		if (*size != index) {
+			fprintf(stderr, "Bad size comparison: file:%s line:%d size:%d index:%d\n", __FILE__, __LINE__, *size, index);
+			status = MB_FAILURE;
+			*error = MB_ERROR_BAD_DATA;
+			*size = 0;
+		}
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
+		fprintf(stderr, "dbg2       size:       %d\n", *size);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:  %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbr_reson7kr_wr_fsdwsb(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_fsdwsb";
+	int status = MB_SUCCESS;
+	struct mbsys_reson7k_struct *store;
+	s7k_header *header;
+	s7kr_fsdwsb *fsdwsb;
+	s7k_fsdwchannel *fsdwchannel;
+	s7k_fsdwsegyheader *fsdwsegyheader;
+	unsigned int checksum;
+	int index;
+	char *buffer;
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
+		fprintf(stderr, "dbg2       bufferptr:  %p\n", (void *)bufferptr);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+	}
+
+	/* get pointer to raw data structure */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+	fsdwsb = &(store->fsdwsb);
+	header = &(fsdwsb->header);
+
+/* print out the data to be output */
+#ifdef MBR_RESON7KR_DEBUG2
+	if (verbose > 0)
+#else
+	if (verbose >= 2)
+#endif
+		mbsys_reson7k_print_fsdwsb(verbose, fsdwsb, error);
+#ifdef MBR_RESON7KR_DEBUG2
+	for (i = 0; i < fsdwsb->number_channels; i++) {
+		fsdwchannel = &(fsdwsb->channel);
+		fsdwsegyheader = &(fsdwsb->segyheader);
+		fprintf(stderr,
+		        "SBP:  7Ktime(%4.4d/%2.2d/%2.2d %2.2d:%2.2d:%2.2d.%6.6d) FSDWtime(%4.4d-%3.3d %2.2d:%2.2d:%2.2d.%3.3d) ping:%d "
+		        "%d chan:%d %d sampint:%d %d\n",
+		        store->time_i[0], store->time_i[1], store->time_i[2], store->time_i[3], store->time_i[4], store->time_i[5],
+		        store->time_i[6], fsdwsegyheader->year, fsdwsegyheader->day, fsdwsegyheader->hour, fsdwsegyheader->minute,
+		        fsdwsegyheader->second,
+		        fsdwsegyheader->millisecondsToday - 1000 * (int)(0.001 * fsdwsegyheader->millisecondsToday), fsdwsb->ping_number,
+		        fsdwsegyheader->pingNum, fsdwchannel->number, fsdwsegyheader->channelNum, fsdwchannel->sample_interval,
+		        fsdwsegyheader->sampleInterval);
+	}
+#endif
+
+	/* figure out size of output record */
+	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
+	*size += R7KHDRSIZE_FSDWsubbottom;
+
+	/* figure out size of output record */
+	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
+	*size += R7KHDRSIZE_FSDWsubbottom;
+	for (i = 0; i < fsdwsb->number_channels; i++) {
+		*size += R7KHDRSIZE_FSDWchannelinfo;
+		*size += R7KHDRSIZE_FSDWsbheader;
+		fsdwchannel = &(fsdwsb->channel);
+		*size += fsdwchannel->bytespersample * fsdwchannel->number_samples;
+	}
+
+	/* allocate memory to write rest of record if necessary */
+	if (*bufferalloc < *size) {
+		status = mb_reallocd(verbose, __FILE__, __LINE__, *size, (void **)bufferptr, error);
+		if (status != MB_SUCCESS) {
+			*bufferalloc = 0;
+		}
+		else {
+			*bufferalloc = *size;
+		}
+	}
+
+	/* proceed to write if buffer allocated */
+	if (status == MB_SUCCESS) {
+		/* get buffer for writing */
+		buffer = (char *)*bufferptr;
+
+		/* insert the header */
+		index = 0;
+		status = mbr_reson7kr_wr_header(verbose, buffer, &index, header, error);
+
+		/* insert the data */
+		index = header->Offset + 4;
+		mb_put_binary_int(MB_YES, fsdwsb->msec_timestamp, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, fsdwsb->ping_number, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, fsdwsb->number_channels, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, fsdwsb->total_bytes, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, fsdwsb->data_format, &buffer[index]);
+		index += 4;
+		index += 12;
+		fsdwchannel = &(fsdwsb->channel);
+		mbr_reson7kr_wr_fsdwchannel(verbose, fsdwsb->data_format, buffer, &index, fsdwchannel, error);
+		/* fprintf(stderr,"index:%d offset:%d\n",index,header->OffsetToOptionalData);*/
+		fsdwsegyheader = &(fsdwsb->segyheader);
+		mbr_reson7kr_wr_fsdwsegyheader(verbose, buffer, &index, fsdwsegyheader, error);
+
+		/* reset the header size value */
+		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
+
+		/* now add the checksum */
+		checksum = 0;
+		for (i = 0; i < index; i++)
+			checksum += (unsigned char)buffer[i];
+		mb_put_binary_int(MB_YES, checksum, &buffer[index]);
+		index += 4;
+
+		/* check size */
+		if (*size != index) {
+			fprintf(stderr, "Bad size comparison: file:%s line:%d size:%d index:%d\n", __FILE__, __LINE__, *size, index);
+			status = MB_FAILURE;
+			*error = MB_ERROR_BAD_DATA;
+			*size = 0;
+		}
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
+		fprintf(stderr, "dbg2       size:       %d\n", *size);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:  %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbr_reson7kr_wr_bluefin(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_bluefin";
+	int status = MB_SUCCESS;
+	struct mbsys_reson7k_struct *store;
+	s7k_header *header;
+	s7kr_bluefin *bluefin;
+	unsigned int checksum;
+	int index;
+	char *buffer;
+	int i, j;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
+		fprintf(stderr, "dbg2       bufferptr:  %p\n", (void *)bufferptr);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+	}
+
+	/* get pointer to raw data structure */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+	bluefin = &(store->bluefin);
+	header = &(bluefin->header);
+
+/* print out the data to be output */
+#ifdef MBR_RESON7KR_DEBUG2
+	if (verbose > 0)
+#else
+	if (verbose >= 2)
+#endif
+		mbsys_reson7k_print_bluefin(verbose, bluefin, error);
+
+	/* figure out size of output record */
+	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
+	*size += R7KHDRSIZE_BluefinDataFrame;
+	*size += bluefin->number_frames * bluefin->frame_size;
+
+	/* allocate memory to write rest of record if necessary */
+	if (*bufferalloc < *size) {
+		status = mb_reallocd(verbose, __FILE__, __LINE__, *size, (void **)bufferptr, error);
+		if (status != MB_SUCCESS) {
+			*bufferalloc = 0;
+		}
+		else {
+			*bufferalloc = *size;
+		}
+	}
+
+	/* proceed to write if buffer allocated */
+	if (status == MB_SUCCESS) {
+		/* get buffer for writing */
+		buffer = (char *)*bufferptr;
+
+		/* insert the header */
+		index = 0;
+		status = mbr_reson7kr_wr_header(verbose, buffer, &index, header, error);
+
+		/* insert the data */
+		index = header->Offset + 4;
+		mb_put_binary_int(MB_YES, bluefin->msec_timestamp, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, bluefin->number_frames, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, bluefin->frame_size, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, bluefin->data_format, &buffer[index]);
+		index += 4;
+		for (i = 0; i < 16; i++) {
+			buffer[index] = bluefin->reserved[i];
+			index++;
+		}
+		if (bluefin->data_format == R7KRECID_BluefinNav) {
+			for (i = 0; i < bluefin->number_frames; i++) {
+				mb_put_binary_int(MB_YES, bluefin->nav[i].packet_size, &buffer[index]);
+				index += 4;
+				mb_put_binary_short(MB_YES, bluefin->nav[i].version, &buffer[index]);
+				index += 2;
+				mb_put_binary_short(MB_YES, bluefin->nav[i].offset, &buffer[index]);
+				index += 2;
+				mb_put_binary_int(MB_YES, bluefin->nav[i].data_type, &buffer[index]);
+				index += 4;
+				mb_put_binary_int(MB_YES, bluefin->nav[i].data_size, &buffer[index]);
+				index += 4;
+				mb_put_binary_short(MB_YES, bluefin->nav[i].s7kTime.Year, &buffer[index]);
+				index += 2;
+				mb_put_binary_short(MB_YES, bluefin->nav[i].s7kTime.Day, &buffer[index]);
+				index += 2;
+				mb_put_binary_float(MB_YES, bluefin->nav[i].s7kTime.Seconds, &buffer[index]);
+				index += 4;
+				buffer[index] = bluefin->nav[i].s7kTime.Hours;
+				(index)++;
+				buffer[index] = bluefin->nav[i].s7kTime.Minutes;
+				(index)++;
+				mb_put_binary_int(MB_YES, bluefin->nav[i].checksum, &buffer[index]);
+				index += 4;
+				mb_put_binary_short(MB_YES, bluefin->nav[i].timedelay, &buffer[index]);
+				index += 2;
+				mb_put_binary_int(MB_YES, bluefin->nav[i].quality, &buffer[index]);
+				index += 4;
+				mb_put_binary_double(MB_YES, bluefin->nav[i].latitude, &buffer[index]);
+				index += 8;
+				mb_put_binary_double(MB_YES, bluefin->nav[i].longitude, &buffer[index]);
+				index += 8;
+				mb_put_binary_float(MB_YES, bluefin->nav[i].speed, &buffer[index]);
+				index += 4;
+				mb_put_binary_double(MB_YES, bluefin->nav[i].depth, &buffer[index]);
+				index += 8;
+				mb_put_binary_double(MB_YES, bluefin->nav[i].altitude, &buffer[index]);
+				index += 8;
+				mb_put_binary_float(MB_YES, bluefin->nav[i].roll, &buffer[index]);
+				index += 4;
+				mb_put_binary_float(MB_YES, bluefin->nav[i].pitch, &buffer[index]);
+				index += 4;
+				mb_put_binary_float(MB_YES, bluefin->nav[i].yaw, &buffer[index]);
+				index += 4;
+				mb_put_binary_float(MB_YES, bluefin->nav[i].northing_rate, &buffer[index]);
+				index += 4;
+				mb_put_binary_float(MB_YES, bluefin->nav[i].easting_rate, &buffer[index]);
+				index += 4;
+				mb_put_binary_float(MB_YES, bluefin->nav[i].depth_rate, &buffer[index]);
+				index += 4;
+				mb_put_binary_float(MB_YES, bluefin->nav[i].altitude_rate, &buffer[index]);
+				index += 4;
+				mb_put_binary_float(MB_YES, bluefin->nav[i].roll_rate, &buffer[index]);
+				index += 4;
+				mb_put_binary_float(MB_YES, bluefin->nav[i].pitch_rate, &buffer[index]);
+				index += 4;
+				mb_put_binary_float(MB_YES, bluefin->nav[i].yaw_rate, &buffer[index]);
+				index += 4;
+				mb_put_binary_double(MB_YES, bluefin->nav[i].position_time, &buffer[index]);
+				index += 8;
+				mb_put_binary_double(MB_YES, bluefin->nav[i].depth_time, &buffer[index]);
+				index += 8;
+			}
+		}
+		else if (bluefin->data_format == R7KRECID_BluefinEnvironmental) {
+			for (i = 0; i < bluefin->number_frames; i++) {
+				mb_put_binary_int(MB_YES, bluefin->environmental[i].packet_size, &buffer[index]);
+				index += 4;
+				mb_put_binary_short(MB_YES, bluefin->environmental[i].version, &buffer[index]);
+				index += 2;
+				mb_put_binary_short(MB_YES, bluefin->environmental[i].offset, &buffer[index]);
+				index += 2;
+				mb_put_binary_int(MB_YES, bluefin->environmental[i].data_type, &buffer[index]);
+				index += 4;
+				mb_put_binary_int(MB_YES, bluefin->environmental[i].data_size, &buffer[index]);
+				index += 4;
+				mb_put_binary_short(MB_YES, bluefin->environmental[i].s7kTime.Year, &buffer[index]);
+				index += 2;
+				mb_put_binary_short(MB_YES, bluefin->environmental[i].s7kTime.Day, &buffer[index]);
+				index += 2;
+				mb_put_binary_float(MB_YES, bluefin->environmental[i].s7kTime.Seconds, &buffer[index]);
+				index += 4;
+				buffer[index] = bluefin->environmental[i].s7kTime.Hours;
+				(index)++;
+				buffer[index] = bluefin->environmental[i].s7kTime.Minutes;
+				(index)++;
+				mb_put_binary_int(MB_YES, bluefin->environmental[i].checksum, &buffer[index]);
+				index += 4;
+				mb_put_binary_short(MB_YES, bluefin->environmental[i].reserved1, &buffer[index]);
+				index += 2;
+				mb_put_binary_int(MB_YES, bluefin->environmental[i].quality, &buffer[index]);
+				index += 4;
+				mb_put_binary_float(MB_YES, bluefin->environmental[i].sound_speed, &buffer[index]);
+				index += 4;
+				mb_put_binary_float(MB_YES, bluefin->environmental[i].conductivity, &buffer[index]);
+				index += 4;
+				mb_put_binary_float(MB_YES, bluefin->environmental[i].temperature, &buffer[index]);
+				index += 4;
+				mb_put_binary_float(MB_YES, bluefin->environmental[i].pressure, &buffer[index]);
+				index += 4;
+				mb_put_binary_float(MB_YES, bluefin->environmental[i].salinity, &buffer[index]);
+				index += 4;
+				mb_put_binary_double(MB_YES, bluefin->environmental[i].ctd_time, &buffer[index]);
+				index += 8;
+				mb_put_binary_double(MB_YES, bluefin->environmental[i].temperature_time, &buffer[index]);
+				index += 8;
+				mb_put_binary_double(MB_YES, bluefin->environmental[i].surface_pressure, &buffer[index]);
+				index += 8;
+				mb_put_binary_int(MB_YES, bluefin->environmental[i].temperature_counts, &buffer[index]);
+				index += 4;
+				mb_put_binary_float(MB_YES, bluefin->environmental[i].conductivity_frequency, &buffer[index]);
+				index += 4;
+				mb_put_binary_int(MB_YES, bluefin->environmental[i].pressure_counts, &buffer[index]);
+				index += 4;
+				mb_put_binary_float(MB_YES, bluefin->environmental[i].pressure_comp_voltage, &buffer[index]);
+				index += 4;
+				mb_put_binary_int(MB_YES, bluefin->environmental[i].sensor_time_sec, &buffer[index]);
+				index += 4;
+				mb_put_binary_int(MB_YES, bluefin->environmental[i].sensor_time_nsec, &buffer[index]);
+				index += 4;
+				mb_put_binary_short(MB_YES, bluefin->environmental[i].sensor1, &buffer[index]);
+				index += 2;
+				mb_put_binary_short(MB_YES, bluefin->environmental[i].sensor2, &buffer[index]);
+				index += 2;
+				mb_put_binary_short(MB_YES, bluefin->environmental[i].sensor3, &buffer[index]);
+				index += 2;
+				mb_put_binary_short(MB_YES, bluefin->environmental[i].sensor4, &buffer[index]);
+				index += 2;
+				mb_put_binary_short(MB_YES, bluefin->environmental[i].sensor5, &buffer[index]);
+				index += 2;
+				mb_put_binary_short(MB_YES, bluefin->environmental[i].sensor6, &buffer[index]);
+				index += 2;
+				mb_put_binary_short(MB_YES, bluefin->environmental[i].sensor7, &buffer[index]);
+				index += 2;
+				mb_put_binary_short(MB_YES, bluefin->environmental[i].sensor8, &buffer[index]);
+				index += 2;
+				for (j = 0; j < 8; j++) {
+					buffer[index] = bluefin->environmental[i].reserved2[j];
+					index++;
+				}
+			}
+		}
+
+		/* reset the header size value */
+		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
 
-	/* print out the data to be output */
-	/*mbsys_reson7k_print_fsdwsegyheader(verbose, fsdwsegyheader, error);*/
+		/* now add the checksum */
+		checksum = 0;
+		for (i = 0; i < index; i++)
+			checksum += (unsigned char)buffer[i];
+		mb_put_binary_int(MB_YES, checksum, &buffer[index]);
+		index += 4;
 
-	/* extract the Edgetech segy header */
-	mb_put_binary_int(MB_YES, fsdwsegyheader->sequenceNumber, &buffer[*index]);
-	*index += 4;
-	mb_put_binary_int(MB_YES, fsdwsegyheader->startDepth, &buffer[*index]);
-	*index += 4;
-	mb_put_binary_int(MB_YES, fsdwsegyheader->pingNum, &buffer[*index]);
-	*index += 4;
-	mb_put_binary_int(MB_YES, fsdwsegyheader->channelNum, &buffer[*index]);
-	*index += 4;
-	for (i = 0; i < 6; i++) {
-		mb_put_binary_short(MB_YES, fsdwsegyheader->unused1[i], &buffer[*index]);
-		*index += 2;
-	}
-	mb_put_binary_short(MB_YES, fsdwsegyheader->traceIDCode, &buffer[*index]);
-	*index += 2;
-	for (i = 0; i < 2; i++) {
-		mb_put_binary_short(MB_YES, fsdwsegyheader->unused2[i], &buffer[*index]);
-		*index += 2;
-	}
-	mb_put_binary_short(MB_YES, fsdwsegyheader->dataFormat, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->NMEAantennaeR, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->NMEAantennaeO, &buffer[*index]);
-	*index += 2;
-	for (i = 0; i < 32; i++) {
-		buffer[*index] = fsdwsegyheader->RS232[i];
-		(*index)++;
-	}
-	mb_put_binary_int(MB_YES, fsdwsegyheader->sourceCoordX, &buffer[*index]);
-	*index += 4;
-	mb_put_binary_int(MB_YES, fsdwsegyheader->sourceCoordY, &buffer[*index]);
-	*index += 4;
-	mb_put_binary_int(MB_YES, fsdwsegyheader->groupCoordX, &buffer[*index]);
-	*index += 4;
-	mb_put_binary_int(MB_YES, fsdwsegyheader->groupCoordY, &buffer[*index]);
-	*index += 4;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->coordUnits, &buffer[*index]);
-	*index += 2;
-	for (i = 0; i < 24; i++) {
-		buffer[*index] = fsdwsegyheader->annotation[i];
-		(*index)++;
-	}
-	mb_put_binary_short(MB_YES, fsdwsegyheader->samples, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_int(MB_YES, fsdwsegyheader->sampleInterval, &buffer[*index]);
-	*index += 4;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->ADCGain, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->pulsePower, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->correlated, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->startFreq, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->endFreq, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->sweepLength, &buffer[*index]);
-	*index += 2;
-	for (i = 0; i < 4; i++) {
-		mb_put_binary_short(MB_YES, fsdwsegyheader->unused7[i], &buffer[*index]);
-		*index += 2;
-	}
-	mb_put_binary_short(MB_YES, fsdwsegyheader->aliasFreq, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->pulseID, &buffer[*index]);
-	*index += 2;
-	for (i = 0; i < 6; i++) {
-		mb_put_binary_short(MB_YES, fsdwsegyheader->unused8[i], &buffer[*index]);
-		*index += 2;
-	}
-	mb_put_binary_short(MB_YES, fsdwsegyheader->year, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->day, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->hour, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->minute, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->second, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->timeBasis, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->weightingFactor, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->unused9, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->heading, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->pitch, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->roll, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->temperature, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->heaveCompensation, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->trigSource, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->markNumber, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->NMEAHour, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->NMEAMinutes, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->NMEASeconds, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->NMEACourse, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->NMEASpeed, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->NMEADay, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->NMEAYear, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_int(MB_YES, fsdwsegyheader->millisecondsToday, &buffer[*index]);
-	*index += 4;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->ADCMax, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->calConst, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->vehicleID, &buffer[*index]);
-	*index += 2;
-	for (i = 0; i < 6; i++) {
-		buffer[*index] = fsdwsegyheader->softwareVersion[i];
-		(*index)++;
-	}
-	mb_put_binary_int(MB_YES, fsdwsegyheader->sphericalCorrection, &buffer[*index]);
-	*index += 4;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->packetNum, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->ADCDecimation, &buffer[*index]);
-	*index += 2;
-	mb_put_binary_short(MB_YES, fsdwsegyheader->decimation, &buffer[*index]);
-	*index += 2;
-	for (i = 0; i < 7; i++) {
-		mb_put_binary_short(MB_YES, fsdwsegyheader->unuseda[i], &buffer[*index]);
-		*index += 2;
+		/* check size */
+		if (*size != index) {
+			fprintf(stderr, "Bad size comparison: file:%s line:%d size:%d index:%d\n", __FILE__, __LINE__, *size, index);
+			status = MB_FAILURE;
+			*error = MB_ERROR_BAD_DATA;
+			*size = 0;
+		}
 	}
 
 	/* print output debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       index:      %d\n", *index);
+		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
+		fprintf(stderr, "dbg2       size:       %d\n", *size);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:  %d\n", status);
@@ -13277,16 +15380,12 @@ int mbr_reson7kr_wr_fsdwsegyheader(int verbose, char *buffer, int *index, s7k_fs
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_fsdwsslo(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_fsdwsslo";
+int mbr_reson7kr_wr_processedsidescan(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_processedsidescan";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_fsdwss *fsdwsslo;
-	s7k_fsdwchannel *fsdwchannel;
-	s7k_fsdwssheader *fsdwssheader;
-	s7kr_bathymetry *bathymetry;
-	s7kr_bluefin *bluefin;
+	s7kr_processedsidescan *processedsidescan;
 	unsigned int checksum;
 	int index;
 	char *buffer;
@@ -13303,44 +15402,25 @@ int mbr_reson7kr_wr_fsdwsslo(int verbose, int *bufferalloc, char **bufferptr, vo
 		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
 	}
 
-	/* get pointer to raw data structure */
-	store = (struct mbsys_reson7k_struct *)store_ptr;
-	fsdwsslo = &(store->fsdwsslo);
-	header = &(fsdwsslo->header);
-	bathymetry = &(store->bathymetry);
-	bluefin = &(store->bluefin);
-
-/* print out the data to be output */
-#ifdef MBR_RESON7KR_DEBUG2
-	if (verbose > 0)
-#else
-	if (verbose >= 2)
-#endif
-		mbsys_reson7k_print_fsdwss(verbose, fsdwsslo, error);
-#ifdef MBR_RESON7KR_DEBUG2
-	for (i = 0; i < fsdwsslo->number_channels; i++) {
-		fsdwchannel = &(fsdwsslo->channel[i]);
-		fsdwssheader = &(fsdwsslo->ssheader[i]);
-		fprintf(stderr,
-		        "SSLO: 7Ktime(%4.4d/%2.2d/%2.2d %2.2d:%2.2d:%2.2d.%6.6d) FSDWtime(%4.4d-%3.3d %2.2d:%2.2d:%2.2d.%3.3d) ping:%d "
-		        "%d chan:%d %d sampint:%d %d\n",
-		        store->time_i[0], store->time_i[1], store->time_i[2], store->time_i[3], store->time_i[4], store->time_i[5],
-		        store->time_i[6], fsdwssheader->year, fsdwssheader->day, fsdwssheader->hour, fsdwssheader->minute,
-		        fsdwssheader->second, fsdwssheader->millisecondsToday - 1000 * (int)(0.001 * fsdwssheader->millisecondsToday),
-		        fsdwsslo->ping_number, fsdwssheader->pingNum, fsdwchannel->number, fsdwssheader->channelNum,
-		        fsdwchannel->sample_interval, fsdwssheader->sampleInterval);
-	}
-#endif
+	/* get pointer to raw data structure */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+	processedsidescan = &(store->processedsidescan);
+	header = &(processedsidescan->header);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_FSDWsidescan;
-	for (i = 0; i < fsdwsslo->number_channels; i++) {
-		*size += R7KHDRSIZE_FSDWchannelinfo;
-		*size += R7KHDRSIZE_FSDWssheader;
-		fsdwchannel = &(fsdwsslo->channel[i]);
-		*size += fsdwchannel->bytespersample * fsdwchannel->number_samples;
-	}
+	*size += R7KHDRSIZE_ProcessedSidescan;
+	*size += processedsidescan->number_pixels * 8;
+	header->OffsetToOptionalData = 0;
+	header->Size = *size;
+
+/* print out the data to be output */
+#ifdef MBR_RESON7KR_DEBUG2
+	if (verbose > 0)
+#else
+	if (verbose >= 2)
+#endif
+		mbsys_reson7k_print_processedsidescan(verbose, processedsidescan, error);
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -13364,27 +15444,35 @@ int mbr_reson7kr_wr_fsdwsslo(int verbose, int *bufferalloc, char **bufferptr, vo
 
 		/* insert the data */
 		index = header->Offset + 4;
-		mb_put_binary_int(MB_YES, fsdwsslo->msec_timestamp, &buffer[index]);
+		mb_put_binary_long(MB_YES, processedsidescan->serial_number, &buffer[index]);
+		index += 8;
+		mb_put_binary_int(MB_YES, processedsidescan->ping_number, &buffer[index]);
 		index += 4;
-		mb_put_binary_int(MB_YES, fsdwsslo->ping_number, &buffer[index]);
+		mb_put_binary_short(MB_YES, processedsidescan->multi_ping, &buffer[index]);
+		index += 2;
+		mb_put_binary_short(MB_YES, processedsidescan->recordversion, &buffer[index]);
+		index += 2;
+		mb_put_binary_int(MB_YES, processedsidescan->ss_source, &buffer[index]);
 		index += 4;
-		mb_put_binary_int(MB_YES, fsdwsslo->number_channels, &buffer[index]);
+		mb_put_binary_int(MB_YES, processedsidescan->number_pixels, &buffer[index]);
 		index += 4;
-		mb_put_binary_int(MB_YES, fsdwsslo->total_bytes, &buffer[index]);
+		mb_put_binary_int(MB_YES, processedsidescan->ss_type, &buffer[index]);
 		index += 4;
-		mb_put_binary_int(MB_YES, fsdwsslo->data_format, &buffer[index]);
+		mb_put_binary_float(MB_YES, processedsidescan->pixelwidth, &buffer[index]);
 		index += 4;
-		index += 12;
-		for (i = 0; i < 2; i++) {
-			fsdwchannel = &(fsdwsslo->channel[i]);
-			mbr_reson7kr_wr_fsdwchannel(verbose, fsdwsslo->data_format, buffer, &index, fsdwchannel, error);
+		mb_put_binary_double(MB_YES, processedsidescan->sonardepth, &buffer[index]);
+		index += 8;
+		mb_put_binary_double(MB_YES, processedsidescan->altitude, &buffer[index]);
+		index += 8;
+
+		/* insert the data */
+		for (i = 0; i < processedsidescan->number_pixels; i++) {
+			mb_put_binary_float(MB_YES, processedsidescan->sidescan[i], &buffer[index]);
+			index += 4;
 		}
-		/*fprintf(stderr,"In mbr_reson7kr_wr_fsdwsslo: index:%d OffsetToOptionalData:%d\n",
-		index, header->OffsetToOptionalData);
-		    index = header->OffsetToOptionalData;*/
-		for (i = 0; i < 2; i++) {
-			fsdwssheader = &(fsdwsslo->ssheader[i]);
-			mbr_reson7kr_wr_fsdwssheader(verbose, buffer, &index, fsdwssheader, error);
+		for (i = 0; i < processedsidescan->number_pixels; i++) {
+			mb_put_binary_float(MB_YES, processedsidescan->alongtrack[i], &buffer[index]);
+			index += 4;
 		}
 
 		/* reset the header size value */
@@ -13421,14 +15509,13 @@ int mbr_reson7kr_wr_fsdwsslo(int verbose, int *bufferalloc, char **bufferptr, vo
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_fsdwsshi(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_fsdwsshi";
+int mbr_reson7kr_wr_volatilesonarsettings(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size,
+                                          int *error) {
+	char *function_name = "mbr_reson7kr_wr_volatilesonarsettings";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_fsdwss *fsdwsshi;
-	s7k_fsdwchannel *fsdwchannel;
-	s7k_fsdwssheader *fsdwssheader;
+	s7kr_volatilesettings *volatilesettings;
 	unsigned int checksum;
 	int index;
 	char *buffer;
@@ -13447,8 +15534,8 @@ int mbr_reson7kr_wr_fsdwsshi(int verbose, int *bufferalloc, char **bufferptr, vo
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	fsdwsshi = &(store->fsdwsshi);
-	header = &(fsdwsshi->header);
+	volatilesettings = &(store->volatilesettings);
+	header = &(volatilesettings->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -13456,31 +15543,11 @@ int mbr_reson7kr_wr_fsdwsshi(int verbose, int *bufferalloc, char **bufferptr, vo
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_fsdwss(verbose, fsdwsshi, error);
-#ifdef MBR_RESON7KR_DEBUG2
-	for (i = 0; i < fsdwsshi->number_channels; i++) {
-		fsdwchannel = &(fsdwsshi->channel[i]);
-		fsdwssheader = &(fsdwsshi->ssheader[i]);
-		fprintf(stderr,
-		        "SSHI: 7Ktime(%4.4d/%2.2d/%2.2d %2.2d:%2.2d:%2.2d.%6.6d) FSDWtime(%4.4d-%3.3d %2.2d:%2.2d:%2.2d.%3.3d) ping:%d "
-		        "%d chan:%d %d sampint:%d %d\n",
-		        store->time_i[0], store->time_i[1], store->time_i[2], store->time_i[3], store->time_i[4], store->time_i[5],
-		        store->time_i[6], fsdwssheader->year, fsdwssheader->day, fsdwssheader->hour, fsdwssheader->minute,
-		        fsdwssheader->second, fsdwssheader->millisecondsToday - 1000 * (int)(0.001 * fsdwssheader->millisecondsToday),
-		        fsdwsshi->ping_number, fsdwssheader->pingNum, fsdwchannel->number, fsdwssheader->channelNum,
-		        fsdwchannel->sample_interval, fsdwssheader->sampleInterval);
-	}
-#endif
+		mbsys_reson7k_print_volatilesettings(verbose, volatilesettings, error);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_FSDWsidescan;
-	for (i = 0; i < fsdwsshi->number_channels; i++) {
-		*size += R7KHDRSIZE_FSDWchannelinfo;
-		*size += R7KHDRSIZE_FSDWssheader;
-		fsdwchannel = &(fsdwsshi->channel[i]);
-		*size += fsdwchannel->bytespersample * fsdwchannel->number_samples;
-	}
+	*size += R7KHDRSIZE_7kVolatileSonarSettings;
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -13504,28 +15571,84 @@ int mbr_reson7kr_wr_fsdwsshi(int verbose, int *bufferalloc, char **bufferptr, vo
 
 		/* insert the data */
 		index = header->Offset + 4;
-		mb_put_binary_int(MB_YES, fsdwsshi->msec_timestamp, &buffer[index]);
+		mb_put_binary_long(MB_YES, volatilesettings->serial_number, &buffer[index]);
+		index += 8;
+		mb_put_binary_int(MB_YES, volatilesettings->ping_number, &buffer[index]);
 		index += 4;
-		mb_put_binary_int(MB_YES, fsdwsshi->ping_number, &buffer[index]);
+		mb_put_binary_short(MB_YES, volatilesettings->multi_ping, &buffer[index]);
+		index += 2;
+		mb_put_binary_float(MB_YES, volatilesettings->frequency, &buffer[index]);
 		index += 4;
-		mb_put_binary_int(MB_YES, fsdwsshi->number_channels, &buffer[index]);
+		mb_put_binary_float(MB_YES, volatilesettings->sample_rate, &buffer[index]);
 		index += 4;
-		mb_put_binary_int(MB_YES, fsdwsshi->total_bytes, &buffer[index]);
+		mb_put_binary_float(MB_YES, volatilesettings->receiver_bandwidth, &buffer[index]);
 		index += 4;
-		mb_put_binary_int(MB_YES, fsdwsshi->data_format, &buffer[index]);
+		mb_put_binary_float(MB_YES, volatilesettings->pulse_width, &buffer[index]);
 		index += 4;
-		index += 12;
-		for (i = 0; i < 2; i++) {
-			fsdwchannel = &(fsdwsshi->channel[i]);
-			mbr_reson7kr_wr_fsdwchannel(verbose, fsdwsshi->data_format, buffer, &index, fsdwchannel, error);
-		}
-		/*fprintf(stderr,"In mbr_reson7kr_wr_fsdwsshi: index:%d OffsetToOptionalData:%d\n",
-		index, header->OffsetToOptionalData);
-		    index = header->OffsetToOptionalData;*/
-		for (i = 0; i < 2; i++) {
-			fsdwssheader = &(fsdwsshi->ssheader[i]);
-			mbr_reson7kr_wr_fsdwssheader(verbose, buffer, &index, fsdwssheader, error);
-		}
+		mb_put_binary_int(MB_YES, volatilesettings->pulse_type, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, volatilesettings->pulse_envelope, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, volatilesettings->pulse_envelope_par, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, volatilesettings->pulse_reserved, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, volatilesettings->max_ping_rate, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, volatilesettings->ping_period, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, volatilesettings->range_selection, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, volatilesettings->power_selection, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, volatilesettings->gain_selection, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, volatilesettings->control_flags, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, volatilesettings->projector_magic_no, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, volatilesettings->steering_vertical, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, volatilesettings->steering_horizontal, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, volatilesettings->beamwidth_vertical, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, volatilesettings->beamwidth_horizontal, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, volatilesettings->focal_point, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, volatilesettings->projector_weighting, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, volatilesettings->projector_weighting_par, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, volatilesettings->transmit_flags, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, volatilesettings->hydrophone_magic_no, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, volatilesettings->receive_weighting, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, volatilesettings->receive_weighting_par, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, volatilesettings->receive_flags, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, volatilesettings->receive_width, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, volatilesettings->range_minimum, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, volatilesettings->range_maximum, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, volatilesettings->depth_minimum, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, volatilesettings->depth_maximum, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, volatilesettings->absorption, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, volatilesettings->sound_velocity, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, volatilesettings->spreading, &buffer[index]);
+		index += 4;
+		mb_put_binary_short(MB_YES, volatilesettings->reserved, &buffer[index]);
+		index += 2;
 
 		/* reset the header size value */
 		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
@@ -13561,18 +15684,17 @@ int mbr_reson7kr_wr_fsdwsshi(int verbose, int *bufferalloc, char **bufferptr, vo
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_fsdwsb(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_fsdwsb";
+int mbr_reson7kr_wr_configuration(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_configuration";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_fsdwsb *fsdwsb;
-	s7k_fsdwchannel *fsdwchannel;
-	s7k_fsdwsegyheader *fsdwsegyheader;
+	s7kr_configuration *configuration;
+	s7k_device *device;
 	unsigned int checksum;
 	int index;
 	char *buffer;
-	int i;
+	int i, j;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -13587,8 +15709,8 @@ int mbr_reson7kr_wr_fsdwsb(int verbose, int *bufferalloc, char **bufferptr, void
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	fsdwsb = &(store->fsdwsb);
-	header = &(fsdwsb->header);
+	configuration = &(store->configuration);
+	header = &(configuration->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -13596,35 +15718,15 @@ int mbr_reson7kr_wr_fsdwsb(int verbose, int *bufferalloc, char **bufferptr, void
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_fsdwsb(verbose, fsdwsb, error);
-#ifdef MBR_RESON7KR_DEBUG2
-	for (i = 0; i < fsdwsb->number_channels; i++) {
-		fsdwchannel = &(fsdwsb->channel);
-		fsdwsegyheader = &(fsdwsb->segyheader);
-		fprintf(stderr,
-		        "SBP:  7Ktime(%4.4d/%2.2d/%2.2d %2.2d:%2.2d:%2.2d.%6.6d) FSDWtime(%4.4d-%3.3d %2.2d:%2.2d:%2.2d.%3.3d) ping:%d "
-		        "%d chan:%d %d sampint:%d %d\n",
-		        store->time_i[0], store->time_i[1], store->time_i[2], store->time_i[3], store->time_i[4], store->time_i[5],
-		        store->time_i[6], fsdwsegyheader->year, fsdwsegyheader->day, fsdwsegyheader->hour, fsdwsegyheader->minute,
-		        fsdwsegyheader->second,
-		        fsdwsegyheader->millisecondsToday - 1000 * (int)(0.001 * fsdwsegyheader->millisecondsToday), fsdwsb->ping_number,
-		        fsdwsegyheader->pingNum, fsdwchannel->number, fsdwsegyheader->channelNum, fsdwchannel->sample_interval,
-		        fsdwsegyheader->sampleInterval);
-	}
-#endif
-
-	/* figure out size of output record */
-	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_FSDWsubbottom;
+		mbsys_reson7k_print_configuration(verbose, configuration, error);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_FSDWsubbottom;
-	for (i = 0; i < fsdwsb->number_channels; i++) {
-		*size += R7KHDRSIZE_FSDWchannelinfo;
-		*size += R7KHDRSIZE_FSDWsbheader;
-		fsdwchannel = &(fsdwsb->channel);
-		*size += fsdwchannel->bytespersample * fsdwchannel->number_samples;
+	*size += R7KHDRSIZE_7kConfiguration;
+	for (i = 0; i < configuration->number_devices; i++) {
+		*size += 80;
+		device = &(configuration->device[i]);
+		*size += device->info_length;
 	}
 
 	/* allocate memory to write rest of record if necessary */
@@ -13647,24 +15749,32 @@ int mbr_reson7kr_wr_fsdwsb(int verbose, int *bufferalloc, char **bufferptr, void
 		index = 0;
 		status = mbr_reson7kr_wr_header(verbose, buffer, &index, header, error);
 
-		/* insert the data */
-		index = header->Offset + 4;
-		mb_put_binary_int(MB_YES, fsdwsb->msec_timestamp, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, fsdwsb->ping_number, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, fsdwsb->number_channels, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, fsdwsb->total_bytes, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, fsdwsb->data_format, &buffer[index]);
-		index += 4;
-		index += 12;
-		fsdwchannel = &(fsdwsb->channel);
-		mbr_reson7kr_wr_fsdwchannel(verbose, fsdwsb->data_format, buffer, &index, fsdwchannel, error);
-		/* fprintf(stderr,"index:%d offset:%d\n",index,header->OffsetToOptionalData);*/
-		fsdwsegyheader = &(fsdwsb->segyheader);
-		mbr_reson7kr_wr_fsdwsegyheader(verbose, buffer, &index, fsdwsegyheader, error);
+		/* insert the data */
+		index = header->Offset + 4;
+		mb_put_binary_long(MB_YES, configuration->serial_number, &buffer[index]);
+		index += 8;
+		mb_put_binary_int(MB_YES, configuration->number_devices, &buffer[index]);
+		index += 4;
+
+		/* extract the data for each device */
+		for (i = 0; i < configuration->number_devices; i++) {
+			device = &(configuration->device[i]);
+			mb_put_binary_int(MB_YES, device->magic_number, &buffer[index]);
+			index += 4;
+			for (j = 0; j < 64; j++) {
+				buffer[index] = device->description[j];
+				index++;
+			}
+			mb_put_binary_long(MB_YES, device->serial_number, &buffer[index]);
+			index += 8;
+			mb_put_binary_int(MB_YES, device->info_length, &buffer[index]);
+			index += 4;
+
+			for (j = 0; j < device->info_length; j++) {
+				buffer[index] = device->info[j];
+				index++;
+			}
+		}
 
 		/* reset the header size value */
 		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
@@ -13700,16 +15810,16 @@ int mbr_reson7kr_wr_fsdwsb(int verbose, int *bufferalloc, char **bufferptr, void
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_bluefin(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_bluefin";
+int mbr_reson7kr_wr_matchfilter(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_matchfilter";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_bluefin *bluefin;
+	s7kr_matchfilter *matchfilter;
 	unsigned int checksum;
 	int index;
 	char *buffer;
-	int i, j;
+	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -13724,8 +15834,8 @@ int mbr_reson7kr_wr_bluefin(int verbose, int *bufferalloc, char **bufferptr, voi
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	bluefin = &(store->bluefin);
-	header = &(bluefin->header);
+	matchfilter = &(store->matchfilter);
+	header = &(matchfilter->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -13733,12 +15843,11 @@ int mbr_reson7kr_wr_bluefin(int verbose, int *bufferalloc, char **bufferptr, voi
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_bluefin(verbose, bluefin, error);
+		mbsys_reson7k_print_matchfilter(verbose, matchfilter, error);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_BluefinDataFrame;
-	*size += bluefin->number_frames * bluefin->frame_size;
+	*size += R7KHDRSIZE_7kMatchFilter;
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -13762,160 +15871,16 @@ int mbr_reson7kr_wr_bluefin(int verbose, int *bufferalloc, char **bufferptr, voi
 
 		/* insert the data */
 		index = header->Offset + 4;
-		mb_put_binary_int(MB_YES, bluefin->msec_timestamp, &buffer[index]);
+		mb_put_binary_long(MB_YES, matchfilter->serial_number, &buffer[index]);
+		index += 8;
+		mb_put_binary_int(MB_YES, matchfilter->ping_number, &buffer[index]);
 		index += 4;
-		mb_put_binary_int(MB_YES, bluefin->number_frames, &buffer[index]);
+		mb_put_binary_int(MB_YES, matchfilter->operation, &buffer[index]);
 		index += 4;
-		mb_put_binary_int(MB_YES, bluefin->frame_size, &buffer[index]);
+		mb_put_binary_float(MB_YES, matchfilter->start_frequency, &buffer[index]);
 		index += 4;
-		mb_put_binary_int(MB_YES, bluefin->data_format, &buffer[index]);
+		mb_put_binary_float(MB_YES, matchfilter->end_frequency, &buffer[index]);
 		index += 4;
-		for (i = 0; i < 16; i++) {
-			buffer[index] = bluefin->reserved[i];
-			index++;
-		}
-		if (bluefin->data_format == R7KRECID_BluefinNav) {
-			for (i = 0; i < bluefin->number_frames; i++) {
-				mb_put_binary_int(MB_YES, bluefin->nav[i].packet_size, &buffer[index]);
-				index += 4;
-				mb_put_binary_short(MB_YES, bluefin->nav[i].version, &buffer[index]);
-				index += 2;
-				mb_put_binary_short(MB_YES, bluefin->nav[i].offset, &buffer[index]);
-				index += 2;
-				mb_put_binary_int(MB_YES, bluefin->nav[i].data_type, &buffer[index]);
-				index += 4;
-				mb_put_binary_int(MB_YES, bluefin->nav[i].data_size, &buffer[index]);
-				index += 4;
-				mb_put_binary_short(MB_YES, bluefin->nav[i].s7kTime.Year, &buffer[index]);
-				index += 2;
-				mb_put_binary_short(MB_YES, bluefin->nav[i].s7kTime.Day, &buffer[index]);
-				index += 2;
-				mb_put_binary_float(MB_YES, bluefin->nav[i].s7kTime.Seconds, &buffer[index]);
-				index += 4;
-				buffer[index] = bluefin->nav[i].s7kTime.Hours;
-				(index)++;
-				buffer[index] = bluefin->nav[i].s7kTime.Minutes;
-				(index)++;
-				mb_put_binary_int(MB_YES, bluefin->nav[i].checksum, &buffer[index]);
-				index += 4;
-				mb_put_binary_short(MB_YES, bluefin->nav[i].timedelay, &buffer[index]);
-				index += 2;
-				mb_put_binary_int(MB_YES, bluefin->nav[i].quality, &buffer[index]);
-				index += 4;
-				mb_put_binary_double(MB_YES, bluefin->nav[i].latitude, &buffer[index]);
-				index += 8;
-				mb_put_binary_double(MB_YES, bluefin->nav[i].longitude, &buffer[index]);
-				index += 8;
-				mb_put_binary_float(MB_YES, bluefin->nav[i].speed, &buffer[index]);
-				index += 4;
-				mb_put_binary_double(MB_YES, bluefin->nav[i].depth, &buffer[index]);
-				index += 8;
-				mb_put_binary_double(MB_YES, bluefin->nav[i].altitude, &buffer[index]);
-				index += 8;
-				mb_put_binary_float(MB_YES, bluefin->nav[i].roll, &buffer[index]);
-				index += 4;
-				mb_put_binary_float(MB_YES, bluefin->nav[i].pitch, &buffer[index]);
-				index += 4;
-				mb_put_binary_float(MB_YES, bluefin->nav[i].yaw, &buffer[index]);
-				index += 4;
-				mb_put_binary_float(MB_YES, bluefin->nav[i].northing_rate, &buffer[index]);
-				index += 4;
-				mb_put_binary_float(MB_YES, bluefin->nav[i].easting_rate, &buffer[index]);
-				index += 4;
-				mb_put_binary_float(MB_YES, bluefin->nav[i].depth_rate, &buffer[index]);
-				index += 4;
-				mb_put_binary_float(MB_YES, bluefin->nav[i].altitude_rate, &buffer[index]);
-				index += 4;
-				mb_put_binary_float(MB_YES, bluefin->nav[i].roll_rate, &buffer[index]);
-				index += 4;
-				mb_put_binary_float(MB_YES, bluefin->nav[i].pitch_rate, &buffer[index]);
-				index += 4;
-				mb_put_binary_float(MB_YES, bluefin->nav[i].yaw_rate, &buffer[index]);
-				index += 4;
-				mb_put_binary_double(MB_YES, bluefin->nav[i].position_time, &buffer[index]);
-				index += 8;
-				mb_put_binary_double(MB_YES, bluefin->nav[i].depth_time, &buffer[index]);
-				index += 8;
-			}
-		}
-		else if (bluefin->data_format == R7KRECID_BluefinEnvironmental) {
-			for (i = 0; i < bluefin->number_frames; i++) {
-				mb_put_binary_int(MB_YES, bluefin->environmental[i].packet_size, &buffer[index]);
-				index += 4;
-				mb_put_binary_short(MB_YES, bluefin->environmental[i].version, &buffer[index]);
-				index += 2;
-				mb_put_binary_short(MB_YES, bluefin->environmental[i].offset, &buffer[index]);
-				index += 2;
-				mb_put_binary_int(MB_YES, bluefin->environmental[i].data_type, &buffer[index]);
-				index += 4;
-				mb_put_binary_int(MB_YES, bluefin->environmental[i].data_size, &buffer[index]);
-				index += 4;
-				mb_put_binary_short(MB_YES, bluefin->environmental[i].s7kTime.Year, &buffer[index]);
-				index += 2;
-				mb_put_binary_short(MB_YES, bluefin->environmental[i].s7kTime.Day, &buffer[index]);
-				index += 2;
-				mb_put_binary_float(MB_YES, bluefin->environmental[i].s7kTime.Seconds, &buffer[index]);
-				index += 4;
-				buffer[index] = bluefin->environmental[i].s7kTime.Hours;
-				(index)++;
-				buffer[index] = bluefin->environmental[i].s7kTime.Minutes;
-				(index)++;
-				mb_put_binary_int(MB_YES, bluefin->environmental[i].checksum, &buffer[index]);
-				index += 4;
-				mb_put_binary_short(MB_YES, bluefin->environmental[i].reserved1, &buffer[index]);
-				index += 2;
-				mb_put_binary_int(MB_YES, bluefin->environmental[i].quality, &buffer[index]);
-				index += 4;
-				mb_put_binary_float(MB_YES, bluefin->environmental[i].sound_speed, &buffer[index]);
-				index += 4;
-				mb_put_binary_float(MB_YES, bluefin->environmental[i].conductivity, &buffer[index]);
-				index += 4;
-				mb_put_binary_float(MB_YES, bluefin->environmental[i].temperature, &buffer[index]);
-				index += 4;
-				mb_put_binary_float(MB_YES, bluefin->environmental[i].pressure, &buffer[index]);
-				index += 4;
-				mb_put_binary_float(MB_YES, bluefin->environmental[i].salinity, &buffer[index]);
-				index += 4;
-				mb_put_binary_double(MB_YES, bluefin->environmental[i].ctd_time, &buffer[index]);
-				index += 8;
-				mb_put_binary_double(MB_YES, bluefin->environmental[i].temperature_time, &buffer[index]);
-				index += 8;
-				mb_put_binary_double(MB_YES, bluefin->environmental[i].surface_pressure, &buffer[index]);
-				index += 8;
-				mb_put_binary_int(MB_YES, bluefin->environmental[i].temperature_counts, &buffer[index]);
-				index += 4;
-				mb_put_binary_float(MB_YES, bluefin->environmental[i].conductivity_frequency, &buffer[index]);
-				index += 4;
-				mb_put_binary_int(MB_YES, bluefin->environmental[i].pressure_counts, &buffer[index]);
-				index += 4;
-				mb_put_binary_float(MB_YES, bluefin->environmental[i].pressure_comp_voltage, &buffer[index]);
-				index += 4;
-				mb_put_binary_int(MB_YES, bluefin->environmental[i].sensor_time_sec, &buffer[index]);
-				index += 4;
-				mb_put_binary_int(MB_YES, bluefin->environmental[i].sensor_time_nsec, &buffer[index]);
-				index += 4;
-				mb_put_binary_short(MB_YES, bluefin->environmental[i].sensor1, &buffer[index]);
-				index += 2;
-				mb_put_binary_short(MB_YES, bluefin->environmental[i].sensor2, &buffer[index]);
-				index += 2;
-				mb_put_binary_short(MB_YES, bluefin->environmental[i].sensor3, &buffer[index]);
-				index += 2;
-				mb_put_binary_short(MB_YES, bluefin->environmental[i].sensor4, &buffer[index]);
-				index += 2;
-				mb_put_binary_short(MB_YES, bluefin->environmental[i].sensor5, &buffer[index]);
-				index += 2;
-				mb_put_binary_short(MB_YES, bluefin->environmental[i].sensor6, &buffer[index]);
-				index += 2;
-				mb_put_binary_short(MB_YES, bluefin->environmental[i].sensor7, &buffer[index]);
-				index += 2;
-				mb_put_binary_short(MB_YES, bluefin->environmental[i].sensor8, &buffer[index]);
-				index += 2;
-				for (j = 0; j < 8; j++) {
-					buffer[index] = bluefin->environmental[i].reserved2[j];
-					index++;
-				}
-			}
-		}
 
 		/* reset the header size value */
 		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
@@ -13951,12 +15916,13 @@ int mbr_reson7kr_wr_bluefin(int verbose, int *bufferalloc, char **bufferptr, voi
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_processedsidescan(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_processedsidescan";
+int mbr_reson7kr_wr_v2firmwarehardwareconfiguration(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size,
+                                                    int *error) {
+	char *function_name = "mbr_reson7kr_wr_v2firmwarehardwareconfiguration";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_processedsidescan *processedsidescan;
+	s7kr_v2firmwarehardwareconfiguration *v2firmwarehardwareconfiguration;
 	unsigned int checksum;
 	int index;
 	char *buffer;
@@ -13975,15 +15941,8 @@ int mbr_reson7kr_wr_processedsidescan(int verbose, int *bufferalloc, char **buff
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	processedsidescan = &(store->processedsidescan);
-	header = &(processedsidescan->header);
-
-	/* figure out size of output record */
-	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_ProcessedSidescan;
-	*size += processedsidescan->number_pixels * 8;
-	header->OffsetToOptionalData = 0;
-	header->Size = *size;
+	v2firmwarehardwareconfiguration = &(store->v2firmwarehardwareconfiguration);
+	header = &(v2firmwarehardwareconfiguration->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -13991,7 +15950,12 @@ int mbr_reson7kr_wr_processedsidescan(int verbose, int *bufferalloc, char **buff
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_processedsidescan(verbose, processedsidescan, error);
+		mbsys_reson7k_print_v2firmwarehardwareconfiguration(verbose, v2firmwarehardwareconfiguration, error);
+
+	/* figure out size of output record */
+	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
+	*size += R7KHDRSIZE_7kV2FirmwareHardwareConfiguration;
+	*size += v2firmwarehardwareconfiguration->info_length;
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -14015,35 +15979,15 @@ int mbr_reson7kr_wr_processedsidescan(int verbose, int *bufferalloc, char **buff
 
 		/* insert the data */
 		index = header->Offset + 4;
-		mb_put_binary_long(MB_YES, processedsidescan->serial_number, &buffer[index]);
-		index += 8;
-		mb_put_binary_int(MB_YES, processedsidescan->ping_number, &buffer[index]);
-		index += 4;
-		mb_put_binary_short(MB_YES, processedsidescan->multi_ping, &buffer[index]);
-		index += 2;
-		mb_put_binary_short(MB_YES, processedsidescan->recordversion, &buffer[index]);
-		index += 2;
-		mb_put_binary_int(MB_YES, processedsidescan->ss_source, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, processedsidescan->number_pixels, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, processedsidescan->ss_type, &buffer[index]);
+		mb_put_binary_int(MB_YES, v2firmwarehardwareconfiguration->device_count, &buffer[index]);
 		index += 4;
-		mb_put_binary_float(MB_YES, processedsidescan->pixelwidth, &buffer[index]);
+		mb_put_binary_int(MB_YES, v2firmwarehardwareconfiguration->info_length, &buffer[index]);
 		index += 4;
-		mb_put_binary_double(MB_YES, processedsidescan->sonardepth, &buffer[index]);
-		index += 8;
-		mb_put_binary_double(MB_YES, processedsidescan->altitude, &buffer[index]);
-		index += 8;
 
-		/* insert the data */
-		for (i = 0; i < processedsidescan->number_pixels; i++) {
-			mb_put_binary_float(MB_YES, processedsidescan->sidescan[i], &buffer[index]);
-			index += 4;
-		}
-		for (i = 0; i < processedsidescan->number_pixels; i++) {
-			mb_put_binary_float(MB_YES, processedsidescan->alongtrack[i], &buffer[index]);
-			index += 4;
+		/* extract the info */
+		for (i = 0; i < v2firmwarehardwareconfiguration->info_length; i++) {
+			buffer[index] = v2firmwarehardwareconfiguration->info[i];
+			index++;
 		}
 
 		/* reset the header size value */
@@ -14080,13 +16024,12 @@ int mbr_reson7kr_wr_processedsidescan(int verbose, int *bufferalloc, char **buff
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_volatilesonarsettings(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size,
-                                          int *error) {
-	char *function_name = "mbr_reson7kr_wr_volatilesonarsettings";
+int mbr_reson7kr_wr_beamgeometry(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_beamgeometry";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_volatilesettings *volatilesettings;
+	s7kr_beamgeometry *beamgeometry;
 	unsigned int checksum;
 	int index;
 	char *buffer;
@@ -14105,8 +16048,8 @@ int mbr_reson7kr_wr_volatilesonarsettings(int verbose, int *bufferalloc, char **
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	volatilesettings = &(store->volatilesettings);
-	header = &(volatilesettings->header);
+	beamgeometry = &(store->beamgeometry);
+	header = &(beamgeometry->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -14114,11 +16057,12 @@ int mbr_reson7kr_wr_volatilesonarsettings(int verbose, int *bufferalloc, char **
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_volatilesettings(verbose, volatilesettings, error);
+		mbsys_reson7k_print_beamgeometry(verbose, beamgeometry, error);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_7kVolatileSonarSettings;
+	*size += R7KHDRSIZE_7kBeamGeometry;
+	*size += beamgeometry->number_beams * 16;
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -14142,84 +16086,28 @@ int mbr_reson7kr_wr_volatilesonarsettings(int verbose, int *bufferalloc, char **
 
 		/* insert the data */
 		index = header->Offset + 4;
-		mb_put_binary_long(MB_YES, volatilesettings->serial_number, &buffer[index]);
+		mb_put_binary_long(MB_YES, beamgeometry->serial_number, &buffer[index]);
 		index += 8;
-		mb_put_binary_int(MB_YES, volatilesettings->ping_number, &buffer[index]);
-		index += 4;
-		mb_put_binary_short(MB_YES, volatilesettings->multi_ping, &buffer[index]);
-		index += 2;
-		mb_put_binary_float(MB_YES, volatilesettings->frequency, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, volatilesettings->sample_rate, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, volatilesettings->receiver_bandwidth, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, volatilesettings->pulse_width, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, volatilesettings->pulse_type, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, volatilesettings->pulse_envelope, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, volatilesettings->pulse_envelope_par, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, volatilesettings->pulse_reserved, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, volatilesettings->max_ping_rate, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, volatilesettings->ping_period, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, volatilesettings->range_selection, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, volatilesettings->power_selection, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, volatilesettings->gain_selection, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, volatilesettings->control_flags, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, volatilesettings->projector_magic_no, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, volatilesettings->steering_vertical, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, volatilesettings->steering_horizontal, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, volatilesettings->beamwidth_vertical, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, volatilesettings->beamwidth_horizontal, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, volatilesettings->focal_point, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, volatilesettings->projector_weighting, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, volatilesettings->projector_weighting_par, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, volatilesettings->transmit_flags, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, volatilesettings->hydrophone_magic_no, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, volatilesettings->receive_weighting, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, volatilesettings->receive_weighting_par, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, volatilesettings->receive_flags, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, volatilesettings->receive_width, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, volatilesettings->range_minimum, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, volatilesettings->range_maximum, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, volatilesettings->depth_minimum, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, volatilesettings->depth_maximum, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, volatilesettings->absorption, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, volatilesettings->sound_velocity, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, volatilesettings->spreading, &buffer[index]);
+		mb_put_binary_int(MB_YES, beamgeometry->number_beams, &buffer[index]);
 		index += 4;
-		mb_put_binary_short(MB_YES, volatilesettings->reserved, &buffer[index]);
-		index += 2;
+
+		/* insert the data */
+		for (i = 0; i < beamgeometry->number_beams; i++) {
+			mb_put_binary_float(MB_YES, beamgeometry->angle_alongtrack[i], &buffer[index]);
+			index += 4;
+		}
+		for (i = 0; i < beamgeometry->number_beams; i++) {
+			mb_put_binary_float(MB_YES, beamgeometry->angle_acrosstrack[i], &buffer[index]);
+			index += 4;
+		}
+		for (i = 0; i < beamgeometry->number_beams; i++) {
+			mb_put_binary_float(MB_YES, beamgeometry->beamwidth_alongtrack[i], &buffer[index]);
+			index += 4;
+		}
+		for (i = 0; i < beamgeometry->number_beams; i++) {
+			mb_put_binary_float(MB_YES, beamgeometry->beamwidth_acrosstrack[i], &buffer[index]);
+			index += 4;
+		}
 
 		/* reset the header size value */
 		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
@@ -14255,17 +16143,16 @@ int mbr_reson7kr_wr_volatilesonarsettings(int verbose, int *bufferalloc, char **
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_configuration(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_configuration";
+int mbr_reson7kr_wr_calibration(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_calibration";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_configuration *configuration;
-	s7k_device *device;
+	s7kr_calibration *calibration;
 	unsigned int checksum;
 	int index;
 	char *buffer;
-	int i, j;
+	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -14280,8 +16167,8 @@ int mbr_reson7kr_wr_configuration(int verbose, int *bufferalloc, char **bufferpt
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	configuration = &(store->configuration);
-	header = &(configuration->header);
+	calibration = &(store->calibration);
+	header = &(calibration->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -14289,16 +16176,12 @@ int mbr_reson7kr_wr_configuration(int verbose, int *bufferalloc, char **bufferpt
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_configuration(verbose, configuration, error);
+		mbsys_reson7k_print_calibration(verbose, calibration, error);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_7kConfiguration;
-	for (i = 0; i < configuration->number_devices; i++) {
-		*size += 80;
-		device = &(configuration->device[i]);
-		*size += device->info_length;
-	}
+	*size += R7KHDRSIZE_7kCalibrationData;
+	*size += calibration->number_channels * 8;
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -14322,29 +16205,19 @@ int mbr_reson7kr_wr_configuration(int verbose, int *bufferalloc, char **bufferpt
 
 		/* insert the data */
 		index = header->Offset + 4;
-		mb_put_binary_long(MB_YES, configuration->serial_number, &buffer[index]);
+		mb_put_binary_long(MB_YES, calibration->serial_number, &buffer[index]);
 		index += 8;
-		mb_put_binary_int(MB_YES, configuration->number_devices, &buffer[index]);
-		index += 4;
+		mb_put_binary_short(MB_YES, calibration->number_channels, &buffer[index]);
+		index += 2;
 
-		/* extract the data for each device */
-		for (i = 0; i < configuration->number_devices; i++) {
-			device = &(configuration->device[i]);
-			mb_put_binary_int(MB_YES, device->magic_number, &buffer[index]);
+		/* insert the data */
+		for (i = 0; i < calibration->number_channels; i++) {
+			mb_put_binary_float(MB_YES, calibration->gain[i], &buffer[index]);
 			index += 4;
-			for (j = 0; j < 64; j++) {
-				buffer[index] = device->description[j];
-				index++;
-			}
-			mb_put_binary_long(MB_YES, device->serial_number, &buffer[index]);
-			index += 8;
-			mb_put_binary_int(MB_YES, device->info_length, &buffer[index]);
+		}
+		for (i = 0; i < calibration->number_channels; i++) {
+			mb_put_binary_float(MB_YES, calibration->phase[i], &buffer[index]);
 			index += 4;
-
-			for (j = 0; j < device->info_length; j++) {
-				buffer[index] = device->info[j];
-				index++;
-			}
 		}
 
 		/* reset the header size value */
@@ -14381,12 +16254,12 @@ int mbr_reson7kr_wr_configuration(int verbose, int *bufferalloc, char **bufferpt
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_matchfilter(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_matchfilter";
+int mbr_reson7kr_wr_bathymetry(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_bathymetry";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_matchfilter *matchfilter;
+	s7kr_bathymetry *bathymetry;
 	unsigned int checksum;
 	int index;
 	char *buffer;
@@ -14405,8 +16278,21 @@ int mbr_reson7kr_wr_matchfilter(int verbose, int *bufferalloc, char **bufferptr,
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	matchfilter = &(store->matchfilter);
-	header = &(matchfilter->header);
+	bathymetry = &(store->bathymetry);
+	header = &(bathymetry->header);
+
+	/* figure out size of output record */
+	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
+	*size += R7KHDRSIZE_7kBathymetricData;
+	*size += bathymetry->number_beams * 17;
+	if (bathymetry->optionaldata == MB_YES) {
+		*size += 45 + bathymetry->number_beams * 20;
+		header->OffsetToOptionalData =
+		    MBSYS_RESON7K_RECORDHEADER_SIZE + R7KHDRSIZE_7kBathymetricData + bathymetry->number_beams * 17;
+	}
+	else
+		header->OffsetToOptionalData = 0;
+	header->Size = *size;
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -14414,11 +16300,7 @@ int mbr_reson7kr_wr_matchfilter(int verbose, int *bufferalloc, char **bufferptr,
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_matchfilter(verbose, matchfilter, error);
-
-	/* figure out size of output record */
-	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_7kMatchFilter;
+		mbsys_reson7k_print_bathymetry(verbose, bathymetry, error);
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -14436,23 +16318,91 @@ int mbr_reson7kr_wr_matchfilter(int verbose, int *bufferalloc, char **bufferptr,
 		/* get buffer for writing */
 		buffer = (char *)*bufferptr;
 
+		/* make sure the version number is right */
+		if (header->Version < 5)
+			header->Version = 5;
+
 		/* insert the header */
 		index = 0;
 		status = mbr_reson7kr_wr_header(verbose, buffer, &index, header, error);
 
 		/* insert the data */
 		index = header->Offset + 4;
-		mb_put_binary_long(MB_YES, matchfilter->serial_number, &buffer[index]);
+		mb_put_binary_long(MB_YES, bathymetry->serial_number, &buffer[index]);
 		index += 8;
-		mb_put_binary_int(MB_YES, matchfilter->ping_number, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, matchfilter->operation, &buffer[index]);
+		mb_put_binary_int(MB_YES, bathymetry->ping_number, &buffer[index]);
 		index += 4;
-		mb_put_binary_float(MB_YES, matchfilter->start_frequency, &buffer[index]);
+		mb_put_binary_short(MB_YES, bathymetry->multi_ping, &buffer[index]);
+		index += 2;
+		mb_put_binary_int(MB_YES, bathymetry->number_beams, &buffer[index]);
 		index += 4;
-		mb_put_binary_float(MB_YES, matchfilter->end_frequency, &buffer[index]);
+		buffer[index] = bathymetry->layer_comp_flag;
+		index++;
+		buffer[index] = bathymetry->sound_vel_flag;
+		index++;
+		mb_put_binary_float(MB_YES, bathymetry->sound_velocity, &buffer[index]);
 		index += 4;
 
+		/* insert the data */
+		for (i = 0; i < bathymetry->number_beams; i++) {
+			mb_put_binary_float(MB_YES, bathymetry->range[i], &buffer[index]);
+			index += 4;
+		}
+		for (i = 0; i < bathymetry->number_beams; i++) {
+			buffer[index] = bathymetry->quality[i];
+			index++;
+		}
+		for (i = 0; i < bathymetry->number_beams; i++) {
+			mb_put_binary_float(MB_YES, bathymetry->intensity[i], &buffer[index]);
+			index += 4;
+		}
+		for (i = 0; i < bathymetry->number_beams; i++) {
+			mb_put_binary_float(MB_YES, bathymetry->min_depth_gate[i], &buffer[index]);
+			index += 4;
+		}
+		for (i = 0; i < bathymetry->number_beams; i++) {
+			mb_put_binary_float(MB_YES, bathymetry->max_depth_gate[i], &buffer[index]);
+			index += 4;
+		}
+
+		/* insert the optional data */
+		if (bathymetry->optionaldata == MB_YES) {
+			mb_put_binary_float(MB_YES, bathymetry->frequency, &buffer[index]);
+			index += 4;
+			mb_put_binary_double(MB_YES, bathymetry->latitude, &buffer[index]);
+			index += 8;
+			mb_put_binary_double(MB_YES, bathymetry->longitude, &buffer[index]);
+			index += 8;
+			mb_put_binary_float(MB_YES, bathymetry->heading, &buffer[index]);
+			index += 4;
+			buffer[index] = bathymetry->height_source;
+			index++;
+			mb_put_binary_float(MB_YES, bathymetry->tide, &buffer[index]);
+			index += 4;
+			mb_put_binary_float(MB_YES, bathymetry->roll, &buffer[index]);
+			index += 4;
+			mb_put_binary_float(MB_YES, bathymetry->pitch, &buffer[index]);
+			index += 4;
+			mb_put_binary_float(MB_YES, bathymetry->heave, &buffer[index]);
+			index += 4;
+			mb_put_binary_float(MB_YES, bathymetry->vehicle_height, &buffer[index]);
+			index += 4;
+			for (i = 0; i < bathymetry->number_beams; i++) {
+				mb_put_binary_float(MB_YES, bathymetry->depth[i], &buffer[index]);
+				index += 4;
+				mb_put_binary_float(MB_YES, bathymetry->alongtrack[i], &buffer[index]);
+				index += 4;
+				mb_put_binary_float(MB_YES, bathymetry->acrosstrack[i], &buffer[index]);
+				index += 4;
+				mb_put_binary_float(MB_YES, bathymetry->pointing_angle[i], &buffer[index]);
+				index += 4;
+				mb_put_binary_float(MB_YES, bathymetry->azimuth_angle[i], &buffer[index]);
+				index += 4;
+//fprintf(stderr,"WRITE BEAM:%d d:%f l:%f x:%f ax:%f az:%f\n",
+//i,bathymetry->depth[i],bathymetry->alongtrack[i],bathymetry->acrosstrack[i],bathymetry->pointing_angle[i],bathymetry->azimuth_angle[i]);
+			}
+		}
+
 		/* reset the header size value */
 		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
 
@@ -14487,16 +16437,18 @@ int mbr_reson7kr_wr_matchfilter(int verbose, int *bufferalloc, char **bufferptr,
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_v2firmwarehardwareconfiguration(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size,
-                                                    int *error) {
-	char *function_name = "mbr_reson7kr_wr_v2firmwarehardwareconfiguration";
+int mbr_reson7kr_wr_backscatter(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_backscatter";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_v2firmwarehardwareconfiguration *v2firmwarehardwareconfiguration;
+	s7kr_backscatter *backscatter;
+	int data_size;
 	unsigned int checksum;
 	int index;
 	char *buffer;
+	short *short_ptr;
+	int *int_ptr;
 	int i;
 
 	/* print input debug statements */
@@ -14512,8 +16464,8 @@ int mbr_reson7kr_wr_v2firmwarehardwareconfiguration(int verbose, int *bufferallo
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	v2firmwarehardwareconfiguration = &(store->v2firmwarehardwareconfiguration);
-	header = &(v2firmwarehardwareconfiguration->header);
+	backscatter = &(store->backscatter);
+	header = &(backscatter->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -14521,12 +16473,15 @@ int mbr_reson7kr_wr_v2firmwarehardwareconfiguration(int verbose, int *bufferallo
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_v2firmwarehardwareconfiguration(verbose, v2firmwarehardwareconfiguration, error);
+		mbsys_reson7k_print_backscatter(verbose, backscatter, error);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_7kV2FirmwareHardwareConfiguration;
-	*size += v2firmwarehardwareconfiguration->info_length;
+	*size += R7KHDRSIZE_7kBackscatterImageData;
+	*size += 2 * backscatter->number_samples * backscatter->sample_size;
+	if (header->OffsetToOptionalData > 0) {
+		*size += 28;
+	}
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -14550,15 +16505,116 @@ int mbr_reson7kr_wr_v2firmwarehardwareconfiguration(int verbose, int *bufferallo
 
 		/* insert the data */
 		index = header->Offset + 4;
-		mb_put_binary_int(MB_YES, v2firmwarehardwareconfiguration->device_count, &buffer[index]);
+		mb_put_binary_long(MB_YES, backscatter->serial_number, &buffer[index]);
+		index += 8;
+		mb_put_binary_int(MB_YES, backscatter->ping_number, &buffer[index]);
 		index += 4;
-		mb_put_binary_int(MB_YES, v2firmwarehardwareconfiguration->info_length, &buffer[index]);
+		mb_put_binary_short(MB_YES, backscatter->multi_ping, &buffer[index]);
+		index += 2;
+		mb_put_binary_float(MB_YES, backscatter->beam_position, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, backscatter->control_flags, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, backscatter->number_samples, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, backscatter->port_beamwidth_x, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, backscatter->port_beamwidth_y, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, backscatter->stbd_beamwidth_x, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, backscatter->stbd_beamwidth_y, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, backscatter->port_steering_x, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, backscatter->port_steering_y, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, backscatter->stbd_steering_x, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, backscatter->stbd_steering_y, &buffer[index]);
 		index += 4;
+		mb_put_binary_short(MB_YES, backscatter->number_beams, &buffer[index]);
+		index += 2;
+		mb_put_binary_short(MB_YES, backscatter->current_beam, &buffer[index]);
+		index += 2;
+		buffer[index] = backscatter->sample_size;
+		index++;
+		buffer[index] = backscatter->data_type;
+		index++;
 
-		/* extract the info */
-		for (i = 0; i < v2firmwarehardwareconfiguration->info_length; i++) {
-			buffer[index] = v2firmwarehardwareconfiguration->info[i];
-			index++;
+		/* allocate memory if required */
+		data_size = backscatter->number_samples * backscatter->sample_size;
+		if (backscatter->nalloc < data_size) {
+			status = mb_reallocd(verbose, __FILE__, __LINE__, data_size, (void **)&(backscatter->port_data), error);
+			if (status == MB_SUCCESS)
+				status = mb_reallocd(verbose, __FILE__, __LINE__, data_size, (void **)&(backscatter->stbd_data), error);
+			if (status == MB_SUCCESS) {
+				backscatter->nalloc = data_size;
+			}
+			else {
+				backscatter->nalloc = 0;
+				backscatter->number_samples = 0;
+			}
+		}
+
+		/* extract backscatter data */
+		if (backscatter->sample_size == 1) {
+			for (i = 0; i < backscatter->number_samples; i++) {
+				buffer[index] = backscatter->port_data[i];
+				index++;
+			}
+			for (i = 0; i < backscatter->number_samples; i++) {
+				buffer[index] = backscatter->stbd_data[i];
+				index++;
+			}
+		}
+		else if (backscatter->sample_size == 2) {
+			short_ptr = (short *)backscatter->port_data;
+			for (i = 0; i < backscatter->number_samples; i++) {
+				mb_put_binary_short(MB_YES, short_ptr[i], &buffer[index]);
+				index += 2;
+			}
+			short_ptr = (short *)backscatter->stbd_data;
+			for (i = 0; i < backscatter->number_samples; i++) {
+				mb_put_binary_short(MB_YES, short_ptr[i], &buffer[index]);
+				index += 2;
+			}
+		}
+		else if (backscatter->sample_size == 4) {
+			int_ptr = (int *)backscatter->port_data;
+			for (i = 0; i < backscatter->number_samples; i++) {
+				mb_put_binary_int(MB_YES, int_ptr[i], &buffer[index]);
+				index += 4;
+			}
+			int_ptr = (int *)backscatter->stbd_data;
+			for (i = 0; i < backscatter->number_samples; i++) {
+				mb_put_binary_int(MB_YES, int_ptr[i], &buffer[index]);
+				index += 4;
+			}
+		}
+
+		/* extract the optional data */
+		if (header->OffsetToOptionalData > 0) {
+			index = header->OffsetToOptionalData;
+			backscatter->optionaldata = MB_YES;
+			mb_put_binary_float(MB_YES, backscatter->frequency, &buffer[index]);
+			index += 4;
+			mb_put_binary_double(MB_YES, backscatter->latitude, &buffer[index]);
+			index += 8;
+			mb_put_binary_double(MB_YES, backscatter->longitude, &buffer[index]);
+			index += 8;
+			mb_put_binary_float(MB_YES, backscatter->heading, &buffer[index]);
+			index += 4;
+			mb_put_binary_float(MB_YES, backscatter->altitude, &buffer[index]);
+			index += 4;
+		}
+		else {
+			backscatter->optionaldata = MB_NO;
+			backscatter->frequency = 0.0;
+			backscatter->latitude = 0.0;
+			backscatter->longitude = 0.0;
+			backscatter->heading = 0.0;
+			backscatter->altitude = 0.0;
 		}
 
 		/* reset the header size value */
@@ -14595,16 +16651,29 @@ int mbr_reson7kr_wr_v2firmwarehardwareconfiguration(int verbose, int *bufferallo
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_beamgeometry(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_beamgeometry";
+int mbr_reson7kr_wr_beam(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_beam";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_beamgeometry *beamgeometry;
+	s7kr_beam *beam;
+	s7kr_snippet *snippet;
 	unsigned int checksum;
 	int index;
 	char *buffer;
-	int i;
+	int nsamples;
+	int sample_type_amp;
+	int sample_type_phase;
+	int sample_type_iandq;
+	int sample_size;
+	char *charptr;
+	unsigned short *ushortptr;
+	unsigned int *uintptr;
+	short *shortptramp;
+	short *shortptrphase;
+	int *intptramp;
+	int *intptrphase;
+	int i, j;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -14619,8 +16688,8 @@ int mbr_reson7kr_wr_beamgeometry(int verbose, int *bufferalloc, char **bufferptr
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	beamgeometry = &(store->beamgeometry);
-	header = &(beamgeometry->header);
+	beam = &(store->beam);
+	header = &(beam->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -14628,12 +16697,38 @@ int mbr_reson7kr_wr_beamgeometry(int verbose, int *bufferalloc, char **bufferptr
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_beamgeometry(verbose, beamgeometry, error);
+		mbsys_reson7k_print_beam(verbose, beam, error);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_7kBeamGeometry;
-	*size += beamgeometry->number_beams * 16;
+	*size += R7KHDRSIZE_7kBeamData;
+	sample_type_amp = beam->sample_type & 15;
+	sample_type_phase = (beam->sample_type >> 4) & 15;
+	sample_type_iandq = (beam->sample_type >> 8) & 15;
+	sample_size = 0;
+	if (sample_type_amp == 1)
+		sample_size += 1;
+	else if (sample_type_amp == 2)
+		sample_size += 2;
+	else if (sample_type_amp == 3)
+		sample_size += 4;
+	if (sample_type_phase == 1)
+		sample_size += 1;
+	else if (sample_type_phase == 2)
+		sample_size += 2;
+	else if (sample_type_phase == 3)
+		sample_size += 4;
+	if (sample_type_iandq == 1)
+		sample_size += 4;
+	else if (sample_type_iandq == 2)
+		sample_size += 8;
+	for (i = 0; i < beam->number_beams; i++) {
+		snippet = &beam->snippets[i];
+		*size += 10 + sample_size * (snippet->end_sample - snippet->begin_sample + 1);
+	}
+	if (header->OffsetToOptionalData > 0) {
+		*size += 24 + beam->number_beams * 12;
+	}
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -14657,27 +16752,89 @@ int mbr_reson7kr_wr_beamgeometry(int verbose, int *bufferalloc, char **bufferptr
 
 		/* insert the data */
 		index = header->Offset + 4;
-		mb_put_binary_long(MB_YES, beamgeometry->serial_number, &buffer[index]);
+		mb_put_binary_long(MB_YES, beam->serial_number, &buffer[index]);
 		index += 8;
-		mb_put_binary_int(MB_YES, beamgeometry->number_beams, &buffer[index]);
+		mb_put_binary_int(MB_YES, beam->ping_number, &buffer[index]);
 		index += 4;
-
-		/* insert the data */
-		for (i = 0; i < beamgeometry->number_beams; i++) {
-			mb_put_binary_float(MB_YES, beamgeometry->angle_alongtrack[i], &buffer[index]);
-			index += 4;
-		}
-		for (i = 0; i < beamgeometry->number_beams; i++) {
-			mb_put_binary_float(MB_YES, beamgeometry->angle_acrosstrack[i], &buffer[index]);
+		mb_put_binary_short(MB_YES, beam->multi_ping, &buffer[index]);
+		index += 2;
+		mb_put_binary_short(MB_YES, beam->number_beams, &buffer[index]);
+		index += 2;
+		mb_put_binary_short(MB_YES, beam->reserved, &buffer[index]);
+		index += 2;
+		mb_put_binary_int(MB_YES, beam->number_samples, &buffer[index]);
+		index += 4;
+		buffer[index] = beam->record_subset_flag;
+		index++;
+		buffer[index] = beam->row_column_flag;
+		index++;
+		mb_put_binary_short(MB_YES, beam->sample_header_id, &buffer[index]);
+		index += 2;
+		mb_put_binary_int(MB_YES, beam->sample_type, &buffer[index]);
+		index += 4;
+		for (i = 0; i < beam->number_beams; i++) {
+			snippet = &beam->snippets[i];
+			mb_put_binary_short(MB_YES, snippet->beam_number, &buffer[index]);
+			index += 2;
+			mb_put_binary_int(MB_YES, snippet->begin_sample, &buffer[index]);
 			index += 4;
-		}
-		for (i = 0; i < beamgeometry->number_beams; i++) {
-			mb_put_binary_float(MB_YES, beamgeometry->beamwidth_alongtrack[i], &buffer[index]);
+			mb_put_binary_int(MB_YES, snippet->end_sample, &buffer[index]);
 			index += 4;
 		}
-		for (i = 0; i < beamgeometry->number_beams; i++) {
-			mb_put_binary_float(MB_YES, beamgeometry->beamwidth_acrosstrack[i], &buffer[index]);
-			index += 4;
+
+		for (i = 0; i < beam->number_beams; i++) {
+			/* extract snippet or beam data data */
+			if (status == MB_SUCCESS) {
+				nsamples = snippet->end_sample - snippet->begin_sample + 1;
+				for (j = 0; j < nsamples; j++) {
+					if (sample_type_amp == 1) {
+						charptr = (char *)snippet->amplitude;
+						buffer[index] = charptr[j];
+						index++;
+					}
+					else if (sample_type_amp == 2) {
+						ushortptr = (unsigned short *)snippet->amplitude;
+						mb_put_binary_short(MB_YES, ushortptr[j], &buffer[index]);
+						index += 2;
+					}
+					else if (sample_type_amp == 3) {
+						uintptr = (unsigned int *)snippet->amplitude;
+						mb_put_binary_int(MB_YES, uintptr[j], &buffer[index]);
+						index += 4;
+					}
+					if (sample_type_phase == 1) {
+						charptr = (char *)snippet->phase;
+						buffer[index] = charptr[j];
+						index++;
+					}
+					else if (sample_type_phase == 2) {
+						ushortptr = (unsigned short *)snippet->phase;
+						mb_put_binary_short(MB_YES, ushortptr[j], &buffer[index]);
+						index += 2;
+					}
+					else if (sample_type_phase == 3) {
+						uintptr = (unsigned int *)snippet->phase;
+						mb_put_binary_int(MB_YES, uintptr[j], &buffer[index]);
+						index += 4;
+					}
+					if (sample_type_iandq == 1) {
+						shortptramp = (short *)snippet->amplitude;
+						shortptrphase = (short *)snippet->phase;
+						mb_put_binary_short(MB_YES, shortptramp[j], &buffer[index]);
+						index += 2;
+						mb_put_binary_short(MB_YES, shortptrphase[j], &buffer[index]);
+						index += 2;
+					}
+					else if (sample_type_iandq == 2) {
+						intptramp = (int *)snippet->amplitude;
+						intptrphase = (int *)snippet->phase;
+						mb_put_binary_int(MB_YES, intptramp[j], &buffer[index]);
+						index += 4;
+						mb_put_binary_int(MB_YES, intptrphase[j], &buffer[index]);
+						index += 4;
+					}
+				}
+			}
 		}
 
 		/* reset the header size value */
@@ -14714,12 +16871,12 @@ int mbr_reson7kr_wr_beamgeometry(int verbose, int *bufferalloc, char **bufferptr
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_calibration(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_calibration";
+int mbr_reson7kr_wr_verticaldepth(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_verticaldepth";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_calibration *calibration;
+	s7kr_verticaldepth *verticaldepth;
 	unsigned int checksum;
 	int index;
 	char *buffer;
@@ -14738,8 +16895,8 @@ int mbr_reson7kr_wr_calibration(int verbose, int *bufferalloc, char **bufferptr,
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	calibration = &(store->calibration);
-	header = &(calibration->header);
+	verticaldepth = &(store->verticaldepth);
+	header = &(verticaldepth->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -14747,12 +16904,11 @@ int mbr_reson7kr_wr_calibration(int verbose, int *bufferalloc, char **bufferptr,
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_calibration(verbose, calibration, error);
+		mbsys_reson7k_print_verticaldepth(verbose, verticaldepth, error);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_7kCalibrationData;
-	*size += calibration->number_channels * 8;
+	*size += R7KHDRSIZE_7kVerticalDepth;
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -14776,20 +16932,24 @@ int mbr_reson7kr_wr_calibration(int verbose, int *bufferalloc, char **bufferptr,
 
 		/* insert the data */
 		index = header->Offset + 4;
-		mb_put_binary_long(MB_YES, calibration->serial_number, &buffer[index]);
-		index += 8;
-		mb_put_binary_short(MB_YES, calibration->number_channels, &buffer[index]);
+		mb_put_binary_float(MB_YES, verticaldepth->frequency, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, verticaldepth->ping_number, &buffer[index]);
+		index += 4;
+		mb_put_binary_short(MB_YES, verticaldepth->multi_ping, &buffer[index]);
 		index += 2;
-
-		/* insert the data */
-		for (i = 0; i < calibration->number_channels; i++) {
-			mb_put_binary_float(MB_YES, calibration->gain[i], &buffer[index]);
-			index += 4;
-		}
-		for (i = 0; i < calibration->number_channels; i++) {
-			mb_put_binary_float(MB_YES, calibration->phase[i], &buffer[index]);
-			index += 4;
-		}
+		mb_put_binary_double(MB_YES, verticaldepth->latitude, &buffer[index]);
+		index += 8;
+		mb_put_binary_double(MB_YES, verticaldepth->longitude, &buffer[index]);
+		index += 8;
+		mb_put_binary_float(MB_YES, verticaldepth->heading, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, verticaldepth->alongtrack, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, verticaldepth->acrosstrack, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, verticaldepth->vertical_depth, &buffer[index]);
+		index += 4;
 
 		/* reset the header size value */
 		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
@@ -14825,12 +16985,12 @@ int mbr_reson7kr_wr_calibration(int verbose, int *bufferalloc, char **bufferptr,
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_bathymetry(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_bathymetry";
+int mbr_reson7kr_wr_tvg(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_tvg";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_bathymetry *bathymetry;
+	s7kr_tvg *tvg;
 	unsigned int checksum;
 	int index;
 	char *buffer;
@@ -14849,21 +17009,8 @@ int mbr_reson7kr_wr_bathymetry(int verbose, int *bufferalloc, char **bufferptr,
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	bathymetry = &(store->bathymetry);
-	header = &(bathymetry->header);
-
-	/* figure out size of output record */
-	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_7kBathymetricData;
-	*size += bathymetry->number_beams * 17;
-	if (bathymetry->optionaldata == MB_YES) {
-		*size += 45 + bathymetry->number_beams * 20;
-		header->OffsetToOptionalData =
-		    MBSYS_RESON7K_RECORDHEADER_SIZE + R7KHDRSIZE_7kBathymetricData + bathymetry->number_beams * 17;
-	}
-	else
-		header->OffsetToOptionalData = 0;
-	header->Size = *size;
+	tvg = &(store->tvg);
+	header = &(tvg->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -14871,7 +17018,12 @@ int mbr_reson7kr_wr_bathymetry(int verbose, int *bufferalloc, char **bufferptr,
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_bathymetry(verbose, bathymetry, error);
+		mbsys_reson7k_print_tvg(verbose, tvg, error);
+
+	/* figure out size of output record */
+	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
+	*size += R7KHDRSIZE_7kTVGData;
+	*size += tvg->n * sizeof(float);
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -14889,90 +17041,28 @@ int mbr_reson7kr_wr_bathymetry(int verbose, int *bufferalloc, char **bufferptr,
 		/* get buffer for writing */
 		buffer = (char *)*bufferptr;
 
-		/* make sure the version number is right */
-		if (header->Version < 5)
-			header->Version = 5;
-
 		/* insert the header */
 		index = 0;
 		status = mbr_reson7kr_wr_header(verbose, buffer, &index, header, error);
 
 		/* insert the data */
 		index = header->Offset + 4;
-		mb_put_binary_long(MB_YES, bathymetry->serial_number, &buffer[index]);
+		mb_put_binary_long(MB_YES, tvg->serial_number, &buffer[index]);
 		index += 8;
-		mb_put_binary_int(MB_YES, bathymetry->ping_number, &buffer[index]);
+		mb_put_binary_int(MB_YES, tvg->ping_number, &buffer[index]);
 		index += 4;
-		mb_put_binary_short(MB_YES, bathymetry->multi_ping, &buffer[index]);
+		mb_put_binary_short(MB_YES, tvg->multi_ping, &buffer[index]);
 		index += 2;
-		mb_put_binary_int(MB_YES, bathymetry->number_beams, &buffer[index]);
-		index += 4;
-		buffer[index] = bathymetry->layer_comp_flag;
-		index++;
-		buffer[index] = bathymetry->sound_vel_flag;
-		index++;
-		mb_put_binary_float(MB_YES, bathymetry->sound_velocity, &buffer[index]);
+		mb_put_binary_int(MB_YES, tvg->n, &buffer[index]);
 		index += 4;
-
-		/* insert the data */
-		for (i = 0; i < bathymetry->number_beams; i++) {
-			mb_put_binary_float(MB_YES, bathymetry->range[i], &buffer[index]);
-			index += 4;
-		}
-		for (i = 0; i < bathymetry->number_beams; i++) {
-			buffer[index] = bathymetry->quality[i];
-			index++;
-		}
-		for (i = 0; i < bathymetry->number_beams; i++) {
-			mb_put_binary_float(MB_YES, bathymetry->intensity[i], &buffer[index]);
-			index += 4;
-		}
-		for (i = 0; i < bathymetry->number_beams; i++) {
-			mb_put_binary_float(MB_YES, bathymetry->min_depth_gate[i], &buffer[index]);
-			index += 4;
-		}
-		for (i = 0; i < bathymetry->number_beams; i++) {
-			mb_put_binary_float(MB_YES, bathymetry->max_depth_gate[i], &buffer[index]);
+		for (i = 0; i < 8; i++) {
+			mb_put_binary_int(MB_YES, tvg->reserved[i], &buffer[index]);
 			index += 4;
 		}
 
-		/* insert the optional data */
-		if (bathymetry->optionaldata == MB_YES) {
-			mb_put_binary_float(MB_YES, bathymetry->frequency, &buffer[index]);
-			index += 4;
-			mb_put_binary_double(MB_YES, bathymetry->latitude, &buffer[index]);
-			index += 8;
-			mb_put_binary_double(MB_YES, bathymetry->longitude, &buffer[index]);
-			index += 8;
-			mb_put_binary_float(MB_YES, bathymetry->heading, &buffer[index]);
-			index += 4;
-			buffer[index] = bathymetry->height_source;
-			index++;
-			mb_put_binary_float(MB_YES, bathymetry->tide, &buffer[index]);
-			index += 4;
-			mb_put_binary_float(MB_YES, bathymetry->roll, &buffer[index]);
-			index += 4;
-			mb_put_binary_float(MB_YES, bathymetry->pitch, &buffer[index]);
-			index += 4;
-			mb_put_binary_float(MB_YES, bathymetry->heave, &buffer[index]);
-			index += 4;
-			mb_put_binary_float(MB_YES, bathymetry->vehicle_height, &buffer[index]);
-			index += 4;
-			for (i = 0; i < bathymetry->number_beams; i++) {
-				mb_put_binary_float(MB_YES, bathymetry->depth[i], &buffer[index]);
-				index += 4;
-				mb_put_binary_float(MB_YES, bathymetry->alongtrack[i], &buffer[index]);
-				index += 4;
-				mb_put_binary_float(MB_YES, bathymetry->acrosstrack[i], &buffer[index]);
-				index += 4;
-				mb_put_binary_float(MB_YES, bathymetry->pointing_angle[i], &buffer[index]);
-				index += 4;
-				mb_put_binary_float(MB_YES, bathymetry->azimuth_angle[i], &buffer[index]);
-				index += 4;
-//fprintf(stderr,"WRITE BEAM:%d d:%f l:%f x:%f ax:%f az:%f\n",
-//i,bathymetry->depth[i],bathymetry->alongtrack[i],bathymetry->acrosstrack[i],bathymetry->pointing_angle[i],bathymetry->azimuth_angle[i]);
-			}
-		}
+		/* insert tvg data */
+		memcpy((void *)&buffer[index], (const void *)tvg->tvg, (size_t)(tvg->n * sizeof(float)));
+		index += tvg->n * sizeof(float);
 
 		/* reset the header size value */
 		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
@@ -15008,18 +17098,19 @@ int mbr_reson7kr_wr_bathymetry(int verbose, int *bufferalloc, char **bufferptr,
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_backscatter(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_backscatter";
+int mbr_reson7kr_wr_image(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_image";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_backscatter *backscatter;
-	int data_size;
+	s7kr_image *image;
 	unsigned int checksum;
 	int index;
 	char *buffer;
-	short *short_ptr;
-	int *int_ptr;
+	int nalloc;
+	char *charptr;
+	unsigned short *ushortptr;
+	unsigned int *uintptr;
 	int i;
 
 	/* print input debug statements */
@@ -15035,8 +17126,8 @@ int mbr_reson7kr_wr_backscatter(int verbose, int *bufferalloc, char **bufferptr,
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	backscatter = &(store->backscatter);
-	header = &(backscatter->header);
+	image = &(store->image);
+	header = &(image->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -15044,15 +17135,12 @@ int mbr_reson7kr_wr_backscatter(int verbose, int *bufferalloc, char **bufferptr,
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_backscatter(verbose, backscatter, error);
+		mbsys_reson7k_print_image(verbose, image, error);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_7kBackscatterImageData;
-	*size += 2 * backscatter->number_samples * backscatter->sample_size;
-	if (header->OffsetToOptionalData > 0) {
-		*size += 28;
-	}
+	*size += R7KHDRSIZE_7kImageData;
+	*size += image->width * image->height * image->color_depth;
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -15076,118 +17164,57 @@ int mbr_reson7kr_wr_backscatter(int verbose, int *bufferalloc, char **bufferptr,
 
 		/* insert the data */
 		index = header->Offset + 4;
-		mb_put_binary_long(MB_YES, backscatter->serial_number, &buffer[index]);
-		index += 8;
-		mb_put_binary_int(MB_YES, backscatter->ping_number, &buffer[index]);
+		mb_put_binary_int(MB_YES, image->ping_number, &buffer[index]);
 		index += 4;
-		mb_put_binary_short(MB_YES, backscatter->multi_ping, &buffer[index]);
+		mb_put_binary_short(MB_YES, image->multi_ping, &buffer[index]);
 		index += 2;
-		mb_put_binary_float(MB_YES, backscatter->beam_position, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, backscatter->control_flags, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, backscatter->number_samples, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, backscatter->port_beamwidth_x, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, backscatter->port_beamwidth_y, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, backscatter->stbd_beamwidth_x, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, backscatter->stbd_beamwidth_y, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, backscatter->port_steering_x, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, backscatter->port_steering_y, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, backscatter->stbd_steering_x, &buffer[index]);
+		mb_put_binary_int(MB_YES, image->width, &buffer[index]);
 		index += 4;
-		mb_put_binary_float(MB_YES, backscatter->stbd_steering_y, &buffer[index]);
+		mb_put_binary_int(MB_YES, image->height, &buffer[index]);
 		index += 4;
-		mb_put_binary_short(MB_YES, backscatter->number_beams, &buffer[index]);
+		mb_put_binary_short(MB_YES, image->color_depth, &buffer[index]);
+		index += 2;
+		mb_put_binary_short(MB_YES, image->width_height_flag, &buffer[index]);
 		index += 2;
-		mb_put_binary_short(MB_YES, backscatter->current_beam, &buffer[index]);
+		mb_put_binary_short(MB_YES, image->compression, &buffer[index]);
 		index += 2;
-		buffer[index] = backscatter->sample_size;
-		index++;
-		buffer[index] = backscatter->data_type;
-		index++;
 
-		/* allocate memory if required */
-		data_size = backscatter->number_samples * backscatter->sample_size;
-		if (backscatter->nalloc < data_size) {
-			status = mb_reallocd(verbose, __FILE__, __LINE__, data_size, (void **)&(backscatter->port_data), error);
+		/* allocate memory for image if needed */
+		nalloc = image->width * image->height * image->color_depth;
+		if (status == MB_SUCCESS && image->nalloc < nalloc) {
+			image->nalloc = nalloc;
 			if (status == MB_SUCCESS)
-				status = mb_reallocd(verbose, __FILE__, __LINE__, data_size, (void **)&(backscatter->stbd_data), error);
-			if (status == MB_SUCCESS) {
-				backscatter->nalloc = data_size;
-			}
-			else {
-				backscatter->nalloc = 0;
-				backscatter->number_samples = 0;
+				status = mb_reallocd(verbose, __FILE__, __LINE__, image->nalloc, (void **)&(image->image), error);
+			if (status != MB_SUCCESS) {
+				image->nalloc = 0;
+				image->width = 0;
+				image->height = 0;
 			}
 		}
 
-		/* extract backscatter data */
-		if (backscatter->sample_size == 1) {
-			for (i = 0; i < backscatter->number_samples; i++) {
-				buffer[index] = backscatter->port_data[i];
-				index++;
-			}
-			for (i = 0; i < backscatter->number_samples; i++) {
-				buffer[index] = backscatter->stbd_data[i];
+		/* extract image data */
+		if (image->color_depth == 1) {
+			charptr = (char *)image->image;
+			for (i = 0; i < image->width * image->height; i++) {
+				buffer[index] = charptr[i];
 				index++;
 			}
 		}
-		else if (backscatter->sample_size == 2) {
-			short_ptr = (short *)backscatter->port_data;
-			for (i = 0; i < backscatter->number_samples; i++) {
-				mb_put_binary_short(MB_YES, short_ptr[i], &buffer[index]);
-				index += 2;
-			}
-			short_ptr = (short *)backscatter->stbd_data;
-			for (i = 0; i < backscatter->number_samples; i++) {
-				mb_put_binary_short(MB_YES, short_ptr[i], &buffer[index]);
+		else if (image->color_depth == 2) {
+			ushortptr = (unsigned short *)image->image;
+			for (i = 0; i < image->width * image->height; i++) {
+				mb_put_binary_short(MB_YES, ushortptr[i], &buffer[index]);
 				index += 2;
 			}
 		}
-		else if (backscatter->sample_size == 4) {
-			int_ptr = (int *)backscatter->port_data;
-			for (i = 0; i < backscatter->number_samples; i++) {
-				mb_put_binary_int(MB_YES, int_ptr[i], &buffer[index]);
-				index += 4;
-			}
-			int_ptr = (int *)backscatter->stbd_data;
-			for (i = 0; i < backscatter->number_samples; i++) {
-				mb_put_binary_int(MB_YES, int_ptr[i], &buffer[index]);
+		else if (image->color_depth == 4) {
+			uintptr = (unsigned int *)image->image;
+			for (i = 0; i < image->width * image->height; i++) {
+				mb_put_binary_int(MB_YES, uintptr[i], &buffer[index]);
 				index += 4;
 			}
 		}
 
-		/* extract the optional data */
-		if (header->OffsetToOptionalData > 0) {
-			index = header->OffsetToOptionalData;
-			backscatter->optionaldata = MB_YES;
-			mb_put_binary_float(MB_YES, backscatter->frequency, &buffer[index]);
-			index += 4;
-			mb_put_binary_double(MB_YES, backscatter->latitude, &buffer[index]);
-			index += 8;
-			mb_put_binary_double(MB_YES, backscatter->longitude, &buffer[index]);
-			index += 8;
-			mb_put_binary_float(MB_YES, backscatter->heading, &buffer[index]);
-			index += 4;
-			mb_put_binary_float(MB_YES, backscatter->altitude, &buffer[index]);
-			index += 4;
-		}
-		else {
-			backscatter->optionaldata = MB_NO;
-			backscatter->frequency = 0.0;
-			backscatter->latitude = 0.0;
-			backscatter->longitude = 0.0;
-			backscatter->heading = 0.0;
-			backscatter->altitude = 0.0;
-		}
-
 		/* reset the header size value */
 		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
 
@@ -15222,29 +17249,16 @@ int mbr_reson7kr_wr_backscatter(int verbose, int *bufferalloc, char **bufferptr,
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_beam(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_beam";
+int mbr_reson7kr_wr_v2pingmotion(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_v2pingmotion";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_beam *beam;
-	s7kr_snippet *snippet;
+	s7kr_v2pingmotion *v2pingmotion;
 	unsigned int checksum;
 	int index;
 	char *buffer;
-	int nsamples;
-	int sample_type_amp;
-	int sample_type_phase;
-	int sample_type_iandq;
-	int sample_size;
-	char *charptr;
-	unsigned short *ushortptr;
-	unsigned int *uintptr;
-	short *shortptramp;
-	short *shortptrphase;
-	int *intptramp;
-	int *intptrphase;
-	int i, j;
+	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -15259,8 +17273,8 @@ int mbr_reson7kr_wr_beam(int verbose, int *bufferalloc, char **bufferptr, void *
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	beam = &(store->beam);
-	header = &(beam->header);
+	v2pingmotion = &(store->v2pingmotion);
+	header = &(v2pingmotion->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -15268,38 +17282,19 @@ int mbr_reson7kr_wr_beam(int verbose, int *bufferalloc, char **bufferptr, void *
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_beam(verbose, beam, error);
+		mbsys_reson7k_print_v2pingmotion(verbose, v2pingmotion, error);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_7kBeamData;
-	sample_type_amp = beam->sample_type & 15;
-	sample_type_phase = (beam->sample_type >> 4) & 15;
-	sample_type_iandq = (beam->sample_type >> 8) & 15;
-	sample_size = 0;
-	if (sample_type_amp == 1)
-		sample_size += 1;
-	else if (sample_type_amp == 2)
-		sample_size += 2;
-	else if (sample_type_amp == 3)
-		sample_size += 4;
-	if (sample_type_phase == 1)
-		sample_size += 1;
-	else if (sample_type_phase == 2)
-		sample_size += 2;
-	else if (sample_type_phase == 3)
-		sample_size += 4;
-	if (sample_type_iandq == 1)
-		sample_size += 4;
-	else if (sample_type_iandq == 2)
-		sample_size += 8;
-	for (i = 0; i < beam->number_beams; i++) {
-		snippet = &beam->snippets[i];
-		*size += 10 + sample_size * (snippet->end_sample - snippet->begin_sample + 1);
-	}
-	if (header->OffsetToOptionalData > 0) {
-		*size += 24 + beam->number_beams * 12;
-	}
+	*size += R7KHDRSIZE_7kV2PingMotion;
+	if (v2pingmotion->flags & 1)
+		*size += sizeof(float);
+	if (v2pingmotion->flags & 2)
+		*size += sizeof(float) * v2pingmotion->n;
+	if (v2pingmotion->flags & 4)
+		*size += sizeof(float) * v2pingmotion->n;
+	if (v2pingmotion->flags & 8)
+		*size += sizeof(float) * v2pingmotion->n;
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -15323,88 +17318,40 @@ int mbr_reson7kr_wr_beam(int verbose, int *bufferalloc, char **bufferptr, void *
 
 		/* insert the data */
 		index = header->Offset + 4;
-		mb_put_binary_long(MB_YES, beam->serial_number, &buffer[index]);
+		mb_put_binary_long(MB_YES, v2pingmotion->serial_number, &buffer[index]);
 		index += 8;
-		mb_put_binary_int(MB_YES, beam->ping_number, &buffer[index]);
+		mb_put_binary_int(MB_YES, v2pingmotion->ping_number, &buffer[index]);
 		index += 4;
-		mb_put_binary_short(MB_YES, beam->multi_ping, &buffer[index]);
-		index += 2;
-		mb_put_binary_short(MB_YES, beam->number_beams, &buffer[index]);
-		index += 2;
-		mb_put_binary_short(MB_YES, beam->reserved, &buffer[index]);
+		mb_put_binary_short(MB_YES, v2pingmotion->multi_ping, &buffer[index]);
 		index += 2;
-		mb_put_binary_int(MB_YES, beam->number_samples, &buffer[index]);
+		mb_put_binary_int(MB_YES, v2pingmotion->n, &buffer[index]);
 		index += 4;
-		buffer[index] = beam->record_subset_flag;
-		index++;
-		buffer[index] = beam->row_column_flag;
-		index++;
-		mb_put_binary_short(MB_YES, beam->sample_header_id, &buffer[index]);
+		mb_put_binary_short(MB_YES, v2pingmotion->flags, &buffer[index]);
 		index += 2;
-		mb_put_binary_int(MB_YES, beam->sample_type, &buffer[index]);
+		mb_put_binary_int(MB_YES, v2pingmotion->error_flags, &buffer[index]);
 		index += 4;
-		for (i = 0; i < beam->number_beams; i++) {
-			snippet = &beam->snippets[i];
-			mb_put_binary_short(MB_YES, snippet->beam_number, &buffer[index]);
-			index += 2;
-			mb_put_binary_int(MB_YES, snippet->begin_sample, &buffer[index]);
-			index += 4;
-			mb_put_binary_int(MB_YES, snippet->end_sample, &buffer[index]);
+		mb_put_binary_float(MB_YES, v2pingmotion->frequency, &buffer[index]);
+		index += 4;
+		if (v2pingmotion->flags & 1) {
+			mb_put_binary_float(MB_YES, v2pingmotion->pitch, &buffer[index]);
 			index += 4;
 		}
-
-		for (i = 0; i < beam->number_beams; i++) {
-			/* extract snippet or beam data data */
-			if (status == MB_SUCCESS) {
-				nsamples = snippet->end_sample - snippet->begin_sample + 1;
-				for (j = 0; j < nsamples; j++) {
-					if (sample_type_amp == 1) {
-						charptr = (char *)snippet->amplitude;
-						buffer[index] = charptr[j];
-						index++;
-					}
-					else if (sample_type_amp == 2) {
-						ushortptr = (unsigned short *)snippet->amplitude;
-						mb_put_binary_short(MB_YES, ushortptr[j], &buffer[index]);
-						index += 2;
-					}
-					else if (sample_type_amp == 3) {
-						uintptr = (unsigned int *)snippet->amplitude;
-						mb_put_binary_int(MB_YES, uintptr[j], &buffer[index]);
-						index += 4;
-					}
-					if (sample_type_phase == 1) {
-						charptr = (char *)snippet->phase;
-						buffer[index] = charptr[j];
-						index++;
-					}
-					else if (sample_type_phase == 2) {
-						ushortptr = (unsigned short *)snippet->phase;
-						mb_put_binary_short(MB_YES, ushortptr[j], &buffer[index]);
-						index += 2;
-					}
-					else if (sample_type_phase == 3) {
-						uintptr = (unsigned int *)snippet->phase;
-						mb_put_binary_int(MB_YES, uintptr[j], &buffer[index]);
-						index += 4;
-					}
-					if (sample_type_iandq == 1) {
-						shortptramp = (short *)snippet->amplitude;
-						shortptrphase = (short *)snippet->phase;
-						mb_put_binary_short(MB_YES, shortptramp[j], &buffer[index]);
-						index += 2;
-						mb_put_binary_short(MB_YES, shortptrphase[j], &buffer[index]);
-						index += 2;
-					}
-					else if (sample_type_iandq == 2) {
-						intptramp = (int *)snippet->amplitude;
-						intptrphase = (int *)snippet->phase;
-						mb_put_binary_int(MB_YES, intptramp[j], &buffer[index]);
-						index += 4;
-						mb_put_binary_int(MB_YES, intptrphase[j], &buffer[index]);
-						index += 4;
-					}
-				}
+		if (v2pingmotion->flags & 2) {
+			for (i = 0; i < v2pingmotion->n; i++) {
+				mb_put_binary_float(MB_YES, v2pingmotion->roll[i], &buffer[index]);
+				index += 4;
+			}
+		}
+		if (v2pingmotion->flags & 4) {
+			for (i = 0; i < v2pingmotion->n; i++) {
+				mb_put_binary_float(MB_YES, v2pingmotion->heading[i], &buffer[index]);
+				index += 4;
+			}
+		}
+		if (v2pingmotion->flags & 8) {
+			for (i = 0; i < v2pingmotion->n; i++) {
+				mb_put_binary_float(MB_YES, v2pingmotion->heave[i], &buffer[index]);
+				index += 4;
 			}
 		}
 
@@ -15431,8 +17378,6 @@ int mbr_reson7kr_wr_beam(int verbose, int *bufferalloc, char **bufferptr, void *
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
-		fprintf(stderr, "dbg2       size:       %d\n", *size);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:  %d\n", status);
@@ -15442,12 +17387,12 @@ int mbr_reson7kr_wr_beam(int verbose, int *bufferalloc, char **bufferptr, void *
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_verticaldepth(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_verticaldepth";
+int mbr_reson7kr_wr_v2detectionsetup(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_v2detectionsetup";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_verticaldepth *verticaldepth;
+	s7kr_v2detectionsetup *v2detectionsetup;
 	unsigned int checksum;
 	int index;
 	char *buffer;
@@ -15466,8 +17411,8 @@ int mbr_reson7kr_wr_verticaldepth(int verbose, int *bufferalloc, char **bufferpt
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	verticaldepth = &(store->verticaldepth);
-	header = &(verticaldepth->header);
+	v2detectionsetup = &(store->v2detectionsetup);
+	header = &(v2detectionsetup->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -15475,11 +17420,12 @@ int mbr_reson7kr_wr_verticaldepth(int verbose, int *bufferalloc, char **bufferpt
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_verticaldepth(verbose, verticaldepth, error);
+		mbsys_reson7k_print_v2detectionsetup(verbose, v2detectionsetup, error);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_7kVerticalDepth;
+	*size += R7KHDRSIZE_7kV2DetectionSetup;
+	*size += v2detectionsetup->number_beams * v2detectionsetup->data_field_size;
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -15503,24 +17449,64 @@ int mbr_reson7kr_wr_verticaldepth(int verbose, int *bufferalloc, char **bufferpt
 
 		/* insert the data */
 		index = header->Offset + 4;
-		mb_put_binary_float(MB_YES, verticaldepth->frequency, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, verticaldepth->ping_number, &buffer[index]);
+		mb_put_binary_long(MB_YES, v2detectionsetup->serial_number, &buffer[index]);
+		index += 8;
+		mb_put_binary_int(MB_YES, v2detectionsetup->ping_number, &buffer[index]);
 		index += 4;
-		mb_put_binary_short(MB_YES, verticaldepth->multi_ping, &buffer[index]);
+		mb_put_binary_short(MB_YES, v2detectionsetup->multi_ping, &buffer[index]);
 		index += 2;
-		mb_put_binary_double(MB_YES, verticaldepth->latitude, &buffer[index]);
-		index += 8;
-		mb_put_binary_double(MB_YES, verticaldepth->longitude, &buffer[index]);
-		index += 8;
-		mb_put_binary_float(MB_YES, verticaldepth->heading, &buffer[index]);
+		mb_put_binary_int(MB_YES, v2detectionsetup->number_beams, &buffer[index]);
 		index += 4;
-		mb_put_binary_float(MB_YES, verticaldepth->alongtrack, &buffer[index]);
+		mb_put_binary_int(MB_YES, v2detectionsetup->data_field_size, &buffer[index]);
 		index += 4;
-		mb_put_binary_float(MB_YES, verticaldepth->acrosstrack, &buffer[index]);
+		buffer[index] = v2detectionsetup->detection_algorithm;
+		index++;
+		mb_put_binary_int(MB_YES, v2detectionsetup->detection_flags, &buffer[index]);
 		index += 4;
-		mb_put_binary_float(MB_YES, verticaldepth->vertical_depth, &buffer[index]);
+		mb_put_binary_float(MB_YES, v2detectionsetup->minimum_depth, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, v2detectionsetup->maximum_depth, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, v2detectionsetup->minimum_range, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, v2detectionsetup->maximum_range, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, v2detectionsetup->minimum_nadir_search, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, v2detectionsetup->maximum_nadir_search, &buffer[index]);
+		index += 4;
+		buffer[index] = v2detectionsetup->automatic_filter_window;
+		index++;
+		mb_put_binary_float(MB_YES, v2detectionsetup->applied_roll, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, v2detectionsetup->depth_gate_tilt, &buffer[index]);
 		index += 4;
+		for (i = 0; i < 14; i++) {
+			mb_put_binary_float(MB_YES, v2detectionsetup->reserved[i], &buffer[index]);
+			index += 4;
+		}
+		for (i = 0; i < v2detectionsetup->number_beams; i++) {
+			mb_put_binary_short(MB_YES, v2detectionsetup->beam_descriptor[i], &buffer[index]);
+			index += 2;
+			mb_put_binary_float(MB_YES, v2detectionsetup->detection_point[i], &buffer[index]);
+			index += 4;
+			mb_put_binary_int(MB_YES, v2detectionsetup->flags[i], &buffer[index]);
+			index += 4;
+			mb_put_binary_int(MB_YES, v2detectionsetup->auto_limits_min_sample[i], &buffer[index]);
+			index += 4;
+			mb_put_binary_int(MB_YES, v2detectionsetup->auto_limits_max_sample[i], &buffer[index]);
+			index += 4;
+			mb_put_binary_int(MB_YES, v2detectionsetup->user_limits_min_sample[i], &buffer[index]);
+			index += 4;
+			mb_put_binary_int(MB_YES, v2detectionsetup->user_limits_max_sample[i], &buffer[index]);
+			index += 4;
+			mb_put_binary_int(MB_YES, v2detectionsetup->quality[i], &buffer[index]);
+			index += 4;
+			if (v2detectionsetup->data_field_size >= R7KRDTSIZE_7kV2DetectionSetup + 4) {
+				mb_put_binary_int(MB_YES, v2detectionsetup->uncertainty[i], &buffer[index]);
+				index += 4;
+			}
+		}
 
 		/* reset the header size value */
 		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
@@ -15545,8 +17531,6 @@ int mbr_reson7kr_wr_verticaldepth(int verbose, int *bufferalloc, char **bufferpt
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
-		fprintf(stderr, "dbg2       size:       %d\n", *size);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:  %d\n", status);
@@ -15556,16 +17540,17 @@ int mbr_reson7kr_wr_verticaldepth(int verbose, int *bufferalloc, char **bufferpt
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_tvg(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_tvg";
+int mbr_reson7kr_wr_v2beamformed(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_v2beamformed";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_tvg *tvg;
+	s7kr_v2beamformed *v2beamformed;
+	s7kr_v2amplitudephase *v2amplitudephase;
 	unsigned int checksum;
 	int index;
 	char *buffer;
-	int i;
+	int i, j;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -15580,8 +17565,8 @@ int mbr_reson7kr_wr_tvg(int verbose, int *bufferalloc, char **bufferptr, void *s
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	tvg = &(store->tvg);
-	header = &(tvg->header);
+	v2beamformed = &(store->v2beamformed);
+	header = &(v2beamformed->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -15589,12 +17574,12 @@ int mbr_reson7kr_wr_tvg(int verbose, int *bufferalloc, char **bufferptr, void *s
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_tvg(verbose, tvg, error);
+		mbsys_reson7k_print_v2beamformed(verbose, v2beamformed, error);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_7kTVGData;
-	*size += tvg->n * sizeof(float);
+	*size += R7KHDRSIZE_7kV2BeamformedData;
+	*size += 2 * sizeof(short) * v2beamformed->number_beams * v2beamformed->number_samples;
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -15618,22 +17603,31 @@ int mbr_reson7kr_wr_tvg(int verbose, int *bufferalloc, char **bufferptr, void *s
 
 		/* insert the data */
 		index = header->Offset + 4;
-		mb_put_binary_long(MB_YES, tvg->serial_number, &buffer[index]);
+		mb_put_binary_long(MB_YES, v2beamformed->serial_number, &buffer[index]);
 		index += 8;
-		mb_put_binary_int(MB_YES, tvg->ping_number, &buffer[index]);
+		mb_put_binary_int(MB_YES, v2beamformed->ping_number, &buffer[index]);
 		index += 4;
-		mb_put_binary_short(MB_YES, tvg->multi_ping, &buffer[index]);
+		mb_put_binary_short(MB_YES, v2beamformed->multi_ping, &buffer[index]);
 		index += 2;
-		mb_put_binary_int(MB_YES, tvg->n, &buffer[index]);
+		mb_put_binary_short(MB_YES, v2beamformed->number_beams, &buffer[index]);
+		index += 2;
+		mb_put_binary_int(MB_YES, v2beamformed->number_samples, &buffer[index]);
 		index += 4;
-		for (i = 0; i < 8; i++) {
-			mb_put_binary_int(MB_YES, tvg->reserved[i], &buffer[index]);
-			index += 4;
+		for (i = 0; i < 32; i++) {
+			buffer[index] = v2beamformed->reserved[i];
+			index++;
 		}
+		for (i = 0; i < v2beamformed->number_beams; i++) {
+			v2amplitudephase = &(v2beamformed->amplitudephase[i]);
 
-		/* insert tvg data */
-		memcpy((void *)&buffer[index], (const void *)tvg->tvg, (size_t)(tvg->n * sizeof(float)));
-		index += tvg->n * sizeof(float);
+			/* insert v2beamformed data */
+			for (j = 0; j < v2beamformed->number_samples; j++) {
+				mb_put_binary_short(MB_YES, v2amplitudephase->amplitude[j], &buffer[index]);
+				index += 2;
+				mb_put_binary_short(MB_YES, v2amplitudephase->phase[j], &buffer[index]);
+				index += 2;
+			}
+		}
 
 		/* reset the header size value */
 		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
@@ -15658,8 +17652,6 @@ int mbr_reson7kr_wr_tvg(int verbose, int *bufferalloc, char **bufferptr, void *s
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
-		fprintf(stderr, "dbg2       size:       %d\n", *size);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:  %d\n", status);
@@ -15669,20 +17661,127 @@ int mbr_reson7kr_wr_tvg(int verbose, int *bufferalloc, char **bufferptr, void *s
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_image(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_image";
+int mbr_reson7kr_wr_compressedbottom(int verbose, void *store_ptr, unsigned int flags, int nbottom, int *bottom, int *size,
+                                     int *ncompressedmax, int *error) {
+	char *function_name = "mbr_reson7kr_wr_compressedbottom";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
-	s7k_header *header;
-	s7kr_image *image;
+	s7kr_v2beamformed *v2beamformed;
+	s7kr_v2rawdetection *v2rawdetection;
+	s7kr_bathymetry *bathymetry;
+	s7kr_volatilesettings *volatilesettings;
+	unsigned int downsample;
+	int divisor;
+	int samplesize;
+	int nsamples;
+	int ncompressed;
+	int beam;
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       flags:      0x%x\n", flags);
+		fprintf(stderr, "dbg2       nbottom:    %d\n", nbottom);
+		fprintf(stderr, "dbg2       bottom:     %p\n", (void *)bottom);
+	}
+
+	/* get pointer to raw data structure */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+	v2beamformed = &(store->v2beamformed);
+	v2rawdetection = &(store->v2rawdetection);
+	bathymetry = &(store->bathymetry);
+	volatilesettings = &(store->volatilesettings);
+
+	/* get the compression settings */
+	downsample = flags & R7KWC_DOWNSAMPLE_MASK;
+	divisor = (flags & R7KWC_DIVISOR_MASK) >> R7KWC_DIVISOR_SHIFT;
+	if (downsample == R7KWC_DOWNSAMPLE_NONE || divisor < 2)
+		divisor = 1;
+	samplesize = ((flags & R7KWC_MAGNITUDEONLY) ? 1 : 2) * ((flags & R7KWC_8BITDB) ? 1 : 2);
+	nsamples = v2beamformed->number_samples;
+
+	/* get the last sample to be kept in each beam - bottom detection + 10%.
+	    The bottom array is sized by the caller to the beams of the ping */
+	for (i = 0; i < nbottom; i++)
+		bottom[i] = nsamples;
+	if (flags & R7KWC_CLIPBOTTOM) {
+		if (store->read_mask & R7KREAD_V2RawDetection) {
+			for (i = 0; i < v2rawdetection->number_beams; i++) {
+				beam = v2rawdetection->beam_descriptor[i];
+				if (beam < nbottom && v2rawdetection->detection_point[i] > 0.0)
+					bottom[beam] = MIN(nsamples, (int)(1.1 * v2rawdetection->detection_point[i]) + 1);
+			}
+		}
+		else if ((store->read_mask & R7KREAD_Bathymetry) && volatilesettings->sample_rate > 0.0) {
+			for (i = 0; i < bathymetry->number_beams && i < nbottom; i++) {
+				if ((bathymetry->quality[i] & 15) > 0 && bathymetry->range[i] > 0.0)
+					bottom[i] = MIN(nsamples, (int)(1.1 * bathymetry->range[i] * volatilesettings->sample_rate) + 1);
+			}
+		}
+	}
+
+	/* figure out size of output record exactly as the writer does */
+	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
+	*size += R7KHDRSIZE_7kCompressedWaterColumn;
+	*ncompressedmax = 0;
+	for (i = 0; i < v2beamformed->number_beams; i++) {
+		beam = v2beamformed->amplitudephase[i].beam_number;
+		ncompressed = ((beam < nbottom ? bottom[beam] : nsamples) + divisor - 1) / divisor;
+		*ncompressedmax = MAX(*ncompressedmax, ncompressed);
+		*size += 6 + ncompressed * samplesize;
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       size:           %d\n", *size);
+		fprintf(stderr, "dbg2       ncompressedmax: %d\n", *ncompressedmax);
+		fprintf(stderr, "dbg2       error:          %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:  %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbr_reson7kr_wr_compressedwatercolumn(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, unsigned int flags,
+                                          int nbottom, int *bottom, int nsample, unsigned short *magnitude, short *phasesample,
+                                          int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_compressedwatercolumn";
+	int status = MB_SUCCESS;
+	struct mbsys_reson7k_struct *store;
+	s7k_header header;
+	s7kr_v2beamformed *v2beamformed;
+	s7kr_v2amplitudephase *v2amplitudephase;
+	s7kr_volatilesettings *volatilesettings;
+	mb_u_char *dbtable;
+	unsigned int downsample;
+	int divisor;
+	int magnitudeonly;
+	int eightbit;
+	int samplesize;
+	int nsamples;
+	int nkeep;
+	int ncompressed;
+	int ncompressedmax;
+	int beam;
+	unsigned short *amplitude;
+	short *phase;
+	unsigned short *mag;
+	short *pha;
+	unsigned int sum;
+	int j0, j1, js;
 	unsigned int checksum;
 	int index;
 	char *buffer;
-	int nalloc;
-	char *charptr;
-	unsigned short *ushortptr;
-	unsigned int *uintptr;
-	int i;
+	int i, j, k;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -15693,28 +17792,61 @@ int mbr_reson7kr_wr_image(int verbose, int *bufferalloc, char **bufferptr, void
 		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
 		fprintf(stderr, "dbg2       bufferptr:  %p\n", (void *)bufferptr);
 		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       flags:      0x%x\n", flags);
+		fprintf(stderr, "dbg2       nbottom:    %d\n", nbottom);
+		fprintf(stderr, "dbg2       bottom:     %p\n", (void *)bottom);
+		fprintf(stderr, "dbg2       nsample:    %d\n", nsample);
+		fprintf(stderr, "dbg2       magnitude:  %p\n", (void *)magnitude);
+		fprintf(stderr, "dbg2       phasesample:%p\n", (void *)phasesample);
 	}
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	image = &(store->image);
-	header = &(image->header);
+	v2beamformed = &(store->v2beamformed);
+	volatilesettings = &(store->volatilesettings);
 
-/* print out the data to be output */
-#ifdef MBR_RESON7KR_DEBUG2
-	if (verbose > 0)
-#else
-	if (verbose >= 2)
-#endif
-		mbsys_reson7k_print_image(verbose, image, error);
+	/* get the 8 bit dB conversion tabulated at registration */
+	dbtable = mbr_reson7kr_dbtable;
+
+	/* get the compression settings */
+	downsample = flags & R7KWC_DOWNSAMPLE_MASK;
+	divisor = (flags & R7KWC_DIVISOR_MASK) >> R7KWC_DIVISOR_SHIFT;
+	if (downsample == R7KWC_DOWNSAMPLE_NONE || divisor < 2)
+		divisor = 1;
+	magnitudeonly = (flags & R7KWC_MAGNITUDEONLY) ? MB_YES : MB_NO;
+	eightbit = (flags & R7KWC_8BITDB) ? MB_YES : MB_NO;
+	samplesize = (magnitudeonly == MB_YES ? 1 : 2) * (eightbit == MB_YES ? 1 : 2);
+	nsamples = v2beamformed->number_samples;
+
+	/* the last sample to be kept in each beam was set in bottom by
+	    mbr_reson7kr_wr_compressedbottom() when the record was sized */
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_7kImageData;
-	*size += image->width * image->height * image->color_depth;
+	*size += R7KHDRSIZE_7kCompressedWaterColumn;
+	ncompressedmax = 0;
+	for (i = 0; i < v2beamformed->number_beams; i++) {
+		beam = v2beamformed->amplitudephase[i].beam_number;
+		ncompressed = ((beam < nbottom ? bottom[beam] : nsamples) + divisor - 1) / divisor;
+		ncompressedmax = MAX(ncompressedmax, ncompressed);
+		*size += 6 + ncompressed * samplesize;
+	}
+
+	/* downsampled beams are gathered in the scratch arrays */
+	if (divisor > 1 && ncompressedmax > nsample) {
+		status = MB_FAILURE;
+		*error = MB_ERROR_MEMORY_FAIL;
+	}
+
+	/* set the record header from the beamformed record it replaces */
+	header = v2beamformed->header;
+	header.RecordType = R7KRECID_7kCompressedWaterColumn;
+	header.OffsetToOptionalData = 0;
+	header.OptionalDataIdentifier = 0;
+	header.Size = *size;
 
 	/* allocate memory to write rest of record if necessary */
-	if (*bufferalloc < *size) {
+	if (status == MB_SUCCESS && *bufferalloc < *size) {
 		status = mb_reallocd(verbose, __FILE__, __LINE__, *size, (void **)bufferptr, error);
 		if (status != MB_SUCCESS) {
 			*bufferalloc = 0;
@@ -15731,59 +17863,117 @@ int mbr_reson7kr_wr_image(int verbose, int *bufferalloc, char **bufferptr, void
 
 		/* insert the header */
 		index = 0;
-		status = mbr_reson7kr_wr_header(verbose, buffer, &index, header, error);
+		status = mbr_reson7kr_wr_header(verbose, buffer, &index, &header, error);
 
-		/* insert the data */
-		index = header->Offset + 4;
-		mb_put_binary_int(MB_YES, image->ping_number, &buffer[index]);
+		/* insert the record type header */
+		index = header.Offset + 4;
+		mb_put_binary_long(MB_YES, v2beamformed->serial_number, &buffer[index]);
+		index += 8;
+		mb_put_binary_int(MB_YES, v2beamformed->ping_number, &buffer[index]);
 		index += 4;
-		mb_put_binary_short(MB_YES, image->multi_ping, &buffer[index]);
+		mb_put_binary_short(MB_YES, v2beamformed->multi_ping, &buffer[index]);
 		index += 2;
-		mb_put_binary_int(MB_YES, image->width, &buffer[index]);
+		mb_put_binary_short(MB_YES, v2beamformed->number_beams, &buffer[index]);
+		index += 2;
+		mb_put_binary_int(MB_YES, nsamples, &buffer[index]);
 		index += 4;
-		mb_put_binary_int(MB_YES, image->height, &buffer[index]);
+		mb_put_binary_int(MB_YES, ncompressedmax, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, flags, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, 0, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, (float)(volatilesettings->sample_rate / divisor), &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, 1.0, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, 0, &buffer[index]);
 		index += 4;
-		mb_put_binary_short(MB_YES, image->color_depth, &buffer[index]);
-		index += 2;
-		mb_put_binary_short(MB_YES, image->width_height_flag, &buffer[index]);
-		index += 2;
-		mb_put_binary_short(MB_YES, image->compression, &buffer[index]);
-		index += 2;
 
-		/* allocate memory for image if needed */
-		nalloc = image->width * image->height * image->color_depth;
-		if (status == MB_SUCCESS && image->nalloc < nalloc) {
-			image->nalloc = nalloc;
-			if (status == MB_SUCCESS)
-				status = mb_reallocd(verbose, __FILE__, __LINE__, image->nalloc, (void **)&(image->image), error);
-			if (status != MB_SUCCESS) {
-				image->nalloc = 0;
-				image->width = 0;
-				image->height = 0;
+		/* insert the compressed samples for each beam - when downsampling,
+		    the magnitude of each output sample and the phase of the sample
+		    it represents are first gathered into the scratch arrays sized by
+		    the caller to nsample. Each format is then written in a single
+		    pass over the samples without branches or calls, storing the
+		    bytes in the little endian order of the 7k format directly */
+		for (i = 0; i < v2beamformed->number_beams; i++) {
+			v2amplitudephase = &(v2beamformed->amplitudephase[i]);
+			amplitude = (unsigned short *)v2amplitudephase->amplitude;
+			phase = (short *)v2amplitudephase->phase;
+			beam = v2amplitudephase->beam_number;
+			nkeep = (beam < nbottom ? bottom[beam] : nsamples);
+			ncompressed = (nkeep + divisor - 1) / divisor;
+
+			mb_put_binary_short(MB_YES, v2amplitudephase->beam_number, &buffer[index]);
+			index += 2;
+			mb_put_binary_int(MB_YES, ncompressed, &buffer[index]);
+			index += 4;
+
+			/* no downsampling - the samples are written as held */
+			mag = amplitude;
+			pha = phase;
+
+			/* downsampling - each output sample represents divisor input samples */
+			if (divisor > 1) {
+				mag = magnitude;
+				pha = phasesample;
+				if (downsample == R7KWC_DOWNSAMPLE_PEAK) {
+					for (k = 0; k < ncompressed; k++) {
+						j0 = k * divisor;
+						j1 = MIN(j0 + divisor, nkeep);
+						js = j0;
+						for (j = j0 + 1; j < j1; j++)
+							js = (amplitude[j] > amplitude[js] ? j : js);
+						mag[k] = amplitude[js];
+						pha[k] = phase[js];
+					}
+				}
+				else if (downsample == R7KWC_DOWNSAMPLE_AVERAGE) {
+					for (k = 0; k < ncompressed; k++) {
+						j0 = k * divisor;
+						j1 = MIN(j0 + divisor, nkeep);
+						sum = 0;
+						for (j = j0; j < j1; j++)
+							sum += amplitude[j];
+						mag[k] = (unsigned short)(sum / (j1 - j0));
+						pha[k] = phase[(j0 + j1) / 2];
+					}
+				}
+				else {
+					for (k = 0; k < ncompressed; k++) {
+						js = (k * divisor + MIN(k * divisor + divisor, nkeep)) / 2;
+						mag[k] = amplitude[js];
+						pha[k] = phase[js];
+					}
+				}
 			}
-		}
 
-		/* extract image data */
-		if (image->color_depth == 1) {
-			charptr = (char *)image->image;
-			for (i = 0; i < image->width * image->height; i++) {
-				buffer[index] = charptr[i];
-				index++;
+			/* write the samples */
+			if (magnitudeonly == MB_YES && eightbit == MB_YES) {
+				for (k = 0; k < ncompressed; k++)
+					buffer[index + k] = (char)dbtable[mag[k]];
 			}
-		}
-		else if (image->color_depth == 2) {
-			ushortptr = (unsigned short *)image->image;
-			for (i = 0; i < image->width * image->height; i++) {
-				mb_put_binary_short(MB_YES, ushortptr[i], &buffer[index]);
-				index += 2;
+			else if (eightbit == MB_YES) {
+				for (k = 0; k < ncompressed; k++) {
+					buffer[index + 2 * k] = (char)dbtable[mag[k]];
+					buffer[index + 2 * k + 1] = (char)(pha[k] >> 8);
+				}
 			}
-		}
-		else if (image->color_depth == 4) {
-			uintptr = (unsigned int *)image->image;
-			for (i = 0; i < image->width * image->height; i++) {
-				mb_put_binary_int(MB_YES, uintptr[i], &buffer[index]);
-				index += 4;
+			else if (magnitudeonly == MB_YES) {
+				for (k = 0; k < ncompressed; k++) {
+					buffer[index + 2 * k] = (char)(mag[k] & 0xFF);
+					buffer[index + 2 * k + 1] = (char)(mag[k] >> 8);
+				}
+			}
+			else {
+				for (k = 0; k < ncompressed; k++) {
+					buffer[index + 4 * k] = (char)(mag[k] & 0xFF);
+					buffer[index + 4 * k + 1] = (char)(mag[k] >> 8);
+					buffer[index + 4 * k + 2] = (char)(((unsigned short)pha[k]) & 0xFF);
+					buffer[index + 4 * k + 3] = (char)(((unsigned short)pha[k]) >> 8);
+				}
 			}
+			index += ncompressed * samplesize;
 		}
 
 		/* reset the header size value */
@@ -15809,7 +17999,6 @@ int mbr_reson7kr_wr_image(int verbose, int *bufferalloc, char **bufferptr, void
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
 		fprintf(stderr, "dbg2       size:       %d\n", *size);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
@@ -15820,16 +18009,19 @@ int mbr_reson7kr_wr_image(int verbose, int *bufferalloc, char **bufferptr, void
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_v2pingmotion(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_v2pingmotion";
+int mbr_reson7kr_wr_v2bite(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_v2bite";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_v2pingmotion *v2pingmotion;
+	s7kr_v2bite *v2bite;
+	s7kr_v2bitereport *report;
+	s7k_time *s7ktime;
+	s7kr_v2bitefield *bitefield;
 	unsigned int checksum;
 	int index;
 	char *buffer;
-	int i;
+	int i, j, k;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -15844,8 +18036,8 @@ int mbr_reson7kr_wr_v2pingmotion(int verbose, int *bufferalloc, char **bufferptr
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	v2pingmotion = &(store->v2pingmotion);
-	header = &(v2pingmotion->header);
+	v2bite = &(store->v2bite);
+	header = &(v2bite->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -15853,21 +18045,17 @@ int mbr_reson7kr_wr_v2pingmotion(int verbose, int *bufferalloc, char **bufferptr
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_v2pingmotion(verbose, v2pingmotion, error);
+		mbsys_reson7k_print_v2bite(verbose, v2bite, error);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_7kV2PingMotion;
-	if (v2pingmotion->flags & 1)
-		*size += sizeof(float);
-	if (v2pingmotion->flags & 2)
-		*size += sizeof(float) * v2pingmotion->n;
-	if (v2pingmotion->flags & 4)
-		*size += sizeof(float) * v2pingmotion->n;
-	if (v2pingmotion->flags & 8)
-		*size += sizeof(float) * v2pingmotion->n;
+	*size += R7KHDRSIZE_7kV2BITEData;
+	for (i = 0; i < v2bite->number_reports; i++) {
+		report = &(v2bite->reports[i]);
+		*size += R7KRDTSIZE_7kV2BITERecordData + report->number_bite * R7KRDTSIZE_7kV2BITEFieldData;
+	}
 
-	/* allocate memory to write rest of record if necessary */
+	/* allocate memory to store rest of record if necessary */
 	if (*bufferalloc < *size) {
 		status = mb_reallocd(verbose, __FILE__, __LINE__, *size, (void **)bufferptr, error);
 		if (status != MB_SUCCESS) {
@@ -15889,39 +18077,84 @@ int mbr_reson7kr_wr_v2pingmotion(int verbose, int *bufferalloc, char **bufferptr
 
 		/* insert the data */
 		index = header->Offset + 4;
-		mb_put_binary_long(MB_YES, v2pingmotion->serial_number, &buffer[index]);
-		index += 8;
-		mb_put_binary_int(MB_YES, v2pingmotion->ping_number, &buffer[index]);
-		index += 4;
-		mb_put_binary_short(MB_YES, v2pingmotion->multi_ping, &buffer[index]);
-		index += 2;
-		mb_put_binary_int(MB_YES, v2pingmotion->n, &buffer[index]);
-		index += 4;
-		mb_put_binary_short(MB_YES, v2pingmotion->flags, &buffer[index]);
+		mb_put_binary_short(MB_YES, v2bite->number_reports, &buffer[index]);
 		index += 2;
-		mb_put_binary_int(MB_YES, v2pingmotion->error_flags, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, v2pingmotion->frequency, &buffer[index]);
-		index += 4;
-		if (v2pingmotion->flags & 1) {
-			mb_put_binary_float(MB_YES, v2pingmotion->pitch, &buffer[index]);
+		for (i = 0; i < v2bite->number_reports; i++) {
+			report = &(v2bite->reports[i]);
+
+			for (j = 0; j < 64; j++) {
+				buffer[index] = report->source_name[j];
+				index++;
+			}
+			buffer[index] = report->source_address;
+			index++;
+			mb_put_binary_float(MB_YES, report->frequency, &buffer[index]);
 			index += 4;
-		}
-		if (v2pingmotion->flags & 2) {
-			for (i = 0; i < v2pingmotion->n; i++) {
-				mb_put_binary_float(MB_YES, v2pingmotion->roll[i], &buffer[index]);
-				index += 4;
+			mb_put_binary_short(MB_YES, report->enumerator, &buffer[index]);
+			index += 2;
+
+			s7ktime = &(report->downlink_time);
+			mb_put_binary_short(MB_YES, s7ktime->Year, &buffer[index]);
+			index += 2;
+			mb_put_binary_short(MB_YES, s7ktime->Day, &buffer[index]);
+			index += 2;
+			mb_put_binary_float(MB_YES, s7ktime->Seconds, &buffer[index]);
+			index += 4;
+			buffer[index] = s7ktime->Hours;
+			index++;
+			buffer[index] = s7ktime->Minutes;
+			index++;
+
+			s7ktime = &(report->uplink_time);
+			mb_put_binary_short(MB_YES, s7ktime->Year, &buffer[index]);
+			index += 2;
+			mb_put_binary_short(MB_YES, s7ktime->Day, &buffer[index]);
+			index += 2;
+			mb_put_binary_float(MB_YES, s7ktime->Seconds, &buffer[index]);
+			index += 4;
+			buffer[index] = s7ktime->Hours;
+			index++;
+			buffer[index] = s7ktime->Minutes;
+			index++;
+
+			s7ktime = &(report->bite_time);
+			mb_put_binary_short(MB_YES, s7ktime->Year, &buffer[index]);
+			index += 2;
+			mb_put_binary_short(MB_YES, s7ktime->Day, &buffer[index]);
+			index += 2;
+			mb_put_binary_float(MB_YES, s7ktime->Seconds, &buffer[index]);
+			index += 4;
+			buffer[index] = s7ktime->Hours;
+			index++;
+			buffer[index] = s7ktime->Minutes;
+			index++;
+
+			buffer[index] = report->status;
+			index++;
+			mb_put_binary_short(MB_YES, report->number_bite, &buffer[index]);
+			index += 2;
+			for (j = 0; j < 32; j++) {
+				buffer[index] = report->bite_status[j];
+				index++;
 			}
-		}
-		if (v2pingmotion->flags & 4) {
-			for (i = 0; i < v2pingmotion->n; i++) {
-				mb_put_binary_float(MB_YES, v2pingmotion->heading[i], &buffer[index]);
+
+			/* loop over all bite fields */
+			for (j = 0; j < report->number_bite; j++) {
+				bitefield = &(report->bitefield[j]);
+
+				mb_put_binary_short(MB_YES, bitefield->reserved, &buffer[index]);
+				index += 2;
+				for (k = 0; k < 64; k++) {
+					buffer[index] = bitefield->name[k];
+					index++;
+				}
+				buffer[index] = bitefield->device_type;
+				index++;
+				mb_put_binary_float(MB_YES, bitefield->minimum, &buffer[index]);
 				index += 4;
-			}
-		}
-		if (v2pingmotion->flags & 8) {
-			for (i = 0; i < v2pingmotion->n; i++) {
-				mb_put_binary_float(MB_YES, v2pingmotion->heave[i], &buffer[index]);
+				mb_put_binary_float(MB_YES, bitefield->maximum, &buffer[index]);
+				index += 4;
+				mb_put_binary_float(MB_YES, bitefield->value, &buffer[index]);
 				index += 4;
 			}
 		}
@@ -15958,12 +18191,12 @@ int mbr_reson7kr_wr_v2pingmotion(int verbose, int *bufferalloc, char **bufferptr
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_v2detectionsetup(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_v2detectionsetup";
+int mbr_reson7kr_wr_v27kcenterversion(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_v27kcenterversion";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_v2detectionsetup *v2detectionsetup;
+	s7kr_v27kcenterversion *v27kcenterversion;
 	unsigned int checksum;
 	int index;
 	char *buffer;
@@ -15982,8 +18215,8 @@ int mbr_reson7kr_wr_v2detectionsetup(int verbose, int *bufferalloc, char **buffe
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	v2detectionsetup = &(store->v2detectionsetup);
-	header = &(v2detectionsetup->header);
+	v27kcenterversion = &(store->v27kcenterversion);
+	header = &(v27kcenterversion->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -15991,92 +18224,37 @@ int mbr_reson7kr_wr_v2detectionsetup(int verbose, int *bufferalloc, char **buffe
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_v2detectionsetup(verbose, v2detectionsetup, error);
+		mbsys_reson7k_print_v27kcenterversion(verbose, v27kcenterversion, error);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_7kV2DetectionSetup;
-	*size += v2detectionsetup->number_beams * v2detectionsetup->data_field_size;
+	*size += R7KHDRSIZE_7kV27kCenterVersion;
 
-	/* allocate memory to write rest of record if necessary */
+	/* allocate memory to store rest of record if necessary */
 	if (*bufferalloc < *size) {
 		status = mb_reallocd(verbose, __FILE__, __LINE__, *size, (void **)bufferptr, error);
 		if (status != MB_SUCCESS) {
 			*bufferalloc = 0;
 		}
-		else {
-			*bufferalloc = *size;
-		}
-	}
-
-	/* proceed to write if buffer allocated */
-	if (status == MB_SUCCESS) {
-		/* get buffer for writing */
-		buffer = (char *)*bufferptr;
-
-		/* insert the header */
-		index = 0;
-		status = mbr_reson7kr_wr_header(verbose, buffer, &index, header, error);
-
-		/* insert the data */
-		index = header->Offset + 4;
-		mb_put_binary_long(MB_YES, v2detectionsetup->serial_number, &buffer[index]);
-		index += 8;
-		mb_put_binary_int(MB_YES, v2detectionsetup->ping_number, &buffer[index]);
-		index += 4;
-		mb_put_binary_short(MB_YES, v2detectionsetup->multi_ping, &buffer[index]);
-		index += 2;
-		mb_put_binary_int(MB_YES, v2detectionsetup->number_beams, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, v2detectionsetup->data_field_size, &buffer[index]);
-		index += 4;
-		buffer[index] = v2detectionsetup->detection_algorithm;
-		index++;
-		mb_put_binary_int(MB_YES, v2detectionsetup->detection_flags, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, v2detectionsetup->minimum_depth, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, v2detectionsetup->maximum_depth, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, v2detectionsetup->minimum_range, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, v2detectionsetup->maximum_range, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, v2detectionsetup->minimum_nadir_search, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, v2detectionsetup->maximum_nadir_search, &buffer[index]);
-		index += 4;
-		buffer[index] = v2detectionsetup->automatic_filter_window;
-		index++;
-		mb_put_binary_float(MB_YES, v2detectionsetup->applied_roll, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, v2detectionsetup->depth_gate_tilt, &buffer[index]);
-		index += 4;
-		for (i = 0; i < 14; i++) {
-			mb_put_binary_float(MB_YES, v2detectionsetup->reserved[i], &buffer[index]);
-			index += 4;
-		}
-		for (i = 0; i < v2detectionsetup->number_beams; i++) {
-			mb_put_binary_short(MB_YES, v2detectionsetup->beam_descriptor[i], &buffer[index]);
-			index += 2;
-			mb_put_binary_float(MB_YES, v2detectionsetup->detection_point[i], &buffer[index]);
-			index += 4;
-			mb_put_binary_int(MB_YES, v2detectionsetup->flags[i], &buffer[index]);
-			index += 4;
-			mb_put_binary_int(MB_YES, v2detectionsetup->auto_limits_min_sample[i], &buffer[index]);
-			index += 4;
-			mb_put_binary_int(MB_YES, v2detectionsetup->auto_limits_max_sample[i], &buffer[index]);
-			index += 4;
-			mb_put_binary_int(MB_YES, v2detectionsetup->user_limits_min_sample[i], &buffer[index]);
-			index += 4;
-			mb_put_binary_int(MB_YES, v2detectionsetup->user_limits_max_sample[i], &buffer[index]);
-			index += 4;
-			mb_put_binary_int(MB_YES, v2detectionsetup->quality[i], &buffer[index]);
-			index += 4;
-			if (v2detectionsetup->data_field_size >= R7KRDTSIZE_7kV2DetectionSetup + 4) {
-				mb_put_binary_int(MB_YES, v2detectionsetup->uncertainty[i], &buffer[index]);
-				index += 4;
-			}
+		else {
+			*bufferalloc = *size;
+		}
+	}
+
+	/* proceed to write if buffer allocated */
+	if (status == MB_SUCCESS) {
+		/* get buffer for writing */
+		buffer = (char *)*bufferptr;
+
+		/* insert the header */
+		index = 0;
+		status = mbr_reson7kr_wr_header(verbose, buffer, &index, header, error);
+
+		/* insert the data */
+		index = header->Offset + 4;
+		for (i = 0; i < 32; i++) {
+			buffer[index] = v27kcenterversion->version[i];
+			index++;
 		}
 
 		/* reset the header size value */
@@ -16111,17 +18289,16 @@ int mbr_reson7kr_wr_v2detectionsetup(int verbose, int *bufferalloc, char **buffe
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_v2beamformed(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_v2beamformed";
+int mbr_reson7kr_wr_v28kwetendversion(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_v28kwetendversion";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_v2beamformed *v2beamformed;
-	s7kr_v2amplitudephase *v2amplitudephase;
+	s7kr_v28kwetendversion *v28kwetendversion;
 	unsigned int checksum;
 	int index;
 	char *buffer;
-	int i, j;
+	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -16136,8 +18313,8 @@ int mbr_reson7kr_wr_v2beamformed(int verbose, int *bufferalloc, char **bufferptr
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	v2beamformed = &(store->v2beamformed);
-	header = &(v2beamformed->header);
+	v28kwetendversion = &(store->v28kwetendversion);
+	header = &(v28kwetendversion->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -16145,14 +18322,13 @@ int mbr_reson7kr_wr_v2beamformed(int verbose, int *bufferalloc, char **bufferptr
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_v2beamformed(verbose, v2beamformed, error);
+		mbsys_reson7k_print_v28kwetendversion(verbose, v28kwetendversion, error);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_7kV2BeamformedData;
-	*size += 2 * sizeof(short) * v2beamformed->number_beams * v2beamformed->number_samples;
+	*size += R7KHDRSIZE_7kV28kWetEndVersion;
 
-	/* allocate memory to write rest of record if necessary */
+	/* allocate memory to store rest of record if necessary */
 	if (*bufferalloc < *size) {
 		status = mb_reallocd(verbose, __FILE__, __LINE__, *size, (void **)bufferptr, error);
 		if (status != MB_SUCCESS) {
@@ -16174,31 +18350,10 @@ int mbr_reson7kr_wr_v2beamformed(int verbose, int *bufferalloc, char **bufferptr
 
 		/* insert the data */
 		index = header->Offset + 4;
-		mb_put_binary_long(MB_YES, v2beamformed->serial_number, &buffer[index]);
-		index += 8;
-		mb_put_binary_int(MB_YES, v2beamformed->ping_number, &buffer[index]);
-		index += 4;
-		mb_put_binary_short(MB_YES, v2beamformed->multi_ping, &buffer[index]);
-		index += 2;
-		mb_put_binary_short(MB_YES, v2beamformed->number_beams, &buffer[index]);
-		index += 2;
-		mb_put_binary_int(MB_YES, v2beamformed->number_samples, &buffer[index]);
-		index += 4;
 		for (i = 0; i < 32; i++) {
-			buffer[index] = v2beamformed->reserved[i];
+			buffer[index] = v28kwetendversion->version[i];
 			index++;
 		}
-		for (i = 0; i < v2beamformed->number_beams; i++) {
-			v2amplitudephase = &(v2beamformed->amplitudephase[i]);
-
-			/* insert v2beamformed data */
-			for (j = 0; j < v2beamformed->number_samples; j++) {
-				mb_put_binary_short(MB_YES, v2amplitudephase->amplitude[j], &buffer[index]);
-				index += 2;
-				mb_put_binary_short(MB_YES, v2amplitudephase->phase[j], &buffer[index]);
-				index += 2;
-			}
-		}
 
 		/* reset the header size value */
 		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
@@ -16232,19 +18387,16 @@ int mbr_reson7kr_wr_v2beamformed(int verbose, int *bufferalloc, char **bufferptr
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_v2bite(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_v2bite";
+int mbr_reson7kr_wr_v2detection(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_v2detection";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_v2bite *v2bite;
-	s7kr_v2bitereport *report;
-	s7k_time *s7ktime;
-	s7kr_v2bitefield *bitefield;
+	s7kr_v2detection *v2detection;
 	unsigned int checksum;
 	int index;
 	char *buffer;
-	int i, j, k;
+	int i, j;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -16259,8 +18411,15 @@ int mbr_reson7kr_wr_v2bite(int verbose, int *bufferalloc, char **bufferptr, void
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	v2bite = &(store->v2bite);
-	header = &(v2bite->header);
+	v2detection = &(store->v2detection);
+	header = &(v2detection->header);
+
+	/* figure out size of output record */
+	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
+	*size += R7KHDRSIZE_7kV2Detection;
+	*size += v2detection->number_beams * v2detection->data_field_size;
+	header->OffsetToOptionalData = 0;
+	header->Size = *size;
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -16268,17 +18427,9 @@ int mbr_reson7kr_wr_v2bite(int verbose, int *bufferalloc, char **bufferptr, void
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_v2bite(verbose, v2bite, error);
-
-	/* figure out size of output record */
-	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_7kV2BITEData;
-	for (i = 0; i < v2bite->number_reports; i++) {
-		report = &(v2bite->reports[i]);
-		*size += R7KRDTSIZE_7kV2BITERecordData + report->number_bite * R7KRDTSIZE_7kV2BITEFieldData;
-	}
+		mbsys_reson7k_print_v2detection(verbose, v2detection, error);
 
-	/* allocate memory to store rest of record if necessary */
+	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
 		status = mb_reallocd(verbose, __FILE__, __LINE__, *size, (void **)bufferptr, error);
 		if (status != MB_SUCCESS) {
@@ -16300,86 +18451,46 @@ int mbr_reson7kr_wr_v2bite(int verbose, int *bufferalloc, char **bufferptr, void
 
 		/* insert the data */
 		index = header->Offset + 4;
-		mb_put_binary_short(MB_YES, v2bite->number_reports, &buffer[index]);
+		mb_put_binary_long(MB_YES, v2detection->serial_number, &buffer[index]);
+		index += 8;
+		mb_put_binary_int(MB_YES, v2detection->ping_number, &buffer[index]);
+		index += 4;
+		mb_put_binary_short(MB_YES, v2detection->multi_ping, &buffer[index]);
 		index += 2;
-		for (i = 0; i < v2bite->number_reports; i++) {
-			report = &(v2bite->reports[i]);
-
-			for (j = 0; j < 64; j++) {
-				buffer[index] = report->source_name[j];
-				index++;
-			}
-			buffer[index] = report->source_address;
+		mb_put_binary_int(MB_YES, v2detection->number_beams, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, v2detection->data_field_size, &buffer[index]);
+		index += 4;
+		mb_put_binary_long(MB_YES, v2detection->corrections, &buffer[index]);
+		index += 8;
+		buffer[index] = v2detection->detection_algorithm;
+		index++;
+		mb_put_binary_int(MB_YES, v2detection->flags, &buffer[index]);
+		index += 4;
+		for (i = 0; i < 64; i++) {
+			buffer[index] = v2detection->reserved[i];
 			index++;
-			mb_put_binary_float(MB_YES, report->frequency, &buffer[index]);
-			index += 4;
-			mb_put_binary_short(MB_YES, report->enumerator, &buffer[index]);
-			index += 2;
+		}
 
-			s7ktime = &(report->downlink_time);
-			mb_put_binary_short(MB_YES, s7ktime->Year, &buffer[index]);
-			index += 2;
-			mb_put_binary_short(MB_YES, s7ktime->Day, &buffer[index]);
-			index += 2;
-			mb_put_binary_float(MB_YES, s7ktime->Seconds, &buffer[index]);
+		/* insert the data */
+		for (i = 0; i < v2detection->number_beams; i++) {
+			mb_put_binary_float(MB_YES, v2detection->range[i], &buffer[index]);
 			index += 4;
-			buffer[index] = s7ktime->Hours;
-			index++;
-			buffer[index] = s7ktime->Minutes;
-			index++;
-
-			s7ktime = &(report->uplink_time);
-			mb_put_binary_short(MB_YES, s7ktime->Year, &buffer[index]);
-			index += 2;
-			mb_put_binary_short(MB_YES, s7ktime->Day, &buffer[index]);
-			index += 2;
-			mb_put_binary_float(MB_YES, s7ktime->Seconds, &buffer[index]);
+			mb_put_binary_float(MB_YES, v2detection->angle_x[i], &buffer[index]);
 			index += 4;
-			buffer[index] = s7ktime->Hours;
-			index++;
-			buffer[index] = s7ktime->Minutes;
-			index++;
-
-			s7ktime = &(report->bite_time);
-			mb_put_binary_short(MB_YES, s7ktime->Year, &buffer[index]);
-			index += 2;
-			mb_put_binary_short(MB_YES, s7ktime->Day, &buffer[index]);
-			index += 2;
-			mb_put_binary_float(MB_YES, s7ktime->Seconds, &buffer[index]);
+			mb_put_binary_float(MB_YES, v2detection->angle_y[i], &buffer[index]);
 			index += 4;
-			buffer[index] = s7ktime->Hours;
-			index++;
-			buffer[index] = s7ktime->Minutes;
-			index++;
-
-			buffer[index] = report->status;
-			index++;
-			mb_put_binary_short(MB_YES, report->number_bite, &buffer[index]);
-			index += 2;
-			for (j = 0; j < 32; j++) {
-				buffer[index] = report->bite_status[j];
-				index++;
-			}
-
-			/* loop over all bite fields */
-			for (j = 0; j < report->number_bite; j++) {
-				bitefield = &(report->bitefield[j]);
-
-				mb_put_binary_short(MB_YES, bitefield->reserved, &buffer[index]);
-				index += 2;
-				for (k = 0; k < 64; k++) {
-					buffer[index] = bitefield->name[k];
+			mb_put_binary_float(MB_YES, v2detection->range_error[i], &buffer[index]);
+			index += 4;
+			mb_put_binary_float(MB_YES, v2detection->angle_x_error[i], &buffer[index]);
+			index += 4;
+			mb_put_binary_float(MB_YES, v2detection->angle_y_error[i], &buffer[index]);
+			index += 4;
+			if (v2detection->data_field_size > 24)
+				for (j = 0; j < v2detection->data_field_size - 24; j++) {
+					buffer[index] = 0;
 					index++;
 				}
-				buffer[index] = bitefield->device_type;
-				index++;
-				mb_put_binary_float(MB_YES, bitefield->minimum, &buffer[index]);
-				index += 4;
-				mb_put_binary_float(MB_YES, bitefield->maximum, &buffer[index]);
-				index += 4;
-				mb_put_binary_float(MB_YES, bitefield->value, &buffer[index]);
-				index += 4;
-			}
 		}
 
 		/* reset the header size value */
@@ -16405,6 +18516,8 @@ int mbr_reson7kr_wr_v2bite(int verbose, int *bufferalloc, char **bufferptr, void
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
+		fprintf(stderr, "dbg2       size:       %d\n", *size);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:  %d\n", status);
@@ -16414,16 +18527,16 @@ int mbr_reson7kr_wr_v2bite(int verbose, int *bufferalloc, char **bufferptr, void
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_v27kcenterversion(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_v27kcenterversion";
+int mbr_reson7kr_wr_v2rawdetection(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_v2rawdetection";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_v27kcenterversion *v27kcenterversion;
+	s7kr_v2rawdetection *v2rawdetection;
 	unsigned int checksum;
 	int index;
 	char *buffer;
-	int i;
+	int i, j;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -16438,8 +18551,15 @@ int mbr_reson7kr_wr_v27kcenterversion(int verbose, int *bufferalloc, char **buff
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	v27kcenterversion = &(store->v27kcenterversion);
-	header = &(v27kcenterversion->header);
+	v2rawdetection = &(store->v2rawdetection);
+	header = &(v2rawdetection->header);
+
+	/* figure out size of output record */
+	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
+	*size += R7KHDRSIZE_7kV2RawDetection;
+	*size += v2rawdetection->number_beams * v2rawdetection->data_field_size;
+	header->OffsetToOptionalData = 0;
+	header->Size = *size;
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -16447,13 +18567,9 @@ int mbr_reson7kr_wr_v27kcenterversion(int verbose, int *bufferalloc, char **buff
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_v27kcenterversion(verbose, v27kcenterversion, error);
-
-	/* figure out size of output record */
-	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_7kV27kCenterVersion;
+		mbsys_reson7k_print_v2rawdetection(verbose, v2rawdetection, error);
 
-	/* allocate memory to store rest of record if necessary */
+	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
 		status = mb_reallocd(verbose, __FILE__, __LINE__, *size, (void **)bufferptr, error);
 		if (status != MB_SUCCESS) {
@@ -16475,11 +18591,50 @@ int mbr_reson7kr_wr_v27kcenterversion(int verbose, int *bufferalloc, char **buff
 
 		/* insert the data */
 		index = header->Offset + 4;
-		for (i = 0; i < 32; i++) {
-			buffer[index] = v27kcenterversion->version[i];
+		mb_put_binary_long(MB_YES, v2rawdetection->serial_number, &buffer[index]);
+		index += 8;
+		mb_put_binary_int(MB_YES, v2rawdetection->ping_number, &buffer[index]);
+		index += 4;
+		mb_put_binary_short(MB_YES, v2rawdetection->multi_ping, &buffer[index]);
+		index += 2;
+		mb_put_binary_int(MB_YES, v2rawdetection->number_beams, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, v2rawdetection->data_field_size, &buffer[index]);
+		index += 4;
+		buffer[index] = v2rawdetection->detection_algorithm;
+		index++;
+		mb_put_binary_int(MB_YES, v2rawdetection->detection_flags, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, v2rawdetection->sampling_rate, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, v2rawdetection->tx_angle, &buffer[index]);
+		index += 4;
+		for (i = 0; i < 64; i++) {
+			buffer[index] = v2rawdetection->reserved[i];
 			index++;
 		}
 
+		/* insert the data */
+		for (i = 0; i < v2rawdetection->number_beams; i++) {
+			mb_put_binary_short(MB_YES, v2rawdetection->beam_descriptor[i], &buffer[index]);
+			index += 2;
+			mb_put_binary_float(MB_YES, v2rawdetection->detection_point[i], &buffer[index]);
+			index += 4;
+			mb_put_binary_float(MB_YES, v2rawdetection->rx_angle[i], &buffer[index]);
+			index += 4;
+			mb_put_binary_int(MB_YES, v2rawdetection->flags[i], &buffer[index]);
+			index += 4;
+			mb_put_binary_int(MB_YES, v2rawdetection->quality[i], &buffer[index]);
+			index += 4;
+			mb_put_binary_float(MB_YES, v2rawdetection->uncertainty[i], &buffer[index]);
+			index += 4;
+			if (v2rawdetection->data_field_size > 22)
+				for (j = 0; j < v2rawdetection->data_field_size - 22; j++) {
+					buffer[index] = 0;
+					index++;
+				}
+		}
+
 		/* reset the header size value */
 		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
 
@@ -16503,6 +18658,8 @@ int mbr_reson7kr_wr_v27kcenterversion(int verbose, int *bufferalloc, char **buff
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
+		fprintf(stderr, "dbg2       size:       %d\n", *size);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:  %d\n", status);
@@ -16512,16 +18669,17 @@ int mbr_reson7kr_wr_v27kcenterversion(int verbose, int *bufferalloc, char **buff
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_v28kwetendversion(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_v28kwetendversion";
+int mbr_reson7kr_wr_v2snippet(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_v2snippet";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_v28kwetendversion *v28kwetendversion;
+	s7kr_v2snippet *v2snippet;
+	s7kr_v2snippettimeseries *snippettimeseries;
 	unsigned int checksum;
 	int index;
 	char *buffer;
-	int i;
+	int i, j;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -16536,8 +18694,20 @@ int mbr_reson7kr_wr_v28kwetendversion(int verbose, int *bufferalloc, char **buff
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	v28kwetendversion = &(store->v28kwetendversion);
-	header = &(v28kwetendversion->header);
+	v2snippet = &(store->v2snippet);
+	header = &(v2snippet->header);
+
+	/* figure out size of output record */
+	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
+	*size += R7KHDRSIZE_7kV2SnippetData;
+	for (i = 0; i < v2snippet->number_beams; i++) {
+		snippettimeseries = &(v2snippet->snippettimeseries[i]);
+
+		*size += R7KRDTSIZE_7kV2SnippetTimeseries +
+		         sizeof(short) * (snippettimeseries->end_sample - snippettimeseries->begin_sample + 1);
+	}
+	header->OffsetToOptionalData = 0;
+	header->Size = *size;
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -16545,13 +18715,9 @@ int mbr_reson7kr_wr_v28kwetendversion(int verbose, int *bufferalloc, char **buff
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_v28kwetendversion(verbose, v28kwetendversion, error);
-
-	/* figure out size of output record */
-	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_7kV28kWetEndVersion;
+		mbsys_reson7k_print_v2snippet(verbose, v2snippet, error);
 
-	/* allocate memory to store rest of record if necessary */
+	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
 		status = mb_reallocd(verbose, __FILE__, __LINE__, *size, (void **)bufferptr, error);
 		if (status != MB_SUCCESS) {
@@ -16573,11 +18739,47 @@ int mbr_reson7kr_wr_v28kwetendversion(int verbose, int *bufferalloc, char **buff
 
 		/* insert the data */
 		index = header->Offset + 4;
-		for (i = 0; i < 32; i++) {
-			buffer[index] = v28kwetendversion->version[i];
+		mb_put_binary_long(MB_YES, v2snippet->serial_number, &buffer[index]);
+		index += 8;
+		mb_put_binary_int(MB_YES, v2snippet->ping_number, &buffer[index]);
+		index += 4;
+		mb_put_binary_short(MB_YES, v2snippet->multi_ping, &buffer[index]);
+		index += 2;
+		mb_put_binary_short(MB_YES, v2snippet->number_beams, &buffer[index]);
+		index += 2;
+		buffer[index] = v2snippet->error_flag;
+		index++;
+		buffer[index] = v2snippet->control_flags;
+		index++;
+		for (i = 0; i < 28; i++) {
+			buffer[index] = v2snippet->reserved[i];
 			index++;
 		}
 
+		/* insert the snippet parameters */
+		for (i = 0; i < v2snippet->number_beams; i++) {
+			snippettimeseries = &(v2snippet->snippettimeseries[i]);
+
+			/* extract snippettimeseries data */
+			mb_put_binary_short(MB_YES, snippettimeseries->beam_number, &buffer[index]);
+			index += 2;
+			mb_put_binary_int(MB_YES, snippettimeseries->begin_sample, &buffer[index]);
+			index += 4;
+			mb_put_binary_int(MB_YES, snippettimeseries->detect_sample, &buffer[index]);
+			index += 4;
+			mb_put_binary_int(MB_YES, snippettimeseries->end_sample, &buffer[index]);
+			index += 4;
+		}
+
+		/* loop over all beams to insert snippet data */
+		for (i = 0; i < v2snippet->number_beams; i++) {
+			snippettimeseries = &(v2snippet->snippettimeseries[i]);
+			for (j = 0; j < (snippettimeseries->end_sample - snippettimeseries->begin_sample + 1); j++) {
+				mb_put_binary_short(MB_YES, snippettimeseries->amplitude[j], &buffer[index]);
+				index += 2;
+			}
+		}
+
 		/* reset the header size value */
 		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
 
@@ -16601,6 +18803,8 @@ int mbr_reson7kr_wr_v28kwetendversion(int verbose, int *bufferalloc, char **buff
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
+		fprintf(stderr, "dbg2       size:       %d\n", *size);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:  %d\n", status);
@@ -16610,12 +18814,13 @@ int mbr_reson7kr_wr_v28kwetendversion(int verbose, int *bufferalloc, char **buff
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_v2detection(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_v2detection";
+int mbr_reson7kr_wr_calibratedsnippet(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_calibratedsnippet";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_v2detection *v2detection;
+	s7kr_calibratedsnippet *calibratedsnippet;
+	s7kr_calibratedsnippettimeseries *snippettimeseries;
 	unsigned int checksum;
 	int index;
 	char *buffer;
@@ -16634,13 +18839,18 @@ int mbr_reson7kr_wr_v2detection(int verbose, int *bufferalloc, char **bufferptr,
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	v2detection = &(store->v2detection);
-	header = &(v2detection->header);
+	calibratedsnippet = &(store->calibratedsnippet);
+	header = &(calibratedsnippet->header);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_7kV2Detection;
-	*size += v2detection->number_beams * v2detection->data_field_size;
+	*size += R7KHDRSIZE_7kCalibratedSnippetData;
+	for (i = 0; i < calibratedsnippet->number_beams; i++) {
+		snippettimeseries = &(calibratedsnippet->calibratedsnippettimeseries[i]);
+
+		*size += R7KRDTSIZE_7kCalibratedSnippetTimeseries +
+		         sizeof(float) * (snippettimeseries->end_sample - snippettimeseries->begin_sample + 1);
+	}
 	header->OffsetToOptionalData = 0;
 	header->Size = *size;
 
@@ -16650,7 +18860,7 @@ int mbr_reson7kr_wr_v2detection(int verbose, int *bufferalloc, char **bufferptr,
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_v2detection(verbose, v2detection, error);
+		mbsys_reson7k_print_calibratedsnippet(verbose, calibratedsnippet, error);
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -16674,46 +18884,45 @@ int mbr_reson7kr_wr_v2detection(int verbose, int *bufferalloc, char **bufferptr,
 
 		/* insert the data */
 		index = header->Offset + 4;
-		mb_put_binary_long(MB_YES, v2detection->serial_number, &buffer[index]);
+		mb_put_binary_long(MB_YES, calibratedsnippet->serial_number, &buffer[index]);
 		index += 8;
-		mb_put_binary_int(MB_YES, v2detection->ping_number, &buffer[index]);
+		mb_put_binary_int(MB_YES, calibratedsnippet->ping_number, &buffer[index]);
 		index += 4;
-		mb_put_binary_short(MB_YES, v2detection->multi_ping, &buffer[index]);
+		mb_put_binary_short(MB_YES, calibratedsnippet->multi_ping, &buffer[index]);
 		index += 2;
-		mb_put_binary_int(MB_YES, v2detection->number_beams, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, v2detection->data_field_size, &buffer[index]);
-		index += 4;
-		mb_put_binary_long(MB_YES, v2detection->corrections, &buffer[index]);
-		index += 8;
-		buffer[index] = v2detection->detection_algorithm;
+		mb_put_binary_short(MB_YES, calibratedsnippet->number_beams, &buffer[index]);
+		index += 2;
+		buffer[index] = calibratedsnippet->error_flag;
 		index++;
-		mb_put_binary_int(MB_YES, v2detection->flags, &buffer[index]);
+		mb_put_binary_int(MB_YES, calibratedsnippet->control_flags, &buffer[index]);
 		index += 4;
-		for (i = 0; i < 64; i++) {
-			buffer[index] = v2detection->reserved[i];
+		for (i = 0; i < 28; i++) {
+			buffer[index] = calibratedsnippet->reserved[i];
 			index++;
 		}
 
-		/* insert the data */
-		for (i = 0; i < v2detection->number_beams; i++) {
-			mb_put_binary_float(MB_YES, v2detection->range[i], &buffer[index]);
-			index += 4;
-			mb_put_binary_float(MB_YES, v2detection->angle_x[i], &buffer[index]);
-			index += 4;
-			mb_put_binary_float(MB_YES, v2detection->angle_y[i], &buffer[index]);
-			index += 4;
-			mb_put_binary_float(MB_YES, v2detection->range_error[i], &buffer[index]);
+		/* insert the snippet parameters */
+		for (i = 0; i < calibratedsnippet->number_beams; i++) {
+			snippettimeseries = &(calibratedsnippet->calibratedsnippettimeseries[i]);
+
+			/* extract snippettimeseries data */
+			mb_put_binary_short(MB_YES, snippettimeseries->beam_number, &buffer[index]);
+			index += 2;
+			mb_put_binary_int(MB_YES, snippettimeseries->begin_sample, &buffer[index]);
 			index += 4;
-			mb_put_binary_float(MB_YES, v2detection->angle_x_error[i], &buffer[index]);
+			mb_put_binary_int(MB_YES, snippettimeseries->detect_sample, &buffer[index]);
 			index += 4;
-			mb_put_binary_float(MB_YES, v2detection->angle_y_error[i], &buffer[index]);
+			mb_put_binary_int(MB_YES, snippettimeseries->end_sample, &buffer[index]);
 			index += 4;
-			if (v2detection->data_field_size > 24)
-				for (j = 0; j < v2detection->data_field_size - 24; j++) {
-					buffer[index] = 0;
-					index++;
-				}
+		}
+
+		/* loop over all beams to insert snippet data */
+		for (i = 0; i < calibratedsnippet->number_beams; i++) {
+			snippettimeseries = &(calibratedsnippet->calibratedsnippettimeseries[i]);
+			for (j = 0; j < (snippettimeseries->end_sample - snippettimeseries->begin_sample + 1); j++) {
+				mb_put_binary_float(MB_YES, snippettimeseries->amplitude[j], &buffer[index]);
+				index += 4;
+			}
 		}
 
 		/* reset the header size value */
@@ -16748,18 +18957,17 @@ int mbr_reson7kr_wr_v2detection(int verbose, int *bufferalloc, char **bufferptr,
 
 	/* return status */
 	return (status);
-}
-/*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_v2rawdetection(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_v2rawdetection";
+} /*--------------------------------------------------------------------*/
+int mbr_reson7kr_wr_installation(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_installation";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_v2rawdetection *v2rawdetection;
+	s7kr_installation *installation;
 	unsigned int checksum;
 	int index;
 	char *buffer;
-	int i, j;
+	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -16774,15 +18982,8 @@ int mbr_reson7kr_wr_v2rawdetection(int verbose, int *bufferalloc, char **bufferp
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	v2rawdetection = &(store->v2rawdetection);
-	header = &(v2rawdetection->header);
-
-	/* figure out size of output record */
-	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_7kV2RawDetection;
-	*size += v2rawdetection->number_beams * v2rawdetection->data_field_size;
-	header->OffsetToOptionalData = 0;
-	header->Size = *size;
+	installation = &(store->installation);
+	header = &(installation->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -16790,7 +18991,11 @@ int mbr_reson7kr_wr_v2rawdetection(int verbose, int *bufferalloc, char **bufferp
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_v2rawdetection(verbose, v2rawdetection, error);
+		mbsys_reson7k_print_installation(verbose, installation, error);
+
+	/* figure out size of output record */
+	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
+	*size += R7KHDRSIZE_7kInstallationParameters;
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -16814,49 +19019,80 @@ int mbr_reson7kr_wr_v2rawdetection(int verbose, int *bufferalloc, char **bufferp
 
 		/* insert the data */
 		index = header->Offset + 4;
-		mb_put_binary_long(MB_YES, v2rawdetection->serial_number, &buffer[index]);
-		index += 8;
-		mb_put_binary_int(MB_YES, v2rawdetection->ping_number, &buffer[index]);
+		mb_put_binary_float(MB_YES, installation->frequency, &buffer[index]);
+		index += 4;
+		mb_put_binary_short(MB_YES, installation->firmware_version_len, &buffer[index]);
+		index += 2;
+		for (i = 0; i < 128; i++) {
+			buffer[index] = installation->firmware_version[i];
+			index++;
+		}
+		mb_put_binary_short(MB_YES, installation->software_version_len, &buffer[index]);
+		index += 2;
+		for (i = 0; i < 128; i++) {
+			buffer[index] = installation->software_version[i];
+			index++;
+		}
+		mb_put_binary_short(MB_YES, installation->s7k_version_len, &buffer[index]);
+		index += 2;
+		for (i = 0; i < 128; i++) {
+			buffer[index] = installation->s7k_version[i];
+			index++;
+		}
+		mb_put_binary_short(MB_YES, installation->protocal_version_len, &buffer[index]);
+		index += 2;
+		for (i = 0; i < 128; i++) {
+			buffer[index] = installation->protocal_version[i];
+			index++;
+		}
+		mb_put_binary_float(MB_YES, installation->transmit_x, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, installation->transmit_y, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, installation->transmit_z, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, installation->transmit_roll, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, installation->transmit_pitch, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, installation->transmit_heading, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, installation->receive_x, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, installation->receive_y, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, installation->receive_z, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, installation->receive_roll, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, installation->receive_pitch, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, installation->receive_heading, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, installation->motion_x, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, installation->motion_y, &buffer[index]);
 		index += 4;
-		mb_put_binary_short(MB_YES, v2rawdetection->multi_ping, &buffer[index]);
-		index += 2;
-		mb_put_binary_int(MB_YES, v2rawdetection->number_beams, &buffer[index]);
+		mb_put_binary_float(MB_YES, installation->motion_z, &buffer[index]);
 		index += 4;
-		mb_put_binary_int(MB_YES, v2rawdetection->data_field_size, &buffer[index]);
+		mb_put_binary_float(MB_YES, installation->motion_roll, &buffer[index]);
 		index += 4;
-		buffer[index] = v2rawdetection->detection_algorithm;
-		index++;
-		mb_put_binary_int(MB_YES, v2rawdetection->detection_flags, &buffer[index]);
+		mb_put_binary_float(MB_YES, installation->motion_pitch, &buffer[index]);
 		index += 4;
-		mb_put_binary_float(MB_YES, v2rawdetection->sampling_rate, &buffer[index]);
+		mb_put_binary_float(MB_YES, installation->motion_heading, &buffer[index]);
 		index += 4;
-		mb_put_binary_float(MB_YES, v2rawdetection->tx_angle, &buffer[index]);
+		mb_put_binary_short(MB_YES, installation->motion_time_delay, &buffer[index]);
+		index += 2;
+		mb_put_binary_float(MB_YES, installation->position_x, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, installation->position_y, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, installation->position_z, &buffer[index]);
+		index += 4;
+		mb_put_binary_short(MB_YES, installation->position_time_delay, &buffer[index]);
+		index += 2;
+		mb_put_binary_float(MB_YES, installation->waterline_z, &buffer[index]);
 		index += 4;
-		for (i = 0; i < 64; i++) {
-			buffer[index] = v2rawdetection->reserved[i];
-			index++;
-		}
-
-		/* insert the data */
-		for (i = 0; i < v2rawdetection->number_beams; i++) {
-			mb_put_binary_short(MB_YES, v2rawdetection->beam_descriptor[i], &buffer[index]);
-			index += 2;
-			mb_put_binary_float(MB_YES, v2rawdetection->detection_point[i], &buffer[index]);
-			index += 4;
-			mb_put_binary_float(MB_YES, v2rawdetection->rx_angle[i], &buffer[index]);
-			index += 4;
-			mb_put_binary_int(MB_YES, v2rawdetection->flags[i], &buffer[index]);
-			index += 4;
-			mb_put_binary_int(MB_YES, v2rawdetection->quality[i], &buffer[index]);
-			index += 4;
-			mb_put_binary_float(MB_YES, v2rawdetection->uncertainty[i], &buffer[index]);
-			index += 4;
-			if (v2rawdetection->data_field_size > 22)
-				for (j = 0; j < v2rawdetection->data_field_size - 22; j++) {
-					buffer[index] = 0;
-					index++;
-				}
-		}
 
 		/* reset the header size value */
 		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
@@ -16892,17 +19128,17 @@ int mbr_reson7kr_wr_v2rawdetection(int verbose, int *bufferalloc, char **bufferp
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_v2snippet(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_v2snippet";
+int mbr_reson7kr_wr_fileheader(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_fileheader";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_v2snippet *v2snippet;
-	s7kr_v2snippettimeseries *snippettimeseries;
+	s7kr_fileheader *fileheader;
+	s7kr_subsystem *subsystem;
 	unsigned int checksum;
 	int index;
 	char *buffer;
-	int i, j;
+	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -16917,20 +19153,40 @@ int mbr_reson7kr_wr_v2snippet(int verbose, int *bufferalloc, char **bufferptr, v
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	v2snippet = &(store->v2snippet);
-	header = &(v2snippet->header);
+	fileheader = &(store->fileheader);
+	header = &(fileheader->header);
 
-	/* figure out size of output record */
-	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_7kV2SnippetData;
-	for (i = 0; i < v2snippet->number_beams; i++) {
-		snippettimeseries = &(v2snippet->snippettimeseries[i]);
+	/* make sure data are defined properly */
+	if (status == MB_SUCCESS && header->RecordType != R7KRECID_7kFileHeader) {
 
-		*size += R7KRDTSIZE_7kV2SnippetTimeseries +
-		         sizeof(short) * (snippettimeseries->end_sample - snippettimeseries->begin_sample + 1);
+		/* Reson 7k data record header information */
+		header->Version = 4;
+		header->Offset = 60;
+		header->SyncPattern = 0x0000ffff;
+		header->OffsetToOptionalData = 0;
+		header->OptionalDataIdentifier = 0;
+		header->s7kTime.Year = 0;
+		header->s7kTime.Day = 0;
+		header->s7kTime.Seconds = 0.0;
+		header->s7kTime.Hours = 0;
+		header->s7kTime.Minutes = 0;
+		header->Reserved = 0;
+		header->RecordType = R7KRECID_7kFileHeader;
+		header->DeviceId = 0;
+		header->Reserved2 = 0;
+		header->SystemEnumerator = 0;
+		header->DataSetNumber = 0;
+		header->RecordNumber = 0;
+		for (i = 0; i < 8; i++) {
+			header->PreviousRecord[i] = -1;
+			header->NextRecord[i] = -1;
+		}
+		header->Flags = 0;
+		header->Reserved3 = 0;
+		header->Reserved4 = 0;
+		header->FragmentedTotal = 0;
+		header->FragmentNumber = 0;
 	}
-	header->OffsetToOptionalData = 0;
-	header->Size = *size;
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -16938,7 +19194,22 @@ int mbr_reson7kr_wr_v2snippet(int verbose, int *bufferalloc, char **bufferptr, v
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_v2snippet(verbose, v2snippet, error);
+		mbsys_reson7k_print_fileheader(verbose, fileheader, error);
+
+	/* figure out size of output record */
+	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
+	*size += R7KHDRSIZE_7kFileHeader + R7KRDTSIZE_7kFileHeader;
+	for (i = 0; i < fileheader->number_subsystems; i++)
+		*size += 6;
+
+	/* always reserve the optional data holding the file catalog location -
+	    the catalog is appended and this record patched when the file is closed */
+	header->OffsetToOptionalData = *size - MBSYS_RESON7K_RECORDTAIL_SIZE;
+	*size += R7KOPTSIZE_7kFileHeader;
+	header->Size = *size;
+	fileheader->optionaldata = MB_YES;
+	fileheader->catalog_size = 0;
+	fileheader->catalog_offset = 0;
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -16962,46 +19233,51 @@ int mbr_reson7kr_wr_v2snippet(int verbose, int *bufferalloc, char **bufferptr, v
 
 		/* insert the data */
 		index = header->Offset + 4;
-		mb_put_binary_long(MB_YES, v2snippet->serial_number, &buffer[index]);
-		index += 8;
-		mb_put_binary_int(MB_YES, v2snippet->ping_number, &buffer[index]);
-		index += 4;
-		mb_put_binary_short(MB_YES, v2snippet->multi_ping, &buffer[index]);
+		for (i = 0; i < 16; i++) {
+			buffer[index] = fileheader->file_identifier[i];
+			index++;
+		}
+		mb_put_binary_short(MB_YES, fileheader->version, &buffer[index]);
 		index += 2;
-		mb_put_binary_short(MB_YES, v2snippet->number_beams, &buffer[index]);
+		mb_put_binary_short(MB_YES, fileheader->reserved, &buffer[index]);
 		index += 2;
-		buffer[index] = v2snippet->error_flag;
-		index++;
-		buffer[index] = v2snippet->control_flags;
-		index++;
-		for (i = 0; i < 28; i++) {
-			buffer[index] = v2snippet->reserved[i];
+		for (i = 0; i < 16; i++) {
+			buffer[index] = fileheader->session_identifier[i];
 			index++;
 		}
-
-		/* insert the snippet parameters */
-		for (i = 0; i < v2snippet->number_beams; i++) {
-			snippettimeseries = &(v2snippet->snippettimeseries[i]);
-
-			/* extract snippettimeseries data */
-			mb_put_binary_short(MB_YES, snippettimeseries->beam_number, &buffer[index]);
-			index += 2;
-			mb_put_binary_int(MB_YES, snippettimeseries->begin_sample, &buffer[index]);
-			index += 4;
-			mb_put_binary_int(MB_YES, snippettimeseries->detect_sample, &buffer[index]);
-			index += 4;
-			mb_put_binary_int(MB_YES, snippettimeseries->end_sample, &buffer[index]);
+		mb_put_binary_int(MB_YES, fileheader->record_data_size, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, fileheader->number_subsystems, &buffer[index]);
+		index += 4;
+		for (i = 0; i < 64; i++) {
+			buffer[index] = fileheader->recording_name[i];
+			index++;
+		}
+		for (i = 0; i < 16; i++) {
+			buffer[index] = fileheader->recording_version[i];
+			index++;
+		}
+		for (i = 0; i < 64; i++) {
+			buffer[index] = fileheader->user_defined_name[i];
+			index++;
+		}
+		for (i = 0; i < 128; i++) {
+			buffer[index] = fileheader->notes[i];
+			index++;
+		}
+		for (i = 0; i < fileheader->number_subsystems; i++) {
+			subsystem = &(fileheader->subsystem[i]);
+			mb_put_binary_int(MB_YES, subsystem->device_identifier, &buffer[index]);
 			index += 4;
+			mb_put_binary_short(MB_YES, subsystem->system_enumerator, &buffer[index]);
+			index += 2;
 		}
 
-		/* loop over all beams to insert snippet data */
-		for (i = 0; i < v2snippet->number_beams; i++) {
-			snippettimeseries = &(v2snippet->snippettimeseries[i]);
-			for (j = 0; j < (snippettimeseries->end_sample - snippettimeseries->begin_sample + 1); j++) {
-				mb_put_binary_short(MB_YES, snippettimeseries->amplitude[j], &buffer[index]);
-				index += 2;
-			}
-		}
+		/* insert the optional data */
+		mb_put_binary_int(MB_YES, fileheader->catalog_size, &buffer[index]);
+		index += 4;
+		mb_put_binary_long(MB_YES, (mb_s_long)fileheader->catalog_offset, &buffer[index]);
+		index += 8;
 
 		/* reset the header size value */
 		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
@@ -17037,17 +19313,16 @@ int mbr_reson7kr_wr_v2snippet(int verbose, int *bufferalloc, char **bufferptr, v
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_calibratedsnippet(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_calibratedsnippet";
+int mbr_reson7kr_wr_systemeventmessage(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_systemeventmessage";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_calibratedsnippet *calibratedsnippet;
-	s7kr_calibratedsnippettimeseries *snippettimeseries;
+	s7kr_systemeventmessage *systemeventmessage;
 	unsigned int checksum;
 	int index;
 	char *buffer;
-	int i, j;
+	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -17062,20 +19337,8 @@ int mbr_reson7kr_wr_calibratedsnippet(int verbose, int *bufferalloc, char **buff
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	calibratedsnippet = &(store->calibratedsnippet);
-	header = &(calibratedsnippet->header);
-
-	/* figure out size of output record */
-	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_7kCalibratedSnippetData;
-	for (i = 0; i < calibratedsnippet->number_beams; i++) {
-		snippettimeseries = &(calibratedsnippet->calibratedsnippettimeseries[i]);
-
-		*size += R7KRDTSIZE_7kCalibratedSnippetTimeseries +
-		         sizeof(float) * (snippettimeseries->end_sample - snippettimeseries->begin_sample + 1);
-	}
-	header->OffsetToOptionalData = 0;
-	header->Size = *size;
+	systemeventmessage = &(store->systemeventmessage);
+	header = &(systemeventmessage->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -17083,7 +19346,12 @@ int mbr_reson7kr_wr_calibratedsnippet(int verbose, int *bufferalloc, char **buff
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_calibratedsnippet(verbose, calibratedsnippet, error);
+		mbsys_reson7k_print_systemeventmessage(verbose, systemeventmessage, error);
+
+	/* figure out size of output record */
+	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
+	*size += R7KHDRSIZE_7kSystemEventMessage;
+	*size += systemeventmessage->message_length;
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -17094,58 +19362,32 @@ int mbr_reson7kr_wr_calibratedsnippet(int verbose, int *bufferalloc, char **buff
 		else {
 			*bufferalloc = *size;
 		}
-	}
-
-	/* proceed to write if buffer allocated */
-	if (status == MB_SUCCESS) {
-		/* get buffer for writing */
-		buffer = (char *)*bufferptr;
-
-		/* insert the header */
-		index = 0;
-		status = mbr_reson7kr_wr_header(verbose, buffer, &index, header, error);
-
-		/* insert the data */
-		index = header->Offset + 4;
-		mb_put_binary_long(MB_YES, calibratedsnippet->serial_number, &buffer[index]);
-		index += 8;
-		mb_put_binary_int(MB_YES, calibratedsnippet->ping_number, &buffer[index]);
-		index += 4;
-		mb_put_binary_short(MB_YES, calibratedsnippet->multi_ping, &buffer[index]);
-		index += 2;
-		mb_put_binary_short(MB_YES, calibratedsnippet->number_beams, &buffer[index]);
-		index += 2;
-		buffer[index] = calibratedsnippet->error_flag;
-		index++;
-		mb_put_binary_int(MB_YES, calibratedsnippet->control_flags, &buffer[index]);
-		index += 4;
-		for (i = 0; i < 28; i++) {
-			buffer[index] = calibratedsnippet->reserved[i];
-			index++;
-		}
-
-		/* insert the snippet parameters */
-		for (i = 0; i < calibratedsnippet->number_beams; i++) {
-			snippettimeseries = &(calibratedsnippet->calibratedsnippettimeseries[i]);
-
-			/* extract snippettimeseries data */
-			mb_put_binary_short(MB_YES, snippettimeseries->beam_number, &buffer[index]);
-			index += 2;
-			mb_put_binary_int(MB_YES, snippettimeseries->begin_sample, &buffer[index]);
-			index += 4;
-			mb_put_binary_int(MB_YES, snippettimeseries->detect_sample, &buffer[index]);
-			index += 4;
-			mb_put_binary_int(MB_YES, snippettimeseries->end_sample, &buffer[index]);
-			index += 4;
-		}
+	}
 
-		/* loop over all beams to insert snippet data */
-		for (i = 0; i < calibratedsnippet->number_beams; i++) {
-			snippettimeseries = &(calibratedsnippet->calibratedsnippettimeseries[i]);
-			for (j = 0; j < (snippettimeseries->end_sample - snippettimeseries->begin_sample + 1); j++) {
-				mb_put_binary_float(MB_YES, snippettimeseries->amplitude[j], &buffer[index]);
-				index += 4;
-			}
+	/* proceed to write if buffer allocated */
+	if (status == MB_SUCCESS) {
+		/* get buffer for writing */
+		buffer = (char *)*bufferptr;
+
+		/* insert the header */
+		index = 0;
+		status = mbr_reson7kr_wr_header(verbose, buffer, &index, header, error);
+
+		/* insert the data */
+		index = header->Offset + 4;
+		mb_put_binary_long(MB_YES, systemeventmessage->serial_number, &buffer[index]);
+		index += 8;
+		mb_put_binary_short(MB_YES, systemeventmessage->event_id, &buffer[index]);
+		index += 2;
+		mb_put_binary_short(MB_YES, systemeventmessage->message_length, &buffer[index]);
+		index += 2;
+		mb_put_binary_short(MB_YES, systemeventmessage->event_identifier, &buffer[index]);
+		index += 2;
+
+		/* insert the data */
+		for (i = 0; i < systemeventmessage->message_length; i++) {
+			buffer[index] = systemeventmessage->message[i];
+			index++;
 		}
 
 		/* reset the header size value */
@@ -17180,13 +19422,15 @@ int mbr_reson7kr_wr_calibratedsnippet(int verbose, int *bufferalloc, char **buff
 
 	/* return status */
 	return (status);
-} /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_installation(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_installation";
+}
+/*--------------------------------------------------------------------*/
+int mbr_reson7kr_wr_remotecontrolsettings(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size,
+                                          int *error) {
+	char *function_name = "mbr_reson7kr_wr_remotecontrolsettings";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_installation *installation;
+	s7kr_remotecontrolsettings *remotecontrolsettings;
 	unsigned int checksum;
 	int index;
 	char *buffer;
@@ -17205,8 +19449,8 @@ int mbr_reson7kr_wr_installation(int verbose, int *bufferalloc, char **bufferptr
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	installation = &(store->installation);
-	header = &(installation->header);
+	remotecontrolsettings = &(store->remotecontrolsettings);
+	header = &(remotecontrolsettings->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -17214,11 +19458,11 @@ int mbr_reson7kr_wr_installation(int verbose, int *bufferalloc, char **bufferptr
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_installation(verbose, installation, error);
+		mbsys_reson7k_print_remotecontrolsettings(verbose, remotecontrolsettings, error);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_7kInstallationParameters;
+	*size += R7KHDRSIZE_7kRemoteControlSonarSettings;
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -17242,81 +19486,211 @@ int mbr_reson7kr_wr_installation(int verbose, int *bufferalloc, char **bufferptr
 
 		/* insert the data */
 		index = header->Offset + 4;
-		mb_put_binary_float(MB_YES, installation->frequency, &buffer[index]);
+		mb_put_binary_long(MB_YES, remotecontrolsettings->serial_number, &buffer[index]);
+		index += 8;
+		mb_put_binary_int(MB_YES, remotecontrolsettings->ping_number, &buffer[index]);
 		index += 4;
-		mb_put_binary_short(MB_YES, installation->firmware_version_len, &buffer[index]);
-		index += 2;
-		for (i = 0; i < 128; i++) {
-			buffer[index] = installation->firmware_version[i];
-			index++;
-		}
-		mb_put_binary_short(MB_YES, installation->software_version_len, &buffer[index]);
-		index += 2;
-		for (i = 0; i < 128; i++) {
-			buffer[index] = installation->software_version[i];
-			index++;
-		}
-		mb_put_binary_short(MB_YES, installation->s7k_version_len, &buffer[index]);
-		index += 2;
-		for (i = 0; i < 128; i++) {
-			buffer[index] = installation->s7k_version[i];
-			index++;
-		}
-		mb_put_binary_short(MB_YES, installation->protocal_version_len, &buffer[index]);
-		index += 2;
-		for (i = 0; i < 128; i++) {
-			buffer[index] = installation->protocal_version[i];
-			index++;
-		}
-		mb_put_binary_float(MB_YES, installation->transmit_x, &buffer[index]);
+		mb_put_binary_float(MB_YES, remotecontrolsettings->frequency, &buffer[index]);
 		index += 4;
-		mb_put_binary_float(MB_YES, installation->transmit_y, &buffer[index]);
+		mb_put_binary_float(MB_YES, remotecontrolsettings->sample_rate, &buffer[index]);
 		index += 4;
-		mb_put_binary_float(MB_YES, installation->transmit_z, &buffer[index]);
+		mb_put_binary_float(MB_YES, remotecontrolsettings->receiver_bandwidth, &buffer[index]);
 		index += 4;
-		mb_put_binary_float(MB_YES, installation->transmit_roll, &buffer[index]);
+		mb_put_binary_float(MB_YES, remotecontrolsettings->pulse_width, &buffer[index]);
 		index += 4;
-		mb_put_binary_float(MB_YES, installation->transmit_pitch, &buffer[index]);
+		mb_put_binary_int(MB_YES, remotecontrolsettings->pulse_type, &buffer[index]);
 		index += 4;
-		mb_put_binary_float(MB_YES, installation->transmit_heading, &buffer[index]);
+		mb_put_binary_int(MB_YES, remotecontrolsettings->pulse_envelope, &buffer[index]);
 		index += 4;
-		mb_put_binary_float(MB_YES, installation->receive_x, &buffer[index]);
+		mb_put_binary_float(MB_YES, remotecontrolsettings->pulse_envelope_par, &buffer[index]);
 		index += 4;
-		mb_put_binary_float(MB_YES, installation->receive_y, &buffer[index]);
+		mb_put_binary_int(MB_YES, remotecontrolsettings->pulse_reserved, &buffer[index]);
 		index += 4;
-		mb_put_binary_float(MB_YES, installation->receive_z, &buffer[index]);
+		mb_put_binary_float(MB_YES, remotecontrolsettings->max_ping_rate, &buffer[index]);
 		index += 4;
-		mb_put_binary_float(MB_YES, installation->receive_roll, &buffer[index]);
+		mb_put_binary_float(MB_YES, remotecontrolsettings->ping_period, &buffer[index]);
 		index += 4;
-		mb_put_binary_float(MB_YES, installation->receive_pitch, &buffer[index]);
+		mb_put_binary_float(MB_YES, remotecontrolsettings->range_selection, &buffer[index]);
 		index += 4;
-		mb_put_binary_float(MB_YES, installation->receive_heading, &buffer[index]);
+		mb_put_binary_float(MB_YES, remotecontrolsettings->power_selection, &buffer[index]);
 		index += 4;
-		mb_put_binary_float(MB_YES, installation->motion_x, &buffer[index]);
+		mb_put_binary_float(MB_YES, remotecontrolsettings->gain_selection, &buffer[index]);
 		index += 4;
-		mb_put_binary_float(MB_YES, installation->motion_y, &buffer[index]);
+		mb_put_binary_int(MB_YES, remotecontrolsettings->control_flags, &buffer[index]);
 		index += 4;
-		mb_put_binary_float(MB_YES, installation->motion_z, &buffer[index]);
+		mb_put_binary_int(MB_YES, remotecontrolsettings->projector_magic_no, &buffer[index]);
 		index += 4;
-		mb_put_binary_float(MB_YES, installation->motion_roll, &buffer[index]);
+		mb_put_binary_float(MB_YES, remotecontrolsettings->steering_vertical, &buffer[index]);
 		index += 4;
-		mb_put_binary_float(MB_YES, installation->motion_pitch, &buffer[index]);
+		mb_put_binary_float(MB_YES, remotecontrolsettings->steering_horizontal, &buffer[index]);
 		index += 4;
-		mb_put_binary_float(MB_YES, installation->motion_heading, &buffer[index]);
+		mb_put_binary_float(MB_YES, remotecontrolsettings->beamwidth_vertical, &buffer[index]);
 		index += 4;
-		mb_put_binary_short(MB_YES, installation->motion_time_delay, &buffer[index]);
+		mb_put_binary_float(MB_YES, remotecontrolsettings->beamwidth_horizontal, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, remotecontrolsettings->focal_point, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, remotecontrolsettings->projector_weighting, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, remotecontrolsettings->projector_weighting_par, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, remotecontrolsettings->transmit_flags, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, remotecontrolsettings->hydrophone_magic_no, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, remotecontrolsettings->receive_weighting, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, remotecontrolsettings->receive_weighting_par, &buffer[index]);
+		index += 4;
+		mb_put_binary_int(MB_YES, remotecontrolsettings->receive_flags, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, remotecontrolsettings->range_minimum, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, remotecontrolsettings->range_maximum, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, remotecontrolsettings->depth_minimum, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, remotecontrolsettings->depth_maximum, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, remotecontrolsettings->absorption, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, remotecontrolsettings->sound_velocity, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, remotecontrolsettings->spreading, &buffer[index]);
+		index += 4;
+		mb_put_binary_short(MB_YES, remotecontrolsettings->reserved, &buffer[index]);
 		index += 2;
-		mb_put_binary_float(MB_YES, installation->position_x, &buffer[index]);
+		mb_put_binary_float(MB_YES, remotecontrolsettings->tx_offset_x, &buffer[index]);
 		index += 4;
-		mb_put_binary_float(MB_YES, installation->position_y, &buffer[index]);
+		mb_put_binary_float(MB_YES, remotecontrolsettings->tx_offset_y, &buffer[index]);
 		index += 4;
-		mb_put_binary_float(MB_YES, installation->position_z, &buffer[index]);
+		mb_put_binary_float(MB_YES, remotecontrolsettings->tx_offset_z, &buffer[index]);
 		index += 4;
-		mb_put_binary_short(MB_YES, installation->position_time_delay, &buffer[index]);
+		mb_put_binary_float(MB_YES, remotecontrolsettings->head_tilt_x, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, remotecontrolsettings->head_tilt_y, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, remotecontrolsettings->head_tilt_z, &buffer[index]);
+		index += 4;
+		mb_put_binary_short(MB_YES, remotecontrolsettings->ping_on_off, &buffer[index]);
 		index += 2;
-		mb_put_binary_float(MB_YES, installation->waterline_z, &buffer[index]);
+		buffer[index] = remotecontrolsettings->data_sample_types;
+		index++;
+		buffer[index] = remotecontrolsettings->projector_orientation;
+		index++;
+		mb_put_binary_short(MB_YES, remotecontrolsettings->beam_angle_mode, &buffer[index]);
+		index += 2;
+		mb_put_binary_short(MB_YES, remotecontrolsettings->r7kcenter_mode, &buffer[index]);
+		index += 2;
+		mb_put_binary_float(MB_YES, remotecontrolsettings->gate_depth_min, &buffer[index]);
+		index += 4;
+		mb_put_binary_float(MB_YES, remotecontrolsettings->gate_depth_max, &buffer[index]);
+		index += 4;
+		for (i = 0; i < 35; i++) {
+			mb_put_binary_short(MB_YES, remotecontrolsettings->reserved2[i], &buffer[index]);
+			index += 2;
+		}
+
+		/* reset the header size value */
+		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
+
+		/* now add the checksum */
+		checksum = 0;
+		for (i = 0; i < index; i++)
+			checksum += (unsigned char)buffer[i];
+		mb_put_binary_int(MB_YES, checksum, &buffer[index]);
 		index += 4;
 
+		/* check size */
+		if (*size != index) {
+			fprintf(stderr, "Bad size comparison: file:%s line:%d size:%d index:%d\n", __FILE__, __LINE__, *size, index);
+			status = MB_FAILURE;
+			*error = MB_ERROR_BAD_DATA;
+			*size = 0;
+		}
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
+		fprintf(stderr, "dbg2       size:       %d\n", *size);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:  %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbr_reson7kr_wr_reserved(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_reserved";
+	int status = MB_SUCCESS;
+	struct mbsys_reson7k_struct *store;
+	s7k_header *header;
+	s7kr_reserved *reserved;
+	unsigned int checksum;
+	int index;
+	char *buffer;
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
+		fprintf(stderr, "dbg2       bufferptr:  %p\n", (void *)bufferptr);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+	}
+
+	/* get pointer to raw data structure */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+	reserved = &(store->reserved);
+	header = &(reserved->header);
+
+/* print out the data to be output */
+#ifdef MBR_RESON7KR_DEBUG2
+	if (verbose > 0)
+#else
+	if (verbose >= 2)
+#endif
+		mbsys_reson7k_print_reserved(verbose, reserved, error);
+
+	/* figure out size of output record */
+	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
+	*size += R7KHDRSIZE_7kReserved;
+
+	/* allocate memory to write rest of record if necessary */
+	if (*bufferalloc < *size) {
+		status = mb_reallocd(verbose, __FILE__, __LINE__, *size, (void **)bufferptr, error);
+		if (status != MB_SUCCESS) {
+			*bufferalloc = 0;
+		}
+		else {
+			*bufferalloc = *size;
+		}
+	}
+
+	/* proceed to write if buffer allocated */
+	if (status == MB_SUCCESS) {
+		/* get buffer for writing */
+		buffer = (char *)*bufferptr;
+
+		/* insert the header */
+		index = 0;
+		status = mbr_reson7kr_wr_header(verbose, buffer, &index, header, error);
+
+		/* insert the data */
+		index = header->Offset + 4;
+		for (i = 0; i < R7KHDRSIZE_7kReserved; i++) {
+			buffer[index] = reserved->reserved[i];
+			index++;
+		}
+
 		/* reset the header size value */
 		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
 
@@ -17351,13 +19725,12 @@ int mbr_reson7kr_wr_installation(int verbose, int *bufferalloc, char **bufferptr
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_fileheader(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_fileheader";
+int mbr_reson7kr_wr_roll(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_roll";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_fileheader *fileheader;
-	s7kr_subsystem *subsystem;
+	s7kr_roll *roll;
 	unsigned int checksum;
 	int index;
 	char *buffer;
@@ -17376,40 +19749,8 @@ int mbr_reson7kr_wr_fileheader(int verbose, int *bufferalloc, char **bufferptr,
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	fileheader = &(store->fileheader);
-	header = &(fileheader->header);
-
-	/* make sure data are defined properly */
-	if (status == MB_SUCCESS && header->RecordType != R7KRECID_7kFileHeader) {
-
-		/* Reson 7k data record header information */
-		header->Version = 4;
-		header->Offset = 60;
-		header->SyncPattern = 0x0000ffff;
-		header->OffsetToOptionalData = 0;
-		header->OptionalDataIdentifier = 0;
-		header->s7kTime.Year = 0;
-		header->s7kTime.Day = 0;
-		header->s7kTime.Seconds = 0.0;
-		header->s7kTime.Hours = 0;
-		header->s7kTime.Minutes = 0;
-		header->Reserved = 0;
-		header->RecordType = R7KRECID_7kFileHeader;
-		header->DeviceId = 0;
-		header->Reserved2 = 0;
-		header->SystemEnumerator = 0;
-		header->DataSetNumber = 0;
-		header->RecordNumber = 0;
-		for (i = 0; i < 8; i++) {
-			header->PreviousRecord[i] = -1;
-			header->NextRecord[i] = -1;
-		}
-		header->Flags = 0;
-		header->Reserved3 = 0;
-		header->Reserved4 = 0;
-		header->FragmentedTotal = 0;
-		header->FragmentNumber = 0;
-	}
+	roll = &(store->roll);
+	header = &(roll->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -17417,13 +19758,11 @@ int mbr_reson7kr_wr_fileheader(int verbose, int *bufferalloc, char **bufferptr,
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_fileheader(verbose, fileheader, error);
+		mbsys_reson7k_print_roll(verbose, roll, error);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_7kFileHeader + R7KRDTSIZE_7kFileHeader;
-	for (i = 0; i < fileheader->number_subsystems; i++)
-		*size += 6;
+	*size += R7KHDRSIZE_7kRoll;
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -17447,45 +19786,8 @@ int mbr_reson7kr_wr_fileheader(int verbose, int *bufferalloc, char **bufferptr,
 
 		/* insert the data */
 		index = header->Offset + 4;
-		for (i = 0; i < 16; i++) {
-			buffer[index] = fileheader->file_identifier[i];
-			index++;
-		}
-		mb_put_binary_short(MB_YES, fileheader->version, &buffer[index]);
-		index += 2;
-		mb_put_binary_short(MB_YES, fileheader->reserved, &buffer[index]);
-		index += 2;
-		for (i = 0; i < 16; i++) {
-			buffer[index] = fileheader->session_identifier[i];
-			index++;
-		}
-		mb_put_binary_int(MB_YES, fileheader->record_data_size, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, fileheader->number_subsystems, &buffer[index]);
+		mb_put_binary_float(MB_YES, roll->roll, &buffer[index]);
 		index += 4;
-		for (i = 0; i < 64; i++) {
-			buffer[index] = fileheader->recording_name[i];
-			index++;
-		}
-		for (i = 0; i < 16; i++) {
-			buffer[index] = fileheader->recording_version[i];
-			index++;
-		}
-		for (i = 0; i < 64; i++) {
-			buffer[index] = fileheader->user_defined_name[i];
-			index++;
-		}
-		for (i = 0; i < 128; i++) {
-			buffer[index] = fileheader->notes[i];
-			index++;
-		}
-		for (i = 0; i < fileheader->number_subsystems; i++) {
-			subsystem = &(fileheader->subsystem[i]);
-			mb_put_binary_int(MB_YES, subsystem->device_identifier, &buffer[index]);
-			index += 4;
-			mb_put_binary_short(MB_YES, subsystem->system_enumerator, &buffer[index]);
-			index += 2;
-		}
 
 		/* reset the header size value */
 		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
@@ -17521,12 +19823,12 @@ int mbr_reson7kr_wr_fileheader(int verbose, int *bufferalloc, char **bufferptr,
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_systemeventmessage(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_systemeventmessage";
+int mbr_reson7kr_wr_pitch(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_pitch";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_systemeventmessage *systemeventmessage;
+	s7kr_pitch *pitch;
 	unsigned int checksum;
 	int index;
 	char *buffer;
@@ -17545,8 +19847,8 @@ int mbr_reson7kr_wr_systemeventmessage(int verbose, int *bufferalloc, char **buf
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	systemeventmessage = &(store->systemeventmessage);
-	header = &(systemeventmessage->header);
+	pitch = &(store->pitch);
+	header = &(pitch->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -17554,12 +19856,11 @@ int mbr_reson7kr_wr_systemeventmessage(int verbose, int *bufferalloc, char **buf
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_systemeventmessage(verbose, systemeventmessage, error);
+		mbsys_reson7k_print_pitch(verbose, pitch, error);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_7kSystemEventMessage;
-	*size += systemeventmessage->message_length;
+	*size += R7KHDRSIZE_7kPitch;
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -17583,20 +19884,8 @@ int mbr_reson7kr_wr_systemeventmessage(int verbose, int *bufferalloc, char **buf
 
 		/* insert the data */
 		index = header->Offset + 4;
-		mb_put_binary_long(MB_YES, systemeventmessage->serial_number, &buffer[index]);
-		index += 8;
-		mb_put_binary_short(MB_YES, systemeventmessage->event_id, &buffer[index]);
-		index += 2;
-		mb_put_binary_short(MB_YES, systemeventmessage->message_length, &buffer[index]);
-		index += 2;
-		mb_put_binary_short(MB_YES, systemeventmessage->event_identifier, &buffer[index]);
-		index += 2;
-
-		/* insert the data */
-		for (i = 0; i < systemeventmessage->message_length; i++) {
-			buffer[index] = systemeventmessage->message[i];
-			index++;
-		}
+		mb_put_binary_float(MB_YES, pitch->pitch, &buffer[index]);
+		index += 4;
 
 		/* reset the header size value */
 		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
@@ -17632,13 +19921,12 @@ int mbr_reson7kr_wr_systemeventmessage(int verbose, int *bufferalloc, char **buf
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_remotecontrolsettings(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size,
-                                          int *error) {
-	char *function_name = "mbr_reson7kr_wr_remotecontrolsettings";
+int mbr_reson7kr_wr_soundvelocity(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_soundvelocity";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_remotecontrolsettings *remotecontrolsettings;
+	s7kr_soundvelocity *soundvelocity;
 	unsigned int checksum;
 	int index;
 	char *buffer;
@@ -17657,8 +19945,8 @@ int mbr_reson7kr_wr_remotecontrolsettings(int verbose, int *bufferalloc, char **
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	remotecontrolsettings = &(store->remotecontrolsettings);
-	header = &(remotecontrolsettings->header);
+	soundvelocity = &(store->soundvelocity);
+	header = &(soundvelocity->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -17666,11 +19954,11 @@ int mbr_reson7kr_wr_remotecontrolsettings(int verbose, int *bufferalloc, char **
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_remotecontrolsettings(verbose, remotecontrolsettings, error);
+		mbsys_reson7k_print_soundvelocity(verbose, soundvelocity, error);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_7kRemoteControlSonarSettings;
+	*size += R7KHDRSIZE_7kSoundVelocity;
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -17694,110 +19982,8 @@ int mbr_reson7kr_wr_remotecontrolsettings(int verbose, int *bufferalloc, char **
 
 		/* insert the data */
 		index = header->Offset + 4;
-		mb_put_binary_long(MB_YES, remotecontrolsettings->serial_number, &buffer[index]);
-		index += 8;
-		mb_put_binary_int(MB_YES, remotecontrolsettings->ping_number, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, remotecontrolsettings->frequency, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, remotecontrolsettings->sample_rate, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, remotecontrolsettings->receiver_bandwidth, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, remotecontrolsettings->pulse_width, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, remotecontrolsettings->pulse_type, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, remotecontrolsettings->pulse_envelope, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, remotecontrolsettings->pulse_envelope_par, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, remotecontrolsettings->pulse_reserved, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, remotecontrolsettings->max_ping_rate, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, remotecontrolsettings->ping_period, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, remotecontrolsettings->range_selection, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, remotecontrolsettings->power_selection, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, remotecontrolsettings->gain_selection, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, remotecontrolsettings->control_flags, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, remotecontrolsettings->projector_magic_no, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, remotecontrolsettings->steering_vertical, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, remotecontrolsettings->steering_horizontal, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, remotecontrolsettings->beamwidth_vertical, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, remotecontrolsettings->beamwidth_horizontal, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, remotecontrolsettings->focal_point, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, remotecontrolsettings->projector_weighting, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, remotecontrolsettings->projector_weighting_par, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, remotecontrolsettings->transmit_flags, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, remotecontrolsettings->hydrophone_magic_no, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, remotecontrolsettings->receive_weighting, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, remotecontrolsettings->receive_weighting_par, &buffer[index]);
-		index += 4;
-		mb_put_binary_int(MB_YES, remotecontrolsettings->receive_flags, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, remotecontrolsettings->range_minimum, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, remotecontrolsettings->range_maximum, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, remotecontrolsettings->depth_minimum, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, remotecontrolsettings->depth_maximum, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, remotecontrolsettings->absorption, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, remotecontrolsettings->sound_velocity, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, remotecontrolsettings->spreading, &buffer[index]);
-		index += 4;
-		mb_put_binary_short(MB_YES, remotecontrolsettings->reserved, &buffer[index]);
-		index += 2;
-		mb_put_binary_float(MB_YES, remotecontrolsettings->tx_offset_x, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, remotecontrolsettings->tx_offset_y, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, remotecontrolsettings->tx_offset_z, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, remotecontrolsettings->head_tilt_x, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, remotecontrolsettings->head_tilt_y, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, remotecontrolsettings->head_tilt_z, &buffer[index]);
-		index += 4;
-		mb_put_binary_short(MB_YES, remotecontrolsettings->ping_on_off, &buffer[index]);
-		index += 2;
-		buffer[index] = remotecontrolsettings->data_sample_types;
-		index++;
-		buffer[index] = remotecontrolsettings->projector_orientation;
-		index++;
-		mb_put_binary_short(MB_YES, remotecontrolsettings->beam_angle_mode, &buffer[index]);
-		index += 2;
-		mb_put_binary_short(MB_YES, remotecontrolsettings->r7kcenter_mode, &buffer[index]);
-		index += 2;
-		mb_put_binary_float(MB_YES, remotecontrolsettings->gate_depth_min, &buffer[index]);
-		index += 4;
-		mb_put_binary_float(MB_YES, remotecontrolsettings->gate_depth_max, &buffer[index]);
+		mb_put_binary_float(MB_YES, soundvelocity->soundvelocity, &buffer[index]);
 		index += 4;
-		for (i = 0; i < 35; i++) {
-			mb_put_binary_short(MB_YES, remotecontrolsettings->reserved2[i], &buffer[index]);
-			index += 2;
-		}
 
 		/* reset the header size value */
 		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
@@ -17833,12 +20019,12 @@ int mbr_reson7kr_wr_remotecontrolsettings(int verbose, int *bufferalloc, char **
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_reserved(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_reserved";
+int mbr_reson7kr_wr_absorptionloss(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_absorptionloss";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_reserved *reserved;
+	s7kr_absorptionloss *absorptionloss;
 	unsigned int checksum;
 	int index;
 	char *buffer;
@@ -17857,8 +20043,8 @@ int mbr_reson7kr_wr_reserved(int verbose, int *bufferalloc, char **bufferptr, vo
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	reserved = &(store->reserved);
-	header = &(reserved->header);
+	absorptionloss = &(store->absorptionloss);
+	header = &(absorptionloss->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -17866,11 +20052,11 @@ int mbr_reson7kr_wr_reserved(int verbose, int *bufferalloc, char **bufferptr, vo
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_reserved(verbose, reserved, error);
+		mbsys_reson7k_print_absorptionloss(verbose, absorptionloss, error);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_7kReserved;
+	*size += R7KHDRSIZE_7kAbsorptionLoss;
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -17894,10 +20080,8 @@ int mbr_reson7kr_wr_reserved(int verbose, int *bufferalloc, char **bufferptr, vo
 
 		/* insert the data */
 		index = header->Offset + 4;
-		for (i = 0; i < R7KHDRSIZE_7kReserved; i++) {
-			buffer[index] = reserved->reserved[i];
-			index++;
-		}
+		mb_put_binary_float(MB_YES, absorptionloss->absorptionloss, &buffer[index]);
+		index += 4;
 
 		/* reset the header size value */
 		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
@@ -17933,12 +20117,12 @@ int mbr_reson7kr_wr_reserved(int verbose, int *bufferalloc, char **bufferptr, vo
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_roll(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_roll";
+int mbr_reson7kr_wr_spreadingloss(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
+	char *function_name = "mbr_reson7kr_wr_spreadingloss";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7k_header *header;
-	s7kr_roll *roll;
+	s7kr_spreadingloss *spreadingloss;
 	unsigned int checksum;
 	int index;
 	char *buffer;
@@ -17957,8 +20141,8 @@ int mbr_reson7kr_wr_roll(int verbose, int *bufferalloc, char **bufferptr, void *
 
 	/* get pointer to raw data structure */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	roll = &(store->roll);
-	header = &(roll->header);
+	spreadingloss = &(store->spreadingloss);
+	header = &(spreadingloss->header);
 
 /* print out the data to be output */
 #ifdef MBR_RESON7KR_DEBUG2
@@ -17966,11 +20150,11 @@ int mbr_reson7kr_wr_roll(int verbose, int *bufferalloc, char **bufferptr, void *
 #else
 	if (verbose >= 2)
 #endif
-		mbsys_reson7k_print_roll(verbose, roll, error);
+		mbsys_reson7k_print_spreadingloss(verbose, spreadingloss, error);
 
 	/* figure out size of output record */
 	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_7kRoll;
+	*size += R7KHDRSIZE_7kSpreadingLoss;
 
 	/* allocate memory to write rest of record if necessary */
 	if (*bufferalloc < *size) {
@@ -17994,7 +20178,7 @@ int mbr_reson7kr_wr_roll(int verbose, int *bufferalloc, char **bufferptr, void *
 
 		/* insert the data */
 		index = header->Offset + 4;
-		mb_put_binary_float(MB_YES, roll->roll, &buffer[index]);
+		mb_put_binary_float(MB_YES, spreadingloss->spreadingloss, &buffer[index]);
 		index += 4;
 
 		/* reset the header size value */
@@ -18031,113 +20215,578 @@ int mbr_reson7kr_wr_roll(int verbose, int *bufferalloc, char **bufferptr, void *
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_pitch(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_pitch";
+int mbr_reson7kr_scan_ancillary(int verbose, void *mbio_ptr, void *preprocess_pars_ptr, int *nrecord, int *error) {
+	char *function_name = "mbr_reson7kr_scan_ancillary";
 	int status = MB_SUCCESS;
+	struct mb_io_struct *mb_io_ptr;
+	struct mb_preprocess_struct *pars;
 	struct mbsys_reson7k_struct *store;
-	s7k_header *header;
-	s7kr_pitch *pitch;
-	unsigned int checksum;
-	int index;
+	s7kr_position *position;
+	s7kr_navigation *navigation;
+	s7kr_attitude *attitude;
+	s7kr_rollpitchheave *rollpitchheave;
+	s7kr_heading *dheading;
+	s7kr_customattitude *customattitude;
+	s7kr_altitude *altitude;
+	s7kr_depth *depth;
+	s7kr_soundvelocity *soundvelocity;
+	FILE *mbfp;
+	off_t start;
+	char **bufferptr;
+	char **buffersaveptr;
 	char *buffer;
-	int i;
+	int *bufferalloc;
+	size_t read_len;
+	int recordid, deviceid, size;
+	unsigned short enumerator;
+	double time_d;
+	int deall_error = MB_ERROR_NO_ERROR;
+	int i, n;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
 		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
-		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
-		fprintf(stderr, "dbg2       bufferptr:  %p\n", (void *)bufferptr);
-		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       verbose:             %d\n", verbose);
+		fprintf(stderr, "dbg2       mbio_ptr:            %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       preprocess_pars_ptr: %p\n", (void *)preprocess_pars_ptr);
 	}
 
-	/* get pointer to raw data structure */
-	store = (struct mbsys_reson7k_struct *)store_ptr;
-	pitch = &(store->pitch);
-	header = &(pitch->header);
+	/* get pointers to mbio descriptor and the preprocessing parameters */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+	pars = (struct mb_preprocess_struct *)preprocess_pars_ptr;
+	mbfp = mb_io_ptr->mbfp;
+	bufferptr = (char **)&mb_io_ptr->saveptr1;
+	buffersaveptr = (char **)&mb_io_ptr->saveptr2;
+	bufferalloc = (int *)&mb_io_ptr->save6;
+	buffer = (char *)*bufferptr;
+	*nrecord = 0;
+	*error = MB_ERROR_NO_ERROR;
 
-/* print out the data to be output */
-#ifdef MBR_RESON7KR_DEBUG2
-	if (verbose > 0)
-#else
-	if (verbose >= 2)
-#endif
-		mbsys_reson7k_print_pitch(verbose, pitch, error);
+	/* the scan leaves the file where it started, so that the pings can
+	    then be read as usual */
+	start = ftello(mbfp);
+
+	/* decode the ancillary records into a private store so that any ping
+	    being read is left alone */
+	store = NULL;
+	status = mbsys_reson7k_alloc(verbose, mbio_ptr, (void **)&store, error);
+
+	/* read the record headers, decoding the ancillary records and seeking
+	    past everything else - samples are appended to the time series
+	    already held, which are only grown past the capacities recorded in
+	    the n_*_alloc fields */
+	while (status == MB_SUCCESS) {
+		read_len = (size_t)MBSYS_RESON7K_VERSIONSYNCSIZE;
+		status = mb_fileio_get(verbose, mbio_ptr, buffer, &read_len, error);
+
+		/* if not a good header read a byte at a time until one is found */
+		while (status == MB_SUCCESS &&
+		       mbr_reson7kr_chk_header(verbose, mbio_ptr, buffer, &recordid, &deviceid, &enumerator, &size) != MB_SUCCESS) {
+			for (i = 0; i < MBSYS_RESON7K_VERSIONSYNCSIZE - 1; i++)
+				buffer[i] = buffer[i + 1];
+			read_len = (size_t)1;
+			status = mb_fileio_get(verbose, mbio_ptr, &buffer[MBSYS_RESON7K_VERSIONSYNCSIZE - 1], &read_len, error);
+		}
+		if (status != MB_SUCCESS)
+			break;
+
+		/* skip records that are not needed */
+		if (recordid != R7KRECID_Position && recordid != R7KRECID_Navigation && recordid != R7KRECID_Attitude &&
+		    recordid != R7KRECID_RollPitchHeave && recordid != R7KRECID_Heading && recordid != R7KRECID_CustomAttitude &&
+		    recordid != R7KRECID_Altitude && recordid != R7KRECID_Depth && recordid != R7KRECID_7kSoundVelocity) {
+			if (fseeko(mbfp, (off_t)(size - MBSYS_RESON7K_VERSIONSYNCSIZE), SEEK_CUR) != 0) {
+				status = MB_FAILURE;
+				*error = MB_ERROR_EOF;
+			}
+			continue;
+		}
 
-	/* figure out size of output record */
-	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_7kPitch;
+		/* read the rest of the record - the saved record buffer is kept
+		    the same size as the read buffer */
+		if (*bufferalloc < size) {
+			status = mb_reallocd(verbose, __FILE__, __LINE__, size, (void **)bufferptr, error);
+			if (status == MB_SUCCESS)
+				status = mb_reallocd(verbose, __FILE__, __LINE__, size, (void **)buffersaveptr, error);
+			if (status != MB_SUCCESS) {
+				*bufferalloc = 0;
+				break;
+			}
+			*bufferalloc = size;
+			buffer = (char *)*bufferptr;
+		}
+		read_len = (size_t)(size - MBSYS_RESON7K_VERSIONSYNCSIZE);
+		status = mb_fileio_get(verbose, mbio_ptr, &buffer[MBSYS_RESON7K_VERSIONSYNCSIZE], &read_len, error);
+		if (status != MB_SUCCESS)
+			break;
+		(*nrecord)++;
 
-	/* allocate memory to write rest of record if necessary */
-	if (*bufferalloc < *size) {
-		status = mb_reallocd(verbose, __FILE__, __LINE__, *size, (void **)bufferptr, error);
-		if (status != MB_SUCCESS) {
-			*bufferalloc = 0;
+		/* decode the record and append its samples */
+		if (recordid == R7KRECID_Position) {
+			status = mbr_reson7kr_rd_position(verbose, buffer, (void *)store, error);
+			position = &(store->position);
+			if (status == MB_SUCCESS)
+				status = mbr_reson7kr_scan_grow(verbose, pars->n_nav + 1, &pars->n_nav_alloc, &pars->nav_time_d, &pars->nav_lon,
+				                                &pars->nav_lat, &pars->nav_speed, NULL, error);
+			if (status == MB_SUCCESS) {
+				pars->nav_time_d[pars->n_nav] = store->time_d;
+				pars->nav_lon[pars->n_nav] = RTD * position->longitude;
+				pars->nav_lat[pars->n_nav] = RTD * position->latitude;
+				pars->nav_speed[pars->n_nav] = 0.0;
+				pars->n_nav++;
+			}
 		}
-		else {
-			*bufferalloc = *size;
+		else if (recordid == R7KRECID_Navigation) {
+			status = mbr_reson7kr_rd_navigation(verbose, buffer, (void *)store, error);
+			navigation = &(store->navigation);
+			if (status == MB_SUCCESS)
+				status = mbr_reson7kr_scan_grow(verbose, pars->n_nav + 1, &pars->n_nav_alloc, &pars->nav_time_d, &pars->nav_lon,
+				                                &pars->nav_lat, &pars->nav_speed, NULL, error);
+			if (status == MB_SUCCESS)
+				status = mbr_reson7kr_scan_grow(verbose, pars->n_heading + 1, &pars->n_heading_alloc, &pars->heading_time_d,
+				                                &pars->heading_heading, NULL, NULL, NULL, error);
+			if (status == MB_SUCCESS) {
+				pars->nav_time_d[pars->n_nav] = store->time_d;
+				pars->nav_lon[pars->n_nav] = RTD * navigation->longitude;
+				pars->nav_lat[pars->n_nav] = RTD * navigation->latitude;
+				pars->nav_speed[pars->n_nav] = 3.6 * navigation->speed;
+				pars->n_nav++;
+				pars->heading_time_d[pars->n_heading] = store->time_d;
+				pars->heading_heading[pars->n_heading] = RTD * navigation->heading;
+				pars->n_heading++;
+			}
+		}
+		else if (recordid == R7KRECID_Attitude || recordid == R7KRECID_CustomAttitude) {
+			if (recordid == R7KRECID_Attitude) {
+				status = mbr_reson7kr_rd_attitude(verbose, buffer, (void *)store, error);
+				attitude = &(store->attitude);
+				n = attitude->n;
+			}
+			else {
+				status = mbr_reson7kr_rd_customattitude(verbose, buffer, (void *)store, error);
+				customattitude = &(store->customattitude);
+				n = customattitude->n;
+			}
+			if (status == MB_SUCCESS)
+				status = mbr_reson7kr_scan_grow(verbose, pars->n_attitude + n, &pars->n_attitude_alloc, &pars->attitude_time_d,
+				                                &pars->attitude_roll, &pars->attitude_pitch, &pars->attitude_heave, NULL, error);
+			if (status == MB_SUCCESS)
+				status = mbr_reson7kr_scan_grow(verbose, pars->n_heading + n, &pars->n_heading_alloc, &pars->heading_time_d,
+				                                &pars->heading_heading, NULL, NULL, NULL, error);
+			for (i = 0; i < n && status == MB_SUCCESS; i++) {
+				if (recordid == R7KRECID_Attitude) {
+					time_d = store->time_d + 0.001 * ((double)attitude->delta_time[i]);
+					pars->attitude_roll[pars->n_attitude] = RTD * attitude->roll[i];
+					pars->attitude_pitch[pars->n_attitude] = RTD * attitude->pitch[i];
+					pars->attitude_heave[pars->n_attitude] = attitude->heave[i];
+					pars->heading_heading[pars->n_heading] = RTD * attitude->heading[i];
+				}
+				else {
+					time_d = store->time_d + ((double)i) / ((double)customattitude->frequency);
+					pars->attitude_roll[pars->n_attitude] = RTD * customattitude->roll[i];
+					pars->attitude_pitch[pars->n_attitude] = RTD * customattitude->pitch[i];
+					pars->attitude_heave[pars->n_attitude] = customattitude->heave[i];
+					pars->heading_heading[pars->n_heading] = RTD * customattitude->heading[i];
+				}
+				pars->attitude_time_d[pars->n_attitude] = time_d;
+				pars->n_attitude++;
+				pars->heading_time_d[pars->n_heading] = time_d;
+				pars->n_heading++;
+			}
+		}
+		else if (recordid == R7KRECID_RollPitchHeave) {
+			status = mbr_reson7kr_rd_rollpitchheave(verbose, buffer, (void *)store, error);
+			rollpitchheave = &(store->rollpitchheave);
+			if (status == MB_SUCCESS)
+				status = mbr_reson7kr_scan_grow(verbose, pars->n_attitude + 1, &pars->n_attitude_alloc, &pars->attitude_time_d,
+				                                &pars->attitude_roll, &pars->attitude_pitch, &pars->attitude_heave, NULL, error);
+			if (status == MB_SUCCESS) {
+				pars->attitude_time_d[pars->n_attitude] = store->time_d;
+				pars->attitude_roll[pars->n_attitude] = RTD * rollpitchheave->roll;
+				pars->attitude_pitch[pars->n_attitude] = RTD * rollpitchheave->pitch;
+				pars->attitude_heave[pars->n_attitude] = rollpitchheave->heave;
+				pars->n_attitude++;
+			}
+		}
+		else if (recordid == R7KRECID_Heading) {
+			status = mbr_reson7kr_rd_heading(verbose, buffer, (void *)store, error);
+			dheading = &(store->heading);
+			if (status == MB_SUCCESS)
+				status = mbr_reson7kr_scan_grow(verbose, pars->n_heading + 1, &pars->n_heading_alloc, &pars->heading_time_d,
+				                                &pars->heading_heading, NULL, NULL, NULL, error);
+			if (status == MB_SUCCESS) {
+				pars->heading_time_d[pars->n_heading] = store->time_d;
+				pars->heading_heading[pars->n_heading] = RTD * dheading->heading;
+				pars->n_heading++;
+			}
+		}
+		else if (recordid == R7KRECID_Altitude) {
+			status = mbr_reson7kr_rd_altitude(verbose, buffer, (void *)store, error);
+			altitude = &(store->altitude);
+			if (status == MB_SUCCESS)
+				status = mbr_reson7kr_scan_grow(verbose, pars->n_altitude + 1, &pars->n_altitude_alloc, &pars->altitude_time_d,
+				                                &pars->altitude_altitude, NULL, NULL, NULL, error);
+			if (status == MB_SUCCESS) {
+				pars->altitude_time_d[pars->n_altitude] = store->time_d;
+				pars->altitude_altitude[pars->n_altitude] = altitude->altitude;
+				pars->n_altitude++;
+			}
+		}
+		else if (recordid == R7KRECID_Depth) {
+			/* only depth to the sensor, not water depth */
+			status = mbr_reson7kr_rd_depth(verbose, buffer, (void *)store, error);
+			depth = &(store->depth);
+			if (status == MB_SUCCESS && depth->descriptor == 0 && depth->depth != 0.0) {
+				status = mbr_reson7kr_scan_grow(verbose, pars->n_sensordepth + 1, &pars->n_sensordepth_alloc,
+				                                &pars->sensordepth_time_d, &pars->sensordepth_sensordepth, NULL, NULL, NULL,
+				                                error);
+				if (status == MB_SUCCESS) {
+					pars->sensordepth_time_d[pars->n_sensordepth] = store->time_d;
+					pars->sensordepth_sensordepth[pars->n_sensordepth] = depth->depth;
+					pars->n_sensordepth++;
+				}
+			}
+		}
+		else if (recordid == R7KRECID_7kSoundVelocity) {
+			status = mbr_reson7kr_rd_soundvelocity(verbose, buffer, (void *)store, error);
+			soundvelocity = &(store->soundvelocity);
+			if (status == MB_SUCCESS)
+				status = mbr_reson7kr_scan_grow(verbose, pars->n_soundspeed + 1, &pars->n_soundspeed_alloc,
+				                                &pars->soundspeed_time_d, &pars->soundspeed_soundspeed, NULL, NULL, NULL,
+				                                error);
+			if (status == MB_SUCCESS) {
+				pars->soundspeed_time_d[pars->n_soundspeed] = store->time_d;
+				pars->soundspeed_soundspeed[pars->n_soundspeed] = soundvelocity->soundvelocity;
+				pars->n_soundspeed++;
+			}
 		}
 	}
 
-	/* proceed to write if buffer allocated */
-	if (status == MB_SUCCESS) {
-		/* get buffer for writing */
-		buffer = (char *)*bufferptr;
+	/* reaching the end of the file is success */
+	if (*error == MB_ERROR_EOF) {
+		status = MB_SUCCESS;
+		*error = MB_ERROR_NO_ERROR;
+	}
 
-		/* insert the header */
-		index = 0;
-		status = mbr_reson7kr_wr_header(verbose, buffer, &index, header, error);
+	/* return to where the scan started */
+	fseeko(mbfp, start, SEEK_SET);
+	if (store != NULL)
+		mbsys_reson7k_deall(verbose, mbio_ptr, (void **)&store, &deall_error);
 
-		/* insert the data */
-		index = header->Offset + 4;
-		mb_put_binary_float(MB_YES, pitch->pitch, &buffer[index]);
-		index += 4;
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       nrecord:        %d\n", *nrecord);
+		fprintf(stderr, "dbg2       n_nav:          %d\n", pars->n_nav);
+		fprintf(stderr, "dbg2       n_sensordepth:  %d\n", pars->n_sensordepth);
+		fprintf(stderr, "dbg2       n_heading:      %d\n", pars->n_heading);
+		fprintf(stderr, "dbg2       n_altitude:     %d\n", pars->n_altitude);
+		fprintf(stderr, "dbg2       n_attitude:     %d\n", pars->n_attitude);
+		fprintf(stderr, "dbg2       n_soundspeed:   %d\n", pars->n_soundspeed);
+		fprintf(stderr, "dbg2       error:          %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:         %d\n", status);
+	}
 
-		/* reset the header size value */
-		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbr_reson7kr_scan_grow(int verbose, int n, int *nalloc, double **array0, double **array1, double **array2,
+                           double **array3, double **array4, int *error) {
+	int status = MB_SUCCESS;
+	int nalloc_new;
+	size_t size;
+
+	/* grow the arrays of a time series geometrically so that appending
+	    samples one at a time stays cheap - the recorded capacity is only
+	    raised once every array has been grown, so on failure it still
+	    describes arrays that are at least that large */
+	if (n > *nalloc) {
+		nalloc_new = MAX(n + MBSYS_RESON7K_SCAN_ALLOC, 2 * (*nalloc));
+		size = (size_t)nalloc_new * sizeof(double);
+		if (status == MB_SUCCESS && array0 != NULL)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, size, (void **)array0, error);
+		if (status == MB_SUCCESS && array1 != NULL)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, size, (void **)array1, error);
+		if (status == MB_SUCCESS && array2 != NULL)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, size, (void **)array2, error);
+		if (status == MB_SUCCESS && array3 != NULL)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, size, (void **)array3, error);
+		if (status == MB_SUCCESS && array4 != NULL)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, size, (void **)array4, error);
+		if (status == MB_SUCCESS)
+			*nalloc = nalloc_new;
+	}
 
-		/* now add the checksum */
-		checksum = 0;
-		for (i = 0; i < index; i++)
-			checksum += (unsigned char)buffer[i];
-		mb_put_binary_int(MB_YES, checksum, &buffer[index]);
-		index += 4;
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbr_reson7kr_rd_fileindex(int verbose, void *mbio_ptr, int *error) {
+	char *function_name = "mbr_reson7kr_rd_fileindex";
+	int status = MB_SUCCESS;
+	struct mb_io_struct *mb_io_ptr;
+	struct mbsys_reson7k_struct *ostore;
+	s7k_fileindex *fileindex;
+	s7k_header header;
+	s7k_time s7ktime;
+	FILE *mbfp;
+	off_t start;
+	off_t offset;
+	char **bufferptr;
+	char **buffersaveptr;
+	char *buffer;
+	int *bufferalloc;
+	size_t read_len;
+	int recordid, deviceid, size;
+	unsigned short enumerator;
+	u32 catalog_size;
+	u64 catalog_offset;
+	u32 records_n;
+	u64 record_offset;
+	u16 record_type;
+	int time_j[5], time_i[7];
+	int index;
+	int i, n;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+	}
+
+	/* get pointers to mbio descriptor and the index held in the internal store */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+	ostore = (struct mbsys_reson7k_struct *)mb_io_ptr->store_data;
+	fileindex = &(ostore->fileindex);
+	mbfp = mb_io_ptr->mbfp;
+	bufferptr = (char **)&mb_io_ptr->saveptr1;
+	buffersaveptr = (char **)&mb_io_ptr->saveptr2;
+	bufferalloc = (int *)&mb_io_ptr->save6;
+	buffer = (char *)*bufferptr;
+	*error = MB_ERROR_NO_ERROR;
+
+	/* the index is loaded once for each file, and loading it leaves the
+	    file where it was */
+	if (fileindex->source == MBSYS_RESON7K_FILEINDEX_NONE) {
+		start = ftello(mbfp);
+		fileindex->n = 0;
+
+		/* get the location of the file catalog from the file header */
+		catalog_size = 0;
+		catalog_offset = 0;
+		if (fseeko(mbfp, (off_t)0, SEEK_SET) == 0) {
+			read_len = (size_t)MBSYS_RESON7K_VERSIONSYNCSIZE;
+			status = mb_fileio_get(verbose, mbio_ptr, buffer, &read_len, error);
+			if (status == MB_SUCCESS &&
+			    mbr_reson7kr_chk_header(verbose, mbio_ptr, buffer, &recordid, &deviceid, &enumerator, &size) == MB_SUCCESS &&
+			    recordid == R7KRECID_7kFileHeader && size <= *bufferalloc) {
+				read_len = (size_t)(size - MBSYS_RESON7K_VERSIONSYNCSIZE);
+				status = mb_fileio_get(verbose, mbio_ptr, &buffer[MBSYS_RESON7K_VERSIONSYNCSIZE], &read_len, error);
+				index = 0;
+				if (status == MB_SUCCESS)
+					status = mbr_reson7kr_rd_header(verbose, buffer, &index, &header, error);
+				if (status == MB_SUCCESS && header.OffsetToOptionalData > 0 &&
+				    header.Size >= header.OffsetToOptionalData + R7KOPTSIZE_7kFileHeader) {
+					index = header.OffsetToOptionalData;
+					mb_get_binary_int(MB_YES, &buffer[index], &catalog_size);
+					index += 4;
+					mb_get_binary_long(MB_YES, &buffer[index], (mb_s_long *)&catalog_offset);
+				}
+			}
+		}
+
+		/* read the index from the file catalog if present */
+		status = MB_SUCCESS;
+		*error = MB_ERROR_NO_ERROR;
+		if (catalog_offset > 0
+		    && catalog_size >= MBSYS_RESON7K_RECORDHEADER_SIZE + R7KHDRSIZE_7kFileCatalogRecord + MBSYS_RESON7K_RECORDTAIL_SIZE
+		    && fseeko(mbfp, (off_t)catalog_offset, SEEK_SET) == 0) {
+			read_len = (size_t)MBSYS_RESON7K_VERSIONSYNCSIZE;
+			status = mb_fileio_get(verbose, mbio_ptr, buffer, &read_len, error);
+			if (status == MB_SUCCESS &&
+			    mbr_reson7kr_chk_header(verbose, mbio_ptr, buffer, &recordid, &deviceid, &enumerator, &size) == MB_SUCCESS &&
+			    recordid == R7KRECID_7kFileCatalogRecord && size == (int)catalog_size) {
+				if (*bufferalloc < size) {
+					status = mb_reallocd(verbose, __FILE__, __LINE__, size, (void **)bufferptr, error);
+					if (status == MB_SUCCESS)
+						status = mb_reallocd(verbose, __FILE__, __LINE__, size, (void **)buffersaveptr, error);
+					if (status == MB_SUCCESS)
+						*bufferalloc = size;
+					else
+						*bufferalloc = 0;
+					buffer = (char *)*bufferptr;
+				}
+				if (status == MB_SUCCESS) {
+					read_len = (size_t)(size - MBSYS_RESON7K_VERSIONSYNCSIZE);
+					status = mb_fileio_get(verbose, mbio_ptr, &buffer[MBSYS_RESON7K_VERSIONSYNCSIZE], &read_len, error);
+				}
+				index = 0;
+				if (status == MB_SUCCESS)
+					status = mbr_reson7kr_rd_header(verbose, buffer, &index, &header, error);
+
+				/* the record type header holds its size, the version, the
+				    number of records and a reserved value */
+				records_n = 0;
+				if (status == MB_SUCCESS) {
+					index = header.Offset + 4 + 6;
+					mb_get_binary_int(MB_YES, &buffer[index], &records_n);
+					index += 8;
+					if (records_n > (u32)(size / R7KRDTSIZE_7kFileCatalogRecord) ||
+					    index + (int)records_n * R7KRDTSIZE_7kFileCatalogRecord + MBSYS_RESON7K_RECORDTAIL_SIZE > size)
+						records_n = 0;
+				}
+				if (records_n > 0)
+					status = mbsys_reson7k_alloc_fileindex(verbose, fileindex, (int)records_n, error);
+
+				/* extract the entries */
+				if (status == MB_SUCCESS && records_n > 0) {
+					for (i = 0; i < (int)records_n; i++) {
+						index += 4;
+						mb_get_binary_long(MB_YES, &buffer[index], (mb_s_long *)&record_offset);
+						index += 8;
+						mb_get_binary_short(MB_YES, &buffer[index], &record_type);
+						index += 6;
+						mb_get_binary_short(MB_YES, &buffer[index], &(s7ktime.Year));
+						index += 2;
+						mb_get_binary_short(MB_YES, &buffer[index], &(s7ktime.Day));
+						index += 2;
+						mb_get_binary_float(MB_YES, &buffer[index], &(s7ktime.Seconds));
+						index += 4;
+						s7ktime.Hours = (u8)buffer[index];
+						index++;
+						s7ktime.Minutes = (u8)buffer[index];
+						index++;
+						index += 20;
+						fileindex->offset[i] = record_offset;
+						fileindex->recordid[i] = (int)record_type;
+						fileindex->time_d[i] = 0.0;
+						if (s7ktime.Year > 0) {
+							time_j[0] = s7ktime.Year;
+							time_j[1] = s7ktime.Day;
+							time_j[2] = 60 * s7ktime.Hours + s7ktime.Minutes;
+							time_j[3] = (int)s7ktime.Seconds;
+							time_j[4] = (int)(1000000 * (s7ktime.Seconds - time_j[3]));
+							mb_get_itime(verbose, time_j, time_i);
+							mb_get_time(verbose, time_i, &(fileindex->time_d[i]));
+						}
+					}
+					fileindex->n = (int)records_n;
+					fileindex->source = MBSYS_RESON7K_FILEINDEX_CATALOG;
+				}
+			}
+		}
+
+		/* otherwise build the index by reading the record headers and
+		    seeking past the rest of each record */
+		if (fileindex->source == MBSYS_RESON7K_FILEINDEX_NONE) {
+			status = MB_SUCCESS;
+			*error = MB_ERROR_NO_ERROR;
+			n = 0;
+			if (fseeko(mbfp, (off_t)0, SEEK_SET) != 0) {
+				status = MB_FAILURE;
+				*error = MB_ERROR_EOF;
+			}
+			while (status == MB_SUCCESS) {
+				read_len = (size_t)MBSYS_RESON7K_VERSIONSYNCSIZE;
+				status = mb_fileio_get(verbose, mbio_ptr, buffer, &read_len, error);
+
+				/* if not a good header read a byte at a time until one is found */
+				while (status == MB_SUCCESS &&
+				       mbr_reson7kr_chk_header(verbose, mbio_ptr, buffer, &recordid, &deviceid, &enumerator, &size) !=
+				           MB_SUCCESS) {
+					for (i = 0; i < MBSYS_RESON7K_VERSIONSYNCSIZE - 1; i++)
+						buffer[i] = buffer[i + 1];
+					read_len = (size_t)1;
+					status = mb_fileio_get(verbose, mbio_ptr, &buffer[MBSYS_RESON7K_VERSIONSYNCSIZE - 1], &read_len, error);
+				}
+				if (status != MB_SUCCESS)
+					break;
+
+				/* add the record to the index */
+				offset = ftello(mbfp) - MBSYS_RESON7K_VERSIONSYNCSIZE;
+				index = 0;
+				mbr_reson7kr_rd_header(verbose, buffer, &index, &header, error);
+				status = mbsys_reson7k_alloc_fileindex(verbose, fileindex, n + 1, error);
+				if (status == MB_SUCCESS) {
+					fileindex->offset[n] = (u64)offset;
+					fileindex->recordid[n] = recordid;
+					fileindex->time_d[n] = 0.0;
+					if (header.s7kTime.Year > 0) {
+						time_j[0] = header.s7kTime.Year;
+						time_j[1] = header.s7kTime.Day;
+						time_j[2] = 60 * header.s7kTime.Hours + header.s7kTime.Minutes;
+						time_j[3] = (int)header.s7kTime.Seconds;
+						time_j[4] = (int)(1000000 * (header.s7kTime.Seconds - time_j[3]));
+						mb_get_itime(verbose, time_j, time_i);
+						mb_get_time(verbose, time_i, &(fileindex->time_d[n]));
+					}
+					n++;
+				}
+
+				/* skip the rest of the record */
+				if (status == MB_SUCCESS && fseeko(mbfp, (off_t)(size - MBSYS_RESON7K_VERSIONSYNCSIZE), SEEK_CUR) != 0) {
+					status = MB_FAILURE;
+					*error = MB_ERROR_EOF;
+				}
+			}
+
+			/* reaching the end of the file is success */
+			if (*error == MB_ERROR_EOF) {
+				status = MB_SUCCESS;
+				*error = MB_ERROR_NO_ERROR;
+			}
+			if (status == MB_SUCCESS) {
+				fileindex->n = n;
+				fileindex->source = MBSYS_RESON7K_FILEINDEX_SCAN;
+			}
+		}
 
-		/* check size */
-		if (*size != index) {
-			fprintf(stderr, "Bad size comparison: file:%s line:%d size:%d index:%d\n", __FILE__, __LINE__, *size, index);
-			status = MB_FAILURE;
-			*error = MB_ERROR_BAD_DATA;
-			*size = 0;
+		/* the latest time up to each record orders the index - records
+		    without a time take that of the records before them */
+		for (i = 0; i < fileindex->n; i++) {
+			if (i == 0)
+				fileindex->time_max[i] = fileindex->time_d[i];
+			else
+				fileindex->time_max[i] = MAX(fileindex->time_max[i - 1], fileindex->time_d[i]);
 		}
+
+		/* return to where the file was */
+		fseeko(mbfp, start, SEEK_SET);
 	}
 
 	/* print output debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
-		fprintf(stderr, "dbg2       size:       %d\n", *size);
+		fprintf(stderr, "dbg2       source:     %d\n", fileindex->source);
+		fprintf(stderr, "dbg2       n:          %d\n", fileindex->n);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
-		fprintf(stderr, "dbg2       status:  %d\n", status);
+		fprintf(stderr, "dbg2       status:     %d\n", status);
 	}
 
 	/* return status */
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_soundvelocity(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_soundvelocity";
+int mbr_reson7kr_seek_record(int verbose, void *mbio_ptr, int irecord, int *error) {
+	char *function_name = "mbr_reson7kr_seek_record";
 	int status = MB_SUCCESS;
-	struct mbsys_reson7k_struct *store;
-	s7k_header *header;
-	s7kr_soundvelocity *soundvelocity;
-	unsigned int checksum;
-	int index;
-	char *buffer;
+	struct mb_io_struct *mb_io_ptr;
+	struct mbsys_reson7k_struct *ostore;
+	s7k_fileindex *fileindex;
+	int *current_ping;
+	int *last_ping;
+	int *new_ping;
+	int *save_flag;
+	int *recordid;
+	int *recordidlast;
 	int i;
 
 	/* print input debug statements */
@@ -18146,97 +20795,95 @@ int mbr_reson7kr_wr_soundvelocity(int verbose, int *bufferalloc, char **bufferpt
 		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
-		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
-		fprintf(stderr, "dbg2       bufferptr:  %p\n", (void *)bufferptr);
-		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       irecord:    %d\n", irecord);
 	}
 
-	/* get pointer to raw data structure */
-	store = (struct mbsys_reson7k_struct *)store_ptr;
-	soundvelocity = &(store->soundvelocity);
-	header = &(soundvelocity->header);
-
-/* print out the data to be output */
-#ifdef MBR_RESON7KR_DEBUG2
-	if (verbose > 0)
-#else
-	if (verbose >= 2)
-#endif
-		mbsys_reson7k_print_soundvelocity(verbose, soundvelocity, error);
+	/* get pointers to mbio descriptor and the index held in the internal store */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+	ostore = (struct mbsys_reson7k_struct *)mb_io_ptr->store_data;
+	fileindex = &(ostore->fileindex);
 
-	/* figure out size of output record */
-	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_7kSoundVelocity;
+	/* get saved values */
+	save_flag = (int *)&mb_io_ptr->save_flag;
+	current_ping = (int *)&mb_io_ptr->save14;
+	last_ping = (int *)&mb_io_ptr->save1;
+	new_ping = (int *)&mb_io_ptr->save2;
+	recordid = (int *)&mb_io_ptr->save3;
+	recordidlast = (int *)&mb_io_ptr->save4;
 
-	/* allocate memory to write rest of record if necessary */
-	if (*bufferalloc < *size) {
-		status = mb_reallocd(verbose, __FILE__, __LINE__, *size, (void **)bufferptr, error);
-		if (status != MB_SUCCESS) {
-			*bufferalloc = 0;
-		}
-		else {
-			*bufferalloc = *size;
-		}
+	/* go to the record */
+	if (irecord < 0 || irecord >= fileindex->n) {
+		status = MB_FAILURE;
+		*error = MB_ERROR_EOF;
+	}
+	else if (fseeko(mb_io_ptr->mbfp, (off_t)fileindex->offset[irecord], SEEK_SET) != 0) {
+		status = MB_FAILURE;
+		*error = MB_ERROR_EOF;
 	}
 
-	/* proceed to write if buffer allocated */
+	/* start reading afresh - any partly read ping is dropped, and the
+	    navigation and attitude held for interpolation are discarded since
+	    the records that follow may be earlier than them */
 	if (status == MB_SUCCESS) {
-		/* get buffer for writing */
-		buffer = (char *)*bufferptr;
-
-		/* insert the header */
-		index = 0;
-		status = mbr_reson7kr_wr_header(verbose, buffer, &index, header, error);
-
-		/* insert the data */
-		index = header->Offset + 4;
-		mb_put_binary_float(MB_YES, soundvelocity->soundvelocity, &buffer[index]);
-		index += 4;
-
-		/* reset the header size value */
-		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
-
-		/* now add the checksum */
-		checksum = 0;
-		for (i = 0; i < index; i++)
-			checksum += (unsigned char)buffer[i];
-		mb_put_binary_int(MB_YES, checksum, &buffer[index]);
-		index += 4;
-
-		/* check size */
-		if (*size != index) {
-			fprintf(stderr, "Bad size comparison: file:%s line:%d size:%d index:%d\n", __FILE__, __LINE__, *size, index);
-			status = MB_FAILURE;
-			*error = MB_ERROR_BAD_DATA;
-			*size = 0;
-		}
+		*save_flag = MB_NO;
+		*current_ping = -1;
+		*last_ping = -1;
+		*new_ping = -1;
+		*recordid = R7KRECID_None;
+		*recordidlast = R7KRECID_None;
+		mb_io_ptr->nfix = 0;
+		mb_io_ptr->nheading = 0;
+		mb_io_ptr->nattitude = 0;
+		mb_io_ptr->nsonardepth = 0;
+		mb_io_ptr->naltitude = 0;
+		for (i = 0; i < MBSYS_RESON7K_TSERIES_NUM; i++) {
+			ostore->tseries[i].n = 0;
+			ostore->tseries[i].head = 0;
+			ostore->tseries[i].cursor = 0;
+		}
+		mb_io_ptr->file_pos = (long)fileindex->offset[irecord];
+		mb_io_ptr->file_bytes = (long)fileindex->offset[irecord];
+		*error = MB_ERROR_NO_ERROR;
 	}
 
 	/* print output debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
-		fprintf(stderr, "dbg2       size:       %d\n", *size);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
-		fprintf(stderr, "dbg2       status:  %d\n", status);
+		fprintf(stderr, "dbg2       status:     %d\n", status);
 	}
 
 	/* return status */
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_absorptionloss(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_absorptionloss";
+int mbr_reson7kr_find_time(s7k_fileindex *fileindex, double time_d) {
+	int ilo, ihi, i;
+
+	/* find the first record at or after the time by bisection on the
+	    latest time up to each record - n if there is none */
+	ilo = 0;
+	ihi = fileindex->n;
+	while (ilo < ihi) {
+		i = (ilo + ihi) / 2;
+		if (fileindex->time_max[i] < time_d)
+			ilo = i + 1;
+		else
+			ihi = i;
+	}
+
+	return (ilo);
+}
+/*--------------------------------------------------------------------*/
+int mbr_reson7kr_seek_time(int verbose, void *mbio_ptr, double time_d, int *error) {
+	char *function_name = "mbr_reson7kr_seek_time";
 	int status = MB_SUCCESS;
-	struct mbsys_reson7k_struct *store;
-	s7k_header *header;
-	s7kr_absorptionloss *absorptionloss;
-	unsigned int checksum;
-	int index;
-	char *buffer;
-	int i;
+	struct mb_io_struct *mb_io_ptr;
+	struct mbsys_reson7k_struct *ostore;
+	int irecord = -1;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -18244,96 +20891,44 @@ int mbr_reson7kr_wr_absorptionloss(int verbose, int *bufferalloc, char **bufferp
 		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
-		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
-		fprintf(stderr, "dbg2       bufferptr:  %p\n", (void *)bufferptr);
-		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       time_d:     %f\n", time_d);
 	}
 
-	/* get pointer to raw data structure */
-	store = (struct mbsys_reson7k_struct *)store_ptr;
-	absorptionloss = &(store->absorptionloss);
-	header = &(absorptionloss->header);
-
-/* print out the data to be output */
-#ifdef MBR_RESON7KR_DEBUG2
-	if (verbose > 0)
-#else
-	if (verbose >= 2)
-#endif
-		mbsys_reson7k_print_absorptionloss(verbose, absorptionloss, error);
-
-	/* figure out size of output record */
-	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_7kAbsorptionLoss;
-
-	/* allocate memory to write rest of record if necessary */
-	if (*bufferalloc < *size) {
-		status = mb_reallocd(verbose, __FILE__, __LINE__, *size, (void **)bufferptr, error);
-		if (status != MB_SUCCESS) {
-			*bufferalloc = 0;
-		}
-		else {
-			*bufferalloc = *size;
-		}
-	}
+	/* get pointers to mbio descriptor and the internal store */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+	ostore = (struct mbsys_reson7k_struct *)mb_io_ptr->store_data;
 
-	/* proceed to write if buffer allocated */
+	/* go to the first record at or after the time - any time window set
+	    stays in effect */
+	status = mbr_reson7kr_rd_fileindex(verbose, mbio_ptr, error);
 	if (status == MB_SUCCESS) {
-		/* get buffer for writing */
-		buffer = (char *)*bufferptr;
-
-		/* insert the header */
-		index = 0;
-		status = mbr_reson7kr_wr_header(verbose, buffer, &index, header, error);
-
-		/* insert the data */
-		index = header->Offset + 4;
-		mb_put_binary_float(MB_YES, absorptionloss->absorptionloss, &buffer[index]);
-		index += 4;
-
-		/* reset the header size value */
-		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
-
-		/* now add the checksum */
-		checksum = 0;
-		for (i = 0; i < index; i++)
-			checksum += (unsigned char)buffer[i];
-		mb_put_binary_int(MB_YES, checksum, &buffer[index]);
-		index += 4;
-
-		/* check size */
-		if (*size != index) {
-			fprintf(stderr, "Bad size comparison: file:%s line:%d size:%d index:%d\n", __FILE__, __LINE__, *size, index);
-			status = MB_FAILURE;
-			*error = MB_ERROR_BAD_DATA;
-			*size = 0;
-		}
+		irecord = mbr_reson7kr_find_time(&(ostore->fileindex), time_d);
+		status = mbr_reson7kr_seek_record(verbose, mbio_ptr, irecord, error);
 	}
 
 	/* print output debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
-		fprintf(stderr, "dbg2       size:       %d\n", *size);
+		fprintf(stderr, "dbg2       irecord:    %d\n", irecord);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
-		fprintf(stderr, "dbg2       status:  %d\n", status);
+		fprintf(stderr, "dbg2       status:     %d\n", status);
 	}
 
 	/* return status */
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbr_reson7kr_wr_spreadingloss(int verbose, int *bufferalloc, char **bufferptr, void *store_ptr, int *size, int *error) {
-	char *function_name = "mbr_reson7kr_wr_spreadingloss";
+int mbr_reson7kr_open_window(int verbose, void *mbio_ptr, double time_start, double time_end, int *error) {
+	char *function_name = "mbr_reson7kr_open_window";
 	int status = MB_SUCCESS;
-	struct mbsys_reson7k_struct *store;
-	s7k_header *header;
-	s7kr_spreadingloss *spreadingloss;
-	unsigned int checksum;
-	int index;
-	char *buffer;
+	struct mb_io_struct *mb_io_ptr;
+	struct mbsys_reson7k_struct *ostore;
+	s7k_fileindex *fileindex;
+	int found_nav, found_heading, found_attitude, found_sonardepth;
+	int irecord = -1;
 	int i;
 
 	/* print input debug statements */
@@ -18342,81 +20937,79 @@ int mbr_reson7kr_wr_spreadingloss(int verbose, int *bufferalloc, char **bufferpt
 		fprintf(stderr, "dbg2  Revision id: %s\n", rcs_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
-		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
-		fprintf(stderr, "dbg2       bufferptr:  %p\n", (void *)bufferptr);
-		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       time_start: %f\n", time_start);
+		fprintf(stderr, "dbg2       time_end:   %f\n", time_end);
 	}
 
-	/* get pointer to raw data structure */
-	store = (struct mbsys_reson7k_struct *)store_ptr;
-	spreadingloss = &(store->spreadingloss);
-	header = &(spreadingloss->header);
-
-/* print out the data to be output */
-#ifdef MBR_RESON7KR_DEBUG2
-	if (verbose > 0)
-#else
-	if (verbose >= 2)
-#endif
-		mbsys_reson7k_print_spreadingloss(verbose, spreadingloss, error);
+	/* get pointers to mbio descriptor and the index held in the internal store */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+	ostore = (struct mbsys_reson7k_struct *)mb_io_ptr->store_data;
+	fileindex = &(ostore->fileindex);
 
-	/* figure out size of output record */
-	*size = MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE;
-	*size += R7KHDRSIZE_7kSpreadingLoss;
+	/* check the window */
+	if (time_end < time_start) {
+		status = MB_FAILURE;
+		*error = MB_ERROR_BAD_PARAMETER;
+	}
 
-	/* allocate memory to write rest of record if necessary */
-	if (*bufferalloc < *size) {
-		status = mb_reallocd(verbose, __FILE__, __LINE__, *size, (void **)bufferptr, error);
-		if (status != MB_SUCCESS) {
-			*bufferalloc = 0;
-		}
-		else {
-			*bufferalloc = *size;
+	/* start at the first record within the margin before the window */
+	if (status == MB_SUCCESS)
+		status = mbr_reson7kr_rd_fileindex(verbose, mbio_ptr, error);
+	if (status == MB_SUCCESS) {
+		irecord = mbr_reson7kr_find_time(fileindex, time_start - MBSYS_RESON7K_WINDOW_MARGIN);
+
+		/* and earlier if needed to include the last navigation, heading,
+		    attitude and sonar depth before the window, so that the first
+		    pings can be interpolated as if the file were read from its start */
+		found_nav = MB_NO;
+		found_heading = MB_NO;
+		found_attitude = MB_NO;
+		found_sonardepth = MB_NO;
+		for (i = irecord - 1;
+		     i >= 0 && fileindex->time_max[i] >= time_start - MBSYS_RESON7K_WINDOW_LOOKBACK &&
+		     (found_nav == MB_NO || found_heading == MB_NO || found_attitude == MB_NO || found_sonardepth == MB_NO);
+		     i--) {
+			if (found_nav == MB_NO &&
+			    (fileindex->recordid[i] == R7KRECID_Position || fileindex->recordid[i] == R7KRECID_Navigation)) {
+				found_nav = MB_YES;
+				irecord = i;
+			}
+			if (found_heading == MB_NO &&
+			    (fileindex->recordid[i] == R7KRECID_Heading || fileindex->recordid[i] == R7KRECID_Navigation ||
+			     fileindex->recordid[i] == R7KRECID_Attitude || fileindex->recordid[i] == R7KRECID_CustomAttitude)) {
+				found_heading = MB_YES;
+				irecord = i;
+			}
+			if (found_attitude == MB_NO &&
+			    (fileindex->recordid[i] == R7KRECID_Attitude || fileindex->recordid[i] == R7KRECID_CustomAttitude ||
+			     fileindex->recordid[i] == R7KRECID_RollPitchHeave)) {
+				found_attitude = MB_YES;
+				irecord = i;
+			}
+			if (found_sonardepth == MB_NO && fileindex->recordid[i] == R7KRECID_Depth) {
+				found_sonardepth = MB_YES;
+				irecord = i;
+			}
 		}
+		status = mbr_reson7kr_seek_record(verbose, mbio_ptr, irecord, error);
 	}
 
-	/* proceed to write if buffer allocated */
+	/* set the window */
 	if (status == MB_SUCCESS) {
-		/* get buffer for writing */
-		buffer = (char *)*bufferptr;
-
-		/* insert the header */
-		index = 0;
-		status = mbr_reson7kr_wr_header(verbose, buffer, &index, header, error);
-
-		/* insert the data */
-		index = header->Offset + 4;
-		mb_put_binary_float(MB_YES, spreadingloss->spreadingloss, &buffer[index]);
-		index += 4;
-
-		/* reset the header size value */
-		mb_put_binary_int(MB_YES, ((unsigned int)(index + 4)), &buffer[8]);
-
-		/* now add the checksum */
-		checksum = 0;
-		for (i = 0; i < index; i++)
-			checksum += (unsigned char)buffer[i];
-		mb_put_binary_int(MB_YES, checksum, &buffer[index]);
-		index += 4;
-
-		/* check size */
-		if (*size != index) {
-			fprintf(stderr, "Bad size comparison: file:%s line:%d size:%d index:%d\n", __FILE__, __LINE__, *size, index);
-			status = MB_FAILURE;
-			*error = MB_ERROR_BAD_DATA;
-			*size = 0;
-		}
+		ostore->window = MB_YES;
+		ostore->window_start = time_start;
+		ostore->window_end = time_end;
 	}
 
 	/* print output debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       bufferalloc:%d\n", *bufferalloc);
-		fprintf(stderr, "dbg2       size:       %d\n", *size);
+		fprintf(stderr, "dbg2       irecord:    %d\n", irecord);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
-		fprintf(stderr, "dbg2       status:  %d\n", status);
+		fprintf(stderr, "dbg2       status:     %d\n", status);
 	}
 
 	/* return status */
@@ -46,8 +46,156 @@
 /* turn on debug statements here */
 /* #define MSYS_RESON7KR_DEBUG 1 */
 
+/* calculate the beam angles in preprocessing with the batch kernel of
+   mbsys_reson7k_beam_geometry_slice() rather than with mb_beaudoin() for each
+   beam - off until the two are shown to agree by a comparison test */
+/* #define MBSYS_RESON7K_BATCH_GEOMETRY 1 */
+
+/* compare the beam angles of every preprocessed ping with mb_beaudoin() here */
+/* #define MBSYS_RESON7K_CHECK_BEAUDOIN 1 */
+
+/* threads are used for the beam angles in preprocessing, the sidescan,
+   batch extraction, the columnar export, the read - preprocess - write
+   pipeline and the store pool unless turned off here */
+/* #define MBSYS_RESON7K_NO_PTHREADS 1 */
+#ifndef MBSYS_RESON7K_NO_PTHREADS
+#define MBSYS_RESON7K_PTHREADS 1
+#endif
+#ifdef MBSYS_RESON7K_PTHREADS
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#endif
+
+/* beams of one ping given to one thread calculating beam angles - with
+   mb_beaudoin() unless batch is set, then with the array axes given */
+struct mbsys_reson7k_geometrywork_struct {
+	s7k_beamattitude *beamattitude;
+	int batch;
+	mb_3D_orientation tx_align;
+	mb_3D_orientation tx_orientation;
+	mb_3D_orientation rx_align;
+	double tvec[3];
+	double rxvec[3];
+	double reference_heading;
+	double soundspeed;
+	int jstart;
+	int jend;
+};
+void *mbsys_reson7k_beam_geometry_slice(void *work_ptr);
+
+/* snippets of one ping given to one thread binning samples into sidescan
+   pixels - the samples are summed into the histograms given, or if
+   listpixel is set they are listed to be summed afterwards in beam order */
+struct mbsys_reson7k_makesswork_struct {
+	struct mbsys_reson7k_struct *store;
+	int source;
+	char *beamflag;
+	double soundspeed;
+	double beamwidth;
+	double footsin;
+	double *footcos;
+	double *footsint;
+	double ss_spacing;
+	double pixel_size;
+	int nss;
+	int istart;
+	int iend;
+	double *ss;
+	double *ssalongtrack;
+	int *ss_cnt;
+	int nlistalloc;
+	int nlist;
+	int *listpixel;
+	double *listamplitude;
+	double *listalongtrack;
+};
+void *mbsys_reson7k_makess_slice(void *work_ptr);
+
+/* columns of one chunk given to one thread encoding them for the
+   columnar export */
+struct mbsys_reson7k_columnarwork_struct {
+	s7k_columnar *columnar;
+	int istart;
+	int iend;
+};
+void *mbsys_reson7k_columnar_slice(void *work_ptr);
+
+/* pings given to one thread extracting beams into the columns of a batch */
+struct mbsys_reson7k_batchwork_struct {
+	void **store_ptrs;
+	s7k_pingbatch *batch;
+	int istart;
+	int iend;
+};
+void *mbsys_reson7k_extract_batch_slice(void *work_ptr);
+
+#ifdef MBSYS_RESON7K_PTHREADS
+/* records passed from the reader through the preprocessing workers to the
+   writer - record n is held by slot_store[n % nslot], and the writer makes
+   the sidescan in order with its own copy wmbio_ptr of the input mbio
+   descriptor. The ring is lock free: each slot is handed from stage to
+   stage by its atomic state, the slot store, status and error being set
+   before the state is, workers claim records by advancing nclaim, and a
+   stage waiting on another polls (see mbsys_reson7k_pipeline_wait()) */
+struct mbsys_reson7k_pipeline_struct {
+	int verbose;
+	void *imbio_ptr;
+	void *ombio_ptr;
+	void *platform_ptr;
+	void *preprocess_pars_ptr;
+	struct mb_io_struct *wmbio_ptr;
+	int nslot;
+	struct mbsys_reson7k_struct *slot_store[MBSYS_RESON7K_PIPELINE_SLOTS_MAX];
+	atomic_int slot_state[MBSYS_RESON7K_PIPELINE_SLOTS_MAX];
+	int slot_status[MBSYS_RESON7K_PIPELINE_SLOTS_MAX];
+	int slot_error[MBSYS_RESON7K_PIPELINE_SLOTS_MAX];
+	atomic_int nread;
+	atomic_int nclaim;
+	atomic_int nwritten;
+	atomic_int eof;
+	atomic_int abort;
+	int status;
+	int error;
+};
+
+/* a preprocessing worker - its copy of the input mbio descriptor holds
+   its own internal store so that the scratch arrays are not shared */
+struct mbsys_reson7k_pipelineworker_struct {
+	struct mbsys_reson7k_pipeline_struct *pipeline;
+	struct mb_io_struct *mbio_ptr;
+};
+void *mbsys_reson7k_pipeline_preprocess(void *work_ptr);
+void *mbsys_reson7k_pipeline_write(void *work_ptr);
+void mbsys_reson7k_pipeline_wait(int *nwait);
+int mbsys_reson7k_pipeline_mbio(int verbose, void *imbio_ptr, struct mb_io_struct **mbio_ptr, int *error);
+#endif
+
 static char svn_id[] = "$Id: mbsys_reson7k.c 2324 2018-01-19 03:04:33Z caress $";
 
+/* stores released by mbsys_reson7k_deall() and kept for reuse by
+   mbsys_reson7k_alloc() - off unless enabled with mbsys_reson7k_set_storepool(),
+   shared by all mbio handles in the process and freed by the caller with
+   mbsys_reson7k_free_storepool(). The lock is a spin lock on an atomic flag
+   so that the pool is safe from any threads, not only those started here;
+   stores are only freed outside it */
+static struct mbsys_reson7k_struct *mbsys_reson7k_storepool[MBSYS_RESON7K_STOREPOOL_MAX];
+static int mbsys_reson7k_storepool_n = 0;
+static int mbsys_reson7k_storepool_max = MBSYS_RESON7K_STOREPOOL_DEFAULT;
+static atomic_flag mbsys_reson7k_storepool_lock = ATOMIC_FLAG_INIT;
+void mbsys_reson7k_storepool_acquire(void);
+void mbsys_reson7k_storepool_release(void);
+
+/* 8 bit dB to linear magnitude conversion used for 7042 input - the
+   inverse of the conversion used for 7042 output in mbr_reson7k3.c, built
+   once by the first mbsys_reson7k_alloc() so that it is only read after */
+static double mbsys_reson7k_dblinear[256];
+static int mbsys_reson7k_dblinear_set = MB_NO;
+#ifdef MBSYS_RESON7K_PTHREADS
+static pthread_once_t mbsys_reson7k_dblinear_once = PTHREAD_ONCE_INIT;
+#endif
+void mbsys_reson7k_dblinear_init(void);
+
 /*--------------------------------------------------------------------*/
 int mbsys_reson7k_zero7kheader(int verbose, s7k_header *header, int *error) {
 	char *function_name = "mbsys_reson7k_zero7kheader";
@@ -104,6 +252,63 @@ int mbsys_reson7k_alloc(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 	char *function_name = "mbsys_reson7k_alloc";
 	int status = MB_SUCCESS;
 	struct mb_io_struct *mb_io_ptr;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+	}
+
+	/* get mbio descriptor */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+
+	/* build the 7042 dB conversion table before any store can be used */
+#ifdef MBSYS_RESON7K_PTHREADS
+	pthread_once(&mbsys_reson7k_dblinear_once, mbsys_reson7k_dblinear_init);
+#else
+	if (mbsys_reson7k_dblinear_set == MB_NO)
+		mbsys_reson7k_dblinear_init();
+#endif
+
+	/* reuse a released store if one is pooled - it was reset when it was
+	    released and keeps the arrays it had grown */
+	*store_ptr = NULL;
+	mbsys_reson7k_storepool_acquire();
+	if (mbsys_reson7k_storepool_n > 0) {
+		mbsys_reson7k_storepool_n--;
+		*store_ptr = (void *)mbsys_reson7k_storepool[mbsys_reson7k_storepool_n];
+		mbsys_reson7k_storepool[mbsys_reson7k_storepool_n] = NULL;
+	}
+	mbsys_reson7k_storepool_release();
+
+	/* otherwise allocate and initialize a new store */
+	if (*store_ptr == NULL) {
+		status = mb_mallocd(verbose, __FILE__, __LINE__, sizeof(struct mbsys_reson7k_struct), (void **)store_ptr, error);
+		if (status == MB_SUCCESS)
+			status = mbsys_reson7k_initstore(verbose, *store_ptr, error);
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)*store_ptr);
+		fprintf(stderr, "dbg2       store size: %zu\n", sizeof(struct mbsys_reson7k_struct));
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_zerostore(int verbose, void *store_ptr, int keeparrays, int *error) {
+	char *function_name = "mbsys_reson7k_zerostore";
+	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
 	s7kr_reference *reference;
 	s7kr_sensoruncal *sensoruncal;
@@ -151,29 +356,27 @@ int mbsys_reson7k_alloc(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 	s7kr_installation *installation;
 	s7kr_systemeventmessage *systemeventmessage;
 	s7kr_fileheader *fileheader;
+	s7kr_filecatalogrecord *filecatalogrecord;
 	s7kr_remotecontrolsettings *remotecontrolsettings;
 	s7kr_reserved *reserved;
 	int i, j;
 
+
 	/* print input debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
-		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       keeparrays: %d\n", keeparrays);
 	}
 
-	/* get mbio descriptor */
-	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
-
-	/* allocate memory for data structure */
-	status = mb_mallocd(verbose, __FILE__, __LINE__, sizeof(struct mbsys_reson7k_struct), (void **)store_ptr, error);
-
 	/* get data structure pointer */
-	store = (struct mbsys_reson7k_struct *)*store_ptr;
+	store = (struct mbsys_reson7k_struct *)store_ptr;
 
-	/* initialize everything */
+	/* initialize everything - if keeparrays is set the arrays already
+	    allocated are kept with their sizes and only emptied */
 
 	/* Type of data record */
 	store->kind = MB_DATA_NONE;
@@ -181,23 +384,18 @@ int mbsys_reson7k_alloc(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 
 	/* ping record id's */
 	store->current_ping_number = -1;
-	store->read_volatilesettings = MB_NO;
-	store->read_matchfilter = MB_NO;
-	store->read_beamgeometry = MB_NO;
-	store->read_bathymetry = MB_NO;
-	store->read_backscatter = MB_NO;
-	store->read_beam = MB_NO;
-	store->read_verticaldepth = MB_NO;
-	store->read_tvg = MB_NO;
-	store->read_image = MB_NO;
-	store->read_v2pingmotion = MB_NO;
-	store->read_v2detectionsetup = MB_NO;
-	store->read_v2beamformed = MB_NO;
-	store->read_v2detection = MB_NO;
-	store->read_v2rawdetection = MB_NO;
-	store->read_v2snippet = MB_NO;
-	store->read_calibratedsnippet = MB_NO;
-	store->read_processedsidescan = MB_NO;
+	store->read_mask = 0;
+
+	/* raw record pass-through */
+	for (i = 0; i < R7KRAW_NUM; i++) {
+		store->rawrecord[i].recordid = R7KRECID_None;
+		store->rawrecord[i].modified = MB_NO;
+		store->rawrecord[i].size = 0;
+		if (keeparrays == MB_NO) {
+			store->rawrecord[i].nalloc = 0;
+			store->rawrecord[i].buffer = NULL;
+		}
+	}
 
 	/* MB-System time stamp */
 	store->time_d = 0;
@@ -252,15 +450,17 @@ int mbsys_reson7k_alloc(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 	customattitude->reserved = 0;
 	customattitude->n = 0;
 	customattitude->frequency = 0;
-	customattitude->nalloc = 0;
-	customattitude->pitch = NULL;
-	customattitude->roll = NULL;
-	customattitude->heading = NULL;
-	customattitude->heave = NULL;
-	customattitude->pitchrate = NULL;
-	customattitude->rollrate = NULL;
-	customattitude->headingrate = NULL;
-	customattitude->heaverate = NULL;
+	if (keeparrays == MB_NO) {
+		customattitude->nalloc = 0;
+		customattitude->pitch = NULL;
+		customattitude->roll = NULL;
+		customattitude->heading = NULL;
+		customattitude->heave = NULL;
+		customattitude->pitchrate = NULL;
+		customattitude->rollrate = NULL;
+		customattitude->headingrate = NULL;
+		customattitude->heaverate = NULL;
+	}
 
 	/* Tide (record 1005) */
 	tide = &store->tide;
@@ -289,13 +489,15 @@ int mbsys_reson7k_alloc(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 	motion->reserved = 0;
 	motion->n = 0;
 	motion->frequency = 0;
-	motion->nalloc = 0;
-	motion->x = NULL;
-	motion->y = NULL;
-	motion->z = NULL;
-	motion->xa = NULL;
-	motion->ya = NULL;
-	motion->za = NULL;
+	if (keeparrays == MB_NO) {
+		motion->nalloc = 0;
+		motion->x = NULL;
+		motion->y = NULL;
+		motion->z = NULL;
+		motion->xa = NULL;
+		motion->ya = NULL;
+		motion->za = NULL;
+	}
 
 	/* Depth (record 1008) */
 	depth = &store->depth;
@@ -314,9 +516,11 @@ int mbsys_reson7k_alloc(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 	svp->latitude = 0.0;
 	svp->longitude = 0.0;
 	svp->n = 0;
-	svp->nalloc = 0;
-	svp->depth = NULL;
-	svp->sound_velocity = NULL;
+	if (keeparrays == MB_NO) {
+		svp->nalloc = 0;
+		svp->depth = NULL;
+		svp->sound_velocity = NULL;
+	}
 
 	/* CTD (record 1010) */
 	ctd = &store->ctd;
@@ -333,12 +537,14 @@ int mbsys_reson7k_alloc(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 	ctd->longitude = 0.0;
 	ctd->sample_rate = 0.0;
 	ctd->n = 0;
-	ctd->nalloc = 0;
-	ctd->conductivity_salinity = NULL;
-	ctd->temperature = NULL;
-	ctd->pressure_depth = NULL;
-	ctd->sound_velocity = NULL;
-	ctd->absorption = NULL;
+	if (keeparrays == MB_NO) {
+		ctd->nalloc = 0;
+		ctd->conductivity_salinity = NULL;
+		ctd->temperature = NULL;
+		ctd->pressure_depth = NULL;
+		ctd->sound_velocity = NULL;
+		ctd->absorption = NULL;
+	}
 
 	/* Geodesy (record 1011) */
 	geodesy = &store->geodesy;
@@ -395,9 +601,11 @@ int mbsys_reson7k_alloc(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 	surveyline->turnradius = 0.0;
 	for (i = 0; i < 64; i++)
 		surveyline->name[i] = '\0';
-	surveyline->nalloc = 0;
-	surveyline->latitude = NULL;
-	surveyline->longitude = NULL;
+	if (keeparrays == MB_NO) {
+		surveyline->nalloc = 0;
+		surveyline->latitude = NULL;
+		surveyline->longitude = NULL;
+	}
 
 	/* Navigation (record 1015) */
 	navigation = &store->navigation;
@@ -416,12 +624,14 @@ int mbsys_reson7k_alloc(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 	attitude = &store->attitude;
 	mbsys_reson7k_zero7kheader(verbose, &attitude->header, error);
 	attitude->n = 0;
-	attitude->nalloc = 0;
-	attitude->delta_time = NULL;
-	attitude->roll = NULL;
-	attitude->pitch = NULL;
-	attitude->heave = NULL;
-	attitude->heading = NULL;
+	if (keeparrays == MB_NO) {
+		attitude->nalloc = 0;
+		attitude->delta_time = NULL;
+		attitude->roll = NULL;
+		attitude->pitch = NULL;
+		attitude->heave = NULL;
+		attitude->heading = NULL;
+	}
 
 	/* Pan Tilt (record 1017) */
 	pantilt = &store->pantilt;
@@ -473,12 +683,14 @@ int mbsys_reson7k_alloc(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 	
 	CONTINUE HERE <---
 	
-	sonarpipeenvironment->nalloc = 0;
-	sonarpipeenvironment->x = NULL;
-	sonarpipeenvironment->y = NULL;
-	sonarpipeenvironment->z = NULL;
-	sonarpipeenvironment->angle = NULL;
-	sonarpipeenvironment->sample_number = NULL;
+	if (keeparrays == MB_NO) {
+		sonarpipeenvironment->nalloc = 0;
+		sonarpipeenvironment->x = NULL;
+		sonarpipeenvironment->y = NULL;
+		sonarpipeenvironment->z = NULL;
+		sonarpipeenvironment->angle = NULL;
+		sonarpipeenvironment->sample_number = NULL;
+	}
 
 	/* Processed sidescan - MB-System extension to 7k format (record 3199) */
 	processedsidescan = &store->processedsidescan;
@@ -546,14 +758,9 @@ int mbsys_reson7k_alloc(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 	mbsys_reson7k_zero7kheader(verbose, &configuration->header, error);
 	configuration->serial_number = 0;
 	configuration->number_devices = 0;
-	for (i = 0; i < MBSYS_RESON7K_MAX_DEVICE; i++) {
-		configuration->device[i].magic_number = 0;
-		for (j = 0; j < 16; j++)
-			configuration->device[i].description[j] = '\0';
-		configuration->device[i].serial_number = 0;
-		configuration->device[i].info_length = 0;
-		configuration->device[i].info_alloc = 0;
-		configuration->device[i].info = NULL;
+	if (keeparrays == MB_NO) {
+		configuration->nalloc = 0;
+		configuration->device = NULL;
 	}
 
 	/* Reson 7k match filter (record 7002) */
@@ -570,20 +777,25 @@ int mbsys_reson7k_alloc(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 	mbsys_reson7k_zero7kheader(verbose, &v2firmwarehardwareconfiguration->header, error);
 	v2firmwarehardwareconfiguration->device_count = 0;
 	v2firmwarehardwareconfiguration->info_length = 0;
-	v2firmwarehardwareconfiguration->info_alloc = 0;
-	v2firmwarehardwareconfiguration->info = NULL;
+	if (keeparrays == MB_NO) {
+		v2firmwarehardwareconfiguration->info_alloc = 0;
+		v2firmwarehardwareconfiguration->info = NULL;
+	}
 
 	/* Reson 7k beam geometry (record 7004) */
 	beamgeometry = &store->beamgeometry;
 	mbsys_reson7k_zero7kheader(verbose, &beamgeometry->header, error);
 	beamgeometry->serial_number = 0;
 	beamgeometry->number_beams = 0;
-	for (i = 0; i < MBSYS_RESON7K_MAX_BEAMS; i++) {
-		beamgeometry->angle_alongtrack[i] = 0.0;
-		beamgeometry->angle_acrosstrack[i] = 0.0;
-		beamgeometry->beamwidth_alongtrack[i] = 0.0;
-		beamgeometry->beamwidth_acrosstrack[i] = 0.0;
+	if (keeparrays == MB_NO) {
+		beamgeometry->nalloc = 0;
+		beamgeometry->angle_alongtrack = NULL;
+		beamgeometry->angle_acrosstrack = NULL;
+		beamgeometry->beamwidth_alongtrack = NULL;
+		beamgeometry->beamwidth_acrosstrack = NULL;
 	}
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_alloc_beamgeometry(verbose, beamgeometry, MBSYS_RESON7K_MAX_BEAMS, error);
 
 	/* Reson 7k calibration data (record 7005) */
 	calibration = &store->calibration;
@@ -602,13 +814,21 @@ int mbsys_reson7k_alloc(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 	bathymetry->ping_number = 0;
 	bathymetry->multi_ping = 0;
 	bathymetry->number_beams = 0;
-	for (i = 0; i < MBSYS_RESON7K_MAX_BEAMS; i++) {
-		bathymetry->range[i] = 0.0;
-		bathymetry->quality[i] = 0;
-		bathymetry->intensity[i] = 0.0;
-		bathymetry->min_depth_gate[i] = 0.0;
-		bathymetry->max_depth_gate[i] = 0.0;
-	}
+	if (keeparrays == MB_NO) {
+		bathymetry->nalloc = 0;
+		bathymetry->range = NULL;
+		bathymetry->quality = NULL;
+		bathymetry->intensity = NULL;
+		bathymetry->min_depth_gate = NULL;
+		bathymetry->max_depth_gate = NULL;
+		bathymetry->depth = NULL;
+		bathymetry->alongtrack = NULL;
+		bathymetry->acrosstrack = NULL;
+		bathymetry->pointing_angle = NULL;
+		bathymetry->azimuth_angle = NULL;
+	}
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_alloc_bathymetry(verbose, bathymetry, MBSYS_RESON7K_MAX_BEAMS, error);
 	bathymetry->optionaldata = MB_NO;
 	bathymetry->frequency = 0.0;
 	bathymetry->latitude = 0.0;
@@ -620,13 +840,6 @@ int mbsys_reson7k_alloc(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 	bathymetry->pitch = 0.0;
 	bathymetry->heave = 0.0;
 	bathymetry->vehicle_height = 0.0;
-	for (i = 0; i < MBSYS_RESON7K_MAX_BEAMS; i++) {
-		bathymetry->depth[i] = 0.0;
-		bathymetry->alongtrack[i] = 0.0;
-		bathymetry->acrosstrack[i] = 0.0;
-		bathymetry->pointing_angle[i] = 0.0;
-		bathymetry->azimuth_angle[i] = 0.0;
-	}
 	bathymetry->acrossalongerror = MB_MAYBE;
 	bathymetry->nacrossalongerroryes = 0;
 	bathymetry->nacrossalongerrorno = 0;
@@ -652,9 +865,11 @@ int mbsys_reson7k_alloc(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 	backscatter->current_beam = 0;
 	backscatter->sample_size = 0;
 	backscatter->data_type = 0;
-	backscatter->nalloc = 0;
-	backscatter->port_data = NULL;
-	backscatter->stbd_data = NULL;
+	if (keeparrays == MB_NO) {
+		backscatter->nalloc = 0;
+		backscatter->port_data = NULL;
+		backscatter->stbd_data = NULL;
+	}
 	backscatter->optionaldata = MB_NO;
 	backscatter->frequency = 0.0;
 	backscatter->latitude = 0.0;
@@ -679,10 +894,12 @@ int mbsys_reson7k_alloc(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 		beam->snippets[i].beam_number = 0;
 		beam->snippets[i].begin_sample = 0;
 		beam->snippets[i].end_sample = 0;
-		beam->snippets[i].nalloc_amp = 0;
-		beam->snippets[i].nalloc_phase = 0;
-		beam->snippets[i].amplitude = NULL;
-		beam->snippets[i].phase = NULL;
+		if (keeparrays == MB_NO) {
+			beam->snippets[i].nalloc_amp = 0;
+			beam->snippets[i].nalloc_phase = 0;
+			beam->snippets[i].amplitude = NULL;
+			beam->snippets[i].phase = NULL;
+		}
 	}
 
 	/* Reson 7k vertical depth (record 7009) */
@@ -707,8 +924,10 @@ int mbsys_reson7k_alloc(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 	tvg->n = 0;
 	for (i = 0; i < 8; i++)
 		tvg->reserved[i] = 0;
-	tvg->nalloc = 0;
-	tvg->tvg = NULL;
+	if (keeparrays == MB_NO) {
+		tvg->nalloc = 0;
+		tvg->tvg = NULL;
+	}
 
 	/* Reson 7k image data (record 7011) */
 	image = &store->image;
@@ -720,8 +939,10 @@ int mbsys_reson7k_alloc(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 	image->color_depth = 0;
 	image->width_height_flag = 0;
 	image->compression = 0;
-	image->nalloc = 0;
-	image->image = NULL;
+	if (keeparrays == MB_NO) {
+		image->nalloc = 0;
+		image->image = NULL;
+	}
 
 	/* Ping motion (record 7012) */
 	v2pingmotion = &store->v2pingmotion;
@@ -733,11 +954,13 @@ int mbsys_reson7k_alloc(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 	v2pingmotion->flags = 0;
 	v2pingmotion->error_flags = 0;
 	v2pingmotion->frequency = 0.0;
-	v2pingmotion->nalloc = 0;
-	v2pingmotion->pitch = 0.0;
-	v2pingmotion->roll = NULL;
-	v2pingmotion->heading = NULL;
-	v2pingmotion->heave = NULL;
+	if (keeparrays == MB_NO) {
+		v2pingmotion->nalloc = 0;
+		v2pingmotion->pitch = 0.0;
+		v2pingmotion->roll = NULL;
+		v2pingmotion->heading = NULL;
+		v2pingmotion->heave = NULL;
+	}
 
 	/* Detection setup (record 7017) */
 	v2detectionsetup = &store->v2detectionsetup;
@@ -760,16 +983,17 @@ int mbsys_reson7k_alloc(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 	v2detectionsetup->depth_gate_tilt = 0.0;
 	for (i = 0; i < 14; i++)
 		v2detectionsetup->reserved[i] = 0.0;
-	for (i = 0; i < MBSYS_RESON7K_MAX_BEAMS; i++) {
-		v2detectionsetup->beam_descriptor[i] = 0;
-		v2detectionsetup->detection_point[i] = 0.0;
-		v2detectionsetup->flags[i] = 0;
-		v2detectionsetup->auto_limits_min_sample[i] = 0;
-		v2detectionsetup->auto_limits_max_sample[i] = 0;
-		v2detectionsetup->user_limits_min_sample[i] = 0;
-		v2detectionsetup->user_limits_max_sample[i] = 0;
-		v2detectionsetup->quality[i] = 0;
-		v2detectionsetup->uncertainty[i] = 0;
+	if (keeparrays == MB_NO) {
+		v2detectionsetup->nalloc = 0;
+		v2detectionsetup->beam_descriptor = NULL;
+		v2detectionsetup->detection_point = NULL;
+		v2detectionsetup->flags = NULL;
+		v2detectionsetup->auto_limits_min_sample = NULL;
+		v2detectionsetup->auto_limits_max_sample = NULL;
+		v2detectionsetup->user_limits_min_sample = NULL;
+		v2detectionsetup->user_limits_max_sample = NULL;
+		v2detectionsetup->quality = NULL;
+		v2detectionsetup->uncertainty = NULL;
 	}
 
 	/* Reson 7k beamformed magnitude and phase data (record 7018) */
@@ -786,17 +1010,21 @@ int mbsys_reson7k_alloc(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 		v2amplitudephase = &v2beamformed->amplitudephase[i];
 		v2amplitudephase->beam_number = 0;
 		v2amplitudephase->number_samples = 0;
-		v2amplitudephase->nalloc = 0;
-		v2amplitudephase->amplitude = NULL;
-		v2amplitudephase->phase = NULL;
+		if (keeparrays == MB_NO) {
+			v2amplitudephase->nalloc = 0;
+			v2amplitudephase->amplitude = NULL;
+			v2amplitudephase->phase = NULL;
+		}
 	}
 
 	/* Reson 7k BITE (record 7021) */
 	v2bite = &store->v2bite;
 	mbsys_reson7k_zero7kheader(verbose, &v2bite->header, error);
 	v2bite->number_reports = 0;
-	v2bite->nalloc = 0;
-	v2bite->reports = NULL;
+	if (keeparrays == MB_NO) {
+		v2bite->nalloc = 0;
+		v2bite->reports = NULL;
+	}
 
 	/* Reson 7k center version (record 7022) */
 	v27kcenterversion = &store->v27kcenterversion;
@@ -823,13 +1051,14 @@ int mbsys_reson7k_alloc(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 	v2detection->flags = 0;
 	for (i = 0; i < 64; i++)
 		v2detection->reserved[i] = 0;
-	for (i = 0; i < MBSYS_RESON7K_MAX_BEAMS; i++) {
-		v2detection->range[i] = 0.0;
-		v2detection->angle_x[i] = 0.0;
-		v2detection->angle_y[i] = 0.0;
-		v2detection->range_error[i] = 0.0;
-		v2detection->angle_x_error[i] = 0.0;
-		v2detection->angle_y_error[i] = 0.0;
+	if (keeparrays == MB_NO) {
+		v2detection->nalloc = 0;
+		v2detection->range = NULL;
+		v2detection->angle_x = NULL;
+		v2detection->angle_y = NULL;
+		v2detection->range_error = NULL;
+		v2detection->angle_x_error = NULL;
+		v2detection->angle_y_error = NULL;
 	}
 
 	/* Reson 7k version 2 raw detection (record 7027) */
@@ -846,13 +1075,14 @@ int mbsys_reson7k_alloc(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 	v2rawdetection->tx_angle = 0.0;
 	for (i = 0; i < 64; i++)
 		v2rawdetection->reserved[i] = 0;
-	for (i = 0; i < MBSYS_RESON7K_MAX_BEAMS; i++) {
-		v2rawdetection->beam_descriptor[i] = 0;
-		v2rawdetection->detection_point[i] = 0;
-		v2rawdetection->rx_angle[i] = 0;
-		v2rawdetection->flags[i] = 0;
-		v2rawdetection->quality[i] = 0;
-		v2rawdetection->uncertainty[i] = 0;
+	if (keeparrays == MB_NO) {
+		v2rawdetection->nalloc = 0;
+		v2rawdetection->beam_descriptor = NULL;
+		v2rawdetection->detection_point = NULL;
+		v2rawdetection->rx_angle = NULL;
+		v2rawdetection->flags = NULL;
+		v2rawdetection->quality = NULL;
+		v2rawdetection->uncertainty = NULL;
 	}
 
 	/* Reson 7k version 2 snippet (record 7028) */
@@ -872,8 +1102,10 @@ int mbsys_reson7k_alloc(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 		v2snippettimeseries->begin_sample = 0;
 		v2snippettimeseries->detect_sample = 0;
 		v2snippettimeseries->end_sample = 0;
-		v2snippettimeseries->nalloc = 0;
-		v2snippettimeseries->amplitude = NULL;
+		if (keeparrays == MB_NO) {
+			v2snippettimeseries->nalloc = 0;
+			v2snippettimeseries->amplitude = NULL;
+		}
 	}
 
 	/* Reson 7k sonar installation parameters (record 7051) */
@@ -924,8 +1156,10 @@ int mbsys_reson7k_alloc(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 	systemeventmessage->event_id = 0;
 	systemeventmessage->message_length = 0;
 	systemeventmessage->event_identifier = 0;
-	systemeventmessage->message_alloc = 0;
-	systemeventmessage->message = NULL;
+	if (keeparrays == MB_NO) {
+		systemeventmessage->message_alloc = 0;
+		systemeventmessage->message = NULL;
+	}
 
 	/* Reson 7k calibrated snippet (record 7058) */
 	calibratedsnippet = &store->calibratedsnippet;
@@ -944,8 +1178,10 @@ int mbsys_reson7k_alloc(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 		calibratedsnippettimeseries->begin_sample = 0;
 		calibratedsnippettimeseries->detect_sample = 0;
 		calibratedsnippettimeseries->end_sample = 0;
-		calibratedsnippettimeseries->nalloc = 0;
-		calibratedsnippettimeseries->amplitude = NULL;
+		if (keeparrays == MB_NO) {
+			calibratedsnippettimeseries->nalloc = 0;
+			calibratedsnippettimeseries->amplitude = NULL;
+		}
 	}
 
 	/* Reson 7k file header (record 7200) */
@@ -967,9 +1203,226 @@ int mbsys_reson7k_alloc(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 		fileheader->user_defined_name[i] = '\0';
 	for (i = 0; i < 128; i++)
 		fileheader->notes[i] = '\0';
-	for (j = 0; j < MBSYS_RESON7K_MAX_DEVICE; j++) {
-		fileheader->subsystem[j].device_identifier = 0;
-		fileheader->subsystem[j].system_enumerator = 0;
+	if (keeparrays == MB_NO) {
+		fileheader->nalloc = 0;
+		fileheader->subsystem = NULL;
+	}
+	fileheader->optionaldata = MB_NO;
+	fileheader->catalog_size = 0;
+	fileheader->catalog_offset = 0;
+
+	/* Reson 7k file catalog (record 7300) */
+	filecatalogrecord = &store->filecatalogrecord;
+	mbsys_reson7k_zero7kheader(verbose, &filecatalogrecord->header, error);
+	filecatalogrecord->size = R7KHDRSIZE_7kFileCatalogRecord;
+	filecatalogrecord->version = 1;
+	filecatalogrecord->records_n = 0;
+	filecatalogrecord->reserved = 0;
+	if (keeparrays == MB_NO) {
+		filecatalogrecord->nalloc = 0;
+		filecatalogrecord->filecatalogrecorddata = NULL;
+	}
+	store->filecatalogwrite.offset = 0;
+	store->filecatalogwrite.fileheader_offset = 0;
+	store->filecatalogwrite.fileheader_size = 0;
+	if (keeparrays == MB_NO) {
+		store->filecatalogwrite.fileheader_nalloc = 0;
+		store->filecatalogwrite.fileheader = NULL;
+	}
+	store->fileindex.source = MBSYS_RESON7K_FILEINDEX_NONE;
+	store->fileindex.n = 0;
+	if (keeparrays == MB_NO) {
+		store->fileindex.nalloc = 0;
+		store->fileindex.offset = NULL;
+		store->fileindex.recordid = NULL;
+		store->fileindex.time_d = NULL;
+		store->fileindex.time_max = NULL;
+	}
+	store->window = MB_NO;
+	store->window_start = 0.0;
+	store->window_end = 0.0;
+
+	/* water column compression on output */
+	store->pingcomplete_mask = 0;
+	store->compresswatercolumn = MB_NO;
+	store->compresswatercolumn_flags = 0;
+
+	/* ping record encoding on output */
+	store->encode_threads = 1;
+	store->writequeue_depth = 0;
+	store->writequeue = NULL;
+	store->preprocess_threads = 1;
+	store->preprocess_makess = MB_YES;
+	store->makess_source = R7KRECID_None;
+	store->makess_threads = 1;
+	store->makess_deterministic = MB_NO;
+	store->encodeping.nrecord = 0;
+	store->encodeping.flags = 0;
+	for (i = 0; i < R7KRAW_Other; i++) {
+		store->encodeping.recordids[i] = R7KRECID_None;
+		store->encodeping.encodebuffer[i].recordid = R7KRECID_None;
+		store->encodeping.encodebuffer[i].status = MB_SUCCESS;
+		store->encodeping.encodebuffer[i].error = MB_ERROR_NO_ERROR;
+		store->encodeping.encodebuffer[i].size = 0;
+		if (keeparrays == MB_NO) {
+			store->encodeping.encodebuffer[i].nalloc = 0;
+			store->encodeping.encodebuffer[i].buffer = NULL;
+		}
+	}
+	if (keeparrays == MB_NO) {
+		store->encodeping.nbottom = 0;
+		store->encodeping.bottom = NULL;
+		store->encodeping.nsample = 0;
+		store->encodeping.magnitude = NULL;
+		store->encodeping.phase = NULL;
+	}
+
+	/* scratch arrays for sidescan generation - allocated on first use */
+	store->makessscratch.footvalid = MB_NO;
+	store->makessscratch.foothash = 0;
+	store->makessscratch.footnbeams = 0;
+	store->makessscratch.grid.npixels = 0;
+	if (keeparrays == MB_NO) {
+		store->makessscratch.nalloc = 0;
+		store->makessscratch.bathsort = NULL;
+		store->makessscratch.beamflag = NULL;
+		store->makessscratch.rangetable = NULL;
+		store->makessscratch.acrosstracktable = NULL;
+		store->makessscratch.alongtracktable = NULL;
+		store->makessscratch.footcos = NULL;
+		store->makessscratch.footsint = NULL;
+		store->makessscratch.grid.nalloc = 0;
+		store->makessscratch.grid.ss = NULL;
+		store->makessscratch.grid.ssacrosstrack = NULL;
+		store->makessscratch.grid.ssalongtrack = NULL;
+		store->makessscratch.grid.ss_cnt = NULL;
+		store->makessscratch.hiresgrid = store->makessscratch.grid;
+		store->makessscratch.nthreadalloc = 0;
+		store->makessscratch.threadss = NULL;
+		store->makessscratch.threadssalongtrack = NULL;
+		store->makessscratch.threadsscnt = NULL;
+		store->makessscratch.nlistalloc = 0;
+		store->makessscratch.listpixel = NULL;
+		store->makessscratch.listamplitude = NULL;
+		store->makessscratch.listalongtrack = NULL;
+		store->beamattitude.nalloc = 0;
+		store->beamattitude.time_d = NULL;
+		store->beamattitude.index = NULL;
+		store->beamattitude.beamid = NULL;
+		store->beamattitude.weight = NULL;
+		store->beamattitude.roll = NULL;
+		store->beamattitude.pitch = NULL;
+		store->beamattitude.heave = NULL;
+		store->beamattitude.heading = NULL;
+		store->beamattitude.tx_steer = NULL;
+		store->beamattitude.rx_steer = NULL;
+		store->beamattitude.range = NULL;
+		store->beamattitude.azimuth = NULL;
+		store->beamattitude.depression = NULL;
+		store->beamattitude.acrosstrack = NULL;
+		store->beamattitude.alongtrack = NULL;
+		store->beamattitude.depth = NULL;
+		store->attitudeseries.nalloc = 0;
+		store->attitudeseries.time_d = NULL;
+		store->attitudeseries.roll = NULL;
+		store->attitudeseries.pitch = NULL;
+		store->attitudeseries.heave = NULL;
+		store->attitudeseries.heading = NULL;
+		store->attitudeseries.index = NULL;
+		store->attitudeseries.weight = NULL;
+	}
+	for (i = 0; i < MBSYS_RESON7K_TSERIES_NUM; i++) {
+		if (keeparrays == MB_NO) {
+			status = mbsys_reson7k_tseries_setup(verbose, &(store->tseries[i]), i, error);
+			status = mbsys_reson7k_tseries_setup(verbose, &(store->tseries_preprocess[i]), i, error);
+		}
+		else {
+			store->tseries[i].n = 0;
+			store->tseries[i].head = 0;
+			store->tseries[i].cursor = 0;
+			store->tseries[i].ndropped = 0;
+			if (store->tseries_preprocess[i].shared == MB_YES)
+				status = mbsys_reson7k_tseries_free(verbose, &(store->tseries_preprocess[i]), error);
+			store->tseries_preprocess[i].n = 0;
+			store->tseries_preprocess[i].head = 0;
+			store->tseries_preprocess[i].cursor = 0;
+			store->tseries_preprocess[i].source = NULL;
+			store->tseries_preprocess[i].nsource = 0;
+			store->tseries_preprocess[i].ndropped = 0;
+		}
+	}
+	store->raytrace = MB_NO;
+	store->raytable.valid = MB_NO;
+	store->raytable.svp_hash = 0;
+	store->raytable.svp_n = 0;
+	store->raytable.soundspeed = 0.0;
+	store->raytable.draft = 0.0;
+	store->raytable.nangle = 0;
+	store->raytable.nlayer = 0;
+	if (keeparrays == MB_NO) {
+		store->raytable.nalloc = 0;
+		store->raytable.nvalid = NULL;
+		store->raytable.time = NULL;
+		store->raytable.xx = NULL;
+		store->raytable.zz = NULL;
+		store->raytable.speed = NULL;
+	}
+
+	/* payloads are not shared until the store is copied */
+	for (i = 0; i < R7KSHARE_NUM; i++)
+		store->sharecount[i] = NULL;
+
+	/* per-beam arrays of the version 3 records - allocated to the number
+	    of beams actually read rather than held at MBSYS_RESON7K_MAX_BEAMS */
+	if (keeparrays == MB_NO) {
+		store->s7kr_watercolumn.nalloc = 0;
+		store->s7kr_watercolumn.wcd = NULL;
+		store->s7kr_watercolumn.beam_alongtrack = NULL;
+		store->s7kr_watercolumn.beam_acrosstrack = NULL;
+		store->s7kr_watercolumn.center_sample = NULL;
+		store->detectionsetup.nalloc = 0;
+		store->detectionsetup.beam_descriptor = NULL;
+		store->detectionsetup.detection_point = NULL;
+		store->detectionsetup.flags = NULL;
+		store->detectionsetup.auto_limits_min_sample = NULL;
+		store->detectionsetup.auto_limits_max_sample = NULL;
+		store->detectionsetup.user_limits_min_sample = NULL;
+		store->detectionsetup.user_limits_max_sample = NULL;
+		store->detectionsetup.quality = NULL;
+		store->detectionsetup.uncertainty = NULL;
+		store->beamformed.nalloc = 0;
+		store->beamformed.amplitudephase = NULL;
+		store->vernierprocessingdataraw.nalloc = 0;
+		store->vernierprocessingdataraw.anglemagnitude = NULL;
+		store->rawdetection.nalloc = 0;
+		store->rawdetection.rawdetectiondata = NULL;
+		store->rawdetection.depth = NULL;
+		store->rawdetection.alongtrack = NULL;
+		store->rawdetection.acrosstrack = NULL;
+		store->rawdetection.pointing_angle = NULL;
+		store->rawdetection.azimuth_angle = NULL;
+		store->snippet.nalloc = 0;
+		store->snippet.snippettimeseries = NULL;
+		store->snippet.beam_alongtrack = NULL;
+		store->snippet.beam_acrosstrack = NULL;
+		store->snippet.center_sample = NULL;
+		store->vernierprocessingdatafiltered.nalloc = 0;
+		store->vernierprocessingdatafiltered.vernierprocessingdatasoundings = NULL;
+		store->compressedbeamformedmagnitude.nalloc = 0;
+		store->compressedbeamformedmagnitude.beamformedmagnitude = NULL;
+		store->compressedwatercolumn.nalloc = 0;
+		store->compressedwatercolumn.compressedwatercolumndata = NULL;
+		store->segmentedrawdetection.nalloc = 0;
+		store->segmentedrawdetection.segmentedrawdetectiondata = NULL;
+		store->systemevents.nalloc = 0;
+		store->systemevents.systemeventsdata = NULL;
+		store->subscriptions.nalloc = 0;
+		store->subscriptions.subscriptionsdata = NULL;
+		store->snippetbackscatteringstrength.nalloc = 0;
+		store->snippetbackscatteringstrength.snippetbackscatteringstrengthdata = NULL;
+		store->snippetbackscatteringstrength.beam_alongtrack = NULL;
+		store->snippetbackscatteringstrength.beam_acrosstrack = NULL;
+		store->snippetbackscatteringstrength.center_sample = NULL;
 	}
 
 	/* Reson 7k remote control sonar settings (record 7503) */
@@ -1038,7 +1491,35 @@ int mbsys_reson7k_alloc(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)*store_ptr);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_initstore(int verbose, void *store_ptr, int *error) {
+	char *function_name = "mbsys_reson7k_initstore";
+	int status = MB_SUCCESS;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+	}
+
+	/* initialize a newly allocated store - it holds no arrays yet */
+	status = mbsys_reson7k_zerostore(verbose, store_ptr, MB_NO, error);
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:     %d\n", status);
@@ -1052,6 +1533,60 @@ int mbsys_reson7k_deall(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 	char *function_name = "mbsys_reson7k_deall";
 	int status = MB_SUCCESS;
 	struct mbsys_reson7k_struct *store;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)*store_ptr);
+	}
+
+	/* get data structure pointer */
+	store = (struct mbsys_reson7k_struct *)*store_ptr;
+
+	/* keep the store for reuse if the pool is enabled and has room - its
+	    counts and flags are reset and the arrays it has grown are kept.
+	    A pooled store stays allocated through mb_mallocd(), so mb_memory
+	    lists it until mbsys_reson7k_free_storepool() frees it */
+	if (store != NULL && mbsys_reson7k_storepool_max > 0) {
+		status = mbsys_reson7k_resetstore(verbose, *store_ptr, error);
+		if (status == MB_SUCCESS) {
+			mbsys_reson7k_storepool_acquire();
+			if (mbsys_reson7k_storepool_n < mbsys_reson7k_storepool_max) {
+				mbsys_reson7k_storepool[mbsys_reson7k_storepool_n] = store;
+				mbsys_reson7k_storepool_n++;
+				*store_ptr = NULL;
+			}
+			mbsys_reson7k_storepool_release();
+		}
+	}
+
+	/* otherwise free the store and everything it holds */
+	if (*store_ptr != NULL) {
+		status = mbsys_reson7k_freestore(verbose, store_ptr, error);
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_freestore(int verbose, void **store_ptr, int *error) {
+	char *function_name = "mbsys_reson7k_freestore";
+	int status = MB_SUCCESS;
+	struct mbsys_reson7k_struct *store;
 	s7kr_customattitude *customattitude;
 	s7kr_motion *motion;
 	s7kr_svp *svp;
@@ -1068,9 +1603,12 @@ int mbsys_reson7k_deall(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 	s7kr_tvg *tvg;
 	s7kr_image *image;
 	s7kr_v2pingmotion *v2pingmotion;
+	s7kr_v2detectionsetup *v2detectionsetup;
 	s7kr_v2amplitudephase *amplitudephase;
 	s7kr_v2beamformed *v2beamformed;
 	s7kr_v2bite *v2bite;
+	s7kr_v2detection *v2detection;
+	s7kr_v2rawdetection *v2rawdetection;
 	s7kr_v2snippettimeseries *v2snippettimeseries;
 	s7kr_v2snippet *v2snippet;
 	s7kr_calibratedsnippettimeseries *calibratedsnippettimeseries;
@@ -1078,19 +1616,24 @@ int mbsys_reson7k_deall(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 	s7kr_systemeventmessage *systemeventmessage;
 	int i;
 
+
 	/* print input debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
-		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
 		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)*store_ptr);
 	}
 
 	/* get data structure pointer */
 	store = (struct mbsys_reson7k_struct *)*store_ptr;
 
+	/* let go of payloads shared with copies of this store - arrays still
+	    referenced by other stores are left to them, the rest are freed */
+	for (i = 0; i < R7KSHARE_NUM; i++)
+		status = mbsys_reson7k_release_payload(verbose, (void *)store, i, error);
+
 	/* Custom attitude (record 1004) */
 	customattitude = &store->customattitude;
 	customattitude->n = 0;
@@ -1201,12 +1744,16 @@ int mbsys_reson7k_deall(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 
 	/* Reson 7k configuration (record 7001) */
 	configuration = &store->configuration;
-	for (i = 0; i < MBSYS_RESON7K_MAX_DEVICE; i++) {
+	for (i = 0; i < configuration->nalloc; i++) {
 		configuration->device[i].info_length = 0;
 		configuration->device[i].info_alloc = 0;
 		if (configuration->device[i].info != NULL)
 			status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(configuration->device[i].info), error);
 	}
+	configuration->number_devices = 0;
+	configuration->nalloc = 0;
+	if (configuration->device != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(configuration->device), error);
 
 	/* Reson 7k firmware and hardware configuration (record 7003) */
 	v2firmwarehardwareconfiguration = &store->v2firmwarehardwareconfiguration;
@@ -1268,6 +1815,29 @@ int mbsys_reson7k_deall(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 	if (v2pingmotion->heave != NULL)
 		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(v2pingmotion->heave), error);
 
+	/* Reson 7k version 2 detection setup (record 7017) */
+	v2detectionsetup = &store->v2detectionsetup;
+	v2detectionsetup->number_beams = 0;
+	v2detectionsetup->nalloc = 0;
+	if (v2detectionsetup->beam_descriptor != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(v2detectionsetup->beam_descriptor), error);
+	if (v2detectionsetup->detection_point != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(v2detectionsetup->detection_point), error);
+	if (v2detectionsetup->flags != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(v2detectionsetup->flags), error);
+	if (v2detectionsetup->auto_limits_min_sample != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(v2detectionsetup->auto_limits_min_sample), error);
+	if (v2detectionsetup->auto_limits_max_sample != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(v2detectionsetup->auto_limits_max_sample), error);
+	if (v2detectionsetup->user_limits_min_sample != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(v2detectionsetup->user_limits_min_sample), error);
+	if (v2detectionsetup->user_limits_max_sample != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(v2detectionsetup->user_limits_max_sample), error);
+	if (v2detectionsetup->quality != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(v2detectionsetup->quality), error);
+	if (v2detectionsetup->uncertainty != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(v2detectionsetup->uncertainty), error);
+
 	/* Reson 7k beamformed magnitude and phase data (record 7018) */
 	v2beamformed = &store->v2beamformed;
 	for (i = 0; i < MBSYS_RESON7K_MAX_BEAMS; i++) {
@@ -1287,6 +1857,40 @@ int mbsys_reson7k_deall(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 	if (v2bite->reports != NULL)
 		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(v2bite->reports), error);
 
+	/* Reson 7k version 2 detection (record 7026) */
+	v2detection = &store->v2detection;
+	v2detection->number_beams = 0;
+	v2detection->nalloc = 0;
+	if (v2detection->range != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(v2detection->range), error);
+	if (v2detection->angle_x != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(v2detection->angle_x), error);
+	if (v2detection->angle_y != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(v2detection->angle_y), error);
+	if (v2detection->range_error != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(v2detection->range_error), error);
+	if (v2detection->angle_x_error != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(v2detection->angle_x_error), error);
+	if (v2detection->angle_y_error != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(v2detection->angle_y_error), error);
+
+	/* Reson 7k version 2 raw detection (record 7027) */
+	v2rawdetection = &store->v2rawdetection;
+	v2rawdetection->number_beams = 0;
+	v2rawdetection->nalloc = 0;
+	if (v2rawdetection->beam_descriptor != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(v2rawdetection->beam_descriptor), error);
+	if (v2rawdetection->detection_point != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(v2rawdetection->detection_point), error);
+	if (v2rawdetection->rx_angle != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(v2rawdetection->rx_angle), error);
+	if (v2rawdetection->flags != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(v2rawdetection->flags), error);
+	if (v2rawdetection->quality != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(v2rawdetection->quality), error);
+	if (v2rawdetection->uncertainty != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(v2rawdetection->uncertainty), error);
+
 	/* Reson 7k version 2 snippet (record 7028) */
 	v2snippet = &store->v2snippet;
 	v2snippet->number_beams = 0;
@@ -1323,6 +1927,358 @@ int mbsys_reson7k_deall(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 			status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(calibratedsnippettimeseries->amplitude), error);
 	}
 
+	/* raw record pass-through */
+	for (i = 0; i < R7KRAW_NUM; i++) {
+		store->rawrecord[i].recordid = R7KRECID_None;
+		store->rawrecord[i].modified = MB_NO;
+		store->rawrecord[i].size = 0;
+		store->rawrecord[i].nalloc = 0;
+		if (store->rawrecord[i].buffer != NULL)
+			status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->rawrecord[i].buffer), error);
+	}
+
+	/* file catalog */
+	store->filecatalogrecord.records_n = 0;
+	store->filecatalogrecord.nalloc = 0;
+	if (store->filecatalogrecord.filecatalogrecorddata != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->filecatalogrecord.filecatalogrecorddata), error);
+	store->filecatalogwrite.fileheader_size = 0;
+	store->filecatalogwrite.fileheader_nalloc = 0;
+	if (store->filecatalogwrite.fileheader != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->filecatalogwrite.fileheader), error);
+	store->fileindex.source = MBSYS_RESON7K_FILEINDEX_NONE;
+	store->fileindex.n = 0;
+	store->fileindex.nalloc = 0;
+	if (store->fileindex.offset != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->fileindex.offset), error);
+	if (store->fileindex.recordid != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->fileindex.recordid), error);
+	if (store->fileindex.time_d != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->fileindex.time_d), error);
+	if (store->fileindex.time_max != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->fileindex.time_max), error);
+
+	/* ping record encoding buffers - the write queue is emptied and freed
+	    by the format when the output file is closed */
+	status = mbsys_reson7k_free_encodeping(verbose, &(store->encodeping), error);
+
+	/* Reson 7k beam geometry (record 7004) */
+	store->beamgeometry.number_beams = 0;
+	store->beamgeometry.nalloc = 0;
+	if (store->beamgeometry.angle_alongtrack != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->beamgeometry.angle_alongtrack), error);
+	if (store->beamgeometry.angle_acrosstrack != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->beamgeometry.angle_acrosstrack), error);
+	if (store->beamgeometry.beamwidth_alongtrack != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->beamgeometry.beamwidth_alongtrack), error);
+	if (store->beamgeometry.beamwidth_acrosstrack != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->beamgeometry.beamwidth_acrosstrack), error);
+
+	/* Reson 7k bathymetry (record 7006) */
+	store->bathymetry.number_beams = 0;
+	store->bathymetry.nalloc = 0;
+	if (store->bathymetry.range != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->bathymetry.range), error);
+	if (store->bathymetry.quality != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->bathymetry.quality), error);
+	if (store->bathymetry.intensity != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->bathymetry.intensity), error);
+	if (store->bathymetry.min_depth_gate != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->bathymetry.min_depth_gate), error);
+	if (store->bathymetry.max_depth_gate != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->bathymetry.max_depth_gate), error);
+	if (store->bathymetry.depth != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->bathymetry.depth), error);
+	if (store->bathymetry.alongtrack != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->bathymetry.alongtrack), error);
+	if (store->bathymetry.acrosstrack != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->bathymetry.acrosstrack), error);
+	if (store->bathymetry.pointing_angle != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->bathymetry.pointing_angle), error);
+	if (store->bathymetry.azimuth_angle != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->bathymetry.azimuth_angle), error);
+
+	/* sidescan generation scratch arrays */
+	store->makessscratch.nalloc = 0;
+	if (store->makessscratch.bathsort != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->makessscratch.bathsort), error);
+	if (store->makessscratch.beamflag != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->makessscratch.beamflag), error);
+	if (store->makessscratch.rangetable != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->makessscratch.rangetable), error);
+	if (store->makessscratch.acrosstracktable != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->makessscratch.acrosstracktable), error);
+	if (store->makessscratch.alongtracktable != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->makessscratch.alongtracktable), error);
+	store->makessscratch.footvalid = MB_NO;
+	if (store->makessscratch.footcos != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->makessscratch.footcos), error);
+	if (store->makessscratch.footsint != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->makessscratch.footsint), error);
+	status = mbsys_reson7k_free_sidescangrid(verbose, &(store->makessscratch.grid), error);
+	status = mbsys_reson7k_free_sidescangrid(verbose, &(store->makessscratch.hiresgrid), error);
+	store->makessscratch.nthreadalloc = 0;
+	if (store->makessscratch.threadss != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->makessscratch.threadss), error);
+	if (store->makessscratch.threadssalongtrack != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->makessscratch.threadssalongtrack), error);
+	if (store->makessscratch.threadsscnt != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->makessscratch.threadsscnt), error);
+	store->makessscratch.nlistalloc = 0;
+	if (store->makessscratch.listpixel != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->makessscratch.listpixel), error);
+	if (store->makessscratch.listamplitude != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->makessscratch.listamplitude), error);
+	if (store->makessscratch.listalongtrack != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->makessscratch.listalongtrack), error);
+	store->beamattitude.nalloc = 0;
+	if (store->beamattitude.time_d != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->beamattitude.time_d), error);
+	if (store->beamattitude.index != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->beamattitude.index), error);
+	if (store->beamattitude.beamid != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->beamattitude.beamid), error);
+	if (store->beamattitude.weight != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->beamattitude.weight), error);
+	if (store->beamattitude.roll != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->beamattitude.roll), error);
+	if (store->beamattitude.pitch != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->beamattitude.pitch), error);
+	if (store->beamattitude.heave != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->beamattitude.heave), error);
+	if (store->beamattitude.heading != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->beamattitude.heading), error);
+	if (store->beamattitude.tx_steer != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->beamattitude.tx_steer), error);
+	if (store->beamattitude.rx_steer != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->beamattitude.rx_steer), error);
+	if (store->beamattitude.range != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->beamattitude.range), error);
+	if (store->beamattitude.azimuth != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->beamattitude.azimuth), error);
+	if (store->beamattitude.depression != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->beamattitude.depression), error);
+	if (store->beamattitude.acrosstrack != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->beamattitude.acrosstrack), error);
+	if (store->beamattitude.alongtrack != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->beamattitude.alongtrack), error);
+	if (store->beamattitude.depth != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->beamattitude.depth), error);
+	store->attitudeseries.nalloc = 0;
+	if (store->attitudeseries.time_d != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->attitudeseries.time_d), error);
+	if (store->attitudeseries.roll != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->attitudeseries.roll), error);
+	if (store->attitudeseries.pitch != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->attitudeseries.pitch), error);
+	if (store->attitudeseries.heave != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->attitudeseries.heave), error);
+	if (store->attitudeseries.heading != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->attitudeseries.heading), error);
+	if (store->attitudeseries.index != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->attitudeseries.index), error);
+	if (store->attitudeseries.weight != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->attitudeseries.weight), error);
+	for (i = 0; i < MBSYS_RESON7K_TSERIES_NUM; i++) {
+		status = mbsys_reson7k_tseries_free(verbose, &(store->tseries[i]), error);
+		status = mbsys_reson7k_tseries_free(verbose, &(store->tseries_preprocess[i]), error);
+	}
+	store->raytable.valid = MB_NO;
+	store->raytable.nalloc = 0;
+	if (store->raytable.nvalid != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->raytable.nvalid), error);
+	if (store->raytable.time != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->raytable.time), error);
+	if (store->raytable.xx != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->raytable.xx), error);
+	if (store->raytable.zz != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->raytable.zz), error);
+	if (store->raytable.speed != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->raytable.speed), error);
+
+	/* per-beam arrays of the version 3 records */
+
+	/* Reson 7k water column (record 7008) */
+	for (i = 0; i < store->s7kr_watercolumn.nalloc; i++) {
+		store->s7kr_watercolumn.wcd[i].n = 0;
+		store->s7kr_watercolumn.wcd[i].nalloc = 0;
+		if (store->s7kr_watercolumn.wcd[i].descriptor != NULL)
+			status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->s7kr_watercolumn.wcd[i].descriptor), error);
+		if (store->s7kr_watercolumn.wcd[i].first_sample != NULL)
+			status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->s7kr_watercolumn.wcd[i].first_sample), error);
+		if (store->s7kr_watercolumn.wcd[i].last_sample != NULL)
+			status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->s7kr_watercolumn.wcd[i].last_sample), error);
+	}
+	store->s7kr_watercolumn.nalloc = 0;
+	if (store->s7kr_watercolumn.wcd != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->s7kr_watercolumn.wcd), error);
+	if (store->s7kr_watercolumn.beam_alongtrack != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->s7kr_watercolumn.beam_alongtrack), error);
+	if (store->s7kr_watercolumn.beam_acrosstrack != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->s7kr_watercolumn.beam_acrosstrack), error);
+	if (store->s7kr_watercolumn.center_sample != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->s7kr_watercolumn.center_sample), error);
+
+	/* Reson 7k detection setup (record 7017) */
+	store->detectionsetup.nalloc = 0;
+	if (store->detectionsetup.beam_descriptor != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->detectionsetup.beam_descriptor), error);
+	if (store->detectionsetup.detection_point != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->detectionsetup.detection_point), error);
+	if (store->detectionsetup.flags != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->detectionsetup.flags), error);
+	if (store->detectionsetup.auto_limits_min_sample != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->detectionsetup.auto_limits_min_sample), error);
+	if (store->detectionsetup.auto_limits_max_sample != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->detectionsetup.auto_limits_max_sample), error);
+	if (store->detectionsetup.user_limits_min_sample != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->detectionsetup.user_limits_min_sample), error);
+	if (store->detectionsetup.user_limits_max_sample != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->detectionsetup.user_limits_max_sample), error);
+	if (store->detectionsetup.quality != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->detectionsetup.quality), error);
+	if (store->detectionsetup.uncertainty != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->detectionsetup.uncertainty), error);
+
+	/* Reson 7k beamformed data (record 7018) */
+	for (i = 0; i < store->beamformed.nalloc; i++) {
+		store->beamformed.amplitudephase[i].n = 0;
+		store->beamformed.amplitudephase[i].nalloc = 0;
+		if (store->beamformed.amplitudephase[i].amplitude != NULL)
+			status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->beamformed.amplitudephase[i].amplitude), error);
+		if (store->beamformed.amplitudephase[i].phase != NULL)
+			status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->beamformed.amplitudephase[i].phase), error);
+	}
+	store->beamformed.nalloc = 0;
+	if (store->beamformed.amplitudephase != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->beamformed.amplitudephase), error);
+
+	/* Reson 7k vernier processing raw data (record 7019) */
+	for (i = 0; i < store->vernierprocessingdataraw.nalloc; i++) {
+		store->vernierprocessingdataraw.anglemagnitude[i].n = 0;
+		store->vernierprocessingdataraw.anglemagnitude[i].nalloc = 0;
+		if (store->vernierprocessingdataraw.anglemagnitude[i].angle != NULL)
+			status = mb_freed(verbose, __FILE__, __LINE__,
+			                  (void **)&(store->vernierprocessingdataraw.anglemagnitude[i].angle), error);
+		if (store->vernierprocessingdataraw.anglemagnitude[i].magnitude != NULL)
+			status = mb_freed(verbose, __FILE__, __LINE__,
+			                  (void **)&(store->vernierprocessingdataraw.anglemagnitude[i].magnitude), error);
+		if (store->vernierprocessingdataraw.anglemagnitude[i].coherence != NULL)
+			status = mb_freed(verbose, __FILE__, __LINE__,
+			                  (void **)&(store->vernierprocessingdataraw.anglemagnitude[i].coherence), error);
+		if (store->vernierprocessingdataraw.anglemagnitude[i].cross_power != NULL)
+			status = mb_freed(verbose, __FILE__, __LINE__,
+			                  (void **)&(store->vernierprocessingdataraw.anglemagnitude[i].cross_power), error);
+		if (store->vernierprocessingdataraw.anglemagnitude[i].quality_factor != NULL)
+			status = mb_freed(verbose, __FILE__, __LINE__,
+			                  (void **)&(store->vernierprocessingdataraw.anglemagnitude[i].quality_factor), error);
+		if (store->vernierprocessingdataraw.anglemagnitude[i].reserved != NULL)
+			status = mb_freed(verbose, __FILE__, __LINE__,
+			                  (void **)&(store->vernierprocessingdataraw.anglemagnitude[i].reserved), error);
+	}
+	store->vernierprocessingdataraw.nalloc = 0;
+	if (store->vernierprocessingdataraw.anglemagnitude != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->vernierprocessingdataraw.anglemagnitude), error);
+
+	/* Reson 7k raw detection (record 7027) */
+	store->rawdetection.nalloc = 0;
+	if (store->rawdetection.rawdetectiondata != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->rawdetection.rawdetectiondata), error);
+	if (store->rawdetection.depth != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->rawdetection.depth), error);
+	if (store->rawdetection.alongtrack != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->rawdetection.alongtrack), error);
+	if (store->rawdetection.acrosstrack != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->rawdetection.acrosstrack), error);
+	if (store->rawdetection.pointing_angle != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->rawdetection.pointing_angle), error);
+	if (store->rawdetection.azimuth_angle != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->rawdetection.azimuth_angle), error);
+
+	/* Reson 7k snippet (record 7028) */
+	for (i = 0; i < store->snippet.nalloc; i++) {
+		store->snippet.snippettimeseries[i].nalloc = 0;
+		if (store->snippet.snippettimeseries[i].amplitude != NULL)
+			status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->snippet.snippettimeseries[i].amplitude), error);
+	}
+	store->snippet.nalloc = 0;
+	if (store->snippet.snippettimeseries != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->snippet.snippettimeseries), error);
+	if (store->snippet.beam_alongtrack != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->snippet.beam_alongtrack), error);
+	if (store->snippet.beam_acrosstrack != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->snippet.beam_acrosstrack), error);
+	if (store->snippet.center_sample != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->snippet.center_sample), error);
+
+	/* Reson 7k vernier processing filtered data (record 7029) */
+	store->vernierprocessingdatafiltered.nalloc = 0;
+	if (store->vernierprocessingdatafiltered.vernierprocessingdatasoundings != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__,
+		                  (void **)&(store->vernierprocessingdatafiltered.vernierprocessingdatasoundings), error);
+
+	/* Reson 7k compressed beamformed magnitude (record 7041) */
+	for (i = 0; i < store->compressedbeamformedmagnitude.nalloc; i++) {
+		store->compressedbeamformedmagnitude.beamformedmagnitude[i].samples = 0;
+		store->compressedbeamformedmagnitude.beamformedmagnitude[i].nalloc = 0;
+		if (store->compressedbeamformedmagnitude.beamformedmagnitude[i].data != NULL)
+			status = mb_freed(verbose, __FILE__, __LINE__,
+			                  (void **)&(store->compressedbeamformedmagnitude.beamformedmagnitude[i].data), error);
+	}
+	store->compressedbeamformedmagnitude.nalloc = 0;
+	if (store->compressedbeamformedmagnitude.beamformedmagnitude != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__,
+		                  (void **)&(store->compressedbeamformedmagnitude.beamformedmagnitude), error);
+
+	/* Reson 7k compressed water column (record 7042) */
+	for (i = 0; i < store->compressedwatercolumn.nalloc; i++) {
+		store->compressedwatercolumn.compressedwatercolumndata[i].samples = 0;
+		store->compressedwatercolumn.compressedwatercolumndata[i].nalloc = 0;
+		if (store->compressedwatercolumn.compressedwatercolumndata[i].sample != NULL)
+			status = mb_freed(verbose, __FILE__, __LINE__,
+			                  (void **)&(store->compressedwatercolumn.compressedwatercolumndata[i].sample), error);
+	}
+	store->compressedwatercolumn.nalloc = 0;
+	if (store->compressedwatercolumn.compressedwatercolumndata != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->compressedwatercolumn.compressedwatercolumndata), error);
+
+	/* Reson 7k segmented raw detection (record 7047) */
+	store->segmentedrawdetection.nalloc = 0;
+	if (store->segmentedrawdetection.segmentedrawdetectiondata != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->segmentedrawdetection.segmentedrawdetectiondata), error);
+
+	/* Reson 7k system events (record 7050) */
+	store->systemevents.nalloc = 0;
+	if (store->systemevents.systemeventsdata != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->systemevents.systemeventsdata), error);
+
+	/* Reson 7k subscriptions (record 7053) */
+	store->subscriptions.nalloc = 0;
+	if (store->subscriptions.subscriptionsdata != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->subscriptions.subscriptionsdata), error);
+
+	/* Reson 7k snippet backscattering strength (record 7058) */
+	for (i = 0; i < store->snippetbackscatteringstrength.nalloc; i++) {
+		store->snippetbackscatteringstrength.snippetbackscatteringstrengthdata[i].nalloc = 0;
+		if (store->snippetbackscatteringstrength.snippetbackscatteringstrengthdata[i].bs != NULL)
+			status = mb_freed(verbose, __FILE__, __LINE__,
+			                  (void **)&(store->snippetbackscatteringstrength.snippetbackscatteringstrengthdata[i].bs), error);
+		if (store->snippetbackscatteringstrength.snippetbackscatteringstrengthdata[i].footprints != NULL)
+			status = mb_freed(verbose, __FILE__, __LINE__,
+			                  (void **)&(store->snippetbackscatteringstrength.snippetbackscatteringstrengthdata[i].footprints),
+			                  error);
+	}
+	store->snippetbackscatteringstrength.nalloc = 0;
+	if (store->snippetbackscatteringstrength.snippetbackscatteringstrengthdata != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__,
+		                  (void **)&(store->snippetbackscatteringstrength.snippetbackscatteringstrengthdata), error);
+	if (store->snippetbackscatteringstrength.beam_alongtrack != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->snippetbackscatteringstrength.beam_alongtrack), error);
+	if (store->snippetbackscatteringstrength.beam_acrosstrack != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->snippetbackscatteringstrength.beam_acrosstrack), error);
+	if (store->snippetbackscatteringstrength.center_sample != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->snippetbackscatteringstrength.center_sample), error);
+
 	/* deallocate memory for data structure */
 	status = mb_freed(verbose, __FILE__, __LINE__, (void **)store_ptr, error);
 
@@ -1338,22 +2294,11 @@ int mbsys_reson7k_deall(int verbose, void *mbio_ptr, void **store_ptr, int *erro
 	/* return status */
 	return (status);
 }
-
-/*--------------------------------------------------------------------*/
-/* 7K Macros */
-int mbsys_reson7k_checkheader(s7k_header header) {
-	return ((header.Version > 0) && (header.SyncPattern == 0x0000ffff) && (header.Size > MBSYS_RESON7K_RECORDHEADER_SIZE) &&
-	        (header.s7kTime.Day >= 1) && (header.s7kTime.Day <= 366) && (header.s7kTime.Seconds >= 0.0f) &&
-	        (header.s7kTime.Seconds < 60.0f) && (header.s7kTime.Hours <= 23) && (header.s7kTime.Minutes <= 59));
-}
-
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_header(int verbose, s7k_header *header, int *error) {
-	char *function_name = "mbsys_reson7k_print_header";
+int mbsys_reson7k_resetstore(int verbose, void *store_ptr, int *error) {
+	char *function_name = "mbsys_reson7k_resetstore";
 	int status = MB_SUCCESS;
-	char *debug_str = "dbg2  ";
-	char *nodebug_str = "  ";
-	char *first;
+	struct mbsys_reson7k_struct *store;
 	int i;
 
 	/* print input debug statements */
@@ -1362,49 +2307,118 @@ int mbsys_reson7k_print_header(int verbose, s7k_header *header, int *error) {
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
-		fprintf(stderr, "dbg2       header:     %p\n", (void *)header);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
 	}
 
-	/* print Reson 7k data record header information */
-	if (verbose >= 2)
-		first = debug_str;
-	else {
-		first = nodebug_str;
-		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
-	}
-	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     Version:                 %d\n", first, header->Version);
-	fprintf(stderr, "%s     Offset:                  %d\n", first, header->Offset);
-	fprintf(stderr, "%s     SyncPattern:             %d\n", first, header->SyncPattern);
-	fprintf(stderr, "%s     Size:                    %d\n", first, header->Size);
-	fprintf(stderr, "%s     OptionalDataOffset:      %d\n", first, header->OptionalDataOffset);
-	fprintf(stderr, "%s     OptionalDataIdentifier:  %d\n", first, header->OptionalDataIdentifier);
-	fprintf(stderr, "%s     s7kTime.Year:            %d\n", first, header->s7kTime.Year);
-	fprintf(stderr, "%s     s7kTime.Day:             %d\n", first, header->s7kTime.Day);
-	fprintf(stderr, "%s     s7kTime.Seconds:         %f\n", first, header->s7kTime.Seconds);
-	fprintf(stderr, "%s     s7kTime.Hours:           %d\n", first, header->s7kTime.Hours);
-	fprintf(stderr, "%s     7kTime->Minutes:         %d\n", first, header->s7kTime.Minutes);
-	fprintf(stderr, "%s     Reserved:                %d\n", first, header->Reserved);
-	fprintf(stderr, "%s     RecordType:              %d\n", first, header->RecordType);
-	fprintf(stderr, "%s     DeviceId:                %d\n", first, header->DeviceId);
-	fprintf(stderr, "%s     Reserved2:               %d\n", first, header->Reserved2);
-	fprintf(stderr, "%s     SystemEnumerator:        %d\n", first, header->SystemEnumerator);
-	fprintf(stderr, "%s     DataSetNumber:           %d\n", first, header->DataSetNumber);
-	fprintf(stderr, "%s     RecordNumber:            %d\n", first, header->RecordNumber);
-	for (i = 0; i < 8; i++) {
-		fprintf(stderr, "%s     PreviousRecord[%d]:       %d\n", first, i, header->PreviousRecord[i]);
-		fprintf(stderr, "%s     NextRecord[%d]:           %d\n", first, i, header->NextRecord[i]);
-	}
-	fprintf(stderr, "%s     Flags:                   %d\n", first, header->Flags);
-	fprintf(stderr, "%s     Reserved3:               %d\n", first, header->Reserved3);
-	fprintf(stderr, "%s     Reserved4:               %d\n", first, header->Reserved4);
-	fprintf(stderr, "%s     FragmentedTotal:         %d\n", first, header->FragmentedTotal);
-	fprintf(stderr, "%s     FragmentNumber:          %d\n", first, header->FragmentNumber);
+	/* get data structure pointer */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
 
-	/* print output debug statements */
-	if (verbose >= 2) {
-		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
-		fprintf(stderr, "dbg2  Return values:\n");
+	/* let go of payloads shared with copies of this store, keeping the
+	    arrays that this store alone holds */
+	for (i = 0; i < R7KSHARE_NUM; i++)
+		if (store->sharecount[i] != NULL)
+			status = mbsys_reson7k_unshare_payload(verbose, store_ptr, i, MB_NO, error);
+
+	/* reset only the counts and flags that say what the store holds - the
+	    record contents are stale but are overwritten before they are used
+	    again, since nothing is read from a record that its count, the
+	    record kind or read_mask does not cover. This costs the same
+	    whatever the store has grown to, unlike mbsys_reson7k_zerostore() */
+
+	/* Type of data record */
+	store->kind = MB_DATA_NONE;
+	store->type = R7KRECID_None;
+	store->sstype = 0;
+
+	/* ping record id's */
+	store->current_ping_number = -1;
+	store->read_mask = 0;
+
+	/* MB-System time stamp */
+	store->time_d = 0;
+	for (i = 0; i < 7; i++)
+		store->time_i[i] = 0;
+
+	/* raw record pass-through */
+	for (i = 0; i < R7KRAW_NUM; i++) {
+		store->rawrecord[i].recordid = R7KRECID_None;
+		store->rawrecord[i].modified = MB_NO;
+		store->rawrecord[i].size = 0;
+	}
+
+	/* counts of the variable length records */
+	store->customattitude.n = 0;
+	store->motion.n = 0;
+	store->svp.n = 0;
+	store->ctd.n = 0;
+	store->surveyline.n = 0;
+	store->attitude.n = 0;
+	store->configuration.number_devices = 0;
+	store->v2firmwarehardwareconfiguration.device_count = 0;
+	store->v2firmwarehardwareconfiguration.info_length = 0;
+	store->beamgeometry.number_beams = 0;
+	store->bathymetry.number_beams = 0;
+	store->tvg.n = 0;
+	store->v2pingmotion.n = 0;
+	store->v2detectionsetup.number_beams = 0;
+	store->v2beamformed.number_beams = 0;
+	store->v2bite.number_reports = 0;
+	store->v2detection.number_beams = 0;
+	store->v2rawdetection.number_beams = 0;
+	store->v2snippet.number_beams = 0;
+	store->calibratedsnippet.number_beams = 0;
+	store->compressedwatercolumn.number_beams = 0;
+	store->systemeventmessage.message_length = 0;
+	store->fileheader.number_subsystems = 0;
+	store->filecatalogrecord.records_n = 0;
+	store->fileindex.source = MBSYS_RESON7K_FILEINDEX_NONE;
+	store->fileindex.n = 0;
+
+	/* output and processing settings */
+	store->window = MB_NO;
+	store->pingcomplete_mask = 0;
+	store->compresswatercolumn = MB_NO;
+	store->compresswatercolumn_flags = 0;
+	store->encode_threads = 1;
+	store->writequeue_depth = 0;
+	store->preprocess_threads = 1;
+	store->preprocess_makess = MB_YES;
+	store->makess_source = R7KRECID_None;
+	store->makess_threads = 1;
+	store->makess_deterministic = MB_NO;
+	store->encodeping.nrecord = 0;
+	store->encodeping.flags = 0;
+	store->filecatalogwrite.offset = 0;
+	store->filecatalogwrite.fileheader_offset = 0;
+	store->filecatalogwrite.fileheader_size = 0;
+
+	/* cached results derived from earlier pings */
+	store->makessscratch.footvalid = MB_NO;
+	store->makessscratch.grid.npixels = 0;
+	store->raytrace = MB_NO;
+	store->raytable.valid = MB_NO;
+
+	/* time series - the preprocess series may reference the arrays of
+	    another store and are released rather than emptied */
+	for (i = 0; i < MBSYS_RESON7K_TSERIES_NUM; i++) {
+		store->tseries[i].n = 0;
+		store->tseries[i].head = 0;
+		store->tseries[i].cursor = 0;
+		store->tseries[i].ndropped = 0;
+		if (store->tseries_preprocess[i].shared == MB_YES)
+			status = mbsys_reson7k_tseries_free(verbose, &(store->tseries_preprocess[i]), error);
+		store->tseries_preprocess[i].n = 0;
+		store->tseries_preprocess[i].head = 0;
+		store->tseries_preprocess[i].cursor = 0;
+		store->tseries_preprocess[i].source = NULL;
+		store->tseries_preprocess[i].nsource = 0;
+		store->tseries_preprocess[i].ndropped = 0;
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:     %d\n", status);
@@ -1413,44 +2427,59 @@ int mbsys_reson7k_print_header(int verbose, s7k_header *header, int *error) {
 	/* return status */
 	return (status);
 }
-
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_reference(int verbose, s7kr_reference *reference, int *error) {
-	char *function_name = "mbsys_reson7k_print_reference";
+int mbsys_reson7k_alloc_beamgeometry(int verbose, s7kr_beamgeometry *beamgeometry, int nbeams, int *error) {
+	char *function_name = "mbsys_reson7k_alloc_beamgeometry";
 	int status = MB_SUCCESS;
-	char *debug_str = "dbg2  ";
-	char *nodebug_str = "  ";
-	char *first;
+	int nalloc;
+	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
-		fprintf(stderr, "dbg2       reference:  %p\n", (void *)reference);
+		fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
+		fprintf(stderr, "dbg2       beamgeometry: %p\n", (void *)beamgeometry);
+		fprintf(stderr, "dbg2       nalloc:       %u\n", beamgeometry->nalloc);
+		fprintf(stderr, "dbg2       nbeams:       %d\n", nbeams);
 	}
 
-	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &reference->header, error);
-
-	/* print Reference point information (record 1000) */
-	if (verbose >= 2)
-		first = debug_str;
-	else {
-		first = nodebug_str;
-		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
+	/* grow the beam arrays if needed - at least doubling so that a slowly
+	    increasing beam count does not reallocate on every ping */
+	if (nbeams > (int)beamgeometry->nalloc) {
+		nalloc = MAX(nbeams, 2 * (int)beamgeometry->nalloc);
+		status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(f32), (void **)&(beamgeometry->angle_alongtrack),
+		                     error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(f32),
+			                     (void **)&(beamgeometry->angle_acrosstrack), error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(f32),
+			                     (void **)&(beamgeometry->beamwidth_alongtrack), error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(f32),
+			                     (void **)&(beamgeometry->beamwidth_acrosstrack), error);
+		if (status == MB_SUCCESS) {
+			for (i = beamgeometry->nalloc; i < nalloc; i++) {
+				beamgeometry->angle_alongtrack[i] = 0.0;
+				beamgeometry->angle_acrosstrack[i] = 0.0;
+				beamgeometry->beamwidth_alongtrack[i] = 0.0;
+				beamgeometry->beamwidth_acrosstrack[i] = 0.0;
+			}
+			beamgeometry->nalloc = nalloc;
+		}
+		else {
+			beamgeometry->nalloc = 0;
+			beamgeometry->number_beams = 0;
+		}
 	}
-	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     offset_x:                %f\n", first, reference->offset_x);
-	fprintf(stderr, "%s     offset_y:                %f\n", first, reference->offset_y);
-	fprintf(stderr, "%s     offset_z:                %f\n", first, reference->offset_z);
-	fprintf(stderr, "%s     water_z:                 %f\n", first, reference->water_z);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       nalloc:     %u\n", beamgeometry->nalloc);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:     %d\n", status);
@@ -1459,46 +2488,77 @@ int mbsys_reson7k_print_reference(int verbose, s7kr_reference *reference, int *e
 	/* return status */
 	return (status);
 }
-
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_sensoruncal(int verbose, s7kr_sensoruncal *sensoruncal, int *error) {
-	char *function_name = "mbsys_reson7k_print_sensoruncal";
+int mbsys_reson7k_alloc_bathymetry(int verbose, s7kr_bathymetry *bathymetry, int nbeams, int *error) {
+	char *function_name = "mbsys_reson7k_alloc_bathymetry";
 	int status = MB_SUCCESS;
-	char *debug_str = "dbg2  ";
-	char *nodebug_str = "  ";
-	char *first;
+	int nalloc;
+	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
-		fprintf(stderr, "dbg2       sensoruncal:  %p\n", (void *)sensoruncal);
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       bathymetry: %p\n", (void *)bathymetry);
+		fprintf(stderr, "dbg2       nalloc:     %u\n", bathymetry->nalloc);
+		fprintf(stderr, "dbg2       nbeams:     %d\n", nbeams);
 	}
 
-	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &sensoruncal->header, error);
-
-	/* print Sensor uncalibrated offset position information (record 1001) */
-	if (verbose >= 2)
-		first = debug_str;
-	else {
-		first = nodebug_str;
-		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
+	/* grow the beam arrays if needed - at least doubling so that a slowly
+	    increasing beam count does not reallocate on every ping */
+	if (nbeams > (int)bathymetry->nalloc) {
+		nalloc = MAX(nbeams, 2 * (int)bathymetry->nalloc);
+		status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(f32), (void **)&(bathymetry->range), error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(u8), (void **)&(bathymetry->quality), error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(f32), (void **)&(bathymetry->intensity), error);
+		if (status == MB_SUCCESS)
+			status =
+			    mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(f32), (void **)&(bathymetry->min_depth_gate), error);
+		if (status == MB_SUCCESS)
+			status =
+			    mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(f32), (void **)&(bathymetry->max_depth_gate), error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(f32), (void **)&(bathymetry->depth), error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(f32), (void **)&(bathymetry->alongtrack), error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(f32), (void **)&(bathymetry->acrosstrack), error);
+		if (status == MB_SUCCESS)
+			status =
+			    mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(f32), (void **)&(bathymetry->pointing_angle), error);
+		if (status == MB_SUCCESS)
+			status =
+			    mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(f32), (void **)&(bathymetry->azimuth_angle), error);
+		if (status == MB_SUCCESS) {
+			for (i = bathymetry->nalloc; i < nalloc; i++) {
+				bathymetry->range[i] = 0.0;
+				bathymetry->quality[i] = 0;
+				bathymetry->intensity[i] = 0.0;
+				bathymetry->min_depth_gate[i] = 0.0;
+				bathymetry->max_depth_gate[i] = 0.0;
+				bathymetry->depth[i] = 0.0;
+				bathymetry->alongtrack[i] = 0.0;
+				bathymetry->acrosstrack[i] = 0.0;
+				bathymetry->pointing_angle[i] = 0.0;
+				bathymetry->azimuth_angle[i] = 0.0;
+			}
+			bathymetry->nalloc = nalloc;
+		}
+		else {
+			bathymetry->nalloc = 0;
+			bathymetry->number_beams = 0;
+		}
 	}
-	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     offset_x:                %f\n", first, sensoruncal->offset_x);
-	fprintf(stderr, "%s     offset_y:                %f\n", first, sensoruncal->offset_y);
-	fprintf(stderr, "%s     offset_z:                %f\n", first, sensoruncal->offset_z);
-	fprintf(stderr, "%s     offset_roll:             %f\n", first, sensoruncal->offset_roll);
-	fprintf(stderr, "%s     offset_pitch:            %f\n", first, sensoruncal->offset_pitch);
-	fprintf(stderr, "%s     offset_yaw:              %f\n", first, sensoruncal->offset_yaw);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       nalloc:     %u\n", bathymetry->nalloc);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:     %d\n", status);
@@ -1507,45 +2567,79 @@ int mbsys_reson7k_print_sensoruncal(int verbose, s7kr_sensoruncal *sensoruncal,
 	/* return status */
 	return (status);
 }
-
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_sensorcal(int verbose, s7kr_sensorcal *sensorcal, int *error) {
-	char *function_name = "mbsys_reson7k_print_sensorcal";
+int mbsys_reson7k_alloc_v2detectionsetup(int verbose, s7kr_v2detectionsetup *v2detectionsetup, int nbeams, int *error) {
+	char *function_name = "mbsys_reson7k_alloc_v2detectionsetup";
 	int status = MB_SUCCESS;
-	char *debug_str = "dbg2  ";
-	char *nodebug_str = "  ";
-	char *first;
+	int nalloc;
+	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
-		fprintf(stderr, "dbg2       sensorcal:    %p\n", (void *)sensorcal);
-	}
-
-	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &sensorcal->header, error);
-
-	/* print Sensor Calibrated offset position information (record 1001) */
-	if (verbose >= 2)
-		first = debug_str;
-	else {
-		first = nodebug_str;
+		fprintf(stderr, "dbg2       verbose:          %d\n", verbose);
+		fprintf(stderr, "dbg2       v2detectionsetup: %p\n", (void *)v2detectionsetup);
+		fprintf(stderr, "dbg2       nalloc:           %u\n", v2detectionsetup->nalloc);
+		fprintf(stderr, "dbg2       nbeams:           %d\n", nbeams);
+	}
+
+	/* grow the beam arrays if needed - at least doubling so that a slowly
+	    increasing beam count does not reallocate on every ping */
+	if (nbeams > (int)v2detectionsetup->nalloc) {
+		nalloc = MAX(nbeams, 2 * (int)v2detectionsetup->nalloc);
+		status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(u16),
+		                     (void **)&(v2detectionsetup->beam_descriptor), error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(f32),
+			                     (void **)&(v2detectionsetup->detection_point), error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(u32), (void **)&(v2detectionsetup->flags),
+			                     error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(u32),
+			                     (void **)&(v2detectionsetup->auto_limits_min_sample), error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(u32),
+			                     (void **)&(v2detectionsetup->auto_limits_max_sample), error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(u32),
+			                     (void **)&(v2detectionsetup->user_limits_min_sample), error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(u32),
+			                     (void **)&(v2detectionsetup->user_limits_max_sample), error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(u32), (void **)&(v2detectionsetup->quality),
+			                     error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(f32),
+			                     (void **)&(v2detectionsetup->uncertainty), error);
+		if (status == MB_SUCCESS) {
+			for (i = v2detectionsetup->nalloc; i < nalloc; i++) {
+				v2detectionsetup->beam_descriptor[i] = 0;
+				v2detectionsetup->detection_point[i] = 0.0;
+				v2detectionsetup->flags[i] = 0;
+				v2detectionsetup->auto_limits_min_sample[i] = 0;
+				v2detectionsetup->auto_limits_max_sample[i] = 0;
+				v2detectionsetup->user_limits_min_sample[i] = 0;
+				v2detectionsetup->user_limits_max_sample[i] = 0;
+				v2detectionsetup->quality[i] = 0;
+				v2detectionsetup->uncertainty[i] = 0.0;
+			}
+			v2detectionsetup->nalloc = nalloc;
+		}
+		else {
+			v2detectionsetup->nalloc = 0;
+			v2detectionsetup->number_beams = 0;
+		}
 	}
-	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     offset_x:                %f\n", first, sensorcal->offset_x);
-	fprintf(stderr, "%s     offset_y:                %f\n", first, sensorcal->offset_y);
-	fprintf(stderr, "%s     offset_z:                %f\n", first, sensorcal->offset_z);
-	fprintf(stderr, "%s     offset_roll:             %f\n", first, sensorcal->offset_roll);
-	fprintf(stderr, "%s     offset_pitch:            %f\n", first, sensorcal->offset_pitch);
-	fprintf(stderr, "%s     offset_yaw:              %f\n", first, sensorcal->offset_yaw);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       nalloc:     %u\n", v2detectionsetup->nalloc);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:     %d\n", status);
@@ -1554,49 +2648,64 @@ int mbsys_reson7k_print_sensorcal(int verbose, s7kr_sensorcal *sensorcal, int *e
 	/* return status */
 	return (status);
 }
-
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_position(int verbose, s7kr_position *position, int *error) {
-	char *function_name = "mbsys_reson7k_print_position";
+int mbsys_reson7k_alloc_v2detection(int verbose, s7kr_v2detection *v2detection, int nbeams, int *error) {
+	char *function_name = "mbsys_reson7k_alloc_v2detection";
 	int status = MB_SUCCESS;
-	char *debug_str = "dbg2  ";
-	char *nodebug_str = "  ";
-	char *first;
+	int nalloc;
+	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
-		fprintf(stderr, "dbg2       position:     %p\n", (void *)position);
+		fprintf(stderr, "dbg2       verbose:     %d\n", verbose);
+		fprintf(stderr, "dbg2       v2detection: %p\n", (void *)v2detection);
+		fprintf(stderr, "dbg2       nalloc:      %u\n", v2detection->nalloc);
+		fprintf(stderr, "dbg2       nbeams:      %d\n", nbeams);
 	}
 
-	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &position->header, error);
-
-	/* print Sensor Calibrated offset position information (record 1001) */
-	if (verbose >= 2)
-		first = debug_str;
-	else {
-		first = nodebug_str;
-		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
+	/* grow the beam arrays if needed - at least doubling so that a slowly
+	    increasing beam count does not reallocate on every ping */
+	if (nbeams > (int)v2detection->nalloc) {
+		nalloc = MAX(nbeams, 2 * (int)v2detection->nalloc);
+		status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(f32), (void **)&(v2detection->range), error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(f32), (void **)&(v2detection->angle_x), error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(f32), (void **)&(v2detection->angle_y), error);
+		if (status == MB_SUCCESS)
+			status =
+			    mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(f32), (void **)&(v2detection->range_error), error);
+		if (status == MB_SUCCESS)
+			status =
+			    mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(f32), (void **)&(v2detection->angle_x_error), error);
+		if (status == MB_SUCCESS)
+			status =
+			    mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(f32), (void **)&(v2detection->angle_y_error), error);
+		if (status == MB_SUCCESS) {
+			for (i = v2detection->nalloc; i < nalloc; i++) {
+				v2detection->range[i] = 0.0;
+				v2detection->angle_x[i] = 0.0;
+				v2detection->angle_y[i] = 0.0;
+				v2detection->range_error[i] = 0.0;
+				v2detection->angle_x_error[i] = 0.0;
+				v2detection->angle_y_error[i] = 0.0;
+			}
+			v2detection->nalloc = nalloc;
+		}
+		else {
+			v2detection->nalloc = 0;
+			v2detection->number_beams = 0;
+		}
 	}
-	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     datum:                   %d\n", first, position->datum);
-	fprintf(stderr, "%s     latency:                 %f\n", first, position->latency);
-	fprintf(stderr, "%s     latitude:                %f\n", first, position->latitude);
-	fprintf(stderr, "%s     longitude:               %f\n", first, position->longitude);
-	fprintf(stderr, "%s     height:                  %f\n", first, position->height);
-	fprintf(stderr, "%s     type:                    %d\n", first, position->type);
-	fprintf(stderr, "%s     utm_zone:                %d\n", first, position->utm_zone);
-	fprintf(stderr, "%s     quality:                 %d\n", first, position->quality);
-	fprintf(stderr, "%s     method:                  %d\n", first, position->method);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       nalloc:     %u\n", v2detection->nalloc);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:     %d\n", status);
@@ -1605,14 +2714,11 @@ int mbsys_reson7k_print_position(int verbose, s7kr_position *position, int *erro
 	/* return status */
 	return (status);
 }
-
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_customattitude(int verbose, s7kr_customattitude *customattitude, int *error) {
-	char *function_name = "mbsys_reson7k_print_customattitude";
+int mbsys_reson7k_alloc_v2rawdetection(int verbose, s7kr_v2rawdetection *v2rawdetection, int nbeams, int *error) {
+	char *function_name = "mbsys_reson7k_alloc_v2rawdetection";
 	int status = MB_SUCCESS;
-	char *debug_str = "dbg2  ";
-	char *nodebug_str = "  ";
-	char *first;
+	int nalloc;
 	int i;
 
 	/* print input debug statements */
@@ -1620,38 +2726,54 @@ int mbsys_reson7k_print_customattitude(int verbose, s7kr_customattitude *customa
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:       %d\n", verbose);
-		fprintf(stderr, "dbg2       customattitude:%p\n", (void *)customattitude);
+		fprintf(stderr, "dbg2       verbose:        %d\n", verbose);
+		fprintf(stderr, "dbg2       v2rawdetection: %p\n", (void *)v2rawdetection);
+		fprintf(stderr, "dbg2       nalloc:         %u\n", v2rawdetection->nalloc);
+		fprintf(stderr, "dbg2       nbeams:         %d\n", nbeams);
 	}
 
-	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &customattitude->header, error);
-
-	/* print Custom attitude (record 1004) */
-	if (verbose >= 2)
-		first = debug_str;
-	else {
-		first = nodebug_str;
-		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
+	/* grow the beam arrays if needed - at least doubling so that a slowly
+	    increasing beam count does not reallocate on every ping */
+	if (nbeams > (int)v2rawdetection->nalloc) {
+		nalloc = MAX(nbeams, 2 * (int)v2rawdetection->nalloc);
+		status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(u16), (void **)&(v2rawdetection->beam_descriptor),
+		                     error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(f32),
+			                     (void **)&(v2rawdetection->detection_point), error);
+		if (status == MB_SUCCESS)
+			status =
+			    mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(f32), (void **)&(v2rawdetection->rx_angle), error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(u32), (void **)&(v2rawdetection->flags), error);
+		if (status == MB_SUCCESS)
+			status =
+			    mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(u32), (void **)&(v2rawdetection->quality), error);
+		if (status == MB_SUCCESS)
+			status =
+			    mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(f32), (void **)&(v2rawdetection->uncertainty), error);
+		if (status == MB_SUCCESS) {
+			for (i = v2rawdetection->nalloc; i < nalloc; i++) {
+				v2rawdetection->beam_descriptor[i] = 0;
+				v2rawdetection->detection_point[i] = 0.0;
+				v2rawdetection->rx_angle[i] = 0.0;
+				v2rawdetection->flags[i] = 0;
+				v2rawdetection->quality[i] = 0;
+				v2rawdetection->uncertainty[i] = 0.0;
+			}
+			v2rawdetection->nalloc = nalloc;
+		}
+		else {
+			v2rawdetection->nalloc = 0;
+			v2rawdetection->number_beams = 0;
+		}
 	}
-	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     bitfield:                   %d\n", first, customattitude->bitfield);
-	fprintf(stderr, "%s     reserved:                   %d\n", first, customattitude->reserved);
-	fprintf(stderr, "%s     n:                          %d\n", first, customattitude->n);
-	fprintf(stderr, "%s     frequency:                  %f\n", first, customattitude->frequency);
-	fprintf(stderr, "%s     nalloc:                     %d\n", first, customattitude->nalloc);
-	for (i = 0; i < customattitude->n; i++)
-		fprintf(stderr, "%s     i:%d pitch:%f roll:%f heading:%f heave:%f\n", first, i, customattitude->pitch[i],
-		        customattitude->roll[i], customattitude->heading[i], customattitude->heave[i]);
-	for (i = 0; i < customattitude->n; i++)
-		fprintf(stderr, "%s     i:%d pitchrate:%f rollrate:%f headingrate:%f heaverate:%f\n", first, i,
-		        customattitude->pitchrate[i], customattitude->rollrate[i], customattitude->headingrate[i],
-		        customattitude->heaverate[i]);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       nalloc:     %u\n", v2rawdetection->nalloc);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:     %d\n", status);
@@ -1660,28 +2782,33 @@ int mbsys_reson7k_print_customattitude(int verbose, s7kr_customattitude *customa
 	/* return status */
 	return (status);
 }
+/*--------------------------------------------------------------------*/
+/* 7K Macros */
+int mbsys_reson7k_checkheader(s7k_header header) {
+	return ((header.Version > 0) && (header.SyncPattern == 0x0000ffff) && (header.Size > MBSYS_RESON7K_RECORDHEADER_SIZE) &&
+	        (header.s7kTime.Day >= 1) && (header.s7kTime.Day <= 366) && (header.s7kTime.Seconds >= 0.0f) &&
+	        (header.s7kTime.Seconds < 60.0f) && (header.s7kTime.Hours <= 23) && (header.s7kTime.Minutes <= 59));
+}
 
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_tide(int verbose, s7kr_tide *tide, int *error) {
-	char *function_name = "mbsys_reson7k_print_tide";
+int mbsys_reson7k_print_header(int verbose, s7k_header *header, int *error) {
+	char *function_name = "mbsys_reson7k_print_header";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
+	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
-		fprintf(stderr, "dbg2       tide:         %p\n", (void *)tide);
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       header:     %p\n", (void *)header);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &tide->header, error);
-
-	/* print Tide (record 1005) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -1689,17 +2816,33 @@ int mbsys_reson7k_print_tide(int verbose, s7kr_tide *tide, int *error) {
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     tide:                       %f\n", first, tide->tide);
-	fprintf(stderr, "%s     source:                     %d\n", first, tide->source);
-	fprintf(stderr, "%s     flags:                      %d\n", first, tide->flags);
-	fprintf(stderr, "%s     gauge:                      %d\n", first, tide->gauge);
-	fprintf(stderr, "%s     datum:                      %d\n", first, tide->datum);
-	fprintf(stderr, "%s     latency:                    %f\n", first, tide->latency);
-	fprintf(stderr, "%s     latitude:                   %f\n", first, tide->latitude);
-	fprintf(stderr, "%s     longitude:                  %f\n", first, tide->longitude);
-	fprintf(stderr, "%s     height:                     %f\n", first, tide->height);
-	fprintf(stderr, "%s     type:                       %d\n", first, tide->type);
-	fprintf(stderr, "%s     utm_zone:                   %d\n", first, tide->utm_zone);
+	fprintf(stderr, "%s     Version:                 %d\n", first, header->Version);
+	fprintf(stderr, "%s     Offset:                  %d\n", first, header->Offset);
+	fprintf(stderr, "%s     SyncPattern:             %d\n", first, header->SyncPattern);
+	fprintf(stderr, "%s     Size:                    %d\n", first, header->Size);
+	fprintf(stderr, "%s     OptionalDataOffset:      %d\n", first, header->OptionalDataOffset);
+	fprintf(stderr, "%s     OptionalDataIdentifier:  %d\n", first, header->OptionalDataIdentifier);
+	fprintf(stderr, "%s     s7kTime.Year:            %d\n", first, header->s7kTime.Year);
+	fprintf(stderr, "%s     s7kTime.Day:             %d\n", first, header->s7kTime.Day);
+	fprintf(stderr, "%s     s7kTime.Seconds:         %f\n", first, header->s7kTime.Seconds);
+	fprintf(stderr, "%s     s7kTime.Hours:           %d\n", first, header->s7kTime.Hours);
+	fprintf(stderr, "%s     7kTime->Minutes:         %d\n", first, header->s7kTime.Minutes);
+	fprintf(stderr, "%s     Reserved:                %d\n", first, header->Reserved);
+	fprintf(stderr, "%s     RecordType:              %d\n", first, header->RecordType);
+	fprintf(stderr, "%s     DeviceId:                %d\n", first, header->DeviceId);
+	fprintf(stderr, "%s     Reserved2:               %d\n", first, header->Reserved2);
+	fprintf(stderr, "%s     SystemEnumerator:        %d\n", first, header->SystemEnumerator);
+	fprintf(stderr, "%s     DataSetNumber:           %d\n", first, header->DataSetNumber);
+	fprintf(stderr, "%s     RecordNumber:            %d\n", first, header->RecordNumber);
+	for (i = 0; i < 8; i++) {
+		fprintf(stderr, "%s     PreviousRecord[%d]:       %d\n", first, i, header->PreviousRecord[i]);
+		fprintf(stderr, "%s     NextRecord[%d]:           %d\n", first, i, header->NextRecord[i]);
+	}
+	fprintf(stderr, "%s     Flags:                   %d\n", first, header->Flags);
+	fprintf(stderr, "%s     Reserved3:               %d\n", first, header->Reserved3);
+	fprintf(stderr, "%s     Reserved4:               %d\n", first, header->Reserved4);
+	fprintf(stderr, "%s     FragmentedTotal:         %d\n", first, header->FragmentedTotal);
+	fprintf(stderr, "%s     FragmentNumber:          %d\n", first, header->FragmentNumber);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -1715,8 +2858,8 @@ int mbsys_reson7k_print_tide(int verbose, s7kr_tide *tide, int *error) {
 }
 
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_altitude(int verbose, s7kr_altitude *altitude, int *error) {
-	char *function_name = "mbsys_reson7k_print_altitude";
+int mbsys_reson7k_print_reference(int verbose, s7kr_reference *reference, int *error) {
+	char *function_name = "mbsys_reson7k_print_reference";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
@@ -1727,14 +2870,14 @@ int mbsys_reson7k_print_altitude(int verbose, s7kr_altitude *altitude, int *erro
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
-		fprintf(stderr, "dbg2       altitude:     %p\n", (void *)altitude);
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       reference:  %p\n", (void *)reference);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &altitude->header, error);
+	mbsys_reson7k_print_header(verbose, &reference->header, error);
 
-	/* print Altitude (record 1006) */
+	/* print Reference point information (record 1000) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -1742,7 +2885,10 @@ int mbsys_reson7k_print_altitude(int verbose, s7kr_altitude *altitude, int *erro
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     altitude:                   %f\n", first, altitude->altitude);
+	fprintf(stderr, "%s     offset_x:                %f\n", first, reference->offset_x);
+	fprintf(stderr, "%s     offset_y:                %f\n", first, reference->offset_y);
+	fprintf(stderr, "%s     offset_z:                %f\n", first, reference->offset_z);
+	fprintf(stderr, "%s     water_z:                 %f\n", first, reference->water_z);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -1758,13 +2904,12 @@ int mbsys_reson7k_print_altitude(int verbose, s7kr_altitude *altitude, int *erro
 }
 
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_motion(int verbose, s7kr_motion *motion, int *error) {
-	char *function_name = "mbsys_reson7k_print_motion";
+int mbsys_reson7k_print_sensoruncal(int verbose, s7kr_sensoruncal *sensoruncal, int *error) {
+	char *function_name = "mbsys_reson7k_print_sensoruncal";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
-	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -1772,13 +2917,13 @@ int mbsys_reson7k_print_motion(int verbose, s7kr_motion *motion, int *error) {
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
-		fprintf(stderr, "dbg2       motion:       %p\n", (void *)motion);
+		fprintf(stderr, "dbg2       sensoruncal:  %p\n", (void *)sensoruncal);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &motion->header, error);
+	mbsys_reson7k_print_header(verbose, &sensoruncal->header, error);
 
-	/* print Motion over ground (record 1007) */
+	/* print Sensor uncalibrated offset position information (record 1001) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -1786,14 +2931,12 @@ int mbsys_reson7k_print_motion(int verbose, s7kr_motion *motion, int *error) {
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     bitfield:                   %d\n", first, motion->bitfield);
-	fprintf(stderr, "%s     reserved:                   %d\n", first, motion->reserved);
-	fprintf(stderr, "%s     n:                          %d\n", first, motion->n);
-	fprintf(stderr, "%s     frequency:                  %f\n", first, motion->frequency);
-	fprintf(stderr, "%s     nalloc:                     %d\n", first, motion->nalloc);
-	for (i = 0; i < motion->n; i++)
-		fprintf(stderr, "%s     i:%d x:%f y:%f z:%f xa:%f ya:%f za:%f\n", first, i, motion->x[i], motion->y[i], motion->z[i],
-		        motion->xa[i], motion->ya[i], motion->za[i]);
+	fprintf(stderr, "%s     offset_x:                %f\n", first, sensoruncal->offset_x);
+	fprintf(stderr, "%s     offset_y:                %f\n", first, sensoruncal->offset_y);
+	fprintf(stderr, "%s     offset_z:                %f\n", first, sensoruncal->offset_z);
+	fprintf(stderr, "%s     offset_roll:             %f\n", first, sensoruncal->offset_roll);
+	fprintf(stderr, "%s     offset_pitch:            %f\n", first, sensoruncal->offset_pitch);
+	fprintf(stderr, "%s     offset_yaw:              %f\n", first, sensoruncal->offset_yaw);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -1807,9 +2950,10 @@ int mbsys_reson7k_print_motion(int verbose, s7kr_motion *motion, int *error) {
 	/* return status */
 	return (status);
 }
+
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_depth(int verbose, s7kr_depth *depth, int *error) {
-	char *function_name = "mbsys_reson7k_print_depth";
+int mbsys_reson7k_print_sensorcal(int verbose, s7kr_sensorcal *sensorcal, int *error) {
+	char *function_name = "mbsys_reson7k_print_sensorcal";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
@@ -1821,24 +2965,25 @@ int mbsys_reson7k_print_depth(int verbose, s7kr_depth *depth, int *error) {
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
-		fprintf(stderr, "dbg2       depth:        %p\n", (void *)depth);
+		fprintf(stderr, "dbg2       sensorcal:    %p\n", (void *)sensorcal);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &depth->header, error);
+	mbsys_reson7k_print_header(verbose, &sensorcal->header, error);
 
-	/* print Depth (record 1008) */
+	/* print Sensor Calibrated offset position information (record 1001) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
 		first = nodebug_str;
-		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     descriptor:                  %d\n", first, depth->descriptor);
-	fprintf(stderr, "%s     correction:                  %d\n", first, depth->correction);
-	fprintf(stderr, "%s     reserved:                    %d\n", first, depth->reserved);
-	fprintf(stderr, "%s     depth:                       %f\n", first, depth->depth);
+	fprintf(stderr, "%s     offset_x:                %f\n", first, sensorcal->offset_x);
+	fprintf(stderr, "%s     offset_y:                %f\n", first, sensorcal->offset_y);
+	fprintf(stderr, "%s     offset_z:                %f\n", first, sensorcal->offset_z);
+	fprintf(stderr, "%s     offset_roll:             %f\n", first, sensorcal->offset_roll);
+	fprintf(stderr, "%s     offset_pitch:            %f\n", first, sensorcal->offset_pitch);
+	fprintf(stderr, "%s     offset_yaw:              %f\n", first, sensorcal->offset_yaw);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -1854,13 +2999,12 @@ int mbsys_reson7k_print_depth(int verbose, s7kr_depth *depth, int *error) {
 }
 
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_svp(int verbose, s7kr_svp *svp, int *error) {
-	char *function_name = "mbsys_reson7k_print_svp";
+int mbsys_reson7k_print_position(int verbose, s7kr_position *position, int *error) {
+	char *function_name = "mbsys_reson7k_print_position";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
-	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -1868,13 +3012,13 @@ int mbsys_reson7k_print_svp(int verbose, s7kr_svp *svp, int *error) {
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
-		fprintf(stderr, "dbg2       svp:          %p\n", (void *)svp);
+		fprintf(stderr, "dbg2       position:     %p\n", (void *)position);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &svp->header, error);
+	mbsys_reson7k_print_header(verbose, &position->header, error);
 
-	/* print Sound velocity profile (record 1009) */
+	/* print Sensor Calibrated offset position information (record 1001) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -1882,15 +3026,15 @@ int mbsys_reson7k_print_svp(int verbose, s7kr_svp *svp, int *error) {
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     position_flag:              %d\n", first, svp->position_flag);
-	fprintf(stderr, "%s     reserved1:                  %d\n", first, svp->reserved1);
-	fprintf(stderr, "%s     reserved2:                  %d\n", first, svp->reserved2);
-	fprintf(stderr, "%s     latitude:                   %f\n", first, svp->latitude);
-	fprintf(stderr, "%s     longitude:                  %f\n", first, svp->longitude);
-	fprintf(stderr, "%s     n:                          %d\n", first, svp->n);
-	fprintf(stderr, "%s     nalloc:                     %d\n", first, svp->nalloc);
-	for (i = 0; i < svp->n; i++)
-		fprintf(stderr, "%s     i:%d depth:%f sound_velocity:%f\n", first, i, svp->depth[i], svp->sound_velocity[i]);
+	fprintf(stderr, "%s     datum:                   %d\n", first, position->datum);
+	fprintf(stderr, "%s     latency:                 %f\n", first, position->latency);
+	fprintf(stderr, "%s     latitude:                %f\n", first, position->latitude);
+	fprintf(stderr, "%s     longitude:               %f\n", first, position->longitude);
+	fprintf(stderr, "%s     height:                  %f\n", first, position->height);
+	fprintf(stderr, "%s     type:                    %d\n", first, position->type);
+	fprintf(stderr, "%s     utm_zone:                %d\n", first, position->utm_zone);
+	fprintf(stderr, "%s     quality:                 %d\n", first, position->quality);
+	fprintf(stderr, "%s     method:                  %d\n", first, position->method);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -1906,8 +3050,8 @@ int mbsys_reson7k_print_svp(int verbose, s7kr_svp *svp, int *error) {
 }
 
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_ctd(int verbose, s7kr_ctd *ctd, int *error) {
-	char *function_name = "mbsys_reson7k_print_ctd";
+int mbsys_reson7k_print_customattitude(int verbose, s7kr_customattitude *customattitude, int *error) {
+	char *function_name = "mbsys_reson7k_print_customattitude";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
@@ -1919,14 +3063,14 @@ int mbsys_reson7k_print_ctd(int verbose, s7kr_ctd *ctd, int *error) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
-		fprintf(stderr, "dbg2       ctd:          %p\n", (void *)ctd);
+		fprintf(stderr, "dbg2       verbose:       %d\n", verbose);
+		fprintf(stderr, "dbg2       customattitude:%p\n", (void *)customattitude);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &ctd->header, error);
+	mbsys_reson7k_print_header(verbose, &customattitude->header, error);
 
-	/* print CTD (record 1010) */
+	/* print Custom attitude (record 1004) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -1934,23 +3078,18 @@ int mbsys_reson7k_print_ctd(int verbose, s7kr_ctd *ctd, int *error) {
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     frequency:                  %f\n", first, ctd->frequency);
-	fprintf(stderr, "%s     velocity_source_flag:       %d\n", first, ctd->velocity_source_flag);
-	fprintf(stderr, "%s     velocity_algorithm:         %d\n", first, ctd->velocity_algorithm);
-	fprintf(stderr, "%s     conductivity_flag:          %d\n", first, ctd->conductivity_flag);
-	fprintf(stderr, "%s     pressure_flag:              %d\n", first, ctd->pressure_flag);
-	fprintf(stderr, "%s     position_flag:              %d\n", first, ctd->position_flag);
-	fprintf(stderr, "%s     validity:                   %d\n", first, ctd->validity);
-	fprintf(stderr, "%s     reserved:                   %d\n", first, ctd->reserved);
-	fprintf(stderr, "%s     latitude:                   %f\n", first, ctd->latitude);
-	fprintf(stderr, "%s     longitude:                  %f\n", first, ctd->longitude);
-	fprintf(stderr, "%s     sample_rate:                %f\n", first, ctd->sample_rate);
-	fprintf(stderr, "%s     n:                          %d\n", first, ctd->n);
-	fprintf(stderr, "%s     nalloc:                     %d\n", first, ctd->nalloc);
-	for (i = 0; i < ctd->n; i++)
-		fprintf(stderr, "%s     i:%d conductivity_salinity:%f temperature:%f pressure_depth:%f sound_velocity:%f absorption:%f\n",
-		        first, i, ctd->conductivity_salinity[i], ctd->temperature[i], ctd->pressure_depth[i], ctd->sound_velocity[i],
-		        ctd->absorption[i]);
+	fprintf(stderr, "%s     bitfield:                   %d\n", first, customattitude->bitfield);
+	fprintf(stderr, "%s     reserved:                   %d\n", first, customattitude->reserved);
+	fprintf(stderr, "%s     n:                          %d\n", first, customattitude->n);
+	fprintf(stderr, "%s     frequency:                  %f\n", first, customattitude->frequency);
+	fprintf(stderr, "%s     nalloc:                     %d\n", first, customattitude->nalloc);
+	for (i = 0; i < customattitude->n; i++)
+		fprintf(stderr, "%s     i:%d pitch:%f roll:%f heading:%f heave:%f\n", first, i, customattitude->pitch[i],
+		        customattitude->roll[i], customattitude->heading[i], customattitude->heave[i]);
+	for (i = 0; i < customattitude->n; i++)
+		fprintf(stderr, "%s     i:%d pitchrate:%f rollrate:%f headingrate:%f heaverate:%f\n", first, i,
+		        customattitude->pitchrate[i], customattitude->rollrate[i], customattitude->headingrate[i],
+		        customattitude->heaverate[i]);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -1966,8 +3105,8 @@ int mbsys_reson7k_print_ctd(int verbose, s7kr_ctd *ctd, int *error) {
 }
 
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_geodesy(int verbose, s7kr_geodesy *geodesy, int *error) {
-	char *function_name = "mbsys_reson7k_print_geodesy";
+int mbsys_reson7k_print_tide(int verbose, s7kr_tide *tide, int *error) {
+	char *function_name = "mbsys_reson7k_print_tide";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
@@ -1979,13 +3118,13 @@ int mbsys_reson7k_print_geodesy(int verbose, s7kr_geodesy *geodesy, int *error)
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
-		fprintf(stderr, "dbg2       geodesy:      %p\n", (void *)geodesy);
+		fprintf(stderr, "dbg2       tide:         %p\n", (void *)tide);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &geodesy->header, error);
+	mbsys_reson7k_print_header(verbose, &tide->header, error);
 
-	/* print Geodesy (record 1011) */
+	/* print Tide (record 1005) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -1993,31 +3132,17 @@ int mbsys_reson7k_print_geodesy(int verbose, s7kr_geodesy *geodesy, int *error)
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     spheroid:                   %s\n", first, geodesy->spheroid);
-	fprintf(stderr, "%s     semimajoraxis:              %f\n", first, geodesy->semimajoraxis);
-	fprintf(stderr, "%s     flattening:                 %f\n", first, geodesy->flattening);
-	fprintf(stderr, "%s     reserved1:                  %s\n", first, geodesy->reserved1);
-	fprintf(stderr, "%s     datum:                      %s\n", first, geodesy->datum);
-	fprintf(stderr, "%s     calculation_method:         %d\n", first, geodesy->calculation_method);
-	fprintf(stderr, "%s     number_parameters:          %d\n", first, geodesy->number_parameters);
-	fprintf(stderr, "%s     dx:                         %f\n", first, geodesy->dx);
-	fprintf(stderr, "%s     dy:                         %f\n", first, geodesy->dy);
-	fprintf(stderr, "%s     dz:                         %f\n", first, geodesy->dz);
-	fprintf(stderr, "%s     rx:                         %f\n", first, geodesy->rx);
-	fprintf(stderr, "%s     ry:                         %f\n", first, geodesy->ry);
-	fprintf(stderr, "%s     rz:                         %f\n", first, geodesy->rz);
-	fprintf(stderr, "%s     scale:                      %f\n", first, geodesy->scale);
-	fprintf(stderr, "%s     reserved2:                  %s\n", first, geodesy->reserved2);
-	fprintf(stderr, "%s     grid_name:                  %s\n", first, geodesy->grid_name);
-	fprintf(stderr, "%s     distance_units:             %d\n", first, geodesy->distance_units);
-	fprintf(stderr, "%s     angular_units:              %d\n", first, geodesy->angular_units);
-	fprintf(stderr, "%s     latitude_origin:            %f\n", first, geodesy->latitude_origin);
-	fprintf(stderr, "%s     central_meriidan:           %f\n", first, geodesy->central_meriidan);
-	fprintf(stderr, "%s     false_easting:              %f\n", first, geodesy->false_easting);
-	fprintf(stderr, "%s     false_northing:             %f\n", first, geodesy->false_northing);
-	fprintf(stderr, "%s     central_scale_factor:       %f\n", first, geodesy->central_scale_factor);
-	fprintf(stderr, "%s     custum_identifier:          %d\n", first, geodesy->custum_identifier);
-	fprintf(stderr, "%s     reserved3:                  %s\n", first, geodesy->reserved3);
+	fprintf(stderr, "%s     tide:                       %f\n", first, tide->tide);
+	fprintf(stderr, "%s     source:                     %d\n", first, tide->source);
+	fprintf(stderr, "%s     flags:                      %d\n", first, tide->flags);
+	fprintf(stderr, "%s     gauge:                      %d\n", first, tide->gauge);
+	fprintf(stderr, "%s     datum:                      %d\n", first, tide->datum);
+	fprintf(stderr, "%s     latency:                    %f\n", first, tide->latency);
+	fprintf(stderr, "%s     latitude:                   %f\n", first, tide->latitude);
+	fprintf(stderr, "%s     longitude:                  %f\n", first, tide->longitude);
+	fprintf(stderr, "%s     height:                     %f\n", first, tide->height);
+	fprintf(stderr, "%s     type:                       %d\n", first, tide->type);
+	fprintf(stderr, "%s     utm_zone:                   %d\n", first, tide->utm_zone);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -2033,8 +3158,8 @@ int mbsys_reson7k_print_geodesy(int verbose, s7kr_geodesy *geodesy, int *error)
 }
 
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_rollpitchheave(int verbose, s7kr_rollpitchheave *rollpitchheave, int *error) {
-	char *function_name = "mbsys_reson7k_print_rollpitchheave";
+int mbsys_reson7k_print_altitude(int verbose, s7kr_altitude *altitude, int *error) {
+	char *function_name = "mbsys_reson7k_print_altitude";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
@@ -2045,14 +3170,14 @@ int mbsys_reson7k_print_rollpitchheave(int verbose, s7kr_rollpitchheave *rollpit
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:        %d\n", verbose);
-		fprintf(stderr, "dbg2       rollpitchheave: %p\n", (void *)rollpitchheave);
+		fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
+		fprintf(stderr, "dbg2       altitude:     %p\n", (void *)altitude);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &rollpitchheave->header, error);
+	mbsys_reson7k_print_header(verbose, &altitude->header, error);
 
-	/* print Roll pitch heave (record 1012) */
+	/* print Altitude (record 1006) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -2060,9 +3185,7 @@ int mbsys_reson7k_print_rollpitchheave(int verbose, s7kr_rollpitchheave *rollpit
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     roll:                       %f\n", first, rollpitchheave->roll);
-	fprintf(stderr, "%s     pitch:                      %f\n", first, rollpitchheave->pitch);
-	fprintf(stderr, "%s     heave:                      %f\n", first, rollpitchheave->heave);
+	fprintf(stderr, "%s     altitude:                   %f\n", first, altitude->altitude);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -2078,12 +3201,13 @@ int mbsys_reson7k_print_rollpitchheave(int verbose, s7kr_rollpitchheave *rollpit
 }
 
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_heading(int verbose, s7kr_heading *heading, int *error) {
-	char *function_name = "mbsys_reson7k_print_heading";
+int mbsys_reson7k_print_motion(int verbose, s7kr_motion *motion, int *error) {
+	char *function_name = "mbsys_reson7k_print_motion";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
+	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -2091,13 +3215,13 @@ int mbsys_reson7k_print_heading(int verbose, s7kr_heading *heading, int *error)
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
-		fprintf(stderr, "dbg2       heading:      %p\n", (void *)heading);
+		fprintf(stderr, "dbg2       motion:       %p\n", (void *)motion);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &heading->header, error);
+	mbsys_reson7k_print_header(verbose, &motion->header, error);
 
-	/* print Heading (record 1013) */
+	/* print Motion over ground (record 1007) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -2105,7 +3229,14 @@ int mbsys_reson7k_print_heading(int verbose, s7kr_heading *heading, int *error)
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     heading:                    %f\n", first, heading->heading);
+	fprintf(stderr, "%s     bitfield:                   %d\n", first, motion->bitfield);
+	fprintf(stderr, "%s     reserved:                   %d\n", first, motion->reserved);
+	fprintf(stderr, "%s     n:                          %d\n", first, motion->n);
+	fprintf(stderr, "%s     frequency:                  %f\n", first, motion->frequency);
+	fprintf(stderr, "%s     nalloc:                     %d\n", first, motion->nalloc);
+	for (i = 0; i < motion->n; i++)
+		fprintf(stderr, "%s     i:%d x:%f y:%f z:%f xa:%f ya:%f za:%f\n", first, i, motion->x[i], motion->y[i], motion->z[i],
+		        motion->xa[i], motion->ya[i], motion->za[i]);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -2119,15 +3250,13 @@ int mbsys_reson7k_print_heading(int verbose, s7kr_heading *heading, int *error)
 	/* return status */
 	return (status);
 }
-
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_surveyline(int verbose, s7kr_surveyline *surveyline, int *error) {
-	char *function_name = "mbsys_reson7k_print_surveyline";
+int mbsys_reson7k_print_depth(int verbose, s7kr_depth *depth, int *error) {
+	char *function_name = "mbsys_reson7k_print_depth";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
-	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -2135,13 +3264,13 @@ int mbsys_reson7k_print_surveyline(int verbose, s7kr_surveyline *surveyline, int
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
-		fprintf(stderr, "dbg2       surveyline:   %p\n", (void *)surveyline);
+		fprintf(stderr, "dbg2       depth:        %p\n", (void *)depth);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &surveyline->header, error);
+	mbsys_reson7k_print_header(verbose, &depth->header, error);
 
-	/* print Survey Line (record 1014) */
+	/* print Depth (record 1008) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -2149,13 +3278,10 @@ int mbsys_reson7k_print_surveyline(int verbose, s7kr_surveyline *surveyline, int
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     n:                          %d\n", first, surveyline->n);
-	fprintf(stderr, "%s     type:                       %d\n", first, surveyline->type);
-	fprintf(stderr, "%s     turnradius:                 %f\n", first, surveyline->turnradius);
-	fprintf(stderr, "%s     name:                       %s\n", first, surveyline->name);
-	fprintf(stderr, "%s     nalloc:                     %d\n", first, surveyline->nalloc);
-	for (i = 0; i < surveyline->n; i++)
-		fprintf(stderr, "%s     i:%d latitude:%f longitude:%f\n", first, i, surveyline->latitude[i], surveyline->longitude[i]);
+	fprintf(stderr, "%s     descriptor:                  %d\n", first, depth->descriptor);
+	fprintf(stderr, "%s     correction:                  %d\n", first, depth->correction);
+	fprintf(stderr, "%s     reserved:                    %d\n", first, depth->reserved);
+	fprintf(stderr, "%s     depth:                       %f\n", first, depth->depth);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -2171,12 +3297,13 @@ int mbsys_reson7k_print_surveyline(int verbose, s7kr_surveyline *surveyline, int
 }
 
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_navigation(int verbose, s7kr_navigation *navigation, int *error) {
-	char *function_name = "mbsys_reson7k_print_navigation";
+int mbsys_reson7k_print_svp(int verbose, s7kr_svp *svp, int *error) {
+	char *function_name = "mbsys_reson7k_print_svp";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
+	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -2184,13 +3311,13 @@ int mbsys_reson7k_print_navigation(int verbose, s7kr_navigation *navigation, int
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
-		fprintf(stderr, "dbg2       navigation:   %p\n", (void *)navigation);
+		fprintf(stderr, "dbg2       svp:          %p\n", (void *)svp);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &navigation->header, error);
+	mbsys_reson7k_print_header(verbose, &svp->header, error);
 
-	/* print Navigation (record 1015) */
+	/* print Sound velocity profile (record 1009) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -2198,15 +3325,15 @@ int mbsys_reson7k_print_navigation(int verbose, s7kr_navigation *navigation, int
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     vertical_reference:         %d\n", first, navigation->vertical_reference);
-	fprintf(stderr, "%s     latitude:                   %f\n", first, navigation->latitude);
-	fprintf(stderr, "%s     longitude:                  %f\n", first, navigation->longitude);
-	fprintf(stderr, "%s     position_accuracy:          %f\n", first, navigation->position_accuracy);
-	fprintf(stderr, "%s     height:                     %f\n", first, navigation->height);
-	fprintf(stderr, "%s     height_accuracy:            %f\n", first, navigation->height_accuracy);
-	fprintf(stderr, "%s     speed:                      %f\n", first, navigation->speed);
-	fprintf(stderr, "%s     course:                     %f\n", first, navigation->course);
-	fprintf(stderr, "%s     heading:                    %f\n", first, navigation->heading);
+	fprintf(stderr, "%s     position_flag:              %d\n", first, svp->position_flag);
+	fprintf(stderr, "%s     reserved1:                  %d\n", first, svp->reserved1);
+	fprintf(stderr, "%s     reserved2:                  %d\n", first, svp->reserved2);
+	fprintf(stderr, "%s     latitude:                   %f\n", first, svp->latitude);
+	fprintf(stderr, "%s     longitude:                  %f\n", first, svp->longitude);
+	fprintf(stderr, "%s     n:                          %d\n", first, svp->n);
+	fprintf(stderr, "%s     nalloc:                     %d\n", first, svp->nalloc);
+	for (i = 0; i < svp->n; i++)
+		fprintf(stderr, "%s     i:%d depth:%f sound_velocity:%f\n", first, i, svp->depth[i], svp->sound_velocity[i]);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -2222,8 +3349,8 @@ int mbsys_reson7k_print_navigation(int verbose, s7kr_navigation *navigation, int
 }
 
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_attitude(int verbose, s7kr_attitude *attitude, int *error) {
-	char *function_name = "mbsys_reson7k_print_attitude";
+int mbsys_reson7k_print_ctd(int verbose, s7kr_ctd *ctd, int *error) {
+	char *function_name = "mbsys_reson7k_print_ctd";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
@@ -2236,13 +3363,13 @@ int mbsys_reson7k_print_attitude(int verbose, s7kr_attitude *attitude, int *erro
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
-		fprintf(stderr, "dbg2       attitude:     %p\n", (void *)attitude);
+		fprintf(stderr, "dbg2       ctd:          %p\n", (void *)ctd);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &attitude->header, error);
+	mbsys_reson7k_print_header(verbose, &ctd->header, error);
 
-	/* print Attitude (record 1016) */
+	/* print CTD (record 1010) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -2250,11 +3377,23 @@ int mbsys_reson7k_print_attitude(int verbose, s7kr_attitude *attitude, int *erro
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     n:                          %d\n", first, attitude->n);
-	fprintf(stderr, "%s     nalloc:                     %d\n", first, attitude->nalloc);
-	for (i = 0; i < attitude->n; i++)
-		fprintf(stderr, "%s     i:%d delta_time:%d pitch:%f roll:%f heading:%f heave:%f\n", first, i, attitude->delta_time[i],
-		        attitude->pitch[i], attitude->roll[i], attitude->heading[i], attitude->heave[i]);
+	fprintf(stderr, "%s     frequency:                  %f\n", first, ctd->frequency);
+	fprintf(stderr, "%s     velocity_source_flag:       %d\n", first, ctd->velocity_source_flag);
+	fprintf(stderr, "%s     velocity_algorithm:         %d\n", first, ctd->velocity_algorithm);
+	fprintf(stderr, "%s     conductivity_flag:          %d\n", first, ctd->conductivity_flag);
+	fprintf(stderr, "%s     pressure_flag:              %d\n", first, ctd->pressure_flag);
+	fprintf(stderr, "%s     position_flag:              %d\n", first, ctd->position_flag);
+	fprintf(stderr, "%s     validity:                   %d\n", first, ctd->validity);
+	fprintf(stderr, "%s     reserved:                   %d\n", first, ctd->reserved);
+	fprintf(stderr, "%s     latitude:                   %f\n", first, ctd->latitude);
+	fprintf(stderr, "%s     longitude:                  %f\n", first, ctd->longitude);
+	fprintf(stderr, "%s     sample_rate:                %f\n", first, ctd->sample_rate);
+	fprintf(stderr, "%s     n:                          %d\n", first, ctd->n);
+	fprintf(stderr, "%s     nalloc:                     %d\n", first, ctd->nalloc);
+	for (i = 0; i < ctd->n; i++)
+		fprintf(stderr, "%s     i:%d conductivity_salinity:%f temperature:%f pressure_depth:%f sound_velocity:%f absorption:%f\n",
+		        first, i, ctd->conductivity_salinity[i], ctd->temperature[i], ctd->pressure_depth[i], ctd->sound_velocity[i],
+		        ctd->absorption[i]);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -2270,13 +3409,12 @@ int mbsys_reson7k_print_attitude(int verbose, s7kr_attitude *attitude, int *erro
 }
 
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_rec1022(int verbose, s7kr_rec1022 *rec1022, int *error) {
-	char *function_name = "mbsys_reson7k_print_rec1022";
+int mbsys_reson7k_print_geodesy(int verbose, s7kr_geodesy *geodesy, int *error) {
+	char *function_name = "mbsys_reson7k_print_geodesy";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
-	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -2284,13 +3422,13 @@ int mbsys_reson7k_print_rec1022(int verbose, s7kr_rec1022 *rec1022, int *error)
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
-		fprintf(stderr, "dbg2       rec1022:      %p\n", (void *)rec1022);
+		fprintf(stderr, "dbg2       geodesy:      %p\n", (void *)geodesy);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &rec1022->header, error);
+	mbsys_reson7k_print_header(verbose, &geodesy->header, error);
 
-	/* print Attitude (record 1016) */
+	/* print Geodesy (record 1011) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -2298,11 +3436,31 @@ int mbsys_reson7k_print_rec1022(int verbose, s7kr_rec1022 *rec1022, int *error)
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     record bytes in hex:        |", first);
-	for (i = 0; i < R7KHDRSIZE_Rec1022; i++) {
-		fprintf(stderr, "%x|", rec1022->data[i]);
-	}
-	fprintf(stderr, "\n");
+	fprintf(stderr, "%s     spheroid:                   %s\n", first, geodesy->spheroid);
+	fprintf(stderr, "%s     semimajoraxis:              %f\n", first, geodesy->semimajoraxis);
+	fprintf(stderr, "%s     flattening:                 %f\n", first, geodesy->flattening);
+	fprintf(stderr, "%s     reserved1:                  %s\n", first, geodesy->reserved1);
+	fprintf(stderr, "%s     datum:                      %s\n", first, geodesy->datum);
+	fprintf(stderr, "%s     calculation_method:         %d\n", first, geodesy->calculation_method);
+	fprintf(stderr, "%s     number_parameters:          %d\n", first, geodesy->number_parameters);
+	fprintf(stderr, "%s     dx:                         %f\n", first, geodesy->dx);
+	fprintf(stderr, "%s     dy:                         %f\n", first, geodesy->dy);
+	fprintf(stderr, "%s     dz:                         %f\n", first, geodesy->dz);
+	fprintf(stderr, "%s     rx:                         %f\n", first, geodesy->rx);
+	fprintf(stderr, "%s     ry:                         %f\n", first, geodesy->ry);
+	fprintf(stderr, "%s     rz:                         %f\n", first, geodesy->rz);
+	fprintf(stderr, "%s     scale:                      %f\n", first, geodesy->scale);
+	fprintf(stderr, "%s     reserved2:                  %s\n", first, geodesy->reserved2);
+	fprintf(stderr, "%s     grid_name:                  %s\n", first, geodesy->grid_name);
+	fprintf(stderr, "%s     distance_units:             %d\n", first, geodesy->distance_units);
+	fprintf(stderr, "%s     angular_units:              %d\n", first, geodesy->angular_units);
+	fprintf(stderr, "%s     latitude_origin:            %f\n", first, geodesy->latitude_origin);
+	fprintf(stderr, "%s     central_meriidan:           %f\n", first, geodesy->central_meriidan);
+	fprintf(stderr, "%s     false_easting:              %f\n", first, geodesy->false_easting);
+	fprintf(stderr, "%s     false_northing:             %f\n", first, geodesy->false_northing);
+	fprintf(stderr, "%s     central_scale_factor:       %f\n", first, geodesy->central_scale_factor);
+	fprintf(stderr, "%s     custum_identifier:          %d\n", first, geodesy->custum_identifier);
+	fprintf(stderr, "%s     reserved3:                  %s\n", first, geodesy->reserved3);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -2318,27 +3476,26 @@ int mbsys_reson7k_print_rec1022(int verbose, s7kr_rec1022 *rec1022, int *error)
 }
 
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_fsdwchannel(int verbose, int data_format, s7k_fsdwchannel *fsdwchannel, int *error) {
-	char *function_name = "mbsys_reson7k_print_fsdwchannel";
+int mbsys_reson7k_print_rollpitchheave(int verbose, s7kr_rollpitchheave *rollpitchheave, int *error) {
+	char *function_name = "mbsys_reson7k_print_rollpitchheave";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
-	short *shortptr;
-	unsigned short *ushortptr;
-	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
-		fprintf(stderr, "dbg2       data_format:  %d\n", data_format);
-		fprintf(stderr, "dbg2       fsdwchannel:  %p\n", (void *)fsdwchannel);
+		fprintf(stderr, "dbg2       verbose:        %d\n", verbose);
+		fprintf(stderr, "dbg2       rollpitchheave: %p\n", (void *)rollpitchheave);
 	}
 
-	/* print Edgetech sidescan or subbottom channel header data */
+	/* print Reson 7k data record header information */
+	mbsys_reson7k_print_header(verbose, &rollpitchheave->header, error);
+
+	/* print Roll pitch heave (record 1012) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -2346,36 +3503,9 @@ int mbsys_reson7k_print_fsdwchannel(int verbose, int data_format, s7k_fsdwchanne
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     number:                     %d\n", first, fsdwchannel->number);
-	fprintf(stderr, "%s     type:                       %d\n", first, fsdwchannel->type);
-	fprintf(stderr, "%s     data_type:                  %d\n", first, fsdwchannel->data_type);
-	fprintf(stderr, "%s     polarity:                   %d\n", first, fsdwchannel->polarity);
-	fprintf(stderr, "%s     bytespersample:             %d\n", first, fsdwchannel->bytespersample);
-	fprintf(stderr, "%s     reserved1[0]                %d\n", first, fsdwchannel->reserved1[0]);
-	fprintf(stderr, "%s     reserved1[1]                %d\n", first, fsdwchannel->reserved1[1]);
-	fprintf(stderr, "%s     reserved1[2]                %d\n", first, fsdwchannel->reserved1[2]);
-	fprintf(stderr, "%s     number_samples:             %d\n", first, fsdwchannel->number_samples);
-	fprintf(stderr, "%s     start_time:                 %d\n", first, fsdwchannel->start_time);
-	fprintf(stderr, "%s     sample_interval:            %d\n", first, fsdwchannel->sample_interval);
-	fprintf(stderr, "%s     range:                      %f\n", first, fsdwchannel->range);
-	fprintf(stderr, "%s     voltage:                    %f\n", first, fsdwchannel->voltage);
-	fprintf(stderr, "%s     name:                       %s\n", first, fsdwchannel->name);
-	fprintf(stderr, "%s     reserved2:                  %s\n", first, fsdwchannel->reserved2);
-	fprintf(stderr, "%s     data_alloc:                 %d\n", first, fsdwchannel->data_alloc);
-	shortptr = (short *)fsdwchannel->data;
-	ushortptr = (unsigned short *)fsdwchannel->data;
-	for (i = 0; i < fsdwchannel->number_samples; i++) {
-		if (data_format == EDGETECH_TRACEFORMAT_ENVELOPE)
-			fprintf(stderr, "%s     data[%d]:                   %d\n", first, i, ushortptr[i]);
-		else if (data_format == EDGETECH_TRACEFORMAT_ANALYTIC)
-			fprintf(stderr, "%s     data[%d]:                   %d %d\n", first, i, shortptr[2 * i], shortptr[2 * i + 1]);
-		else if (data_format == EDGETECH_TRACEFORMAT_RAW)
-			fprintf(stderr, "%s     data[%d]:                   %d\n", first, i, ushortptr[i]);
-		else if (data_format == EDGETECH_TRACEFORMAT_REALANALYTIC)
-			fprintf(stderr, "%s     data[%d]:                   %d\n", first, i, ushortptr[i]);
-		else if (data_format == EDGETECH_TRACEFORMAT_PIXEL)
-			fprintf(stderr, "%s     data[%d]:                   %d\n", first, i, ushortptr[i]);
-	}
+	fprintf(stderr, "%s     roll:                       %f\n", first, rollpitchheave->roll);
+	fprintf(stderr, "%s     pitch:                      %f\n", first, rollpitchheave->pitch);
+	fprintf(stderr, "%s     heave:                      %f\n", first, rollpitchheave->heave);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -2391,24 +3521,26 @@ int mbsys_reson7k_print_fsdwchannel(int verbose, int data_format, s7k_fsdwchanne
 }
 
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_fsdwssheader(int verbose, s7k_fsdwssheader *fsdwssheader, int *error) {
-	char *function_name = "mbsys_reson7k_print_fsdwssheader";
+int mbsys_reson7k_print_heading(int verbose, s7kr_heading *heading, int *error) {
+	char *function_name = "mbsys_reson7k_print_heading";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
-	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:       %d\n", verbose);
-		fprintf(stderr, "dbg2       fsdwssheader:  %p\n", (void *)fsdwssheader);
+		fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
+		fprintf(stderr, "dbg2       heading:      %p\n", (void *)heading);
 	}
 
-	/* print Edgetech sidescan or subbottom channel header data */
+	/* print Reson 7k data record header information */
+	mbsys_reson7k_print_header(verbose, &heading->header, error);
+
+	/* print Heading (record 1013) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -2416,39 +3548,7 @@ int mbsys_reson7k_print_fsdwssheader(int verbose, s7k_fsdwssheader *fsdwssheader
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     subsystem:                    %d\n", first, fsdwssheader->subsystem);
-	fprintf(stderr, "%s     channelNum:                   %d\n", first, fsdwssheader->channelNum);
-	fprintf(stderr, "%s     pingNum:                      %d\n", first, fsdwssheader->pingNum);
-	fprintf(stderr, "%s     packetNum:                    %d\n", first, fsdwssheader->packetNum);
-	fprintf(stderr, "%s     trigSource:                   %d\n", first, fsdwssheader->trigSource);
-	fprintf(stderr, "%s     samples:                      %d\n", first, fsdwssheader->samples);
-	fprintf(stderr, "%s     sampleInterval:               %d\n", first, fsdwssheader->sampleInterval);
-	fprintf(stderr, "%s     startDepth:                   %d\n", first, fsdwssheader->startDepth);
-	fprintf(stderr, "%s     weightingFactor:              %d\n", first, fsdwssheader->weightingFactor);
-	fprintf(stderr, "%s     ADCGain:                      %d\n", first, fsdwssheader->ADCGain);
-	fprintf(stderr, "%s     ADCMax:                       %d\n", first, fsdwssheader->ADCMax);
-	fprintf(stderr, "%s     rangeSetting:                 %d\n", first, fsdwssheader->rangeSetting);
-	fprintf(stderr, "%s     pulseID:                      %d\n", first, fsdwssheader->pulseID);
-	fprintf(stderr, "%s     markNumber:                   %d\n", first, fsdwssheader->markNumber);
-	fprintf(stderr, "%s     dataFormat:                   %d\n", first, fsdwssheader->dataFormat);
-	fprintf(stderr, "%s     reserved:                     %d\n", first, fsdwssheader->reserved);
-	fprintf(stderr, "%s     millisecondsToday:            %d\n", first, fsdwssheader->millisecondsToday);
-	fprintf(stderr, "%s     year:                         %d\n", first, fsdwssheader->year);
-	fprintf(stderr, "%s     day:                          %d\n", first, fsdwssheader->day);
-	fprintf(stderr, "%s     hour:                         %d\n", first, fsdwssheader->hour);
-	fprintf(stderr, "%s     minute:                       %d\n", first, fsdwssheader->minute);
-	fprintf(stderr, "%s     second:                       %d\n", first, fsdwssheader->second);
-	fprintf(stderr, "%s     heading:                      %d\n", first, fsdwssheader->heading);
-	fprintf(stderr, "%s     pitch:                        %d\n", first, fsdwssheader->pitch);
-	fprintf(stderr, "%s     roll:                         %d\n", first, fsdwssheader->roll);
-	fprintf(stderr, "%s     heave:                        %d\n", first, fsdwssheader->heave);
-	fprintf(stderr, "%s     yaw:                          %d\n", first, fsdwssheader->yaw);
-	fprintf(stderr, "%s     depth:                        %d\n", first, fsdwssheader->depth);
-	fprintf(stderr, "%s     temperature:                  %d\n", first, fsdwssheader->temperature);
-	for (i = 0; i < 2; i++)
-		fprintf(stderr, "%s     reserved2[%d]:                 %d\n", first, i, fsdwssheader->reserved2[i]);
-	fprintf(stderr, "%s     longitude:                    %d\n", first, fsdwssheader->longitude);
-	fprintf(stderr, "%s     latitude:                     %d\n", first, fsdwssheader->latitude);
+	fprintf(stderr, "%s     heading:                    %f\n", first, heading->heading);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -2464,8 +3564,8 @@ int mbsys_reson7k_print_fsdwssheader(int verbose, s7k_fsdwssheader *fsdwssheader
 }
 
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_fsdwsegyheader(int verbose, s7k_fsdwsegyheader *fsdwsegyheader, int *error) {
-	char *function_name = "mbsys_reson7k_print_fsdwsegyheader";
+int mbsys_reson7k_print_surveyline(int verbose, s7kr_surveyline *surveyline, int *error) {
+	char *function_name = "mbsys_reson7k_print_surveyline";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
@@ -2477,11 +3577,14 @@ int mbsys_reson7k_print_fsdwsegyheader(int verbose, s7k_fsdwsegyheader *fsdwsegy
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:         %d\n", verbose);
-		fprintf(stderr, "dbg2       fsdwsegyheader:  %p\n", (void *)fsdwsegyheader);
+		fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
+		fprintf(stderr, "dbg2       surveyline:   %p\n", (void *)surveyline);
 	}
 
-	/* print Edgetech sidescan or subbottom channel header data */
+	/* print Reson 7k data record header information */
+	mbsys_reson7k_print_header(verbose, &surveyline->header, error);
+
+	/* print Survey Line (record 1014) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -2489,73 +3592,13 @@ int mbsys_reson7k_print_fsdwsegyheader(int verbose, s7k_fsdwsegyheader *fsdwsegy
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     sequenceNumber:              %d\n", first, fsdwsegyheader->sequenceNumber);
-	fprintf(stderr, "%s     startDepth:                  %d\n", first, fsdwsegyheader->startDepth);
-	fprintf(stderr, "%s     pingNum:                     %d\n", first, fsdwsegyheader->pingNum);
-	fprintf(stderr, "%s     channelNum:                  %d\n", first, fsdwsegyheader->channelNum);
-	for (i = 0; i < 6; i++)
-		fprintf(stderr, "%s     unused1[%d]:                  %d\n", first, i, fsdwsegyheader->unused1[i]);
-	fprintf(stderr, "%s     traceIDCode:                 %d\n", first, fsdwsegyheader->traceIDCode);
-	for (i = 0; i < 2; i++)
-		fprintf(stderr, "%s     unused2[%d]:                  %d\n", first, i, fsdwsegyheader->unused2[i]);
-	fprintf(stderr, "%s     dataFormat:                  %d\n", first, fsdwsegyheader->dataFormat);
-	fprintf(stderr, "%s     NMEAantennaeR:               %d\n", first, fsdwsegyheader->NMEAantennaeR);
-	fprintf(stderr, "%s     NMEAantennaeO:               %d\n", first, fsdwsegyheader->NMEAantennaeO);
-	for (i = 0; i < 32; i++)
-		fprintf(stderr, "%s     RS232[%d]:                   %d\n", first, i, fsdwsegyheader->RS232[i]);
-	fprintf(stderr, "%s     sourceCoordX:                %d\n", first, fsdwsegyheader->sourceCoordX);
-	fprintf(stderr, "%s     sourceCoordY:                %d\n", first, fsdwsegyheader->sourceCoordY);
-	fprintf(stderr, "%s     groupCoordX:                 %d\n", first, fsdwsegyheader->groupCoordX);
-	fprintf(stderr, "%s     groupCoordY:                 %d\n", first, fsdwsegyheader->groupCoordY);
-	fprintf(stderr, "%s     coordUnits:                  %d\n", first, fsdwsegyheader->coordUnits);
-	fprintf(stderr, "%s     annotation:                  %s\n", first, fsdwsegyheader->annotation);
-	fprintf(stderr, "%s     samples:                     %d\n", first, fsdwsegyheader->samples);
-	fprintf(stderr, "%s     sampleInterval:              %d\n", first, fsdwsegyheader->sampleInterval);
-	fprintf(stderr, "%s     ADCGain:                     %d\n", first, fsdwsegyheader->ADCGain);
-	fprintf(stderr, "%s     pulsePower:                  %d\n", first, fsdwsegyheader->pulsePower);
-	fprintf(stderr, "%s     correlated:                  %d\n", first, fsdwsegyheader->correlated);
-	fprintf(stderr, "%s     startFreq:                   %d\n", first, fsdwsegyheader->startFreq);
-	fprintf(stderr, "%s     endFreq:                     %d\n", first, fsdwsegyheader->endFreq);
-	fprintf(stderr, "%s     sweepLength:                 %d\n", first, fsdwsegyheader->sweepLength);
-	for (i = 0; i < 4; i++)
-		fprintf(stderr, "%s     unused7[%d]:                  %d\n", first, i, fsdwsegyheader->unused7[i]);
-	fprintf(stderr, "%s     aliasFreq:                   %d\n", first, fsdwsegyheader->aliasFreq);
-	fprintf(stderr, "%s     pulseID:                     %d\n", first, fsdwsegyheader->pulseID);
-	for (i = 0; i < 6; i++)
-		fprintf(stderr, "%s     unused8[%d]:                  %d\n", first, i, fsdwsegyheader->unused8[i]);
-	fprintf(stderr, "%s     year:                        %d\n", first, fsdwsegyheader->year);
-	fprintf(stderr, "%s     day:                         %d\n", first, fsdwsegyheader->day);
-	fprintf(stderr, "%s     hour:                        %d\n", first, fsdwsegyheader->hour);
-	fprintf(stderr, "%s     minute:                      %d\n", first, fsdwsegyheader->minute);
-	fprintf(stderr, "%s     second:                      %d\n", first, fsdwsegyheader->second);
-	fprintf(stderr, "%s     timeBasis:                   %d\n", first, fsdwsegyheader->timeBasis);
-	fprintf(stderr, "%s     weightingFactor:             %d\n", first, fsdwsegyheader->weightingFactor);
-	fprintf(stderr, "%s     unused9:                     %d\n", first, fsdwsegyheader->unused9);
-	fprintf(stderr, "%s     heading:                     %d\n", first, fsdwsegyheader->heading);
-	fprintf(stderr, "%s     pitch:                       %d\n", first, fsdwsegyheader->pitch);
-	fprintf(stderr, "%s     roll:                        %d\n", first, fsdwsegyheader->roll);
-	fprintf(stderr, "%s     temperature:                 %d\n", first, fsdwsegyheader->temperature);
-	fprintf(stderr, "%s     heaveCompensation:           %d\n", first, fsdwsegyheader->heaveCompensation);
-	fprintf(stderr, "%s     trigSource:                  %d\n", first, fsdwsegyheader->trigSource);
-	fprintf(stderr, "%s     markNumber:                  %d\n", first, fsdwsegyheader->markNumber);
-	fprintf(stderr, "%s     NMEAHour:                    %d\n", first, fsdwsegyheader->NMEAHour);
-	fprintf(stderr, "%s     NMEAMinutes:                 %d\n", first, fsdwsegyheader->NMEAMinutes);
-	fprintf(stderr, "%s     NMEASeconds:                 %d\n", first, fsdwsegyheader->NMEASeconds);
-	fprintf(stderr, "%s     NMEACourse:                  %d\n", first, fsdwsegyheader->NMEACourse);
-	fprintf(stderr, "%s     NMEASpeed:                   %d\n", first, fsdwsegyheader->NMEASpeed);
-	fprintf(stderr, "%s     NMEADay:                     %d\n", first, fsdwsegyheader->NMEADay);
-	fprintf(stderr, "%s     NMEAYear:                    %d\n", first, fsdwsegyheader->NMEAYear);
-	fprintf(stderr, "%s     millisecondsToday:           %d\n", first, fsdwsegyheader->millisecondsToday);
-	fprintf(stderr, "%s     ADCMax:                      %d\n", first, fsdwsegyheader->ADCMax);
-	fprintf(stderr, "%s     calConst:                    %d\n", first, fsdwsegyheader->calConst);
-	fprintf(stderr, "%s     vehicleID:                   %d\n", first, fsdwsegyheader->vehicleID);
-	fprintf(stderr, "%s     softwareVersion:             %s\n", first, fsdwsegyheader->softwareVersion);
-	fprintf(stderr, "%s     sphericalCorrection:         %d\n", first, fsdwsegyheader->sphericalCorrection);
-	fprintf(stderr, "%s     packetNum:                   %d\n", first, fsdwsegyheader->packetNum);
-	fprintf(stderr, "%s     ADCDecimation:               %d\n", first, fsdwsegyheader->ADCDecimation);
-	fprintf(stderr, "%s     decimation:                  %d\n", first, fsdwsegyheader->decimation);
-	for (i = 0; i < 7; i++)
-		fprintf(stderr, "%s     unuseda[%d]:                  %d\n", first, i, fsdwsegyheader->unuseda[i]);
+	fprintf(stderr, "%s     n:                          %d\n", first, surveyline->n);
+	fprintf(stderr, "%s     type:                       %d\n", first, surveyline->type);
+	fprintf(stderr, "%s     turnradius:                 %f\n", first, surveyline->turnradius);
+	fprintf(stderr, "%s     name:                       %s\n", first, surveyline->name);
+	fprintf(stderr, "%s     nalloc:                     %d\n", first, surveyline->nalloc);
+	for (i = 0; i < surveyline->n; i++)
+		fprintf(stderr, "%s     i:%d latitude:%f longitude:%f\n", first, i, surveyline->latitude[i], surveyline->longitude[i]);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -2571,13 +3614,12 @@ int mbsys_reson7k_print_fsdwsegyheader(int verbose, s7k_fsdwsegyheader *fsdwsegy
 }
 
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_fsdwss(int verbose, s7kr_fsdwss *fsdwss, int *error) {
-	char *function_name = "mbsys_reson7k_print_fsdwss";
+int mbsys_reson7k_print_navigation(int verbose, s7kr_navigation *navigation, int *error) {
+	char *function_name = "mbsys_reson7k_print_navigation";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
-	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -2585,13 +3627,13 @@ int mbsys_reson7k_print_fsdwss(int verbose, s7kr_fsdwss *fsdwss, int *error) {
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
-		fprintf(stderr, "dbg2       fsdwss:       %p\n", (void *)fsdwss);
+		fprintf(stderr, "dbg2       navigation:   %p\n", (void *)navigation);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &fsdwss->header, error);
+	mbsys_reson7k_print_header(verbose, &navigation->header, error);
 
-	/* print Edgetech FS-DW sidescan (record 3000) */
+	/* print Navigation (record 1015) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -2599,15 +3641,15 @@ int mbsys_reson7k_print_fsdwss(int verbose, s7kr_fsdwss *fsdwss, int *error) {
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     msec_timestamp:             %d\n", first, fsdwss->msec_timestamp);
-	fprintf(stderr, "%s     ping_number:                %u\n", first, fsdwss->ping_number);
-	fprintf(stderr, "%s     number_channels:            %d\n", first, fsdwss->number_channels);
-	fprintf(stderr, "%s     total_bytes:                %d\n", first, fsdwss->total_bytes);
-	fprintf(stderr, "%s     data_format:                %d\n", first, fsdwss->data_format);
-	for (i = 0; i < fsdwss->number_channels; i++) {
-		mbsys_reson7k_print_fsdwchannel(verbose, fsdwss->data_format, &fsdwss->channel[i], error);
-		mbsys_reson7k_print_fsdwssheader(verbose, &fsdwss->ssheader[i], error);
-	}
+	fprintf(stderr, "%s     vertical_reference:         %d\n", first, navigation->vertical_reference);
+	fprintf(stderr, "%s     latitude:                   %f\n", first, navigation->latitude);
+	fprintf(stderr, "%s     longitude:                  %f\n", first, navigation->longitude);
+	fprintf(stderr, "%s     position_accuracy:          %f\n", first, navigation->position_accuracy);
+	fprintf(stderr, "%s     height:                     %f\n", first, navigation->height);
+	fprintf(stderr, "%s     height_accuracy:            %f\n", first, navigation->height_accuracy);
+	fprintf(stderr, "%s     speed:                      %f\n", first, navigation->speed);
+	fprintf(stderr, "%s     course:                     %f\n", first, navigation->course);
+	fprintf(stderr, "%s     heading:                    %f\n", first, navigation->heading);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -2621,13 +3663,15 @@ int mbsys_reson7k_print_fsdwss(int verbose, s7kr_fsdwss *fsdwss, int *error) {
 	/* return status */
 	return (status);
 }
+
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_fsdwsb(int verbose, s7kr_fsdwsb *fsdwsb, int *error) {
-	char *function_name = "mbsys_reson7k_print_fsdwsb";
+int mbsys_reson7k_print_attitude(int verbose, s7kr_attitude *attitude, int *error) {
+	char *function_name = "mbsys_reson7k_print_attitude";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
+	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -2635,13 +3679,13 @@ int mbsys_reson7k_print_fsdwsb(int verbose, s7kr_fsdwsb *fsdwsb, int *error) {
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
-		fprintf(stderr, "dbg2       fsdwsb:       %p\n", (void *)fsdwsb);
+		fprintf(stderr, "dbg2       attitude:     %p\n", (void *)attitude);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &fsdwsb->header, error);
+	mbsys_reson7k_print_header(verbose, &attitude->header, error);
 
-	/* print Edgetech FS-DW subbottom (record 3001) */
+	/* print Attitude (record 1016) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -2649,13 +3693,11 @@ int mbsys_reson7k_print_fsdwsb(int verbose, s7kr_fsdwsb *fsdwsb, int *error) {
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     msec_timestamp:             %d\n", first, fsdwsb->msec_timestamp);
-	fprintf(stderr, "%s     ping_number:                %u\n", first, fsdwsb->ping_number);
-	fprintf(stderr, "%s     number_channels:            %d\n", first, fsdwsb->number_channels);
-	fprintf(stderr, "%s     total_bytes:                %d\n", first, fsdwsb->total_bytes);
-	fprintf(stderr, "%s     data_format:                %d\n", first, fsdwsb->data_format);
-	mbsys_reson7k_print_fsdwchannel(verbose, fsdwsb->data_format, &fsdwsb->channel, error);
-	mbsys_reson7k_print_fsdwsegyheader(verbose, &fsdwsb->segyheader, error);
+	fprintf(stderr, "%s     n:                          %d\n", first, attitude->n);
+	fprintf(stderr, "%s     nalloc:                     %d\n", first, attitude->nalloc);
+	for (i = 0; i < attitude->n; i++)
+		fprintf(stderr, "%s     i:%d delta_time:%d pitch:%f roll:%f heading:%f heave:%f\n", first, i, attitude->delta_time[i],
+		        attitude->pitch[i], attitude->roll[i], attitude->heading[i], attitude->heave[i]);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -2669,14 +3711,15 @@ int mbsys_reson7k_print_fsdwsb(int verbose, s7kr_fsdwsb *fsdwsb, int *error) {
 	/* return status */
 	return (status);
 }
+
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_bluefin(int verbose, s7kr_bluefin *bluefin, int *error) {
-	char *function_name = "mbsys_reson7k_print_bluefin";
+int mbsys_reson7k_print_rec1022(int verbose, s7kr_rec1022 *rec1022, int *error) {
+	char *function_name = "mbsys_reson7k_print_rec1022";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
-	int i, j;
+	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -2684,13 +3727,13 @@ int mbsys_reson7k_print_bluefin(int verbose, s7kr_bluefin *bluefin, int *error)
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
-		fprintf(stderr, "dbg2       bluefin:      %p\n", (void *)bluefin);
+		fprintf(stderr, "dbg2       rec1022:      %p\n", (void *)rec1022);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &bluefin->header, error);
+	mbsys_reson7k_print_header(verbose, &rec1022->header, error);
 
-	/* print Bluefin data frames (record 3100) */
+	/* print Attitude (record 1016) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -2698,91 +3741,11 @@ int mbsys_reson7k_print_bluefin(int verbose, s7kr_bluefin *bluefin, int *error)
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     msec_timestamp:             %d\n", first, bluefin->msec_timestamp);
-	fprintf(stderr, "%s     number_frames:              %d\n", first, bluefin->number_frames);
-	fprintf(stderr, "%s     frame_size:                 %d\n", first, bluefin->frame_size);
-	fprintf(stderr, "%s     data_format:                %d\n", first, bluefin->data_format);
-	for (i = 0; i < 16; i++)
-		fprintf(stderr, "%s     reserved[%d]:                %d\n", first, i, bluefin->reserved[i]);
-	if (bluefin->data_format == R7KRECID_BluefinNav) {
-		for (i = 0; i < MIN(bluefin->number_frames, BLUEFIN_MAX_FRAMES); i++) {
-			fprintf(stderr, "%s     nav[%d].packet_size:        %d\n", first, i, bluefin->nav[i].packet_size);
-			fprintf(stderr, "%s     nav[%d].version:            %d\n", first, i, bluefin->nav[i].version);
-			fprintf(stderr, "%s     nav[%d].offset:             %d\n", first, i, bluefin->nav[i].offset);
-			fprintf(stderr, "%s     nav[%d].data_type:          %d\n", first, i, bluefin->nav[i].data_type);
-			fprintf(stderr, "%s     nav[%d].data_size:          %d\n", first, i, bluefin->nav[i].data_size);
-			fprintf(stderr, "%s     nav[%d].s7kTime.Year:       %d\n", first, i, bluefin->nav[i].s7kTime.Year);
-			fprintf(stderr, "%s     nav[%d].s7kTime.Day:        %d\n", first, i, bluefin->nav[i].s7kTime.Day);
-			fprintf(stderr, "%s     nav[%d].s7kTime.Seconds:    %f\n", first, i, bluefin->nav[i].s7kTime.Seconds);
-			fprintf(stderr, "%s     nav[%d].s7kTime.Hours:      %d\n", first, i, bluefin->nav[i].s7kTime.Hours);
-			fprintf(stderr, "%s     nav[%d].7kTime->Minutes:    %d\n", first, i, bluefin->nav[i].s7kTime.Minutes);
-			fprintf(stderr, "%s     nav[%d].checksum:           %d\n", first, i, bluefin->nav[i].checksum);
-			fprintf(stderr, "%s     nav[%d].timedelay:          %d\n", first, i, bluefin->nav[i].timedelay);
-			fprintf(stderr, "%s     nav[%d].quality:            %x\n", first, i, bluefin->nav[i].quality);
-			fprintf(stderr, "%s     nav[%d].latitude:           %f\n", first, i, bluefin->nav[i].latitude);
-			fprintf(stderr, "%s     nav[%d].longitude:          %f\n", first, i, bluefin->nav[i].longitude);
-			fprintf(stderr, "%s     nav[%d].speed:              %f\n", first, i, bluefin->nav[i].speed);
-			fprintf(stderr, "%s     nav[%d].depth:              %f\n", first, i, bluefin->nav[i].depth);
-			fprintf(stderr, "%s     nav[%d].altitude:           %f\n", first, i, bluefin->nav[i].altitude);
-			fprintf(stderr, "%s     nav[%d].roll:               %f\n", first, i, bluefin->nav[i].roll);
-			fprintf(stderr, "%s     nav[%d].pitch:              %f\n", first, i, bluefin->nav[i].pitch);
-			fprintf(stderr, "%s     nav[%d].yaw:                %f\n", first, i, bluefin->nav[i].yaw);
-			fprintf(stderr, "%s     nav[%d].northing_rate:      %f\n", first, i, bluefin->nav[i].northing_rate);
-			fprintf(stderr, "%s     nav[%d].easting_rate:       %f\n", first, i, bluefin->nav[i].easting_rate);
-			fprintf(stderr, "%s     nav[%d].depth_rate:         %f\n", first, i, bluefin->nav[i].depth_rate);
-			fprintf(stderr, "%s     nav[%d].altitude_rate:      %f\n", first, i, bluefin->nav[i].altitude_rate);
-			fprintf(stderr, "%s     nav[%d].roll_rate:          %f\n", first, i, bluefin->nav[i].roll_rate);
-			fprintf(stderr, "%s     nav[%d].pitch_rate:         %f\n", first, i, bluefin->nav[i].pitch_rate);
-			fprintf(stderr, "%s     nav[%d].yaw_rate:           %f\n", first, i, bluefin->nav[i].yaw_rate);
-			fprintf(stderr, "%s     nav[%d].position_time:      %f\n", first, i, bluefin->nav[i].position_time);
-			fprintf(stderr, "%s     nav[%d].depth_time:         %f\n", first, i, bluefin->nav[i].depth_time);
-		}
-	}
-	else if (bluefin->data_format == R7KRECID_BluefinEnvironmental) {
-		for (i = 0; i < MIN(bluefin->number_frames, BLUEFIN_MAX_FRAMES); i++) {
-			fprintf(stderr, "%s     env[%d].packet_size:            %d\n", first, i, bluefin->environmental[i].packet_size);
-			fprintf(stderr, "%s     env[%d].version:                %d\n", first, i, bluefin->environmental[i].version);
-			fprintf(stderr, "%s     env[%d].offset:                 %d\n", first, i, bluefin->environmental[i].offset);
-			fprintf(stderr, "%s     env[%d].data_type:              %d\n", first, i, bluefin->environmental[i].data_type);
-			fprintf(stderr, "%s     env[%d].data_size:              %d\n", first, i, bluefin->environmental[i].data_size);
-			fprintf(stderr, "%s     env[%d].s7kTime.Year:           %d\n", first, i, bluefin->environmental[i].s7kTime.Year);
-			fprintf(stderr, "%s     env[%d].s7kTime.Day:            %d\n", first, i, bluefin->environmental[i].s7kTime.Day);
-			fprintf(stderr, "%s     env[%d].s7kTime.Seconds:        %f\n", first, i, bluefin->environmental[i].s7kTime.Seconds);
-			fprintf(stderr, "%s     env[%d].s7kTime.Hours:          %d\n", first, i, bluefin->environmental[i].s7kTime.Hours);
-			fprintf(stderr, "%s     env[%d].7kTime->Minutes:        %d\n", first, i, bluefin->environmental[i].s7kTime.Minutes);
-			fprintf(stderr, "%s     env[%d].checksum:               %d\n", first, i, bluefin->environmental[i].checksum);
-			fprintf(stderr, "%s     env[%d].reserved1:              %d\n", first, i, bluefin->environmental[i].reserved1);
-			fprintf(stderr, "%s     env[%d].quality:                %d\n", first, i, bluefin->environmental[i].quality);
-			fprintf(stderr, "%s     env[%d].sound_speed:            %f\n", first, i, bluefin->environmental[i].sound_speed);
-			fprintf(stderr, "%s     env[%d].conductivity:           %f\n", first, i, bluefin->environmental[i].conductivity);
-			fprintf(stderr, "%s     env[%d].temperature:            %f\n", first, i, bluefin->environmental[i].temperature);
-			fprintf(stderr, "%s     env[%d].pressure:               %f\n", first, i, bluefin->environmental[i].pressure);
-			fprintf(stderr, "%s     env[%d].salinity:               %f\n", first, i, bluefin->environmental[i].salinity);
-			fprintf(stderr, "%s     env[%d].ctd_time:               %f\n", first, i, bluefin->environmental[i].ctd_time);
-			fprintf(stderr, "%s     env[%d].temperature_time:       %f\n", first, i, bluefin->environmental[i].temperature_time);
-			fprintf(stderr, "%s     env[%d].surface_pressure:       %f\n", first, i, bluefin->environmental[i].surface_pressure);
-			fprintf(stderr, "%s     env[%d].temperature_counts:     %d\n", first, i,
-			        bluefin->environmental[i].temperature_counts);
-			fprintf(stderr, "%s     env[%d].conductivity_frequency: %f\n", first, i,
-			        bluefin->environmental[i].conductivity_frequency);
-			fprintf(stderr, "%s     env[%d].pressure_counts:        %d\n", first, i, bluefin->environmental[i].pressure_counts);
-			fprintf(stderr, "%s     env[%d].pressure_comp_voltage:  %f\n", first, i,
-			        bluefin->environmental[i].pressure_comp_voltage);
-			fprintf(stderr, "%s     env[%d].sensor_time_sec:        %d\n", first, i, bluefin->environmental[i].sensor_time_sec);
-			fprintf(stderr, "%s     env[%d].sensor_time_nsec:       %d\n", first, i, bluefin->environmental[i].sensor_time_nsec);
-			fprintf(stderr, "%s     env[%d].sensor1:                %d\n", first, i, bluefin->environmental[i].sensor1);
-			fprintf(stderr, "%s     env[%d].sensor2:                %d\n", first, i, bluefin->environmental[i].sensor2);
-			fprintf(stderr, "%s     env[%d].sensor3:                %d\n", first, i, bluefin->environmental[i].sensor3);
-			fprintf(stderr, "%s     env[%d].sensor4:                %d\n", first, i, bluefin->environmental[i].sensor4);
-			fprintf(stderr, "%s     env[%d].sensor5:                %d\n", first, i, bluefin->environmental[i].sensor5);
-			fprintf(stderr, "%s     env[%d].sensor6:                %d\n", first, i, bluefin->environmental[i].sensor6);
-			fprintf(stderr, "%s     env[%d].sensor7:                %d\n", first, i, bluefin->environmental[i].sensor7);
-			fprintf(stderr, "%s     env[%d].sensor8:                %d\n", first, i, bluefin->environmental[i].sensor8);
-			for (j = 0; j < 8; j++)
-				fprintf(stderr, "%s     env[%d].reserved2[%2d]:          %d\n", first, i, j,
-				        bluefin->environmental[i].reserved2[j]);
-		}
+	fprintf(stderr, "%s     record bytes in hex:        |", first);
+	for (i = 0; i < R7KHDRSIZE_Rec1022; i++) {
+		fprintf(stderr, "%x|", rec1022->data[i]);
 	}
+	fprintf(stderr, "\n");
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -2796,13 +3759,16 @@ int mbsys_reson7k_print_bluefin(int verbose, s7kr_bluefin *bluefin, int *error)
 	/* return status */
 	return (status);
 }
+
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_processedsidescan(int verbose, s7kr_processedsidescan *processedsidescan, int *error) {
-	char *function_name = "mbsys_reson7k_print_processedsidescan";
+int mbsys_reson7k_print_fsdwchannel(int verbose, int data_format, s7k_fsdwchannel *fsdwchannel, int *error) {
+	char *function_name = "mbsys_reson7k_print_fsdwchannel";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
+	short *shortptr;
+	unsigned short *ushortptr;
 	int i;
 
 	/* print input debug statements */
@@ -2810,14 +3776,12 @@ int mbsys_reson7k_print_processedsidescan(int verbose, s7kr_processedsidescan *p
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       processedsidescan: %p\n", (void *)processedsidescan);
+		fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
+		fprintf(stderr, "dbg2       data_format:  %d\n", data_format);
+		fprintf(stderr, "dbg2       fsdwchannel:  %p\n", (void *)fsdwchannel);
 	}
 
-	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &processedsidescan->header, error);
-
-	/* print Reson 7k beam geometry (record 7004) */
+	/* print Edgetech sidescan or subbottom channel header data */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -2825,18 +3789,36 @@ int mbsys_reson7k_print_processedsidescan(int verbose, s7kr_processedsidescan *p
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     serial_number:              %llu\n", first, processedsidescan->serial_number);
-	fprintf(stderr, "%s     ping_number:                %u\n", first, processedsidescan->ping_number);
-	fprintf(stderr, "%s     multi_ping:                 %u\n", first, processedsidescan->multi_ping);
-	fprintf(stderr, "%s     recordversion:              %u\n", first, processedsidescan->recordversion);
-	fprintf(stderr, "%s     ss_source:                  %u\n", first, processedsidescan->ss_source);
-	fprintf(stderr, "%s     number_pixels:              %u\n", first, processedsidescan->number_pixels);
-	fprintf(stderr, "%s     pixelwidth:                 %f\n", first, processedsidescan->pixelwidth);
-	fprintf(stderr, "%s     sonardepth:                 %f\n", first, processedsidescan->sonardepth);
-	fprintf(stderr, "%s     altitude:                   %f\n", first, processedsidescan->altitude);
-	for (i = 0; i < processedsidescan->number_pixels; i++)
-		fprintf(stderr, "%s     pixel[%d]:  sidescan:%f alongtrack:%f\n", first, i, processedsidescan->sidescan[i],
-		        processedsidescan->alongtrack[i]);
+	fprintf(stderr, "%s     number:                     %d\n", first, fsdwchannel->number);
+	fprintf(stderr, "%s     type:                       %d\n", first, fsdwchannel->type);
+	fprintf(stderr, "%s     data_type:                  %d\n", first, fsdwchannel->data_type);
+	fprintf(stderr, "%s     polarity:                   %d\n", first, fsdwchannel->polarity);
+	fprintf(stderr, "%s     bytespersample:             %d\n", first, fsdwchannel->bytespersample);
+	fprintf(stderr, "%s     reserved1[0]                %d\n", first, fsdwchannel->reserved1[0]);
+	fprintf(stderr, "%s     reserved1[1]                %d\n", first, fsdwchannel->reserved1[1]);
+	fprintf(stderr, "%s     reserved1[2]                %d\n", first, fsdwchannel->reserved1[2]);
+	fprintf(stderr, "%s     number_samples:             %d\n", first, fsdwchannel->number_samples);
+	fprintf(stderr, "%s     start_time:                 %d\n", first, fsdwchannel->start_time);
+	fprintf(stderr, "%s     sample_interval:            %d\n", first, fsdwchannel->sample_interval);
+	fprintf(stderr, "%s     range:                      %f\n", first, fsdwchannel->range);
+	fprintf(stderr, "%s     voltage:                    %f\n", first, fsdwchannel->voltage);
+	fprintf(stderr, "%s     name:                       %s\n", first, fsdwchannel->name);
+	fprintf(stderr, "%s     reserved2:                  %s\n", first, fsdwchannel->reserved2);
+	fprintf(stderr, "%s     data_alloc:                 %d\n", first, fsdwchannel->data_alloc);
+	shortptr = (short *)fsdwchannel->data;
+	ushortptr = (unsigned short *)fsdwchannel->data;
+	for (i = 0; i < fsdwchannel->number_samples; i++) {
+		if (data_format == EDGETECH_TRACEFORMAT_ENVELOPE)
+			fprintf(stderr, "%s     data[%d]:                   %d\n", first, i, ushortptr[i]);
+		else if (data_format == EDGETECH_TRACEFORMAT_ANALYTIC)
+			fprintf(stderr, "%s     data[%d]:                   %d %d\n", first, i, shortptr[2 * i], shortptr[2 * i + 1]);
+		else if (data_format == EDGETECH_TRACEFORMAT_RAW)
+			fprintf(stderr, "%s     data[%d]:                   %d\n", first, i, ushortptr[i]);
+		else if (data_format == EDGETECH_TRACEFORMAT_REALANALYTIC)
+			fprintf(stderr, "%s     data[%d]:                   %d\n", first, i, ushortptr[i]);
+		else if (data_format == EDGETECH_TRACEFORMAT_PIXEL)
+			fprintf(stderr, "%s     data[%d]:                   %d\n", first, i, ushortptr[i]);
+	}
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -2850,27 +3832,26 @@ int mbsys_reson7k_print_processedsidescan(int verbose, s7kr_processedsidescan *p
 	/* return status */
 	return (status);
 }
+
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_volatilesettings(int verbose, s7kr_volatilesettings *volatilesettings, int *error) {
-	char *function_name = "mbsys_reson7k_print_volatilesettings";
+int mbsys_reson7k_print_fsdwssheader(int verbose, s7k_fsdwssheader *fsdwssheader, int *error) {
+	char *function_name = "mbsys_reson7k_print_fsdwssheader";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
+	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       volatilesettings:  %p\n", (void *)volatilesettings);
+		fprintf(stderr, "dbg2       verbose:       %d\n", verbose);
+		fprintf(stderr, "dbg2       fsdwssheader:  %p\n", (void *)fsdwssheader);
 	}
 
-	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &volatilesettings->header, error);
-
-	/* print Reson 7k volatile sonar settings (record 7000) */
+	/* print Edgetech sidescan or subbottom channel header data */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -2878,45 +3859,39 @@ int mbsys_reson7k_print_volatilesettings(int verbose, s7kr_volatilesettings *vol
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     serial_number:              %llu\n", first, volatilesettings->serial_number);
-	fprintf(stderr, "%s     ping_number:                %u\n", first, volatilesettings->ping_number);
-	fprintf(stderr, "%s     multi_ping:                 %u\n", first, volatilesettings->multi_ping);
-	fprintf(stderr, "%s     frequency:                  %f\n", first, volatilesettings->frequency);
-	fprintf(stderr, "%s     sample_rate:                %f\n", first, volatilesettings->sample_rate);
-	fprintf(stderr, "%s     receiver_bandwidth:         %f\n", first, volatilesettings->receiver_bandwidth);
-	fprintf(stderr, "%s     pulse_width:                %f\n", first, volatilesettings->pulse_width);
-	fprintf(stderr, "%s     pulse_type:                 %d\n", first, volatilesettings->pulse_type);
-	fprintf(stderr, "%s     pulse_envelope:             %d\n", first, volatilesettings->pulse_envelope);
-	fprintf(stderr, "%s     pulse_envelope_par:         %f\n", first, volatilesettings->pulse_envelope_par);
-	fprintf(stderr, "%s     pulse_reserved:             %d\n", first, volatilesettings->pulse_reserved);
-	fprintf(stderr, "%s     max_ping_rate:              %f\n", first, volatilesettings->max_ping_rate);
-	fprintf(stderr, "%s     ping_period:                %f\n", first, volatilesettings->ping_period);
-	fprintf(stderr, "%s     range_selection:            %f\n", first, volatilesettings->range_selection);
-	fprintf(stderr, "%s     power_selection:            %f\n", first, volatilesettings->power_selection);
-	fprintf(stderr, "%s     gain_selection:             %f\n", first, volatilesettings->gain_selection);
-	fprintf(stderr, "%s     control_flags:              %d\n", first, volatilesettings->control_flags);
-	fprintf(stderr, "%s     projector_magic_no:         %d\n", first, volatilesettings->projector_magic_no);
-	fprintf(stderr, "%s     steering_vertical:          %f\n", first, volatilesettings->steering_vertical);
-	fprintf(stderr, "%s     steering_horizontal:        %f\n", first, volatilesettings->steering_horizontal);
-	fprintf(stderr, "%s     beamwidth_vertical:         %f\n", first, volatilesettings->beamwidth_vertical);
-	fprintf(stderr, "%s     beamwidth_horizontal:       %f\n", first, volatilesettings->beamwidth_horizontal);
-	fprintf(stderr, "%s     focal_point:                %f\n", first, volatilesettings->focal_point);
-	fprintf(stderr, "%s     projector_weighting:        %d\n", first, volatilesettings->projector_weighting);
-	fprintf(stderr, "%s     projector_weighting_par:    %f\n", first, volatilesettings->projector_weighting_par);
-	fprintf(stderr, "%s     transmit_flags:             %d\n", first, volatilesettings->transmit_flags);
-	fprintf(stderr, "%s     hydrophone_magic_no:        %d\n", first, volatilesettings->hydrophone_magic_no);
-	fprintf(stderr, "%s     receive_weighting:          %d\n", first, volatilesettings->receive_weighting);
-	fprintf(stderr, "%s     receive_weighting_par:      %f\n", first, volatilesettings->receive_weighting_par);
-	fprintf(stderr, "%s     receive_flags:              %d\n", first, volatilesettings->receive_flags);
-	fprintf(stderr, "%s     receive_width:              %f\n", first, volatilesettings->receive_width);
-	fprintf(stderr, "%s     range_minimum:              %f\n", first, volatilesettings->range_minimum);
-	fprintf(stderr, "%s     range_maximum:              %f\n", first, volatilesettings->range_maximum);
-	fprintf(stderr, "%s     depth_minimum:              %f\n", first, volatilesettings->depth_minimum);
-	fprintf(stderr, "%s     depth_maximum:              %f\n", first, volatilesettings->depth_maximum);
-	fprintf(stderr, "%s     absorption:                 %f\n", first, volatilesettings->absorption);
-	fprintf(stderr, "%s     sound_velocity:             %f\n", first, volatilesettings->sound_velocity);
-	fprintf(stderr, "%s     spreading:                  %f\n", first, volatilesettings->spreading);
-	fprintf(stderr, "%s     reserved:                   %d\n", first, volatilesettings->reserved);
+	fprintf(stderr, "%s     subsystem:                    %d\n", first, fsdwssheader->subsystem);
+	fprintf(stderr, "%s     channelNum:                   %d\n", first, fsdwssheader->channelNum);
+	fprintf(stderr, "%s     pingNum:                      %d\n", first, fsdwssheader->pingNum);
+	fprintf(stderr, "%s     packetNum:                    %d\n", first, fsdwssheader->packetNum);
+	fprintf(stderr, "%s     trigSource:                   %d\n", first, fsdwssheader->trigSource);
+	fprintf(stderr, "%s     samples:                      %d\n", first, fsdwssheader->samples);
+	fprintf(stderr, "%s     sampleInterval:               %d\n", first, fsdwssheader->sampleInterval);
+	fprintf(stderr, "%s     startDepth:                   %d\n", first, fsdwssheader->startDepth);
+	fprintf(stderr, "%s     weightingFactor:              %d\n", first, fsdwssheader->weightingFactor);
+	fprintf(stderr, "%s     ADCGain:                      %d\n", first, fsdwssheader->ADCGain);
+	fprintf(stderr, "%s     ADCMax:                       %d\n", first, fsdwssheader->ADCMax);
+	fprintf(stderr, "%s     rangeSetting:                 %d\n", first, fsdwssheader->rangeSetting);
+	fprintf(stderr, "%s     pulseID:                      %d\n", first, fsdwssheader->pulseID);
+	fprintf(stderr, "%s     markNumber:                   %d\n", first, fsdwssheader->markNumber);
+	fprintf(stderr, "%s     dataFormat:                   %d\n", first, fsdwssheader->dataFormat);
+	fprintf(stderr, "%s     reserved:                     %d\n", first, fsdwssheader->reserved);
+	fprintf(stderr, "%s     millisecondsToday:            %d\n", first, fsdwssheader->millisecondsToday);
+	fprintf(stderr, "%s     year:                         %d\n", first, fsdwssheader->year);
+	fprintf(stderr, "%s     day:                          %d\n", first, fsdwssheader->day);
+	fprintf(stderr, "%s     hour:                         %d\n", first, fsdwssheader->hour);
+	fprintf(stderr, "%s     minute:                       %d\n", first, fsdwssheader->minute);
+	fprintf(stderr, "%s     second:                       %d\n", first, fsdwssheader->second);
+	fprintf(stderr, "%s     heading:                      %d\n", first, fsdwssheader->heading);
+	fprintf(stderr, "%s     pitch:                        %d\n", first, fsdwssheader->pitch);
+	fprintf(stderr, "%s     roll:                         %d\n", first, fsdwssheader->roll);
+	fprintf(stderr, "%s     heave:                        %d\n", first, fsdwssheader->heave);
+	fprintf(stderr, "%s     yaw:                          %d\n", first, fsdwssheader->yaw);
+	fprintf(stderr, "%s     depth:                        %d\n", first, fsdwssheader->depth);
+	fprintf(stderr, "%s     temperature:                  %d\n", first, fsdwssheader->temperature);
+	for (i = 0; i < 2; i++)
+		fprintf(stderr, "%s     reserved2[%d]:                 %d\n", first, i, fsdwssheader->reserved2[i]);
+	fprintf(stderr, "%s     longitude:                    %d\n", first, fsdwssheader->longitude);
+	fprintf(stderr, "%s     latitude:                     %d\n", first, fsdwssheader->latitude);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -2930,24 +3905,26 @@ int mbsys_reson7k_print_volatilesettings(int verbose, s7kr_volatilesettings *vol
 	/* return status */
 	return (status);
 }
+
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_device(int verbose, s7k_device *device, int *error) {
-	char *function_name = "mbsys_reson7k_print_device";
+int mbsys_reson7k_print_fsdwsegyheader(int verbose, s7k_fsdwsegyheader *fsdwsegyheader, int *error) {
+	char *function_name = "mbsys_reson7k_print_fsdwsegyheader";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
+	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       device:            %p\n", (void *)device);
+		fprintf(stderr, "dbg2       verbose:         %d\n", verbose);
+		fprintf(stderr, "dbg2       fsdwsegyheader:  %p\n", (void *)fsdwsegyheader);
 	}
 
-	/* print Reson 7k device configuration structure */
+	/* print Edgetech sidescan or subbottom channel header data */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -2955,12 +3932,73 @@ int mbsys_reson7k_print_device(int verbose, s7k_device *device, int *error) {
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     magic_number:               %d\n", first, device->magic_number);
-	fprintf(stderr, "%s     description:                %s\n", first, device->description);
-	fprintf(stderr, "%s     serial_number:              %llu\n", first, device->serial_number);
-	fprintf(stderr, "%s     info_length:                %d\n", first, device->info_length);
-	fprintf(stderr, "%s     info_alloc:                 %d\n", first, device->info_alloc);
-	fprintf(stderr, "%s     info:                       %s\n", first, device->info);
+	fprintf(stderr, "%s     sequenceNumber:              %d\n", first, fsdwsegyheader->sequenceNumber);
+	fprintf(stderr, "%s     startDepth:                  %d\n", first, fsdwsegyheader->startDepth);
+	fprintf(stderr, "%s     pingNum:                     %d\n", first, fsdwsegyheader->pingNum);
+	fprintf(stderr, "%s     channelNum:                  %d\n", first, fsdwsegyheader->channelNum);
+	for (i = 0; i < 6; i++)
+		fprintf(stderr, "%s     unused1[%d]:                  %d\n", first, i, fsdwsegyheader->unused1[i]);
+	fprintf(stderr, "%s     traceIDCode:                 %d\n", first, fsdwsegyheader->traceIDCode);
+	for (i = 0; i < 2; i++)
+		fprintf(stderr, "%s     unused2[%d]:                  %d\n", first, i, fsdwsegyheader->unused2[i]);
+	fprintf(stderr, "%s     dataFormat:                  %d\n", first, fsdwsegyheader->dataFormat);
+	fprintf(stderr, "%s     NMEAantennaeR:               %d\n", first, fsdwsegyheader->NMEAantennaeR);
+	fprintf(stderr, "%s     NMEAantennaeO:               %d\n", first, fsdwsegyheader->NMEAantennaeO);
+	for (i = 0; i < 32; i++)
+		fprintf(stderr, "%s     RS232[%d]:                   %d\n", first, i, fsdwsegyheader->RS232[i]);
+	fprintf(stderr, "%s     sourceCoordX:                %d\n", first, fsdwsegyheader->sourceCoordX);
+	fprintf(stderr, "%s     sourceCoordY:                %d\n", first, fsdwsegyheader->sourceCoordY);
+	fprintf(stderr, "%s     groupCoordX:                 %d\n", first, fsdwsegyheader->groupCoordX);
+	fprintf(stderr, "%s     groupCoordY:                 %d\n", first, fsdwsegyheader->groupCoordY);
+	fprintf(stderr, "%s     coordUnits:                  %d\n", first, fsdwsegyheader->coordUnits);
+	fprintf(stderr, "%s     annotation:                  %s\n", first, fsdwsegyheader->annotation);
+	fprintf(stderr, "%s     samples:                     %d\n", first, fsdwsegyheader->samples);
+	fprintf(stderr, "%s     sampleInterval:              %d\n", first, fsdwsegyheader->sampleInterval);
+	fprintf(stderr, "%s     ADCGain:                     %d\n", first, fsdwsegyheader->ADCGain);
+	fprintf(stderr, "%s     pulsePower:                  %d\n", first, fsdwsegyheader->pulsePower);
+	fprintf(stderr, "%s     correlated:                  %d\n", first, fsdwsegyheader->correlated);
+	fprintf(stderr, "%s     startFreq:                   %d\n", first, fsdwsegyheader->startFreq);
+	fprintf(stderr, "%s     endFreq:                     %d\n", first, fsdwsegyheader->endFreq);
+	fprintf(stderr, "%s     sweepLength:                 %d\n", first, fsdwsegyheader->sweepLength);
+	for (i = 0; i < 4; i++)
+		fprintf(stderr, "%s     unused7[%d]:                  %d\n", first, i, fsdwsegyheader->unused7[i]);
+	fprintf(stderr, "%s     aliasFreq:                   %d\n", first, fsdwsegyheader->aliasFreq);
+	fprintf(stderr, "%s     pulseID:                     %d\n", first, fsdwsegyheader->pulseID);
+	for (i = 0; i < 6; i++)
+		fprintf(stderr, "%s     unused8[%d]:                  %d\n", first, i, fsdwsegyheader->unused8[i]);
+	fprintf(stderr, "%s     year:                        %d\n", first, fsdwsegyheader->year);
+	fprintf(stderr, "%s     day:                         %d\n", first, fsdwsegyheader->day);
+	fprintf(stderr, "%s     hour:                        %d\n", first, fsdwsegyheader->hour);
+	fprintf(stderr, "%s     minute:                      %d\n", first, fsdwsegyheader->minute);
+	fprintf(stderr, "%s     second:                      %d\n", first, fsdwsegyheader->second);
+	fprintf(stderr, "%s     timeBasis:                   %d\n", first, fsdwsegyheader->timeBasis);
+	fprintf(stderr, "%s     weightingFactor:             %d\n", first, fsdwsegyheader->weightingFactor);
+	fprintf(stderr, "%s     unused9:                     %d\n", first, fsdwsegyheader->unused9);
+	fprintf(stderr, "%s     heading:                     %d\n", first, fsdwsegyheader->heading);
+	fprintf(stderr, "%s     pitch:                       %d\n", first, fsdwsegyheader->pitch);
+	fprintf(stderr, "%s     roll:                        %d\n", first, fsdwsegyheader->roll);
+	fprintf(stderr, "%s     temperature:                 %d\n", first, fsdwsegyheader->temperature);
+	fprintf(stderr, "%s     heaveCompensation:           %d\n", first, fsdwsegyheader->heaveCompensation);
+	fprintf(stderr, "%s     trigSource:                  %d\n", first, fsdwsegyheader->trigSource);
+	fprintf(stderr, "%s     markNumber:                  %d\n", first, fsdwsegyheader->markNumber);
+	fprintf(stderr, "%s     NMEAHour:                    %d\n", first, fsdwsegyheader->NMEAHour);
+	fprintf(stderr, "%s     NMEAMinutes:                 %d\n", first, fsdwsegyheader->NMEAMinutes);
+	fprintf(stderr, "%s     NMEASeconds:                 %d\n", first, fsdwsegyheader->NMEASeconds);
+	fprintf(stderr, "%s     NMEACourse:                  %d\n", first, fsdwsegyheader->NMEACourse);
+	fprintf(stderr, "%s     NMEASpeed:                   %d\n", first, fsdwsegyheader->NMEASpeed);
+	fprintf(stderr, "%s     NMEADay:                     %d\n", first, fsdwsegyheader->NMEADay);
+	fprintf(stderr, "%s     NMEAYear:                    %d\n", first, fsdwsegyheader->NMEAYear);
+	fprintf(stderr, "%s     millisecondsToday:           %d\n", first, fsdwsegyheader->millisecondsToday);
+	fprintf(stderr, "%s     ADCMax:                      %d\n", first, fsdwsegyheader->ADCMax);
+	fprintf(stderr, "%s     calConst:                    %d\n", first, fsdwsegyheader->calConst);
+	fprintf(stderr, "%s     vehicleID:                   %d\n", first, fsdwsegyheader->vehicleID);
+	fprintf(stderr, "%s     softwareVersion:             %s\n", first, fsdwsegyheader->softwareVersion);
+	fprintf(stderr, "%s     sphericalCorrection:         %d\n", first, fsdwsegyheader->sphericalCorrection);
+	fprintf(stderr, "%s     packetNum:                   %d\n", first, fsdwsegyheader->packetNum);
+	fprintf(stderr, "%s     ADCDecimation:               %d\n", first, fsdwsegyheader->ADCDecimation);
+	fprintf(stderr, "%s     decimation:                  %d\n", first, fsdwsegyheader->decimation);
+	for (i = 0; i < 7; i++)
+		fprintf(stderr, "%s     unuseda[%d]:                  %d\n", first, i, fsdwsegyheader->unuseda[i]);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -2974,9 +4012,10 @@ int mbsys_reson7k_print_device(int verbose, s7k_device *device, int *error) {
 	/* return status */
 	return (status);
 }
+
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_configuration(int verbose, s7kr_configuration *configuration, int *error) {
-	char *function_name = "mbsys_reson7k_print_configuration";
+int mbsys_reson7k_print_fsdwss(int verbose, s7kr_fsdwss *fsdwss, int *error) {
+	char *function_name = "mbsys_reson7k_print_fsdwss";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
@@ -2988,14 +4027,14 @@ int mbsys_reson7k_print_configuration(int verbose, s7kr_configuration *configura
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       configuration:     %p\n", (void *)configuration);
+		fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
+		fprintf(stderr, "dbg2       fsdwss:       %p\n", (void *)fsdwss);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &configuration->header, error);
+	mbsys_reson7k_print_header(verbose, &fsdwss->header, error);
 
-	/* print Reson 7k configuration (record 7001) */
+	/* print Edgetech FS-DW sidescan (record 3000) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -3003,10 +4042,15 @@ int mbsys_reson7k_print_configuration(int verbose, s7kr_configuration *configura
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     serial_number:              %llu\n", first, configuration->serial_number);
-	fprintf(stderr, "%s     number_devices:             %d\n", first, configuration->number_devices);
-	for (i = 0; i < configuration->number_devices; i++)
-		mbsys_reson7k_print_device(verbose, &configuration->device[i], error);
+	fprintf(stderr, "%s     msec_timestamp:             %d\n", first, fsdwss->msec_timestamp);
+	fprintf(stderr, "%s     ping_number:                %u\n", first, fsdwss->ping_number);
+	fprintf(stderr, "%s     number_channels:            %d\n", first, fsdwss->number_channels);
+	fprintf(stderr, "%s     total_bytes:                %d\n", first, fsdwss->total_bytes);
+	fprintf(stderr, "%s     data_format:                %d\n", first, fsdwss->data_format);
+	for (i = 0; i < fsdwss->number_channels; i++) {
+		mbsys_reson7k_print_fsdwchannel(verbose, fsdwss->data_format, &fsdwss->channel[i], error);
+		mbsys_reson7k_print_fsdwssheader(verbose, &fsdwss->ssheader[i], error);
+	}
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -3021,8 +4065,8 @@ int mbsys_reson7k_print_configuration(int verbose, s7kr_configuration *configura
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_matchfilter(int verbose, s7kr_matchfilter *matchfilter, int *error) {
-	char *function_name = "mbsys_reson7k_print_matchfilter";
+int mbsys_reson7k_print_fsdwsb(int verbose, s7kr_fsdwsb *fsdwsb, int *error) {
+	char *function_name = "mbsys_reson7k_print_fsdwsb";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
@@ -3033,14 +4077,14 @@ int mbsys_reson7k_print_matchfilter(int verbose, s7kr_matchfilter *matchfilter,
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       matchfilter:       %p\n", (void *)matchfilter);
+		fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
+		fprintf(stderr, "dbg2       fsdwsb:       %p\n", (void *)fsdwsb);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &matchfilter->header, error);
+	mbsys_reson7k_print_header(verbose, &fsdwsb->header, error);
 
-	/* print Reson 7k match filter (record 7002) */
+	/* print Edgetech FS-DW subbottom (record 3001) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -3048,11 +4092,13 @@ int mbsys_reson7k_print_matchfilter(int verbose, s7kr_matchfilter *matchfilter,
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     serial_number:              %llu\n", first, matchfilter->serial_number);
-	fprintf(stderr, "%s     ping_number:                %u\n", first, matchfilter->ping_number);
-	fprintf(stderr, "%s     operation:                  %d\n", first, matchfilter->operation);
-	fprintf(stderr, "%s     start_frequency:            %f\n", first, matchfilter->start_frequency);
-	fprintf(stderr, "%s     end_frequency:              %f\n", first, matchfilter->end_frequency);
+	fprintf(stderr, "%s     msec_timestamp:             %d\n", first, fsdwsb->msec_timestamp);
+	fprintf(stderr, "%s     ping_number:                %u\n", first, fsdwsb->ping_number);
+	fprintf(stderr, "%s     number_channels:            %d\n", first, fsdwsb->number_channels);
+	fprintf(stderr, "%s     total_bytes:                %d\n", first, fsdwsb->total_bytes);
+	fprintf(stderr, "%s     data_format:                %d\n", first, fsdwsb->data_format);
+	mbsys_reson7k_print_fsdwchannel(verbose, fsdwsb->data_format, &fsdwsb->channel, error);
+	mbsys_reson7k_print_fsdwsegyheader(verbose, &fsdwsb->segyheader, error);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -3067,28 +4113,27 @@ int mbsys_reson7k_print_matchfilter(int verbose, s7kr_matchfilter *matchfilter,
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_v2firmwarehardwareconfiguration(int verbose,
-                                                        s7kr_v2firmwarehardwareconfiguration *v2firmwarehardwareconfiguration,
-                                                        int *error) {
-	char *function_name = "mbsys_reson7k_print_v2firmwarehardwareconfiguration";
+int mbsys_reson7k_print_bluefin(int verbose, s7kr_bluefin *bluefin, int *error) {
+	char *function_name = "mbsys_reson7k_print_bluefin";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
+	int i, j;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       v2firmwarehardwareconfiguration:       %p\n", (void *)v2firmwarehardwareconfiguration);
+		fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
+		fprintf(stderr, "dbg2       bluefin:      %p\n", (void *)bluefin);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &v2firmwarehardwareconfiguration->header, error);
+	mbsys_reson7k_print_header(verbose, &bluefin->header, error);
 
-	/* print Reson 7k match filter (record 7002) */
+	/* print Bluefin data frames (record 3100) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -3096,26 +4141,107 @@ int mbsys_reson7k_print_v2firmwarehardwareconfiguration(int verbose,
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     device_count:               %d\n", first, v2firmwarehardwareconfiguration->device_count);
-	fprintf(stderr, "%s     info_length:                %d\n", first, v2firmwarehardwareconfiguration->info_length);
-	fprintf(stderr, "%s     info:                       \n", first);
-	fprintf(stderr, "%s\n%s\n", v2firmwarehardwareconfiguration->info, first);
-
-	/* print output debug statements */
-	if (verbose >= 2) {
-		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
-		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       error:      %d\n", *error);
-		fprintf(stderr, "dbg2  Return status:\n");
-		fprintf(stderr, "dbg2       status:     %d\n", status);
-	}
-
-	/* return status */
-	return (status);
-}
-/*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_beamgeometry(int verbose, s7kr_beamgeometry *beamgeometry, int *error) {
-	char *function_name = "mbsys_reson7k_print_beamgeometry";
+	fprintf(stderr, "%s     msec_timestamp:             %d\n", first, bluefin->msec_timestamp);
+	fprintf(stderr, "%s     number_frames:              %d\n", first, bluefin->number_frames);
+	fprintf(stderr, "%s     frame_size:                 %d\n", first, bluefin->frame_size);
+	fprintf(stderr, "%s     data_format:                %d\n", first, bluefin->data_format);
+	for (i = 0; i < 16; i++)
+		fprintf(stderr, "%s     reserved[%d]:                %d\n", first, i, bluefin->reserved[i]);
+	if (bluefin->data_format == R7KRECID_BluefinNav) {
+		for (i = 0; i < MIN(bluefin->number_frames, BLUEFIN_MAX_FRAMES); i++) {
+			fprintf(stderr, "%s     nav[%d].packet_size:        %d\n", first, i, bluefin->nav[i].packet_size);
+			fprintf(stderr, "%s     nav[%d].version:            %d\n", first, i, bluefin->nav[i].version);
+			fprintf(stderr, "%s     nav[%d].offset:             %d\n", first, i, bluefin->nav[i].offset);
+			fprintf(stderr, "%s     nav[%d].data_type:          %d\n", first, i, bluefin->nav[i].data_type);
+			fprintf(stderr, "%s     nav[%d].data_size:          %d\n", first, i, bluefin->nav[i].data_size);
+			fprintf(stderr, "%s     nav[%d].s7kTime.Year:       %d\n", first, i, bluefin->nav[i].s7kTime.Year);
+			fprintf(stderr, "%s     nav[%d].s7kTime.Day:        %d\n", first, i, bluefin->nav[i].s7kTime.Day);
+			fprintf(stderr, "%s     nav[%d].s7kTime.Seconds:    %f\n", first, i, bluefin->nav[i].s7kTime.Seconds);
+			fprintf(stderr, "%s     nav[%d].s7kTime.Hours:      %d\n", first, i, bluefin->nav[i].s7kTime.Hours);
+			fprintf(stderr, "%s     nav[%d].7kTime->Minutes:    %d\n", first, i, bluefin->nav[i].s7kTime.Minutes);
+			fprintf(stderr, "%s     nav[%d].checksum:           %d\n", first, i, bluefin->nav[i].checksum);
+			fprintf(stderr, "%s     nav[%d].timedelay:          %d\n", first, i, bluefin->nav[i].timedelay);
+			fprintf(stderr, "%s     nav[%d].quality:            %x\n", first, i, bluefin->nav[i].quality);
+			fprintf(stderr, "%s     nav[%d].latitude:           %f\n", first, i, bluefin->nav[i].latitude);
+			fprintf(stderr, "%s     nav[%d].longitude:          %f\n", first, i, bluefin->nav[i].longitude);
+			fprintf(stderr, "%s     nav[%d].speed:              %f\n", first, i, bluefin->nav[i].speed);
+			fprintf(stderr, "%s     nav[%d].depth:              %f\n", first, i, bluefin->nav[i].depth);
+			fprintf(stderr, "%s     nav[%d].altitude:           %f\n", first, i, bluefin->nav[i].altitude);
+			fprintf(stderr, "%s     nav[%d].roll:               %f\n", first, i, bluefin->nav[i].roll);
+			fprintf(stderr, "%s     nav[%d].pitch:              %f\n", first, i, bluefin->nav[i].pitch);
+			fprintf(stderr, "%s     nav[%d].yaw:                %f\n", first, i, bluefin->nav[i].yaw);
+			fprintf(stderr, "%s     nav[%d].northing_rate:      %f\n", first, i, bluefin->nav[i].northing_rate);
+			fprintf(stderr, "%s     nav[%d].easting_rate:       %f\n", first, i, bluefin->nav[i].easting_rate);
+			fprintf(stderr, "%s     nav[%d].depth_rate:         %f\n", first, i, bluefin->nav[i].depth_rate);
+			fprintf(stderr, "%s     nav[%d].altitude_rate:      %f\n", first, i, bluefin->nav[i].altitude_rate);
+			fprintf(stderr, "%s     nav[%d].roll_rate:          %f\n", first, i, bluefin->nav[i].roll_rate);
+			fprintf(stderr, "%s     nav[%d].pitch_rate:         %f\n", first, i, bluefin->nav[i].pitch_rate);
+			fprintf(stderr, "%s     nav[%d].yaw_rate:           %f\n", first, i, bluefin->nav[i].yaw_rate);
+			fprintf(stderr, "%s     nav[%d].position_time:      %f\n", first, i, bluefin->nav[i].position_time);
+			fprintf(stderr, "%s     nav[%d].depth_time:         %f\n", first, i, bluefin->nav[i].depth_time);
+		}
+	}
+	else if (bluefin->data_format == R7KRECID_BluefinEnvironmental) {
+		for (i = 0; i < MIN(bluefin->number_frames, BLUEFIN_MAX_FRAMES); i++) {
+			fprintf(stderr, "%s     env[%d].packet_size:            %d\n", first, i, bluefin->environmental[i].packet_size);
+			fprintf(stderr, "%s     env[%d].version:                %d\n", first, i, bluefin->environmental[i].version);
+			fprintf(stderr, "%s     env[%d].offset:                 %d\n", first, i, bluefin->environmental[i].offset);
+			fprintf(stderr, "%s     env[%d].data_type:              %d\n", first, i, bluefin->environmental[i].data_type);
+			fprintf(stderr, "%s     env[%d].data_size:              %d\n", first, i, bluefin->environmental[i].data_size);
+			fprintf(stderr, "%s     env[%d].s7kTime.Year:           %d\n", first, i, bluefin->environmental[i].s7kTime.Year);
+			fprintf(stderr, "%s     env[%d].s7kTime.Day:            %d\n", first, i, bluefin->environmental[i].s7kTime.Day);
+			fprintf(stderr, "%s     env[%d].s7kTime.Seconds:        %f\n", first, i, bluefin->environmental[i].s7kTime.Seconds);
+			fprintf(stderr, "%s     env[%d].s7kTime.Hours:          %d\n", first, i, bluefin->environmental[i].s7kTime.Hours);
+			fprintf(stderr, "%s     env[%d].7kTime->Minutes:        %d\n", first, i, bluefin->environmental[i].s7kTime.Minutes);
+			fprintf(stderr, "%s     env[%d].checksum:               %d\n", first, i, bluefin->environmental[i].checksum);
+			fprintf(stderr, "%s     env[%d].reserved1:              %d\n", first, i, bluefin->environmental[i].reserved1);
+			fprintf(stderr, "%s     env[%d].quality:                %d\n", first, i, bluefin->environmental[i].quality);
+			fprintf(stderr, "%s     env[%d].sound_speed:            %f\n", first, i, bluefin->environmental[i].sound_speed);
+			fprintf(stderr, "%s     env[%d].conductivity:           %f\n", first, i, bluefin->environmental[i].conductivity);
+			fprintf(stderr, "%s     env[%d].temperature:            %f\n", first, i, bluefin->environmental[i].temperature);
+			fprintf(stderr, "%s     env[%d].pressure:               %f\n", first, i, bluefin->environmental[i].pressure);
+			fprintf(stderr, "%s     env[%d].salinity:               %f\n", first, i, bluefin->environmental[i].salinity);
+			fprintf(stderr, "%s     env[%d].ctd_time:               %f\n", first, i, bluefin->environmental[i].ctd_time);
+			fprintf(stderr, "%s     env[%d].temperature_time:       %f\n", first, i, bluefin->environmental[i].temperature_time);
+			fprintf(stderr, "%s     env[%d].surface_pressure:       %f\n", first, i, bluefin->environmental[i].surface_pressure);
+			fprintf(stderr, "%s     env[%d].temperature_counts:     %d\n", first, i,
+			        bluefin->environmental[i].temperature_counts);
+			fprintf(stderr, "%s     env[%d].conductivity_frequency: %f\n", first, i,
+			        bluefin->environmental[i].conductivity_frequency);
+			fprintf(stderr, "%s     env[%d].pressure_counts:        %d\n", first, i, bluefin->environmental[i].pressure_counts);
+			fprintf(stderr, "%s     env[%d].pressure_comp_voltage:  %f\n", first, i,
+			        bluefin->environmental[i].pressure_comp_voltage);
+			fprintf(stderr, "%s     env[%d].sensor_time_sec:        %d\n", first, i, bluefin->environmental[i].sensor_time_sec);
+			fprintf(stderr, "%s     env[%d].sensor_time_nsec:       %d\n", first, i, bluefin->environmental[i].sensor_time_nsec);
+			fprintf(stderr, "%s     env[%d].sensor1:                %d\n", first, i, bluefin->environmental[i].sensor1);
+			fprintf(stderr, "%s     env[%d].sensor2:                %d\n", first, i, bluefin->environmental[i].sensor2);
+			fprintf(stderr, "%s     env[%d].sensor3:                %d\n", first, i, bluefin->environmental[i].sensor3);
+			fprintf(stderr, "%s     env[%d].sensor4:                %d\n", first, i, bluefin->environmental[i].sensor4);
+			fprintf(stderr, "%s     env[%d].sensor5:                %d\n", first, i, bluefin->environmental[i].sensor5);
+			fprintf(stderr, "%s     env[%d].sensor6:                %d\n", first, i, bluefin->environmental[i].sensor6);
+			fprintf(stderr, "%s     env[%d].sensor7:                %d\n", first, i, bluefin->environmental[i].sensor7);
+			fprintf(stderr, "%s     env[%d].sensor8:                %d\n", first, i, bluefin->environmental[i].sensor8);
+			for (j = 0; j < 8; j++)
+				fprintf(stderr, "%s     env[%d].reserved2[%2d]:          %d\n", first, i, j,
+				        bluefin->environmental[i].reserved2[j]);
+		}
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_print_processedsidescan(int verbose, s7kr_processedsidescan *processedsidescan, int *error) {
+	char *function_name = "mbsys_reson7k_print_processedsidescan";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
@@ -3128,11 +4254,11 @@ int mbsys_reson7k_print_beamgeometry(int verbose, s7kr_beamgeometry *beamgeometr
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       beamgeometry:      %p\n", (void *)beamgeometry);
+		fprintf(stderr, "dbg2       processedsidescan: %p\n", (void *)processedsidescan);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &beamgeometry->header, error);
+	mbsys_reson7k_print_header(verbose, &processedsidescan->header, error);
 
 	/* print Reson 7k beam geometry (record 7004) */
 	if (verbose >= 2)
@@ -3142,13 +4268,18 @@ int mbsys_reson7k_print_beamgeometry(int verbose, s7kr_beamgeometry *beamgeometr
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     serial_number:              %llu\n", first, beamgeometry->serial_number);
-	fprintf(stderr, "%s     number_beams:               %u\n", first, beamgeometry->number_beams);
-	for (i = 0; i < beamgeometry->number_beams; i++)
-		fprintf(stderr,
-		        "%s     beam[%d]:  angle_alongtrack:%f angle_acrosstrack:%f beamwidth_alongtrack:%f beamwidth_acrosstrack:%f\n",
-		        first, i, beamgeometry->angle_alongtrack[i], beamgeometry->angle_acrosstrack[i],
-		        beamgeometry->beamwidth_alongtrack[i], beamgeometry->beamwidth_acrosstrack[i]);
+	fprintf(stderr, "%s     serial_number:              %llu\n", first, processedsidescan->serial_number);
+	fprintf(stderr, "%s     ping_number:                %u\n", first, processedsidescan->ping_number);
+	fprintf(stderr, "%s     multi_ping:                 %u\n", first, processedsidescan->multi_ping);
+	fprintf(stderr, "%s     recordversion:              %u\n", first, processedsidescan->recordversion);
+	fprintf(stderr, "%s     ss_source:                  %u\n", first, processedsidescan->ss_source);
+	fprintf(stderr, "%s     number_pixels:              %u\n", first, processedsidescan->number_pixels);
+	fprintf(stderr, "%s     pixelwidth:                 %f\n", first, processedsidescan->pixelwidth);
+	fprintf(stderr, "%s     sonardepth:                 %f\n", first, processedsidescan->sonardepth);
+	fprintf(stderr, "%s     altitude:                   %f\n", first, processedsidescan->altitude);
+	for (i = 0; i < processedsidescan->number_pixels; i++)
+		fprintf(stderr, "%s     pixel[%d]:  sidescan:%f alongtrack:%f\n", first, i, processedsidescan->sidescan[i],
+		        processedsidescan->alongtrack[i]);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -3163,13 +4294,12 @@ int mbsys_reson7k_print_beamgeometry(int verbose, s7kr_beamgeometry *beamgeometr
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_calibration(int verbose, s7kr_calibration *calibration, int *error) {
-	char *function_name = "mbsys_reson7k_print_calibration";
+int mbsys_reson7k_print_volatilesettings(int verbose, s7kr_volatilesettings *volatilesettings, int *error) {
+	char *function_name = "mbsys_reson7k_print_volatilesettings";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
-	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -3177,13 +4307,13 @@ int mbsys_reson7k_print_calibration(int verbose, s7kr_calibration *calibration,
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       calibration:       %p\n", (void *)calibration);
+		fprintf(stderr, "dbg2       volatilesettings:  %p\n", (void *)volatilesettings);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &calibration->header, error);
+	mbsys_reson7k_print_header(verbose, &volatilesettings->header, error);
 
-	/* print Reson 7k calibration data (record 7005) */
+	/* print Reson 7k volatile sonar settings (record 7000) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -3191,10 +4321,45 @@ int mbsys_reson7k_print_calibration(int verbose, s7kr_calibration *calibration,
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     serial_number:              %llu\n", first, calibration->serial_number);
-	fprintf(stderr, "%s     number_channels:            %d\n", first, calibration->number_channels);
-	for (i = 0; i < calibration->number_channels; i++)
-		fprintf(stderr, "%s     channel[%d]:  gain:%f phase:%f\n", first, i, calibration->gain[i], calibration->phase[i]);
+	fprintf(stderr, "%s     serial_number:              %llu\n", first, volatilesettings->serial_number);
+	fprintf(stderr, "%s     ping_number:                %u\n", first, volatilesettings->ping_number);
+	fprintf(stderr, "%s     multi_ping:                 %u\n", first, volatilesettings->multi_ping);
+	fprintf(stderr, "%s     frequency:                  %f\n", first, volatilesettings->frequency);
+	fprintf(stderr, "%s     sample_rate:                %f\n", first, volatilesettings->sample_rate);
+	fprintf(stderr, "%s     receiver_bandwidth:         %f\n", first, volatilesettings->receiver_bandwidth);
+	fprintf(stderr, "%s     pulse_width:                %f\n", first, volatilesettings->pulse_width);
+	fprintf(stderr, "%s     pulse_type:                 %d\n", first, volatilesettings->pulse_type);
+	fprintf(stderr, "%s     pulse_envelope:             %d\n", first, volatilesettings->pulse_envelope);
+	fprintf(stderr, "%s     pulse_envelope_par:         %f\n", first, volatilesettings->pulse_envelope_par);
+	fprintf(stderr, "%s     pulse_reserved:             %d\n", first, volatilesettings->pulse_reserved);
+	fprintf(stderr, "%s     max_ping_rate:              %f\n", first, volatilesettings->max_ping_rate);
+	fprintf(stderr, "%s     ping_period:                %f\n", first, volatilesettings->ping_period);
+	fprintf(stderr, "%s     range_selection:            %f\n", first, volatilesettings->range_selection);
+	fprintf(stderr, "%s     power_selection:            %f\n", first, volatilesettings->power_selection);
+	fprintf(stderr, "%s     gain_selection:             %f\n", first, volatilesettings->gain_selection);
+	fprintf(stderr, "%s     control_flags:              %d\n", first, volatilesettings->control_flags);
+	fprintf(stderr, "%s     projector_magic_no:         %d\n", first, volatilesettings->projector_magic_no);
+	fprintf(stderr, "%s     steering_vertical:          %f\n", first, volatilesettings->steering_vertical);
+	fprintf(stderr, "%s     steering_horizontal:        %f\n", first, volatilesettings->steering_horizontal);
+	fprintf(stderr, "%s     beamwidth_vertical:         %f\n", first, volatilesettings->beamwidth_vertical);
+	fprintf(stderr, "%s     beamwidth_horizontal:       %f\n", first, volatilesettings->beamwidth_horizontal);
+	fprintf(stderr, "%s     focal_point:                %f\n", first, volatilesettings->focal_point);
+	fprintf(stderr, "%s     projector_weighting:        %d\n", first, volatilesettings->projector_weighting);
+	fprintf(stderr, "%s     projector_weighting_par:    %f\n", first, volatilesettings->projector_weighting_par);
+	fprintf(stderr, "%s     transmit_flags:             %d\n", first, volatilesettings->transmit_flags);
+	fprintf(stderr, "%s     hydrophone_magic_no:        %d\n", first, volatilesettings->hydrophone_magic_no);
+	fprintf(stderr, "%s     receive_weighting:          %d\n", first, volatilesettings->receive_weighting);
+	fprintf(stderr, "%s     receive_weighting_par:      %f\n", first, volatilesettings->receive_weighting_par);
+	fprintf(stderr, "%s     receive_flags:              %d\n", first, volatilesettings->receive_flags);
+	fprintf(stderr, "%s     receive_width:              %f\n", first, volatilesettings->receive_width);
+	fprintf(stderr, "%s     range_minimum:              %f\n", first, volatilesettings->range_minimum);
+	fprintf(stderr, "%s     range_maximum:              %f\n", first, volatilesettings->range_maximum);
+	fprintf(stderr, "%s     depth_minimum:              %f\n", first, volatilesettings->depth_minimum);
+	fprintf(stderr, "%s     depth_maximum:              %f\n", first, volatilesettings->depth_maximum);
+	fprintf(stderr, "%s     absorption:                 %f\n", first, volatilesettings->absorption);
+	fprintf(stderr, "%s     sound_velocity:             %f\n", first, volatilesettings->sound_velocity);
+	fprintf(stderr, "%s     spreading:                  %f\n", first, volatilesettings->spreading);
+	fprintf(stderr, "%s     reserved:                   %d\n", first, volatilesettings->reserved);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -3209,13 +4374,12 @@ int mbsys_reson7k_print_calibration(int verbose, s7kr_calibration *calibration,
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_bathymetry(int verbose, s7kr_bathymetry *bathymetry, int *error) {
-	char *function_name = "mbsys_reson7k_print_bathymetry";
+int mbsys_reson7k_print_device(int verbose, s7k_device *device, int *error) {
+	char *function_name = "mbsys_reson7k_print_device";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
-	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -3223,13 +4387,10 @@ int mbsys_reson7k_print_bathymetry(int verbose, s7kr_bathymetry *bathymetry, int
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       bathymetry:        %p\n", (void *)bathymetry);
+		fprintf(stderr, "dbg2       device:            %p\n", (void *)device);
 	}
 
-	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &bathymetry->header, error);
-
-	/* print Reson 7k bathymetry (record 7006) */
+	/* print Reson 7k device configuration structure */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -3237,32 +4398,12 @@ int mbsys_reson7k_print_bathymetry(int verbose, s7kr_bathymetry *bathymetry, int
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     serial_number:              %llu\n", first, bathymetry->serial_number);
-	fprintf(stderr, "%s     ping_number:                %u\n", first, bathymetry->ping_number);
-	fprintf(stderr, "%s     multi_ping:                 %u\n", first, bathymetry->multi_ping);
-	fprintf(stderr, "%s     number_beams:               %u\n", first, bathymetry->number_beams);
-	fprintf(stderr, "%s     layer_comp_flag:            %d\n", first, bathymetry->layer_comp_flag);
-	fprintf(stderr, "%s     sound_vel_flag:             %d\n", first, bathymetry->sound_vel_flag);
-	fprintf(stderr, "%s     sound_velocity:             %f\n", first, bathymetry->sound_velocity);
-	for (i = 0; i < bathymetry->number_beams; i++)
-		fprintf(stderr, "%s     beam[%d]:  range:%f quality:%d intensity:%f min_depth_gate:%f min_depth_gate:%f\n", first, i,
-		        bathymetry->range[i], bathymetry->quality[i], bathymetry->intensity[i], bathymetry->min_depth_gate[i],
-		        bathymetry->max_depth_gate[i]);
-	fprintf(stderr, "%s     optionaldata:               %d\n", first, bathymetry->optionaldata);
-	fprintf(stderr, "%s     frequency:                  %f\n", first, bathymetry->frequency);
-	fprintf(stderr, "%s     latitude:                   %f\n", first, bathymetry->latitude);
-	fprintf(stderr, "%s     longitude:                  %f\n", first, bathymetry->longitude);
-	fprintf(stderr, "%s     heading:                    %f\n", first, bathymetry->heading);
-	fprintf(stderr, "%s     height_source:              %d\n", first, bathymetry->height_source);
-	fprintf(stderr, "%s     tide:                       %f\n", first, bathymetry->tide);
-	fprintf(stderr, "%s     roll:                       %f\n", first, bathymetry->roll);
-	fprintf(stderr, "%s     pitch:                      %f\n", first, bathymetry->pitch);
-	fprintf(stderr, "%s     heave:                      %f\n", first, bathymetry->heave);
-	fprintf(stderr, "%s     vehicle_height:             %f\n", first, bathymetry->vehicle_height);
-	for (i = 0; i < bathymetry->number_beams; i++)
-		fprintf(stderr, "%s     beam[%d]:  depth:%f ltrack:%f xtrack:%f angles: %f %f\n", first, i, bathymetry->depth[i],
-		        bathymetry->alongtrack[i], bathymetry->acrosstrack[i], bathymetry->pointing_angle[i],
-		        bathymetry->azimuth_angle[i]);
+	fprintf(stderr, "%s     magic_number:               %d\n", first, device->magic_number);
+	fprintf(stderr, "%s     description:                %s\n", first, device->description);
+	fprintf(stderr, "%s     serial_number:              %llu\n", first, device->serial_number);
+	fprintf(stderr, "%s     info_length:                %d\n", first, device->info_length);
+	fprintf(stderr, "%s     info_alloc:                 %d\n", first, device->info_alloc);
+	fprintf(stderr, "%s     info:                       %s\n", first, device->info);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -3277,15 +4418,12 @@ int mbsys_reson7k_print_bathymetry(int verbose, s7kr_bathymetry *bathymetry, int
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_backscatter(int verbose, s7kr_backscatter *backscatter, int *error) {
-	char *function_name = "mbsys_reson7k_print_backscatter";
+int mbsys_reson7k_print_configuration(int verbose, s7kr_configuration *configuration, int *error) {
+	char *function_name = "mbsys_reson7k_print_configuration";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
-	mb_s_char *charptr;
-	short *shortptr;
-	int *intptr;
 	int i;
 
 	/* print input debug statements */
@@ -3294,13 +4432,13 @@ int mbsys_reson7k_print_backscatter(int verbose, s7kr_backscatter *backscatter,
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       backscatter:       %p\n", (void *)backscatter);
+		fprintf(stderr, "dbg2       configuration:     %p\n", (void *)configuration);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &backscatter->header, error);
+	mbsys_reson7k_print_header(verbose, &configuration->header, error);
 
-	/* print Reson 7k backscatter imagery data (record 7007) */
+	/* print Reson 7k configuration (record 7001) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -3308,55 +4446,10 @@ int mbsys_reson7k_print_backscatter(int verbose, s7kr_backscatter *backscatter,
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     serial_number:              %llu\n", first, backscatter->serial_number);
-	fprintf(stderr, "%s     ping_number:                %u\n", first, backscatter->ping_number);
-	fprintf(stderr, "%s     multi_ping:                 %u\n", first, backscatter->multi_ping);
-	fprintf(stderr, "%s     beam_position:              %f\n", first, backscatter->beam_position);
-	fprintf(stderr, "%s     control_flags:              %d\n", first, backscatter->control_flags);
-	fprintf(stderr, "%s     number_samples:             %d\n", first, backscatter->number_samples);
-	fprintf(stderr, "%s     port_beamwidth_x:           %f\n", first, backscatter->port_beamwidth_x);
-	fprintf(stderr, "%s     port_beamwidth_y:           %f\n", first, backscatter->port_beamwidth_y);
-	fprintf(stderr, "%s     stbd_beamwidth_x:           %f\n", first, backscatter->stbd_beamwidth_x);
-	fprintf(stderr, "%s     stbd_beamwidth_y:           %f\n", first, backscatter->stbd_beamwidth_y);
-	fprintf(stderr, "%s     port_steering_x:            %f\n", first, backscatter->port_steering_x);
-	fprintf(stderr, "%s     port_steering_y:            %f\n", first, backscatter->port_steering_y);
-	fprintf(stderr, "%s     stbd_steering_x:            %f\n", first, backscatter->stbd_steering_x);
-	fprintf(stderr, "%s     stbd_steering_y:            %f\n", first, backscatter->stbd_steering_y);
-	fprintf(stderr, "%s     number_beams:               %u\n", first, backscatter->number_beams);
-	fprintf(stderr, "%s     current_beam:               %d\n", first, backscatter->current_beam);
-	fprintf(stderr, "%s     sample_size:                %d\n", first, backscatter->sample_size);
-	fprintf(stderr, "%s     data_type:                  %d\n", first, backscatter->data_type);
-	fprintf(stderr, "%s     nalloc:                     %d\n", first, backscatter->nalloc);
-	if (backscatter->sample_size == 1) {
-		charptr = (mb_s_char *)backscatter->port_data;
-		for (i = 0; i < backscatter->number_samples; i++)
-			fprintf(stderr, "%s     port backscatter[%d]:  %d\n", first, i, charptr[i]);
-		charptr = (mb_s_char *)backscatter->stbd_data;
-		for (i = 0; i < backscatter->number_samples; i++)
-			fprintf(stderr, "%s     stbd backscatter[%d]:  %d\n", first, i, charptr[i]);
-	}
-	else if (backscatter->sample_size == 2) {
-		shortptr = (short *)backscatter->port_data;
-		for (i = 0; i < backscatter->number_samples; i++)
-			fprintf(stderr, "%s     port backscatter[%d]:  %d\n", first, i, shortptr[i]);
-		shortptr = (short *)backscatter->stbd_data;
-		for (i = 0; i < backscatter->number_samples; i++)
-			fprintf(stderr, "%s     stbd backscatter[%d]:  %d\n", first, i, shortptr[i]);
-	}
-	else if (backscatter->sample_size == 4) {
-		intptr = (int *)backscatter->port_data;
-		for (i = 0; i < backscatter->number_samples; i++)
-			fprintf(stderr, "%s     port backscatter[%d]:  %d\n", first, i, intptr[i]);
-		intptr = (int *)backscatter->stbd_data;
-		for (i = 0; i < backscatter->number_samples; i++)
-			fprintf(stderr, "%s     stbd backscatter[%d]:  %d\n", first, i, intptr[i]);
-	}
-	fprintf(stderr, "%s     optionaldata:               %d\n", first, backscatter->optionaldata);
-	fprintf(stderr, "%s     frequency:                  %f\n", first, backscatter->frequency);
-	fprintf(stderr, "%s     latitude:                   %f\n", first, backscatter->latitude);
-	fprintf(stderr, "%s     longitude:                  %f\n", first, backscatter->longitude);
-	fprintf(stderr, "%s     heading:                    %f\n", first, backscatter->heading);
-	fprintf(stderr, "%s     altitude:                   %f\n", first, backscatter->altitude);
+	fprintf(stderr, "%s     serial_number:              %llu\n", first, configuration->serial_number);
+	fprintf(stderr, "%s     number_devices:             %d\n", first, configuration->number_devices);
+	for (i = 0; i < configuration->number_devices; i++)
+		mbsys_reson7k_print_device(verbose, &configuration->device[i], error);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -3371,23 +4464,12 @@ int mbsys_reson7k_print_backscatter(int verbose, s7kr_backscatter *backscatter,
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_beam(int verbose, s7kr_beam *beam, int *error) {
-	char *function_name = "mbsys_reson7k_print_beam";
+int mbsys_reson7k_print_matchfilter(int verbose, s7kr_matchfilter *matchfilter, int *error) {
+	char *function_name = "mbsys_reson7k_print_matchfilter";
 	int status = MB_SUCCESS;
-	s7kr_snippet *snippet;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
-	int sample_type_amp;
-	int sample_type_phase;
-	int sample_type_iandq;
-	int sample_type_beamforming;
-	mb_u_char *ucharptramp, *ucharptrphase;
-	unsigned short *ushortptramp, *ushortptrphase;
-	unsigned int *uintptramp, *uintptrphase;
-	short *shortptramp, *shortptrphase;
-	int *intptramp, *intptrphase;
-	int i, j;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -3395,13 +4477,13 @@ int mbsys_reson7k_print_beam(int verbose, s7kr_beam *beam, int *error) {
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       beam:              %p\n", (void *)beam);
+		fprintf(stderr, "dbg2       matchfilter:       %p\n", (void *)matchfilter);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &beam->header, error);
+	mbsys_reson7k_print_header(verbose, &matchfilter->header, error);
 
-	/* print Reson 7k beam data (record 7007) */
+	/* print Reson 7k match filter (record 7002) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -3409,59 +4491,11 @@ int mbsys_reson7k_print_beam(int verbose, s7kr_beam *beam, int *error) {
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     serial_number:              %llu\n", first, beam->serial_number);
-	fprintf(stderr, "%s     ping_number:                %u\n", first, beam->ping_number);
-	fprintf(stderr, "%s     multi_ping:                 %u\n", first, beam->multi_ping);
-	fprintf(stderr, "%s     number_beams:               %u\n", first, beam->number_beams);
-	fprintf(stderr, "%s     reserved:                   %d\n", first, beam->reserved);
-	fprintf(stderr, "%s     number_samples:             %d\n", first, beam->number_samples);
-	fprintf(stderr, "%s     record_subset_flag:         %d\n", first, beam->record_subset_flag);
-	fprintf(stderr, "%s     row_column_flag:            %d\n", first, beam->row_column_flag);
-	fprintf(stderr, "%s     sample_header_id:           %d\n", first, beam->sample_header_id);
-	fprintf(stderr, "%s     sample_type:                %d\n", first, beam->sample_type);
-	sample_type_amp = beam->sample_type & 15;
-	sample_type_phase = (beam->sample_type >> 4) & 15;
-	sample_type_iandq = (beam->sample_type >> 8) & 15;
-	sample_type_beamforming = (beam->sample_type >> 12) & 15;
-	fprintf(stderr, "%s     sample_type amplitude:      %d\n", first, sample_type_amp);
-	fprintf(stderr, "%s     sample_type phase:          %d\n", first, sample_type_phase);
-	fprintf(stderr, "%s     sample_type I and Q:        %d\n", first, sample_type_iandq);
-	fprintf(stderr, "%s     sample_type beamforming:    %d\n", first, sample_type_beamforming);
-	for (i = 0; i < beam->number_beams; i++) {
-		snippet = &beam->snippets[i];
-		fprintf(stderr, "%s     beam[%d]:%d   begin_sample:%d end_sample:%d nalloc_amp:%d nalloc_phase:%d\n", first, i,
-		        snippet->beam_number, snippet->begin_sample, snippet->end_sample, snippet->nalloc_amp, snippet->nalloc_phase);
-		ucharptramp = (mb_u_char *)snippet->amplitude;
-		ucharptrphase = (mb_u_char *)snippet->phase;
-		ushortptramp = (unsigned short *)snippet->amplitude;
-		ushortptrphase = (unsigned short *)snippet->phase;
-		uintptramp = (unsigned int *)snippet->amplitude;
-		uintptrphase = (unsigned int *)snippet->phase;
-		shortptramp = (short *)snippet->amplitude;
-		shortptrphase = (short *)snippet->phase;
-		intptramp = (int *)snippet->amplitude;
-		intptrphase = (int *)snippet->phase;
-		for (j = 0; j <= snippet->end_sample - snippet->begin_sample; j++) {
-			fprintf(stderr, "%s     sample[%d]:%d", first, j, snippet->begin_sample + j);
-			if (sample_type_amp == 1)
-				fprintf(stderr, "   amplitude:%d", ucharptramp[j]);
-			else if (sample_type_amp == 2)
-				fprintf(stderr, "   amplitude:%d", ushortptramp[j]);
-			else if (sample_type_amp == 3)
-				fprintf(stderr, "   amplitude:%d", uintptramp[j]);
-			if (sample_type_phase == 1)
-				fprintf(stderr, "   phase:%d", ucharptrphase[j]);
-			else if (sample_type_phase == 2)
-				fprintf(stderr, "   phase:%d", ushortptrphase[j]);
-			else if (sample_type_phase == 3)
-				fprintf(stderr, "   phase:%d", uintptrphase[j]);
-			if (sample_type_iandq == 1)
-				fprintf(stderr, "   amplitude:%d   phase:%d", shortptramp[j], shortptrphase[j]);
-			else if (sample_type_iandq == 2)
-				fprintf(stderr, "   amplitude:%d   phase:%d", intptramp[j], intptrphase[j]);
-			fprintf(stderr, "\n");
-		}
-	}
+	fprintf(stderr, "%s     serial_number:              %llu\n", first, matchfilter->serial_number);
+	fprintf(stderr, "%s     ping_number:                %u\n", first, matchfilter->ping_number);
+	fprintf(stderr, "%s     operation:                  %d\n", first, matchfilter->operation);
+	fprintf(stderr, "%s     start_frequency:            %f\n", first, matchfilter->start_frequency);
+	fprintf(stderr, "%s     end_frequency:              %f\n", first, matchfilter->end_frequency);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -3476,8 +4510,10 @@ int mbsys_reson7k_print_beam(int verbose, s7kr_beam *beam, int *error) {
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_verticaldepth(int verbose, s7kr_verticaldepth *verticaldepth, int *error) {
-	char *function_name = "mbsys_reson7k_print_verticaldepth";
+int mbsys_reson7k_print_v2firmwarehardwareconfiguration(int verbose,
+                                                        s7kr_v2firmwarehardwareconfiguration *v2firmwarehardwareconfiguration,
+                                                        int *error) {
+	char *function_name = "mbsys_reson7k_print_v2firmwarehardwareconfiguration";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
@@ -3489,13 +4525,13 @@ int mbsys_reson7k_print_verticaldepth(int verbose, s7kr_verticaldepth *verticald
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       verticaldepth:     %p\n", (void *)verticaldepth);
+		fprintf(stderr, "dbg2       v2firmwarehardwareconfiguration:       %p\n", (void *)v2firmwarehardwareconfiguration);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &verticaldepth->header, error);
+	mbsys_reson7k_print_header(verbose, &v2firmwarehardwareconfiguration->header, error);
 
-	/* print Reson 7k vertical depth data (record 7009) */
+	/* print Reson 7k match filter (record 7002) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -3503,15 +4539,10 @@ int mbsys_reson7k_print_verticaldepth(int verbose, s7kr_verticaldepth *verticald
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     frequency:                  %f\n", first, verticaldepth->frequency);
-	fprintf(stderr, "%s     ping_number:                %u\n", first, verticaldepth->ping_number);
-	fprintf(stderr, "%s     multi_ping:                 %u\n", first, verticaldepth->multi_ping);
-	fprintf(stderr, "%s     latitude:                   %f\n", first, verticaldepth->latitude);
-	fprintf(stderr, "%s     longitude:                  %f\n", first, verticaldepth->longitude);
-	fprintf(stderr, "%s     heading:                    %f\n", first, verticaldepth->heading);
-	fprintf(stderr, "%s     alongtrack:                 %f\n", first, verticaldepth->alongtrack);
-	fprintf(stderr, "%s     acrosstrack:                %f\n", first, verticaldepth->acrosstrack);
-	fprintf(stderr, "%s     vertical_depth:             %f\n", first, verticaldepth->vertical_depth);
+	fprintf(stderr, "%s     device_count:               %d\n", first, v2firmwarehardwareconfiguration->device_count);
+	fprintf(stderr, "%s     info_length:                %d\n", first, v2firmwarehardwareconfiguration->info_length);
+	fprintf(stderr, "%s     info:                       \n", first);
+	fprintf(stderr, "%s\n%s\n", v2firmwarehardwareconfiguration->info, first);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -3526,13 +4557,12 @@ int mbsys_reson7k_print_verticaldepth(int verbose, s7kr_verticaldepth *verticald
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_tvg(int verbose, s7kr_tvg *tvg, int *error) {
-	char *function_name = "mbsys_reson7k_print_tvg";
+int mbsys_reson7k_print_beamgeometry(int verbose, s7kr_beamgeometry *beamgeometry, int *error) {
+	char *function_name = "mbsys_reson7k_print_beamgeometry";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
-	float *tvg_float;
 	int i;
 
 	/* print input debug statements */
@@ -3541,13 +4571,13 @@ int mbsys_reson7k_print_tvg(int verbose, s7kr_tvg *tvg, int *error) {
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       tvg:               %p\n", (void *)tvg);
+		fprintf(stderr, "dbg2       beamgeometry:      %p\n", (void *)beamgeometry);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &tvg->header, error);
+	mbsys_reson7k_print_header(verbose, &beamgeometry->header, error);
 
-	/* print Reson 7k tvg data (record 7010) */
+	/* print Reson 7k beam geometry (record 7004) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -3555,16 +4585,13 @@ int mbsys_reson7k_print_tvg(int verbose, s7kr_tvg *tvg, int *error) {
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     serial_number:              %llu\n", first, tvg->serial_number);
-	fprintf(stderr, "%s     ping_number:                %u\n", first, tvg->ping_number);
-	fprintf(stderr, "%s     multi_ping:                 %u\n", first, tvg->multi_ping);
-	fprintf(stderr, "%s     n:                          %d\n", first, tvg->n);
-	for (i = 0; i < 8; i++)
-		fprintf(stderr, "%s     reserved[%d]:                %d\n", first, i, tvg->reserved[i]);
-	for (i = 0; i < tvg->n; i++) {
-		tvg_float = (float *)tvg->tvg;
-		fprintf(stderr, "%s     tvg[%d]:  %f\n", first, i, tvg_float[i]);
-	}
+	fprintf(stderr, "%s     serial_number:              %llu\n", first, beamgeometry->serial_number);
+	fprintf(stderr, "%s     number_beams:               %u\n", first, beamgeometry->number_beams);
+	for (i = 0; i < beamgeometry->number_beams; i++)
+		fprintf(stderr,
+		        "%s     beam[%d]:  angle_alongtrack:%f angle_acrosstrack:%f beamwidth_alongtrack:%f beamwidth_acrosstrack:%f\n",
+		        first, i, beamgeometry->angle_alongtrack[i], beamgeometry->angle_acrosstrack[i],
+		        beamgeometry->beamwidth_alongtrack[i], beamgeometry->beamwidth_acrosstrack[i]);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -3579,15 +4606,12 @@ int mbsys_reson7k_print_tvg(int verbose, s7kr_tvg *tvg, int *error) {
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_image(int verbose, s7kr_image *image, int *error) {
-	char *function_name = "mbsys_reson7k_print_image";
+int mbsys_reson7k_print_calibration(int verbose, s7kr_calibration *calibration, int *error) {
+	char *function_name = "mbsys_reson7k_print_calibration";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
-	mb_s_char *charptr;
-	short *shortptr;
-	int *intptr;
 	int i;
 
 	/* print input debug statements */
@@ -3596,13 +4620,13 @@ int mbsys_reson7k_print_image(int verbose, s7kr_image *image, int *error) {
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       image:             %p\n", (void *)image);
+		fprintf(stderr, "dbg2       calibration:       %p\n", (void *)calibration);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &image->header, error);
+	mbsys_reson7k_print_header(verbose, &calibration->header, error);
 
-	/* print Reson 7k image imagery data (record 7007) */
+	/* print Reson 7k calibration data (record 7005) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -3610,29 +4634,10 @@ int mbsys_reson7k_print_image(int verbose, s7kr_image *image, int *error) {
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     ping_number:                %u\n", first, image->ping_number);
-	fprintf(stderr, "%s     multi_ping:                 %u\n", first, image->multi_ping);
-	fprintf(stderr, "%s     width:                      %d\n", first, image->width);
-	fprintf(stderr, "%s     height:                     %d\n", first, image->height);
-	fprintf(stderr, "%s     color_depth:                %d\n", first, image->color_depth);
-	fprintf(stderr, "%s     width_height_flag:          %d\n", first, image->width_height_flag);
-	fprintf(stderr, "%s     compression:                %d\n", first, image->compression);
-	fprintf(stderr, "%s     nalloc:                     %d\n", first, image->nalloc);
-	if (image->color_depth == 1) {
-		charptr = (mb_s_char *)image->image;
-		for (i = 0; i < image->width * image->height; i++)
-			fprintf(stderr, "%s     image[%d]:  %hhu\n", first, i, charptr[i]);
-	}
-	else if (image->color_depth == 2) {
-		shortptr = (short *)image->image;
-		for (i = 0; i < image->width * image->height; i++)
-			fprintf(stderr, "%s     image[%d]:  %hu\n", first, i, shortptr[i]);
-	}
-	else if (image->color_depth == 4) {
-		intptr = (int *)image->image;
-		for (i = 0; i < image->width * image->height; i++)
-			fprintf(stderr, "%s     image[%d]:  %u\n", first, i, intptr[i]);
-	}
+	fprintf(stderr, "%s     serial_number:              %llu\n", first, calibration->serial_number);
+	fprintf(stderr, "%s     number_channels:            %d\n", first, calibration->number_channels);
+	for (i = 0; i < calibration->number_channels; i++)
+		fprintf(stderr, "%s     channel[%d]:  gain:%f phase:%f\n", first, i, calibration->gain[i], calibration->phase[i]);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -3647,8 +4652,8 @@ int mbsys_reson7k_print_image(int verbose, s7kr_image *image, int *error) {
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_v2pingmotion(int verbose, s7kr_v2pingmotion *v2pingmotion, int *error) {
-	char *function_name = "mbsys_reson7k_print_v2pingmotion";
+int mbsys_reson7k_print_bathymetry(int verbose, s7kr_bathymetry *bathymetry, int *error) {
+	char *function_name = "mbsys_reson7k_print_bathymetry";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
@@ -3661,13 +4666,13 @@ int mbsys_reson7k_print_v2pingmotion(int verbose, s7kr_v2pingmotion *v2pingmotio
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       v2pingmotion:      %p\n", (void *)v2pingmotion);
+		fprintf(stderr, "dbg2       bathymetry:        %p\n", (void *)bathymetry);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &v2pingmotion->header, error);
+	mbsys_reson7k_print_header(verbose, &bathymetry->header, error);
 
-	/* print Reson 7k ping motion (record 7012) */
+	/* print Reson 7k bathymetry (record 7006) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -3675,21 +4680,32 @@ int mbsys_reson7k_print_v2pingmotion(int verbose, s7kr_v2pingmotion *v2pingmotio
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     serial_number:              %llu\n", first, v2pingmotion->serial_number);
-	fprintf(stderr, "%s     ping_number:                %u\n", first, v2pingmotion->ping_number);
-	fprintf(stderr, "%s     multi_ping:                 %u\n", first, v2pingmotion->multi_ping);
-	fprintf(stderr, "%s     n:                          %d\n", first, v2pingmotion->n);
-	fprintf(stderr, "%s     flags:                      %d\n", first, v2pingmotion->flags);
-	fprintf(stderr, "%s     error_flags:                %d\n", first, v2pingmotion->error_flags);
-	fprintf(stderr, "%s     frequency:                  %f\n", first, v2pingmotion->frequency);
-	fprintf(stderr, "%s     pitch:                      %f\n", first, v2pingmotion->pitch);
-	fprintf(stderr, "%s     nalloc:                     %d\n", first, v2pingmotion->nalloc);
-	fprintf(stderr, "%s     beam	roll    heading    heave\n", first);
-	fprintf(stderr, "%s     ----	----    -------    -----\n", first);
-	for (i = 0; i < v2pingmotion->n; i++) {
-		fprintf(stderr, "%s     %3d  %10g  %10g  %10g\n", first, i, v2pingmotion->roll[i], v2pingmotion->heading[i],
-		        v2pingmotion->heave[i]);
-	}
+	fprintf(stderr, "%s     serial_number:              %llu\n", first, bathymetry->serial_number);
+	fprintf(stderr, "%s     ping_number:                %u\n", first, bathymetry->ping_number);
+	fprintf(stderr, "%s     multi_ping:                 %u\n", first, bathymetry->multi_ping);
+	fprintf(stderr, "%s     number_beams:               %u\n", first, bathymetry->number_beams);
+	fprintf(stderr, "%s     layer_comp_flag:            %d\n", first, bathymetry->layer_comp_flag);
+	fprintf(stderr, "%s     sound_vel_flag:             %d\n", first, bathymetry->sound_vel_flag);
+	fprintf(stderr, "%s     sound_velocity:             %f\n", first, bathymetry->sound_velocity);
+	for (i = 0; i < bathymetry->number_beams; i++)
+		fprintf(stderr, "%s     beam[%d]:  range:%f quality:%d intensity:%f min_depth_gate:%f min_depth_gate:%f\n", first, i,
+		        bathymetry->range[i], bathymetry->quality[i], bathymetry->intensity[i], bathymetry->min_depth_gate[i],
+		        bathymetry->max_depth_gate[i]);
+	fprintf(stderr, "%s     optionaldata:               %d\n", first, bathymetry->optionaldata);
+	fprintf(stderr, "%s     frequency:                  %f\n", first, bathymetry->frequency);
+	fprintf(stderr, "%s     latitude:                   %f\n", first, bathymetry->latitude);
+	fprintf(stderr, "%s     longitude:                  %f\n", first, bathymetry->longitude);
+	fprintf(stderr, "%s     heading:                    %f\n", first, bathymetry->heading);
+	fprintf(stderr, "%s     height_source:              %d\n", first, bathymetry->height_source);
+	fprintf(stderr, "%s     tide:                       %f\n", first, bathymetry->tide);
+	fprintf(stderr, "%s     roll:                       %f\n", first, bathymetry->roll);
+	fprintf(stderr, "%s     pitch:                      %f\n", first, bathymetry->pitch);
+	fprintf(stderr, "%s     heave:                      %f\n", first, bathymetry->heave);
+	fprintf(stderr, "%s     vehicle_height:             %f\n", first, bathymetry->vehicle_height);
+	for (i = 0; i < bathymetry->number_beams; i++)
+		fprintf(stderr, "%s     beam[%d]:  depth:%f ltrack:%f xtrack:%f angles: %f %f\n", first, i, bathymetry->depth[i],
+		        bathymetry->alongtrack[i], bathymetry->acrosstrack[i], bathymetry->pointing_angle[i],
+		        bathymetry->azimuth_angle[i]);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -3704,12 +4720,15 @@ int mbsys_reson7k_print_v2pingmotion(int verbose, s7kr_v2pingmotion *v2pingmotio
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_v2detectionsetup(int verbose, s7kr_v2detectionsetup *v2detectionsetup, int *error) {
-	char *function_name = "mbsys_reson7k_print_v2detectionsetup";
+int mbsys_reson7k_print_backscatter(int verbose, s7kr_backscatter *backscatter, int *error) {
+	char *function_name = "mbsys_reson7k_print_backscatter";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
+	mb_s_char *charptr;
+	short *shortptr;
+	int *intptr;
 	int i;
 
 	/* print input debug statements */
@@ -3718,13 +4737,13 @@ int mbsys_reson7k_print_v2detectionsetup(int verbose, s7kr_v2detectionsetup *v2d
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       v2detectionsetup:  %p\n", (void *)v2detectionsetup);
+		fprintf(stderr, "dbg2       backscatter:       %p\n", (void *)backscatter);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &v2detectionsetup->header, error);
+	mbsys_reson7k_print_header(verbose, &backscatter->header, error);
 
-	/* print Reson 7k detection setup (record 7017) */
+	/* print Reson 7k backscatter imagery data (record 7007) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -3732,33 +4751,55 @@ int mbsys_reson7k_print_v2detectionsetup(int verbose, s7kr_v2detectionsetup *v2d
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     serial_number:              %llu\n", first, v2detectionsetup->serial_number);
-	fprintf(stderr, "%s     ping_number:                %u\n", first, v2detectionsetup->ping_number);
-	fprintf(stderr, "%s     multi_ping:                 %u\n", first, v2detectionsetup->multi_ping);
-	fprintf(stderr, "%s     number_beams:               %u\n", first, v2detectionsetup->number_beams);
-	fprintf(stderr, "%s     data_field_size:            %d\n", first, v2detectionsetup->data_field_size);
-	fprintf(stderr, "%s     detection_algorithm:        %d\n", first, v2detectionsetup->detection_algorithm);
-	fprintf(stderr, "%s     detection_flags:            %d\n", first, v2detectionsetup->detection_flags);
-	fprintf(stderr, "%s     minimum_depth:              %f\n", first, v2detectionsetup->minimum_depth);
-	fprintf(stderr, "%s     maximum_depth:              %f\n", first, v2detectionsetup->maximum_depth);
-	fprintf(stderr, "%s     minimum_range:              %f\n", first, v2detectionsetup->minimum_range);
-	fprintf(stderr, "%s     maximum_range:              %f\n", first, v2detectionsetup->maximum_range);
-	fprintf(stderr, "%s     minimum_nadir_search:       %f\n", first, v2detectionsetup->minimum_nadir_search);
-	fprintf(stderr, "%s     maximum_nadir_search:       %f\n", first, v2detectionsetup->maximum_nadir_search);
-	fprintf(stderr, "%s     automatic_filter_window:    %u\n", first, v2detectionsetup->automatic_filter_window);
-	fprintf(stderr, "%s     applied_roll:               %f\n", first, v2detectionsetup->applied_roll);
-	fprintf(stderr, "%s     depth_gate_tilt:            %f\n", first, v2detectionsetup->depth_gate_tilt);
-	for (i = 0; i < 14; i++) {
-		fprintf(stderr, "%s     reserved[%2d]:               %f\n", first, i, v2detectionsetup->reserved[i]);
+	fprintf(stderr, "%s     serial_number:              %llu\n", first, backscatter->serial_number);
+	fprintf(stderr, "%s     ping_number:                %u\n", first, backscatter->ping_number);
+	fprintf(stderr, "%s     multi_ping:                 %u\n", first, backscatter->multi_ping);
+	fprintf(stderr, "%s     beam_position:              %f\n", first, backscatter->beam_position);
+	fprintf(stderr, "%s     control_flags:              %d\n", first, backscatter->control_flags);
+	fprintf(stderr, "%s     number_samples:             %d\n", first, backscatter->number_samples);
+	fprintf(stderr, "%s     port_beamwidth_x:           %f\n", first, backscatter->port_beamwidth_x);
+	fprintf(stderr, "%s     port_beamwidth_y:           %f\n", first, backscatter->port_beamwidth_y);
+	fprintf(stderr, "%s     stbd_beamwidth_x:           %f\n", first, backscatter->stbd_beamwidth_x);
+	fprintf(stderr, "%s     stbd_beamwidth_y:           %f\n", first, backscatter->stbd_beamwidth_y);
+	fprintf(stderr, "%s     port_steering_x:            %f\n", first, backscatter->port_steering_x);
+	fprintf(stderr, "%s     port_steering_y:            %f\n", first, backscatter->port_steering_y);
+	fprintf(stderr, "%s     stbd_steering_x:            %f\n", first, backscatter->stbd_steering_x);
+	fprintf(stderr, "%s     stbd_steering_y:            %f\n", first, backscatter->stbd_steering_y);
+	fprintf(stderr, "%s     number_beams:               %u\n", first, backscatter->number_beams);
+	fprintf(stderr, "%s     current_beam:               %d\n", first, backscatter->current_beam);
+	fprintf(stderr, "%s     sample_size:                %d\n", first, backscatter->sample_size);
+	fprintf(stderr, "%s     data_type:                  %d\n", first, backscatter->data_type);
+	fprintf(stderr, "%s     nalloc:                     %d\n", first, backscatter->nalloc);
+	if (backscatter->sample_size == 1) {
+		charptr = (mb_s_char *)backscatter->port_data;
+		for (i = 0; i < backscatter->number_samples; i++)
+			fprintf(stderr, "%s     port backscatter[%d]:  %d\n", first, i, charptr[i]);
+		charptr = (mb_s_char *)backscatter->stbd_data;
+		for (i = 0; i < backscatter->number_samples; i++)
+			fprintf(stderr, "%s     stbd backscatter[%d]:  %d\n", first, i, charptr[i]);
 	}
-	fprintf(stderr, "%s     beam	descriptor pick flag amin amax umin umax quality uncertainty\n", first);
-	fprintf(stderr, "%s     ---------------------------------------------------------\n", first);
-	for (i = 0; i < v2detectionsetup->number_beams; i++) {
-		fprintf(stderr, "%s     %3d %u %10.3f %u %u %u %u %u %u %f\n", first, i, v2detectionsetup->beam_descriptor[i],
-		        v2detectionsetup->detection_point[i], v2detectionsetup->flags[i], v2detectionsetup->auto_limits_min_sample[i],
-		        v2detectionsetup->auto_limits_max_sample[i], v2detectionsetup->user_limits_min_sample[i],
-		        v2detectionsetup->user_limits_max_sample[i], v2detectionsetup->quality[i], v2detectionsetup->uncertainty[i]);
+	else if (backscatter->sample_size == 2) {
+		shortptr = (short *)backscatter->port_data;
+		for (i = 0; i < backscatter->number_samples; i++)
+			fprintf(stderr, "%s     port backscatter[%d]:  %d\n", first, i, shortptr[i]);
+		shortptr = (short *)backscatter->stbd_data;
+		for (i = 0; i < backscatter->number_samples; i++)
+			fprintf(stderr, "%s     stbd backscatter[%d]:  %d\n", first, i, shortptr[i]);
+	}
+	else if (backscatter->sample_size == 4) {
+		intptr = (int *)backscatter->port_data;
+		for (i = 0; i < backscatter->number_samples; i++)
+			fprintf(stderr, "%s     port backscatter[%d]:  %d\n", first, i, intptr[i]);
+		intptr = (int *)backscatter->stbd_data;
+		for (i = 0; i < backscatter->number_samples; i++)
+			fprintf(stderr, "%s     stbd backscatter[%d]:  %d\n", first, i, intptr[i]);
 	}
+	fprintf(stderr, "%s     optionaldata:               %d\n", first, backscatter->optionaldata);
+	fprintf(stderr, "%s     frequency:                  %f\n", first, backscatter->frequency);
+	fprintf(stderr, "%s     latitude:                   %f\n", first, backscatter->latitude);
+	fprintf(stderr, "%s     longitude:                  %f\n", first, backscatter->longitude);
+	fprintf(stderr, "%s     heading:                    %f\n", first, backscatter->heading);
+	fprintf(stderr, "%s     altitude:                   %f\n", first, backscatter->altitude);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -3773,13 +4814,22 @@ int mbsys_reson7k_print_v2detectionsetup(int verbose, s7kr_v2detectionsetup *v2d
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_v2beamformed(int verbose, s7kr_v2beamformed *v2beamformed, int *error) {
-	char *function_name = "mbsys_reson7k_print_v2beamformed";
+int mbsys_reson7k_print_beam(int verbose, s7kr_beam *beam, int *error) {
+	char *function_name = "mbsys_reson7k_print_beam";
 	int status = MB_SUCCESS;
-	s7kr_v2amplitudephase *v2amplitudephase;
+	s7kr_snippet *snippet;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
+	int sample_type_amp;
+	int sample_type_phase;
+	int sample_type_iandq;
+	int sample_type_beamforming;
+	mb_u_char *ucharptramp, *ucharptrphase;
+	unsigned short *ushortptramp, *ushortptrphase;
+	unsigned int *uintptramp, *uintptrphase;
+	short *shortptramp, *shortptrphase;
+	int *intptramp, *intptrphase;
 	int i, j;
 
 	/* print input debug statements */
@@ -3788,13 +4838,13 @@ int mbsys_reson7k_print_v2beamformed(int verbose, s7kr_v2beamformed *v2beamforme
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       v2beamformed:      %p\n", (void *)v2beamformed);
+		fprintf(stderr, "dbg2       beam:              %p\n", (void *)beam);
 	}
 
-	/* Reson 7k beamformed magnitude and phase data (record 7018) */
-	mbsys_reson7k_print_header(verbose, &v2beamformed->header, error);
+	/* print Reson 7k data record header information */
+	mbsys_reson7k_print_header(verbose, &beam->header, error);
 
-	/* print Reson 7k detection setup (record 7017) */
+	/* print Reson 7k beam data (record 7007) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -3802,22 +4852,57 @@ int mbsys_reson7k_print_v2beamformed(int verbose, s7kr_v2beamformed *v2beamforme
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     serial_number:              %llu\n", first, v2beamformed->serial_number);
-	fprintf(stderr, "%s     ping_number:                %u\n", first, v2beamformed->ping_number);
-	fprintf(stderr, "%s     multi_ping:                 %u\n", first, v2beamformed->multi_ping);
-	fprintf(stderr, "%s     number_beams:               %u\n", first, v2beamformed->number_beams);
-	fprintf(stderr, "%s     number_samples:             %d\n", first, v2beamformed->number_samples);
-	fprintf(stderr, "%s     reserved:                   ", first);
-	for (i = 0; i < 32; i++)
-		fprintf(stderr, "%u ", v2beamformed->reserved[i]);
-	fprintf(stderr, "\n");
-	for (i = 0; i < v2beamformed->number_beams; i++) {
-		v2amplitudephase = &(v2beamformed->amplitudephase[i]);
-		fprintf(stderr, "%s     beam_number:                %d\n", first, v2amplitudephase->beam_number);
-		fprintf(stderr, "%s     number_samples:             %d\n", first, v2amplitudephase->number_samples);
-		for (j = 0; j < v2amplitudephase->number_samples; j++) {
-			fprintf(stderr, "%s     beam[%d] sample[%d] amplitude:%u phase:%d\n", first, i, j, v2amplitudephase->amplitude[j],
-			        v2amplitudephase->phase[j]);
+	fprintf(stderr, "%s     serial_number:              %llu\n", first, beam->serial_number);
+	fprintf(stderr, "%s     ping_number:                %u\n", first, beam->ping_number);
+	fprintf(stderr, "%s     multi_ping:                 %u\n", first, beam->multi_ping);
+	fprintf(stderr, "%s     number_beams:               %u\n", first, beam->number_beams);
+	fprintf(stderr, "%s     reserved:                   %d\n", first, beam->reserved);
+	fprintf(stderr, "%s     number_samples:             %d\n", first, beam->number_samples);
+	fprintf(stderr, "%s     record_subset_flag:         %d\n", first, beam->record_subset_flag);
+	fprintf(stderr, "%s     row_column_flag:            %d\n", first, beam->row_column_flag);
+	fprintf(stderr, "%s     sample_header_id:           %d\n", first, beam->sample_header_id);
+	fprintf(stderr, "%s     sample_type:                %d\n", first, beam->sample_type);
+	sample_type_amp = beam->sample_type & 15;
+	sample_type_phase = (beam->sample_type >> 4) & 15;
+	sample_type_iandq = (beam->sample_type >> 8) & 15;
+	sample_type_beamforming = (beam->sample_type >> 12) & 15;
+	fprintf(stderr, "%s     sample_type amplitude:      %d\n", first, sample_type_amp);
+	fprintf(stderr, "%s     sample_type phase:          %d\n", first, sample_type_phase);
+	fprintf(stderr, "%s     sample_type I and Q:        %d\n", first, sample_type_iandq);
+	fprintf(stderr, "%s     sample_type beamforming:    %d\n", first, sample_type_beamforming);
+	for (i = 0; i < beam->number_beams; i++) {
+		snippet = &beam->snippets[i];
+		fprintf(stderr, "%s     beam[%d]:%d   begin_sample:%d end_sample:%d nalloc_amp:%d nalloc_phase:%d\n", first, i,
+		        snippet->beam_number, snippet->begin_sample, snippet->end_sample, snippet->nalloc_amp, snippet->nalloc_phase);
+		ucharptramp = (mb_u_char *)snippet->amplitude;
+		ucharptrphase = (mb_u_char *)snippet->phase;
+		ushortptramp = (unsigned short *)snippet->amplitude;
+		ushortptrphase = (unsigned short *)snippet->phase;
+		uintptramp = (unsigned int *)snippet->amplitude;
+		uintptrphase = (unsigned int *)snippet->phase;
+		shortptramp = (short *)snippet->amplitude;
+		shortptrphase = (short *)snippet->phase;
+		intptramp = (int *)snippet->amplitude;
+		intptrphase = (int *)snippet->phase;
+		for (j = 0; j <= snippet->end_sample - snippet->begin_sample; j++) {
+			fprintf(stderr, "%s     sample[%d]:%d", first, j, snippet->begin_sample + j);
+			if (sample_type_amp == 1)
+				fprintf(stderr, "   amplitude:%d", ucharptramp[j]);
+			else if (sample_type_amp == 2)
+				fprintf(stderr, "   amplitude:%d", ushortptramp[j]);
+			else if (sample_type_amp == 3)
+				fprintf(stderr, "   amplitude:%d", uintptramp[j]);
+			if (sample_type_phase == 1)
+				fprintf(stderr, "   phase:%d", ucharptrphase[j]);
+			else if (sample_type_phase == 2)
+				fprintf(stderr, "   phase:%d", ushortptrphase[j]);
+			else if (sample_type_phase == 3)
+				fprintf(stderr, "   phase:%d", uintptrphase[j]);
+			if (sample_type_iandq == 1)
+				fprintf(stderr, "   amplitude:%d   phase:%d", shortptramp[j], shortptrphase[j]);
+			else if (sample_type_iandq == 2)
+				fprintf(stderr, "   amplitude:%d   phase:%d", intptramp[j], intptrphase[j]);
+			fprintf(stderr, "\n");
 		}
 	}
 
@@ -3834,16 +4919,12 @@ int mbsys_reson7k_print_v2beamformed(int verbose, s7kr_v2beamformed *v2beamforme
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_v2bite(int verbose, s7kr_v2bite *v2bite, int *error) {
-	char *function_name = "mbsys_reson7k_print_v2bite";
+int mbsys_reson7k_print_verticaldepth(int verbose, s7kr_verticaldepth *verticaldepth, int *error) {
+	char *function_name = "mbsys_reson7k_print_verticaldepth";
 	int status = MB_SUCCESS;
-	s7kr_v2bitereport *v2bitereport;
-	s7kr_v2bitefield *v2bitefield;
-	s7k_time *s7ktime;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
-	int i, j;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -3851,13 +4932,13 @@ int mbsys_reson7k_print_v2bite(int verbose, s7kr_v2bite *v2bite, int *error) {
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       v2bite:      %p\n", (void *)v2bite);
+		fprintf(stderr, "dbg2       verticaldepth:     %p\n", (void *)verticaldepth);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &v2bite->header, error);
+	mbsys_reson7k_print_header(verbose, &verticaldepth->header, error);
 
-	/* Reson 7k BITE (record 7021) */
+	/* print Reson 7k vertical depth data (record 7009) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -3865,38 +4946,15 @@ int mbsys_reson7k_print_v2bite(int verbose, s7kr_v2bite *v2bite, int *error) {
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     number_reports:             %u\n", first, v2bite->number_reports);
-	for (i = 0; i < v2bite->number_reports; i++) {
-		v2bitereport = &(v2bite->reports[i]);
-		fprintf(stderr, "%s     source_name:                %s\n", first, v2bitereport->source_name);
-		fprintf(stderr, "%s     source_address:             %u\n", first, v2bitereport->source_address);
-		fprintf(stderr, "%s     frequency:                  %f\n", first, v2bitereport->frequency);
-		fprintf(stderr, "%s     enumerator:                 %u\n", first, v2bitereport->enumerator);
-		s7ktime = &(v2bitereport->downlink_time);
-		fprintf(stderr, "%s     downlink_time:              %4.4d/%3.3d %2.2d:%2.2d:%9.6f\n", first, s7ktime->Year, s7ktime->Day,
-		        s7ktime->Hours, s7ktime->Minutes, s7ktime->Seconds);
-		s7ktime = &(v2bitereport->uplink_time);
-		fprintf(stderr, "%s     uplink_time:                %4.4d/%3.3d %2.2d:%2.2d:%9.6f\n", first, s7ktime->Year, s7ktime->Day,
-		        s7ktime->Hours, s7ktime->Minutes, s7ktime->Seconds);
-		s7ktime = &(v2bitereport->bite_time);
-		fprintf(stderr, "%s     bite_time:                  %4.4d/%3.3d %2.2d:%2.2d:%9.6f\n", first, s7ktime->Year, s7ktime->Day,
-		        s7ktime->Hours, s7ktime->Minutes, s7ktime->Seconds);
-		fprintf(stderr, "%s     status:                     %u\n", first, v2bitereport->status);
-		fprintf(stderr, "%s     number_bite:                %u\n", first, v2bitereport->number_bite);
-		fprintf(stderr, "%s     bite_status:                ", first);
-		for (j = 0; j < 32; j++)
-			fprintf(stderr, "%u ", v2bitereport->bite_status[j]);
-		fprintf(stderr, "\n");
-		for (j = 0; j < v2bitereport->number_bite; j++) {
-			v2bitefield = &(v2bitereport->bitefield[j]);
-			fprintf(stderr, "%s     reserved[%2d]:               %u\n", first, j, v2bitefield->reserved);
-			fprintf(stderr, "%s     name[%2d]:                   %s\n", first, j, v2bitefield->name);
-			fprintf(stderr, "%s     device_type[%2d]:            %d\n", first, j, v2bitefield->device_type);
-			fprintf(stderr, "%s     minimum[%2d]:                %f\n", first, j, v2bitefield->minimum);
-			fprintf(stderr, "%s     maximum[%2d]:                %f\n", first, j, v2bitefield->maximum);
-			fprintf(stderr, "%s     value[%2d]:                  %f\n", first, j, v2bitefield->value);
-		}
-	}
+	fprintf(stderr, "%s     frequency:                  %f\n", first, verticaldepth->frequency);
+	fprintf(stderr, "%s     ping_number:                %u\n", first, verticaldepth->ping_number);
+	fprintf(stderr, "%s     multi_ping:                 %u\n", first, verticaldepth->multi_ping);
+	fprintf(stderr, "%s     latitude:                   %f\n", first, verticaldepth->latitude);
+	fprintf(stderr, "%s     longitude:                  %f\n", first, verticaldepth->longitude);
+	fprintf(stderr, "%s     heading:                    %f\n", first, verticaldepth->heading);
+	fprintf(stderr, "%s     alongtrack:                 %f\n", first, verticaldepth->alongtrack);
+	fprintf(stderr, "%s     acrosstrack:                %f\n", first, verticaldepth->acrosstrack);
+	fprintf(stderr, "%s     vertical_depth:             %f\n", first, verticaldepth->vertical_depth);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -3911,12 +4969,14 @@ int mbsys_reson7k_print_v2bite(int verbose, s7kr_v2bite *v2bite, int *error) {
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_v27kcenterversion(int verbose, s7kr_v27kcenterversion *v27kcenterversion, int *error) {
-	char *function_name = "mbsys_reson7k_print_v27kcenterversion";
+int mbsys_reson7k_print_tvg(int verbose, s7kr_tvg *tvg, int *error) {
+	char *function_name = "mbsys_reson7k_print_tvg";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
+	float *tvg_float;
+	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -3924,13 +4984,13 @@ int mbsys_reson7k_print_v27kcenterversion(int verbose, s7kr_v27kcenterversion *v
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       v27kcenterversion: %p\n", (void *)v27kcenterversion);
+		fprintf(stderr, "dbg2       tvg:               %p\n", (void *)tvg);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &v27kcenterversion->header, error);
+	mbsys_reson7k_print_header(verbose, &tvg->header, error);
 
-	/* Reson 7k center version (record 7022) */
+	/* print Reson 7k tvg data (record 7010) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -3938,7 +4998,16 @@ int mbsys_reson7k_print_v27kcenterversion(int verbose, s7kr_v27kcenterversion *v
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     version:                    %s\n", first, v27kcenterversion->version);
+	fprintf(stderr, "%s     serial_number:              %llu\n", first, tvg->serial_number);
+	fprintf(stderr, "%s     ping_number:                %u\n", first, tvg->ping_number);
+	fprintf(stderr, "%s     multi_ping:                 %u\n", first, tvg->multi_ping);
+	fprintf(stderr, "%s     n:                          %d\n", first, tvg->n);
+	for (i = 0; i < 8; i++)
+		fprintf(stderr, "%s     reserved[%d]:                %d\n", first, i, tvg->reserved[i]);
+	for (i = 0; i < tvg->n; i++) {
+		tvg_float = (float *)tvg->tvg;
+		fprintf(stderr, "%s     tvg[%d]:  %f\n", first, i, tvg_float[i]);
+	}
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -3953,12 +5022,16 @@ int mbsys_reson7k_print_v27kcenterversion(int verbose, s7kr_v27kcenterversion *v
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_v28kwetendversion(int verbose, s7kr_v28kwetendversion *v28kwetendversion, int *error) {
-	char *function_name = "mbsys_reson7k_print_v28kwetendversion";
-	int status = MB_SUCCESS;
+int mbsys_reson7k_print_image(int verbose, s7kr_image *image, int *error) {
+	char *function_name = "mbsys_reson7k_print_image";
+	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
+	mb_s_char *charptr;
+	short *shortptr;
+	int *intptr;
+	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -3966,13 +5039,13 @@ int mbsys_reson7k_print_v28kwetendversion(int verbose, s7kr_v28kwetendversion *v
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       v28kwetendversion:      %p\n", (void *)v28kwetendversion);
+		fprintf(stderr, "dbg2       image:             %p\n", (void *)image);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &v28kwetendversion->header, error);
+	mbsys_reson7k_print_header(verbose, &image->header, error);
 
-	/* Reson 7k 8k wet end version (record 7023) */
+	/* print Reson 7k image imagery data (record 7007) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -3980,7 +5053,29 @@ int mbsys_reson7k_print_v28kwetendversion(int verbose, s7kr_v28kwetendversion *v
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     version:                    %s\n", first, v28kwetendversion->version);
+	fprintf(stderr, "%s     ping_number:                %u\n", first, image->ping_number);
+	fprintf(stderr, "%s     multi_ping:                 %u\n", first, image->multi_ping);
+	fprintf(stderr, "%s     width:                      %d\n", first, image->width);
+	fprintf(stderr, "%s     height:                     %d\n", first, image->height);
+	fprintf(stderr, "%s     color_depth:                %d\n", first, image->color_depth);
+	fprintf(stderr, "%s     width_height_flag:          %d\n", first, image->width_height_flag);
+	fprintf(stderr, "%s     compression:                %d\n", first, image->compression);
+	fprintf(stderr, "%s     nalloc:                     %d\n", first, image->nalloc);
+	if (image->color_depth == 1) {
+		charptr = (mb_s_char *)image->image;
+		for (i = 0; i < image->width * image->height; i++)
+			fprintf(stderr, "%s     image[%d]:  %hhu\n", first, i, charptr[i]);
+	}
+	else if (image->color_depth == 2) {
+		shortptr = (short *)image->image;
+		for (i = 0; i < image->width * image->height; i++)
+			fprintf(stderr, "%s     image[%d]:  %hu\n", first, i, shortptr[i]);
+	}
+	else if (image->color_depth == 4) {
+		intptr = (int *)image->image;
+		for (i = 0; i < image->width * image->height; i++)
+			fprintf(stderr, "%s     image[%d]:  %u\n", first, i, intptr[i]);
+	}
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -3995,8 +5090,8 @@ int mbsys_reson7k_print_v28kwetendversion(int verbose, s7kr_v28kwetendversion *v
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_v2detection(int verbose, s7kr_v2detection *v2detection, int *error) {
-	char *function_name = "mbsys_reson7k_print_v2detection";
+int mbsys_reson7k_print_v2pingmotion(int verbose, s7kr_v2pingmotion *v2pingmotion, int *error) {
+	char *function_name = "mbsys_reson7k_print_v2pingmotion";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
@@ -4009,13 +5104,13 @@ int mbsys_reson7k_print_v2detection(int verbose, s7kr_v2detection *v2detection,
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       v2detection:      %p\n", (void *)v2detection);
+		fprintf(stderr, "dbg2       v2pingmotion:      %p\n", (void *)v2pingmotion);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &v2detection->header, error);
+	mbsys_reson7k_print_header(verbose, &v2pingmotion->header, error);
 
-	/* print Reson 7k version 2 detection (record 7026) */
+	/* print Reson 7k ping motion (record 7012) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -4023,22 +5118,20 @@ int mbsys_reson7k_print_v2detection(int verbose, s7kr_v2detection *v2detection,
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     serial_number:              %llu\n", first, v2detection->serial_number);
-	fprintf(stderr, "%s     ping_number:                %u\n", first, v2detection->ping_number);
-	fprintf(stderr, "%s     multi_ping:                 %u\n", first, v2detection->multi_ping);
-	fprintf(stderr, "%s     number_beams:               %u\n", first, v2detection->number_beams);
-	fprintf(stderr, "%s     data_field_size:            %d\n", first, v2detection->data_field_size);
-	fprintf(stderr, "%s     corrections:                %llu\n", first, v2detection->corrections);
-	fprintf(stderr, "%s     detection_algorithm:        %d\n", first, v2detection->detection_algorithm);
-	fprintf(stderr, "%s     flags:                      %d\n", first, v2detection->flags);
-	for (i = 0; i < 64; i++)
-		fprintf(stderr, "%u ", v2detection->reserved[i]);
-	fprintf(stderr, "%s     beam	range angle_x angle_y range_error angle_x_error angle_y_error\n", first);
-	fprintf(stderr, "%s     ----------------------------------------------------------------------\n", first);
-	for (i = 0; i < v2detection->number_beams; i++) {
-		fprintf(stderr, "%s     %3d %f %f %f %f %f %f\n", first, i, v2detection->range[i], v2detection->angle_x[i],
-		        v2detection->angle_y[i], v2detection->range_error[i], v2detection->angle_x_error[i],
-		        v2detection->angle_y_error[i]);
+	fprintf(stderr, "%s     serial_number:              %llu\n", first, v2pingmotion->serial_number);
+	fprintf(stderr, "%s     ping_number:                %u\n", first, v2pingmotion->ping_number);
+	fprintf(stderr, "%s     multi_ping:                 %u\n", first, v2pingmotion->multi_ping);
+	fprintf(stderr, "%s     n:                          %d\n", first, v2pingmotion->n);
+	fprintf(stderr, "%s     flags:                      %d\n", first, v2pingmotion->flags);
+	fprintf(stderr, "%s     error_flags:                %d\n", first, v2pingmotion->error_flags);
+	fprintf(stderr, "%s     frequency:                  %f\n", first, v2pingmotion->frequency);
+	fprintf(stderr, "%s     pitch:                      %f\n", first, v2pingmotion->pitch);
+	fprintf(stderr, "%s     nalloc:                     %d\n", first, v2pingmotion->nalloc);
+	fprintf(stderr, "%s     beam	roll    heading    heave\n", first);
+	fprintf(stderr, "%s     ----	----    -------    -----\n", first);
+	for (i = 0; i < v2pingmotion->n; i++) {
+		fprintf(stderr, "%s     %3d  %10g  %10g  %10g\n", first, i, v2pingmotion->roll[i], v2pingmotion->heading[i],
+		        v2pingmotion->heave[i]);
 	}
 
 	/* print output debug statements */
@@ -4054,8 +5147,8 @@ int mbsys_reson7k_print_v2detection(int verbose, s7kr_v2detection *v2detection,
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_v2rawdetection(int verbose, s7kr_v2rawdetection *v2rawdetection, int *error) {
-	char *function_name = "mbsys_reson7k_print_v2rawdetection";
+int mbsys_reson7k_print_v2detectionsetup(int verbose, s7kr_v2detectionsetup *v2detectionsetup, int *error) {
+	char *function_name = "mbsys_reson7k_print_v2detectionsetup";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
@@ -4068,13 +5161,13 @@ int mbsys_reson7k_print_v2rawdetection(int verbose, s7kr_v2rawdetection *v2rawde
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       v2rawdetection:      %p\n", (void *)v2rawdetection);
+		fprintf(stderr, "dbg2       v2detectionsetup:  %p\n", (void *)v2detectionsetup);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &v2rawdetection->header, error);
+	mbsys_reson7k_print_header(verbose, &v2detectionsetup->header, error);
 
-	/* print Reson 7k version 2 raw detection (record 7027) */
+	/* print Reson 7k detection setup (record 7017) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -4082,24 +5175,32 @@ int mbsys_reson7k_print_v2rawdetection(int verbose, s7kr_v2rawdetection *v2rawde
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     serial_number:              %llu\n", first, v2rawdetection->serial_number);
-	fprintf(stderr, "%s     ping_number:                %u\n", first, v2rawdetection->ping_number);
-	fprintf(stderr, "%s     multi_ping:                 %u\n", first, v2rawdetection->multi_ping);
-	fprintf(stderr, "%s     number_beams:               %u\n", first, v2rawdetection->number_beams);
-	fprintf(stderr, "%s     data_field_size:            %d\n", first, v2rawdetection->data_field_size);
-	fprintf(stderr, "%s     detection_algorithm:        %d\n", first, v2rawdetection->detection_algorithm);
-	fprintf(stderr, "%s     detection_flags:            %d\n", first, v2rawdetection->detection_flags);
-	fprintf(stderr, "%s     sampling_rate:              %f\n", first, v2rawdetection->sampling_rate);
-	fprintf(stderr, "%s     tx_angle:                   %f\n", first, v2rawdetection->tx_angle);
-	fprintf(stderr, "%s     reserved:                   ", first);
-	for (i = 0; i < 64; i++)
-		fprintf(stderr, "%u ", v2rawdetection->reserved[i]);
-	fprintf(stderr, "\n%s     beam	beam_descriptor detection_point rx_angle flags quality uncertainty\n", first);
-	fprintf(stderr, "%s     ----------------------------------------------------------------------\n", first);
-	for (i = 0; i < v2rawdetection->number_beams; i++) {
-		fprintf(stderr, "%s     %3d %u %f %f %u %u %f\n", first, i, v2rawdetection->beam_descriptor[i],
-		        v2rawdetection->detection_point[i], v2rawdetection->rx_angle[i], v2rawdetection->flags[i],
-		        v2rawdetection->quality[i], v2rawdetection->uncertainty[i]);
+	fprintf(stderr, "%s     serial_number:              %llu\n", first, v2detectionsetup->serial_number);
+	fprintf(stderr, "%s     ping_number:                %u\n", first, v2detectionsetup->ping_number);
+	fprintf(stderr, "%s     multi_ping:                 %u\n", first, v2detectionsetup->multi_ping);
+	fprintf(stderr, "%s     number_beams:               %u\n", first, v2detectionsetup->number_beams);
+	fprintf(stderr, "%s     data_field_size:            %d\n", first, v2detectionsetup->data_field_size);
+	fprintf(stderr, "%s     detection_algorithm:        %d\n", first, v2detectionsetup->detection_algorithm);
+	fprintf(stderr, "%s     detection_flags:            %d\n", first, v2detectionsetup->detection_flags);
+	fprintf(stderr, "%s     minimum_depth:              %f\n", first, v2detectionsetup->minimum_depth);
+	fprintf(stderr, "%s     maximum_depth:              %f\n", first, v2detectionsetup->maximum_depth);
+	fprintf(stderr, "%s     minimum_range:              %f\n", first, v2detectionsetup->minimum_range);
+	fprintf(stderr, "%s     maximum_range:              %f\n", first, v2detectionsetup->maximum_range);
+	fprintf(stderr, "%s     minimum_nadir_search:       %f\n", first, v2detectionsetup->minimum_nadir_search);
+	fprintf(stderr, "%s     maximum_nadir_search:       %f\n", first, v2detectionsetup->maximum_nadir_search);
+	fprintf(stderr, "%s     automatic_filter_window:    %u\n", first, v2detectionsetup->automatic_filter_window);
+	fprintf(stderr, "%s     applied_roll:               %f\n", first, v2detectionsetup->applied_roll);
+	fprintf(stderr, "%s     depth_gate_tilt:            %f\n", first, v2detectionsetup->depth_gate_tilt);
+	for (i = 0; i < 14; i++) {
+		fprintf(stderr, "%s     reserved[%2d]:               %f\n", first, i, v2detectionsetup->reserved[i]);
+	}
+	fprintf(stderr, "%s     beam	descriptor pick flag amin amax umin umax quality uncertainty\n", first);
+	fprintf(stderr, "%s     ---------------------------------------------------------\n", first);
+	for (i = 0; i < v2detectionsetup->number_beams; i++) {
+		fprintf(stderr, "%s     %3d %u %10.3f %u %u %u %u %u %u %f\n", first, i, v2detectionsetup->beam_descriptor[i],
+		        v2detectionsetup->detection_point[i], v2detectionsetup->flags[i], v2detectionsetup->auto_limits_min_sample[i],
+		        v2detectionsetup->auto_limits_max_sample[i], v2detectionsetup->user_limits_min_sample[i],
+		        v2detectionsetup->user_limits_max_sample[i], v2detectionsetup->quality[i], v2detectionsetup->uncertainty[i]);
 	}
 
 	/* print output debug statements */
@@ -4115,10 +5216,10 @@ int mbsys_reson7k_print_v2rawdetection(int verbose, s7kr_v2rawdetection *v2rawde
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_v2snippet(int verbose, s7kr_v2snippet *v2snippet, int *error) {
-	char *function_name = "mbsys_reson7k_print_v2snippet";
+int mbsys_reson7k_print_v2beamformed(int verbose, s7kr_v2beamformed *v2beamformed, int *error) {
+	char *function_name = "mbsys_reson7k_print_v2beamformed";
 	int status = MB_SUCCESS;
-	s7kr_v2snippettimeseries *v2snippettimeseries;
+	s7kr_v2amplitudephase *v2amplitudephase;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
@@ -4130,13 +5231,13 @@ int mbsys_reson7k_print_v2snippet(int verbose, s7kr_v2snippet *v2snippet, int *e
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       v2snippet:      %p\n", (void *)v2snippet);
+		fprintf(stderr, "dbg2       v2beamformed:      %p\n", (void *)v2beamformed);
 	}
 
-	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &v2snippet->header, error);
+	/* Reson 7k beamformed magnitude and phase data (record 7018) */
+	mbsys_reson7k_print_header(verbose, &v2beamformed->header, error);
 
-	/* print Reson 7k version 2 snippet (record 7028) */
+	/* print Reson 7k detection setup (record 7017) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -4144,21 +5245,23 @@ int mbsys_reson7k_print_v2snippet(int verbose, s7kr_v2snippet *v2snippet, int *e
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     serial_number:              %llu\n", first, v2snippet->serial_number);
-	fprintf(stderr, "%s     ping_number:                %u\n", first, v2snippet->ping_number);
-	fprintf(stderr, "%s     multi_ping:                 %u\n", first, v2snippet->multi_ping);
-	fprintf(stderr, "%s     number_beams:               %u\n", first, v2snippet->number_beams);
-	fprintf(stderr, "%s     error_flag:                 %u\n", first, v2snippet->error_flag);
-	fprintf(stderr, "%s     control_flags:              %u\n", first, v2snippet->control_flags);
-	for (i = 0; i < 28; i++)
-		fprintf(stderr, "%u ", v2snippet->reserved[i]);
-	for (i = 0; i < v2snippet->number_beams; i++) {
-		v2snippettimeseries = &(v2snippet->snippettimeseries[i]);
-		fprintf(stderr, "%s     beam: %u begin:%u detect:%u end:%u\n", first, v2snippettimeseries->beam_number,
-		        v2snippettimeseries->begin_sample, v2snippettimeseries->detect_sample, v2snippettimeseries->end_sample);
-		for (j = 0; j < v2snippettimeseries->end_sample - v2snippettimeseries->begin_sample + 1; j++)
-			fprintf(stderr, "%s     amplitude[%d]:%d\n", first, v2snippettimeseries->begin_sample + j,
-			        v2snippettimeseries->amplitude[j]);
+	fprintf(stderr, "%s     serial_number:              %llu\n", first, v2beamformed->serial_number);
+	fprintf(stderr, "%s     ping_number:                %u\n", first, v2beamformed->ping_number);
+	fprintf(stderr, "%s     multi_ping:                 %u\n", first, v2beamformed->multi_ping);
+	fprintf(stderr, "%s     number_beams:               %u\n", first, v2beamformed->number_beams);
+	fprintf(stderr, "%s     number_samples:             %d\n", first, v2beamformed->number_samples);
+	fprintf(stderr, "%s     reserved:                   ", first);
+	for (i = 0; i < 32; i++)
+		fprintf(stderr, "%u ", v2beamformed->reserved[i]);
+	fprintf(stderr, "\n");
+	for (i = 0; i < v2beamformed->number_beams; i++) {
+		v2amplitudephase = &(v2beamformed->amplitudephase[i]);
+		fprintf(stderr, "%s     beam_number:                %d\n", first, v2amplitudephase->beam_number);
+		fprintf(stderr, "%s     number_samples:             %d\n", first, v2amplitudephase->number_samples);
+		for (j = 0; j < v2amplitudephase->number_samples; j++) {
+			fprintf(stderr, "%s     beam[%d] sample[%d] amplitude:%u phase:%d\n", first, i, j, v2amplitudephase->amplitude[j],
+			        v2amplitudephase->phase[j]);
+		}
 	}
 
 	/* print output debug statements */
@@ -4174,10 +5277,12 @@ int mbsys_reson7k_print_v2snippet(int verbose, s7kr_v2snippet *v2snippet, int *e
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_calibratedsnippet(int verbose, s7kr_calibratedsnippet *calibratedsnippet, int *error) {
-	char *function_name = "mbsys_reson7k_print_calibratedsnippet";
+int mbsys_reson7k_print_v2bite(int verbose, s7kr_v2bite *v2bite, int *error) {
+	char *function_name = "mbsys_reson7k_print_v2bite";
 	int status = MB_SUCCESS;
-	s7kr_calibratedsnippettimeseries *calibratedsnippettimeseries;
+	s7kr_v2bitereport *v2bitereport;
+	s7kr_v2bitefield *v2bitefield;
+	s7k_time *s7ktime;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
@@ -4189,13 +5294,13 @@ int mbsys_reson7k_print_calibratedsnippet(int verbose, s7kr_calibratedsnippet *c
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       calibratedsnippet:      %p\n", (void *)calibratedsnippet);
+		fprintf(stderr, "dbg2       v2bite:      %p\n", (void *)v2bite);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &calibratedsnippet->header, error);
+	mbsys_reson7k_print_header(verbose, &v2bite->header, error);
 
-	/* print Reson 7k version 2 snippet (record 7028) */
+	/* Reson 7k BITE (record 7021) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -4203,22 +5308,37 @@ int mbsys_reson7k_print_calibratedsnippet(int verbose, s7kr_calibratedsnippet *c
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     serial_number:              %llu\n", first, calibratedsnippet->serial_number);
-	fprintf(stderr, "%s     ping_number:                %u\n", first, calibratedsnippet->ping_number);
-	fprintf(stderr, "%s     multi_ping:                 %u\n", first, calibratedsnippet->multi_ping);
-	fprintf(stderr, "%s     number_beams:               %u\n", first, calibratedsnippet->number_beams);
-	fprintf(stderr, "%s     error_flag:                 %u\n", first, calibratedsnippet->error_flag);
-	fprintf(stderr, "%s     control_flags:              %u\n", first, calibratedsnippet->control_flags);
-	for (i = 0; i < 28; i++)
-		fprintf(stderr, "%s     reserved[%d]:                %u\n", first, i, calibratedsnippet->reserved[i]);
-	for (i = 0; i < calibratedsnippet->number_beams; i++) {
-		calibratedsnippettimeseries = &(calibratedsnippet->calibratedsnippettimeseries[i]);
-		fprintf(stderr, "%s     beam: %u begin:%u detect:%u end:%u\n", first, calibratedsnippettimeseries->beam_number,
-		        calibratedsnippettimeseries->begin_sample, calibratedsnippettimeseries->detect_sample,
-		        calibratedsnippettimeseries->end_sample);
-		for (j = 0; j < calibratedsnippettimeseries->end_sample - calibratedsnippettimeseries->begin_sample + 1; j++)
-			fprintf(stderr, "%s     snippet amplitude[%d]:%f\n", first, calibratedsnippettimeseries->begin_sample + j,
-			        calibratedsnippettimeseries->amplitude[j]);
+	fprintf(stderr, "%s     number_reports:             %u\n", first, v2bite->number_reports);
+	for (i = 0; i < v2bite->number_reports; i++) {
+		v2bitereport = &(v2bite->reports[i]);
+		fprintf(stderr, "%s     source_name:                %s\n", first, v2bitereport->source_name);
+		fprintf(stderr, "%s     source_address:             %u\n", first, v2bitereport->source_address);
+		fprintf(stderr, "%s     frequency:                  %f\n", first, v2bitereport->frequency);
+		fprintf(stderr, "%s     enumerator:                 %u\n", first, v2bitereport->enumerator);
+		s7ktime = &(v2bitereport->downlink_time);
+		fprintf(stderr, "%s     downlink_time:              %4.4d/%3.3d %2.2d:%2.2d:%9.6f\n", first, s7ktime->Year, s7ktime->Day,
+		        s7ktime->Hours, s7ktime->Minutes, s7ktime->Seconds);
+		s7ktime = &(v2bitereport->uplink_time);
+		fprintf(stderr, "%s     uplink_time:                %4.4d/%3.3d %2.2d:%2.2d:%9.6f\n", first, s7ktime->Year, s7ktime->Day,
+		        s7ktime->Hours, s7ktime->Minutes, s7ktime->Seconds);
+		s7ktime = &(v2bitereport->bite_time);
+		fprintf(stderr, "%s     bite_time:                  %4.4d/%3.3d %2.2d:%2.2d:%9.6f\n", first, s7ktime->Year, s7ktime->Day,
+		        s7ktime->Hours, s7ktime->Minutes, s7ktime->Seconds);
+		fprintf(stderr, "%s     status:                     %u\n", first, v2bitereport->status);
+		fprintf(stderr, "%s     number_bite:                %u\n", first, v2bitereport->number_bite);
+		fprintf(stderr, "%s     bite_status:                ", first);
+		for (j = 0; j < 32; j++)
+			fprintf(stderr, "%u ", v2bitereport->bite_status[j]);
+		fprintf(stderr, "\n");
+		for (j = 0; j < v2bitereport->number_bite; j++) {
+			v2bitefield = &(v2bitereport->bitefield[j]);
+			fprintf(stderr, "%s     reserved[%2d]:               %u\n", first, j, v2bitefield->reserved);
+			fprintf(stderr, "%s     name[%2d]:                   %s\n", first, j, v2bitefield->name);
+			fprintf(stderr, "%s     device_type[%2d]:            %d\n", first, j, v2bitefield->device_type);
+			fprintf(stderr, "%s     minimum[%2d]:                %f\n", first, j, v2bitefield->minimum);
+			fprintf(stderr, "%s     maximum[%2d]:                %f\n", first, j, v2bitefield->maximum);
+			fprintf(stderr, "%s     value[%2d]:                  %f\n", first, j, v2bitefield->value);
+		}
 	}
 
 	/* print output debug statements */
@@ -4234,8 +5354,8 @@ int mbsys_reson7k_print_calibratedsnippet(int verbose, s7kr_calibratedsnippet *c
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_installation(int verbose, s7kr_installation *installation, int *error) {
-	char *function_name = "mbsys_reson7k_print_installation";
+int mbsys_reson7k_print_v27kcenterversion(int verbose, s7kr_v27kcenterversion *v27kcenterversion, int *error) {
+	char *function_name = "mbsys_reson7k_print_v27kcenterversion";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
@@ -4247,13 +5367,13 @@ int mbsys_reson7k_print_installation(int verbose, s7kr_installation *installatio
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       installation:      %p\n", (void *)installation);
+		fprintf(stderr, "dbg2       v27kcenterversion: %p\n", (void *)v27kcenterversion);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &installation->header, error);
+	mbsys_reson7k_print_header(verbose, &v27kcenterversion->header, error);
 
-	/* print Reson 7k sonar installation parameters (record 7051) */
+	/* Reson 7k center version (record 7022) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -4261,45 +5381,7 @@ int mbsys_reson7k_print_installation(int verbose, s7kr_installation *installatio
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     frequency:                  %f\n", first, installation->frequency);
-	fprintf(stderr, "%s     firmware_version_len:       %d\n", first, installation->firmware_version_len);
-	fprintf(stderr, "%s     firmware_version:           %s\n", first, installation->firmware_version);
-	fprintf(stderr, "%s     software_version_len:       %d\n", first, installation->software_version_len);
-	fprintf(stderr, "%s     software_version:           %s\n", first, installation->software_version);
-	fprintf(stderr, "%s     s7k_version_len:            %d\n", first, installation->s7k_version_len);
-	fprintf(stderr, "%s     s7k_version:                %s\n", first, installation->s7k_version);
-	fprintf(stderr, "%s     protocal_version_len:       %d\n", first, installation->protocal_version_len);
-	fprintf(stderr, "%s     protocal_version:           %s\n", first, installation->protocal_version);
-	fprintf(stderr, "%s     transmit_x:                 %f\n", first, installation->transmit_x);
-	fprintf(stderr, "%s     transmit_y:                 %f\n", first, installation->transmit_y);
-	fprintf(stderr, "%s     transmit_z:                 %f\n", first, installation->transmit_z);
-	fprintf(stderr, "%s     transmit_roll:              %f\n", first, installation->transmit_roll);
-	fprintf(stderr, "%s     transmit_pitch:             %f\n", first, installation->transmit_pitch);
-	fprintf(stderr, "%s     transmit_heading:           %f\n", first, installation->transmit_heading);
-	fprintf(stderr, "%s     transmit_x:                 %f\n", first, installation->transmit_x);
-	fprintf(stderr, "%s     transmit_x:                 %f\n", first, installation->transmit_x);
-	fprintf(stderr, "%s     receive_x:                  %f\n", first, installation->receive_x);
-	fprintf(stderr, "%s     receive_y:                  %f\n", first, installation->receive_y);
-	fprintf(stderr, "%s     receive_z:                  %f\n", first, installation->receive_z);
-	fprintf(stderr, "%s     receive_roll:               %f\n", first, installation->receive_roll);
-	fprintf(stderr, "%s     receive_pitch:              %f\n", first, installation->receive_pitch);
-	fprintf(stderr, "%s     receive_heading:            %f\n", first, installation->receive_heading);
-	fprintf(stderr, "%s     receive_x:                  %f\n", first, installation->receive_x);
-	fprintf(stderr, "%s     receive_x:                  %f\n", first, installation->receive_x);
-	fprintf(stderr, "%s     motion_x:                   %f\n", first, installation->motion_x);
-	fprintf(stderr, "%s     motion_y:                   %f\n", first, installation->motion_y);
-	fprintf(stderr, "%s     motion_z:                   %f\n", first, installation->motion_z);
-	fprintf(stderr, "%s     motion_roll:                %f\n", first, installation->motion_roll);
-	fprintf(stderr, "%s     motion_pitch:               %f\n", first, installation->motion_pitch);
-	fprintf(stderr, "%s     motion_heading:             %f\n", first, installation->motion_heading);
-	fprintf(stderr, "%s     motion_x:                   %f\n", first, installation->motion_x);
-	fprintf(stderr, "%s     motion_x:                   %f\n", first, installation->motion_x);
-	fprintf(stderr, "%s     motion_time_delay:          %d\n", first, installation->motion_time_delay);
-	fprintf(stderr, "%s     position_x:                 %f\n", first, installation->position_x);
-	fprintf(stderr, "%s     position_y:                 %f\n", first, installation->position_y);
-	fprintf(stderr, "%s     position_z:                 %f\n", first, installation->position_z);
-	fprintf(stderr, "%s     position_time_delay:        %d\n", first, installation->position_time_delay);
-	fprintf(stderr, "%s     waterline_z:                %f\n", first, installation->waterline_z);
+	fprintf(stderr, "%s     version:                    %s\n", first, v27kcenterversion->version);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -4314,8 +5396,8 @@ int mbsys_reson7k_print_installation(int verbose, s7kr_installation *installatio
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_systemeventmessage(int verbose, s7kr_systemeventmessage *systemeventmessage, int *error) {
-	char *function_name = "mbsys_reson7k_print_systemeventmessage";
+int mbsys_reson7k_print_v28kwetendversion(int verbose, s7kr_v28kwetendversion *v28kwetendversion, int *error) {
+	char *function_name = "mbsys_reson7k_print_v28kwetendversion";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
@@ -4327,13 +5409,13 @@ int mbsys_reson7k_print_systemeventmessage(int verbose, s7kr_systemeventmessage
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       systemeventmessage:%p\n", (void *)systemeventmessage);
+		fprintf(stderr, "dbg2       v28kwetendversion:      %p\n", (void *)v28kwetendversion);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &systemeventmessage->header, error);
+	mbsys_reson7k_print_header(verbose, &v28kwetendversion->header, error);
 
-	/* print Reson 7k system event (record 7051) */
+	/* Reson 7k 8k wet end version (record 7023) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -4341,12 +5423,7 @@ int mbsys_reson7k_print_systemeventmessage(int verbose, s7kr_systemeventmessage
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     serial_number:              %llu\n", first, systemeventmessage->serial_number);
-	fprintf(stderr, "%s     event_id:                   %d\n", first, systemeventmessage->event_id);
-	fprintf(stderr, "%s     message_length:             %d\n", first, systemeventmessage->message_length);
-	fprintf(stderr, "%s     event_identifier:           %d\n", first, systemeventmessage->event_identifier);
-	fprintf(stderr, "%s     message_alloc:              %d\n", first, systemeventmessage->message_alloc);
-	fprintf(stderr, "%s     message:                    %s\n", first, systemeventmessage->message);
+	fprintf(stderr, "%s     version:                    %s\n", first, v28kwetendversion->version);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -4361,12 +5438,13 @@ int mbsys_reson7k_print_systemeventmessage(int verbose, s7kr_systemeventmessage
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_subsystem(int verbose, s7kr_subsystem *subsystem, int *error) {
-	char *function_name = "mbsys_reson7k_print_subsystem";
+int mbsys_reson7k_print_v2detection(int verbose, s7kr_v2detection *v2detection, int *error) {
+	char *function_name = "mbsys_reson7k_print_v2detection";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
+	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -4374,10 +5452,13 @@ int mbsys_reson7k_print_subsystem(int verbose, s7kr_subsystem *subsystem, int *e
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       subsystem:         %p\n", (void *)subsystem);
+		fprintf(stderr, "dbg2       v2detection:      %p\n", (void *)v2detection);
 	}
 
-	/* print Reson 7k subsystem structure */
+	/* print Reson 7k data record header information */
+	mbsys_reson7k_print_header(verbose, &v2detection->header, error);
+
+	/* print Reson 7k version 2 detection (record 7026) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -4385,8 +5466,23 @@ int mbsys_reson7k_print_subsystem(int verbose, s7kr_subsystem *subsystem, int *e
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     device_identifier:          %d\n", first, subsystem->device_identifier);
-	fprintf(stderr, "%s     system_enumerator:          %d\n", first, subsystem->system_enumerator);
+	fprintf(stderr, "%s     serial_number:              %llu\n", first, v2detection->serial_number);
+	fprintf(stderr, "%s     ping_number:                %u\n", first, v2detection->ping_number);
+	fprintf(stderr, "%s     multi_ping:                 %u\n", first, v2detection->multi_ping);
+	fprintf(stderr, "%s     number_beams:               %u\n", first, v2detection->number_beams);
+	fprintf(stderr, "%s     data_field_size:            %d\n", first, v2detection->data_field_size);
+	fprintf(stderr, "%s     corrections:                %llu\n", first, v2detection->corrections);
+	fprintf(stderr, "%s     detection_algorithm:        %d\n", first, v2detection->detection_algorithm);
+	fprintf(stderr, "%s     flags:                      %d\n", first, v2detection->flags);
+	for (i = 0; i < 64; i++)
+		fprintf(stderr, "%u ", v2detection->reserved[i]);
+	fprintf(stderr, "%s     beam	range angle_x angle_y range_error angle_x_error angle_y_error\n", first);
+	fprintf(stderr, "%s     ----------------------------------------------------------------------\n", first);
+	for (i = 0; i < v2detection->number_beams; i++) {
+		fprintf(stderr, "%s     %3d %f %f %f %f %f %f\n", first, i, v2detection->range[i], v2detection->angle_x[i],
+		        v2detection->angle_y[i], v2detection->range_error[i], v2detection->angle_x_error[i],
+		        v2detection->angle_y_error[i]);
+	}
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -4401,8 +5497,8 @@ int mbsys_reson7k_print_subsystem(int verbose, s7kr_subsystem *subsystem, int *e
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_fileheader(int verbose, s7kr_fileheader *fileheader, int *error) {
-	char *function_name = "mbsys_reson7k_print_fileheader";
+int mbsys_reson7k_print_v2rawdetection(int verbose, s7kr_v2rawdetection *v2rawdetection, int *error) {
+	char *function_name = "mbsys_reson7k_print_v2rawdetection";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
@@ -4415,13 +5511,13 @@ int mbsys_reson7k_print_fileheader(int verbose, s7kr_fileheader *fileheader, int
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       fileheader:        %p\n", (void *)fileheader);
+		fprintf(stderr, "dbg2       v2rawdetection:      %p\n", (void *)v2rawdetection);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &fileheader->header, error);
+	mbsys_reson7k_print_header(verbose, &v2rawdetection->header, error);
 
-	/* print Reson 7k system event (record 7051) */
+	/* print Reson 7k version 2 raw detection (record 7027) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -4429,21 +5525,25 @@ int mbsys_reson7k_print_fileheader(int verbose, s7kr_fileheader *fileheader, int
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     file_identifier:            0x", first);
-	for (i = 0; i < 16; i++)
-		fprintf(stderr, "%hhx", fileheader->file_identifier[i]);
-	fprintf(stderr, "\n");
-	fprintf(stderr, "%s     version:                    %d\n", first, fileheader->version);
-	fprintf(stderr, "%s     reserved:                   %d\n", first, fileheader->reserved);
-	fprintf(stderr, "%s     session_identifier:         %s\n", first, fileheader->session_identifier);
-	fprintf(stderr, "%s     record_data_size:           %d\n", first, fileheader->record_data_size);
-	fprintf(stderr, "%s     number_subsystems:          %d\n", first, fileheader->number_subsystems);
-	fprintf(stderr, "%s     recording_name:             %s\n", first, fileheader->recording_name);
-	fprintf(stderr, "%s     recording_version:          %s\n", first, fileheader->recording_version);
-	fprintf(stderr, "%s     user_defined_name:          %s\n", first, fileheader->user_defined_name);
-	fprintf(stderr, "%s     notes:                      %s\n", first, fileheader->notes);
-	for (i = 0; i < fileheader->number_subsystems; i++)
-		mbsys_reson7k_print_subsystem(verbose, &fileheader->subsystem[i], error);
+	fprintf(stderr, "%s     serial_number:              %llu\n", first, v2rawdetection->serial_number);
+	fprintf(stderr, "%s     ping_number:                %u\n", first, v2rawdetection->ping_number);
+	fprintf(stderr, "%s     multi_ping:                 %u\n", first, v2rawdetection->multi_ping);
+	fprintf(stderr, "%s     number_beams:               %u\n", first, v2rawdetection->number_beams);
+	fprintf(stderr, "%s     data_field_size:            %d\n", first, v2rawdetection->data_field_size);
+	fprintf(stderr, "%s     detection_algorithm:        %d\n", first, v2rawdetection->detection_algorithm);
+	fprintf(stderr, "%s     detection_flags:            %d\n", first, v2rawdetection->detection_flags);
+	fprintf(stderr, "%s     sampling_rate:              %f\n", first, v2rawdetection->sampling_rate);
+	fprintf(stderr, "%s     tx_angle:                   %f\n", first, v2rawdetection->tx_angle);
+	fprintf(stderr, "%s     reserved:                   ", first);
+	for (i = 0; i < 64; i++)
+		fprintf(stderr, "%u ", v2rawdetection->reserved[i]);
+	fprintf(stderr, "\n%s     beam	beam_descriptor detection_point rx_angle flags quality uncertainty\n", first);
+	fprintf(stderr, "%s     ----------------------------------------------------------------------\n", first);
+	for (i = 0; i < v2rawdetection->number_beams; i++) {
+		fprintf(stderr, "%s     %3d %u %f %f %u %u %f\n", first, i, v2rawdetection->beam_descriptor[i],
+		        v2rawdetection->detection_point[i], v2rawdetection->rx_angle[i], v2rawdetection->flags[i],
+		        v2rawdetection->quality[i], v2rawdetection->uncertainty[i]);
+	}
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -4458,13 +5558,14 @@ int mbsys_reson7k_print_fileheader(int verbose, s7kr_fileheader *fileheader, int
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_remotecontrolsettings(int verbose, s7kr_remotecontrolsettings *remotecontrolsettings, int *error) {
-	char *function_name = "mbsys_reson7k_print_remotecontrolsettings";
+int mbsys_reson7k_print_v2snippet(int verbose, s7kr_v2snippet *v2snippet, int *error) {
+	char *function_name = "mbsys_reson7k_print_v2snippet";
 	int status = MB_SUCCESS;
+	s7kr_v2snippettimeseries *v2snippettimeseries;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
-	int i;
+	int i, j;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -4472,13 +5573,13 @@ int mbsys_reson7k_print_remotecontrolsettings(int verbose, s7kr_remotecontrolset
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       remotecontrolsettings:  %p\n", (void *)remotecontrolsettings);
+		fprintf(stderr, "dbg2       v2snippet:      %p\n", (void *)v2snippet);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &remotecontrolsettings->header, error);
+	mbsys_reson7k_print_header(verbose, &v2snippet->header, error);
 
-	/* print Reson 7k remote control sonar settings (record 7503) */
+	/* print Reson 7k version 2 snippet (record 7028) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -4486,58 +5587,22 @@ int mbsys_reson7k_print_remotecontrolsettings(int verbose, s7kr_remotecontrolset
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     serial_number:              %llu\n", first, remotecontrolsettings->serial_number);
-	fprintf(stderr, "%s     ping_number:                %u\n", first, remotecontrolsettings->ping_number);
-	fprintf(stderr, "%s     frequency:                  %f\n", first, remotecontrolsettings->frequency);
-	fprintf(stderr, "%s     sample_rate:                %f\n", first, remotecontrolsettings->sample_rate);
-	fprintf(stderr, "%s     receiver_bandwidth:         %f\n", first, remotecontrolsettings->receiver_bandwidth);
-	fprintf(stderr, "%s     pulse_width:                %f\n", first, remotecontrolsettings->pulse_width);
-	fprintf(stderr, "%s     pulse_type:                 %d\n", first, remotecontrolsettings->pulse_type);
-	fprintf(stderr, "%s     pulse_envelope:             %d\n", first, remotecontrolsettings->pulse_envelope);
-	fprintf(stderr, "%s     pulse_envelope_par:         %f\n", first, remotecontrolsettings->pulse_envelope_par);
-	fprintf(stderr, "%s     pulse_reserved:             %d\n", first, remotecontrolsettings->pulse_reserved);
-	fprintf(stderr, "%s     max_ping_rate:              %f\n", first, remotecontrolsettings->max_ping_rate);
-	fprintf(stderr, "%s     ping_period:                %f\n", first, remotecontrolsettings->ping_period);
-	fprintf(stderr, "%s     range_selection:            %f\n", first, remotecontrolsettings->range_selection);
-	fprintf(stderr, "%s     power_selection:            %f\n", first, remotecontrolsettings->power_selection);
-	fprintf(stderr, "%s     gain_selection:             %f\n", first, remotecontrolsettings->gain_selection);
-	fprintf(stderr, "%s     control_flags:              %d\n", first, remotecontrolsettings->control_flags);
-	fprintf(stderr, "%s     projector_magic_no:         %d\n", first, remotecontrolsettings->projector_magic_no);
-	fprintf(stderr, "%s     steering_vertical:          %f\n", first, remotecontrolsettings->steering_vertical);
-	fprintf(stderr, "%s     steering_horizontal:        %f\n", first, remotecontrolsettings->steering_horizontal);
-	fprintf(stderr, "%s     beamwidth_vertical:         %f\n", first, remotecontrolsettings->beamwidth_vertical);
-	fprintf(stderr, "%s     beamwidth_horizontal:       %f\n", first, remotecontrolsettings->beamwidth_horizontal);
-	fprintf(stderr, "%s     focal_point:                %f\n", first, remotecontrolsettings->focal_point);
-	fprintf(stderr, "%s     projector_weighting:        %d\n", first, remotecontrolsettings->projector_weighting);
-	fprintf(stderr, "%s     projector_weighting_par:    %f\n", first, remotecontrolsettings->projector_weighting_par);
-	fprintf(stderr, "%s     transmit_flags:             %d\n", first, remotecontrolsettings->transmit_flags);
-	fprintf(stderr, "%s     hydrophone_magic_no:        %d\n", first, remotecontrolsettings->hydrophone_magic_no);
-	fprintf(stderr, "%s     receive_weighting:          %d\n", first, remotecontrolsettings->receive_weighting);
-	fprintf(stderr, "%s     receive_weighting_par:      %f\n", first, remotecontrolsettings->receive_weighting_par);
-	fprintf(stderr, "%s     receive_flags:              %d\n", first, remotecontrolsettings->receive_flags);
-	fprintf(stderr, "%s     range_minimum:              %f\n", first, remotecontrolsettings->range_minimum);
-	fprintf(stderr, "%s     range_maximum:              %f\n", first, remotecontrolsettings->range_maximum);
-	fprintf(stderr, "%s     depth_minimum:              %f\n", first, remotecontrolsettings->depth_minimum);
-	fprintf(stderr, "%s     depth_maximum:              %f\n", first, remotecontrolsettings->depth_maximum);
-	fprintf(stderr, "%s     absorption:                 %f\n", first, remotecontrolsettings->absorption);
-	fprintf(stderr, "%s     sound_velocity:             %f\n", first, remotecontrolsettings->sound_velocity);
-	fprintf(stderr, "%s     spreading:                  %f\n", first, remotecontrolsettings->spreading);
-	fprintf(stderr, "%s     reserved:                   %d\n", first, remotecontrolsettings->reserved);
-	fprintf(stderr, "%s     tx_offset_x:                %f\n", first, remotecontrolsettings->tx_offset_x);
-	fprintf(stderr, "%s     tx_offset_y:                %f\n", first, remotecontrolsettings->tx_offset_y);
-	fprintf(stderr, "%s     tx_offset_z:                %f\n", first, remotecontrolsettings->tx_offset_z);
-	fprintf(stderr, "%s     head_tilt_x:                %f\n", first, remotecontrolsettings->head_tilt_x);
-	fprintf(stderr, "%s     head_tilt_y:                %f\n", first, remotecontrolsettings->head_tilt_y);
-	fprintf(stderr, "%s     head_tilt_z:                %f\n", first, remotecontrolsettings->head_tilt_z);
-	fprintf(stderr, "%s     ping_on_off:                %d\n", first, remotecontrolsettings->ping_on_off);
-	fprintf(stderr, "%s     data_sample_types:          %d\n", first, remotecontrolsettings->data_sample_types);
-	fprintf(stderr, "%s     projector_orientation:      %d\n", first, remotecontrolsettings->projector_orientation);
-	fprintf(stderr, "%s     beam_angle_mode:            %d\n", first, remotecontrolsettings->beam_angle_mode);
-	fprintf(stderr, "%s     r7kcenter_mode:             %d\n", first, remotecontrolsettings->r7kcenter_mode);
-	fprintf(stderr, "%s     gate_depth_min:             %f\n", first, remotecontrolsettings->gate_depth_min);
-	fprintf(stderr, "%s     gate_depth_max:             %f\n", first, remotecontrolsettings->gate_depth_max);
-	for (i = 0; i < 35; i++)
-		fprintf(stderr, "%s     reserved2[i]:               %d\n", first, remotecontrolsettings->reserved2[i]);
+	fprintf(stderr, "%s     serial_number:              %llu\n", first, v2snippet->serial_number);
+	fprintf(stderr, "%s     ping_number:                %u\n", first, v2snippet->ping_number);
+	fprintf(stderr, "%s     multi_ping:                 %u\n", first, v2snippet->multi_ping);
+	fprintf(stderr, "%s     number_beams:               %u\n", first, v2snippet->number_beams);
+	fprintf(stderr, "%s     error_flag:                 %u\n", first, v2snippet->error_flag);
+	fprintf(stderr, "%s     control_flags:              %u\n", first, v2snippet->control_flags);
+	for (i = 0; i < 28; i++)
+		fprintf(stderr, "%u ", v2snippet->reserved[i]);
+	for (i = 0; i < v2snippet->number_beams; i++) {
+		v2snippettimeseries = &(v2snippet->snippettimeseries[i]);
+		fprintf(stderr, "%s     beam: %u begin:%u detect:%u end:%u\n", first, v2snippettimeseries->beam_number,
+		        v2snippettimeseries->begin_sample, v2snippettimeseries->detect_sample, v2snippettimeseries->end_sample);
+		for (j = 0; j < v2snippettimeseries->end_sample - v2snippettimeseries->begin_sample + 1; j++)
+			fprintf(stderr, "%s     amplitude[%d]:%d\n", first, v2snippettimeseries->begin_sample + j,
+			        v2snippettimeseries->amplitude[j]);
+	}
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -4552,13 +5617,14 @@ int mbsys_reson7k_print_remotecontrolsettings(int verbose, s7kr_remotecontrolset
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_reserved(int verbose, s7kr_reserved *reserved, int *error) {
-	char *function_name = "mbsys_reson7k_print_reserved";
+int mbsys_reson7k_print_calibratedsnippet(int verbose, s7kr_calibratedsnippet *calibratedsnippet, int *error) {
+	char *function_name = "mbsys_reson7k_print_calibratedsnippet";
 	int status = MB_SUCCESS;
+	s7kr_calibratedsnippettimeseries *calibratedsnippettimeseries;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
-	int i;
+	int i, j;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -4566,13 +5632,13 @@ int mbsys_reson7k_print_reserved(int verbose, s7kr_reserved *reserved, int *erro
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       reserved:          %p\n", (void *)reserved);
+		fprintf(stderr, "dbg2       calibratedsnippet:      %p\n", (void *)calibratedsnippet);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &reserved->header, error);
+	mbsys_reson7k_print_header(verbose, &calibratedsnippet->header, error);
 
-	/* print Reson 7k Reserved (well, unknown really...) (record 7504) */
+	/* print Reson 7k version 2 snippet (record 7028) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -4580,8 +5646,23 @@ int mbsys_reson7k_print_reserved(int verbose, s7kr_reserved *reserved, int *erro
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	for (i = 0; i < R7KHDRSIZE_7kReserved; i++)
-		fprintf(stderr, "%s     reserved[%d]:               %u\n", first, i, reserved->reserved[i]);
+	fprintf(stderr, "%s     serial_number:              %llu\n", first, calibratedsnippet->serial_number);
+	fprintf(stderr, "%s     ping_number:                %u\n", first, calibratedsnippet->ping_number);
+	fprintf(stderr, "%s     multi_ping:                 %u\n", first, calibratedsnippet->multi_ping);
+	fprintf(stderr, "%s     number_beams:               %u\n", first, calibratedsnippet->number_beams);
+	fprintf(stderr, "%s     error_flag:                 %u\n", first, calibratedsnippet->error_flag);
+	fprintf(stderr, "%s     control_flags:              %u\n", first, calibratedsnippet->control_flags);
+	for (i = 0; i < 28; i++)
+		fprintf(stderr, "%s     reserved[%d]:                %u\n", first, i, calibratedsnippet->reserved[i]);
+	for (i = 0; i < calibratedsnippet->number_beams; i++) {
+		calibratedsnippettimeseries = &(calibratedsnippet->calibratedsnippettimeseries[i]);
+		fprintf(stderr, "%s     beam: %u begin:%u detect:%u end:%u\n", first, calibratedsnippettimeseries->beam_number,
+		        calibratedsnippettimeseries->begin_sample, calibratedsnippettimeseries->detect_sample,
+		        calibratedsnippettimeseries->end_sample);
+		for (j = 0; j < calibratedsnippettimeseries->end_sample - calibratedsnippettimeseries->begin_sample + 1; j++)
+			fprintf(stderr, "%s     snippet amplitude[%d]:%f\n", first, calibratedsnippettimeseries->begin_sample + j,
+			        calibratedsnippettimeseries->amplitude[j]);
+	}
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -4596,8 +5677,8 @@ int mbsys_reson7k_print_reserved(int verbose, s7kr_reserved *reserved, int *erro
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_roll(int verbose, s7kr_roll *roll, int *error) {
-	char *function_name = "mbsys_reson7k_print_roll";
+int mbsys_reson7k_print_installation(int verbose, s7kr_installation *installation, int *error) {
+	char *function_name = "mbsys_reson7k_print_installation";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
@@ -4609,13 +5690,13 @@ int mbsys_reson7k_print_roll(int verbose, s7kr_roll *roll, int *error) {
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       roll:              %p\n", (void *)roll);
+		fprintf(stderr, "dbg2       installation:      %p\n", (void *)installation);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &roll->header, error);
+	mbsys_reson7k_print_header(verbose, &installation->header, error);
 
-	/* print Reson 7k Roll (record 7600) */
+	/* print Reson 7k sonar installation parameters (record 7051) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -4623,23 +5704,61 @@ int mbsys_reson7k_print_roll(int verbose, s7kr_roll *roll, int *error) {
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     roll:                       %f\n", first, roll->roll);
-
-	/* print output debug statements */
-	if (verbose >= 2) {
-		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
-		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       error:      %d\n", *error);
-		fprintf(stderr, "dbg2  Return status:\n");
-		fprintf(stderr, "dbg2       status:     %d\n", status);
+	fprintf(stderr, "%s     frequency:                  %f\n", first, installation->frequency);
+	fprintf(stderr, "%s     firmware_version_len:       %d\n", first, installation->firmware_version_len);
+	fprintf(stderr, "%s     firmware_version:           %s\n", first, installation->firmware_version);
+	fprintf(stderr, "%s     software_version_len:       %d\n", first, installation->software_version_len);
+	fprintf(stderr, "%s     software_version:           %s\n", first, installation->software_version);
+	fprintf(stderr, "%s     s7k_version_len:            %d\n", first, installation->s7k_version_len);
+	fprintf(stderr, "%s     s7k_version:                %s\n", first, installation->s7k_version);
+	fprintf(stderr, "%s     protocal_version_len:       %d\n", first, installation->protocal_version_len);
+	fprintf(stderr, "%s     protocal_version:           %s\n", first, installation->protocal_version);
+	fprintf(stderr, "%s     transmit_x:                 %f\n", first, installation->transmit_x);
+	fprintf(stderr, "%s     transmit_y:                 %f\n", first, installation->transmit_y);
+	fprintf(stderr, "%s     transmit_z:                 %f\n", first, installation->transmit_z);
+	fprintf(stderr, "%s     transmit_roll:              %f\n", first, installation->transmit_roll);
+	fprintf(stderr, "%s     transmit_pitch:             %f\n", first, installation->transmit_pitch);
+	fprintf(stderr, "%s     transmit_heading:           %f\n", first, installation->transmit_heading);
+	fprintf(stderr, "%s     transmit_x:                 %f\n", first, installation->transmit_x);
+	fprintf(stderr, "%s     transmit_x:                 %f\n", first, installation->transmit_x);
+	fprintf(stderr, "%s     receive_x:                  %f\n", first, installation->receive_x);
+	fprintf(stderr, "%s     receive_y:                  %f\n", first, installation->receive_y);
+	fprintf(stderr, "%s     receive_z:                  %f\n", first, installation->receive_z);
+	fprintf(stderr, "%s     receive_roll:               %f\n", first, installation->receive_roll);
+	fprintf(stderr, "%s     receive_pitch:              %f\n", first, installation->receive_pitch);
+	fprintf(stderr, "%s     receive_heading:            %f\n", first, installation->receive_heading);
+	fprintf(stderr, "%s     receive_x:                  %f\n", first, installation->receive_x);
+	fprintf(stderr, "%s     receive_x:                  %f\n", first, installation->receive_x);
+	fprintf(stderr, "%s     motion_x:                   %f\n", first, installation->motion_x);
+	fprintf(stderr, "%s     motion_y:                   %f\n", first, installation->motion_y);
+	fprintf(stderr, "%s     motion_z:                   %f\n", first, installation->motion_z);
+	fprintf(stderr, "%s     motion_roll:                %f\n", first, installation->motion_roll);
+	fprintf(stderr, "%s     motion_pitch:               %f\n", first, installation->motion_pitch);
+	fprintf(stderr, "%s     motion_heading:             %f\n", first, installation->motion_heading);
+	fprintf(stderr, "%s     motion_x:                   %f\n", first, installation->motion_x);
+	fprintf(stderr, "%s     motion_x:                   %f\n", first, installation->motion_x);
+	fprintf(stderr, "%s     motion_time_delay:          %d\n", first, installation->motion_time_delay);
+	fprintf(stderr, "%s     position_x:                 %f\n", first, installation->position_x);
+	fprintf(stderr, "%s     position_y:                 %f\n", first, installation->position_y);
+	fprintf(stderr, "%s     position_z:                 %f\n", first, installation->position_z);
+	fprintf(stderr, "%s     position_time_delay:        %d\n", first, installation->position_time_delay);
+	fprintf(stderr, "%s     waterline_z:                %f\n", first, installation->waterline_z);
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
 	}
 
 	/* return status */
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_pitch(int verbose, s7kr_pitch *pitch, int *error) {
-	char *function_name = "mbsys_reson7k_print_pitch";
+int mbsys_reson7k_print_systemeventmessage(int verbose, s7kr_systemeventmessage *systemeventmessage, int *error) {
+	char *function_name = "mbsys_reson7k_print_systemeventmessage";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
@@ -4651,13 +5770,13 @@ int mbsys_reson7k_print_pitch(int verbose, s7kr_pitch *pitch, int *error) {
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       pitch:             %p\n", (void *)pitch);
+		fprintf(stderr, "dbg2       systemeventmessage:%p\n", (void *)systemeventmessage);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &pitch->header, error);
+	mbsys_reson7k_print_header(verbose, &systemeventmessage->header, error);
 
-	/* print Reson 7k Pitch (record 7601) */
+	/* print Reson 7k system event (record 7051) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -4665,7 +5784,12 @@ int mbsys_reson7k_print_pitch(int verbose, s7kr_pitch *pitch, int *error) {
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     pitch:                      %f\n", first, pitch->pitch);
+	fprintf(stderr, "%s     serial_number:              %llu\n", first, systemeventmessage->serial_number);
+	fprintf(stderr, "%s     event_id:                   %d\n", first, systemeventmessage->event_id);
+	fprintf(stderr, "%s     message_length:             %d\n", first, systemeventmessage->message_length);
+	fprintf(stderr, "%s     event_identifier:           %d\n", first, systemeventmessage->event_identifier);
+	fprintf(stderr, "%s     message_alloc:              %d\n", first, systemeventmessage->message_alloc);
+	fprintf(stderr, "%s     message:                    %s\n", first, systemeventmessage->message);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -4680,8 +5804,8 @@ int mbsys_reson7k_print_pitch(int verbose, s7kr_pitch *pitch, int *error) {
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_soundvelocity(int verbose, s7kr_soundvelocity *soundvelocity, int *error) {
-	char *function_name = "mbsys_reson7k_print_soundvelocity";
+int mbsys_reson7k_print_subsystem(int verbose, s7kr_subsystem *subsystem, int *error) {
+	char *function_name = "mbsys_reson7k_print_subsystem";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
@@ -4693,13 +5817,10 @@ int mbsys_reson7k_print_soundvelocity(int verbose, s7kr_soundvelocity *soundvelo
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       soundvelocity:     %p\n", (void *)soundvelocity);
+		fprintf(stderr, "dbg2       subsystem:         %p\n", (void *)subsystem);
 	}
 
-	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &soundvelocity->header, error);
-
-	/* print Reson 7k Sound Velocity (record 7610) */
+	/* print Reson 7k subsystem structure */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -4707,7 +5828,8 @@ int mbsys_reson7k_print_soundvelocity(int verbose, s7kr_soundvelocity *soundvelo
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     soundvelocity:              %f\n", first, soundvelocity->soundvelocity);
+	fprintf(stderr, "%s     device_identifier:          %d\n", first, subsystem->device_identifier);
+	fprintf(stderr, "%s     system_enumerator:          %d\n", first, subsystem->system_enumerator);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -4722,12 +5844,13 @@ int mbsys_reson7k_print_soundvelocity(int verbose, s7kr_soundvelocity *soundvelo
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_absorptionloss(int verbose, s7kr_absorptionloss *absorptionloss, int *error) {
-	char *function_name = "mbsys_reson7k_print_absorptionloss";
+int mbsys_reson7k_print_fileheader(int verbose, s7kr_fileheader *fileheader, int *error) {
+	char *function_name = "mbsys_reson7k_print_fileheader";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
+	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -4735,13 +5858,13 @@ int mbsys_reson7k_print_absorptionloss(int verbose, s7kr_absorptionloss *absorpt
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       absorptionloss:    %p\n", (void *)absorptionloss);
+		fprintf(stderr, "dbg2       fileheader:        %p\n", (void *)fileheader);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &absorptionloss->header, error);
+	mbsys_reson7k_print_header(verbose, &fileheader->header, error);
 
-	/* print Reson 7k Absorption Loss (record 7611) */
+	/* print Reson 7k system event (record 7051) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -4749,7 +5872,21 @@ int mbsys_reson7k_print_absorptionloss(int verbose, s7kr_absorptionloss *absorpt
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     absorptionloss:             %f\n", first, absorptionloss->absorptionloss);
+	fprintf(stderr, "%s     file_identifier:            0x", first);
+	for (i = 0; i < 16; i++)
+		fprintf(stderr, "%hhx", fileheader->file_identifier[i]);
+	fprintf(stderr, "\n");
+	fprintf(stderr, "%s     version:                    %d\n", first, fileheader->version);
+	fprintf(stderr, "%s     reserved:                   %d\n", first, fileheader->reserved);
+	fprintf(stderr, "%s     session_identifier:         %s\n", first, fileheader->session_identifier);
+	fprintf(stderr, "%s     record_data_size:           %d\n", first, fileheader->record_data_size);
+	fprintf(stderr, "%s     number_subsystems:          %d\n", first, fileheader->number_subsystems);
+	fprintf(stderr, "%s     recording_name:             %s\n", first, fileheader->recording_name);
+	fprintf(stderr, "%s     recording_version:          %s\n", first, fileheader->recording_version);
+	fprintf(stderr, "%s     user_defined_name:          %s\n", first, fileheader->user_defined_name);
+	fprintf(stderr, "%s     notes:                      %s\n", first, fileheader->notes);
+	for (i = 0; i < fileheader->number_subsystems; i++)
+		mbsys_reson7k_print_subsystem(verbose, &fileheader->subsystem[i], error);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -4764,12 +5901,13 @@ int mbsys_reson7k_print_absorptionloss(int verbose, s7kr_absorptionloss *absorpt
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_print_spreadingloss(int verbose, s7kr_spreadingloss *spreadingloss, int *error) {
-	char *function_name = "mbsys_reson7k_print_spreadingloss";
+int mbsys_reson7k_print_remotecontrolsettings(int verbose, s7kr_remotecontrolsettings *remotecontrolsettings, int *error) {
+	char *function_name = "mbsys_reson7k_print_remotecontrolsettings";
 	int status = MB_SUCCESS;
 	char *debug_str = "dbg2  ";
 	char *nodebug_str = "  ";
 	char *first;
+	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -4777,13 +5915,13 @@ int mbsys_reson7k_print_spreadingloss(int verbose, s7kr_spreadingloss *spreading
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       spreadingloss:     %p\n", (void *)spreadingloss);
+		fprintf(stderr, "dbg2       remotecontrolsettings:  %p\n", (void *)remotecontrolsettings);
 	}
 
 	/* print Reson 7k data record header information */
-	mbsys_reson7k_print_header(verbose, &spreadingloss->header, error);
+	mbsys_reson7k_print_header(verbose, &remotecontrolsettings->header, error);
 
-	/* print Reson 7k Spreading Loss (record 7611) */
+	/* print Reson 7k remote control sonar settings (record 7503) */
 	if (verbose >= 2)
 		first = debug_str;
 	else {
@@ -4791,7 +5929,58 @@ int mbsys_reson7k_print_spreadingloss(int verbose, s7kr_spreadingloss *spreading
 		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
 	fprintf(stderr, "%sStructure Contents:\n", first);
-	fprintf(stderr, "%s     spreadingloss:              %f\n", first, spreadingloss->spreadingloss);
+	fprintf(stderr, "%s     serial_number:              %llu\n", first, remotecontrolsettings->serial_number);
+	fprintf(stderr, "%s     ping_number:                %u\n", first, remotecontrolsettings->ping_number);
+	fprintf(stderr, "%s     frequency:                  %f\n", first, remotecontrolsettings->frequency);
+	fprintf(stderr, "%s     sample_rate:                %f\n", first, remotecontrolsettings->sample_rate);
+	fprintf(stderr, "%s     receiver_bandwidth:         %f\n", first, remotecontrolsettings->receiver_bandwidth);
+	fprintf(stderr, "%s     pulse_width:                %f\n", first, remotecontrolsettings->pulse_width);
+	fprintf(stderr, "%s     pulse_type:                 %d\n", first, remotecontrolsettings->pulse_type);
+	fprintf(stderr, "%s     pulse_envelope:             %d\n", first, remotecontrolsettings->pulse_envelope);
+	fprintf(stderr, "%s     pulse_envelope_par:         %f\n", first, remotecontrolsettings->pulse_envelope_par);
+	fprintf(stderr, "%s     pulse_reserved:             %d\n", first, remotecontrolsettings->pulse_reserved);
+	fprintf(stderr, "%s     max_ping_rate:              %f\n", first, remotecontrolsettings->max_ping_rate);
+	fprintf(stderr, "%s     ping_period:                %f\n", first, remotecontrolsettings->ping_period);
+	fprintf(stderr, "%s     range_selection:            %f\n", first, remotecontrolsettings->range_selection);
+	fprintf(stderr, "%s     power_selection:            %f\n", first, remotecontrolsettings->power_selection);
+	fprintf(stderr, "%s     gain_selection:             %f\n", first, remotecontrolsettings->gain_selection);
+	fprintf(stderr, "%s     control_flags:              %d\n", first, remotecontrolsettings->control_flags);
+	fprintf(stderr, "%s     projector_magic_no:         %d\n", first, remotecontrolsettings->projector_magic_no);
+	fprintf(stderr, "%s     steering_vertical:          %f\n", first, remotecontrolsettings->steering_vertical);
+	fprintf(stderr, "%s     steering_horizontal:        %f\n", first, remotecontrolsettings->steering_horizontal);
+	fprintf(stderr, "%s     beamwidth_vertical:         %f\n", first, remotecontrolsettings->beamwidth_vertical);
+	fprintf(stderr, "%s     beamwidth_horizontal:       %f\n", first, remotecontrolsettings->beamwidth_horizontal);
+	fprintf(stderr, "%s     focal_point:                %f\n", first, remotecontrolsettings->focal_point);
+	fprintf(stderr, "%s     projector_weighting:        %d\n", first, remotecontrolsettings->projector_weighting);
+	fprintf(stderr, "%s     projector_weighting_par:    %f\n", first, remotecontrolsettings->projector_weighting_par);
+	fprintf(stderr, "%s     transmit_flags:             %d\n", first, remotecontrolsettings->transmit_flags);
+	fprintf(stderr, "%s     hydrophone_magic_no:        %d\n", first, remotecontrolsettings->hydrophone_magic_no);
+	fprintf(stderr, "%s     receive_weighting:          %d\n", first, remotecontrolsettings->receive_weighting);
+	fprintf(stderr, "%s     receive_weighting_par:      %f\n", first, remotecontrolsettings->receive_weighting_par);
+	fprintf(stderr, "%s     receive_flags:              %d\n", first, remotecontrolsettings->receive_flags);
+	fprintf(stderr, "%s     range_minimum:              %f\n", first, remotecontrolsettings->range_minimum);
+	fprintf(stderr, "%s     range_maximum:              %f\n", first, remotecontrolsettings->range_maximum);
+	fprintf(stderr, "%s     depth_minimum:              %f\n", first, remotecontrolsettings->depth_minimum);
+	fprintf(stderr, "%s     depth_maximum:              %f\n", first, remotecontrolsettings->depth_maximum);
+	fprintf(stderr, "%s     absorption:                 %f\n", first, remotecontrolsettings->absorption);
+	fprintf(stderr, "%s     sound_velocity:             %f\n", first, remotecontrolsettings->sound_velocity);
+	fprintf(stderr, "%s     spreading:                  %f\n", first, remotecontrolsettings->spreading);
+	fprintf(stderr, "%s     reserved:                   %d\n", first, remotecontrolsettings->reserved);
+	fprintf(stderr, "%s     tx_offset_x:                %f\n", first, remotecontrolsettings->tx_offset_x);
+	fprintf(stderr, "%s     tx_offset_y:                %f\n", first, remotecontrolsettings->tx_offset_y);
+	fprintf(stderr, "%s     tx_offset_z:                %f\n", first, remotecontrolsettings->tx_offset_z);
+	fprintf(stderr, "%s     head_tilt_x:                %f\n", first, remotecontrolsettings->head_tilt_x);
+	fprintf(stderr, "%s     head_tilt_y:                %f\n", first, remotecontrolsettings->head_tilt_y);
+	fprintf(stderr, "%s     head_tilt_z:                %f\n", first, remotecontrolsettings->head_tilt_z);
+	fprintf(stderr, "%s     ping_on_off:                %d\n", first, remotecontrolsettings->ping_on_off);
+	fprintf(stderr, "%s     data_sample_types:          %d\n", first, remotecontrolsettings->data_sample_types);
+	fprintf(stderr, "%s     projector_orientation:      %d\n", first, remotecontrolsettings->projector_orientation);
+	fprintf(stderr, "%s     beam_angle_mode:            %d\n", first, remotecontrolsettings->beam_angle_mode);
+	fprintf(stderr, "%s     r7kcenter_mode:             %d\n", first, remotecontrolsettings->r7kcenter_mode);
+	fprintf(stderr, "%s     gate_depth_min:             %f\n", first, remotecontrolsettings->gate_depth_min);
+	fprintf(stderr, "%s     gate_depth_max:             %f\n", first, remotecontrolsettings->gate_depth_max);
+	for (i = 0; i < 35; i++)
+		fprintf(stderr, "%s     reserved2[i]:               %d\n", first, remotecontrolsettings->reserved2[i]);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -4806,56 +5995,41 @@ int mbsys_reson7k_print_spreadingloss(int verbose, s7kr_spreadingloss *spreading
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_dimensions(int verbose, void *mbio_ptr, void *store_ptr, int *kind, int *nbath, int *namp, int *nss,
-                             int *error) {
-	char *function_name = "mbsys_reson7k_dimensions";
+int mbsys_reson7k_print_reserved(int verbose, s7kr_reserved *reserved, int *error) {
+	char *function_name = "mbsys_reson7k_print_reserved";
 	int status = MB_SUCCESS;
-	struct mb_io_struct *mb_io_ptr;
-	struct mbsys_reson7k_struct *store;
-	s7kr_bathymetry *bathymetry;
+	char *debug_str = "dbg2  ";
+	char *nodebug_str = "  ";
+	char *first;
+	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
-		fprintf(stderr, "dbg2       mb_ptr:     %p\n", (void *)mbio_ptr);
-		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
+		fprintf(stderr, "dbg2       reserved:          %p\n", (void *)reserved);
 	}
 
-	/* get mbio descriptor */
-	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
-
-	/* get data structure pointer */
-	store = (struct mbsys_reson7k_struct *)store_ptr;
-
-	/* get data kind */
-	*kind = store->kind;
+	/* print Reson 7k data record header information */
+	mbsys_reson7k_print_header(verbose, &reserved->header, error);
 
-	/* extract data from structure */
-	if (*kind == MB_DATA_DATA) {
-		/* get beam and pixel numbers */
-		bathymetry = (s7kr_bathymetry *)&store->bathymetry;
-		*nbath = bathymetry->number_beams;
-		*namp = *nbath;
-		*nss = 0;
-	}
+	/* print Reson 7k Reserved (well, unknown really...) (record 7504) */
+	if (verbose >= 2)
+		first = debug_str;
 	else {
-		/* get beam and pixel numbers */
-		*nbath = 0;
-		*namp = 0;
-		*nss = 0;
+		first = nodebug_str;
+		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
 	}
+	fprintf(stderr, "%sStructure Contents:\n", first);
+	for (i = 0; i < R7KHDRSIZE_7kReserved; i++)
+		fprintf(stderr, "%s     reserved[%d]:               %u\n", first, i, reserved->reserved[i]);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       kind:       %d\n", *kind);
-		fprintf(stderr, "dbg2       nbath:      %d\n", *nbath);
-		fprintf(stderr, "dbg2        namp:      %d\n", *namp);
-		fprintf(stderr, "dbg2        nss:       %d\n", *nss);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:     %d\n", status);
@@ -4865,37 +6039,39 @@ int mbsys_reson7k_dimensions(int verbose, void *mbio_ptr, void *store_ptr, int *
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_pingnumber(int verbose, void *mbio_ptr, int *pingnumber, int *error) {
-	char *function_name = "mbsys_reson7k_pingnumber";
+int mbsys_reson7k_print_roll(int verbose, s7kr_roll *roll, int *error) {
+	char *function_name = "mbsys_reson7k_print_roll";
 	int status = MB_SUCCESS;
-	struct mb_io_struct *mb_io_ptr;
-	struct mbsys_reson7k_struct *store;
-	s7kr_bathymetry *bathymetry;
+	char *debug_str = "dbg2  ";
+	char *nodebug_str = "  ";
+	char *first;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
-		fprintf(stderr, "dbg2       mb_ptr:     %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
+		fprintf(stderr, "dbg2       roll:              %p\n", (void *)roll);
 	}
 
-	/* get mbio descriptor */
-	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
-
-	/* get data structure pointer */
-	store = (struct mbsys_reson7k_struct *)mb_io_ptr->store_data;
+	/* print Reson 7k data record header information */
+	mbsys_reson7k_print_header(verbose, &roll->header, error);
 
-	/* extract data from structure */
-	bathymetry = (s7kr_bathymetry *)&store->bathymetry;
-	*pingnumber = bathymetry->ping_number;
+	/* print Reson 7k Roll (record 7600) */
+	if (verbose >= 2)
+		first = debug_str;
+	else {
+		first = nodebug_str;
+		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
+	}
+	fprintf(stderr, "%sStructure Contents:\n", first);
+	fprintf(stderr, "%s     roll:                       %f\n", first, roll->roll);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       pingnumber: %d\n", *pingnumber);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:     %d\n", status);
@@ -4905,11 +6081,181 @@ int mbsys_reson7k_pingnumber(int verbose, void *mbio_ptr, int *pingnumber, int *
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_sonartype(int verbose, void *mbio_ptr, void *store_ptr, int *sonartype, int *error) {
-	char *function_name = "mbsys_reson7k_sonartype";
+int mbsys_reson7k_print_pitch(int verbose, s7kr_pitch *pitch, int *error) {
+	char *function_name = "mbsys_reson7k_print_pitch";
+	int status = MB_SUCCESS;
+	char *debug_str = "dbg2  ";
+	char *nodebug_str = "  ";
+	char *first;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
+		fprintf(stderr, "dbg2       pitch:             %p\n", (void *)pitch);
+	}
+
+	/* print Reson 7k data record header information */
+	mbsys_reson7k_print_header(verbose, &pitch->header, error);
+
+	/* print Reson 7k Pitch (record 7601) */
+	if (verbose >= 2)
+		first = debug_str;
+	else {
+		first = nodebug_str;
+		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
+	}
+	fprintf(stderr, "%sStructure Contents:\n", first);
+	fprintf(stderr, "%s     pitch:                      %f\n", first, pitch->pitch);
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_print_soundvelocity(int verbose, s7kr_soundvelocity *soundvelocity, int *error) {
+	char *function_name = "mbsys_reson7k_print_soundvelocity";
+	int status = MB_SUCCESS;
+	char *debug_str = "dbg2  ";
+	char *nodebug_str = "  ";
+	char *first;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
+		fprintf(stderr, "dbg2       soundvelocity:     %p\n", (void *)soundvelocity);
+	}
+
+	/* print Reson 7k data record header information */
+	mbsys_reson7k_print_header(verbose, &soundvelocity->header, error);
+
+	/* print Reson 7k Sound Velocity (record 7610) */
+	if (verbose >= 2)
+		first = debug_str;
+	else {
+		first = nodebug_str;
+		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
+	}
+	fprintf(stderr, "%sStructure Contents:\n", first);
+	fprintf(stderr, "%s     soundvelocity:              %f\n", first, soundvelocity->soundvelocity);
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_print_absorptionloss(int verbose, s7kr_absorptionloss *absorptionloss, int *error) {
+	char *function_name = "mbsys_reson7k_print_absorptionloss";
+	int status = MB_SUCCESS;
+	char *debug_str = "dbg2  ";
+	char *nodebug_str = "  ";
+	char *first;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
+		fprintf(stderr, "dbg2       absorptionloss:    %p\n", (void *)absorptionloss);
+	}
+
+	/* print Reson 7k data record header information */
+	mbsys_reson7k_print_header(verbose, &absorptionloss->header, error);
+
+	/* print Reson 7k Absorption Loss (record 7611) */
+	if (verbose >= 2)
+		first = debug_str;
+	else {
+		first = nodebug_str;
+		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
+	}
+	fprintf(stderr, "%sStructure Contents:\n", first);
+	fprintf(stderr, "%s     absorptionloss:             %f\n", first, absorptionloss->absorptionloss);
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_print_spreadingloss(int verbose, s7kr_spreadingloss *spreadingloss, int *error) {
+	char *function_name = "mbsys_reson7k_print_spreadingloss";
+	int status = MB_SUCCESS;
+	char *debug_str = "dbg2  ";
+	char *nodebug_str = "  ";
+	char *first;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
+		fprintf(stderr, "dbg2       spreadingloss:     %p\n", (void *)spreadingloss);
+	}
+
+	/* print Reson 7k data record header information */
+	mbsys_reson7k_print_header(verbose, &spreadingloss->header, error);
+
+	/* print Reson 7k Spreading Loss (record 7611) */
+	if (verbose >= 2)
+		first = debug_str;
+	else {
+		first = nodebug_str;
+		fprintf(stderr, "\n%sMBIO function <%s> called\n", first, function_name);
+	}
+	fprintf(stderr, "%sStructure Contents:\n", first);
+	fprintf(stderr, "%s     spreadingloss:              %f\n", first, spreadingloss->spreadingloss);
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_dimensions(int verbose, void *mbio_ptr, void *store_ptr, int *kind, int *nbath, int *namp, int *nss,
+                             int *error) {
+	char *function_name = "mbsys_reson7k_dimensions";
 	int status = MB_SUCCESS;
 	struct mb_io_struct *mb_io_ptr;
 	struct mbsys_reson7k_struct *store;
+	s7kr_bathymetry *bathymetry;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -4927,14 +6273,32 @@ int mbsys_reson7k_sonartype(int verbose, void *mbio_ptr, void *store_ptr, int *s
 	/* get data structure pointer */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
 
-	/* get sonar type */
-	*sonartype = MB_TOPOGRAPHY_TYPE_MULTIBEAM;
+	/* get data kind */
+	*kind = store->kind;
+
+	/* extract data from structure */
+	if (*kind == MB_DATA_DATA) {
+		/* get beam and pixel numbers */
+		bathymetry = (s7kr_bathymetry *)&store->bathymetry;
+		*nbath = bathymetry->number_beams;
+		*namp = *nbath;
+		*nss = 0;
+	}
+	else {
+		/* get beam and pixel numbers */
+		*nbath = 0;
+		*namp = 0;
+		*nss = 0;
+	}
 
 	/* print output debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       sonartype:  %d\n", *sonartype);
+		fprintf(stderr, "dbg2       kind:       %d\n", *kind);
+		fprintf(stderr, "dbg2       nbath:      %d\n", *nbath);
+		fprintf(stderr, "dbg2        namp:      %d\n", *namp);
+		fprintf(stderr, "dbg2        nss:       %d\n", *nss);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:     %d\n", status);
@@ -4944,8 +6308,48 @@ int mbsys_reson7k_sonartype(int verbose, void *mbio_ptr, void *store_ptr, int *s
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_sidescantype(int verbose, void *mbio_ptr, void *store_ptr, int *ss_type, int *error) {
-	char *function_name = "mbsys_reson7k_sidescantype";
+int mbsys_reson7k_pingnumber(int verbose, void *mbio_ptr, int *pingnumber, int *error) {
+	char *function_name = "mbsys_reson7k_pingnumber";
+	int status = MB_SUCCESS;
+	struct mb_io_struct *mb_io_ptr;
+	struct mbsys_reson7k_struct *store;
+	s7kr_bathymetry *bathymetry;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mb_ptr:     %p\n", (void *)mbio_ptr);
+	}
+
+	/* get mbio descriptor */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+
+	/* get data structure pointer */
+	store = (struct mbsys_reson7k_struct *)mb_io_ptr->store_data;
+
+	/* extract data from structure */
+	bathymetry = (s7kr_bathymetry *)&store->bathymetry;
+	*pingnumber = bathymetry->ping_number;
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       pingnumber: %d\n", *pingnumber);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_sonartype(int verbose, void *mbio_ptr, void *store_ptr, int *sonartype, int *error) {
+	char *function_name = "mbsys_reson7k_sonartype";
 	int status = MB_SUCCESS;
 	struct mb_io_struct *mb_io_ptr;
 	struct mbsys_reson7k_struct *store;
@@ -4966,14 +6370,14 @@ int mbsys_reson7k_sidescantype(int verbose, void *mbio_ptr, void *store_ptr, int
 	/* get data structure pointer */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
 
-	/* get sidescan type */
-	*ss_type = MB_SIDESCAN_LINEAR;
+	/* get sonar type */
+	*sonartype = MB_TOPOGRAPHY_TYPE_MULTIBEAM;
 
 	/* print output debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       ss_type:    %d\n", *ss_type);
+		fprintf(stderr, "dbg2       sonartype:  %d\n", *sonartype);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:     %d\n", status);
@@ -4983,18 +6387,57 @@ int mbsys_reson7k_sidescantype(int verbose, void *mbio_ptr, void *store_ptr, int
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_preprocess(int verbose,     /* in: verbosity level set on command line 0..N */
-                             void *mbio_ptr,  /* in: see mb_io.h:/^struct mb_io_struct/ */
-                             void *store_ptr, /* in: see mbsys_reson7k.h:/^struct mbsys_reson7k_struct/ */
-                             void *platform_ptr, void *preprocess_pars_ptr, int *error) {
-	char *function_name = "mbsys_reson7k_preprocess";
+int mbsys_reson7k_sidescantype(int verbose, void *mbio_ptr, void *store_ptr, int *ss_type, int *error) {
+	char *function_name = "mbsys_reson7k_sidescantype";
 	int status = MB_SUCCESS;
 	struct mb_io_struct *mb_io_ptr;
 	struct mbsys_reson7k_struct *store;
-	struct mb_platform_struct *platform;
-	struct mb_preprocess_struct *pars;
 
-	/* data structure pointers */
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mb_ptr:     %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+	}
+
+	/* get mbio descriptor */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+
+	/* get data structure pointer */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+
+	/* get sidescan type */
+	*ss_type = MB_SIDESCAN_LINEAR;
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       ss_type:    %d\n", *ss_type);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_preprocess(int verbose,     /* in: verbosity level set on command line 0..N */
+                             void *mbio_ptr,  /* in: see mb_io.h:/^struct mb_io_struct/ */
+                             void *store_ptr, /* in: see mbsys_reson7k.h:/^struct mbsys_reson7k_struct/ */
+                             void *platform_ptr, void *preprocess_pars_ptr, int *error) {
+	char *function_name = "mbsys_reson7k_preprocess";
+	int status = MB_SUCCESS;
+	struct mb_io_struct *mb_io_ptr;
+	struct mbsys_reson7k_struct *store;
+	struct mb_platform_struct *platform;
+	struct mb_preprocess_struct *pars;
+
+	/* data structure pointers */
 	s7k_header *header;
 	// s7kr_reference			*reference;
 	// s7kr_sensoruncal		*sensoruncal;
@@ -5039,6 +6482,8 @@ int mbsys_reson7k_preprocess(int verbose,     /* in: verbosity level set on comm
 	// s7kr_fileheader			*fileheader;
 	// s7kr_installation		*installation;
 	s7kr_remotecontrolsettings *remotecontrolsettings;
+	struct mbsys_reson7k_struct *ostore;
+	s7k_beamattitude *beamattitude;
 
 	/* control parameters */
 	int ss_source = R7KRECID_None;
@@ -5054,13 +6499,8 @@ int mbsys_reson7k_preprocess(int verbose,     /* in: verbosity level set on comm
 	/* variables for beam angle calculation */
 	mb_3D_orientation tx_align;
 	mb_3D_orientation tx_orientation;
-	double tx_steer;
 	mb_3D_orientation rx_align;
-	mb_3D_orientation rx_orientation;
-	double rx_steer;
 	double reference_heading;
-	double beamAzimuth;
-	double beamDepression;
 
 	s7k_time s7kTime;
 	int time_i[7];
@@ -5072,27 +6512,27 @@ int mbsys_reson7k_preprocess(int verbose,     /* in: verbosity level set on comm
 	double altitude = 0.0;
 	double sensordepth = 0.0;
 	double heading = 0.0;
-	double beamheading, beamheadingr;
 	double roll = 0.0;
-	double rollr, beamroll, beamrollr;
+	double rollr;
 	double pitch = 0.0;
-	double pitchr, beampitch, beampitchr;
+	double pitchr;
 	double heave = 0.0;
-	double beamheave;
 	double soundspeed;
 	double soundspeednew;
 	double soundspeedsnellfactor = 1.0;
 	double theta, phi;
 	double rr, xx, zz;
 	double mtodeglon, mtodeglat, headingx, headingy;
-	double dx, dy, dt;
-	int jnav = 0;
-	int jsensordepth = 0;
+	double values[MBSYS_RESON7K_TSERIES_FIELDS];
+	s7k_tseries *tseries;
 	int jheading = 0;
-	int jaltitude = 0;
 	int jattitude = 0;
 	int jsoundspeed = 0;
-	int j1, j2;
+	int nbeams;
+#ifdef MBSYS_RESON7K_CHECK_BEAUDOIN
+	int mismatch;
+	double diffmax;
+#endif
 	int interp_status = MB_SUCCESS;
 	int interp_error = MB_ERROR_NO_ERROR;
 	double *pixel_size;
@@ -5128,6 +6568,7 @@ int mbsys_reson7k_preprocess(int verbose,     /* in: verbosity level set on comm
 	store = (struct mbsys_reson7k_struct *)store_ptr;
 	platform = (struct mb_platform_struct *)platform_ptr;
 	pars = (struct mb_preprocess_struct *)preprocess_pars_ptr;
+	store->makess_source = R7KRECID_None;
 
 	/* get saved values */
 	pixel_size = (double *)&mb_io_ptr->saved1;
@@ -5219,8 +6660,14 @@ int mbsys_reson7k_preprocess(int verbose,     /* in: verbosity level set on comm
 		image = &(store->image);
 		bathymetry = &(store->bathymetry);
 
+		/* the beam arrays are recalculated in place, so copies shared with
+		    other stores must first become this store's own */
+		status = mbsys_reson7k_unshare_payload(verbose, store_ptr, R7KSHARE_Bathymetry, MB_YES, error);
+		if (status == MB_SUCCESS)
+			status = mbsys_reson7k_unshare_payload(verbose, store_ptr, R7KSHARE_BeamGeometry, MB_YES, error);
+
 		/* print out record headers */
-		if (store->read_volatilesettings == MB_YES) {
+		if (store->read_mask & R7KREAD_VolatileSettings) {
 			header = &(volatilesettings->header);
 			time_j[0] = header->s7kTime.Year;
 			time_j[1] = header->s7kTime.Day;
@@ -5234,7 +6681,7 @@ int mbsys_reson7k_preprocess(int verbose,     /* in: verbosity level set on comm
 				        "R7KRECID_7kVolatileSonarSettings:  7Ktime(%4.4d/%2.2d/%2.2d %2.2d:%2.2d:%2.2d.%6.6d) record_number:%d\n",
 				        time_i[0], time_i[1], time_i[2], time_i[3], time_i[4], time_i[5], time_i[6], header->RecordNumber);
 		}
-		if (store->read_matchfilter == MB_YES) {
+		if (store->read_mask & R7KREAD_MatchFilter) {
 			header = &(matchfilter->header);
 			time_j[0] = header->s7kTime.Year;
 			time_j[1] = header->s7kTime.Day;
@@ -5248,7 +6695,7 @@ int mbsys_reson7k_preprocess(int verbose,     /* in: verbosity level set on comm
 				        "R7KRECID_7kMatchFilter:            7Ktime(%4.4d/%2.2d/%2.2d %2.2d:%2.2d:%2.2d.%6.6d) record_number:%d\n",
 				        time_i[0], time_i[1], time_i[2], time_i[3], time_i[4], time_i[5], time_i[6], header->RecordNumber);
 		}
-		if (store->read_beamgeometry == MB_YES) {
+		if (store->read_mask & R7KREAD_BeamGeometry) {
 			header = &(beamgeometry->header);
 			time_j[0] = header->s7kTime.Year;
 			time_j[1] = header->s7kTime.Day;
@@ -5264,7 +6711,7 @@ int mbsys_reson7k_preprocess(int verbose,     /* in: verbosity level set on comm
 				        time_i[0], time_i[1], time_i[2], time_i[3], time_i[4], time_i[5], time_i[6], header->RecordNumber,
 				        beamgeometry->number_beams);
 		}
-		if (store->read_remotecontrolsettings == MB_YES) {
+		if (store->read_mask & R7KREAD_RemoteControlSettings) {
 			header = &(remotecontrolsettings->header);
 			time_j[0] = header->s7kTime.Year;
 			time_j[1] = header->s7kTime.Day;
@@ -5278,7 +6725,7 @@ int mbsys_reson7k_preprocess(int verbose,     /* in: verbosity level set on comm
 				        "R7KRECID_7kremotecontrolsettings:  7Ktime(%4.4d/%2.2d/%2.2d %2.2d:%2.2d:%2.2d.%6.6d) record_number:%d\n",
 				        time_i[0], time_i[1], time_i[2], time_i[3], time_i[4], time_i[5], time_i[6], header->RecordNumber);
 		}
-		if (store->read_backscatter == MB_YES) {
+		if (store->read_mask & R7KREAD_Backscatter) {
 			header = &(backscatter->header);
 			time_j[0] = header->s7kTime.Year;
 			time_j[1] = header->s7kTime.Day;
@@ -5294,7 +6741,7 @@ int mbsys_reson7k_preprocess(int verbose,     /* in: verbosity level set on comm
 				        time_i[0], time_i[1], time_i[2], time_i[3], time_i[4], time_i[5], time_i[6], header->RecordNumber,
 				        backscatter->ping_number, backscatter->number_samples);
 		}
-		if (store->read_beam == MB_YES) {
+		if (store->read_mask & R7KREAD_Beam) {
 			header = &(beam->header);
 			time_j[0] = header->s7kTime.Year;
 			time_j[1] = header->s7kTime.Day;
@@ -5310,7 +6757,7 @@ int mbsys_reson7k_preprocess(int verbose,     /* in: verbosity level set on comm
 				        time_i[0], time_i[1], time_i[2], time_i[3], time_i[4], time_i[5], time_i[6], header->RecordNumber,
 				        beam->ping_number, beam->number_beams, beam->number_samples);
 		}
-		if (store->read_verticaldepth == MB_YES) {
+		if (store->read_mask & R7KREAD_VerticalDepth) {
 			header = &(verticaldepth->header);
 			time_j[0] = header->s7kTime.Year;
 			time_j[1] = header->s7kTime.Day;
@@ -5325,7 +6772,7 @@ int mbsys_reson7k_preprocess(int verbose,     /* in: verbosity level set on comm
 				        time_i[0], time_i[1], time_i[2], time_i[3], time_i[4], time_i[5], time_i[6], header->RecordNumber,
 				        verticaldepth->ping_number);
 		}
-		if (store->read_image == MB_YES) {
+		if (store->read_mask & R7KREAD_Image) {
 			header = &(image->header);
 			time_j[0] = header->s7kTime.Year;
 			time_j[1] = header->s7kTime.Day;
@@ -5341,11 +6788,14 @@ int mbsys_reson7k_preprocess(int verbose,     /* in: verbosity level set on comm
 				        time_i[0], time_i[1], time_i[2], time_i[3], time_i[4], time_i[5], time_i[6], header->RecordNumber,
 				        image->ping_number, image->width, image->height);
 		}
-		if (store->read_bathymetry != MB_YES) {
+		if (!(store->read_mask & R7KREAD_Bathymetry)) {
 			status = MB_FAILURE;
 			*error = MB_ERROR_IGNORE;
 		}
 		else {
+			/* the bathymetry record is always rewritten by preprocessing */
+			mbsys_reson7k_rawrecord_modified(verbose, store_ptr, R7KRECID_7kBathymetricData, error);
+
 			header = &(bathymetry->header);
 			time_j[0] = header->s7kTime.Year;
 			time_j[1] = header->s7kTime.Day;
@@ -5480,8 +6930,8 @@ int mbsys_reson7k_preprocess(int verbose,     /* in: verbosity level set on comm
 			/* if requested ignore water column data
 			 * (will not be included in any output file) */
 			if (pars->ignore_water_column == MB_YES
-				&& store->read_v2beamformed == MB_YES)
-				store->read_v2beamformed = MB_NO;
+				&& (store->read_mask & R7KREAD_V2Beamformed))
+				store->read_mask &= ~R7KREAD_V2Beamformed;
 
 			/*--------------------------------------------------------------*/
 			/* change timestamp if indicated */
@@ -5502,72 +6952,114 @@ int mbsys_reson7k_preprocess(int verbose,     /* in: verbosity level set on comm
 				        function_name, time_i[0], time_i[1], time_i[2], time_i[3], time_i[4], time_i[5], time_i[6],
 				        bathymetry->ping_number);
 
-				/* apply the timestamp to all of the relevant data records */
-				if (store->read_volatilesettings == MB_YES)
+				/* apply the timestamp to all of the relevant data records, which are
+				    then no longer the records as read */
+				if (store->read_mask & R7KREAD_VolatileSettings) {
 					store->volatilesettings.header.s7kTime = s7kTime;
-				if (store->read_matchfilter == MB_YES)
+					mbsys_reson7k_rawrecord_modified(verbose, store_ptr, R7KRECID_7kVolatileSonarSettings, error);
+				}
+				if (store->read_mask & R7KREAD_MatchFilter) {
 					store->matchfilter.header.s7kTime = s7kTime;
-				if (store->read_beamgeometry == MB_YES)
+					mbsys_reson7k_rawrecord_modified(verbose, store_ptr, R7KRECID_7kMatchFilter, error);
+				}
+				if (store->read_mask & R7KREAD_BeamGeometry) {
 					store->beamgeometry.header.s7kTime = s7kTime;
-				if (store->read_remotecontrolsettings == MB_YES)
+					mbsys_reson7k_rawrecord_modified(verbose, store_ptr, R7KRECID_7kBeamGeometry, error);
+				}
+				if (store->read_mask & R7KREAD_RemoteControlSettings) {
 					store->remotecontrolsettings.header.s7kTime = s7kTime;
-				if (store->read_bathymetry == MB_YES)
+					mbsys_reson7k_rawrecord_modified(verbose, store_ptr, R7KRECID_7kRemoteControlSonarSettings, error);
+				}
+				if (store->read_mask & R7KREAD_Bathymetry) {
 					store->bathymetry.header.s7kTime = s7kTime;
-				if (store->read_backscatter == MB_YES)
+					mbsys_reson7k_rawrecord_modified(verbose, store_ptr, R7KRECID_7kBathymetricData, error);
+				}
+				if (store->read_mask & R7KREAD_Backscatter) {
 					store->backscatter.header.s7kTime = s7kTime;
-				if (store->read_beam == MB_YES)
+					mbsys_reson7k_rawrecord_modified(verbose, store_ptr, R7KRECID_7kBackscatterImageData, error);
+				}
+				if (store->read_mask & R7KREAD_Beam) {
 					store->beam.header.s7kTime = s7kTime;
-				if (store->read_verticaldepth == MB_YES)
+					mbsys_reson7k_rawrecord_modified(verbose, store_ptr, R7KRECID_7kBeamData, error);
+				}
+				if (store->read_mask & R7KREAD_VerticalDepth) {
 					store->verticaldepth.header.s7kTime = s7kTime;
-				if (store->read_image == MB_YES)
+					mbsys_reson7k_rawrecord_modified(verbose, store_ptr, R7KRECID_7kVerticalDepth, error);
+				}
+				if (store->read_mask & R7KREAD_Image) {
 					store->image.header.s7kTime = s7kTime;
-				if (store->read_v2pingmotion == MB_YES)
+					mbsys_reson7k_rawrecord_modified(verbose, store_ptr, R7KRECID_7kImageData, error);
+				}
+				if (store->read_mask & R7KREAD_V2PingMotion) {
 					store->v2pingmotion.header.s7kTime = s7kTime;
-				if (store->read_v2detectionsetup == MB_YES)
+					mbsys_reson7k_rawrecord_modified(verbose, store_ptr, R7KRECID_7kV2PingMotion, error);
+				}
+				if (store->read_mask & R7KREAD_V2DetectionSetup) {
 					store->v2detectionsetup.header.s7kTime = s7kTime;
-				if (store->read_v2beamformed == MB_YES)
+					mbsys_reson7k_rawrecord_modified(verbose, store_ptr, R7KRECID_7kV2DetectionSetup, error);
+				}
+				if (store->read_mask & R7KREAD_V2Beamformed) {
 					store->v2beamformed.header.s7kTime = s7kTime;
-				if (store->read_v2detection == MB_YES)
+					mbsys_reson7k_rawrecord_modified(verbose, store_ptr, R7KRECID_7kV2BeamformedData, error);
+				}
+				if (store->read_mask & R7KREAD_V2Detection) {
 					store->v2detection.header.s7kTime = s7kTime;
-				if (store->read_v2rawdetection == MB_YES)
+					mbsys_reson7k_rawrecord_modified(verbose, store_ptr, R7KRECID_7kV2Detection, error);
+				}
+				if (store->read_mask & R7KREAD_V2RawDetection) {
 					store->v2rawdetection.header.s7kTime = s7kTime;
-				if (store->read_v2snippet == MB_YES)
+					mbsys_reson7k_rawrecord_modified(verbose, store_ptr, R7KRECID_7kV2RawDetection, error);
+				}
+				if (store->read_mask & R7KREAD_V2Snippet) {
 					store->v2snippet.header.s7kTime = s7kTime;
-				if (store->read_calibratedsnippet == MB_YES)
+					mbsys_reson7k_rawrecord_modified(verbose, store_ptr, R7KRECID_7kV2SnippetData, error);
+				}
+				if (store->read_mask & R7KREAD_CalibratedSnippet) {
 					store->calibratedsnippet.header.s7kTime = s7kTime;
-				if (store->read_processedsidescan == MB_YES)
+					mbsys_reson7k_rawrecord_modified(verbose, store_ptr, R7KRECID_7kCalibratedSnippetData, error);
+				}
+				if (store->read_mask & R7KREAD_ProcessedSidescan) {
 					store->processedsidescan.header.s7kTime = s7kTime;
+					mbsys_reson7k_rawrecord_modified(verbose, store_ptr, R7KRECID_ProcessedSidescan, error);
+				}
 			}
 
 			/*--------------------------------------------------------------*/
 			/* interpolate ancilliary values  */
 			/*--------------------------------------------------------------*/
-			interp_status = mb_linear_interp_longitude(verbose, pars->nav_time_d - 1, pars->nav_lon - 1, pars->n_nav, time_d,
-			                                           &navlon, &jnav, &interp_error);
-			interp_status = mb_linear_interp_latitude(verbose, pars->nav_time_d - 1, pars->nav_lat - 1, pars->n_nav, time_d,
-			                                          &navlat, &jnav, &interp_error);
-			interp_status = mb_linear_interp(verbose, pars->nav_time_d - 1, pars->nav_speed - 1, pars->n_nav, time_d, &speed,
-			                                 &jnav, &interp_error);
+			/* the series are held by the internal store of this mbio
+			    descriptor, copied once from the preprocessing parameters, and
+			    each keeps the bracket of the previous ping so that looking up
+			    pings in time order costs only a few comparisons */
+			ostore = (struct mbsys_reson7k_struct *)mb_io_ptr->store_data;
+			tseries = ostore->tseries_preprocess;
+			interp_status = mbsys_reson7k_preprocess_tseries(verbose, mbio_ptr, preprocess_pars_ptr, &interp_error);
+
+			/* interpolate navigation */
+			interp_status = mbsys_reson7k_tseries_interp(verbose, &tseries[MBSYS_RESON7K_TSERIES_NAV], time_d, values,
+			                                             &interp_error);
+			navlon = values[0];
+			navlat = values[1];
+			speed = values[2];
 
 			/* interpolate sensordepth */
-			interp_status = mb_linear_interp(verbose, pars->sensordepth_time_d - 1, pars->sensordepth_sensordepth - 1,
-			                                 pars->n_sensordepth, time_d, &sensordepth, &jsensordepth, &interp_error);
+			interp_status = mbsys_reson7k_tseries_interp(verbose, &tseries[MBSYS_RESON7K_TSERIES_SONARDEPTH], time_d,
+			                                             &sensordepth, &interp_error);
 
 			/* interpolate heading */
-			interp_status = mb_linear_interp_heading(verbose, pars->heading_time_d - 1, pars->heading_heading - 1,
-			                                         pars->n_heading, time_d, &heading, &jheading, &interp_error);
+			interp_status = mbsys_reson7k_tseries_interp(verbose, &tseries[MBSYS_RESON7K_TSERIES_HEADING], time_d, &heading,
+			                                             &interp_error);
 
 			/* interpolate altitude */
-			interp_status = mb_linear_interp(verbose, pars->altitude_time_d - 1, pars->altitude_altitude - 1, pars->n_altitude,
-			                                 time_d, &altitude, &jaltitude, &interp_error);
+			interp_status = mbsys_reson7k_tseries_interp(verbose, &tseries[MBSYS_RESON7K_TSERIES_ALTITUDE], time_d, &altitude,
+			                                             &interp_error);
 
 			/* interpolate attitude */
-			interp_status = mb_linear_interp(verbose, pars->attitude_time_d - 1, pars->attitude_roll - 1, pars->n_attitude,
-			                                 time_d, &roll, &jattitude, &interp_error);
-			interp_status = mb_linear_interp(verbose, pars->attitude_time_d - 1, pars->attitude_pitch - 1, pars->n_attitude,
-			                                 time_d, &pitch, &jattitude, &interp_error);
-			interp_status = mb_linear_interp(verbose, pars->attitude_time_d - 1, pars->attitude_heave - 1, pars->n_attitude,
-			                                 time_d, &heave, &jattitude, &interp_error);
+			interp_status = mbsys_reson7k_tseries_interp(verbose, &tseries[MBSYS_RESON7K_TSERIES_ATTITUDE], time_d, values,
+			                                             &interp_error);
+			roll = values[0];
+			pitch = values[1];
+			heave = values[2];
 
 			/* interpolate soundspeed */
 			interp_status = mb_linear_interp(verbose, pars->soundspeed_time_d - 1, pars->soundspeed_soundspeed - 1, pars->n_soundspeed,
@@ -5590,21 +7082,8 @@ int mbsys_reson7k_preprocess(int verbose,     /* in: verbosity level set on comm
 			headingy = cos(DTR * heading);
 
 			/* if a valid speed is not available calculate it */
-			if (interp_status == MB_SUCCESS && speed <= 0.0) {
-				if (jnav > 1) {
-					j1 = jnav - 2;
-					j2 = jnav - 1;
-				}
-				else {
-					j1 = jnav - 1;
-					j2 = jnav;
-				}
-				dx = (pars->nav_lon[j2] - pars->nav_lon[j1]) / mtodeglon;
-				dy = (pars->nav_lat[j2] - pars->nav_lat[j1]) / mtodeglat;
-				dt = (pars->nav_time_d[j2] - pars->nav_time_d[j1]);
-				if (dt > 0.0)
-					speed = sqrt(dx * dx + dy * dy) / dt;
-			}
+			if (interp_status == MB_SUCCESS && speed <= 0.0)
+				mbsys_reson7k_tseries_speed(verbose, &tseries[MBSYS_RESON7K_TSERIES_NAV], time_d, &speed, &interp_error);
 
 			/* if the optional data are not all available, this ping
 			    is not useful, and is discarded by setting
@@ -5623,30 +7102,13 @@ int mbsys_reson7k_preprocess(int verbose,     /* in: verbosity level set on comm
 				if (verbose >= 2) {
 					fprintf(stderr, "\ndbg2 Recalculating bathymetry in %s: 7k ping records read:\n", function_name);
 					fprintf(stderr, "dbg2      current_ping_number:           %d\n", store->current_ping_number);
-					fprintf(stderr, "dbg2      read_volatilesettings:         %d\n", store->read_volatilesettings);
-					fprintf(stderr, "dbg2      read_matchfilter:              %d\n", store->read_matchfilter);
-					fprintf(stderr, "dbg2      read_beamgeometry:             %d\n", store->read_beamgeometry);
-					fprintf(stderr, "dbg2      read_remotecontrolsettings:    %d\n", store->read_remotecontrolsettings);
-					fprintf(stderr, "dbg2      read_bathymetry:               %d\n", store->read_bathymetry);
-					fprintf(stderr, "dbg2      read_backscatter:              %d\n", store->read_backscatter);
-					fprintf(stderr, "dbg2      read_beam:                     %d\n", store->read_beam);
-					fprintf(stderr, "dbg2      read_verticaldepth:            %d\n", store->read_verticaldepth);
-					fprintf(stderr, "dbg2      read_tvg:                      %d\n", store->read_tvg);
-					fprintf(stderr, "dbg2      read_image:                    %d\n", store->read_image);
-					fprintf(stderr, "dbg2      read_v2pingmotion:             %d\n", store->read_v2pingmotion);
-					fprintf(stderr, "dbg2      read_v2detectionsetup:         %d\n", store->read_v2detectionsetup);
-					fprintf(stderr, "dbg2      read_v2beamformed:             %d\n", store->read_v2beamformed);
-					fprintf(stderr, "dbg2      read_v2detection:              %d\n", store->read_v2detection);
-					fprintf(stderr, "dbg2      read_v2rawdetection:           %d\n", store->read_v2rawdetection);
-					fprintf(stderr, "dbg2      read_v2snippet:                %d\n", store->read_v2snippet);
-					fprintf(stderr, "dbg2      read_calibratedsnippet:        %d\n", store->read_calibratedsnippet);
-					fprintf(stderr, "dbg2      read_processedsidescan:        %d\n", store->read_processedsidescan);
+					fprintf(stderr, "dbg2      read_mask:                     0x%5.5x\n", store->read_mask);
 				}
 
 				/* initialize all of the beams */
 				for (i = 0; i < bathymetry->number_beams; i++) {
-					if (store->read_v2rawdetection == MB_YES ||
-					    (store->read_v2detection == MB_YES && store->read_v2detectionsetup == MB_YES))
+					if ((store->read_mask & R7KREAD_V2RawDetection) ||
+					    ((store->read_mask & R7KREAD_V2Detection) && (store->read_mask & R7KREAD_V2DetectionSetup)))
 						bathymetry->quality[i] = 0;
 					bathymetry->depth[i] = 0.0;
 					bathymetry->acrosstrack[i] = 0.0;
@@ -5695,12 +7157,21 @@ int mbsys_reson7k_preprocess(int verbose,     /* in: verbosity level set on comm
 					}
 				}
 
+				/* any beam angle or sound speed changes alter the records as read */
+				if (kluge_zeroalongtrackangles == MB_YES || kluge_beampatternsnell == MB_YES
+					|| kluge_soundspeedsnell == MB_YES || pars->modify_soundspeed) {
+					mbsys_reson7k_rawrecord_modified(verbose, store_ptr, R7KRECID_7kVolatileSonarSettings, error);
+					mbsys_reson7k_rawrecord_modified(verbose, store_ptr, R7KRECID_7kBeamGeometry, error);
+					mbsys_reson7k_rawrecord_modified(verbose, store_ptr, R7KRECID_7kV2Detection, error);
+					mbsys_reson7k_rawrecord_modified(verbose, store_ptr, R7KRECID_7kV2RawDetection, error);
+				}
+
 				/* if requested apply kluge scaling of rx beam angles */
 				if (kluge_beampatternsnell == MB_YES) {
 					/*
 					 * v2rawdetection record
 					 */
-					if (store->read_v2rawdetection == MB_YES) {
+					if (store->read_mask & R7KREAD_V2RawDetection) {
 						for (i = 0; i < v2rawdetection->number_beams; i++) {
 							v2rawdetection->rx_angle[i]
 								= asin(MAX(-1.0, MIN(1.0, kluge_beampatternsnellfactor
@@ -5711,7 +7182,7 @@ int mbsys_reson7k_preprocess(int verbose,     /* in: verbosity level set on comm
 					/*
 					 * v2detection record with or without v2detectionsetup
 					 */
-					if (store->read_v2detection == MB_YES) {
+					if (store->read_mask & R7KREAD_V2Detection) {
 						for (i = 0; i < v2detection->number_beams; i++) {
 							v2detection->angle_x[i]
 								= asin(MAX(-1.0, MIN(1.0, kluge_beampatternsnellfactor
@@ -5722,7 +7193,7 @@ int mbsys_reson7k_preprocess(int verbose,     /* in: verbosity level set on comm
 					/*
 					 * beamgeometry record
 					 */
-					if (store->read_beamgeometry == MB_YES) {
+					if (store->read_mask & R7KREAD_BeamGeometry) {
 						for (i = 0; i < bathymetry->number_beams; i++) {
 							beamgeometry->angle_acrosstrack[i] =
 							    asin(MAX(-1.0, MIN(1.0, kluge_beampatternsnellfactor
@@ -5760,7 +7231,7 @@ int mbsys_reson7k_preprocess(int verbose,     /* in: verbosity level set on comm
 					/*
 					 * v2rawdetection record
 					 */
-					if (store->read_v2rawdetection == MB_YES) {
+					if (store->read_mask & R7KREAD_V2RawDetection) {
 						for (i = 0; i < v2rawdetection->number_beams; i++) {
 							v2rawdetection->rx_angle[i] =
 							    asin(MAX(-1.0, MIN(1.0, soundspeedsnellfactor
@@ -5771,7 +7242,7 @@ int mbsys_reson7k_preprocess(int verbose,     /* in: verbosity level set on comm
 					/*
 					 * v2detection record with or without v2detectionsetup
 					 */
-					if (store->read_v2detection == MB_YES) {
+					if (store->read_mask & R7KREAD_V2Detection) {
 						for (i = 0; i < v2detection->number_beams; i++) {
 							v2detection->angle_x[i]
 								= asin(MAX(-1.0, MIN(1.0, soundspeedsnellfactor
@@ -5782,7 +7253,7 @@ int mbsys_reson7k_preprocess(int verbose,     /* in: verbosity level set on comm
 					/*
 					 * beamgeometry record
 					 */
-					if (store->read_beamgeometry == MB_YES) {
+					if (store->read_mask & R7KREAD_BeamGeometry) {
 						for (i = 0; i < bathymetry->number_beams; i++) {
 							beamgeometry->angle_acrosstrack[i] =
 							    asin(MAX(-1.0, MIN(1.0, soundspeedsnellfactor
@@ -5800,327 +7271,161 @@ int mbsys_reson7k_preprocess(int verbose,     /* in: verbosity level set on comm
 					                                        &(rx_align.heading), &(rx_align.roll), &(rx_align.pitch), error);
 				}
 
-				/* loop over detections as available - the 7k format has used several
+				/* get the scratch arrays held by the internal store of this mbio
+				    handle, growing them if this ping has more beams than any before */
+				ostore = (struct mbsys_reson7k_struct *)mb_io_ptr->store_data;
+				beamattitude = &(ostore->beamattitude);
+				nbeams = bathymetry->number_beams;
+				if (store->read_mask & R7KREAD_V2RawDetection)
+					nbeams = MAX(nbeams, (int)v2rawdetection->number_beams);
+				if (store->read_mask & R7KREAD_V2Detection)
+					nbeams = MAX(nbeams, (int)v2detection->number_beams);
+				status = mbsys_reson7k_alloc_beamattitude(verbose, beamattitude, nbeams, error);
+
+				/* list the detections as available - the 7k format has used several
 				   different records over the years, so there are several different
-				   cases that must be handled */
+				   cases that must be handled. For each detection get the beam id,
+				   range, bottom return time and steering angles */
+				nbeams = 0;
 
 				/* case of v2rawdetection record */
-				if (store->read_v2rawdetection == MB_YES) {
-					for (j = 0; j < v2rawdetection->number_beams; j++) {
-						/* beam id */
+				if (store->read_mask & R7KREAD_V2RawDetection) {
+					for (j = 0; j < beamattitude->nalloc && j < v2rawdetection->number_beams; j++) {
 						i = v2rawdetection->beam_descriptor[j];
-
-						/* get range and quality */
 						bathymetry->range[i] = v2rawdetection->detection_point[j] / v2rawdetection->sampling_rate;
 						bathymetry->quality[i] = v2rawdetection->quality[j];
-
-						/* get roll at bottom return time for this beam */
-						interp_status =
-						    mb_linear_interp(verbose, pars->attitude_time_d - 1, pars->attitude_roll - 1, pars->n_attitude,
-						                     time_d + bathymetry->range[i], &beamroll, &jattitude, error);
-						beamrollr = DTR * beamroll;
-
-						/* get pitch at bottom return time for this beam */
-						interp_status =
-						    mb_linear_interp(verbose, pars->attitude_time_d - 1, pars->attitude_pitch - 1, pars->n_attitude,
-						                     time_d + bathymetry->range[i], &beampitch, &jattitude, error);
-						beampitchr = DTR * beampitch;
-
-						/* get heading at bottom return time for this beam */
-						interp_status = mb_linear_interp_heading(verbose, pars->heading_time_d - 1, pars->heading_heading - 1,
-						                                         pars->n_heading, time_d + bathymetry->range[i], &beamheading,
-						                                         &jheading, error);
-						beamheadingr = DTR * beamheading;
-
-						/* calculate beam angles for raytracing using Jon Beaudoin's code based on:
-						    Beaudoin, J., Hughes Clarke, J., and Bartlett, J. Application of
-						    Surface Sound Speed Measurements in Post-Processing for Multi-Sector
-						    Multibeam Echosounders : International Hydrographic Review, v.5, no.3,
-						    p.26-31.
-						    (http://www.omg.unb.ca/omg/papers/beaudoin_IHR_nov2004.pdf).
-						   note complexity if transducer arrays are reverse mounted, as determined
-						   by a mount heading angle of about 180 degrees rather than about 0 degrees.
-						   If a receive array or a transmit array are reverse mounted then:
-						    1) subtract 180 from the heading mount angle of the array
-						    2) flip the sign of the pitch and roll mount offsets of the array
-						    3) flip the sign of the beam steering angle from that array
-						        (reverse TX means flip sign of TX steer, reverse RX
-						        means flip sign of RX steer) */
-						tx_steer = RTD * v2rawdetection->tx_angle;
-						tx_orientation.roll = roll;
-						tx_orientation.pitch = pitch;
-						tx_orientation.heading = heading;
-						rx_steer = -RTD * v2rawdetection->rx_angle[j];
-						rx_orientation.roll = beamroll;
-						rx_orientation.pitch = beampitch;
-						rx_orientation.heading = beamheading;
-						reference_heading = heading;
-
-						status = mb_beaudoin(verbose, tx_align, tx_orientation, tx_steer, rx_align, rx_orientation, rx_steer,
-						                     reference_heading, &beamAzimuth, &beamDepression, error);
-						theta = 90.0 - beamDepression;
-						phi = 90.0 - beamAzimuth;
-						if (phi < 0.0)
-							phi += 360.0;
-
-						/* calculate bathymetry */
-						rr = 0.5 * soundspeed * bathymetry->range[i];
-						xx = rr * sin(DTR * theta);
-						zz = rr * cos(DTR * theta);
-						bathymetry->acrosstrack[i] = xx * cos(DTR * phi);
-						bathymetry->alongtrack[i] = xx * sin(DTR * phi);
-						bathymetry->depth[i] = zz + sensordepth - heave;
-						bathymetry->pointing_angle[i] = DTR * theta;
-						bathymetry->azimuth_angle[i] = DTR * phi;
-						// fprintf(stderr,"beam:%d time_d:%f heading:%f %f roll:%f %f pitch:%f %f theta:%f phi:%f bath:%f %f
-						// %f\n",  i,time_d + bathymetry->range[i],heading,beamheading,roll,beamroll,pitch,beampitch,theta,phi,
-						// bathymetry->depth[i],bathymetry->acrosstrack[i],bathymetry->alongtrack[i]);
+						beamattitude->beamid[nbeams] = i;
+						beamattitude->tx_steer[nbeams] = RTD * v2rawdetection->tx_angle;
+						beamattitude->rx_steer[nbeams] = -RTD * v2rawdetection->rx_angle[j];
+						nbeams++;
 					}
 				}
 
 				/* case of v2detection record with v2detectionsetup */
-				else if (store->read_v2detection == MB_YES && store->read_v2detectionsetup == MB_YES) {
-					for (j = 0; j < v2detection->number_beams; j++) {
+				else if ((store->read_mask & R7KREAD_V2Detection) && (store->read_mask & R7KREAD_V2DetectionSetup)) {
+					for (j = 0; j < beamattitude->nalloc && j < v2detection->number_beams; j++) {
 						i = v2detectionsetup->beam_descriptor[j];
-
 						bathymetry->range[i] = v2detection->range[j];
 						bathymetry->quality[i] = v2detectionsetup->quality[j];
-
-						/* compensate for pitch if not already compensated */
-						if ((volatilesettings->transmit_flags & 0xF) != 0) {
-							beampitch = 0.0;
-						}
-						else {
-							beampitch = pitch;
-						}
-						beampitchr = DTR * beampitch;
-
-						/* compensate for roll if not already compensated */
-						if ((volatilesettings->receive_flags & 0x1) != 0) {
-							beamroll = 0.0;
-						}
-						else {
-							/* get roll at bottom return time for this beam */
-							interp_status =
-							    mb_linear_interp(verbose, pars->attitude_time_d - 1, pars->attitude_roll - 1, pars->n_attitude,
-							                     time_d + bathymetry->range[i], &beamroll, &jattitude, error);
-						}
-						beamrollr = DTR * beamroll;
-
-						/* get heading at bottom return time for this beam */
-						interp_status = mb_linear_interp_heading(verbose, pars->heading_time_d - 1, pars->heading_heading - 1,
-						                                         pars->n_heading, time_d + bathymetry->range[i], &beamheading,
-						                                         &jheading, error);
-						beamheadingr = DTR * beamheading;
-
-						/* calculate beam angles for raytracing using Jon Beaudoin's code based on:
-						    Beaudoin, J., Hughes Clarke, J., and Bartlett, J. Application of
-						    Surface Sound Speed Measurements in Post-Processing for Multi-Sector
-						    Multibeam Echosounders : International Hydrographic Review, v.5, no.3,
-						    p.26-31.
-						    (http://www.omg.unb.ca/omg/papers/beaudoin_IHR_nov2004.pdf).
-						   note complexity if transducer arrays are reverse mounted, as determined
-						   by a mount heading angle of about 180 degrees rather than about 0 degrees.
-						   If a receive array or a transmit array are reverse mounted then:
-						    1) subtract 180 from the heading mount angle of the array
-						    2) flip the sign of the pitch and roll mount offsets of the array
-						    3) flip the sign of the beam steering angle from that array
-						        (reverse TX means flip sign of TX steer, reverse RX
-						        means flip sign of RX steer) */
-						tx_steer = RTD * v2detection->angle_y[j];
-						tx_orientation.roll = roll;
-						tx_orientation.pitch = pitch;
-						tx_orientation.heading = heading;
-						rx_steer = -RTD * v2detection->angle_x[j];
-						rx_orientation.roll = beamroll;
-						rx_orientation.pitch = beampitch;
-						rx_orientation.heading = beamheading;
-						reference_heading = heading;
-
-						status = mb_beaudoin(verbose, tx_align, tx_orientation, tx_steer, rx_align, rx_orientation, rx_steer,
-						                     reference_heading, &beamAzimuth, &beamDepression, error);
-						theta = 90.0 - beamDepression;
-						phi = 90.0 - beamAzimuth;
-						if (phi < 0.0)
-							phi += 360.0;
-
-						/* calculate bathymetry */
-						rr = 0.5 * soundspeed * bathymetry->range[i];
-						xx = rr * sin(DTR * theta);
-						zz = rr * cos(DTR * theta);
-						bathymetry->acrosstrack[i] = xx * cos(DTR * phi);
-						bathymetry->alongtrack[i] = xx * sin(DTR * phi);
-						bathymetry->depth[i] = zz + sensordepth - heave;
-						bathymetry->pointing_angle[i] = DTR * theta;
-						bathymetry->azimuth_angle[i] = DTR * phi;
+						beamattitude->beamid[nbeams] = i;
+						beamattitude->tx_steer[nbeams] = RTD * v2detection->angle_y[j];
+						beamattitude->rx_steer[nbeams] = -RTD * v2detection->angle_x[j];
+						nbeams++;
 					}
 				}
 
 				/* case of v2detection record */
-				else if (store->read_v2detection == MB_YES) {
-					/* now loop over the detects */
-					for (i = 0; i < v2detection->number_beams; i++) {
+				else if (store->read_mask & R7KREAD_V2Detection) {
+					for (i = 0; i < beamattitude->nalloc && i < v2detection->number_beams; i++) {
 						bathymetry->range[i] = v2detection->range[i];
 						/* bathymetry->quality[i] set in bathymetry record */
-
-						/* compensate for pitch if not already compensated */
-						if ((volatilesettings->transmit_flags & 0xF) != 0) {
-							beampitch = 0.0;
-						}
-						else {
-							beampitch = pitch;
-						}
-						beampitchr = DTR * beampitch;
-
-						/* compensate for roll if not already compensated */
-						if ((volatilesettings->receive_flags & 0x1) != 0) {
-							beamroll = 0.0;
-						}
-						else {
-							/* get roll at bottom return time for this beam */
-							interp_status =
-							    mb_linear_interp(verbose, pars->attitude_time_d - 1, pars->attitude_roll - 1, pars->n_attitude,
-							                     time_d + bathymetry->range[i], &beamroll, &jattitude, error);
-						}
-						beamrollr = DTR * beamroll;
-
-						/* get heading at bottom return time for this beam */
-						interp_status = mb_linear_interp_heading(verbose, pars->heading_time_d - 1, pars->heading_heading - 1,
-						                                         pars->n_heading, time_d + bathymetry->range[i], &beamheading,
-						                                         &jheading, error);
-						beamheadingr = DTR * beamheading;
-
-						/* calculate beam angles for raytracing using Jon Beaudoin's code based on:
-						    Beaudoin, J., Hughes Clarke, J., and Bartlett, J. Application of
-						    Surface Sound Speed Measurements in Post-Processing for Multi-Sector
-						    Multibeam Echosounders : International Hydrographic Review, v.5, no.3,
-						    p.26-31.
-						    (http://www.omg.unb.ca/omg/papers/beaudoin_IHR_nov2004.pdf).
-						   note complexity if transducer arrays are reverse mounted, as determined
-						   by a mount heading angle of about 180 degrees rather than about 0 degrees.
-						   If a receive array or a transmit array are reverse mounted then:
-						    1) subtract 180 from the heading mount angle of the array
-						    2) flip the sign of the pitch and roll mount offsets of the array
-						    3) flip the sign of the beam steering angle from that array
-						        (reverse TX means flip sign of TX steer, reverse RX
-						        means flip sign of RX steer) */
-						tx_steer = RTD * v2detection->angle_y[i];
-						tx_orientation.roll = roll;
-						tx_orientation.pitch = pitch;
-						tx_orientation.heading = heading;
-						rx_steer = -RTD * v2detection->angle_x[i];
-						rx_orientation.roll = beamroll;
-						rx_orientation.pitch = beampitch;
-						rx_orientation.heading = beamheading;
-						reference_heading = heading;
-
-						status = mb_beaudoin(verbose, tx_align, tx_orientation, tx_steer, rx_align, rx_orientation, rx_steer,
-						                     reference_heading, &beamAzimuth, &beamDepression, error);
-						theta = 90.0 - beamDepression;
-						phi = 90.0 - beamAzimuth;
-						if (phi < 0.0)
-							phi += 360.0;
-
-						/* calculate bathymetry */
-						rr = 0.5 * soundspeed * bathymetry->range[i];
-						xx = rr * sin(DTR * theta);
-						zz = rr * cos(DTR * theta);
-						bathymetry->acrosstrack[i] = xx * cos(DTR * phi);
-						bathymetry->alongtrack[i] = xx * sin(DTR * phi);
-						bathymetry->depth[i] = zz + sensordepth - heave;
-						bathymetry->pointing_angle[i] = DTR * theta;
-						bathymetry->azimuth_angle[i] = DTR * phi;
+						beamattitude->beamid[nbeams] = i;
+						beamattitude->tx_steer[nbeams] = RTD * v2detection->angle_y[i];
+						beamattitude->rx_steer[nbeams] = -RTD * v2detection->angle_x[i];
+						nbeams++;
 					}
 				}
 
 				/* else default case of beamgeometry record */
 				else {
-					/* loop over all beams */
-					for (i = 0; i < bathymetry->number_beams; i++) {
+					for (i = 0; i < beamattitude->nalloc && i < bathymetry->number_beams; i++) {
 						/* bathymetry->range[i] set */
 						/* bathymetry->quality[i] set */
 						if ((bathymetry->quality[i] & 15) > 0) {
-							/* compensate for pitch if not already compensated */
-							if ((volatilesettings->transmit_flags & 0xF) != 0) {
-								beampitch = 0.0;
-							}
-							else {
-								beampitch = pitch;
-							}
-							beampitchr = DTR * beampitch;
-
-							/* compensate for roll if not already compensated */
-							if ((volatilesettings->receive_flags & 0x1) != 0) {
-								beamroll = 0.0;
-							}
-							else {
-								/* get roll at bottom return time for this beam */
-								interp_status = mb_linear_interp(verbose, pars->attitude_time_d - 1, pars->attitude_roll - 1,
-								                                 pars->n_attitude, time_d + bathymetry->range[i], &beamroll,
-								                                 &jattitude, error);
-							}
-							beamrollr = DTR * beamroll;
-
-							/* compensate for heave if not already compensated */
-							if ((volatilesettings->receive_flags & 0x2) != 0) {
-								beamheave = 0.0;
-							}
-							else {
-								interp_status = mb_linear_interp(verbose, pars->attitude_time_d - 1, pars->attitude_heave - 1,
-								                                 pars->n_attitude, time_d + bathymetry->range[i], &beamheave,
-								                                 &jattitude, error);
-							}
-
-							/* get heading at bottom return time for this beam */
-							interp_status = mb_linear_interp_heading(verbose, pars->heading_time_d - 1, pars->heading_heading - 1,
-							                                         pars->n_heading, time_d + bathymetry->range[i], &beamheading,
-							                                         &jheading, error);
-							beamheadingr = DTR * beamheading;
-
-							/* calculate beam angles for raytracing using Jon Beaudoin's code based on:
-							    Beaudoin, J., Hughes Clarke, J., and Bartlett, J. Application of
-							    Surface Sound Speed Measurements in Post-Processing for Multi-Sector
-							    Multibeam Echosounders : International Hydrographic Review, v.5, no.3,
-							    p.26-31.
-							    (http://www.omg.unb.ca/omg/papers/beaudoin_IHR_nov2004.pdf).
-							   note complexity if transducer arrays are reverse mounted, as determined
-							   by a mount heading angle of about 180 degrees rather than about 0 degrees.
-							   If a receive array or a transmit array are reverse mounted then:
-							    1) subtract 180 from the heading mount angle of the array
-							    2) flip the sign of the pitch and roll mount offsets of the array
-							    3) flip the sign of the beam steering angle from that array
-							        (reverse TX means flip sign of TX steer, reverse RX
-							        means flip sign of RX steer) */
-							tx_steer = RTD * beamgeometry->angle_alongtrack[i];
-							tx_orientation.roll = roll;
-							tx_orientation.pitch = pitch;
-							tx_orientation.heading = heading;
-							rx_steer = -RTD * beamgeometry->angle_acrosstrack[i];
-							rx_orientation.roll = beamroll;
-							rx_orientation.pitch = beampitch;
-							rx_orientation.heading = beamheading;
-							reference_heading = heading;
-
-							status = mb_beaudoin(verbose, tx_align, tx_orientation, tx_steer, rx_align, rx_orientation, rx_steer,
-							                     reference_heading, &beamAzimuth, &beamDepression, error);
-							theta = 90.0 - beamDepression;
-							phi = 90.0 - beamAzimuth;
-							if (phi < 0.0)
-								phi += 360.0;
-
-							/* calculate bathymetry */
-							rr = 0.5 * soundspeed * bathymetry->range[i];
-							xx = rr * sin(DTR * theta);
-							zz = rr * cos(DTR * theta);
-							bathymetry->acrosstrack[i] = xx * cos(DTR * phi);
-							bathymetry->alongtrack[i] = xx * sin(DTR * phi);
-							bathymetry->depth[i] = zz + sensordepth - heave;
-							bathymetry->pointing_angle[i] = DTR * theta;
-							bathymetry->azimuth_angle[i] = DTR * phi;
+							beamattitude->beamid[nbeams] = i;
+							beamattitude->tx_steer[nbeams] = RTD * beamgeometry->angle_alongtrack[i];
+							beamattitude->rx_steer[nbeams] = -RTD * beamgeometry->angle_acrosstrack[i];
+							nbeams++;
+						}
+					}
+				}
+				for (j = 0; j < nbeams; j++) {
+					beamattitude->range[j] = bathymetry->range[beamattitude->beamid[j]];
+					beamattitude->time_d[j] = time_d + beamattitude->range[j];
+				}
+
+				/* get roll, pitch and heading at the bottom return times of
+				    all beams at once */
+				if (status == MB_SUCCESS)
+					status = mbsys_reson7k_interp_beamattitude(verbose, (void *)pars, nbeams, beamattitude, &jattitude,
+					                                           &jheading, error);
+
+				/* for detections other than raw detections use the pitch of the
+				    ping unless the sonar has compensated for pitch, and zero roll
+				    if the sonar has compensated for roll */
+				if (!(store->read_mask & R7KREAD_V2RawDetection)) {
+					for (j = 0; j < nbeams; j++) {
+						if ((volatilesettings->transmit_flags & 0xF) != 0)
+							beamattitude->pitch[j] = 0.0;
+						else
+							beamattitude->pitch[j] = pitch;
+						if ((volatilesettings->receive_flags & 0x1) != 0)
+							beamattitude->roll[j] = 0.0;
+					}
+				}
+
+				/* calculate beam angles for raytracing using Jon Beaudoin's code
+				    (mb_beaudoin(), or the batch kernel if built with
+				    MBSYS_RESON7K_BATCH_GEOMETRY) based on:
+				    Beaudoin, J., Hughes Clarke, J., and Bartlett, J. Application of
+				    Surface Sound Speed Measurements in Post-Processing for Multi-Sector
+				    Multibeam Echosounders : International Hydrographic Review, v.5, no.3,
+				    p.26-31.
+				    (http://www.omg.unb.ca/omg/papers/beaudoin_IHR_nov2004.pdf).
+				   the transmit orientation is that of the ping and the receive
+				   orientation that at the bottom return time of each beam - the
+				   beams are shared among preprocess_threads threads (one unless
+				   set) if built with MBSYS_RESON7K_PTHREADS */
+				tx_orientation.roll = roll;
+				tx_orientation.pitch = pitch;
+				tx_orientation.heading = heading;
+				reference_heading = heading;
+				if (status == MB_SUCCESS)
+					status = mbsys_reson7k_beam_geometry(verbose, tx_align, tx_orientation, rx_align, reference_heading,
+					                                     soundspeed, nbeams, ostore->preprocess_threads, beamattitude, error);
+#ifdef MBSYS_RESON7K_CHECK_BEAUDOIN
+				if (status == MB_SUCCESS) {
+					status = mbsys_reson7k_beam_geometry_check(verbose, tx_align, tx_orientation, rx_align, reference_heading,
+					                                           nbeams, beamattitude, &mismatch, &diffmax, error);
+					if (mismatch == MB_YES)
+						fprintf(stderr, "%s: ping %d beam angles differ from mb_beaudoin() by up to %g degrees\n", function_name,
+						        store->current_ping_number, diffmax);
+				}
+#endif
+
+				/* if requested recalculate the beam positions by ray tracing through
+				    the current SVP - the ray table is only rebuilt when the SVP, the
+				    transducer depth or the sound speed changes */
+				if (status == MB_SUCCESS && ostore->raytrace == MB_YES && store->svp.n > 1) {
+					status = mbsys_reson7k_raytable_update(verbose, &(ostore->raytable), &(store->svp), soundspeed, sensordepth,
+					                                       error);
+					for (j = 0; j < nbeams && ostore->raytable.valid == MB_YES; j++) {
+						mbsys_reson7k_raytable_lookup(&(ostore->raytable), 90.0 - beamattitude->depression[j],
+						                              0.5 * beamattitude->range[j], &xx, &zz);
+						rr = sqrt(beamattitude->acrosstrack[j] * beamattitude->acrosstrack[j]
+						          + beamattitude->alongtrack[j] * beamattitude->alongtrack[j]);
+						if (rr > 0.0) {
+							beamattitude->acrosstrack[j] *= xx / rr;
+							beamattitude->alongtrack[j] *= xx / rr;
 						}
+						beamattitude->depth[j] = zz;
 					}
 				}
 
+				/* save the bathymetry */
+				for (j = 0; j < nbeams; j++) {
+					i = beamattitude->beamid[j];
+					theta = 90.0 - beamattitude->depression[j];
+					phi = 90.0 - beamattitude->azimuth[j];
+					if (phi < 0.0)
+						phi += 360.0;
+					bathymetry->acrosstrack[i] = beamattitude->acrosstrack[j];
+					bathymetry->alongtrack[i] = beamattitude->alongtrack[j];
+					bathymetry->depth[i] = beamattitude->depth[j] + sensordepth - heave;
+					bathymetry->pointing_angle[i] = DTR * theta;
+					bathymetry->azimuth_angle[i] = DTR * phi;
+				}
+
 				/* set flag */
 				bathymetry->optionaldata = MB_YES;
 				bathymetry->header.OptionalDataOffset =
@@ -6133,9 +7438,14 @@ int mbsys_reson7k_preprocess(int verbose,     /* in: verbosity level set on comm
 				else if (pars->multibeam_sidescan_source == MB_PR_SSSOURCE_WIDEBEAMBACKSCATTER)
 					ss_source = R7KRECID_7kBackscatterImageData;
 
-				/* regenerate sidescan */
-				status = mbsys_reson7k_makess(verbose, mbio_ptr, store_ptr, ss_source, MB_NO, pixel_size, MB_NO, swath_width,
-				                              MB_YES, error);
+				/* regenerate sidescan - the pixel size and swath width carry over
+				    from ping to ping, so a preprocessing worker of a pipeline
+				    leaves this to the stage writing the pings in order */
+				if (ostore->preprocess_makess == MB_NO)
+					store->makess_source = ss_source;
+				else
+					status = mbsys_reson7k_makess(verbose, mbio_ptr, store_ptr, ss_source, MB_NO, pixel_size, MB_NO,
+					                              swath_width, MB_YES, error);
 			}
 			/*--------------------------------------------------------------*/
 		}
@@ -6155,6 +7465,62 @@ int mbsys_reson7k_preprocess(int verbose,     /* in: verbosity level set on comm
 	return (status);
 }
 /*--------------------------------------------------------------------*/
+int mbsys_reson7k_preprocess_tseries(int verbose, void *mbio_ptr, void *preprocess_pars_ptr, int *error) {
+	char *function_name = "mbsys_reson7k_preprocess_tseries";
+	int status = MB_SUCCESS;
+	struct mb_io_struct *mb_io_ptr;
+	struct mbsys_reson7k_struct *ostore;
+	struct mb_preprocess_struct *pars;
+	s7k_tseries *tseries;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:             %d\n", verbose);
+		fprintf(stderr, "dbg2       mbio_ptr:            %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       preprocess_pars_ptr: %p\n", (void *)preprocess_pars_ptr);
+	}
+
+	/* get mbio descriptor and the preprocessing parameters */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+	ostore = (struct mbsys_reson7k_struct *)mb_io_ptr->store_data;
+	pars = (struct mb_preprocess_struct *)preprocess_pars_ptr;
+	*error = MB_ERROR_NO_ERROR;
+
+	/* load the ancillary series into the internal store - each is copied
+	    only if it is not already held, or shared, from the same arrays */
+	tseries = ostore->tseries_preprocess;
+	status = mbsys_reson7k_tseries_load(verbose, &tseries[MBSYS_RESON7K_TSERIES_NAV], pars->n_nav, pars->nav_time_d,
+	                                    pars->nav_lon, pars->nav_lat, pars->nav_speed, error);
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_tseries_load(verbose, &tseries[MBSYS_RESON7K_TSERIES_SONARDEPTH], pars->n_sensordepth,
+		                                    pars->sensordepth_time_d, pars->sensordepth_sensordepth, NULL, NULL, error);
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_tseries_load(verbose, &tseries[MBSYS_RESON7K_TSERIES_HEADING], pars->n_heading,
+		                                    pars->heading_time_d, pars->heading_heading, NULL, NULL, error);
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_tseries_load(verbose, &tseries[MBSYS_RESON7K_TSERIES_ALTITUDE], pars->n_altitude,
+		                                    pars->altitude_time_d, pars->altitude_altitude, NULL, NULL, error);
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_tseries_load(verbose, &tseries[MBSYS_RESON7K_TSERIES_ATTITUDE], pars->n_attitude,
+		                                    pars->attitude_time_d, pars->attitude_roll, pars->attitude_pitch,
+		                                    pars->attitude_heave, error);
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
 int mbsys_reson7k_extract_platform(int verbose, void *mbio_ptr, void *store_ptr, int *kind, void **platform_ptr, int *error) {
 	char *function_name = "mbsys_reson7k_extract_platform";
 	int status = MB_SUCCESS;
@@ -6419,11 +7785,11 @@ int mbsys_reson7k_extract(int verbose, void *mbio_ptr, void *store_ptr, int *kin
 		}
 
 		/* set beamwidths in mb_io structure */
-		if (store->read_volatilesettings == MB_YES) {
+		if (store->read_mask & R7KREAD_VolatileSettings) {
 			mb_io_ptr->beamwidth_xtrack = RTD * volatilesettings->receive_width;
 			mb_io_ptr->beamwidth_ltrack = RTD * volatilesettings->beamwidth_vertical;
 		}
-		else if (store->read_beamgeometry == MB_YES) {
+		else if (store->read_mask & R7KREAD_BeamGeometry) {
 			mb_io_ptr->beamwidth_xtrack = RTD * beamgeometry->beamwidth_acrosstrack[beamgeometry->number_beams / 2];
 			mb_io_ptr->beamwidth_ltrack = RTD * beamgeometry->beamwidth_alongtrack[beamgeometry->number_beams / 2];
 		}
@@ -6526,7 +7892,7 @@ int mbsys_reson7k_extract(int verbose, void *mbio_ptr, void *store_ptr, int *kin
 
 		/* extract sidescan */
 		*nss = 0;
-		if (store->read_processedsidescan == MB_YES) {
+		if (store->read_mask & R7KREAD_ProcessedSidescan) {
 			*nss = processedsidescan->number_pixels;
 			for (i = 0; i < processedsidescan->number_pixels; i++) {
 				ss[i] = processedsidescan->sidescan[i];
@@ -6997,8 +8363,15 @@ int mbsys_reson7k_insert(int verbose, void *mbio_ptr, void *store_ptr, int kind,
 
 		/* get speed  */
 
+		/* the beam arrays are edited in place, so a copy shared with
+		    other stores must first become this store's own */
+		status = mbsys_reson7k_unshare_payload(verbose, store_ptr, R7KSHARE_Bathymetry, MB_YES, error);
+
 		/* read distance and depth values into storage arrays */
-		bathymetry->number_beams = nbath;
+		if (status == MB_SUCCESS) {
+			bathymetry->number_beams = nbath;
+			status = mbsys_reson7k_alloc_bathymetry(verbose, bathymetry, bathymetry->number_beams, error);
+		}
 		for (i = 0; i < bathymetry->number_beams; i++) {
 			bathymetry->depth[i] = bath[i];
 			if (beamflag[i] == MB_FLAG_NULL)
@@ -7147,6 +8520,9 @@ int mbsys_reson7k_insert(int verbose, void *mbio_ptr, void *store_ptr, int kind,
 
 	/* insert comment in structure */
 	else if (store->kind == MB_DATA_COMMENT) {
+		/* the message is replaced, so any array shared with copies is left to them */
+		status = mbsys_reson7k_unshare_payload(verbose, store_ptr, R7KSHARE_SystemEventMessage, MB_NO, error);
+
 		/* make sure memory is allocated for comment */
 		msglen = MIN(strlen(comment) + 1, MB_COMMENT_MAXLINE);
 		if (msglen % 2 > 0)
@@ -7192,6 +8568,16 @@ int mbsys_reson7k_insert(int verbose, void *mbio_ptr, void *store_ptr, int kind,
 		}
 	}
 
+	/* the inserted values supersede the records as read, so these
+	    records must be encoded rather than passed through on output */
+	if (status == MB_SUCCESS && store->kind == MB_DATA_DATA) {
+		mbsys_reson7k_rawrecord_modified(verbose, store_ptr, R7KRECID_7kBathymetricData, error);
+		mbsys_reson7k_rawrecord_modified(verbose, store_ptr, R7KRECID_ProcessedSidescan, error);
+	}
+	else if (status == MB_SUCCESS) {
+		mbsys_reson7k_rawrecord_modified(verbose, store_ptr, store->type, error);
+	}
+
 	/* print output debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
@@ -7525,170 +8911,395 @@ int mbsys_reson7k_gains(int verbose, void *mbio_ptr, void *store_ptr, int *kind,
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_extract_altitude(int verbose, void *mbio_ptr, void *store_ptr, int *kind, double *transducer_depth,
-                                   double *altitudev, int *error) {
-	char *function_name = "mbsys_reson7k_extract_altitude";
+int mbsys_reson7k_extract_batch(int verbose, void *mbio_ptr, int npings, void **store_ptrs, int nthreads, s7k_pingbatch *batch,
+                                int *error) {
+	char *function_name = "mbsys_reson7k_extract_batch";
 	int status = MB_SUCCESS;
 	struct mb_io_struct *mb_io_ptr;
 	struct mbsys_reson7k_struct *store;
+	struct mbsys_reson7k_struct *beamstore;
+	struct mbsys_reson7k_batchwork_struct work[MBSYS_RESON7K_BATCH_THREADS_MAX];
+#ifdef MBSYS_RESON7K_PTHREADS
+	pthread_t threads[MBSYS_RESON7K_BATCH_THREADS_MAX];
+	int nstarted;
+#endif
 	s7kr_bathymetry *bathymetry;
-	s7kr_depth *depth;
-	s7kr_altitude *altitude;
-	s7kr_attitude *attitude;
-	s7kr_reference *reference;
-	double heave, roll, pitch;
-	double xtrackmin;
-	int altitude_found;
-	char flag;
-	int i;
+	s7kr_volatilesettings *volatilesettings;
+	s7kr_beamgeometry *beamgeometry;
+	double navlon, navlat, heading;
+	int i, l;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
-		fprintf(stderr, "dbg2       mb_ptr:     %p\n", (void *)mbio_ptr);
-		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       verbose:     %d\n", verbose);
+		fprintf(stderr, "dbg2       mb_ptr:      %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       npings:      %d\n", npings);
+		fprintf(stderr, "dbg2       store_ptrs:  %p\n", (void *)store_ptrs);
+		fprintf(stderr, "dbg2       nthreads:    %d\n", nthreads);
+		fprintf(stderr, "dbg2       batch:       %p\n", (void *)batch);
+		fprintf(stderr, "dbg2       npingsalloc: %d\n", batch->npingsalloc);
+		fprintf(stderr, "dbg2       nbeamsalloc: %d\n", batch->nbeamsalloc);
 	}
 
 	/* get mbio descriptor */
 	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
 
-	/* get data structure pointer */
-	store = (struct mbsys_reson7k_struct *)store_ptr;
-	bathymetry = (s7kr_bathymetry *)&store->bathymetry;
-	depth = (s7kr_depth *)&store->depth;
-	attitude = (s7kr_attitude *)&store->attitude;
-	altitude = (s7kr_altitude *)&store->altitude;
-	reference = (s7kr_reference *)&store->reference;
+	/* the values of each ping are extracted in order by the calling thread
+	    because the navigation interpolation uses the mbio descriptor. Survey
+	    pings get exactly what looping over mbsys_reson7k_extract() with the
+	    same variables would give - the navigation is interpolated with the
+	    heading of the previous ping, the heading is then taken from the
+	    optional data, and values a ping has no source for carry over from
+	    the ping before. Other records are not extracted and do not change
+	    the values carried over */
+	npings = MAX(0, MIN(npings, batch->npingsalloc));
+	beamstore = NULL;
+	navlon = 0.0;
+	navlat = 0.0;
+	heading = 0.0;
+	for (i = 0; i < npings; i++) {
+		store = (struct mbsys_reson7k_struct *)store_ptrs[i];
+		bathymetry = &(store->bathymetry);
+		batch->kind[i] = store->kind;
+		batch->time_d[i] = store->time_d;
+		batch->speed[i] = 0.0;
+		batch->nbath[i] = 0;
+		if (store->kind == MB_DATA_DATA) {
+			/* get interpolated nav and speed */
+			if (mb_io_ptr->nfix > 0)
+				mb_navint_interp(verbose, mbio_ptr, store->time_d, heading, batch->speed[i], &navlon, &navlat,
+				                 &batch->speed[i], error);
 
-	/* get data kind */
-	*kind = store->kind;
+			/* get heading */
+			if (bathymetry->optionaldata == MB_YES)
+				heading = RTD * bathymetry->heading;
 
-	/* extract data from structure */
-	if (*kind == MB_DATA_DATA) {
-		/* get transducer depth and altitude */
-		if (bathymetry->optionaldata == MB_YES) {
-			*transducer_depth = -bathymetry->vehicle_height + reference->water_z;
-		}
-		else if (mb_io_ptr->nsonardepth > 0) {
-			mb_depint_interp(verbose, mbio_ptr, store->time_d, transducer_depth, error);
-		}
-		else if (mb_io_ptr->nattitude > 0) {
-			*transducer_depth = reference->water_z;
-			mb_attint_interp(verbose, mbio_ptr, store->time_d, &heave, &roll, &pitch, error);
-			*transducer_depth += heave;
+			/* get navigation */
+			if (bathymetry->optionaldata == MB_YES && bathymetry->longitude != 0.0 && bathymetry->latitude != 0.0) {
+				navlon = RTD * bathymetry->longitude;
+				navlat = RTD * bathymetry->latitude;
+			}
+
+			/* get gains */
+			volatilesettings = &(store->volatilesettings);
+			if (batch->transmit_gain != NULL)
+				batch->transmit_gain[i] = (double)volatilesettings->power_selection;
+			if (batch->pulse_length != NULL)
+				batch->pulse_length[i] = (double)volatilesettings->pulse_width;
+			if (batch->receive_gain != NULL)
+				batch->receive_gain[i] = (double)volatilesettings->gain_selection;
+
+			/* beams beyond the row are left out */
+			batch->nbath[i] = MAX(0, MIN((int)bathymetry->number_beams, batch->nbeamsalloc));
+			beamstore = store;
 		}
 		else {
-			*transducer_depth = reference->water_z;
-		}
-
-		/* get altitude */
-		altitude_found = MB_NO;
-		if (mb_io_ptr->naltitude > 0) {
-			mb_altint_interp(verbose, mbio_ptr, store->time_d, altitudev, error);
-			altitude_found = MB_YES;
+			if (batch->transmit_gain != NULL)
+				batch->transmit_gain[i] = 0.0;
+			if (batch->pulse_length != NULL)
+				batch->pulse_length[i] = 0.0;
+			if (batch->receive_gain != NULL)
+				batch->receive_gain[i] = 0.0;
 		}
-		if (altitude_found == MB_NO && bathymetry->optionaldata == MB_YES) {
-			/* get depth closest to nadir */
-			xtrackmin = 999999.9;
-			for (i = 0; i < bathymetry->number_beams; i++) {
-				if (bathymetry->quality[i] == 0) {
-					flag = MB_FLAG_NULL;
-				}
-				else if (bathymetry->quality[i] & 64) {
-					flag = MB_FLAG_FLAG + MB_FLAG_FILTER;
-				}
-				else if (bathymetry->quality[i] & 128) {
-					flag = MB_FLAG_FLAG + MB_FLAG_MANUAL;
-				}
-				else if (bathymetry->quality[i] & 240) {
-					flag = MB_FLAG_NONE;
-				}
-				else if ((bathymetry->quality[i] & 3) == 3) {
-					flag = MB_FLAG_NONE;
-				}
-				else if ((bathymetry->quality[i] & 15) == 0) {
-					flag = MB_FLAG_NULL;
-				}
-				else if ((bathymetry->quality[i] & 3) == 0) {
-					flag = MB_FLAG_FLAG + MB_FLAG_FILTER;
-				}
-				else {
-					flag = MB_FLAG_FLAG + MB_FLAG_MANUAL;
-				}
+		batch->navlon[i] = navlon;
+		batch->navlat[i] = navlat;
+		batch->heading[i] = heading;
+	}
 
-				if ((flag == MB_FLAG_NONE) && fabs((double)bathymetry->acrosstrack[i]) < xtrackmin) {
-					*altitudev = bathymetry->depth[i] - *transducer_depth;
-					altitude_found = MB_YES;
-					xtrackmin = fabs((double)bathymetry->acrosstrack[i]);
-				}
-			}
-		}
-		if (altitude_found == MB_NO && altitude->altitude > 0.0) {
-			*altitudev = altitude->altitude;
+	/* set beamwidths in mb_io structure from the last ping */
+	if (beamstore != NULL) {
+		volatilesettings = &(beamstore->volatilesettings);
+		beamgeometry = &(beamstore->beamgeometry);
+		if (beamstore->read_mask & R7KREAD_VolatileSettings) {
+			mb_io_ptr->beamwidth_xtrack = RTD * volatilesettings->receive_width;
+			mb_io_ptr->beamwidth_ltrack = RTD * volatilesettings->beamwidth_vertical;
 		}
-		else if (altitude_found == MB_NO) {
-			*altitudev = 0.0;
+		else if (beamstore->read_mask & R7KREAD_BeamGeometry) {
+			mb_io_ptr->beamwidth_xtrack = RTD * beamgeometry->beamwidth_acrosstrack[beamgeometry->number_beams / 2];
+			mb_io_ptr->beamwidth_ltrack = RTD * beamgeometry->beamwidth_alongtrack[beamgeometry->number_beams / 2];
 		}
+		mb_io_ptr->beamwidth_xtrack = MIN(mb_io_ptr->beamwidth_xtrack, 2.0);
+		mb_io_ptr->beamwidth_ltrack = MIN(mb_io_ptr->beamwidth_ltrack, 2.0);
+	}
 
-		/* set status */
-		*error = MB_ERROR_NO_ERROR;
-		status = MB_SUCCESS;
+	/* extract the beams in contiguous slices of pings - each thread writes
+	    only the rows of its own pings, so the results do not depend on the
+	    number of threads */
+	nthreads = MAX(1, MIN(nthreads, MBSYS_RESON7K_BATCH_THREADS_MAX));
+	nthreads = MAX(1, MIN(nthreads, npings / MBSYS_RESON7K_BATCH_THREADS_PINGS));
+	for (l = 0; l < nthreads; l++) {
+		work[l].store_ptrs = store_ptrs;
+		work[l].batch = batch;
+		work[l].istart = (l * npings) / nthreads;
+		work[l].iend = ((l + 1) * npings) / nthreads;
+	}
+#ifdef MBSYS_RESON7K_PTHREADS
+	for (nstarted = 1; nstarted < nthreads; nstarted++) {
+		if (pthread_create(&threads[nstarted], NULL, mbsys_reson7k_extract_batch_slice, (void *)&work[nstarted]) != 0)
+			break;
+	}
+	for (l = nstarted; l < nthreads; l++)
+		mbsys_reson7k_extract_batch_slice((void *)&work[l]);
+	mbsys_reson7k_extract_batch_slice((void *)&work[0]);
+	for (l = 1; l < nstarted; l++)
+		pthread_join(threads[l], NULL);
+#else
+	for (l = 0; l < nthreads; l++)
+		mbsys_reson7k_extract_batch_slice((void *)&work[l]);
+#endif
+	batch->npings = npings;
 
-		/* done translating values */
-	}
+	/* set status */
+	*error = MB_ERROR_NO_ERROR;
+	status = MB_SUCCESS;
 
-	/* deal with comment */
-	else if (*kind == MB_DATA_COMMENT) {
-		/* set status */
-		*error = MB_ERROR_COMMENT;
-		status = MB_FAILURE;
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       npings:     %d\n", batch->npings);
+		for (i = 0; i < batch->npings; i++)
+			fprintf(stderr, "dbg2       ping:%d  kind:%d  time_d:%f  lon:%f  lat:%f  speed:%f  heading:%f  nbath:%d\n", i,
+			        batch->kind[i], batch->time_d[i], batch->navlon[i], batch->navlat[i], batch->speed[i], batch->heading[i],
+			        batch->nbath[i]);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
 	}
 
-	/* deal with other record type */
-	else {
-		/* set status */
-		*error = MB_ERROR_OTHER;
-		status = MB_FAILURE;
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+void *mbsys_reson7k_extract_batch_slice(void *work_ptr) {
+	struct mbsys_reson7k_batchwork_struct *work;
+	struct mbsys_reson7k_struct *store;
+	s7k_pingbatch *batch;
+	s7kr_bathymetry *bathymetry;
+	s7kr_v2detectionsetup *v2detectionsetup;
+	s7kr_v2rawdetection *v2rawdetection;
+	size_t offset;
+	mb_u_char detect;
+	int i, j, k;
+
+	work = (struct mbsys_reson7k_batchwork_struct *)work_ptr;
+	batch = work->batch;
+
+	/* loop over the pings of this slice */
+	for (i = work->istart; i < work->iend; i++) {
+		store = (struct mbsys_reson7k_struct *)work->store_ptrs[i];
+		bathymetry = &(store->bathymetry);
+		offset = (size_t)i * (size_t)batch->nbeamsalloc;
+
+		/* beams of the ping, flagged as by mbsys_reson7k_extract() */
+		for (j = 0; j < batch->nbath[i]; j++) {
+			if (bathymetry->quality[j] == 0)
+				batch->beamflag[offset + j] = MB_FLAG_NULL;
+			else if (bathymetry->quality[j] & 64)
+				batch->beamflag[offset + j] = MB_FLAG_FLAG + MB_FLAG_FILTER;
+			else if (bathymetry->quality[j] & 128)
+				batch->beamflag[offset + j] = MB_FLAG_FLAG + MB_FLAG_MANUAL;
+			else if (bathymetry->quality[j] & 240)
+				batch->beamflag[offset + j] = MB_FLAG_NONE;
+			else if ((bathymetry->quality[j] & 3) == 3)
+				batch->beamflag[offset + j] = MB_FLAG_NONE;
+			else if ((bathymetry->quality[j] & 15) == 0)
+				batch->beamflag[offset + j] = MB_FLAG_NULL;
+			else if ((bathymetry->quality[j] & 3) == 0)
+				batch->beamflag[offset + j] = MB_FLAG_FLAG + MB_FLAG_FILTER;
+			else
+				batch->beamflag[offset + j] = MB_FLAG_FLAG + MB_FLAG_MANUAL;
+			batch->bath[offset + j] = bathymetry->depth[j];
+			batch->bathacrosstrack[offset + j] = bathymetry->acrosstrack[j];
+			batch->bathalongtrack[offset + j] = bathymetry->alongtrack[j];
+			if (bathymetry->intensity[j] > 0.0)
+				batch->amp[offset + j] = 20.0 * log10((double)bathymetry->intensity[j]);
+			else
+				batch->amp[offset + j] = 0.0;
+			if (batch->ttimes != NULL)
+				batch->ttimes[offset + j] = bathymetry->range[j];
+			if (batch->detects != NULL) {
+				detect = (bathymetry->quality[j] & 48) >> 4;
+				if (detect == 1)
+					batch->detects[offset + j] = MB_DETECT_AMPLITUDE;
+				else if (detect == 2)
+					batch->detects[offset + j] = MB_DETECT_PHASE;
+				else
+					batch->detects[offset + j] = MB_DETECT_UNKNOWN;
+			}
+		}
+
+		/* the rest of the row is null so that rows may be processed whole */
+		for (j = batch->nbath[i]; j < batch->nbeamsalloc; j++) {
+			batch->beamflag[offset + j] = MB_FLAG_NULL;
+			batch->bath[offset + j] = 0.0;
+			batch->bathacrosstrack[offset + j] = 0.0;
+			batch->bathalongtrack[offset + j] = 0.0;
+			batch->amp[offset + j] = 0.0;
+			if (batch->ttimes != NULL)
+				batch->ttimes[offset + j] = 0.0;
+			if (batch->detects != NULL)
+				batch->detects[offset + j] = MB_DETECT_UNKNOWN;
+		}
+
+		/* uncertainties are held by the detection records in detection order */
+		if (batch->uncertainty != NULL) {
+			v2rawdetection = &(store->v2rawdetection);
+			v2detectionsetup = &(store->v2detectionsetup);
+			for (j = 0; j < batch->nbeamsalloc; j++)
+				batch->uncertainty[offset + j] = 0.0;
+			if (store->read_mask & R7KREAD_V2RawDetection) {
+				for (k = 0; k < (int)v2rawdetection->number_beams; k++) {
+					j = v2rawdetection->beam_descriptor[k];
+					if (j >= 0 && j < batch->nbath[i])
+						batch->uncertainty[offset + j] = v2rawdetection->uncertainty[k];
+				}
+			}
+			else if (store->read_mask & R7KREAD_V2DetectionSetup) {
+				for (k = 0; k < (int)v2detectionsetup->number_beams; k++) {
+					j = v2detectionsetup->beam_descriptor[k];
+					if (j >= 0 && j < batch->nbath[i])
+						batch->uncertainty[offset + j] = v2detectionsetup->uncertainty[k];
+				}
+			}
+		}
+	}
+
+	return (NULL);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_columnar_open(int verbose, char *path, int nbeamsalloc, int chunk_pings, int nthreads, void **columnar_ptr,
+                                int *error) {
+	char *function_name = "mbsys_reson7k_columnar_open";
+	int status = MB_SUCCESS;
+	s7k_columnar *columnar;
+	s7k_pingbatch *batch;
+	char buffer[MBSYS_RESON7K_COLUMNAR_HEADER_SIZE];
+	size_t nping, nbeam;
+	int index;
+	int close_error;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
+		fprintf(stderr, "dbg2       path:         %s\n", path);
+		fprintf(stderr, "dbg2       nbeamsalloc:  %d\n", nbeamsalloc);
+		fprintf(stderr, "dbg2       chunk_pings:  %d\n", chunk_pings);
+		fprintf(stderr, "dbg2       nthreads:     %d\n", nthreads);
+	}
+
+	/* allocate the export and the columns of one chunk */
+	*columnar_ptr = NULL;
+	nbeamsalloc = MAX(1, nbeamsalloc);
+	if (chunk_pings <= 0)
+		chunk_pings = MBSYS_RESON7K_COLUMNAR_CHUNK_PINGS;
+	nping = (size_t)chunk_pings;
+	nbeam = nping * (size_t)nbeamsalloc;
+	status = mb_mallocd(verbose, __FILE__, __LINE__, sizeof(s7k_columnar), (void **)&columnar, error);
+	if (status == MB_SUCCESS) {
+		memset(columnar, 0, sizeof(s7k_columnar));
+		columnar->nbeamsalloc = nbeamsalloc;
+		columnar->chunk_pings = chunk_pings;
+		columnar->nthreads = MAX(1, nthreads);
+		batch = &(columnar->batch);
+		batch->npingsalloc = chunk_pings;
+		batch->nbeamsalloc = nbeamsalloc;
+		*columnar_ptr = (void *)columnar;
+	}
+	if (status == MB_SUCCESS)
+		status = mb_mallocd(verbose, __FILE__, __LINE__, nping * sizeof(int), (void **)&batch->kind, error);
+	if (status == MB_SUCCESS)
+		status = mb_mallocd(verbose, __FILE__, __LINE__, nping * sizeof(double), (void **)&batch->time_d, error);
+	if (status == MB_SUCCESS)
+		status = mb_mallocd(verbose, __FILE__, __LINE__, nping * sizeof(double), (void **)&batch->navlon, error);
+	if (status == MB_SUCCESS)
+		status = mb_mallocd(verbose, __FILE__, __LINE__, nping * sizeof(double), (void **)&batch->navlat, error);
+	if (status == MB_SUCCESS)
+		status = mb_mallocd(verbose, __FILE__, __LINE__, nping * sizeof(double), (void **)&batch->speed, error);
+	if (status == MB_SUCCESS)
+		status = mb_mallocd(verbose, __FILE__, __LINE__, nping * sizeof(double), (void **)&batch->heading, error);
+	if (status == MB_SUCCESS)
+		status = mb_mallocd(verbose, __FILE__, __LINE__, nping * sizeof(int), (void **)&batch->nbath, error);
+	if (status == MB_SUCCESS)
+		status = mb_mallocd(verbose, __FILE__, __LINE__, nbeam * sizeof(char), (void **)&batch->beamflag, error);
+	if (status == MB_SUCCESS)
+		status = mb_mallocd(verbose, __FILE__, __LINE__, nbeam * sizeof(double), (void **)&batch->bath, error);
+	if (status == MB_SUCCESS)
+		status = mb_mallocd(verbose, __FILE__, __LINE__, nbeam * sizeof(double), (void **)&batch->bathacrosstrack, error);
+	if (status == MB_SUCCESS)
+		status = mb_mallocd(verbose, __FILE__, __LINE__, nbeam * sizeof(double), (void **)&batch->bathalongtrack, error);
+	if (status == MB_SUCCESS)
+		status = mb_mallocd(verbose, __FILE__, __LINE__, nbeam * sizeof(double), (void **)&batch->amp, error);
+	if (status == MB_SUCCESS)
+		status = mb_mallocd(verbose, __FILE__, __LINE__, nbeam * sizeof(double), (void **)&batch->uncertainty, error);
+	if (status == MB_SUCCESS)
+		status = mb_mallocd(verbose, __FILE__, __LINE__, nping * sizeof(void *), (void **)&columnar->ping_ptrs, error);
+
+	/* open the file and write the header */
+	if (status == MB_SUCCESS) {
+		if ((columnar->fp = fopen(path, "wb")) == NULL) {
+			*error = MB_ERROR_OPEN_FAIL;
+			status = MB_FAILURE;
+		}
+		else {
+			memcpy(buffer, MBSYS_RESON7K_COLUMNAR_MAGIC, 8);
+			index = 8;
+			mb_put_binary_int(MB_YES, MBSYS_RESON7K_COLUMNAR_VERSION, &buffer[index]);
+			index += 4;
+			mb_put_binary_int(MB_YES, MBSYS_RESON7K_COLUMN_NUM, &buffer[index]);
+			index += 4;
+			mb_put_binary_int(MB_YES, nbeamsalloc, &buffer[index]);
+			index += 4;
+			mb_put_binary_int(MB_YES, chunk_pings, &buffer[index]);
+			index += 4;
+			mb_put_binary_long(MB_YES, (mb_s_long)0, &buffer[index]);
+			index += 8;
+			if (fwrite(buffer, 1, (size_t)index, columnar->fp) != (size_t)index) {
+				*error = MB_ERROR_WRITE_FAIL;
+				status = MB_FAILURE;
+			}
+			columnar->offset = (u64)index;
+		}
+	}
+
+	/* release everything if the export could not be started */
+	if (status == MB_FAILURE && *columnar_ptr != NULL) {
+		if (columnar->fp != NULL) {
+			fclose(columnar->fp);
+			columnar->fp = NULL;
+		}
+		mbsys_reson7k_columnar_close(verbose, columnar_ptr, &close_error);
 	}
 
 	/* print output debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       kind:              %d\n", *kind);
-		fprintf(stderr, "dbg2       transducer_depth:  %f\n", *transducer_depth);
-		fprintf(stderr, "dbg2       altitude:          %f\n", *altitudev);
-		fprintf(stderr, "dbg2       error:             %d\n", *error);
+		fprintf(stderr, "dbg2       columnar_ptr: %p\n", (void *)*columnar_ptr);
+		fprintf(stderr, "dbg2       error:        %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
-		fprintf(stderr, "dbg2       status:            %d\n", status);
+		fprintf(stderr, "dbg2       status:       %d\n", status);
 	}
 
 	/* return status */
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_extract_nav(int verbose, void *mbio_ptr, void *store_ptr, int *kind, int time_i[7], double *time_d,
-                              double *navlon, double *navlat, double *speed, double *heading, double *draft, double *roll,
-                              double *pitch, double *heave, int *error) {
-	char *function_name = "mbsys_reson7k_extract_nav";
+int mbsys_reson7k_columnar_write(int verbose, void *mbio_ptr, void *columnar_ptr, int npings, void **store_ptrs, int *error) {
+	char *function_name = "mbsys_reson7k_columnar_write";
 	int status = MB_SUCCESS;
-	struct mb_io_struct *mb_io_ptr;
 	struct mbsys_reson7k_struct *store;
-	s7kr_bathymetry *bathymetry;
-	s7kr_bluefin *bluefin;
-	s7kr_position *position;
-	s7kr_depth *depth;
-	s7kr_attitude *attitude;
-	s7kr_reference *reference;
-	s7kr_navigation *navigation;
-	s7kr_fsdwsb *fsdwsb;
-	s7kr_fsdwss *fsdwsslo;
-	s7kr_fsdwss *fsdwsshi;
-	s7k_fsdwsegyheader *fsdwsegyheader;
-	s7k_fsdwssheader *fsdwssheader;
+	s7k_columnar *columnar;
+	s7k_pingbatch *batch;
+	s7k_pingbatch rows;
+	size_t offset;
+	int nping;
 	int i;
 
 	/* print input debug statements */
@@ -7696,369 +9307,466 @@ int mbsys_reson7k_extract_nav(int verbose, void *mbio_ptr, void *store_ptr, int
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
-		fprintf(stderr, "dbg2       mb_ptr:     %p\n", (void *)mbio_ptr);
-		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
+		fprintf(stderr, "dbg2       mbio_ptr:     %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       columnar_ptr: %p\n", (void *)columnar_ptr);
+		fprintf(stderr, "dbg2       npings:       %d\n", npings);
+		fprintf(stderr, "dbg2       store_ptrs:   %p\n", (void *)store_ptrs);
 	}
 
-	/* get mbio descriptor */
-	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+	/* get export */
+	columnar = (s7k_columnar *)columnar_ptr;
+	batch = &(columnar->batch);
+	*error = MB_ERROR_NO_ERROR;
 
-	/* get data structure pointer */
-	store = (struct mbsys_reson7k_struct *)store_ptr;
-	bathymetry = (s7kr_bathymetry *)&store->bathymetry;
-	bluefin = (s7kr_bluefin *)&store->bluefin;
-	position = (s7kr_position *)&store->position;
-	depth = (s7kr_depth *)&store->depth;
-	attitude = (s7kr_attitude *)&store->attitude;
-	reference = (s7kr_reference *)&store->reference;
-	navigation = &(store->navigation);
-	fsdwsb = &(store->fsdwsb);
-	fsdwsslo = &(store->fsdwsslo);
-	fsdwsshi = &(store->fsdwsshi);
+	/* the survey pings are extracted into the rows following those already
+	    held, and each chunk is written as soon as it is full */
+	i = 0;
+	while (status == MB_SUCCESS && i < npings) {
+		nping = 0;
+		for (; i < npings && batch->npings + nping < columnar->chunk_pings; i++) {
+			store = (struct mbsys_reson7k_struct *)store_ptrs[i];
+			if (store->kind == MB_DATA_DATA)
+				columnar->ping_ptrs[nping++] = store_ptrs[i];
+		}
+		if (nping > 0) {
+			offset = (size_t)batch->npings * (size_t)batch->nbeamsalloc;
+			memset(&rows, 0, sizeof(s7k_pingbatch));
+			rows.npingsalloc = columnar->chunk_pings - batch->npings;
+			rows.nbeamsalloc = batch->nbeamsalloc;
+			rows.kind = &batch->kind[batch->npings];
+			rows.time_d = &batch->time_d[batch->npings];
+			rows.navlon = &batch->navlon[batch->npings];
+			rows.navlat = &batch->navlat[batch->npings];
+			rows.speed = &batch->speed[batch->npings];
+			rows.heading = &batch->heading[batch->npings];
+			rows.nbath = &batch->nbath[batch->npings];
+			rows.beamflag = &batch->beamflag[offset];
+			rows.bath = &batch->bath[offset];
+			rows.bathacrosstrack = &batch->bathacrosstrack[offset];
+			rows.bathalongtrack = &batch->bathalongtrack[offset];
+			rows.amp = &batch->amp[offset];
+			rows.uncertainty = &batch->uncertainty[offset];
+			status = mbsys_reson7k_extract_batch(verbose, mbio_ptr, nping, columnar->ping_ptrs, columnar->nthreads, &rows, error);
+			batch->npings += rows.npings;
+		}
+		if (status == MB_SUCCESS && batch->npings >= columnar->chunk_pings)
+			status = mbsys_reson7k_columnar_flush(verbose, columnar_ptr, error);
+	}
 
-	/* get data kind */
-	*kind = store->kind;
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       npings held:  %d\n", batch->npings);
+		fprintf(stderr, "dbg2       nchunk:       %d\n", columnar->nchunk);
+		fprintf(stderr, "dbg2       error:        %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:       %d\n", status);
+	}
 
-	/* extract data from ping structure */
-	if (*kind == MB_DATA_DATA) {
-		/* get time */
-		for (i = 0; i < 7; i++)
-			time_i[i] = store->time_i[i];
-		*time_d = store->time_d;
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_columnar_flush(int verbose, void *columnar_ptr, int *error) {
+	char *function_name = "mbsys_reson7k_columnar_flush";
+	int status = MB_SUCCESS;
+	s7k_columnar *columnar;
+	s7k_pingbatch *batch;
+	struct mbsys_reson7k_columnarwork_struct work[MBSYS_RESON7K_COLUMN_NUM];
+#ifdef MBSYS_RESON7K_PTHREADS
+	pthread_t threads[MBSYS_RESON7K_COLUMN_NUM];
+	int nstarted;
+#endif
+	size_t nping, nbeam, size, offset;
+	int nthreads;
+	int c, k, l;
 
-		/* get interpolated nav heading and speed  */
-		*speed = 0.0;
-		if (mb_io_ptr->nheading > 0)
-			mb_hedint_interp(verbose, mbio_ptr, store->time_d, heading, error);
-		if (mb_io_ptr->nfix > 0)
-			mb_navint_interp(verbose, mbio_ptr, store->time_d, *heading, *speed, navlon, navlat, speed, error);
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
+		fprintf(stderr, "dbg2       columnar_ptr: %p\n", (void *)columnar_ptr);
+	}
 
-		/* get heading */
-		if (bathymetry->optionaldata == MB_YES)
-			*heading = RTD * bathymetry->heading;
+	/* get export */
+	columnar = (s7k_columnar *)columnar_ptr;
+	batch = &(columnar->batch);
+	*error = MB_ERROR_NO_ERROR;
 
-		/* get navigation */
-		if (bathymetry->optionaldata == MB_YES) {
-			*navlon = RTD * bathymetry->longitude;
-			*navlat = RTD * bathymetry->latitude;
+	/* grow the chunk index if needed */
+	if (batch->npings > 0 && columnar->nchunk >= columnar->nchunkalloc) {
+		k = columnar->nchunkalloc + 64;
+		size = (size_t)k * MBSYS_RESON7K_COLUMN_NUM;
+		status = mb_reallocd(verbose, __FILE__, __LINE__, k * sizeof(u64), (void **)&columnar->chunk_offset, error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, k * sizeof(int), (void **)&columnar->chunk_npings, error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, size * sizeof(u64), (void **)&columnar->column_offset, error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, size * sizeof(u64), (void **)&columnar->column_size, error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, size * sizeof(int), (void **)&columnar->column_nvalues, error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, size * sizeof(double), (void **)&columnar->column_min, error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, size * sizeof(double), (void **)&columnar->column_max, error);
+		if (status == MB_SUCCESS)
+			columnar->nchunkalloc = k;
+	}
+
+	/* lay out the columns of the chunk at 8 byte aligned offsets */
+	if (status == MB_SUCCESS && batch->npings > 0) {
+		nping = (size_t)batch->npings;
+		nbeam = nping * (size_t)batch->nbeamsalloc;
+		columnar->chunk_offset[columnar->nchunk] = columnar->offset;
+		columnar->chunk_npings[columnar->nchunk] = batch->npings;
+		offset = 0;
+		for (c = 0; c < MBSYS_RESON7K_COLUMN_NUM; c++) {
+			if (c == MBSYS_RESON7K_COLUMN_NBATH)
+				size = nping * 4;
+			else if (c < MBSYS_RESON7K_COLUMN_NBATH)
+				size = nping * 8;
+			else if (c == MBSYS_RESON7K_COLUMN_BEAMFLAG)
+				size = nbeam;
+			else
+				size = nbeam * 8;
+			k = columnar->nchunk * MBSYS_RESON7K_COLUMN_NUM + c;
+			columnar->column_offset[k] = columnar->offset + offset;
+			columnar->column_size[k] = size;
+			offset += (size + 7) & ~((size_t)7);
+		}
+		if (offset > columnar->nbufferalloc) {
+			status = mb_reallocd(verbose, __FILE__, __LINE__, offset, (void **)&columnar->buffer, error);
+			if (status == MB_SUCCESS)
+				columnar->nbufferalloc = offset;
 		}
+		if (status == MB_SUCCESS)
+			memset(columnar->buffer, 0, offset);
 
-		/* get draft  */
-		if (bathymetry->optionaldata == MB_YES) {
-			*draft = -bathymetry->vehicle_height + reference->water_z;
+		/* encode the columns and their statistics - each column is encoded
+		    whole by one thread, so the chunk does not depend on the number
+		    of threads */
+		if (status == MB_SUCCESS) {
+			nthreads = MAX(1, MIN(columnar->nthreads, MBSYS_RESON7K_COLUMN_NUM));
+			for (l = 0; l < nthreads; l++) {
+				work[l].columnar = columnar;
+				work[l].istart = (l * MBSYS_RESON7K_COLUMN_NUM) / nthreads;
+				work[l].iend = ((l + 1) * MBSYS_RESON7K_COLUMN_NUM) / nthreads;
+			}
+#ifdef MBSYS_RESON7K_PTHREADS
+			for (nstarted = 1; nstarted < nthreads; nstarted++) {
+				if (pthread_create(&threads[nstarted], NULL, mbsys_reson7k_columnar_slice, (void *)&work[nstarted]) != 0)
+					break;
+			}
+			for (l = nstarted; l < nthreads; l++)
+				mbsys_reson7k_columnar_slice((void *)&work[l]);
+			mbsys_reson7k_columnar_slice((void *)&work[0]);
+			for (l = 1; l < nstarted; l++)
+				pthread_join(threads[l], NULL);
+#else
+			for (l = 0; l < nthreads; l++)
+				mbsys_reson7k_columnar_slice((void *)&work[l]);
+#endif
+
+			/* write the chunk */
+			if (fwrite(columnar->buffer, 1, offset, columnar->fp) != offset) {
+				*error = MB_ERROR_WRITE_FAIL;
+				status = MB_FAILURE;
+			}
+			else {
+				columnar->offset += offset;
+				columnar->nchunk++;
+				batch->npings = 0;
+			}
 		}
-		else if (mb_io_ptr->nsonardepth > 0) {
-			mb_depint_interp(verbose, mbio_ptr, store->time_d, draft, error);
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       nchunk:       %d\n", columnar->nchunk);
+		fprintf(stderr, "dbg2       offset:       %llu\n", (unsigned long long)columnar->offset);
+		fprintf(stderr, "dbg2       error:        %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:       %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+void *mbsys_reson7k_columnar_slice(void *work_ptr) {
+	struct mbsys_reson7k_columnarwork_struct *work;
+	s7k_columnar *columnar;
+	s7k_pingbatch *batch;
+	char *buffer;
+	double *values;
+	double min, max;
+	size_t offset;
+	int nvalues;
+	int c, i, j, k;
+
+	work = (struct mbsys_reson7k_columnarwork_struct *)work_ptr;
+	columnar = work->columnar;
+	batch = &(columnar->batch);
+
+	/* loop over the columns of this slice */
+	for (c = work->istart; c < work->iend; c++) {
+		k = columnar->nchunk * MBSYS_RESON7K_COLUMN_NUM + c;
+		buffer = &columnar->buffer[columnar->column_offset[k] - columnar->chunk_offset[columnar->nchunk]];
+		nvalues = 0;
+		min = 0.0;
+		max = 0.0;
+
+		/* beam counts */
+		if (c == MBSYS_RESON7K_COLUMN_NBATH) {
+			for (i = 0; i < batch->npings; i++) {
+				mb_put_binary_int(MB_YES, batch->nbath[i], &buffer[4 * i]);
+				if (nvalues == 0 || batch->nbath[i] < min)
+					min = batch->nbath[i];
+				if (nvalues == 0 || batch->nbath[i] > max)
+					max = batch->nbath[i];
+				nvalues++;
+			}
 		}
-		else {
-			*draft = reference->water_z;
+
+		/* beam flags - the statistics cover the beams that are not null */
+		else if (c == MBSYS_RESON7K_COLUMN_BEAMFLAG) {
+			for (i = 0; i < batch->npings; i++) {
+				offset = (size_t)i * (size_t)batch->nbeamsalloc;
+				for (j = 0; j < batch->nbeamsalloc; j++) {
+					buffer[offset + j] = batch->beamflag[offset + j];
+					if (j < batch->nbath[i] && batch->beamflag[offset + j] != MB_FLAG_NULL) {
+						if (nvalues == 0 || (mb_u_char)batch->beamflag[offset + j] < min)
+							min = (mb_u_char)batch->beamflag[offset + j];
+						if (nvalues == 0 || (mb_u_char)batch->beamflag[offset + j] > max)
+							max = (mb_u_char)batch->beamflag[offset + j];
+						nvalues++;
+					}
+				}
+			}
 		}
 
-		/* get attitude  */
-		if (bathymetry->optionaldata == MB_YES) {
-			*roll = RTD * bathymetry->roll;
-			*pitch = RTD * bathymetry->pitch;
-			*heave = bathymetry->heave;
+		/* ping values */
+		else if (c < MBSYS_RESON7K_COLUMN_NBATH) {
+			if (c == MBSYS_RESON7K_COLUMN_TIME)
+				values = batch->time_d;
+			else if (c == MBSYS_RESON7K_COLUMN_NAVLON)
+				values = batch->navlon;
+			else if (c == MBSYS_RESON7K_COLUMN_NAVLAT)
+				values = batch->navlat;
+			else
+				values = batch->heading;
+			for (i = 0; i < batch->npings; i++) {
+				mb_put_binary_double(MB_YES, values[i], &buffer[8 * i]);
+				if (nvalues == 0 || values[i] < min)
+					min = values[i];
+				if (nvalues == 0 || values[i] > max)
+					max = values[i];
+				nvalues++;
+			}
 		}
+
+		/* beam values - the statistics cover the beams that are not null */
 		else {
-			if (mb_io_ptr->nattitude > 0) {
-				mb_attint_interp(verbose, mbio_ptr, store->time_d, heave, roll, pitch, error);
+			if (c == MBSYS_RESON7K_COLUMN_BATH)
+				values = batch->bath;
+			else if (c == MBSYS_RESON7K_COLUMN_ACROSSTRACK)
+				values = batch->bathacrosstrack;
+			else if (c == MBSYS_RESON7K_COLUMN_ALONGTRACK)
+				values = batch->bathalongtrack;
+			else if (c == MBSYS_RESON7K_COLUMN_AMP)
+				values = batch->amp;
+			else
+				values = batch->uncertainty;
+			for (i = 0; i < batch->npings; i++) {
+				offset = (size_t)i * (size_t)batch->nbeamsalloc;
+				for (j = 0; j < batch->nbeamsalloc; j++) {
+					mb_put_binary_double(MB_YES, values[offset + j], &buffer[8 * (offset + j)]);
+					if (j < batch->nbath[i] && batch->beamflag[offset + j] != MB_FLAG_NULL) {
+						if (nvalues == 0 || values[offset + j] < min)
+							min = values[offset + j];
+						if (nvalues == 0 || values[offset + j] > max)
+							max = values[offset + j];
+						nvalues++;
+					}
+				}
 			}
 		}
 
-		/* done translating values */
+		columnar->column_nvalues[k] = nvalues;
+		columnar->column_min[k] = min;
+		columnar->column_max[k] = max;
 	}
 
-	/* extract data from nav structure */
-	else if (*kind == MB_DATA_NAV1) {
-		/* get position data structure */
-		position = (s7kr_position *)&store->position;
-
-		/* get time */
-		for (i = 0; i < 7; i++)
-			time_i[i] = store->time_i[i];
-		*time_d = store->time_d;
+	return (NULL);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_columnar_close(int verbose, void **columnar_ptr, int *error) {
+	char *function_name = "mbsys_reson7k_columnar_close";
+	int status = MB_SUCCESS;
+	s7k_columnar *columnar;
+	s7k_pingbatch *batch;
+	size_t size;
+	int index;
+	int free_error;
+	int c, k, n;
 
-		/* get navigation and heading */
-		*speed = 0.0;
-		if (mb_io_ptr->nheading > 0)
-			mb_hedint_interp(verbose, mbio_ptr, store->time_d, heading, error);
-		if (mb_io_ptr->nfix > 0)
-			mb_navint_interp(verbose, mbio_ptr, store->time_d, *heading, *speed, navlon, navlat, speed, error);
-		*navlon = RTD * position->longitude;
-		*navlat = RTD * position->latitude;
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:      %d\n", verbose);
+		fprintf(stderr, "dbg2       columnar_ptr: %p\n", (void *)*columnar_ptr);
+	}
 
-		/* get roll pitch and heave */
-		if (mb_io_ptr->nattitude > 0) {
-			mb_attint_interp(verbose, mbio_ptr, *time_d, heave, roll, pitch, error);
-		}
+	/* get export */
+	columnar = (s7k_columnar *)*columnar_ptr;
+	batch = &(columnar->batch);
+	*error = MB_ERROR_NO_ERROR;
 
-		/* get draft  */
-		if (mb_io_ptr->nsonardepth > 0) {
-			if (mb_io_ptr->nsonardepth > 0)
-				mb_depint_interp(verbose, mbio_ptr, store->time_d, draft, error);
-			*heave = 0.0;
+	/* write the last chunk, the footer index and the trailer */
+	if (columnar->fp != NULL) {
+		status = mbsys_reson7k_columnar_flush(verbose, *columnar_ptr, error);
+		size = 8 + (size_t)columnar->nchunk
+		               * (MBSYS_RESON7K_COLUMNAR_CHUNK_SIZE + MBSYS_RESON7K_COLUMN_NUM * MBSYS_RESON7K_COLUMNAR_ENTRY_SIZE)
+		       + MBSYS_RESON7K_COLUMNAR_TRAILER_SIZE;
+		if (status == MB_SUCCESS && size > columnar->nbufferalloc) {
+			status = mb_reallocd(verbose, __FILE__, __LINE__, size, (void **)&columnar->buffer, error);
+			if (status == MB_SUCCESS)
+				columnar->nbufferalloc = size;
 		}
-		else if (bathymetry->optionaldata == MB_YES) {
-			*draft = -bathymetry->vehicle_height + reference->water_z;
-			*heave = 0.0;
+		if (status == MB_SUCCESS) {
+			index = 0;
+			mb_put_binary_int(MB_YES, columnar->nchunk, &columnar->buffer[index]);
+			index += 4;
+			mb_put_binary_int(MB_YES, MBSYS_RESON7K_COLUMN_NUM, &columnar->buffer[index]);
+			index += 4;
+			for (n = 0; n < columnar->nchunk; n++) {
+				mb_put_binary_long(MB_YES, (mb_s_long)columnar->chunk_offset[n], &columnar->buffer[index]);
+				index += 8;
+				mb_put_binary_int(MB_YES, columnar->chunk_npings[n], &columnar->buffer[index]);
+				index += 4;
+				mb_put_binary_int(MB_YES, 0, &columnar->buffer[index]);
+				index += 4;
+				for (c = 0; c < MBSYS_RESON7K_COLUMN_NUM; c++) {
+					k = n * MBSYS_RESON7K_COLUMN_NUM + c;
+					mb_put_binary_long(MB_YES, (mb_s_long)columnar->column_offset[k], &columnar->buffer[index]);
+					index += 8;
+					mb_put_binary_long(MB_YES, (mb_s_long)columnar->column_size[k], &columnar->buffer[index]);
+					index += 8;
+					mb_put_binary_int(MB_YES, columnar->column_nvalues[k], &columnar->buffer[index]);
+					index += 4;
+					mb_put_binary_int(MB_YES, 0, &columnar->buffer[index]);
+					index += 4;
+					mb_put_binary_double(MB_YES, columnar->column_min[k], &columnar->buffer[index]);
+					index += 8;
+					mb_put_binary_double(MB_YES, columnar->column_max[k], &columnar->buffer[index]);
+					index += 8;
+				}
+			}
+			mb_put_binary_long(MB_YES, (mb_s_long)columnar->offset, &columnar->buffer[index]);
+			index += 8;
+			mb_put_binary_long(MB_YES, (mb_s_long)(index - 8), &columnar->buffer[index]);
+			index += 8;
+			memcpy(&columnar->buffer[index], MBSYS_RESON7K_COLUMNAR_MAGIC, 8);
+			index += 8;
+			if (fwrite(columnar->buffer, 1, (size_t)index, columnar->fp) != (size_t)index) {
+				*error = MB_ERROR_WRITE_FAIL;
+				status = MB_FAILURE;
+			}
+			else
+				columnar->offset += index;
 		}
-		else {
-			*draft = reference->water_z;
+		if (fclose(columnar->fp) != 0 && status == MB_SUCCESS) {
+			*error = MB_ERROR_WRITE_FAIL;
+			status = MB_FAILURE;
 		}
-
-		/* done translating values */
-	}
-
-	/* extract data from structure */
-	else if (*kind == MB_DATA_NAV2) {
-		/* get time */
-		for (i = 0; i < 7; i++)
-			time_i[i] = store->time_i[i];
-		*time_d = store->time_d;
-
-		/* get heading */
-		*heading = RTD * bluefin->nav[0].yaw;
-
-		/* get speed */
-		*speed = 0.0;
-		if (mb_io_ptr->nfix > 0)
-			mb_navint_interp(verbose, mbio_ptr, store->time_d, *heading, *speed, navlon, navlat, speed, error);
-
-		/* get navigation */
-		*navlon = RTD * bluefin->nav[0].longitude;
-		*navlat = RTD * bluefin->nav[0].latitude;
-
-		/* get roll pitch and heave */
-		*roll = RTD * bluefin->nav[0].roll;
-		*pitch = RTD * bluefin->nav[0].pitch;
-		*heave = 0.0;
-
-		/* get draft  */
-		*draft = bluefin->nav[0].depth;
-
-		/* done translating values */
-	}
-
-	/* extract data from structure */
-	else if (*kind == MB_DATA_NAV3) {
-		/* get time */
-		for (i = 0; i < 7; i++)
-			time_i[i] = store->time_i[i];
-		time_d[0] = store->time_d;
-
-		/* get navigation */
-		navlon[0] = RTD * navigation->longitude;
-		navlat[0] = RTD * navigation->latitude;
-
-		/* get speed  */
-		speed[0] = 0.0;
-
-		/* get heading */
-		if (mb_io_ptr->nheading > 0)
-			mb_hedint_interp(verbose, mbio_ptr, store->time_d, heading, error);
-		else if (bathymetry->optionaldata == MB_YES)
-			heading[0] = RTD * bathymetry->heading;
-
-		/* get draft  */
-		if (mb_io_ptr->nsonardepth > 0) {
-			mb_depint_interp(verbose, mbio_ptr, store->time_d, &(draft[0]), error);
-		}
-		else if (bathymetry->optionaldata == MB_YES) {
-			draft[0] = -bathymetry->vehicle_height + reference->water_z;
-		}
-		else {
-			draft[0] = reference->water_z;
-		}
-
-		/* get attitude  */
-		if (mb_io_ptr->nattitude > 0) {
-			mb_attint_interp(verbose, mbio_ptr, store->time_d, &(heave[0]), &(roll[0]), &(pitch[0]), error);
-		}
-		else if (bathymetry->optionaldata == MB_YES) {
-			roll[0] = RTD * bathymetry->roll;
-			pitch[0] = RTD * bathymetry->pitch;
-			heave[0] = bathymetry->heave;
-		}
-		else {
-			roll[0] = 0.0;
-			pitch[0] = 0.0;
-			heave[0] = 0.0;
-		}
-
-		/* done translating values */
-	}
-
-	/* extract data from structure */
-	else if (*kind == MB_DATA_SUBBOTTOM_SUBBOTTOM) {
-		/* get edgetech segy header */
-		fsdwsegyheader = &(fsdwsb->segyheader);
-
-		/* get time */
-		for (i = 0; i < 7; i++)
-			time_i[i] = store->time_i[i];
-		*time_d = store->time_d;
-
-		/* get heading */
-		if (fsdwsegyheader->heading != 0)
-			*heading = 0.01 * fsdwsegyheader->heading;
-		else
-			mb_hedint_interp(verbose, mbio_ptr, store->time_d, heading, error);
-
-		/* get speed and position */
-		*speed = 0.0;
-		if (mb_io_ptr->nfix > 0)
-			mb_navint_interp(verbose, mbio_ptr, store->time_d, *heading, *speed, navlon, navlat, speed, error);
-
-		/* get position */
-		if (fsdwsegyheader->sourceCoordX != 0 || fsdwsegyheader->sourceCoordY != 0) {
-			*navlon = ((double)fsdwsegyheader->sourceCoordX) / 360000.0;
-			*navlat = ((double)fsdwsegyheader->sourceCoordY) / 360000.0;
-		}
-
-		/* get roll pitch and heave */
-		*roll = 0.01 * fsdwsegyheader->roll;
-		*pitch = 0.01 * fsdwsegyheader->pitch;
-		*heave = 0.0;
-
-		if (mb_io_ptr->nattitude > 0) {
-			mb_attint_interp(verbose, mbio_ptr, store->time_d, heave, roll, pitch, error);
-		}
-
-		/* get draft  */
-		*draft = reference->water_z;
-
-		/* done translating values */
-	}
-
-	/* extract data from sidescan structure */
-	else if (*kind == MB_DATA_SIDESCAN2 || *kind == MB_DATA_SIDESCAN3) {
-		/* get edgetech sidescan header */
-		if (*kind == MB_DATA_SIDESCAN2)
-			fsdwssheader = &(fsdwsslo->ssheader[0]);
-		else // if (*kind == MB_DATA_SIDESCAN3)
-			fsdwssheader = &(fsdwsshi->ssheader[0]);
-
-		/* get time */
-		for (i = 0; i < 7; i++)
-			time_i[i] = store->time_i[i];
-		*time_d = store->time_d;
-
-		/* get heading */
-		if (fsdwssheader->heading != 0)
-			*heading = 0.01 * fsdwssheader->heading;
-		else if (mb_io_ptr->nheading > 0)
-			mb_hedint_interp(verbose, mbio_ptr, store->time_d, heading, error);
-
-		/* get speed and position */
-		*speed = 0.0;
-		if (mb_io_ptr->nfix > 0)
-			mb_navint_interp(verbose, mbio_ptr, store->time_d, *heading, *speed, navlon, navlat, speed, error);
-
-		/* get position */
-		if (fsdwssheader->longitude != 0 || fsdwssheader->latitude != 0) {
-			*navlon = ((double)fsdwssheader->longitude) / 360000.0;
-			*navlat = ((double)fsdwssheader->latitude) / 360000.0;
-		}
-
-		/* print debug statements */
-		if (verbose >= 5) {
-			fprintf(stderr, "\ndbg4  Data extracted by MBIO function <%s>\n", function_name);
-			fprintf(stderr, "dbg4  Extracted values:\n");
-			fprintf(stderr, "dbg4       kind:       %d\n", *kind);
-			fprintf(stderr, "dbg4       error:      %d\n", *error);
-			fprintf(stderr, "dbg4       time_i[0]:  %d\n", time_i[0]);
-			fprintf(stderr, "dbg4       time_i[1]:  %d\n", time_i[1]);
-			fprintf(stderr, "dbg4       time_i[2]:  %d\n", time_i[2]);
-			fprintf(stderr, "dbg4       time_i[3]:  %d\n", time_i[3]);
-			fprintf(stderr, "dbg4       time_i[4]:  %d\n", time_i[4]);
-			fprintf(stderr, "dbg4       time_i[5]:  %d\n", time_i[5]);
-			fprintf(stderr, "dbg4       time_i[6]:  %d\n", time_i[6]);
-			fprintf(stderr, "dbg4       time_d:     %f\n", *time_d);
-			fprintf(stderr, "dbg4       longitude:  %f\n", *navlon);
-			fprintf(stderr, "dbg4       latitude:   %f\n", *navlat);
-			fprintf(stderr, "dbg4       speed:      %f\n", *speed);
-			fprintf(stderr, "dbg4       heading:    %f\n", *heading);
-		}
-
-		/* done translating values */
-	}
-
-	/* deal with comment */
-	else if (*kind == MB_DATA_COMMENT) {
-		/* set status */
-		*error = MB_ERROR_COMMENT;
-		status = MB_FAILURE;
-
-		/* get time */
-		for (i = 0; i < 7; i++)
-			time_i[i] = store->time_i[i];
-		*time_d = store->time_d;
-	}
-
-	/* deal with other record type */
-	else {
-		/* set status */
-		*error = MB_ERROR_OTHER;
-		status = MB_FAILURE;
-
-		/* get time */
-		for (i = 0; i < 7; i++)
-			time_i[i] = store->time_i[i];
-		*time_d = store->time_d;
-	}
+		columnar->fp = NULL;
+	}
+
+	/* deallocate the export */
+	if (batch->kind != NULL)
+		mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->kind, &free_error);
+	if (batch->time_d != NULL)
+		mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->time_d, &free_error);
+	if (batch->navlon != NULL)
+		mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->navlon, &free_error);
+	if (batch->navlat != NULL)
+		mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->navlat, &free_error);
+	if (batch->speed != NULL)
+		mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->speed, &free_error);
+	if (batch->heading != NULL)
+		mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->heading, &free_error);
+	if (batch->nbath != NULL)
+		mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->nbath, &free_error);
+	if (batch->beamflag != NULL)
+		mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->beamflag, &free_error);
+	if (batch->bath != NULL)
+		mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->bath, &free_error);
+	if (batch->bathacrosstrack != NULL)
+		mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->bathacrosstrack, &free_error);
+	if (batch->bathalongtrack != NULL)
+		mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->bathalongtrack, &free_error);
+	if (batch->amp != NULL)
+		mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->amp, &free_error);
+	if (batch->uncertainty != NULL)
+		mb_freed(verbose, __FILE__, __LINE__, (void **)&batch->uncertainty, &free_error);
+	if (columnar->ping_ptrs != NULL)
+		mb_freed(verbose, __FILE__, __LINE__, (void **)&columnar->ping_ptrs, &free_error);
+	if (columnar->chunk_offset != NULL)
+		mb_freed(verbose, __FILE__, __LINE__, (void **)&columnar->chunk_offset, &free_error);
+	if (columnar->chunk_npings != NULL)
+		mb_freed(verbose, __FILE__, __LINE__, (void **)&columnar->chunk_npings, &free_error);
+	if (columnar->column_offset != NULL)
+		mb_freed(verbose, __FILE__, __LINE__, (void **)&columnar->column_offset, &free_error);
+	if (columnar->column_size != NULL)
+		mb_freed(verbose, __FILE__, __LINE__, (void **)&columnar->column_size, &free_error);
+	if (columnar->column_nvalues != NULL)
+		mb_freed(verbose, __FILE__, __LINE__, (void **)&columnar->column_nvalues, &free_error);
+	if (columnar->column_min != NULL)
+		mb_freed(verbose, __FILE__, __LINE__, (void **)&columnar->column_min, &free_error);
+	if (columnar->column_max != NULL)
+		mb_freed(verbose, __FILE__, __LINE__, (void **)&columnar->column_max, &free_error);
+	if (columnar->buffer != NULL)
+		mb_freed(verbose, __FILE__, __LINE__, (void **)&columnar->buffer, &free_error);
+	mb_freed(verbose, __FILE__, __LINE__, (void **)columnar_ptr, &free_error);
 
 	/* print output debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       kind:          %d\n", *kind);
-		fprintf(stderr, "dbg2       time_i[0]:     %d\n", time_i[0]);
-		fprintf(stderr, "dbg2       time_i[1]:     %d\n", time_i[1]);
-		fprintf(stderr, "dbg2       time_i[2]:     %d\n", time_i[2]);
-		fprintf(stderr, "dbg2       time_i[3]:     %d\n", time_i[3]);
-		fprintf(stderr, "dbg2       time_i[4]:     %d\n", time_i[4]);
-		fprintf(stderr, "dbg2       time_i[5]:     %d\n", time_i[5]);
-		fprintf(stderr, "dbg2       time_i[6]:     %d\n", time_i[6]);
-		fprintf(stderr, "dbg2       time_d:        %f\n", *time_d);
-		fprintf(stderr, "dbg2       longitude:     %f\n", *navlon);
-		fprintf(stderr, "dbg2       latitude:      %f\n", *navlat);
-		fprintf(stderr, "dbg2       speed:         %f\n", *speed);
-		fprintf(stderr, "dbg2       heading:       %f\n", *heading);
-		fprintf(stderr, "dbg2       draft:         %f\n", *draft);
-		fprintf(stderr, "dbg2       roll:          %f\n", *roll);
-		fprintf(stderr, "dbg2       pitch:         %f\n", *pitch);
-		fprintf(stderr, "dbg2       heave:         %f\n", *heave);
-		fprintf(stderr, "dbg2       error:         %d\n", *error);
+		fprintf(stderr, "dbg2       error:        %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
-		fprintf(stderr, "dbg2       status:        %d\n", status);
+		fprintf(stderr, "dbg2       status:       %d\n", status);
 	}
-	/*if (status == MB_SUCCESS)
-	fprintf(stderr,"%4.4d/%2.2d/%2.2d %2.2d:%2.2d:%2.2d.%6.6d %f %f %f %f %f %f %f %f\n",
-	time_i[0],time_i[1],time_i[2],time_i[3],time_i[4],time_i[5],time_i[6],
-	*navlon,*navlat,*speed,*heading,*draft,*roll,*pitch,*heave);*/
 
 	/* return status */
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_extract_nnav(int verbose, void *mbio_ptr, void *store_ptr, int nmax, int *kind, int *n, int *time_i,
-                               double *time_d, double *navlon, double *navlat, double *speed, double *heading, double *draft,
-                               double *roll, double *pitch, double *heave, int *error) {
-	char *function_name = "mbsys_reson7k_extract_nnav";
+int mbsys_reson7k_extract_altitude(int verbose, void *mbio_ptr, void *store_ptr, int *kind, double *transducer_depth,
+                                   double *altitudev, int *error) {
+	char *function_name = "mbsys_reson7k_extract_altitude";
 	int status = MB_SUCCESS;
 	struct mb_io_struct *mb_io_ptr;
 	struct mbsys_reson7k_struct *store;
 	s7kr_bathymetry *bathymetry;
-	s7kr_bluefin *bluefin;
-	s7kr_position *position;
 	s7kr_depth *depth;
+	s7kr_altitude *altitude;
 	s7kr_attitude *attitude;
 	s7kr_reference *reference;
-	s7kr_navigation *navigation;
-	s7kr_rollpitchheave *rollpitchheave;
-	int i, inav;
+	double heave, roll, pitch;
+	double xtrackmin;
+	int altitude_found;
+	char flag;
+	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -8068,7 +9776,6 @@ int mbsys_reson7k_extract_nnav(int verbose, void *mbio_ptr, void *store_ptr, int
 		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
 		fprintf(stderr, "dbg2       mb_ptr:     %p\n", (void *)mbio_ptr);
 		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
-		fprintf(stderr, "dbg2       nmax:       %d\n", nmax);
 	}
 
 	/* get mbio descriptor */
@@ -8077,61 +9784,213 @@ int mbsys_reson7k_extract_nnav(int verbose, void *mbio_ptr, void *store_ptr, int
 	/* get data structure pointer */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
 	bathymetry = (s7kr_bathymetry *)&store->bathymetry;
-	bluefin = (s7kr_bluefin *)&store->bluefin;
-	position = (s7kr_position *)&store->position;
 	depth = (s7kr_depth *)&store->depth;
 	attitude = (s7kr_attitude *)&store->attitude;
+	altitude = (s7kr_altitude *)&store->altitude;
 	reference = (s7kr_reference *)&store->reference;
-	navigation = &(store->navigation);
-	rollpitchheave = &(store->rollpitchheave);
 
 	/* get data kind */
 	*kind = store->kind;
 
-	/* extract data from ping structure */
+	/* extract data from structure */
 	if (*kind == MB_DATA_DATA) {
-		/* just one navigation value */
-		*n = 1;
-
-		/* get time */
-		for (i = 0; i < 7; i++)
-			time_i[i] = store->time_i[i];
-		time_d[0] = store->time_d;
+		/* get transducer depth and altitude */
+		if (bathymetry->optionaldata == MB_YES) {
+			*transducer_depth = -bathymetry->vehicle_height + reference->water_z;
+		}
+		else if (mb_io_ptr->nsonardepth > 0) {
+			mb_depint_interp(verbose, mbio_ptr, store->time_d, transducer_depth, error);
+		}
+		else if (mb_io_ptr->nattitude > 0) {
+			*transducer_depth = reference->water_z;
+			mb_attint_interp(verbose, mbio_ptr, store->time_d, &heave, &roll, &pitch, error);
+			*transducer_depth += heave;
+		}
+		else {
+			*transducer_depth = reference->water_z;
+		}
+
+		/* get altitude */
+		altitude_found = MB_NO;
+		if (mb_io_ptr->naltitude > 0) {
+			mb_altint_interp(verbose, mbio_ptr, store->time_d, altitudev, error);
+			altitude_found = MB_YES;
+		}
+		if (altitude_found == MB_NO && bathymetry->optionaldata == MB_YES) {
+			/* get depth closest to nadir */
+			xtrackmin = 999999.9;
+			for (i = 0; i < bathymetry->number_beams; i++) {
+				if (bathymetry->quality[i] == 0) {
+					flag = MB_FLAG_NULL;
+				}
+				else if (bathymetry->quality[i] & 64) {
+					flag = MB_FLAG_FLAG + MB_FLAG_FILTER;
+				}
+				else if (bathymetry->quality[i] & 128) {
+					flag = MB_FLAG_FLAG + MB_FLAG_MANUAL;
+				}
+				else if (bathymetry->quality[i] & 240) {
+					flag = MB_FLAG_NONE;
+				}
+				else if ((bathymetry->quality[i] & 3) == 3) {
+					flag = MB_FLAG_NONE;
+				}
+				else if ((bathymetry->quality[i] & 15) == 0) {
+					flag = MB_FLAG_NULL;
+				}
+				else if ((bathymetry->quality[i] & 3) == 0) {
+					flag = MB_FLAG_FLAG + MB_FLAG_FILTER;
+				}
+				else {
+					flag = MB_FLAG_FLAG + MB_FLAG_MANUAL;
+				}
+
+				if ((flag == MB_FLAG_NONE) && fabs((double)bathymetry->acrosstrack[i]) < xtrackmin) {
+					*altitudev = bathymetry->depth[i] - *transducer_depth;
+					altitude_found = MB_YES;
+					xtrackmin = fabs((double)bathymetry->acrosstrack[i]);
+				}
+			}
+		}
+		if (altitude_found == MB_NO && altitude->altitude > 0.0) {
+			*altitudev = altitude->altitude;
+		}
+		else if (altitude_found == MB_NO) {
+			*altitudev = 0.0;
+		}
+
+		/* set status */
+		*error = MB_ERROR_NO_ERROR;
+		status = MB_SUCCESS;
+
+		/* done translating values */
+	}
+
+	/* deal with comment */
+	else if (*kind == MB_DATA_COMMENT) {
+		/* set status */
+		*error = MB_ERROR_COMMENT;
+		status = MB_FAILURE;
+	}
+
+	/* deal with other record type */
+	else {
+		/* set status */
+		*error = MB_ERROR_OTHER;
+		status = MB_FAILURE;
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       kind:              %d\n", *kind);
+		fprintf(stderr, "dbg2       transducer_depth:  %f\n", *transducer_depth);
+		fprintf(stderr, "dbg2       altitude:          %f\n", *altitudev);
+		fprintf(stderr, "dbg2       error:             %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:            %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_extract_nav(int verbose, void *mbio_ptr, void *store_ptr, int *kind, int time_i[7], double *time_d,
+                              double *navlon, double *navlat, double *speed, double *heading, double *draft, double *roll,
+                              double *pitch, double *heave, int *error) {
+	char *function_name = "mbsys_reson7k_extract_nav";
+	int status = MB_SUCCESS;
+	struct mb_io_struct *mb_io_ptr;
+	struct mbsys_reson7k_struct *store;
+	s7kr_bathymetry *bathymetry;
+	s7kr_bluefin *bluefin;
+	s7kr_position *position;
+	s7kr_depth *depth;
+	s7kr_attitude *attitude;
+	s7kr_reference *reference;
+	s7kr_navigation *navigation;
+	s7kr_fsdwsb *fsdwsb;
+	s7kr_fsdwss *fsdwsslo;
+	s7kr_fsdwss *fsdwsshi;
+	s7k_fsdwsegyheader *fsdwsegyheader;
+	s7k_fsdwssheader *fsdwssheader;
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mb_ptr:     %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+	}
+
+	/* get mbio descriptor */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+
+	/* get data structure pointer */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+	bathymetry = (s7kr_bathymetry *)&store->bathymetry;
+	bluefin = (s7kr_bluefin *)&store->bluefin;
+	position = (s7kr_position *)&store->position;
+	depth = (s7kr_depth *)&store->depth;
+	attitude = (s7kr_attitude *)&store->attitude;
+	reference = (s7kr_reference *)&store->reference;
+	navigation = &(store->navigation);
+	fsdwsb = &(store->fsdwsb);
+	fsdwsslo = &(store->fsdwsslo);
+	fsdwsshi = &(store->fsdwsshi);
+
+	/* get data kind */
+	*kind = store->kind;
+
+	/* extract data from ping structure */
+	if (*kind == MB_DATA_DATA) {
+		/* get time */
+		for (i = 0; i < 7; i++)
+			time_i[i] = store->time_i[i];
+		*time_d = store->time_d;
 
 		/* get interpolated nav heading and speed  */
-		speed[0] = 0.0;
-		mb_hedint_interp(verbose, mbio_ptr, store->time_d, &(heading[0]), error);
-		mb_navint_interp(verbose, mbio_ptr, store->time_d, heading[0], speed[0], &(navlon[0]), &(navlat[0]), &(speed[0]), error);
+		*speed = 0.0;
+		if (mb_io_ptr->nheading > 0)
+			mb_hedint_interp(verbose, mbio_ptr, store->time_d, heading, error);
+		if (mb_io_ptr->nfix > 0)
+			mb_navint_interp(verbose, mbio_ptr, store->time_d, *heading, *speed, navlon, navlat, speed, error);
 
 		/* get heading */
 		if (bathymetry->optionaldata == MB_YES)
-			heading[0] = RTD * bathymetry->heading;
+			*heading = RTD * bathymetry->heading;
 
 		/* get navigation */
 		if (bathymetry->optionaldata == MB_YES) {
-			navlon[0] = RTD * bathymetry->longitude;
-			navlat[0] = RTD * bathymetry->latitude;
+			*navlon = RTD * bathymetry->longitude;
+			*navlat = RTD * bathymetry->latitude;
 		}
 
 		/* get draft  */
 		if (bathymetry->optionaldata == MB_YES) {
-			draft[0] = -bathymetry->vehicle_height + reference->water_z;
+			*draft = -bathymetry->vehicle_height + reference->water_z;
 		}
 		else if (mb_io_ptr->nsonardepth > 0) {
-			mb_depint_interp(verbose, mbio_ptr, store->time_d, &(draft[0]), error);
+			mb_depint_interp(verbose, mbio_ptr, store->time_d, draft, error);
 		}
 		else {
-			draft[0] = reference->water_z;
+			*draft = reference->water_z;
 		}
 
 		/* get attitude  */
 		if (bathymetry->optionaldata == MB_YES) {
-			roll[0] = RTD * bathymetry->roll;
-			pitch[0] = RTD * bathymetry->pitch;
-			heave[0] = bathymetry->heave;
+			*roll = RTD * bathymetry->roll;
+			*pitch = RTD * bathymetry->pitch;
+			*heave = bathymetry->heave;
 		}
 		else {
-			mb_attint_interp(verbose, mbio_ptr, store->time_d, &(heave[0]), &(roll[0]), &(pitch[0]), error);
+			if (mb_io_ptr->nattitude > 0) {
+				mb_attint_interp(verbose, mbio_ptr, store->time_d, heave, roll, pitch, error);
+			}
 		}
 
 		/* done translating values */
@@ -8139,35 +9998,40 @@ int mbsys_reson7k_extract_nnav(int verbose, void *mbio_ptr, void *store_ptr, int
 
 	/* extract data from nav structure */
 	else if (*kind == MB_DATA_NAV1) {
-		/* just one navigation value */
-		*n = 1;
+		/* get position data structure */
+		position = (s7kr_position *)&store->position;
 
 		/* get time */
 		for (i = 0; i < 7; i++)
 			time_i[i] = store->time_i[i];
-		time_d[0] = store->time_d;
+		*time_d = store->time_d;
 
 		/* get navigation and heading */
-		speed[0] = 0.0;
-		mb_hedint_interp(verbose, mbio_ptr, store->time_d, &(heading[0]), error);
-		mb_navint_interp(verbose, mbio_ptr, store->time_d, heading[0], speed[0], &(navlon[0]), &(navlat[0]), &(speed[0]), error);
-		navlon[0] = RTD * position->longitude;
-		navlat[0] = RTD * position->latitude;
+		*speed = 0.0;
+		if (mb_io_ptr->nheading > 0)
+			mb_hedint_interp(verbose, mbio_ptr, store->time_d, heading, error);
+		if (mb_io_ptr->nfix > 0)
+			mb_navint_interp(verbose, mbio_ptr, store->time_d, *heading, *speed, navlon, navlat, speed, error);
+		*navlon = RTD * position->longitude;
+		*navlat = RTD * position->latitude;
 
 		/* get roll pitch and heave */
-		mb_attint_interp(verbose, mbio_ptr, *time_d, &(heave[0]), &(roll[0]), &(pitch[0]), error);
+		if (mb_io_ptr->nattitude > 0) {
+			mb_attint_interp(verbose, mbio_ptr, *time_d, heave, roll, pitch, error);
+		}
 
 		/* get draft  */
 		if (mb_io_ptr->nsonardepth > 0) {
-			mb_depint_interp(verbose, mbio_ptr, store->time_d, &draft[0], error);
-			heave[0] = 0.0;
+			if (mb_io_ptr->nsonardepth > 0)
+				mb_depint_interp(verbose, mbio_ptr, store->time_d, draft, error);
+			*heave = 0.0;
 		}
 		else if (bathymetry->optionaldata == MB_YES) {
-			draft[0] = -bathymetry->vehicle_height + reference->water_z;
-			heave[0] = 0.0;
+			*draft = -bathymetry->vehicle_height + reference->water_z;
+			*heave = 0.0;
 		}
 		else {
-			draft[0] = reference->water_z;
+			*draft = reference->water_z;
 		}
 
 		/* done translating values */
@@ -8175,47 +10039,36 @@ int mbsys_reson7k_extract_nnav(int verbose, void *mbio_ptr, void *store_ptr, int
 
 	/* extract data from structure */
 	else if (*kind == MB_DATA_NAV2) {
-		/* get number of available navigation values */
-		if (bluefin->data_format == 0 && bluefin->number_frames > 0)
-			*n = bluefin->number_frames;
-		else
-			*n = 0;
-
-		/* loop over navigation values */
-		for (inav = 0; inav < *n; inav++) {
-			/* get time */
-			time_d[inav] = bluefin->nav[inav].position_time;
-			mb_get_date(verbose, time_d[inav], &(time_i[7 * inav]));
+		/* get time */
+		for (i = 0; i < 7; i++)
+			time_i[i] = store->time_i[i];
+		*time_d = store->time_d;
 
-			/* get heading */
-			heading[inav] = RTD * bluefin->nav[inav].yaw;
+		/* get heading */
+		*heading = RTD * bluefin->nav[0].yaw;
 
-			/* get speed */
-			speed[inav] = 0.0;
-			mb_navint_interp(verbose, mbio_ptr, time_d[inav], heading[inav], speed[inav], &(navlon[inav]), &(navlat[inav]),
-			                 &(speed[inav]), error);
+		/* get speed */
+		*speed = 0.0;
+		if (mb_io_ptr->nfix > 0)
+			mb_navint_interp(verbose, mbio_ptr, store->time_d, *heading, *speed, navlon, navlat, speed, error);
 
-			/* get navigation */
-			navlon[inav] = RTD * bluefin->nav[inav].longitude;
-			navlat[inav] = RTD * bluefin->nav[inav].latitude;
+		/* get navigation */
+		*navlon = RTD * bluefin->nav[0].longitude;
+		*navlat = RTD * bluefin->nav[0].latitude;
 
-			/* get roll pitch and heave */
-			roll[inav] = RTD * bluefin->nav[inav].roll;
-			pitch[inav] = RTD * bluefin->nav[inav].pitch;
-			heave[inav] = 0.0;
+		/* get roll pitch and heave */
+		*roll = RTD * bluefin->nav[0].roll;
+		*pitch = RTD * bluefin->nav[0].pitch;
+		*heave = 0.0;
 
-			/* get draft  */
-			draft[inav] = bluefin->nav[inav].depth;
-		}
+		/* get draft  */
+		*draft = bluefin->nav[0].depth;
 
 		/* done translating values */
 	}
 
 	/* extract data from structure */
 	else if (*kind == MB_DATA_NAV3) {
-		/* get number of available navigation values */
-		*n = 1;
-
 		/* get time */
 		for (i = 0; i < 7; i++)
 			time_i[i] = store->time_i[i];
@@ -8263,46 +10116,97 @@ int mbsys_reson7k_extract_nnav(int verbose, void *mbio_ptr, void *store_ptr, int
 		/* done translating values */
 	}
 
-	/* extract data from attitude structure */
-	else if (*kind == MB_DATA_ATTITUDE) {
-		/* just one navigation value */
-		*n = 1;
+	/* extract data from structure */
+	else if (*kind == MB_DATA_SUBBOTTOM_SUBBOTTOM) {
+		/* get edgetech segy header */
+		fsdwsegyheader = &(fsdwsb->segyheader);
 
 		/* get time */
 		for (i = 0; i < 7; i++)
 			time_i[i] = store->time_i[i];
-		time_d[0] = store->time_d;
+		*time_d = store->time_d;
 
-		/* get interpolated nav heading and speed  */
-		speed[0] = 0.0;
-		heading[0] = 0.0;
-		if (mb_io_ptr->nheading > 0)
-			mb_hedint_interp(verbose, mbio_ptr, store->time_d, &(heading[0]), error);
-		else if (bathymetry->optionaldata == MB_YES)
-			heading[0] = RTD * bathymetry->heading;
+		/* get heading */
+		if (fsdwsegyheader->heading != 0)
+			*heading = 0.01 * fsdwsegyheader->heading;
+		else
+			mb_hedint_interp(verbose, mbio_ptr, store->time_d, heading, error);
+
+		/* get speed and position */
+		*speed = 0.0;
 		if (mb_io_ptr->nfix > 0)
-			mb_navint_interp(verbose, mbio_ptr, store->time_d, heading[0], speed[0], &(navlon[0]), &(navlat[0]), &(speed[0]),
-			                 error);
-		else if (bathymetry->optionaldata == MB_YES) {
-			navlon[0] = RTD * bathymetry->longitude;
-			navlat[0] = RTD * bathymetry->latitude;
-		}
+			mb_navint_interp(verbose, mbio_ptr, store->time_d, *heading, *speed, navlon, navlat, speed, error);
 
-		/* get draft  */
-		if (mb_io_ptr->nsonardepth > 0) {
-			mb_depint_interp(verbose, mbio_ptr, store->time_d, &(draft[0]), error);
+		/* get position */
+		if (fsdwsegyheader->sourceCoordX != 0 || fsdwsegyheader->sourceCoordY != 0) {
+			*navlon = ((double)fsdwsegyheader->sourceCoordX) / 360000.0;
+			*navlat = ((double)fsdwsegyheader->sourceCoordY) / 360000.0;
 		}
-		else if (bathymetry->optionaldata == MB_YES) {
-			draft[0] = -bathymetry->vehicle_height + reference->water_z;
+
+		/* get roll pitch and heave */
+		*roll = 0.01 * fsdwsegyheader->roll;
+		*pitch = 0.01 * fsdwsegyheader->pitch;
+		*heave = 0.0;
+
+		if (mb_io_ptr->nattitude > 0) {
+			mb_attint_interp(verbose, mbio_ptr, store->time_d, heave, roll, pitch, error);
 		}
-		else {
-			draft[0] = reference->water_z;
+
+		/* get draft  */
+		*draft = reference->water_z;
+
+		/* done translating values */
+	}
+
+	/* extract data from sidescan structure */
+	else if (*kind == MB_DATA_SIDESCAN2 || *kind == MB_DATA_SIDESCAN3) {
+		/* get edgetech sidescan header */
+		if (*kind == MB_DATA_SIDESCAN2)
+			fsdwssheader = &(fsdwsslo->ssheader[0]);
+		else // if (*kind == MB_DATA_SIDESCAN3)
+			fsdwssheader = &(fsdwsshi->ssheader[0]);
+
+		/* get time */
+		for (i = 0; i < 7; i++)
+			time_i[i] = store->time_i[i];
+		*time_d = store->time_d;
+
+		/* get heading */
+		if (fsdwssheader->heading != 0)
+			*heading = 0.01 * fsdwssheader->heading;
+		else if (mb_io_ptr->nheading > 0)
+			mb_hedint_interp(verbose, mbio_ptr, store->time_d, heading, error);
+
+		/* get speed and position */
+		*speed = 0.0;
+		if (mb_io_ptr->nfix > 0)
+			mb_navint_interp(verbose, mbio_ptr, store->time_d, *heading, *speed, navlon, navlat, speed, error);
+
+		/* get position */
+		if (fsdwssheader->longitude != 0 || fsdwssheader->latitude != 0) {
+			*navlon = ((double)fsdwssheader->longitude) / 360000.0;
+			*navlat = ((double)fsdwssheader->latitude) / 360000.0;
 		}
 
-		/* get attitude  */
-		roll[0] = RTD * rollpitchheave->roll;
-		pitch[0] = RTD * rollpitchheave->pitch;
-		heave[0] = rollpitchheave->heave;
+		/* print debug statements */
+		if (verbose >= 5) {
+			fprintf(stderr, "\ndbg4  Data extracted by MBIO function <%s>\n", function_name);
+			fprintf(stderr, "dbg4  Extracted values:\n");
+			fprintf(stderr, "dbg4       kind:       %d\n", *kind);
+			fprintf(stderr, "dbg4       error:      %d\n", *error);
+			fprintf(stderr, "dbg4       time_i[0]:  %d\n", time_i[0]);
+			fprintf(stderr, "dbg4       time_i[1]:  %d\n", time_i[1]);
+			fprintf(stderr, "dbg4       time_i[2]:  %d\n", time_i[2]);
+			fprintf(stderr, "dbg4       time_i[3]:  %d\n", time_i[3]);
+			fprintf(stderr, "dbg4       time_i[4]:  %d\n", time_i[4]);
+			fprintf(stderr, "dbg4       time_i[5]:  %d\n", time_i[5]);
+			fprintf(stderr, "dbg4       time_i[6]:  %d\n", time_i[6]);
+			fprintf(stderr, "dbg4       time_d:     %f\n", *time_d);
+			fprintf(stderr, "dbg4       longitude:  %f\n", *navlon);
+			fprintf(stderr, "dbg4       latitude:   %f\n", *navlat);
+			fprintf(stderr, "dbg4       speed:      %f\n", *speed);
+			fprintf(stderr, "dbg4       heading:    %f\n", *heading);
+		}
 
 		/* done translating values */
 	}
@@ -8325,9 +10229,6 @@ int mbsys_reson7k_extract_nnav(int verbose, void *mbio_ptr, void *store_ptr, int
 		*error = MB_ERROR_OTHER;
 		status = MB_FAILURE;
 
-		/* get number of available navigation values */
-		*n = 1;
-
 		/* get time */
 		for (i = 0; i < 7; i++)
 			time_i[i] = store->time_i[i];
@@ -8338,43 +10239,52 @@ int mbsys_reson7k_extract_nnav(int verbose, void *mbio_ptr, void *store_ptr, int
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       kind:       %d\n", *kind);
-		fprintf(stderr, "dbg2       n:          %d\n", *n);
-		for (inav = 0; inav < *n; inav++) {
-			for (i = 0; i < 7; i++)
-				fprintf(stderr, "dbg2       %d time_i[%d]:     %d\n", inav, i, time_i[inav * 7 + i]);
-			fprintf(stderr, "dbg2       %d time_d:        %f\n", inav, time_d[inav]);
-			fprintf(stderr, "dbg2       %d longitude:     %f\n", inav, navlon[inav]);
-			fprintf(stderr, "dbg2       %d latitude:      %f\n", inav, navlat[inav]);
-			fprintf(stderr, "dbg2       %d speed:         %f\n", inav, speed[inav]);
-			fprintf(stderr, "dbg2       %d heading:       %f\n", inav, heading[inav]);
-			fprintf(stderr, "dbg2       %d draft:         %f\n", inav, draft[inav]);
-			fprintf(stderr, "dbg2       %d roll:          %f\n", inav, roll[inav]);
-			fprintf(stderr, "dbg2       %d pitch:         %f\n", inav, pitch[inav]);
-			fprintf(stderr, "dbg2       %d heave:         %f\n", inav, heave[inav]);
-		}
-		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2       kind:          %d\n", *kind);
+		fprintf(stderr, "dbg2       time_i[0]:     %d\n", time_i[0]);
+		fprintf(stderr, "dbg2       time_i[1]:     %d\n", time_i[1]);
+		fprintf(stderr, "dbg2       time_i[2]:     %d\n", time_i[2]);
+		fprintf(stderr, "dbg2       time_i[3]:     %d\n", time_i[3]);
+		fprintf(stderr, "dbg2       time_i[4]:     %d\n", time_i[4]);
+		fprintf(stderr, "dbg2       time_i[5]:     %d\n", time_i[5]);
+		fprintf(stderr, "dbg2       time_i[6]:     %d\n", time_i[6]);
+		fprintf(stderr, "dbg2       time_d:        %f\n", *time_d);
+		fprintf(stderr, "dbg2       longitude:     %f\n", *navlon);
+		fprintf(stderr, "dbg2       latitude:      %f\n", *navlat);
+		fprintf(stderr, "dbg2       speed:         %f\n", *speed);
+		fprintf(stderr, "dbg2       heading:       %f\n", *heading);
+		fprintf(stderr, "dbg2       draft:         %f\n", *draft);
+		fprintf(stderr, "dbg2       roll:          %f\n", *roll);
+		fprintf(stderr, "dbg2       pitch:         %f\n", *pitch);
+		fprintf(stderr, "dbg2       heave:         %f\n", *heave);
+		fprintf(stderr, "dbg2       error:         %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
-		fprintf(stderr, "dbg2       status:     %d\n", status);
+		fprintf(stderr, "dbg2       status:        %d\n", status);
 	}
+	/*if (status == MB_SUCCESS)
+	fprintf(stderr,"%4.4d/%2.2d/%2.2d %2.2d:%2.2d:%2.2d.%6.6d %f %f %f %f %f %f %f %f\n",
+	time_i[0],time_i[1],time_i[2],time_i[3],time_i[4],time_i[5],time_i[6],
+	*navlon,*navlat,*speed,*heading,*draft,*roll,*pitch,*heave);*/
 
 	/* return status */
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_insert_nav(int verbose, void *mbio_ptr, void *store_ptr, int time_i[7], double time_d, double navlon,
-                             double navlat, double speed, double heading, double draft, double roll, double pitch, double heave,
-                             int *error) {
-	char *function_name = "mbsys_reson7k_insert_nav";
+int mbsys_reson7k_extract_nnav(int verbose, void *mbio_ptr, void *store_ptr, int nmax, int *kind, int *n, int *time_i,
+                               double *time_d, double *navlon, double *navlat, double *speed, double *heading, double *draft,
+                               double *roll, double *pitch, double *heave, int *error) {
+	char *function_name = "mbsys_reson7k_extract_nnav";
 	int status = MB_SUCCESS;
 	struct mb_io_struct *mb_io_ptr;
 	struct mbsys_reson7k_struct *store;
 	s7kr_bathymetry *bathymetry;
+	s7kr_bluefin *bluefin;
 	s7kr_position *position;
 	s7kr_depth *depth;
 	s7kr_attitude *attitude;
 	s7kr_reference *reference;
-	int i;
+	s7kr_navigation *navigation;
+	s7kr_rollpitchheave *rollpitchheave;
+	int i, inav;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -8382,24 +10292,9 @@ int mbsys_reson7k_insert_nav(int verbose, void *mbio_ptr, void *store_ptr, int t
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
-		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       mb_ptr:     %p\n", (void *)mbio_ptr);
 		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
-		fprintf(stderr, "dbg2       time_i[0]:  %d\n", time_i[0]);
-		fprintf(stderr, "dbg2       time_i[1]:  %d\n", time_i[1]);
-		fprintf(stderr, "dbg2       time_i[2]:  %d\n", time_i[2]);
-		fprintf(stderr, "dbg2       time_i[3]:  %d\n", time_i[3]);
-		fprintf(stderr, "dbg2       time_i[4]:  %d\n", time_i[4]);
-		fprintf(stderr, "dbg2       time_i[5]:  %d\n", time_i[5]);
-		fprintf(stderr, "dbg2       time_i[6]:  %d\n", time_i[6]);
-		fprintf(stderr, "dbg2       time_d:     %f\n", time_d);
-		fprintf(stderr, "dbg2       navlon:     %f\n", navlon);
-		fprintf(stderr, "dbg2       navlat:     %f\n", navlat);
-		fprintf(stderr, "dbg2       speed:      %f\n", speed);
-		fprintf(stderr, "dbg2       heading:    %f\n", heading);
-		fprintf(stderr, "dbg2       draft:      %f\n", draft);
-		fprintf(stderr, "dbg2       roll:       %f\n", roll);
-		fprintf(stderr, "dbg2       pitch:      %f\n", pitch);
-		fprintf(stderr, "dbg2       heave:      %f\n", heave);
+		fprintf(stderr, "dbg2       nmax:       %d\n", nmax);
 	}
 
 	/* get mbio descriptor */
@@ -8408,108 +10303,232 @@ int mbsys_reson7k_insert_nav(int verbose, void *mbio_ptr, void *store_ptr, int t
 	/* get data structure pointer */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
 	bathymetry = (s7kr_bathymetry *)&store->bathymetry;
+	bluefin = (s7kr_bluefin *)&store->bluefin;
 	position = (s7kr_position *)&store->position;
 	depth = (s7kr_depth *)&store->depth;
 	attitude = (s7kr_attitude *)&store->attitude;
 	reference = (s7kr_reference *)&store->reference;
+	navigation = &(store->navigation);
+	rollpitchheave = &(store->rollpitchheave);
 
-	/* insert data in ping structure */
-	if (store->kind == MB_DATA_DATA) {
-		/* get time */
-		for (i = 0; i < 7; i++)
-			store->time_i[i] = time_i[i];
-		store->time_d = time_d;
-
-		/* get navigation */
-		bathymetry->longitude = DTR * navlon;
-		bathymetry->latitude = DTR * navlat;
-
-		/* get heading */
-		bathymetry->heading = DTR * heading;
-
-		/* get speed  */
-
-		/* get draft  */
-		bathymetry->vehicle_height = reference->water_z - draft;
+	/* get data kind */
+	*kind = store->kind;
 
-		/* get roll pitch and heave */
-		bathymetry->heave = heave;
-		bathymetry->pitch = DTR * pitch;
-		bathymetry->roll = DTR * roll;
-	}
+	/* extract data from ping structure */
+	if (*kind == MB_DATA_DATA) {
+		/* just one navigation value */
+		*n = 1;
 
-	/* insert data in nav structure */
-	else if (store->kind == MB_DATA_NAV1) {
 		/* get time */
 		for (i = 0; i < 7; i++)
-			store->time_i[i] = time_i[i];
-		store->time_d = time_d;
+			time_i[i] = store->time_i[i];
+		time_d[0] = store->time_d;
 
-		/* get navigation */
-		position->longitude = DTR * navlon;
-		position->latitude = DTR * navlat;
+		/* get interpolated nav heading and speed  */
+		speed[0] = 0.0;
+		mb_hedint_interp(verbose, mbio_ptr, store->time_d, &(heading[0]), error);
+		mb_navint_interp(verbose, mbio_ptr, store->time_d, heading[0], speed[0], &(navlon[0]), &(navlat[0]), &(speed[0]), error);
 
 		/* get heading */
+		if (bathymetry->optionaldata == MB_YES)
+			heading[0] = RTD * bathymetry->heading;
 
-		/* get speed  */
+		/* get navigation */
+		if (bathymetry->optionaldata == MB_YES) {
+			navlon[0] = RTD * bathymetry->longitude;
+			navlat[0] = RTD * bathymetry->latitude;
+		}
 
 		/* get draft  */
-
-		/* get roll pitch and heave */
-	}
-
-	/* print output debug statements */
-	if (verbose >= 2) {
-		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
-		fprintf(stderr, "dbg2  Return value:\n");
-		fprintf(stderr, "dbg2       error:      %d\n", *error);
-		fprintf(stderr, "dbg2  Return status:\n");
-		fprintf(stderr, "dbg2       status:  %d\n", status);
+		if (bathymetry->optionaldata == MB_YES) {
+			draft[0] = -bathymetry->vehicle_height + reference->water_z;
+		}
+		else if (mb_io_ptr->nsonardepth > 0) {
+			mb_depint_interp(verbose, mbio_ptr, store->time_d, &(draft[0]), error);
+		}
+		else {
+			draft[0] = reference->water_z;
+		}
+
+		/* get attitude  */
+		if (bathymetry->optionaldata == MB_YES) {
+			roll[0] = RTD * bathymetry->roll;
+			pitch[0] = RTD * bathymetry->pitch;
+			heave[0] = bathymetry->heave;
+		}
+		else {
+			mb_attint_interp(verbose, mbio_ptr, store->time_d, &(heave[0]), &(roll[0]), &(pitch[0]), error);
+		}
+
+		/* done translating values */
 	}
 
-	/* return status */
-	return (status);
-}
-/*--------------------------------------------------------------------*/
-int mbsys_reson7k_extract_svp(int verbose, void *mbio_ptr, void *store_ptr, int *kind, int *nsvp, double *depth, double *velocity,
-                              int *error) {
-	char *function_name = "mbsys_reson7k_extract_svp";
-	int status = MB_SUCCESS;
-	struct mb_io_struct *mb_io_ptr;
-	struct mbsys_reson7k_struct *store;
-	s7kr_svp *svp;
-	int i;
+	/* extract data from nav structure */
+	else if (*kind == MB_DATA_NAV1) {
+		/* just one navigation value */
+		*n = 1;
 
-	/* print input debug statements */
-	if (verbose >= 2) {
-		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
-		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
-		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
-		fprintf(stderr, "dbg2       mb_ptr:     %p\n", (void *)mbio_ptr);
-		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+		/* get time */
+		for (i = 0; i < 7; i++)
+			time_i[i] = store->time_i[i];
+		time_d[0] = store->time_d;
+
+		/* get navigation and heading */
+		speed[0] = 0.0;
+		mb_hedint_interp(verbose, mbio_ptr, store->time_d, &(heading[0]), error);
+		mb_navint_interp(verbose, mbio_ptr, store->time_d, heading[0], speed[0], &(navlon[0]), &(navlat[0]), &(speed[0]), error);
+		navlon[0] = RTD * position->longitude;
+		navlat[0] = RTD * position->latitude;
+
+		/* get roll pitch and heave */
+		mb_attint_interp(verbose, mbio_ptr, *time_d, &(heave[0]), &(roll[0]), &(pitch[0]), error);
+
+		/* get draft  */
+		if (mb_io_ptr->nsonardepth > 0) {
+			mb_depint_interp(verbose, mbio_ptr, store->time_d, &draft[0], error);
+			heave[0] = 0.0;
+		}
+		else if (bathymetry->optionaldata == MB_YES) {
+			draft[0] = -bathymetry->vehicle_height + reference->water_z;
+			heave[0] = 0.0;
+		}
+		else {
+			draft[0] = reference->water_z;
+		}
+
+		/* done translating values */
 	}
 
-	/* get mbio descriptor */
-	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+	/* extract data from structure */
+	else if (*kind == MB_DATA_NAV2) {
+		/* get number of available navigation values */
+		if (bluefin->data_format == 0 && bluefin->number_frames > 0)
+			*n = bluefin->number_frames;
+		else
+			*n = 0;
 
-	/* get data structure pointer */
-	store = (struct mbsys_reson7k_struct *)store_ptr;
-	svp = (s7kr_svp *)&store->svp;
+		/* loop over navigation values */
+		for (inav = 0; inav < *n; inav++) {
+			/* get time */
+			time_d[inav] = bluefin->nav[inav].position_time;
+			mb_get_date(verbose, time_d[inav], &(time_i[7 * inav]));
 
-	/* get data kind */
-	*kind = store->kind;
+			/* get heading */
+			heading[inav] = RTD * bluefin->nav[inav].yaw;
+
+			/* get speed */
+			speed[inav] = 0.0;
+			mb_navint_interp(verbose, mbio_ptr, time_d[inav], heading[inav], speed[inav], &(navlon[inav]), &(navlat[inav]),
+			                 &(speed[inav]), error);
+
+			/* get navigation */
+			navlon[inav] = RTD * bluefin->nav[inav].longitude;
+			navlat[inav] = RTD * bluefin->nav[inav].latitude;
+
+			/* get roll pitch and heave */
+			roll[inav] = RTD * bluefin->nav[inav].roll;
+			pitch[inav] = RTD * bluefin->nav[inav].pitch;
+			heave[inav] = 0.0;
+
+			/* get draft  */
+			draft[inav] = bluefin->nav[inav].depth;
+		}
+
+		/* done translating values */
+	}
 
 	/* extract data from structure */
-	if (*kind == MB_DATA_VELOCITY_PROFILE) {
-		/* get number of depth-velocity pairs */
-		*nsvp = svp->n;
+	else if (*kind == MB_DATA_NAV3) {
+		/* get number of available navigation values */
+		*n = 1;
 
-		/* get profile */
-		for (i = 0; i < *nsvp; i++) {
-			depth[i] = svp->depth[i];
-			velocity[i] = svp->sound_velocity[i];
+		/* get time */
+		for (i = 0; i < 7; i++)
+			time_i[i] = store->time_i[i];
+		time_d[0] = store->time_d;
+
+		/* get navigation */
+		navlon[0] = RTD * navigation->longitude;
+		navlat[0] = RTD * navigation->latitude;
+
+		/* get speed  */
+		speed[0] = 0.0;
+
+		/* get heading */
+		if (mb_io_ptr->nheading > 0)
+			mb_hedint_interp(verbose, mbio_ptr, store->time_d, heading, error);
+		else if (bathymetry->optionaldata == MB_YES)
+			heading[0] = RTD * bathymetry->heading;
+
+		/* get draft  */
+		if (mb_io_ptr->nsonardepth > 0) {
+			mb_depint_interp(verbose, mbio_ptr, store->time_d, &(draft[0]), error);
+		}
+		else if (bathymetry->optionaldata == MB_YES) {
+			draft[0] = -bathymetry->vehicle_height + reference->water_z;
+		}
+		else {
+			draft[0] = reference->water_z;
+		}
+
+		/* get attitude  */
+		if (mb_io_ptr->nattitude > 0) {
+			mb_attint_interp(verbose, mbio_ptr, store->time_d, &(heave[0]), &(roll[0]), &(pitch[0]), error);
+		}
+		else if (bathymetry->optionaldata == MB_YES) {
+			roll[0] = RTD * bathymetry->roll;
+			pitch[0] = RTD * bathymetry->pitch;
+			heave[0] = bathymetry->heave;
+		}
+		else {
+			roll[0] = 0.0;
+			pitch[0] = 0.0;
+			heave[0] = 0.0;
+		}
+
+		/* done translating values */
+	}
+
+	/* extract data from attitude structure */
+	else if (*kind == MB_DATA_ATTITUDE) {
+		/* just one navigation value */
+		*n = 1;
+
+		/* get time */
+		for (i = 0; i < 7; i++)
+			time_i[i] = store->time_i[i];
+		time_d[0] = store->time_d;
+
+		/* get interpolated nav heading and speed  */
+		speed[0] = 0.0;
+		heading[0] = 0.0;
+		if (mb_io_ptr->nheading > 0)
+			mb_hedint_interp(verbose, mbio_ptr, store->time_d, &(heading[0]), error);
+		else if (bathymetry->optionaldata == MB_YES)
+			heading[0] = RTD * bathymetry->heading;
+		if (mb_io_ptr->nfix > 0)
+			mb_navint_interp(verbose, mbio_ptr, store->time_d, heading[0], speed[0], &(navlon[0]), &(navlat[0]), &(speed[0]),
+			                 error);
+		else if (bathymetry->optionaldata == MB_YES) {
+			navlon[0] = RTD * bathymetry->longitude;
+			navlat[0] = RTD * bathymetry->latitude;
+		}
+
+		/* get draft  */
+		if (mb_io_ptr->nsonardepth > 0) {
+			mb_depint_interp(verbose, mbio_ptr, store->time_d, &(draft[0]), error);
 		}
+		else if (bathymetry->optionaldata == MB_YES) {
+			draft[0] = -bathymetry->vehicle_height + reference->water_z;
+		}
+		else {
+			draft[0] = reference->water_z;
+		}
+
+		/* get attitude  */
+		roll[0] = RTD * rollpitchheave->roll;
+		pitch[0] = RTD * rollpitchheave->pitch;
+		heave[0] = rollpitchheave->heave;
 
 		/* done translating values */
 	}
@@ -8519,6 +10538,11 @@ int mbsys_reson7k_extract_svp(int verbose, void *mbio_ptr, void *store_ptr, int
 		/* set status */
 		*error = MB_ERROR_COMMENT;
 		status = MB_FAILURE;
+
+		/* get time */
+		for (i = 0; i < 7; i++)
+			time_i[i] = store->time_i[i];
+		*time_d = store->time_d;
 	}
 
 	/* deal with other record type */
@@ -8526,32 +10550,55 @@ int mbsys_reson7k_extract_svp(int verbose, void *mbio_ptr, void *store_ptr, int
 		/* set status */
 		*error = MB_ERROR_OTHER;
 		status = MB_FAILURE;
+
+		/* get number of available navigation values */
+		*n = 1;
+
+		/* get time */
+		for (i = 0; i < 7; i++)
+			time_i[i] = store->time_i[i];
+		*time_d = store->time_d;
 	}
 
 	/* print output debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       kind:              %d\n", *kind);
-		fprintf(stderr, "dbg2       nsvp:              %d\n", *nsvp);
-		for (i = 0; i < *nsvp; i++)
-			fprintf(stderr, "dbg2       depth[%d]: %f   velocity[%d]: %f\n", i, depth[i], i, velocity[i]);
-		fprintf(stderr, "dbg2       error:             %d\n", *error);
+		fprintf(stderr, "dbg2       kind:       %d\n", *kind);
+		fprintf(stderr, "dbg2       n:          %d\n", *n);
+		for (inav = 0; inav < *n; inav++) {
+			for (i = 0; i < 7; i++)
+				fprintf(stderr, "dbg2       %d time_i[%d]:     %d\n", inav, i, time_i[inav * 7 + i]);
+			fprintf(stderr, "dbg2       %d time_d:        %f\n", inav, time_d[inav]);
+			fprintf(stderr, "dbg2       %d longitude:     %f\n", inav, navlon[inav]);
+			fprintf(stderr, "dbg2       %d latitude:      %f\n", inav, navlat[inav]);
+			fprintf(stderr, "dbg2       %d speed:         %f\n", inav, speed[inav]);
+			fprintf(stderr, "dbg2       %d heading:       %f\n", inav, heading[inav]);
+			fprintf(stderr, "dbg2       %d draft:         %f\n", inav, draft[inav]);
+			fprintf(stderr, "dbg2       %d roll:          %f\n", inav, roll[inav]);
+			fprintf(stderr, "dbg2       %d pitch:         %f\n", inav, pitch[inav]);
+			fprintf(stderr, "dbg2       %d heave:         %f\n", inav, heave[inav]);
+		}
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
-		fprintf(stderr, "dbg2       status:            %d\n", status);
+		fprintf(stderr, "dbg2       status:     %d\n", status);
 	}
 
 	/* return status */
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_insert_svp(int verbose, void *mbio_ptr, void *store_ptr, int nsvp, double *depth, double *velocity,
-                             int *error) {
-	char *function_name = "mbsys_reson7k_insert_svp";
+int mbsys_reson7k_extract_attitude(int verbose, void *mbio_ptr, void *store_ptr, int *kind, int nmax, int *n, int *fieldmask,
+                                   double *time_d, double *roll, double *pitch, double *heave, double *heading, int *error) {
+	char *function_name = "mbsys_reson7k_extract_attitude";
 	int status = MB_SUCCESS;
-	struct mb_io_struct *mb_io_ptr;
 	struct mbsys_reson7k_struct *store;
-	s7kr_svp *svp;
+	s7kr_attitude *attitude;
+	s7kr_rollpitchheave *rollpitchheave;
+	s7kr_customattitude *customattitude;
+	s7kr_heading *dheading;
+	s7kr_v2pingmotion *v2pingmotion;
+	double dtime;
 	int i;
 
 	/* print input debug statements */
@@ -8560,336 +10607,438 @@ int mbsys_reson7k_insert_svp(int verbose, void *mbio_ptr, void *store_ptr, int n
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
-		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       mb_ptr:     %p\n", (void *)mbio_ptr);
 		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
-		fprintf(stderr, "dbg2       nsvp:       %d\n", nsvp);
-		for (i = 0; i < nsvp; i++)
-			fprintf(stderr, "dbg2       depth[%d]: %f   velocity[%d]: %f\n", i, depth[i], i, velocity[i]);
+		fprintf(stderr, "dbg2       nmax:       %d\n", nmax);
 	}
 
-	/* get mbio descriptor */
-	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
-
 	/* get data structure pointer */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	svp = (s7kr_svp *)&store->svp;
 
-	/* insert data in structure */
-	if (store->kind == MB_DATA_VELOCITY_PROFILE) {
-		/* allocate memory if necessary */
-		if (svp->nalloc < nsvp) {
-			status = mb_reallocd(verbose, __FILE__, __LINE__, nsvp * sizeof(float), (void **)&(svp->depth), error);
-			status = mb_reallocd(verbose, __FILE__, __LINE__, nsvp * sizeof(float), (void **)&(svp->sound_velocity), error);
-			if (status == MB_SUCCESS) {
-				svp->nalloc = nsvp;
-			}
-			else {
-				svp->n = 0;
-				svp->nalloc = 0;
-			}
+	/* get data kind */
+	*kind = store->kind;
+	*n = 0;
+	*fieldmask = 0;
+
+	/* the whole series of the record is returned, up to nmax samples, with
+	    absolute times and with angles in degrees - fields the record does
+	    not hold are left out of fieldmask and returned as zero */
+	if (store->kind == MB_DATA_ATTITUDE && store->type == R7KRECID_Attitude) {
+		attitude = &(store->attitude);
+		*n = MIN((int)attitude->n, nmax);
+		*fieldmask = MBSYS_RESON7K_ATTITUDE_RPH | MBSYS_RESON7K_ATTITUDE_HEADING;
+		for (i = 0; i < *n; i++) {
+			time_d[i] = store->time_d + 0.001 * ((double)attitude->delta_time[i]);
+			roll[i] = RTD * attitude->roll[i];
+			pitch[i] = RTD * attitude->pitch[i];
+			heave[i] = attitude->heave[i];
+			heading[i] = RTD * attitude->heading[i];
 		}
-
-		/* get profile */
-		if (status == MB_SUCCESS) {
-			svp->n = nsvp;
-			for (i = 0; i < svp->n; i++) {
-				svp->depth[i] = depth[i];
-				svp->sound_velocity[i] = velocity[i];
-			}
+	}
+	else if (store->kind == MB_DATA_ATTITUDE && store->type == R7KRECID_RollPitchHeave) {
+		rollpitchheave = &(store->rollpitchheave);
+		*n = MIN(1, nmax);
+		*fieldmask = MBSYS_RESON7K_ATTITUDE_RPH;
+		for (i = 0; i < *n; i++) {
+			time_d[i] = store->time_d;
+			roll[i] = RTD * rollpitchheave->roll;
+			pitch[i] = RTD * rollpitchheave->pitch;
+			heave[i] = rollpitchheave->heave;
+			heading[i] = 0.0;
+		}
+	}
+	else if (store->kind == MB_DATA_ATTITUDE && store->type == R7KRECID_CustomAttitude) {
+		customattitude = &(store->customattitude);
+		*n = MIN((int)customattitude->n, nmax);
+		if (customattitude->fieldmask & 1)
+			*fieldmask |= MBSYS_RESON7K_ATTITUDE_PITCH;
+		if (customattitude->fieldmask & 2)
+			*fieldmask |= MBSYS_RESON7K_ATTITUDE_ROLL;
+		if (customattitude->fieldmask & 4)
+			*fieldmask |= MBSYS_RESON7K_ATTITUDE_HEADING;
+		if (customattitude->fieldmask & 8)
+			*fieldmask |= MBSYS_RESON7K_ATTITUDE_HEAVE;
+		dtime = (customattitude->frequency > 0.0 ? 1.0 / ((double)customattitude->frequency) : 0.0);
+		for (i = 0; i < *n; i++) {
+			time_d[i] = store->time_d + ((double)i) * dtime;
+			roll[i] = (*fieldmask & MBSYS_RESON7K_ATTITUDE_ROLL ? RTD * customattitude->roll[i] : 0.0);
+			pitch[i] = (*fieldmask & MBSYS_RESON7K_ATTITUDE_PITCH ? RTD * customattitude->pitch[i] : 0.0);
+			heave[i] = (*fieldmask & MBSYS_RESON7K_ATTITUDE_HEAVE ? customattitude->heave[i] : 0.0);
+			heading[i] = (*fieldmask & MBSYS_RESON7K_ATTITUDE_HEADING ? RTD * customattitude->heading[i] : 0.0);
+		}
+	}
+	else if (store->kind == MB_DATA_HEADING && store->type == R7KRECID_Heading) {
+		dheading = &(store->heading);
+		*n = MIN(1, nmax);
+		*fieldmask = MBSYS_RESON7K_ATTITUDE_HEADING;
+		for (i = 0; i < *n; i++) {
+			time_d[i] = store->time_d;
+			roll[i] = 0.0;
+			pitch[i] = 0.0;
+			heave[i] = 0.0;
+			heading[i] = RTD * dheading->heading;
+		}
+	}
+	else if (store->kind == MB_DATA_DATA && (store->read_mask & R7KREAD_V2PingMotion)) {
+		/* the 7012 record holds one pitch for the ping and the other
+		    fields at the sonar sample rate from the ping time */
+		v2pingmotion = &(store->v2pingmotion);
+		*n = MIN((int)v2pingmotion->n, nmax);
+		if (v2pingmotion->flags & 1)
+			*fieldmask |= MBSYS_RESON7K_ATTITUDE_PITCH;
+		if (v2pingmotion->flags & 2)
+			*fieldmask |= MBSYS_RESON7K_ATTITUDE_ROLL;
+		if (v2pingmotion->flags & 4)
+			*fieldmask |= MBSYS_RESON7K_ATTITUDE_HEADING;
+		if (v2pingmotion->flags & 8)
+			*fieldmask |= MBSYS_RESON7K_ATTITUDE_HEAVE;
+		dtime = (v2pingmotion->frequency > 0.0 ? 1.0 / ((double)v2pingmotion->frequency) : 0.0);
+		for (i = 0; i < *n; i++) {
+			time_d[i] = store->time_d + ((double)i) * dtime;
+			roll[i] = (*fieldmask & MBSYS_RESON7K_ATTITUDE_ROLL ? RTD * v2pingmotion->roll[i] : 0.0);
+			pitch[i] = (*fieldmask & MBSYS_RESON7K_ATTITUDE_PITCH ? RTD * v2pingmotion->pitch : 0.0);
+			heave[i] = (*fieldmask & MBSYS_RESON7K_ATTITUDE_HEAVE ? v2pingmotion->heave[i] : 0.0);
+			heading[i] = (*fieldmask & MBSYS_RESON7K_ATTITUDE_HEADING ? RTD * v2pingmotion->heading[i] : 0.0);
 		}
 	}
 
+	/* deal with comment */
+	else if (*kind == MB_DATA_COMMENT) {
+		/* set status */
+		*error = MB_ERROR_COMMENT;
+		status = MB_FAILURE;
+	}
+
+	/* deal with other record type */
+	else {
+		/* set status */
+		*error = MB_ERROR_OTHER;
+		status = MB_FAILURE;
+	}
+
 	/* print output debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
-		fprintf(stderr, "dbg2  Return value:\n");
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       kind:       %d\n", *kind);
+		fprintf(stderr, "dbg2       n:          %d\n", *n);
+		fprintf(stderr, "dbg2       fieldmask:  %d\n", *fieldmask);
+		for (i = 0; i < *n; i++)
+			fprintf(stderr, "dbg2       %d time_d:%f roll:%f pitch:%f heave:%f heading:%f\n", i, time_d[i], roll[i], pitch[i],
+			        heave[i], heading[i]);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
-		fprintf(stderr, "dbg2       status:  %d\n", status);
+		fprintf(stderr, "dbg2       status:     %d\n", status);
 	}
 
 	/* return status */
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_extract_segytraceheader(int verbose, void *mbio_ptr, void *store_ptr, int *kind, void *segytraceheader_ptr,
+int mbsys_reson7k_extract_attitude_window(int verbose, void *mbio_ptr, double time_start, double time_end, int nmax, int *n,
+                                          double *time_d, double *roll, double *pitch, double *heave, double *heading,
                                           int *error) {
-	char *function_name = "mbsys_reson7k_extract_segytraceheader";
+	char *function_name = "mbsys_reson7k_extract_attitude_window";
 	int status = MB_SUCCESS;
 	struct mb_io_struct *mb_io_ptr;
-	struct mbsys_reson7k_struct *store;
-	struct mb_segytraceheader_struct *mb_segytraceheader_ptr;
-	s7k_header *header;
-	s7kr_bathymetry *bathymetry;
-	s7kr_bluefin *bluefin;
-	s7kr_fsdwsb *fsdwsb;
-	s7k_fsdwchannel *fsdwchannel;
-	s7k_fsdwsegyheader *fsdwsegyheader;
-	s7kr_ctd *ctd;
-	double dsonardepth, dsonaraltitude, dwaterdepth;
-	int sonardepth, waterdepth;
-	int watersoundspeed;
-	float fwatertime;
-	double longitude, latitude;
-	double speed, heading;
-	double roll, pitch, heave;
-	double xtrackmin;
-	int time_j[5];
-	int i;
+	struct mbsys_reson7k_struct *ostore;
+	s7k_attitudeseries *attitudeseries;
+	double *yd;
+	double dheading;
+	int jheading;
+	int i, ilo, ihi, k;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:        %d\n", verbose);
-		fprintf(stderr, "dbg2       mb_ptr:         %p\n", (void *)mbio_ptr);
-		fprintf(stderr, "dbg2       store_ptr:      %p\n", (void *)store_ptr);
-		fprintf(stderr, "dbg2       kind:           %d\n", *kind);
-		fprintf(stderr, "dbg2       segytraceheader_ptr: %p\n", (void *)segytraceheader_ptr);
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mb_ptr:     %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       time_start: %f\n", time_start);
+		fprintf(stderr, "dbg2       time_end:   %f\n", time_end);
+		fprintf(stderr, "dbg2       nmax:       %d\n", nmax);
 	}
 
 	/* get mbio descriptor */
 	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+	ostore = (struct mbsys_reson7k_struct *)mb_io_ptr->store_data;
+	attitudeseries = &(ostore->attitudeseries);
+	*n = 0;
+
+	/* find the first attitude sample of the window - the samples held for
+	    interpolation are in time order */
+	ilo = 0;
+	ihi = mb_io_ptr->nattitude;
+	while (ilo < ihi) {
+		i = (ilo + ihi) / 2;
+		if (mb_io_ptr->attitude_time_d[i] < time_start)
+			ilo = i + 1;
+		else
+			ihi = i;
+	}
+
+	/* copy the attitude samples of the window */
+	for (i = ilo; i < mb_io_ptr->nattitude && mb_io_ptr->attitude_time_d[i] <= time_end && *n < nmax; i++) {
+		time_d[*n] = mb_io_ptr->attitude_time_d[i];
+		roll[*n] = mb_io_ptr->attitude_roll[i];
+		pitch[*n] = mb_io_ptr->attitude_pitch[i];
+		heave[*n] = mb_io_ptr->attitude_heave[i];
+		(*n)++;
+	}
+
+	/* interpolate heading at the attitude times, taking the shorter way
+	    around the circle as mb_linear_interp_heading() does */
+	if (*n > 0 && mb_io_ptr->nheading > 0)
+		status = mbsys_reson7k_alloc_attitudeseries(verbose, attitudeseries, *n, error);
+	if (*n > 0 && mb_io_ptr->nheading > 0 && status == MB_SUCCESS) {
+		jheading = 0;
+		mbsys_reson7k_interp_bracket(mb_io_ptr->nheading, mb_io_ptr->heading_time_d, *n, time_d, &jheading,
+		                             attitudeseries->index, attitudeseries->weight);
+		k = MIN(1, mb_io_ptr->nheading - 1);
+		yd = mb_io_ptr->heading_heading;
+		for (i = 0; i < *n; i++) {
+			dheading = yd[attitudeseries->index[i] + k] - yd[attitudeseries->index[i]];
+			if (dheading > 180.0)
+				dheading -= 360.0;
+			else if (dheading < -180.0)
+				dheading += 360.0;
+			heading[i] = yd[attitudeseries->index[i]] + attitudeseries->weight[i] * dheading;
+			if (heading[i] < 0.0)
+				heading[i] += 360.0;
+			else if (heading[i] >= 360.0)
+				heading[i] -= 360.0;
+		}
+	}
+	else {
+		for (i = 0; i < *n; i++)
+			heading[i] = 0.0;
+	}
 
-	/* get data structure pointer */
-	store = (struct mbsys_reson7k_struct *)store_ptr;
-
-	/* get data kind */
-	*kind = store->kind;
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       n:          %d\n", *n);
+		for (i = 0; i < *n; i++)
+			fprintf(stderr, "dbg2       %d time_d:%f roll:%f pitch:%f heave:%f heading:%f\n", i, time_d[i], roll[i], pitch[i],
+			        heave[i], heading[i]);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
 
-	/* extract data from structure */
-	if (*kind == MB_DATA_SUBBOTTOM_SUBBOTTOM) {
-		/* get relevant structures */
-		mb_segytraceheader_ptr = (struct mb_segytraceheader_struct *)segytraceheader_ptr;
-		bathymetry = &(store->bathymetry);
-		bluefin = &(store->bluefin);
-		ctd = &(store->ctd);
-		fsdwsb = &(store->fsdwsb);
-		header = &(fsdwsb->header);
-		fsdwchannel = &(fsdwsb->channel);
-		fsdwsegyheader = &(fsdwsb->segyheader);
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_attitude_append(int verbose, void *mbio_ptr, int n, int fieldmask, double *time_d, double *roll,
+                                  double *pitch, double *heave, double *heading, int *error) {
+	char *function_name = "mbsys_reson7k_attitude_append";
+	int status = MB_SUCCESS;
+	struct mb_io_struct *mb_io_ptr;
+	struct mbsys_reson7k_struct *ostore;
+	double *values[MBSYS_RESON7K_TSERIES_FIELDS];
+	double tstart, tlast;
+	int nheld, nadd, nskip, nkeep, shift;
+	int i, k;
 
-		/* get needed values */
-		mb_depint_interp(verbose, mbio_ptr, store->time_d, &dsonardepth, error);
-		mb_altint_interp(verbose, mbio_ptr, store->time_d, &dsonaraltitude, error);
-		dwaterdepth = dsonardepth + dsonaraltitude;
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mb_ptr:     %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       n:          %d\n", n);
+		fprintf(stderr, "dbg2       fieldmask:  %d\n", fieldmask);
+		for (i = 0; i < n; i++)
+			fprintf(stderr, "dbg2       %d time_d:%f roll:%f pitch:%f heave:%f heading:%f\n", i, time_d[i], roll[i], pitch[i],
+			        heave[i], heading[i]);
+	}
 
-		/* if possible get altitude from nadir of multibeam bathymetry */
-		if (bathymetry->optionaldata == MB_YES) {
-			/* get depth closest to nadir */
-			xtrackmin = 999999.9;
-			for (i = 0; i < bathymetry->number_beams; i++) {
-				if (((bathymetry->quality[i] & 15) == 15) && fabs((double)bathymetry->acrosstrack[i]) < xtrackmin) {
-					dwaterdepth = bathymetry->depth[i];
-					dsonaraltitude = bathymetry->depth[i] - dsonardepth;
-					xtrackmin = fabs((double)bathymetry->acrosstrack[i]);
+	/* get mbio descriptor and the time series of the handle */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+	ostore = (struct mbsys_reson7k_struct *)mb_io_ptr->store_data;
+
+	/* append the series to the interpolation buffers in the manner of
+	    mb_attint_add() and mb_hedint_add() - samples not later than the last
+	    one held are skipped. Unlike those functions, a full buffer is not
+	    cut by half; only as many of the oldest samples are discarded as are
+	    needed to make room, so the buffers always hold the latest
+	    MB_ASYNCH_SAVE_MAX samples. The samples to be added are counted
+	    first so that each buffer is shifted at most once per call. */
+	if (fieldmask & MBSYS_RESON7K_ATTITUDE_RPH) {
+		nheld = mb_io_ptr->nattitude;
+		tstart = (nheld > 0 ? mb_io_ptr->attitude_time_d[nheld - 1] : 0.0);
+		nadd = 0;
+		tlast = tstart;
+		for (i = 0; i < n; i++) {
+			if ((nheld == 0 && nadd == 0) || time_d[i] > tlast) {
+				tlast = time_d[i];
+				nadd++;
+			}
+		}
+		nskip = MAX(nadd - MB_ASYNCH_SAVE_MAX, 0);
+		shift = MIN(MAX(nheld + nadd - MB_ASYNCH_SAVE_MAX, 0), nheld);
+		if (shift > 0) {
+			nkeep = nheld - shift;
+			memmove(&mb_io_ptr->attitude_time_d[0], &mb_io_ptr->attitude_time_d[shift], nkeep * sizeof(double));
+			memmove(&mb_io_ptr->attitude_heave[0], &mb_io_ptr->attitude_heave[shift], nkeep * sizeof(double));
+			memmove(&mb_io_ptr->attitude_roll[0], &mb_io_ptr->attitude_roll[shift], nkeep * sizeof(double));
+			memmove(&mb_io_ptr->attitude_pitch[0], &mb_io_ptr->attitude_pitch[shift], nkeep * sizeof(double));
+			mb_io_ptr->nattitude = nkeep;
+		}
+		nadd = 0;
+		tlast = tstart;
+		for (i = 0; i < n; i++) {
+			if ((nheld == 0 && nadd == 0) || time_d[i] > tlast) {
+				tlast = time_d[i];
+				nadd++;
+				if (nadd > nskip) {
+					k = mb_io_ptr->nattitude;
+					mb_io_ptr->attitude_time_d[k] = time_d[i];
+					mb_io_ptr->attitude_heave[k] = heave[i];
+					mb_io_ptr->attitude_roll[k] = roll[i];
+					mb_io_ptr->attitude_pitch[k] = pitch[i];
+					mb_io_ptr->nattitude++;
 				}
 			}
 		}
-
-		/* get needed values */
-		sonardepth = (int)(100 * dsonardepth);
-		waterdepth = (int)(100 * dwaterdepth);
-		if (ctd->n > 0)
-			watersoundspeed = (int)(ctd->sound_velocity[ctd->n - 1]);
-		else if (bluefin->environmental[0].sound_speed > 0.0)
-			watersoundspeed = (int)(bluefin->environmental[0].sound_speed);
-		else
-			watersoundspeed = 1500;
-		fwatertime = 2.0 * dwaterdepth / ((double)watersoundspeed);
-
-		mb_hedint_interp(verbose, mbio_ptr, store->time_d, &heading, error);
-		speed = 0.0;
-		mb_navint_interp(verbose, mbio_ptr, store->time_d, heading, speed, &longitude, &latitude, &speed, error);
-		mb_attint_interp(verbose, mbio_ptr, store->time_d, &heave, &roll, &pitch, error);
-		if (longitude == 0.0 && latitude == 0.0 && bathymetry->longitude != 0.0 && bathymetry->latitude != 0.0) {
-			longitude = RTD * bathymetry->longitude;
-			latitude = RTD * bathymetry->latitude;
+	}
+	if (fieldmask & MBSYS_RESON7K_ATTITUDE_HEADING) {
+		nheld = mb_io_ptr->nheading;
+		tstart = (nheld > 0 ? mb_io_ptr->heading_time_d[nheld - 1] : 0.0);
+		nadd = 0;
+		tlast = tstart;
+		for (i = 0; i < n; i++) {
+			if ((nheld == 0 && nadd == 0) || time_d[i] > tlast) {
+				tlast = time_d[i];
+				nadd++;
+			}
 		}
-		mb_get_jtime(verbose, store->time_i, time_j);
-
-		/* extract the data */
-		mb_segytraceheader_ptr->seq_num = fsdwsb->ping_number;
-		mb_segytraceheader_ptr->seq_reel = fsdwsb->ping_number;
-		mb_segytraceheader_ptr->shot_num = fsdwsb->ping_number;
-		mb_segytraceheader_ptr->shot_tr = 1;
-		mb_segytraceheader_ptr->espn = 0;
-		mb_segytraceheader_ptr->rp_num = fsdwsb->ping_number;
-		mb_segytraceheader_ptr->rp_tr = 1;
-		mb_segytraceheader_ptr->trc_id = 1;
-		mb_segytraceheader_ptr->num_vstk = 0;
-		mb_segytraceheader_ptr->cdp_fold = 0;
-		mb_segytraceheader_ptr->use = fsdwsb->data_format;
-		mb_segytraceheader_ptr->range = 0;
-		mb_segytraceheader_ptr->grp_elev = -sonardepth;
-		mb_segytraceheader_ptr->src_elev = -sonardepth;
-		mb_segytraceheader_ptr->src_depth = sonardepth;
-		mb_segytraceheader_ptr->grp_datum = 0;
-		mb_segytraceheader_ptr->src_datum = 0;
-		mb_segytraceheader_ptr->src_wbd = waterdepth;
-		mb_segytraceheader_ptr->grp_wbd = waterdepth;
-		mb_segytraceheader_ptr->elev_scalar = -100; /* 0.01 m precision for depths */
-		mb_segytraceheader_ptr->coord_scalar = -100; /* 0.01 arc second precision for position
-		                     = 0.3 m precision at equator */
-		mb_segytraceheader_ptr->src_long = (int)(longitude * 360000.0);
-		mb_segytraceheader_ptr->src_lat = (int)(latitude * 360000.0);
-		mb_segytraceheader_ptr->grp_long = (int)(longitude * 360000.0);
-		mb_segytraceheader_ptr->grp_lat = (int)(latitude * 360000.0);
-		mb_segytraceheader_ptr->coord_units = 2;
-		mb_segytraceheader_ptr->wvel = watersoundspeed;
-		mb_segytraceheader_ptr->sbvel = 0;
-		mb_segytraceheader_ptr->src_up_vel = 0;
-		mb_segytraceheader_ptr->grp_up_vel = 0;
-		mb_segytraceheader_ptr->src_static = 0;
-		mb_segytraceheader_ptr->grp_static = 0;
-		mb_segytraceheader_ptr->tot_static = 0;
-		mb_segytraceheader_ptr->laga = 0;
-		mb_segytraceheader_ptr->delay_mils = 0;
-		mb_segytraceheader_ptr->smute_mils = 0;
-		mb_segytraceheader_ptr->emute_mils = 0;
-		mb_segytraceheader_ptr->nsamps = fsdwchannel->number_samples;
-		mb_segytraceheader_ptr->si_micros = fsdwchannel->sample_interval;
-		for (i = 0; i < 19; i++)
-			mb_segytraceheader_ptr->other_1[i] = 0;
-		mb_segytraceheader_ptr->year = store->time_i[0];
-		mb_segytraceheader_ptr->day_of_yr = time_j[1];
-		mb_segytraceheader_ptr->hour = store->time_i[3];
-		mb_segytraceheader_ptr->min = store->time_i[4];
-		mb_segytraceheader_ptr->sec = store->time_i[5];
-		mb_segytraceheader_ptr->mils = store->time_i[6] / 1000;
-		mb_segytraceheader_ptr->tr_weight = 1;
-		for (i = 0; i < 5; i++)
-			mb_segytraceheader_ptr->other_2[i] = 0;
-		mb_segytraceheader_ptr->delay = 0.0;
-		mb_segytraceheader_ptr->smute_sec = 0.0;
-		mb_segytraceheader_ptr->emute_sec = 0.0;
-		mb_segytraceheader_ptr->si_secs = 0.000001 * ((float)fsdwchannel->sample_interval);
-		mb_segytraceheader_ptr->wbt_secs = fwatertime;
-		mb_segytraceheader_ptr->end_of_rp = 0;
-		mb_segytraceheader_ptr->dummy1 = 0.0;
-		mb_segytraceheader_ptr->dummy2 = 0.0;
-		mb_segytraceheader_ptr->dummy3 = 0.0;
-		mb_segytraceheader_ptr->dummy4 = 0.0;
-		mb_segytraceheader_ptr->soundspeed = watersoundspeed;
-		mb_segytraceheader_ptr->distance = 0.0;
-		mb_segytraceheader_ptr->roll = (float)roll;
-		mb_segytraceheader_ptr->pitch = (float)pitch;
-		mb_segytraceheader_ptr->heading = (float)heading;
+		nskip = MAX(nadd - MB_ASYNCH_SAVE_MAX, 0);
+		shift = MIN(MAX(nheld + nadd - MB_ASYNCH_SAVE_MAX, 0), nheld);
+		if (shift > 0) {
+			nkeep = nheld - shift;
+			memmove(&mb_io_ptr->heading_time_d[0], &mb_io_ptr->heading_time_d[shift], nkeep * sizeof(double));
+			memmove(&mb_io_ptr->heading_heading[0], &mb_io_ptr->heading_heading[shift], nkeep * sizeof(double));
+			mb_io_ptr->nheading = nkeep;
+		}
+		nadd = 0;
+		tlast = tstart;
+		for (i = 0; i < n; i++) {
+			if ((nheld == 0 && nadd == 0) || time_d[i] > tlast) {
+				tlast = time_d[i];
+				nadd++;
+				if (nadd > nskip) {
+					k = mb_io_ptr->nheading;
+					mb_io_ptr->heading_time_d[k] = time_d[i];
+					mb_io_ptr->heading_heading[k] = heading[i];
+					mb_io_ptr->nheading++;
+				}
+			}
+		}
+	}
+	*error = MB_ERROR_NO_ERROR;
 
-		/* done translating values */
+	/* append the series to the time series of the handle as well */
+	if (fieldmask & MBSYS_RESON7K_ATTITUDE_RPH) {
+		values[0] = roll;
+		values[1] = pitch;
+		values[2] = heave;
+		status = mbsys_reson7k_tseries_append(verbose, &(ostore->tseries[MBSYS_RESON7K_TSERIES_ATTITUDE]), n, time_d, values,
+		                                      error);
+	}
+	if (status == MB_SUCCESS && (fieldmask & MBSYS_RESON7K_ATTITUDE_HEADING)) {
+		values[0] = heading;
+		status = mbsys_reson7k_tseries_append(verbose, &(ostore->tseries[MBSYS_RESON7K_TSERIES_HEADING]), n, time_d, values,
+		                                      error);
 	}
 
-	/* deal with comment */
-	else if (*kind == MB_DATA_COMMENT) {
-		/* set status */
-		*error = MB_ERROR_COMMENT;
-		status = MB_FAILURE;
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       nattitude:  %d\n", mb_io_ptr->nattitude);
+		fprintf(stderr, "dbg2       nheading:   %d\n", mb_io_ptr->nheading);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
 	}
 
-	/* deal with other record type */
-	else {
-		/* set status */
-		*error = MB_ERROR_OTHER;
-		status = MB_FAILURE;
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_attitude_append_record(int verbose, void *mbio_ptr, void *store_ptr, int *error) {
+	char *function_name = "mbsys_reson7k_attitude_append_record";
+	int status = MB_SUCCESS;
+	struct mb_io_struct *mb_io_ptr;
+	struct mbsys_reson7k_struct *store;
+	struct mbsys_reson7k_struct *ostore;
+	s7k_attitudeseries *attitudeseries;
+	int kind, n, nsamples, fieldmask;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mb_ptr:     %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+	}
+
+	/* get mbio descriptor and the scratch arrays of the handle */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+	ostore = (struct mbsys_reson7k_struct *)mb_io_ptr->store_data;
+	attitudeseries = &(ostore->attitudeseries);
+
+	/* only the attitude and heading records are appended - the 7012 ping
+	    motion of survey pings is left out of the interpolation buffers */
+	nsamples = 0;
+	if (store->kind == MB_DATA_ATTITUDE && store->type == R7KRECID_Attitude)
+		nsamples = store->attitude.n;
+	else if (store->kind == MB_DATA_ATTITUDE && store->type == R7KRECID_CustomAttitude)
+		nsamples = store->customattitude.n;
+	else if ((store->kind == MB_DATA_ATTITUDE && store->type == R7KRECID_RollPitchHeave)
+	         || (store->kind == MB_DATA_HEADING && store->type == R7KRECID_Heading))
+		nsamples = 1;
+
+	/* extract the series and append it in one call */
+	if (nsamples > 0) {
+		status = mbsys_reson7k_alloc_attitudeseries(verbose, attitudeseries, nsamples, error);
+		if (status == MB_SUCCESS)
+			status = mbsys_reson7k_extract_attitude(verbose, mbio_ptr, store_ptr, &kind, attitudeseries->nalloc, &n, &fieldmask,
+			                                        attitudeseries->time_d, attitudeseries->roll, attitudeseries->pitch,
+			                                        attitudeseries->heave, attitudeseries->heading, error);
+		if (status == MB_SUCCESS)
+			status = mbsys_reson7k_attitude_append(verbose, mbio_ptr, n, fieldmask, attitudeseries->time_d,
+			                                       attitudeseries->roll, attitudeseries->pitch, attitudeseries->heave,
+			                                       attitudeseries->heading, error);
 	}
 
 	/* print output debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       kind:              %d\n", *kind);
-		if (*kind == MB_DATA_SUBBOTTOM_SUBBOTTOM) {
-			mb_segytraceheader_ptr = (struct mb_segytraceheader_struct *)segytraceheader_ptr;
-			fprintf(stderr, "dbg2       seq_num:           %d\n", mb_segytraceheader_ptr->seq_num);
-			fprintf(stderr, "dbg2       seq_reel:          %d\n", mb_segytraceheader_ptr->seq_reel);
-			fprintf(stderr, "dbg2       shot_num:          %d\n", mb_segytraceheader_ptr->shot_num);
-			fprintf(stderr, "dbg2       shot_tr:           %d\n", mb_segytraceheader_ptr->shot_tr);
-			fprintf(stderr, "dbg2       espn:              %d\n", mb_segytraceheader_ptr->espn);
-			fprintf(stderr, "dbg2       rp_num:            %d\n", mb_segytraceheader_ptr->rp_num);
-			fprintf(stderr, "dbg2       rp_tr:             %d\n", mb_segytraceheader_ptr->rp_tr);
-			fprintf(stderr, "dbg2       trc_id:            %d\n", mb_segytraceheader_ptr->trc_id);
-			fprintf(stderr, "dbg2       num_vstk:          %d\n", mb_segytraceheader_ptr->num_vstk);
-			fprintf(stderr, "dbg2       cdp_fold:          %d\n", mb_segytraceheader_ptr->cdp_fold);
-			fprintf(stderr, "dbg2       use:               %d\n", mb_segytraceheader_ptr->use);
-			fprintf(stderr, "dbg2       range:             %d\n", mb_segytraceheader_ptr->range);
-			fprintf(stderr, "dbg2       grp_elev:          %d\n", mb_segytraceheader_ptr->grp_elev);
-			fprintf(stderr, "dbg2       src_elev:          %d\n", mb_segytraceheader_ptr->src_elev);
-			fprintf(stderr, "dbg2       src_depth:         %d\n", mb_segytraceheader_ptr->src_depth);
-			fprintf(stderr, "dbg2       grp_datum:         %d\n", mb_segytraceheader_ptr->grp_datum);
-			fprintf(stderr, "dbg2       src_datum:         %d\n", mb_segytraceheader_ptr->src_datum);
-			fprintf(stderr, "dbg2       src_wbd:           %d\n", mb_segytraceheader_ptr->src_wbd);
-			fprintf(stderr, "dbg2       grp_wbd:           %d\n", mb_segytraceheader_ptr->grp_wbd);
-			fprintf(stderr, "dbg2       elev_scalar:       %d\n", mb_segytraceheader_ptr->elev_scalar);
-			fprintf(stderr, "dbg2       coord_scalar:      %d\n", mb_segytraceheader_ptr->coord_scalar);
-			fprintf(stderr, "dbg2       src_long:          %d\n", mb_segytraceheader_ptr->src_long);
-			fprintf(stderr, "dbg2       src_lat:           %d\n", mb_segytraceheader_ptr->src_lat);
-			fprintf(stderr, "dbg2       grp_long:          %d\n", mb_segytraceheader_ptr->grp_long);
-			fprintf(stderr, "dbg2       grp_lat:           %d\n", mb_segytraceheader_ptr->grp_lat);
-			fprintf(stderr, "dbg2       coord_units:       %d\n", mb_segytraceheader_ptr->coord_units);
-			fprintf(stderr, "dbg2       wvel:              %d\n", mb_segytraceheader_ptr->wvel);
-			fprintf(stderr, "dbg2       sbvel:             %d\n", mb_segytraceheader_ptr->sbvel);
-			fprintf(stderr, "dbg2       src_up_vel:        %d\n", mb_segytraceheader_ptr->src_up_vel);
-			fprintf(stderr, "dbg2       grp_up_vel:        %d\n", mb_segytraceheader_ptr->grp_up_vel);
-			fprintf(stderr, "dbg2       src_static:        %d\n", mb_segytraceheader_ptr->src_static);
-			fprintf(stderr, "dbg2       grp_static:        %d\n", mb_segytraceheader_ptr->grp_static);
-			fprintf(stderr, "dbg2       tot_static:        %d\n", mb_segytraceheader_ptr->tot_static);
-			fprintf(stderr, "dbg2       laga:              %d\n", mb_segytraceheader_ptr->laga);
-			fprintf(stderr, "dbg2       delay_mils:        %d\n", mb_segytraceheader_ptr->delay_mils);
-			fprintf(stderr, "dbg2       smute_mils:        %d\n", mb_segytraceheader_ptr->smute_mils);
-			fprintf(stderr, "dbg2       emute_mils:        %d\n", mb_segytraceheader_ptr->emute_mils);
-			fprintf(stderr, "dbg2       nsamps:            %d\n", mb_segytraceheader_ptr->nsamps);
-			fprintf(stderr, "dbg2       si_micros:         %d\n", mb_segytraceheader_ptr->si_micros);
-			for (i = 0; i < 19; i++)
-				fprintf(stderr, "dbg2       other_1[%2d]:       %d\n", i, mb_segytraceheader_ptr->other_1[i]);
-			fprintf(stderr, "dbg2       year:              %d\n", mb_segytraceheader_ptr->year);
-			fprintf(stderr, "dbg2       day_of_yr:         %d\n", mb_segytraceheader_ptr->day_of_yr);
-			fprintf(stderr, "dbg2       hour:              %d\n", mb_segytraceheader_ptr->hour);
-			fprintf(stderr, "dbg2       min:               %d\n", mb_segytraceheader_ptr->min);
-			fprintf(stderr, "dbg2       sec:               %d\n", mb_segytraceheader_ptr->sec);
-			fprintf(stderr, "dbg2       mils:              %d\n", mb_segytraceheader_ptr->mils);
-			fprintf(stderr, "dbg2       tr_weight:         %d\n", mb_segytraceheader_ptr->tr_weight);
-			for (i = 0; i < 5; i++)
-				fprintf(stderr, "dbg2       other_2[%2d]:       %d\n", i, mb_segytraceheader_ptr->other_2[i]);
-			fprintf(stderr, "dbg2       delay:             %f\n", mb_segytraceheader_ptr->delay);
-			fprintf(stderr, "dbg2       smute_sec:         %f\n", mb_segytraceheader_ptr->smute_sec);
-			fprintf(stderr, "dbg2       emute_sec:         %f\n", mb_segytraceheader_ptr->emute_sec);
-			fprintf(stderr, "dbg2       si_secs:           %f\n", mb_segytraceheader_ptr->si_secs);
-			fprintf(stderr, "dbg2       wbt_secs:          %f\n", mb_segytraceheader_ptr->wbt_secs);
-			fprintf(stderr, "dbg2       end_of_rp:         %d\n", mb_segytraceheader_ptr->end_of_rp);
-			fprintf(stderr, "dbg2       dummy1:            %f\n", mb_segytraceheader_ptr->dummy1);
-			fprintf(stderr, "dbg2       dummy2:            %f\n", mb_segytraceheader_ptr->dummy2);
-			fprintf(stderr, "dbg2       dummy3:            %f\n", mb_segytraceheader_ptr->dummy3);
-			fprintf(stderr, "dbg2       dummy4:            %f\n", mb_segytraceheader_ptr->dummy4);
-			fprintf(stderr, "dbg2       soundspeed:        %f\n", mb_segytraceheader_ptr->soundspeed);
-			fprintf(stderr, "dbg2       distance:          %f\n", mb_segytraceheader_ptr->distance);
-			fprintf(stderr, "dbg2       roll:              %f\n", mb_segytraceheader_ptr->roll);
-			fprintf(stderr, "dbg2       pitch:             %f\n", mb_segytraceheader_ptr->pitch);
-			fprintf(stderr, "dbg2       heading:           %f\n", mb_segytraceheader_ptr->heading);
-		}
-		fprintf(stderr, "dbg2       error:             %d\n", *error);
+		fprintf(stderr, "dbg2       nsamples:   %d\n", nsamples);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
-		fprintf(stderr, "dbg2       status:            %d\n", status);
+		fprintf(stderr, "dbg2       status:     %d\n", status);
 	}
 
 	/* return status */
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_extract_segy(int verbose, void *mbio_ptr, void *store_ptr, int *sampleformat, int *kind, void *segyheader_ptr,
-                               float *segydata, int *error) {
-	char *function_name = "mbsys_reson7k_extract_segy";
+int mbsys_reson7k_alloc_attitudeseries(int verbose, s7k_attitudeseries *attitudeseries, int n, int *error) {
+	char *function_name = "mbsys_reson7k_alloc_attitudeseries";
 	int status = MB_SUCCESS;
-	struct mb_io_struct *mb_io_ptr;
-	struct mbsys_reson7k_struct *store;
-	struct mb_segytraceheader_struct *mb_segytraceheader_ptr;
-	s7k_header *header;
-	s7kr_fsdwsb *fsdwsb;
-	s7k_fsdwchannel *fsdwchannel;
-	s7k_fsdwsegyheader *fsdwsegyheader;
-	short *shortptr;
-	unsigned short *ushortptr;
-	double weight;
+	double **arrays[6];
+	int narrays;
 	int i;
 
 	/* print input debug statements */
@@ -8897,287 +11046,1513 @@ int mbsys_reson7k_extract_segy(int verbose, void *mbio_ptr, void *store_ptr, int
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
-		fprintf(stderr, "dbg2       mb_ptr:            %p\n", (void *)mbio_ptr);
-		fprintf(stderr, "dbg2       store_ptr:         %p\n", (void *)store_ptr);
-		fprintf(stderr, "dbg2       sampleformat:      %d\n", *sampleformat);
-		fprintf(stderr, "dbg2       kind:              %d\n", *kind);
-		fprintf(stderr, "dbg2       segyheader_ptr:    %p\n", (void *)segyheader_ptr);
-		fprintf(stderr, "dbg2       segydata:          %p\n", (void *)segydata);
+		fprintf(stderr, "dbg2       verbose:         %d\n", verbose);
+		fprintf(stderr, "dbg2       attitudeseries:  %p\n", (void *)attitudeseries);
+		fprintf(stderr, "dbg2       n:               %d\n", n);
+	}
+
+	/* grow the scratch arrays if this series is longer than any before */
+	if (attitudeseries->nalloc < n) {
+		narrays = 0;
+		arrays[narrays++] = &(attitudeseries->time_d);
+		arrays[narrays++] = &(attitudeseries->roll);
+		arrays[narrays++] = &(attitudeseries->pitch);
+		arrays[narrays++] = &(attitudeseries->heave);
+		arrays[narrays++] = &(attitudeseries->heading);
+		arrays[narrays++] = &(attitudeseries->weight);
+		status = mb_reallocd(verbose, __FILE__, __LINE__, n * sizeof(int), (void **)&(attitudeseries->index), error);
+		for (i = 0; i < narrays && status == MB_SUCCESS; i++)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, n * sizeof(double), (void **)arrays[i], error);
+		if (status == MB_SUCCESS)
+			attitudeseries->nalloc = n;
+		else
+			attitudeseries->nalloc = 0;
 	}
 
-	/* get mbio descriptor */
-	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       nalloc:     %d\n", attitudeseries->nalloc);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
 
-	/* get data structure pointer */
-	store = (struct mbsys_reson7k_struct *)store_ptr;
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_tseries_setup(int verbose, s7k_tseries *tseries, int id, int *error) {
+	char *function_name = "mbsys_reson7k_tseries_setup";
+	int status = MB_SUCCESS;
+	int i;
 
-	/* get data kind */
-	*kind = store->kind;
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       tseries:    %p\n", (void *)tseries);
+		fprintf(stderr, "dbg2       id:         %d\n", id);
+	}
+
+	/* set the values held by this kind of series */
+	for (i = 0; i < MBSYS_RESON7K_TSERIES_FIELDS; i++)
+		tseries->field[i] = MBSYS_RESON7K_TSERIES_LINEAR;
+	if (id == MBSYS_RESON7K_TSERIES_NAV) {
+		tseries->nfield = 3;
+		tseries->field[0] = MBSYS_RESON7K_TSERIES_LONGITUDE;
+	}
+	else if (id == MBSYS_RESON7K_TSERIES_HEADING) {
+		tseries->nfield = 1;
+		tseries->field[0] = MBSYS_RESON7K_TSERIES_AZIMUTH;
+	}
+	else if (id == MBSYS_RESON7K_TSERIES_ATTITUDE)
+		tseries->nfield = 3;
+	else
+		tseries->nfield = 1;
+
+	/* the series starts empty */
+	tseries->nmax = MBSYS_RESON7K_TSERIES_MAX;
+	tseries->nalloc = 0;
+	tseries->n = 0;
+	tseries->head = 0;
+	tseries->cursor = 0;
+	tseries->time_d = NULL;
+	for (i = 0; i < MBSYS_RESON7K_TSERIES_FIELDS; i++)
+		tseries->value[i] = NULL;
+	tseries->source = NULL;
+	tseries->nsource = 0;
+	tseries->ndropped = 0;
+	tseries->shared = MB_NO;
+	*error = MB_ERROR_NO_ERROR;
 
-	/* extract data from structure */
-	if (*kind == MB_DATA_SUBBOTTOM_SUBBOTTOM) {
-		/* extract segy header */
-		status = mbsys_reson7k_extract_segytraceheader(verbose, mbio_ptr, store_ptr, kind, segyheader_ptr, error);
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       nfield:     %d\n", tseries->nfield);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
 
-		/* get relevant structures */
-		mb_segytraceheader_ptr = (struct mb_segytraceheader_struct *)segyheader_ptr;
-		fsdwsb = &(store->fsdwsb);
-		header = &(fsdwsb->header);
-		fsdwchannel = &(fsdwsb->channel);
-		fsdwsegyheader = &(fsdwsb->segyheader);
-		shortptr = (short *)fsdwchannel->data;
-		ushortptr = (unsigned short *)fsdwchannel->data;
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_tseries_free(int verbose, s7k_tseries *tseries, int *error) {
+	char *function_name = "mbsys_reson7k_tseries_free";
+	int status = MB_SUCCESS;
+	int i;
 
-		/* get the trace weight */
-		weight = exp(MB_LN_2 * ((double)fsdwsegyheader->weightingFactor));
-		/*fprintf(stderr, "Subbottom: Weight: %d %f\n",fsdwsegyheader->weightingFactor,weight);*/
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       tseries:    %p\n", (void *)tseries);
+	}
+
+	/* deallocate the samples - arrays shared from another series are
+	    only let go of */
+	tseries->nalloc = 0;
+	tseries->n = 0;
+	tseries->head = 0;
+	tseries->cursor = 0;
+	tseries->source = NULL;
+	tseries->nsource = 0;
+	tseries->ndropped = 0;
+	if (tseries->shared == MB_YES) {
+		tseries->time_d = NULL;
+		for (i = 0; i < MBSYS_RESON7K_TSERIES_FIELDS; i++)
+			tseries->value[i] = NULL;
+		tseries->shared = MB_NO;
+	}
+	if (tseries->time_d != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(tseries->time_d), error);
+	for (i = 0; i < MBSYS_RESON7K_TSERIES_FIELDS; i++) {
+		if (tseries->value[i] != NULL)
+			status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(tseries->value[i]), error);
+	}
 
-		/* extract the data */
-		if (fsdwsb->data_format == EDGETECH_TRACEFORMAT_ENVELOPE) {
-			*sampleformat = MB_SEGY_SAMPLEFORMAT_ENVELOPE;
-			for (i = 0; i < fsdwchannel->number_samples; i++) {
-				segydata[i] = (float)(((double)ushortptr[i]) / weight);
-			}
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_tseries_append(int verbose, s7k_tseries *tseries, int n, double *time_d, double **values, int *error) {
+	char *function_name = "mbsys_reson7k_tseries_append";
+	int status = MB_SUCCESS;
+	int nalloc;
+	int i, j, k;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       tseries:    %p\n", (void *)tseries);
+		fprintf(stderr, "dbg2       n:          %d\n", n);
+		for (i = 0; i < n; i++) {
+			fprintf(stderr, "dbg2       %d time_d:%f", i, time_d[i]);
+			for (j = 0; j < tseries->nfield; j++)
+				fprintf(stderr, " %f", values[j][i]);
+			fprintf(stderr, "\n");
 		}
-		else if (fsdwsb->data_format == EDGETECH_TRACEFORMAT_ANALYTIC) {
-			/* if no format specified do envelope by default */
-			if (*sampleformat == MB_SEGY_SAMPLEFORMAT_NONE)
-				*sampleformat = MB_SEGY_SAMPLEFORMAT_ENVELOPE;
+	}
 
-			/* convert analytic data to desired envelope */
-			if (*sampleformat == MB_SEGY_SAMPLEFORMAT_ENVELOPE) {
-				for (i = 0; i < fsdwchannel->number_samples; i++) {
-					segydata[i] =
-					    (float)(sqrt((double)(shortptr[2 * i] * shortptr[2 * i] + shortptr[2 * i + 1] * shortptr[2 * i + 1])) /
-					            weight);
+	/* a series sharing the arrays of another is never written - it is
+	    given arrays of its own first */
+	*error = MB_ERROR_NO_ERROR;
+	if (tseries->shared == MB_YES && n > 0)
+		status = mbsys_reson7k_tseries_free(verbose, tseries, error);
+
+	/* append the samples later than the last one held - until the series
+	    holds nmax samples the arrays grow and the oldest sample stays at the
+	    start, after that each sample overwrites the oldest. Samples at or
+	    before the last time held are counted in ndropped */
+	for (i = 0; i < n && status == MB_SUCCESS; i++) {
+		if (tseries->n == 0 || time_d[i] > tseries->time_d[(tseries->head + tseries->n - 1) % tseries->nalloc]) {
+			if (tseries->n >= tseries->nalloc && tseries->nalloc < tseries->nmax) {
+				nalloc = MIN(tseries->nmax, MAX(MBSYS_RESON7K_TSERIES_ALLOC, 2 * tseries->nalloc));
+				status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(double), (void **)&(tseries->time_d), error);
+				for (j = 0; j < tseries->nfield && status == MB_SUCCESS; j++)
+					status =
+					    mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(double), (void **)&(tseries->value[j]), error);
+				if (status == MB_SUCCESS)
+					tseries->nalloc = nalloc;
+				else {
+					tseries->nalloc = 0;
+					tseries->n = 0;
+					tseries->head = 0;
+					tseries->cursor = 0;
 				}
 			}
-
-			/* else extract desired analytic data */
-			else if (*sampleformat == MB_SEGY_SAMPLEFORMAT_ANALYTIC) {
-				for (i = 0; i < fsdwchannel->number_samples; i++) {
-					segydata[2 * i] = (float)(((double)shortptr[2 * i]) / weight);
-					segydata[2 * i + 1] = (float)(((double)shortptr[2 * i + 1]) / weight);
+			if (status == MB_SUCCESS) {
+				if (tseries->n < tseries->nalloc) {
+					k = (tseries->head + tseries->n) % tseries->nalloc;
+					tseries->n++;
 				}
-			}
-
-			/* else extract desired real trace from analytic data */
-			else if (*sampleformat == MB_SEGY_SAMPLEFORMAT_TRACE) {
-				for (i = 0; i < fsdwchannel->number_samples; i++) {
-					segydata[i] = (float)(((double)shortptr[2 * i]) / weight);
+				else {
+					k = tseries->head;
+					tseries->head = (tseries->head + 1) % tseries->nalloc;
+					tseries->cursor = MAX(0, tseries->cursor - 1);
 				}
+				tseries->time_d[k] = time_d[i];
+				for (j = 0; j < tseries->nfield; j++)
+					tseries->value[j][k] = values[j][i];
 			}
 		}
-		else if (fsdwsb->data_format == EDGETECH_TRACEFORMAT_RAW) {
-			*sampleformat = MB_SEGY_SAMPLEFORMAT_TRACE;
-			for (i = 0; i < fsdwchannel->number_samples; i++) {
-				segydata[i] = (float)(((double)ushortptr[i]) / weight);
-			}
-		}
-		else if (fsdwsb->data_format == EDGETECH_TRACEFORMAT_REALANALYTIC) {
-			*sampleformat = MB_SEGY_SAMPLEFORMAT_TRACE;
-			for (i = 0; i < fsdwchannel->number_samples; i++) {
-				segydata[i] = (float)(((double)ushortptr[i]) / weight);
-			}
-		}
-		else if (fsdwsb->data_format == EDGETECH_TRACEFORMAT_PIXEL) {
-			*sampleformat = MB_SEGY_SAMPLEFORMAT_TRACE;
-			for (i = 0; i < fsdwchannel->number_samples; i++) {
-				segydata[i] = (float)(((double)ushortptr[i]) / weight);
-			}
-		}
+		else
+			tseries->ndropped++;
+	}
 
-		/* done translating values */
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       nalloc:     %d\n", tseries->nalloc);
+		fprintf(stderr, "dbg2       n:          %d\n", tseries->n);
+		fprintf(stderr, "dbg2       head:       %d\n", tseries->head);
+		fprintf(stderr, "dbg2       ndropped:   %d\n", tseries->ndropped);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
 	}
 
-	/* deal with comment */
-	else if (*kind == MB_DATA_COMMENT) {
-		/* set status */
-		*error = MB_ERROR_COMMENT;
-		status = MB_FAILURE;
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_tseries_share(int verbose, s7k_tseries *tseries, s7k_tseries *source_tseries, int *error) {
+	char *function_name = "mbsys_reson7k_tseries_share";
+	int status = MB_SUCCESS;
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:        %d\n", verbose);
+		fprintf(stderr, "dbg2       tseries:        %p\n", (void *)tseries);
+		fprintf(stderr, "dbg2       source_tseries: %p\n", (void *)source_tseries);
+	}
+
+	/* read the samples of the source series in place rather than copying
+	    them - the source must not change while it is shared, and only the
+	    lookup bracket belongs to this series */
+	status = mbsys_reson7k_tseries_free(verbose, tseries, error);
+	tseries->nfield = source_tseries->nfield;
+	for (i = 0; i < MBSYS_RESON7K_TSERIES_FIELDS; i++) {
+		tseries->field[i] = source_tseries->field[i];
+		tseries->value[i] = source_tseries->value[i];
+	}
+	tseries->nmax = source_tseries->nmax;
+	tseries->nalloc = source_tseries->nalloc;
+	tseries->n = source_tseries->n;
+	tseries->head = source_tseries->head;
+	tseries->cursor = 0;
+	tseries->time_d = source_tseries->time_d;
+	tseries->source = source_tseries->source;
+	tseries->nsource = source_tseries->nsource;
+	tseries->ndropped = source_tseries->ndropped;
+	tseries->shared = MB_YES;
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       n:          %d\n", tseries->n);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
 	}
 
-	/* deal with other record type */
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_tseries_add(int verbose, void *mbio_ptr, int id, double time_d, double value0, double value1, double value2,
+                              int *error) {
+	char *function_name = "mbsys_reson7k_tseries_add";
+	int status = MB_SUCCESS;
+	struct mb_io_struct *mb_io_ptr;
+	struct mbsys_reson7k_struct *ostore;
+	double *values[MBSYS_RESON7K_TSERIES_FIELDS];
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mb_ptr:     %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       id:         %d\n", id);
+		fprintf(stderr, "dbg2       time_d:     %f\n", time_d);
+		fprintf(stderr, "dbg2       value0:     %f\n", value0);
+		fprintf(stderr, "dbg2       value1:     %f\n", value1);
+		fprintf(stderr, "dbg2       value2:     %f\n", value2);
+	}
+
+	/* get the series held by the internal store of this mbio descriptor */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+	ostore = (struct mbsys_reson7k_struct *)mb_io_ptr->store_data;
+
+	/* append the sample */
+	values[0] = &value0;
+	values[1] = &value1;
+	values[2] = &value2;
+	if (id >= 0 && id < MBSYS_RESON7K_TSERIES_NUM)
+		status = mbsys_reson7k_tseries_append(verbose, &(ostore->tseries[id]), 1, &time_d, values, error);
 	else {
-		/* set status */
-		*error = MB_ERROR_OTHER;
 		status = MB_FAILURE;
+		*error = MB_ERROR_BAD_PARAMETER;
 	}
 
 	/* print output debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       sampleformat:      %d\n", *sampleformat);
-		fprintf(stderr, "dbg2       kind:              %d\n", *kind);
-		fprintf(stderr, "dbg2       seq_num:           %d\n", mb_segytraceheader_ptr->seq_num);
-		fprintf(stderr, "dbg2       seq_reel:          %d\n", mb_segytraceheader_ptr->seq_reel);
-		fprintf(stderr, "dbg2       shot_num:          %d\n", mb_segytraceheader_ptr->shot_num);
-		fprintf(stderr, "dbg2       shot_tr:           %d\n", mb_segytraceheader_ptr->shot_tr);
-		fprintf(stderr, "dbg2       espn:              %d\n", mb_segytraceheader_ptr->espn);
-		fprintf(stderr, "dbg2       rp_num:            %d\n", mb_segytraceheader_ptr->rp_num);
-		fprintf(stderr, "dbg2       rp_tr:             %d\n", mb_segytraceheader_ptr->rp_tr);
-		fprintf(stderr, "dbg2       trc_id:            %d\n", mb_segytraceheader_ptr->trc_id);
-		fprintf(stderr, "dbg2       num_vstk:          %d\n", mb_segytraceheader_ptr->num_vstk);
-		fprintf(stderr, "dbg2       cdp_fold:          %d\n", mb_segytraceheader_ptr->cdp_fold);
-		fprintf(stderr, "dbg2       use:               %d\n", mb_segytraceheader_ptr->use);
-		fprintf(stderr, "dbg2       range:             %d\n", mb_segytraceheader_ptr->range);
-		fprintf(stderr, "dbg2       grp_elev:          %d\n", mb_segytraceheader_ptr->grp_elev);
-		fprintf(stderr, "dbg2       src_elev:          %d\n", mb_segytraceheader_ptr->src_elev);
-		fprintf(stderr, "dbg2       src_depth:         %d\n", mb_segytraceheader_ptr->src_depth);
-		fprintf(stderr, "dbg2       grp_datum:         %d\n", mb_segytraceheader_ptr->grp_datum);
-		fprintf(stderr, "dbg2       src_datum:         %d\n", mb_segytraceheader_ptr->src_datum);
-		fprintf(stderr, "dbg2       src_wbd:           %d\n", mb_segytraceheader_ptr->src_wbd);
-		fprintf(stderr, "dbg2       grp_wbd:           %d\n", mb_segytraceheader_ptr->grp_wbd);
-		fprintf(stderr, "dbg2       elev_scalar:       %d\n", mb_segytraceheader_ptr->elev_scalar);
-		fprintf(stderr, "dbg2       coord_scalar:      %d\n", mb_segytraceheader_ptr->coord_scalar);
-		fprintf(stderr, "dbg2       src_long:          %d\n", mb_segytraceheader_ptr->src_long);
-		fprintf(stderr, "dbg2       src_lat:           %d\n", mb_segytraceheader_ptr->src_lat);
-		fprintf(stderr, "dbg2       grp_long:          %d\n", mb_segytraceheader_ptr->grp_long);
-		fprintf(stderr, "dbg2       grp_lat:           %d\n", mb_segytraceheader_ptr->grp_lat);
-		fprintf(stderr, "dbg2       coord_units:       %d\n", mb_segytraceheader_ptr->coord_units);
-		fprintf(stderr, "dbg2       wvel:              %d\n", mb_segytraceheader_ptr->wvel);
-		fprintf(stderr, "dbg2       sbvel:             %d\n", mb_segytraceheader_ptr->sbvel);
-		fprintf(stderr, "dbg2       src_up_vel:        %d\n", mb_segytraceheader_ptr->src_up_vel);
-		fprintf(stderr, "dbg2       grp_up_vel:        %d\n", mb_segytraceheader_ptr->grp_up_vel);
-		fprintf(stderr, "dbg2       src_static:        %d\n", mb_segytraceheader_ptr->src_static);
-		fprintf(stderr, "dbg2       grp_static:        %d\n", mb_segytraceheader_ptr->grp_static);
-		fprintf(stderr, "dbg2       tot_static:        %d\n", mb_segytraceheader_ptr->tot_static);
-		fprintf(stderr, "dbg2       laga:              %d\n", mb_segytraceheader_ptr->laga);
-		fprintf(stderr, "dbg2       delay_mils:        %d\n", mb_segytraceheader_ptr->delay_mils);
-		fprintf(stderr, "dbg2       smute_mils:        %d\n", mb_segytraceheader_ptr->smute_mils);
-		fprintf(stderr, "dbg2       emute_mils:        %d\n", mb_segytraceheader_ptr->emute_mils);
-		fprintf(stderr, "dbg2       nsamps:            %d\n", mb_segytraceheader_ptr->nsamps);
-		fprintf(stderr, "dbg2       si_micros:         %d\n", mb_segytraceheader_ptr->si_micros);
-		for (i = 0; i < 19; i++)
-			fprintf(stderr, "dbg2       other_1[%2d]:       %d\n", i, mb_segytraceheader_ptr->other_1[i]);
-		fprintf(stderr, "dbg2       year:              %d\n", mb_segytraceheader_ptr->year);
-		fprintf(stderr, "dbg2       day_of_yr:         %d\n", mb_segytraceheader_ptr->day_of_yr);
-		fprintf(stderr, "dbg2       hour:              %d\n", mb_segytraceheader_ptr->hour);
-		fprintf(stderr, "dbg2       min:               %d\n", mb_segytraceheader_ptr->min);
-		fprintf(stderr, "dbg2       sec:               %d\n", mb_segytraceheader_ptr->sec);
-		fprintf(stderr, "dbg2       mils:              %d\n", mb_segytraceheader_ptr->mils);
-		fprintf(stderr, "dbg2       tr_weight:         %d\n", mb_segytraceheader_ptr->tr_weight);
-		for (i = 0; i < 5; i++)
-			fprintf(stderr, "dbg2       other_2[%2d]:       %d\n", i, mb_segytraceheader_ptr->other_2[i]);
-		fprintf(stderr, "dbg2       delay:             %f\n", mb_segytraceheader_ptr->delay);
-		fprintf(stderr, "dbg2       smute_sec:         %f\n", mb_segytraceheader_ptr->smute_sec);
-		fprintf(stderr, "dbg2       emute_sec:         %f\n", mb_segytraceheader_ptr->emute_sec);
-		fprintf(stderr, "dbg2       si_secs:           %f\n", mb_segytraceheader_ptr->si_secs);
-		fprintf(stderr, "dbg2       wbt_secs:          %f\n", mb_segytraceheader_ptr->wbt_secs);
-		fprintf(stderr, "dbg2       end_of_rp:         %d\n", mb_segytraceheader_ptr->end_of_rp);
-		fprintf(stderr, "dbg2       dummy1:            %f\n", mb_segytraceheader_ptr->dummy1);
-		fprintf(stderr, "dbg2       dummy2:            %f\n", mb_segytraceheader_ptr->dummy2);
-		fprintf(stderr, "dbg2       dummy3:            %f\n", mb_segytraceheader_ptr->dummy3);
-		fprintf(stderr, "dbg2       dummy4:            %f\n", mb_segytraceheader_ptr->dummy4);
-		fprintf(stderr, "dbg2       soundspeed:        %f\n", mb_segytraceheader_ptr->soundspeed);
-		fprintf(stderr, "dbg2       distance:          %f\n", mb_segytraceheader_ptr->distance);
-		fprintf(stderr, "dbg2       roll:              %f\n", mb_segytraceheader_ptr->roll);
-		fprintf(stderr, "dbg2       pitch:             %f\n", mb_segytraceheader_ptr->pitch);
-		fprintf(stderr, "dbg2       heading:           %f\n", mb_segytraceheader_ptr->heading);
-		for (i = 0; i < mb_segytraceheader_ptr->nsamps; i++)
-			fprintf(stderr, "dbg2       segydata[%d]:      %f\n", i, segydata[i]);
-		fprintf(stderr, "dbg2       error:             %d\n", *error);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
-		fprintf(stderr, "dbg2       status:            %d\n", status);
+		fprintf(stderr, "dbg2       status:     %d\n", status);
 	}
 
 	/* return status */
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_insert_segy(int verbose, void *mbio_ptr, void *store_ptr, int kind, void *segyheader_ptr, float *segydata,
-                              int *error) {
-	char *function_name = "mbsys_reson7k_insert_segy";
+int mbsys_reson7k_tseries_load(int verbose, s7k_tseries *tseries, int n, double *time_d, double *value0, double *value1,
+                               double *value2, int *error) {
+	char *function_name = "mbsys_reson7k_tseries_load";
 	int status = MB_SUCCESS;
-	struct mb_io_struct *mb_io_ptr;
-	struct mbsys_reson7k_struct *store;
-	struct mb_segytraceheader_struct *mb_segytraceheader_ptr;
-	s7k_header *header;
-	s7kr_bathymetry *bathymetry;
-	s7kr_fsdwsb *fsdwsb;
-	s7k_fsdwchannel *fsdwchannel;
-	s7k_fsdwsegyheader *fsdwsegyheader;
-	s7kr_ctd *ctd;
-	double dsonardepth, dsonaraltitude, dwaterdepth;
-	int sonardepth, waterdepth;
-	int watersoundspeed;
-	float fwatertime;
-	int time_j[5];
-	float factor;
-	float datamax;
-	double weight;
-	int data_size;
-	short *shortptr;
-	int i;
+	double *values[MBSYS_RESON7K_TSERIES_FIELDS];
 
 	/* print input debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:        %d\n", verbose);
-		fprintf(stderr, "dbg2       mb_ptr:         %p\n", (void *)mbio_ptr);
-		fprintf(stderr, "dbg2       store_ptr:      %p\n", (void *)store_ptr);
-		fprintf(stderr, "dbg2       kind:           %d\n", kind);
-		fprintf(stderr, "dbg2       segyheader_ptr: %p\n", (void *)segyheader_ptr);
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       tseries:    %p\n", (void *)tseries);
+		fprintf(stderr, "dbg2       n:          %d\n", n);
+		fprintf(stderr, "dbg2       time_d:     %p\n", (void *)time_d);
+		fprintf(stderr, "dbg2       value0:     %p\n", (void *)value0);
+		fprintf(stderr, "dbg2       value1:     %p\n", (void *)value1);
+		fprintf(stderr, "dbg2       value2:     %p\n", (void *)value2);
 	}
 
-	/* get mbio descriptor */
-	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+	/* the series passed for preprocessing stays the same from ping to ping,
+	    so it is copied only when the arrays change - the whole series is
+	    held, and the bracket of the last lookup is kept between pings */
+	*error = MB_ERROR_NO_ERROR;
+	if (time_d != tseries->source || n != tseries->nsource) {
+		if (tseries->shared == MB_YES)
+			status = mbsys_reson7k_tseries_free(verbose, tseries, error);
+		tseries->n = 0;
+		tseries->head = 0;
+		tseries->cursor = 0;
+		tseries->ndropped = 0;
+		tseries->nmax = MAX(n, 1);
+		if (tseries->nalloc > tseries->nmax)
+			tseries->nmax = tseries->nalloc;
+		values[0] = value0;
+		values[1] = value1;
+		values[2] = value2;
+		if (n > 0)
+			status = mbsys_reson7k_tseries_append(verbose, tseries, n, time_d, values, error);
+		if (status == MB_SUCCESS) {
+			tseries->source = time_d;
+			tseries->nsource = n;
+		}
+		else {
+			tseries->source = NULL;
+			tseries->nsource = 0;
+		}
 
-	/* get data structure pointer */
-	store = (struct mbsys_reson7k_struct *)store_ptr;
+		/* the series must increase in time - samples at or before the time of
+		    the sample before are left out */
+		if (status == MB_SUCCESS && tseries->ndropped > 0 && verbose > 0)
+			fprintf(stderr, "%s: %d of %d samples dropped because their times do not increase\n", function_name,
+			        tseries->ndropped, n);
+	}
 
-	/* get data kind */
-	store->kind = kind;
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       n:          %d\n", tseries->n);
+		fprintf(stderr, "dbg2       ndropped:   %d\n", tseries->ndropped);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
 
-	/* insert data to structure */
-	if (store->kind == MB_DATA_SUBBOTTOM_SUBBOTTOM) {
-		/* get relevant structures */
-		mb_segytraceheader_ptr = (struct mb_segytraceheader_struct *)segyheader_ptr;
-		bathymetry = &(store->bathymetry);
-		ctd = &(store->ctd);
-		fsdwsb = &(store->fsdwsb);
-		header = &(fsdwsb->header);
-		fsdwchannel = &(fsdwsb->channel);
-		fsdwsegyheader = &(fsdwsb->segyheader);
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_tseries_locate(s7k_tseries *tseries, double time_d) {
+	int k;
+
+	/* find the pair of samples bracketing the time, counted from the oldest
+	    sample - the search starts from the bracket of the previous lookup, so
+	    lookups at increasing times cost only a few comparisons each, and
+	    times outside the series give the first or last pair */
+	if (tseries->n < 2)
+		return (0);
+	k = MAX(0, MIN(tseries->cursor, tseries->n - 2));
+	while (k > 0 && time_d < tseries->time_d[(tseries->head + k) % tseries->nalloc])
+		k--;
+	while (k < tseries->n - 2 && time_d >= tseries->time_d[(tseries->head + k + 1) % tseries->nalloc])
+		k++;
+	tseries->cursor = k;
+
+	return (k);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_tseries_interp(int verbose, s7k_tseries *tseries, double time_d, double *values, int *error) {
+	char *function_name = "mbsys_reson7k_tseries_interp";
+	int status = MB_SUCCESS;
+	double weight, dvalue;
+	int k0, k1;
+	int j;
 
-		/* get needed values */
-		mb_depint_interp(verbose, mbio_ptr, store->time_d, &dsonardepth, error);
-		mb_altint_interp(verbose, mbio_ptr, store->time_d, &dsonaraltitude, error);
-		dwaterdepth = dsonardepth + dsonaraltitude;
-		sonardepth = (int)(100 * dsonardepth);
-		waterdepth = (int)(100 * dwaterdepth);
-		if (ctd->n > 0)
-			watersoundspeed = (int)(ctd->sound_velocity[ctd->n - 1]);
-		else
-			watersoundspeed = 1500;
-		fwatertime = 2.0 * 0.01 * ((double)waterdepth) / ((double)watersoundspeed);
-		mb_get_jtime(verbose, store->time_i, time_j);
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       tseries:    %p\n", (void *)tseries);
+		fprintf(stderr, "dbg2       n:          %d\n", tseries->n);
+		fprintf(stderr, "dbg2       time_d:     %f\n", time_d);
+	}
 
-		/* extract the data */
-		if (mb_segytraceheader_ptr->shot_num != 0)
-			fsdwsb->ping_number = mb_segytraceheader_ptr->shot_num;
-		else if (mb_segytraceheader_ptr->seq_reel != 0)
-			fsdwsb->ping_number = mb_segytraceheader_ptr->seq_reel;
-		else if (mb_segytraceheader_ptr->seq_num != 0)
-			fsdwsb->ping_number = mb_segytraceheader_ptr->seq_num;
-		else if (mb_segytraceheader_ptr->rp_num != 0)
-			fsdwsb->ping_number = mb_segytraceheader_ptr->rp_num;
-		else
-			fsdwsb->ping_number = 0;
-		fsdwsb->data_format = mb_segytraceheader_ptr->use;
-		if (mb_segytraceheader_ptr->grp_elev != 0)
-			sonardepth = -mb_segytraceheader_ptr->grp_elev;
-		else if (mb_segytraceheader_ptr->src_elev != 0)
-			sonardepth = -mb_segytraceheader_ptr->src_elev;
-		else if (mb_segytraceheader_ptr->src_depth != 0)
-			sonardepth = mb_segytraceheader_ptr->src_depth;
+	/* interpolate the values at the time - times outside the series are
+	    clamped to its ends as in mb_linear_interp(), and angles are
+	    interpolated the shorter way round */
+	if (tseries->n <= 0) {
+		for (j = 0; j < tseries->nfield; j++)
+			values[j] = 0.0;
+		status = MB_FAILURE;
+		*error = MB_ERROR_NOT_ENOUGH_DATA;
+	}
+	else {
+		k0 = mbsys_reson7k_tseries_locate(tseries, time_d);
+		k1 = MIN(k0 + 1, tseries->n - 1);
+		k0 = (tseries->head + k0) % tseries->nalloc;
+		k1 = (tseries->head + k1) % tseries->nalloc;
+		if (time_d <= tseries->time_d[k0])
+			weight = 0.0;
+		else if (time_d >= tseries->time_d[k1])
+			weight = 1.0;
 		else
-			sonardepth = 0;
-		if (mb_segytraceheader_ptr->elev_scalar < 0)
+			weight = (time_d - tseries->time_d[k0]) / (tseries->time_d[k1] - tseries->time_d[k0]);
+		for (j = 0; j < tseries->nfield; j++) {
+			dvalue = tseries->value[j][k1] - tseries->value[j][k0];
+			if (tseries->field[j] != MBSYS_RESON7K_TSERIES_LINEAR) {
+				if (dvalue > 180.0)
+					dvalue -= 360.0;
+				else if (dvalue < -180.0)
+					dvalue += 360.0;
+			}
+			values[j] = tseries->value[j][k0] + weight * dvalue;
+			if (tseries->field[j] == MBSYS_RESON7K_TSERIES_AZIMUTH) {
+				if (values[j] < 0.0)
+					values[j] += 360.0;
+				else if (values[j] >= 360.0)
+					values[j] -= 360.0;
+			}
+			else if (tseries->field[j] == MBSYS_RESON7K_TSERIES_LONGITUDE) {
+				if (values[j] < -180.0)
+					values[j] += 360.0;
+				else if (values[j] > 180.0)
+					values[j] -= 360.0;
+			}
+		}
+		*error = MB_ERROR_NO_ERROR;
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		for (j = 0; j < tseries->nfield; j++)
+			fprintf(stderr, "dbg2       values[%d]:  %f\n", j, values[j]);
+		fprintf(stderr, "dbg2       cursor:     %d\n", tseries->cursor);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_tseries_speed(int verbose, s7k_tseries *tseries, double time_d, double *speed, int *error) {
+	char *function_name = "mbsys_reson7k_tseries_speed";
+	int status = MB_SUCCESS;
+	double mtodeglon, mtodeglat;
+	double dx, dy, dt;
+	int k0, k1;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       tseries:    %p\n", (void *)tseries);
+		fprintf(stderr, "dbg2       n:          %d\n", tseries->n);
+		fprintf(stderr, "dbg2       time_d:     %f\n", time_d);
+	}
+
+	/* calculate the speed (m/s) between the pair of navigation fixes
+	    bracketing the time, or the first or last pair outside the series */
+	*speed = 0.0;
+	if (tseries->n < 2) {
+		status = MB_FAILURE;
+		*error = MB_ERROR_NOT_ENOUGH_DATA;
+	}
+	else {
+		k0 = mbsys_reson7k_tseries_locate(tseries, time_d);
+		k1 = (tseries->head + k0 + 1) % tseries->nalloc;
+		k0 = (tseries->head + k0) % tseries->nalloc;
+		mb_coor_scale(verbose, tseries->value[1][k0], &mtodeglon, &mtodeglat);
+		dx = (tseries->value[0][k1] - tseries->value[0][k0]) / mtodeglon;
+		dy = (tseries->value[1][k1] - tseries->value[1][k0]) / mtodeglat;
+		dt = tseries->time_d[k1] - tseries->time_d[k0];
+		if (dt > 0.0)
+			*speed = sqrt(dx * dx + dy * dy) / dt;
+		*error = MB_ERROR_NO_ERROR;
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       speed:      %f\n", *speed);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_tseries_nav(int verbose, s7k_tseries *tseries, double time_d, double heading, double speed, double *navlon,
+                              double *navlat, double *speed_out, int *error) {
+	char *function_name = "mbsys_reson7k_tseries_nav";
+	int status = MB_SUCCESS;
+	double values[MBSYS_RESON7K_TSERIES_FIELDS];
+	double mtodeglon, mtodeglat;
+	double speed_mps, dd;
+	int k;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       tseries:    %p\n", (void *)tseries);
+		fprintf(stderr, "dbg2       n:          %d\n", tseries->n);
+		fprintf(stderr, "dbg2       time_d:     %f\n", time_d);
+		fprintf(stderr, "dbg2       heading:    %f\n", heading);
+		fprintf(stderr, "dbg2       speed:      %f\n", speed);
+	}
+
+	/* interpolate the navigation in the manner of mb_navint_interp() - within
+	    the series the fixes are interpolated, and outside it the position is
+	    extrapolated from the nearest fix along the heading, with the speed
+	    (km/hr) given, held with the fixes, or made good between fixes */
+	status = mbsys_reson7k_tseries_interp(verbose, tseries, time_d, values, error);
+	if (status == MB_SUCCESS) {
+		*navlon = values[0];
+		*navlat = values[1];
+		*speed_out = speed;
+		if (*speed_out <= 0.0)
+			*speed_out = values[2];
+		if (*speed_out <= 0.0 && tseries->n > 1) {
+			mbsys_reson7k_tseries_speed(verbose, tseries, time_d, &speed_mps, error);
+			*speed_out = 3.6 * speed_mps;
+		}
+		if (tseries->n > 1) {
+			k = (tseries->head + tseries->n - 1) % tseries->nalloc;
+			if (time_d > tseries->time_d[k])
+				dd = (time_d - tseries->time_d[k]) * *speed_out / 3.6;
+			else if (time_d < tseries->time_d[tseries->head])
+				dd = (time_d - tseries->time_d[tseries->head]) * *speed_out / 3.6;
+			else
+				dd = 0.0;
+			if (dd != 0.0) {
+				mb_coor_scale(verbose, *navlat, &mtodeglon, &mtodeglat);
+				*navlon += sin(DTR * heading) * mtodeglon * dd;
+				*navlat += cos(DTR * heading) * mtodeglat * dd;
+			}
+		}
+		*error = MB_ERROR_NO_ERROR;
+	}
+	else {
+		*navlon = 0.0;
+		*navlat = 0.0;
+		*speed_out = 0.0;
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       navlon:     %f\n", *navlon);
+		fprintf(stderr, "dbg2       navlat:     %f\n", *navlat);
+		fprintf(stderr, "dbg2       speed_out:  %f\n", *speed_out);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_alloc_fileindex(int verbose, s7k_fileindex *fileindex, int n, int *error) {
+	char *function_name = "mbsys_reson7k_alloc_fileindex";
+	int status = MB_SUCCESS;
+	int nalloc;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       fileindex:  %p\n", (void *)fileindex);
+		fprintf(stderr, "dbg2       n:          %d\n", n);
+	}
+
+	/* grow the index - at least doubling so that an index built one record
+	    at a time is not reallocated for every record */
+	if (fileindex->nalloc < n) {
+		nalloc = MAX(n, 2 * fileindex->nalloc);
+		status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(u64), (void **)&(fileindex->offset), error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(int), (void **)&(fileindex->recordid), error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(double), (void **)&(fileindex->time_d), error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(double), (void **)&(fileindex->time_max), error);
+		if (status == MB_SUCCESS)
+			fileindex->nalloc = nalloc;
+		else {
+			fileindex->nalloc = 0;
+			fileindex->n = 0;
+			fileindex->source = MBSYS_RESON7K_FILEINDEX_NONE;
+		}
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       nalloc:     %d\n", fileindex->nalloc);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_insert_nav(int verbose, void *mbio_ptr, void *store_ptr, int time_i[7], double time_d, double navlon,
+                             double navlat, double speed, double heading, double draft, double roll, double pitch, double heave,
+                             int *error) {
+	char *function_name = "mbsys_reson7k_insert_nav";
+	int status = MB_SUCCESS;
+	struct mb_io_struct *mb_io_ptr;
+	struct mbsys_reson7k_struct *store;
+	s7kr_bathymetry *bathymetry;
+	s7kr_position *position;
+	s7kr_depth *depth;
+	s7kr_attitude *attitude;
+	s7kr_reference *reference;
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       time_i[0]:  %d\n", time_i[0]);
+		fprintf(stderr, "dbg2       time_i[1]:  %d\n", time_i[1]);
+		fprintf(stderr, "dbg2       time_i[2]:  %d\n", time_i[2]);
+		fprintf(stderr, "dbg2       time_i[3]:  %d\n", time_i[3]);
+		fprintf(stderr, "dbg2       time_i[4]:  %d\n", time_i[4]);
+		fprintf(stderr, "dbg2       time_i[5]:  %d\n", time_i[5]);
+		fprintf(stderr, "dbg2       time_i[6]:  %d\n", time_i[6]);
+		fprintf(stderr, "dbg2       time_d:     %f\n", time_d);
+		fprintf(stderr, "dbg2       navlon:     %f\n", navlon);
+		fprintf(stderr, "dbg2       navlat:     %f\n", navlat);
+		fprintf(stderr, "dbg2       speed:      %f\n", speed);
+		fprintf(stderr, "dbg2       heading:    %f\n", heading);
+		fprintf(stderr, "dbg2       draft:      %f\n", draft);
+		fprintf(stderr, "dbg2       roll:       %f\n", roll);
+		fprintf(stderr, "dbg2       pitch:      %f\n", pitch);
+		fprintf(stderr, "dbg2       heave:      %f\n", heave);
+	}
+
+	/* get mbio descriptor */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+
+	/* get data structure pointer */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+	bathymetry = (s7kr_bathymetry *)&store->bathymetry;
+	position = (s7kr_position *)&store->position;
+	depth = (s7kr_depth *)&store->depth;
+	attitude = (s7kr_attitude *)&store->attitude;
+	reference = (s7kr_reference *)&store->reference;
+
+	/* insert data in ping structure */
+	if (store->kind == MB_DATA_DATA) {
+		/* get time */
+		for (i = 0; i < 7; i++)
+			store->time_i[i] = time_i[i];
+		store->time_d = time_d;
+
+		/* get navigation */
+		bathymetry->longitude = DTR * navlon;
+		bathymetry->latitude = DTR * navlat;
+
+		/* get heading */
+		bathymetry->heading = DTR * heading;
+
+		/* get speed  */
+
+		/* get draft  */
+		bathymetry->vehicle_height = reference->water_z - draft;
+
+		/* get roll pitch and heave */
+		bathymetry->heave = heave;
+		bathymetry->pitch = DTR * pitch;
+		bathymetry->roll = DTR * roll;
+	}
+
+	/* insert data in nav structure */
+	else if (store->kind == MB_DATA_NAV1) {
+		/* get time */
+		for (i = 0; i < 7; i++)
+			store->time_i[i] = time_i[i];
+		store->time_d = time_d;
+
+		/* get navigation */
+		position->longitude = DTR * navlon;
+		position->latitude = DTR * navlat;
+
+		/* get heading */
+
+		/* get speed  */
+
+		/* get draft  */
+
+		/* get roll pitch and heave */
+	}
+
+	/* the inserted values supersede the records as read */
+	if (store->kind == MB_DATA_DATA)
+		mbsys_reson7k_rawrecord_modified(verbose, store_ptr, R7KRECID_7kBathymetricData, error);
+	else if (store->kind == MB_DATA_NAV1)
+		mbsys_reson7k_rawrecord_modified(verbose, store_ptr, R7KRECID_Position, error);
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return value:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:  %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_extract_svp(int verbose, void *mbio_ptr, void *store_ptr, int *kind, int *nsvp, double *depth, double *velocity,
+                              int *error) {
+	char *function_name = "mbsys_reson7k_extract_svp";
+	int status = MB_SUCCESS;
+	struct mb_io_struct *mb_io_ptr;
+	struct mbsys_reson7k_struct *store;
+	s7kr_svp *svp;
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mb_ptr:     %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+	}
+
+	/* get mbio descriptor */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+
+	/* get data structure pointer */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+	svp = (s7kr_svp *)&store->svp;
+
+	/* get data kind */
+	*kind = store->kind;
+
+	/* extract data from structure */
+	if (*kind == MB_DATA_VELOCITY_PROFILE) {
+		/* get number of depth-velocity pairs */
+		*nsvp = svp->n;
+
+		/* get profile */
+		for (i = 0; i < *nsvp; i++) {
+			depth[i] = svp->depth[i];
+			velocity[i] = svp->sound_velocity[i];
+		}
+
+		/* done translating values */
+	}
+
+	/* deal with comment */
+	else if (*kind == MB_DATA_COMMENT) {
+		/* set status */
+		*error = MB_ERROR_COMMENT;
+		status = MB_FAILURE;
+	}
+
+	/* deal with other record type */
+	else {
+		/* set status */
+		*error = MB_ERROR_OTHER;
+		status = MB_FAILURE;
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       kind:              %d\n", *kind);
+		fprintf(stderr, "dbg2       nsvp:              %d\n", *nsvp);
+		for (i = 0; i < *nsvp; i++)
+			fprintf(stderr, "dbg2       depth[%d]: %f   velocity[%d]: %f\n", i, depth[i], i, velocity[i]);
+		fprintf(stderr, "dbg2       error:             %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:            %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_insert_svp(int verbose, void *mbio_ptr, void *store_ptr, int nsvp, double *depth, double *velocity,
+                             int *error) {
+	char *function_name = "mbsys_reson7k_insert_svp";
+	int status = MB_SUCCESS;
+	struct mb_io_struct *mb_io_ptr;
+	struct mbsys_reson7k_struct *store;
+	s7kr_svp *svp;
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       nsvp:       %d\n", nsvp);
+		for (i = 0; i < nsvp; i++)
+			fprintf(stderr, "dbg2       depth[%d]: %f   velocity[%d]: %f\n", i, depth[i], i, velocity[i]);
+	}
+
+	/* get mbio descriptor */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+
+	/* get data structure pointer */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+	svp = (s7kr_svp *)&store->svp;
+
+	/* insert data in structure */
+	if (store->kind == MB_DATA_VELOCITY_PROFILE) {
+		/* the profile is replaced, so any arrays shared with copies are left to them */
+		status = mbsys_reson7k_unshare_payload(verbose, store_ptr, R7KSHARE_Svp, MB_NO, error);
+
+		/* allocate memory if necessary */
+		if (svp->nalloc < nsvp) {
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nsvp * sizeof(float), (void **)&(svp->depth), error);
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nsvp * sizeof(float), (void **)&(svp->sound_velocity), error);
+			if (status == MB_SUCCESS) {
+				svp->nalloc = nsvp;
+			}
+			else {
+				svp->n = 0;
+				svp->nalloc = 0;
+			}
+		}
+
+		/* get profile */
+		if (status == MB_SUCCESS) {
+			svp->n = nsvp;
+			for (i = 0; i < svp->n; i++) {
+				svp->depth[i] = depth[i];
+				svp->sound_velocity[i] = velocity[i];
+			}
+		}
+	}
+
+	/* the inserted profile supersedes the record as read */
+	if (store->kind == MB_DATA_VELOCITY_PROFILE)
+		mbsys_reson7k_rawrecord_modified(verbose, store_ptr, R7KRECID_SoundVelocityProfile, error);
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return value:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:  %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_extract_segytraceheader(int verbose, void *mbio_ptr, void *store_ptr, int *kind, void *segytraceheader_ptr,
+                                          int *error) {
+	char *function_name = "mbsys_reson7k_extract_segytraceheader";
+	int status = MB_SUCCESS;
+	struct mb_io_struct *mb_io_ptr;
+	struct mbsys_reson7k_struct *store;
+	struct mb_segytraceheader_struct *mb_segytraceheader_ptr;
+	s7k_header *header;
+	s7kr_bathymetry *bathymetry;
+	s7kr_bluefin *bluefin;
+	s7kr_fsdwsb *fsdwsb;
+	s7k_fsdwchannel *fsdwchannel;
+	s7k_fsdwsegyheader *fsdwsegyheader;
+	s7kr_ctd *ctd;
+	double dsonardepth, dsonaraltitude, dwaterdepth;
+	int sonardepth, waterdepth;
+	int watersoundspeed;
+	float fwatertime;
+	double longitude, latitude;
+	double speed, heading;
+	double roll, pitch, heave;
+	double xtrackmin;
+	int time_j[5];
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:        %d\n", verbose);
+		fprintf(stderr, "dbg2       mb_ptr:         %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       store_ptr:      %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       kind:           %d\n", *kind);
+		fprintf(stderr, "dbg2       segytraceheader_ptr: %p\n", (void *)segytraceheader_ptr);
+	}
+
+	/* get mbio descriptor */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+
+	/* get data structure pointer */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+
+	/* get data kind */
+	*kind = store->kind;
+
+	/* extract data from structure */
+	if (*kind == MB_DATA_SUBBOTTOM_SUBBOTTOM) {
+		/* get relevant structures */
+		mb_segytraceheader_ptr = (struct mb_segytraceheader_struct *)segytraceheader_ptr;
+		bathymetry = &(store->bathymetry);
+		bluefin = &(store->bluefin);
+		ctd = &(store->ctd);
+		fsdwsb = &(store->fsdwsb);
+		header = &(fsdwsb->header);
+		fsdwchannel = &(fsdwsb->channel);
+		fsdwsegyheader = &(fsdwsb->segyheader);
+
+		/* get needed values */
+		mb_depint_interp(verbose, mbio_ptr, store->time_d, &dsonardepth, error);
+		mb_altint_interp(verbose, mbio_ptr, store->time_d, &dsonaraltitude, error);
+		dwaterdepth = dsonardepth + dsonaraltitude;
+
+		/* if possible get altitude from nadir of multibeam bathymetry */
+		if (bathymetry->optionaldata == MB_YES) {
+			/* get depth closest to nadir */
+			xtrackmin = 999999.9;
+			for (i = 0; i < bathymetry->number_beams; i++) {
+				if (((bathymetry->quality[i] & 15) == 15) && fabs((double)bathymetry->acrosstrack[i]) < xtrackmin) {
+					dwaterdepth = bathymetry->depth[i];
+					dsonaraltitude = bathymetry->depth[i] - dsonardepth;
+					xtrackmin = fabs((double)bathymetry->acrosstrack[i]);
+				}
+			}
+		}
+
+		/* get needed values */
+		sonardepth = (int)(100 * dsonardepth);
+		waterdepth = (int)(100 * dwaterdepth);
+		if (ctd->n > 0)
+			watersoundspeed = (int)(ctd->sound_velocity[ctd->n - 1]);
+		else if (bluefin->environmental[0].sound_speed > 0.0)
+			watersoundspeed = (int)(bluefin->environmental[0].sound_speed);
+		else
+			watersoundspeed = 1500;
+		fwatertime = 2.0 * dwaterdepth / ((double)watersoundspeed);
+
+		mb_hedint_interp(verbose, mbio_ptr, store->time_d, &heading, error);
+		speed = 0.0;
+		mb_navint_interp(verbose, mbio_ptr, store->time_d, heading, speed, &longitude, &latitude, &speed, error);
+		mb_attint_interp(verbose, mbio_ptr, store->time_d, &heave, &roll, &pitch, error);
+		if (longitude == 0.0 && latitude == 0.0 && bathymetry->longitude != 0.0 && bathymetry->latitude != 0.0) {
+			longitude = RTD * bathymetry->longitude;
+			latitude = RTD * bathymetry->latitude;
+		}
+		mb_get_jtime(verbose, store->time_i, time_j);
+
+		/* extract the data */
+		mb_segytraceheader_ptr->seq_num = fsdwsb->ping_number;
+		mb_segytraceheader_ptr->seq_reel = fsdwsb->ping_number;
+		mb_segytraceheader_ptr->shot_num = fsdwsb->ping_number;
+		mb_segytraceheader_ptr->shot_tr = 1;
+		mb_segytraceheader_ptr->espn = 0;
+		mb_segytraceheader_ptr->rp_num = fsdwsb->ping_number;
+		mb_segytraceheader_ptr->rp_tr = 1;
+		mb_segytraceheader_ptr->trc_id = 1;
+		mb_segytraceheader_ptr->num_vstk = 0;
+		mb_segytraceheader_ptr->cdp_fold = 0;
+		mb_segytraceheader_ptr->use = fsdwsb->data_format;
+		mb_segytraceheader_ptr->range = 0;
+		mb_segytraceheader_ptr->grp_elev = -sonardepth;
+		mb_segytraceheader_ptr->src_elev = -sonardepth;
+		mb_segytraceheader_ptr->src_depth = sonardepth;
+		mb_segytraceheader_ptr->grp_datum = 0;
+		mb_segytraceheader_ptr->src_datum = 0;
+		mb_segytraceheader_ptr->src_wbd = waterdepth;
+		mb_segytraceheader_ptr->grp_wbd = waterdepth;
+		mb_segytraceheader_ptr->elev_scalar = -100; /* 0.01 m precision for depths */
+		mb_segytraceheader_ptr->coord_scalar = -100; /* 0.01 arc second precision for position
+		                     = 0.3 m precision at equator */
+		mb_segytraceheader_ptr->src_long = (int)(longitude * 360000.0);
+		mb_segytraceheader_ptr->src_lat = (int)(latitude * 360000.0);
+		mb_segytraceheader_ptr->grp_long = (int)(longitude * 360000.0);
+		mb_segytraceheader_ptr->grp_lat = (int)(latitude * 360000.0);
+		mb_segytraceheader_ptr->coord_units = 2;
+		mb_segytraceheader_ptr->wvel = watersoundspeed;
+		mb_segytraceheader_ptr->sbvel = 0;
+		mb_segytraceheader_ptr->src_up_vel = 0;
+		mb_segytraceheader_ptr->grp_up_vel = 0;
+		mb_segytraceheader_ptr->src_static = 0;
+		mb_segytraceheader_ptr->grp_static = 0;
+		mb_segytraceheader_ptr->tot_static = 0;
+		mb_segytraceheader_ptr->laga = 0;
+		mb_segytraceheader_ptr->delay_mils = 0;
+		mb_segytraceheader_ptr->smute_mils = 0;
+		mb_segytraceheader_ptr->emute_mils = 0;
+		mb_segytraceheader_ptr->nsamps = fsdwchannel->number_samples;
+		mb_segytraceheader_ptr->si_micros = fsdwchannel->sample_interval;
+		for (i = 0; i < 19; i++)
+			mb_segytraceheader_ptr->other_1[i] = 0;
+		mb_segytraceheader_ptr->year = store->time_i[0];
+		mb_segytraceheader_ptr->day_of_yr = time_j[1];
+		mb_segytraceheader_ptr->hour = store->time_i[3];
+		mb_segytraceheader_ptr->min = store->time_i[4];
+		mb_segytraceheader_ptr->sec = store->time_i[5];
+		mb_segytraceheader_ptr->mils = store->time_i[6] / 1000;
+		mb_segytraceheader_ptr->tr_weight = 1;
+		for (i = 0; i < 5; i++)
+			mb_segytraceheader_ptr->other_2[i] = 0;
+		mb_segytraceheader_ptr->delay = 0.0;
+		mb_segytraceheader_ptr->smute_sec = 0.0;
+		mb_segytraceheader_ptr->emute_sec = 0.0;
+		mb_segytraceheader_ptr->si_secs = 0.000001 * ((float)fsdwchannel->sample_interval);
+		mb_segytraceheader_ptr->wbt_secs = fwatertime;
+		mb_segytraceheader_ptr->end_of_rp = 0;
+		mb_segytraceheader_ptr->dummy1 = 0.0;
+		mb_segytraceheader_ptr->dummy2 = 0.0;
+		mb_segytraceheader_ptr->dummy3 = 0.0;
+		mb_segytraceheader_ptr->dummy4 = 0.0;
+		mb_segytraceheader_ptr->soundspeed = watersoundspeed;
+		mb_segytraceheader_ptr->distance = 0.0;
+		mb_segytraceheader_ptr->roll = (float)roll;
+		mb_segytraceheader_ptr->pitch = (float)pitch;
+		mb_segytraceheader_ptr->heading = (float)heading;
+
+		/* done translating values */
+	}
+
+	/* deal with comment */
+	else if (*kind == MB_DATA_COMMENT) {
+		/* set status */
+		*error = MB_ERROR_COMMENT;
+		status = MB_FAILURE;
+	}
+
+	/* deal with other record type */
+	else {
+		/* set status */
+		*error = MB_ERROR_OTHER;
+		status = MB_FAILURE;
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       kind:              %d\n", *kind);
+		if (*kind == MB_DATA_SUBBOTTOM_SUBBOTTOM) {
+			mb_segytraceheader_ptr = (struct mb_segytraceheader_struct *)segytraceheader_ptr;
+			fprintf(stderr, "dbg2       seq_num:           %d\n", mb_segytraceheader_ptr->seq_num);
+			fprintf(stderr, "dbg2       seq_reel:          %d\n", mb_segytraceheader_ptr->seq_reel);
+			fprintf(stderr, "dbg2       shot_num:          %d\n", mb_segytraceheader_ptr->shot_num);
+			fprintf(stderr, "dbg2       shot_tr:           %d\n", mb_segytraceheader_ptr->shot_tr);
+			fprintf(stderr, "dbg2       espn:              %d\n", mb_segytraceheader_ptr->espn);
+			fprintf(stderr, "dbg2       rp_num:            %d\n", mb_segytraceheader_ptr->rp_num);
+			fprintf(stderr, "dbg2       rp_tr:             %d\n", mb_segytraceheader_ptr->rp_tr);
+			fprintf(stderr, "dbg2       trc_id:            %d\n", mb_segytraceheader_ptr->trc_id);
+			fprintf(stderr, "dbg2       num_vstk:          %d\n", mb_segytraceheader_ptr->num_vstk);
+			fprintf(stderr, "dbg2       cdp_fold:          %d\n", mb_segytraceheader_ptr->cdp_fold);
+			fprintf(stderr, "dbg2       use:               %d\n", mb_segytraceheader_ptr->use);
+			fprintf(stderr, "dbg2       range:             %d\n", mb_segytraceheader_ptr->range);
+			fprintf(stderr, "dbg2       grp_elev:          %d\n", mb_segytraceheader_ptr->grp_elev);
+			fprintf(stderr, "dbg2       src_elev:          %d\n", mb_segytraceheader_ptr->src_elev);
+			fprintf(stderr, "dbg2       src_depth:         %d\n", mb_segytraceheader_ptr->src_depth);
+			fprintf(stderr, "dbg2       grp_datum:         %d\n", mb_segytraceheader_ptr->grp_datum);
+			fprintf(stderr, "dbg2       src_datum:         %d\n", mb_segytraceheader_ptr->src_datum);
+			fprintf(stderr, "dbg2       src_wbd:           %d\n", mb_segytraceheader_ptr->src_wbd);
+			fprintf(stderr, "dbg2       grp_wbd:           %d\n", mb_segytraceheader_ptr->grp_wbd);
+			fprintf(stderr, "dbg2       elev_scalar:       %d\n", mb_segytraceheader_ptr->elev_scalar);
+			fprintf(stderr, "dbg2       coord_scalar:      %d\n", mb_segytraceheader_ptr->coord_scalar);
+			fprintf(stderr, "dbg2       src_long:          %d\n", mb_segytraceheader_ptr->src_long);
+			fprintf(stderr, "dbg2       src_lat:           %d\n", mb_segytraceheader_ptr->src_lat);
+			fprintf(stderr, "dbg2       grp_long:          %d\n", mb_segytraceheader_ptr->grp_long);
+			fprintf(stderr, "dbg2       grp_lat:           %d\n", mb_segytraceheader_ptr->grp_lat);
+			fprintf(stderr, "dbg2       coord_units:       %d\n", mb_segytraceheader_ptr->coord_units);
+			fprintf(stderr, "dbg2       wvel:              %d\n", mb_segytraceheader_ptr->wvel);
+			fprintf(stderr, "dbg2       sbvel:             %d\n", mb_segytraceheader_ptr->sbvel);
+			fprintf(stderr, "dbg2       src_up_vel:        %d\n", mb_segytraceheader_ptr->src_up_vel);
+			fprintf(stderr, "dbg2       grp_up_vel:        %d\n", mb_segytraceheader_ptr->grp_up_vel);
+			fprintf(stderr, "dbg2       src_static:        %d\n", mb_segytraceheader_ptr->src_static);
+			fprintf(stderr, "dbg2       grp_static:        %d\n", mb_segytraceheader_ptr->grp_static);
+			fprintf(stderr, "dbg2       tot_static:        %d\n", mb_segytraceheader_ptr->tot_static);
+			fprintf(stderr, "dbg2       laga:              %d\n", mb_segytraceheader_ptr->laga);
+			fprintf(stderr, "dbg2       delay_mils:        %d\n", mb_segytraceheader_ptr->delay_mils);
+			fprintf(stderr, "dbg2       smute_mils:        %d\n", mb_segytraceheader_ptr->smute_mils);
+			fprintf(stderr, "dbg2       emute_mils:        %d\n", mb_segytraceheader_ptr->emute_mils);
+			fprintf(stderr, "dbg2       nsamps:            %d\n", mb_segytraceheader_ptr->nsamps);
+			fprintf(stderr, "dbg2       si_micros:         %d\n", mb_segytraceheader_ptr->si_micros);
+			for (i = 0; i < 19; i++)
+				fprintf(stderr, "dbg2       other_1[%2d]:       %d\n", i, mb_segytraceheader_ptr->other_1[i]);
+			fprintf(stderr, "dbg2       year:              %d\n", mb_segytraceheader_ptr->year);
+			fprintf(stderr, "dbg2       day_of_yr:         %d\n", mb_segytraceheader_ptr->day_of_yr);
+			fprintf(stderr, "dbg2       hour:              %d\n", mb_segytraceheader_ptr->hour);
+			fprintf(stderr, "dbg2       min:               %d\n", mb_segytraceheader_ptr->min);
+			fprintf(stderr, "dbg2       sec:               %d\n", mb_segytraceheader_ptr->sec);
+			fprintf(stderr, "dbg2       mils:              %d\n", mb_segytraceheader_ptr->mils);
+			fprintf(stderr, "dbg2       tr_weight:         %d\n", mb_segytraceheader_ptr->tr_weight);
+			for (i = 0; i < 5; i++)
+				fprintf(stderr, "dbg2       other_2[%2d]:       %d\n", i, mb_segytraceheader_ptr->other_2[i]);
+			fprintf(stderr, "dbg2       delay:             %f\n", mb_segytraceheader_ptr->delay);
+			fprintf(stderr, "dbg2       smute_sec:         %f\n", mb_segytraceheader_ptr->smute_sec);
+			fprintf(stderr, "dbg2       emute_sec:         %f\n", mb_segytraceheader_ptr->emute_sec);
+			fprintf(stderr, "dbg2       si_secs:           %f\n", mb_segytraceheader_ptr->si_secs);
+			fprintf(stderr, "dbg2       wbt_secs:          %f\n", mb_segytraceheader_ptr->wbt_secs);
+			fprintf(stderr, "dbg2       end_of_rp:         %d\n", mb_segytraceheader_ptr->end_of_rp);
+			fprintf(stderr, "dbg2       dummy1:            %f\n", mb_segytraceheader_ptr->dummy1);
+			fprintf(stderr, "dbg2       dummy2:            %f\n", mb_segytraceheader_ptr->dummy2);
+			fprintf(stderr, "dbg2       dummy3:            %f\n", mb_segytraceheader_ptr->dummy3);
+			fprintf(stderr, "dbg2       dummy4:            %f\n", mb_segytraceheader_ptr->dummy4);
+			fprintf(stderr, "dbg2       soundspeed:        %f\n", mb_segytraceheader_ptr->soundspeed);
+			fprintf(stderr, "dbg2       distance:          %f\n", mb_segytraceheader_ptr->distance);
+			fprintf(stderr, "dbg2       roll:              %f\n", mb_segytraceheader_ptr->roll);
+			fprintf(stderr, "dbg2       pitch:             %f\n", mb_segytraceheader_ptr->pitch);
+			fprintf(stderr, "dbg2       heading:           %f\n", mb_segytraceheader_ptr->heading);
+		}
+		fprintf(stderr, "dbg2       error:             %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:            %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_extract_segy(int verbose, void *mbio_ptr, void *store_ptr, int *sampleformat, int *kind, void *segyheader_ptr,
+                               float *segydata, int *error) {
+	char *function_name = "mbsys_reson7k_extract_segy";
+	int status = MB_SUCCESS;
+	struct mb_io_struct *mb_io_ptr;
+	struct mbsys_reson7k_struct *store;
+	struct mb_segytraceheader_struct *mb_segytraceheader_ptr;
+	s7k_header *header;
+	s7kr_fsdwsb *fsdwsb;
+	s7k_fsdwchannel *fsdwchannel;
+	s7k_fsdwsegyheader *fsdwsegyheader;
+	short *shortptr;
+	unsigned short *ushortptr;
+	double weight;
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:           %d\n", verbose);
+		fprintf(stderr, "dbg2       mb_ptr:            %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       store_ptr:         %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       sampleformat:      %d\n", *sampleformat);
+		fprintf(stderr, "dbg2       kind:              %d\n", *kind);
+		fprintf(stderr, "dbg2       segyheader_ptr:    %p\n", (void *)segyheader_ptr);
+		fprintf(stderr, "dbg2       segydata:          %p\n", (void *)segydata);
+	}
+
+	/* get mbio descriptor */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+
+	/* get data structure pointer */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+
+	/* get data kind */
+	*kind = store->kind;
+
+	/* extract data from structure */
+	if (*kind == MB_DATA_SUBBOTTOM_SUBBOTTOM) {
+		/* extract segy header */
+		status = mbsys_reson7k_extract_segytraceheader(verbose, mbio_ptr, store_ptr, kind, segyheader_ptr, error);
+
+		/* get relevant structures */
+		mb_segytraceheader_ptr = (struct mb_segytraceheader_struct *)segyheader_ptr;
+		fsdwsb = &(store->fsdwsb);
+		header = &(fsdwsb->header);
+		fsdwchannel = &(fsdwsb->channel);
+		fsdwsegyheader = &(fsdwsb->segyheader);
+		shortptr = (short *)fsdwchannel->data;
+		ushortptr = (unsigned short *)fsdwchannel->data;
+
+		/* get the trace weight */
+		weight = exp(MB_LN_2 * ((double)fsdwsegyheader->weightingFactor));
+		/*fprintf(stderr, "Subbottom: Weight: %d %f\n",fsdwsegyheader->weightingFactor,weight);*/
+
+		/* extract the data */
+		if (fsdwsb->data_format == EDGETECH_TRACEFORMAT_ENVELOPE) {
+			*sampleformat = MB_SEGY_SAMPLEFORMAT_ENVELOPE;
+			for (i = 0; i < fsdwchannel->number_samples; i++) {
+				segydata[i] = (float)(((double)ushortptr[i]) / weight);
+			}
+		}
+		else if (fsdwsb->data_format == EDGETECH_TRACEFORMAT_ANALYTIC) {
+			/* if no format specified do envelope by default */
+			if (*sampleformat == MB_SEGY_SAMPLEFORMAT_NONE)
+				*sampleformat = MB_SEGY_SAMPLEFORMAT_ENVELOPE;
+
+			/* convert analytic data to desired envelope */
+			if (*sampleformat == MB_SEGY_SAMPLEFORMAT_ENVELOPE) {
+				for (i = 0; i < fsdwchannel->number_samples; i++) {
+					segydata[i] =
+					    (float)(sqrt((double)(shortptr[2 * i] * shortptr[2 * i] + shortptr[2 * i + 1] * shortptr[2 * i + 1])) /
+					            weight);
+				}
+			}
+
+			/* else extract desired analytic data */
+			else if (*sampleformat == MB_SEGY_SAMPLEFORMAT_ANALYTIC) {
+				for (i = 0; i < fsdwchannel->number_samples; i++) {
+					segydata[2 * i] = (float)(((double)shortptr[2 * i]) / weight);
+					segydata[2 * i + 1] = (float)(((double)shortptr[2 * i + 1]) / weight);
+				}
+			}
+
+			/* else extract desired real trace from analytic data */
+			else if (*sampleformat == MB_SEGY_SAMPLEFORMAT_TRACE) {
+				for (i = 0; i < fsdwchannel->number_samples; i++) {
+					segydata[i] = (float)(((double)shortptr[2 * i]) / weight);
+				}
+			}
+		}
+		else if (fsdwsb->data_format == EDGETECH_TRACEFORMAT_RAW) {
+			*sampleformat = MB_SEGY_SAMPLEFORMAT_TRACE;
+			for (i = 0; i < fsdwchannel->number_samples; i++) {
+				segydata[i] = (float)(((double)ushortptr[i]) / weight);
+			}
+		}
+		else if (fsdwsb->data_format == EDGETECH_TRACEFORMAT_REALANALYTIC) {
+			*sampleformat = MB_SEGY_SAMPLEFORMAT_TRACE;
+			for (i = 0; i < fsdwchannel->number_samples; i++) {
+				segydata[i] = (float)(((double)ushortptr[i]) / weight);
+			}
+		}
+		else if (fsdwsb->data_format == EDGETECH_TRACEFORMAT_PIXEL) {
+			*sampleformat = MB_SEGY_SAMPLEFORMAT_TRACE;
+			for (i = 0; i < fsdwchannel->number_samples; i++) {
+				segydata[i] = (float)(((double)ushortptr[i]) / weight);
+			}
+		}
+
+		/* done translating values */
+	}
+
+	/* deal with comment */
+	else if (*kind == MB_DATA_COMMENT) {
+		/* set status */
+		*error = MB_ERROR_COMMENT;
+		status = MB_FAILURE;
+	}
+
+	/* deal with other record type */
+	else {
+		/* set status */
+		*error = MB_ERROR_OTHER;
+		status = MB_FAILURE;
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       sampleformat:      %d\n", *sampleformat);
+		fprintf(stderr, "dbg2       kind:              %d\n", *kind);
+		fprintf(stderr, "dbg2       seq_num:           %d\n", mb_segytraceheader_ptr->seq_num);
+		fprintf(stderr, "dbg2       seq_reel:          %d\n", mb_segytraceheader_ptr->seq_reel);
+		fprintf(stderr, "dbg2       shot_num:          %d\n", mb_segytraceheader_ptr->shot_num);
+		fprintf(stderr, "dbg2       shot_tr:           %d\n", mb_segytraceheader_ptr->shot_tr);
+		fprintf(stderr, "dbg2       espn:              %d\n", mb_segytraceheader_ptr->espn);
+		fprintf(stderr, "dbg2       rp_num:            %d\n", mb_segytraceheader_ptr->rp_num);
+		fprintf(stderr, "dbg2       rp_tr:             %d\n", mb_segytraceheader_ptr->rp_tr);
+		fprintf(stderr, "dbg2       trc_id:            %d\n", mb_segytraceheader_ptr->trc_id);
+		fprintf(stderr, "dbg2       num_vstk:          %d\n", mb_segytraceheader_ptr->num_vstk);
+		fprintf(stderr, "dbg2       cdp_fold:          %d\n", mb_segytraceheader_ptr->cdp_fold);
+		fprintf(stderr, "dbg2       use:               %d\n", mb_segytraceheader_ptr->use);
+		fprintf(stderr, "dbg2       range:             %d\n", mb_segytraceheader_ptr->range);
+		fprintf(stderr, "dbg2       grp_elev:          %d\n", mb_segytraceheader_ptr->grp_elev);
+		fprintf(stderr, "dbg2       src_elev:          %d\n", mb_segytraceheader_ptr->src_elev);
+		fprintf(stderr, "dbg2       src_depth:         %d\n", mb_segytraceheader_ptr->src_depth);
+		fprintf(stderr, "dbg2       grp_datum:         %d\n", mb_segytraceheader_ptr->grp_datum);
+		fprintf(stderr, "dbg2       src_datum:         %d\n", mb_segytraceheader_ptr->src_datum);
+		fprintf(stderr, "dbg2       src_wbd:           %d\n", mb_segytraceheader_ptr->src_wbd);
+		fprintf(stderr, "dbg2       grp_wbd:           %d\n", mb_segytraceheader_ptr->grp_wbd);
+		fprintf(stderr, "dbg2       elev_scalar:       %d\n", mb_segytraceheader_ptr->elev_scalar);
+		fprintf(stderr, "dbg2       coord_scalar:      %d\n", mb_segytraceheader_ptr->coord_scalar);
+		fprintf(stderr, "dbg2       src_long:          %d\n", mb_segytraceheader_ptr->src_long);
+		fprintf(stderr, "dbg2       src_lat:           %d\n", mb_segytraceheader_ptr->src_lat);
+		fprintf(stderr, "dbg2       grp_long:          %d\n", mb_segytraceheader_ptr->grp_long);
+		fprintf(stderr, "dbg2       grp_lat:           %d\n", mb_segytraceheader_ptr->grp_lat);
+		fprintf(stderr, "dbg2       coord_units:       %d\n", mb_segytraceheader_ptr->coord_units);
+		fprintf(stderr, "dbg2       wvel:              %d\n", mb_segytraceheader_ptr->wvel);
+		fprintf(stderr, "dbg2       sbvel:             %d\n", mb_segytraceheader_ptr->sbvel);
+		fprintf(stderr, "dbg2       src_up_vel:        %d\n", mb_segytraceheader_ptr->src_up_vel);
+		fprintf(stderr, "dbg2       grp_up_vel:        %d\n", mb_segytraceheader_ptr->grp_up_vel);
+		fprintf(stderr, "dbg2       src_static:        %d\n", mb_segytraceheader_ptr->src_static);
+		fprintf(stderr, "dbg2       grp_static:        %d\n", mb_segytraceheader_ptr->grp_static);
+		fprintf(stderr, "dbg2       tot_static:        %d\n", mb_segytraceheader_ptr->tot_static);
+		fprintf(stderr, "dbg2       laga:              %d\n", mb_segytraceheader_ptr->laga);
+		fprintf(stderr, "dbg2       delay_mils:        %d\n", mb_segytraceheader_ptr->delay_mils);
+		fprintf(stderr, "dbg2       smute_mils:        %d\n", mb_segytraceheader_ptr->smute_mils);
+		fprintf(stderr, "dbg2       emute_mils:        %d\n", mb_segytraceheader_ptr->emute_mils);
+		fprintf(stderr, "dbg2       nsamps:            %d\n", mb_segytraceheader_ptr->nsamps);
+		fprintf(stderr, "dbg2       si_micros:         %d\n", mb_segytraceheader_ptr->si_micros);
+		for (i = 0; i < 19; i++)
+			fprintf(stderr, "dbg2       other_1[%2d]:       %d\n", i, mb_segytraceheader_ptr->other_1[i]);
+		fprintf(stderr, "dbg2       year:              %d\n", mb_segytraceheader_ptr->year);
+		fprintf(stderr, "dbg2       day_of_yr:         %d\n", mb_segytraceheader_ptr->day_of_yr);
+		fprintf(stderr, "dbg2       hour:              %d\n", mb_segytraceheader_ptr->hour);
+		fprintf(stderr, "dbg2       min:               %d\n", mb_segytraceheader_ptr->min);
+		fprintf(stderr, "dbg2       sec:               %d\n", mb_segytraceheader_ptr->sec);
+		fprintf(stderr, "dbg2       mils:              %d\n", mb_segytraceheader_ptr->mils);
+		fprintf(stderr, "dbg2       tr_weight:         %d\n", mb_segytraceheader_ptr->tr_weight);
+		for (i = 0; i < 5; i++)
+			fprintf(stderr, "dbg2       other_2[%2d]:       %d\n", i, mb_segytraceheader_ptr->other_2[i]);
+		fprintf(stderr, "dbg2       delay:             %f\n", mb_segytraceheader_ptr->delay);
+		fprintf(stderr, "dbg2       smute_sec:         %f\n", mb_segytraceheader_ptr->smute_sec);
+		fprintf(stderr, "dbg2       emute_sec:         %f\n", mb_segytraceheader_ptr->emute_sec);
+		fprintf(stderr, "dbg2       si_secs:           %f\n", mb_segytraceheader_ptr->si_secs);
+		fprintf(stderr, "dbg2       wbt_secs:          %f\n", mb_segytraceheader_ptr->wbt_secs);
+		fprintf(stderr, "dbg2       end_of_rp:         %d\n", mb_segytraceheader_ptr->end_of_rp);
+		fprintf(stderr, "dbg2       dummy1:            %f\n", mb_segytraceheader_ptr->dummy1);
+		fprintf(stderr, "dbg2       dummy2:            %f\n", mb_segytraceheader_ptr->dummy2);
+		fprintf(stderr, "dbg2       dummy3:            %f\n", mb_segytraceheader_ptr->dummy3);
+		fprintf(stderr, "dbg2       dummy4:            %f\n", mb_segytraceheader_ptr->dummy4);
+		fprintf(stderr, "dbg2       soundspeed:        %f\n", mb_segytraceheader_ptr->soundspeed);
+		fprintf(stderr, "dbg2       distance:          %f\n", mb_segytraceheader_ptr->distance);
+		fprintf(stderr, "dbg2       roll:              %f\n", mb_segytraceheader_ptr->roll);
+		fprintf(stderr, "dbg2       pitch:             %f\n", mb_segytraceheader_ptr->pitch);
+		fprintf(stderr, "dbg2       heading:           %f\n", mb_segytraceheader_ptr->heading);
+		for (i = 0; i < mb_segytraceheader_ptr->nsamps; i++)
+			fprintf(stderr, "dbg2       segydata[%d]:      %f\n", i, segydata[i]);
+		fprintf(stderr, "dbg2       error:             %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:            %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_insert_segy(int verbose, void *mbio_ptr, void *store_ptr, int kind, void *segyheader_ptr, float *segydata,
+                              int *error) {
+	char *function_name = "mbsys_reson7k_insert_segy";
+	int status = MB_SUCCESS;
+	struct mb_io_struct *mb_io_ptr;
+	struct mbsys_reson7k_struct *store;
+	struct mb_segytraceheader_struct *mb_segytraceheader_ptr;
+	s7k_header *header;
+	s7kr_bathymetry *bathymetry;
+	s7kr_fsdwsb *fsdwsb;
+	s7k_fsdwchannel *fsdwchannel;
+	s7k_fsdwsegyheader *fsdwsegyheader;
+	s7kr_ctd *ctd;
+	double dsonardepth, dsonaraltitude, dwaterdepth;
+	int sonardepth, waterdepth;
+	int watersoundspeed;
+	float fwatertime;
+	int time_j[5];
+	float factor;
+	float datamax;
+	double weight;
+	int data_size;
+	short *shortptr;
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:        %d\n", verbose);
+		fprintf(stderr, "dbg2       mb_ptr:         %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       store_ptr:      %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       kind:           %d\n", kind);
+		fprintf(stderr, "dbg2       segyheader_ptr: %p\n", (void *)segyheader_ptr);
+	}
+
+	/* get mbio descriptor */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+
+	/* get data structure pointer */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+
+	/* get data kind */
+	store->kind = kind;
+
+	/* insert data to structure */
+	if (store->kind == MB_DATA_SUBBOTTOM_SUBBOTTOM) {
+		/* get relevant structures */
+		mb_segytraceheader_ptr = (struct mb_segytraceheader_struct *)segyheader_ptr;
+		bathymetry = &(store->bathymetry);
+		ctd = &(store->ctd);
+		fsdwsb = &(store->fsdwsb);
+		header = &(fsdwsb->header);
+		fsdwchannel = &(fsdwsb->channel);
+		fsdwsegyheader = &(fsdwsb->segyheader);
+
+		/* the trace is written into the channel data, so a copy shared with
+		    other stores must first become this store's own */
+		status = mbsys_reson7k_unshare_payload(verbose, store_ptr, R7KSHARE_Fsdwsb, MB_YES, error);
+
+		/* get needed values */
+		mb_depint_interp(verbose, mbio_ptr, store->time_d, &dsonardepth, error);
+		mb_altint_interp(verbose, mbio_ptr, store->time_d, &dsonaraltitude, error);
+		dwaterdepth = dsonardepth + dsonaraltitude;
+		sonardepth = (int)(100 * dsonardepth);
+		waterdepth = (int)(100 * dwaterdepth);
+		if (ctd->n > 0)
+			watersoundspeed = (int)(ctd->sound_velocity[ctd->n - 1]);
+		else
+			watersoundspeed = 1500;
+		fwatertime = 2.0 * 0.01 * ((double)waterdepth) / ((double)watersoundspeed);
+		mb_get_jtime(verbose, store->time_i, time_j);
+
+		/* extract the data */
+		if (mb_segytraceheader_ptr->shot_num != 0)
+			fsdwsb->ping_number = mb_segytraceheader_ptr->shot_num;
+		else if (mb_segytraceheader_ptr->seq_reel != 0)
+			fsdwsb->ping_number = mb_segytraceheader_ptr->seq_reel;
+		else if (mb_segytraceheader_ptr->seq_num != 0)
+			fsdwsb->ping_number = mb_segytraceheader_ptr->seq_num;
+		else if (mb_segytraceheader_ptr->rp_num != 0)
+			fsdwsb->ping_number = mb_segytraceheader_ptr->rp_num;
+		else
+			fsdwsb->ping_number = 0;
+		fsdwsb->data_format = mb_segytraceheader_ptr->use;
+		if (mb_segytraceheader_ptr->grp_elev != 0)
+			sonardepth = -mb_segytraceheader_ptr->grp_elev;
+		else if (mb_segytraceheader_ptr->src_elev != 0)
+			sonardepth = -mb_segytraceheader_ptr->src_elev;
+		else if (mb_segytraceheader_ptr->src_depth != 0)
+			sonardepth = mb_segytraceheader_ptr->src_depth;
+		else
+			sonardepth = 0;
+		if (mb_segytraceheader_ptr->elev_scalar < 0)
 			factor = 1.0 / ((float)(-mb_segytraceheader_ptr->elev_scalar));
 		else
 			factor = (float)mb_segytraceheader_ptr->elev_scalar;
@@ -9186,169 +12561,2901 @@ int mbsys_reson7k_insert_segy(int verbose, void *mbio_ptr, void *store_ptr, int
 		else if (mb_segytraceheader_ptr->grp_wbd != 0)
 			waterdepth = -mb_segytraceheader_ptr->src_elev;
 		else
-			waterdepth = 0;
-		if (mb_segytraceheader_ptr->coord_scalar < 0)
-			factor = 1.0 / ((float)(-mb_segytraceheader_ptr->coord_scalar)) / 3600.0;
+			waterdepth = 0;
+		if (mb_segytraceheader_ptr->coord_scalar < 0)
+			factor = 1.0 / ((float)(-mb_segytraceheader_ptr->coord_scalar)) / 3600.0;
+		else
+			factor = (float)mb_segytraceheader_ptr->coord_scalar / 3600.0;
+		fsdwchannel->number_samples = mb_segytraceheader_ptr->nsamps;
+		fsdwchannel->sample_interval = mb_segytraceheader_ptr->si_micros;
+		time_j[0] = mb_segytraceheader_ptr->year;
+		time_j[1] = mb_segytraceheader_ptr->day_of_yr;
+		time_j[2] = 60 * mb_segytraceheader_ptr->hour + mb_segytraceheader_ptr->min;
+		time_j[3] = mb_segytraceheader_ptr->sec;
+		time_j[4] = 1000 * mb_segytraceheader_ptr->mils;
+		mb_get_itime(verbose, time_j, store->time_i);
+		mb_get_time(verbose, store->time_i, &(store->time_d));
+		header->s7kTime.Year = time_j[0];
+		header->s7kTime.Day = time_j[1];
+		header->s7kTime.Seconds = 0.000001 * store->time_i[6] + store->time_i[5];
+		header->s7kTime.Hours = store->time_i[3];
+		header->s7kTime.Minutes = store->time_i[4];
+
+		/* get max data value */
+		datamax = 0.0;
+		for (i = 0; i < mb_segytraceheader_ptr->nsamps; i++) {
+			if (fabs(segydata[i]) > datamax)
+				datamax = fabs(segydata[i]);
+		}
+		if (datamax > 0.0) {
+			fsdwsegyheader->weightingFactor = (short)(log(datamax) / MB_LN_2) - 15;
+		}
+		else
+			fsdwsegyheader->weightingFactor = 0;
+		weight = pow(2.0, (double)fsdwsegyheader->weightingFactor);
+		fsdwchannel->bytespersample = 2;
+
+		/* make sure enough memory is allocated for channel data */
+		data_size = fsdwchannel->bytespersample * fsdwchannel->number_samples;
+		if (fsdwchannel->data_alloc < data_size) {
+			status = mb_reallocd(verbose, __FILE__, __LINE__, data_size, (void **)&(fsdwchannel->data), error);
+			if (status == MB_SUCCESS) {
+				fsdwchannel->data_alloc = data_size;
+			}
+			else {
+				fsdwchannel->data_alloc = 0;
+				fsdwchannel->number_samples = 0;
+			}
+		}
+
+		/* copy over the data */
+		if (fsdwchannel->data_alloc >= data_size) {
+			shortptr = (short *)fsdwchannel->data;
+			for (i = 0; i < fsdwchannel->number_samples; i++) {
+				shortptr[i] = (short)(segydata[i] * weight);
+			}
+		}
+
+		/* done translating values */
+	}
+
+	/* deal with comment */
+	else if (kind == MB_DATA_COMMENT) {
+		/* set status */
+		*error = MB_ERROR_COMMENT;
+		status = MB_FAILURE;
+	}
+
+	/* deal with other record type */
+	else {
+		/* set status */
+		*error = MB_ERROR_OTHER;
+		status = MB_FAILURE;
+	}
+
+	/* the inserted values supersede the record as read */
+	mbsys_reson7k_rawrecord_modified(verbose, store_ptr, store->type, error);
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       seq_num:           %d\n", mb_segytraceheader_ptr->seq_num);
+		fprintf(stderr, "dbg2       seq_reel:          %d\n", mb_segytraceheader_ptr->seq_reel);
+		fprintf(stderr, "dbg2       shot_num:          %d\n", mb_segytraceheader_ptr->shot_num);
+		fprintf(stderr, "dbg2       shot_tr:           %d\n", mb_segytraceheader_ptr->shot_tr);
+		fprintf(stderr, "dbg2       espn:              %d\n", mb_segytraceheader_ptr->espn);
+		fprintf(stderr, "dbg2       rp_num:            %d\n", mb_segytraceheader_ptr->rp_num);
+		fprintf(stderr, "dbg2       rp_tr:             %d\n", mb_segytraceheader_ptr->rp_tr);
+		fprintf(stderr, "dbg2       trc_id:            %d\n", mb_segytraceheader_ptr->trc_id);
+		fprintf(stderr, "dbg2       num_vstk:          %d\n", mb_segytraceheader_ptr->num_vstk);
+		fprintf(stderr, "dbg2       cdp_fold:          %d\n", mb_segytraceheader_ptr->cdp_fold);
+		fprintf(stderr, "dbg2       use:               %d\n", mb_segytraceheader_ptr->use);
+		fprintf(stderr, "dbg2       range:             %d\n", mb_segytraceheader_ptr->range);
+		fprintf(stderr, "dbg2       grp_elev:          %d\n", mb_segytraceheader_ptr->grp_elev);
+		fprintf(stderr, "dbg2       src_elev:          %d\n", mb_segytraceheader_ptr->src_elev);
+		fprintf(stderr, "dbg2       src_depth:         %d\n", mb_segytraceheader_ptr->src_depth);
+		fprintf(stderr, "dbg2       grp_datum:         %d\n", mb_segytraceheader_ptr->grp_datum);
+		fprintf(stderr, "dbg2       src_datum:         %d\n", mb_segytraceheader_ptr->src_datum);
+		fprintf(stderr, "dbg2       src_wbd:           %d\n", mb_segytraceheader_ptr->src_wbd);
+		fprintf(stderr, "dbg2       grp_wbd:           %d\n", mb_segytraceheader_ptr->grp_wbd);
+		fprintf(stderr, "dbg2       elev_scalar:       %d\n", mb_segytraceheader_ptr->elev_scalar);
+		fprintf(stderr, "dbg2       coord_scalar:      %d\n", mb_segytraceheader_ptr->coord_scalar);
+		fprintf(stderr, "dbg2       src_long:          %d\n", mb_segytraceheader_ptr->src_long);
+		fprintf(stderr, "dbg2       src_lat:           %d\n", mb_segytraceheader_ptr->src_lat);
+		fprintf(stderr, "dbg2       grp_long:          %d\n", mb_segytraceheader_ptr->grp_long);
+		fprintf(stderr, "dbg2       grp_lat:           %d\n", mb_segytraceheader_ptr->grp_lat);
+		fprintf(stderr, "dbg2       coord_units:       %d\n", mb_segytraceheader_ptr->coord_units);
+		fprintf(stderr, "dbg2       wvel:              %d\n", mb_segytraceheader_ptr->wvel);
+		fprintf(stderr, "dbg2       sbvel:             %d\n", mb_segytraceheader_ptr->sbvel);
+		fprintf(stderr, "dbg2       src_up_vel:        %d\n", mb_segytraceheader_ptr->src_up_vel);
+		fprintf(stderr, "dbg2       grp_up_vel:        %d\n", mb_segytraceheader_ptr->grp_up_vel);
+		fprintf(stderr, "dbg2       src_static:        %d\n", mb_segytraceheader_ptr->src_static);
+		fprintf(stderr, "dbg2       grp_static:        %d\n", mb_segytraceheader_ptr->grp_static);
+		fprintf(stderr, "dbg2       tot_static:        %d\n", mb_segytraceheader_ptr->tot_static);
+		fprintf(stderr, "dbg2       laga:              %d\n", mb_segytraceheader_ptr->laga);
+		fprintf(stderr, "dbg2       delay_mils:        %d\n", mb_segytraceheader_ptr->delay_mils);
+		fprintf(stderr, "dbg2       smute_mils:        %d\n", mb_segytraceheader_ptr->smute_mils);
+		fprintf(stderr, "dbg2       emute_mils:        %d\n", mb_segytraceheader_ptr->emute_mils);
+		fprintf(stderr, "dbg2       nsamps:            %d\n", mb_segytraceheader_ptr->nsamps);
+		fprintf(stderr, "dbg2       si_micros:         %d\n", mb_segytraceheader_ptr->si_micros);
+		for (i = 0; i < 19; i++)
+			fprintf(stderr, "dbg2       other_1[%2d]:       %d\n", i, mb_segytraceheader_ptr->other_1[i]);
+		fprintf(stderr, "dbg2       year:              %d\n", mb_segytraceheader_ptr->year);
+		fprintf(stderr, "dbg2       day_of_yr:         %d\n", mb_segytraceheader_ptr->day_of_yr);
+		fprintf(stderr, "dbg2       hour:              %d\n", mb_segytraceheader_ptr->hour);
+		fprintf(stderr, "dbg2       min:               %d\n", mb_segytraceheader_ptr->min);
+		fprintf(stderr, "dbg2       sec:               %d\n", mb_segytraceheader_ptr->sec);
+		fprintf(stderr, "dbg2       mils:              %d\n", mb_segytraceheader_ptr->mils);
+		fprintf(stderr, "dbg2       tr_weight:         %d\n", mb_segytraceheader_ptr->tr_weight);
+		for (i = 0; i < 5; i++)
+			fprintf(stderr, "dbg2       other_2[%2d]:       %d\n", i, mb_segytraceheader_ptr->other_2[i]);
+		fprintf(stderr, "dbg2       delay:             %f\n", mb_segytraceheader_ptr->delay);
+		fprintf(stderr, "dbg2       smute_sec:         %f\n", mb_segytraceheader_ptr->smute_sec);
+		fprintf(stderr, "dbg2       emute_sec:         %f\n", mb_segytraceheader_ptr->emute_sec);
+		fprintf(stderr, "dbg2       si_secs:           %f\n", mb_segytraceheader_ptr->si_secs);
+		fprintf(stderr, "dbg2       wbt_secs:          %f\n", mb_segytraceheader_ptr->wbt_secs);
+		fprintf(stderr, "dbg2       end_of_rp:         %d\n", mb_segytraceheader_ptr->end_of_rp);
+		fprintf(stderr, "dbg2       dummy1:            %f\n", mb_segytraceheader_ptr->dummy1);
+		fprintf(stderr, "dbg2       dummy2:            %f\n", mb_segytraceheader_ptr->dummy2);
+		fprintf(stderr, "dbg2       dummy3:            %f\n", mb_segytraceheader_ptr->dummy3);
+		fprintf(stderr, "dbg2       dummy4:            %f\n", mb_segytraceheader_ptr->dummy4);
+		fprintf(stderr, "dbg2       soundspeed:        %f\n", mb_segytraceheader_ptr->soundspeed);
+		fprintf(stderr, "dbg2       distance:          %f\n", mb_segytraceheader_ptr->distance);
+		fprintf(stderr, "dbg2       roll:              %f\n", mb_segytraceheader_ptr->roll);
+		fprintf(stderr, "dbg2       pitch:             %f\n", mb_segytraceheader_ptr->pitch);
+		fprintf(stderr, "dbg2       heading:           %f\n", mb_segytraceheader_ptr->heading);
+		fprintf(stderr, "dbg2       error:             %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:            %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_ctd(int verbose, void *mbio_ptr, void *store_ptr, int *kind, int *nctd, double *time_d, double *conductivity,
+                      double *temperature, double *depth, double *salinity, double *soundspeed, int *error) {
+	char *function_name = "mbsys_reson7k_ctd";
+	struct mb_io_struct *mb_io_ptr;
+	struct mbsys_reson7k_struct *store;
+	s7k_header *header;
+	s7kr_bluefin *bluefin;
+	s7k_bluefin_environmental *environmental;
+	s7kr_ctd *ctd;
+	int status = MB_SUCCESS;
+	int time_j[5];
+	int time_i[7];
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mb_ptr:     %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+	}
+
+	/* get mbio descriptor */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+
+	/* get pointer to raw data structure */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+
+	/* get data kind */
+	*kind = store->kind;
+
+	/* extract ctd data from bluefin environmental SSV record */
+	if (*kind == MB_DATA_SSV) {
+		bluefin = &(store->bluefin);
+		header = &(bluefin->header);
+
+		*nctd = 0;
+		for (i = 0; i < bluefin->number_frames; i++) {
+			environmental = &(bluefin->environmental[i]);
+			if (environmental->ctd_time > 0.0 && *nctd < MB_CTD_MAX) {
+				/* get time_d if needed */
+				if (environmental->ctd_time < 10000.0) {
+					time_j[0] = environmental->s7kTime.Year;
+					time_j[1] = environmental->s7kTime.Day;
+					time_j[2] = 60 * environmental->s7kTime.Hours + environmental->s7kTime.Minutes;
+					time_j[3] = (int)environmental->s7kTime.Seconds;
+					time_j[4] = (int)(1000000 * (environmental->s7kTime.Seconds - time_j[3]));
+					mb_get_itime(verbose, time_j, time_i);
+					mb_get_time(verbose, time_i, &environmental->ctd_time);
+				}
+
+				/* get values */
+				time_d[*nctd] = environmental->ctd_time;
+				conductivity[*nctd] = environmental->conductivity;
+				temperature[*nctd] = environmental->temperature;
+				depth[*nctd] = environmental->pressure;
+				salinity[*nctd] = environmental->salinity;
+				soundspeed[*nctd] = environmental->sound_speed;
+				(*nctd)++;
+			}
+		}
+	}
+
+	/* extract ctd data from CTD record */
+	else if (*kind == MB_DATA_CTD) {
+		ctd = &(store->ctd);
+		header = &(ctd->header);
+
+		/* get time */
+		time_j[0] = header->s7kTime.Year;
+		time_j[1] = header->s7kTime.Day;
+		time_j[2] = 60 * header->s7kTime.Hours + header->s7kTime.Minutes;
+		time_j[3] = (int)header->s7kTime.Seconds;
+		time_j[4] = (int)(1000000 * (header->s7kTime.Seconds - time_j[3]));
+		mb_get_itime(verbose, time_j, time_i);
+		mb_get_time(verbose, time_i, &time_d[0]);
+
+		*nctd = MIN(ctd->n, MB_CTD_MAX);
+		for (i = 0; i < *nctd; i++) {
+			time_d[i] = time_d[0];
+			if (ctd->sample_rate > 0.0)
+				time_d[i] += i * (1.0 / ctd->sample_rate);
+			if (ctd->conductivity_flag == 0)
+				conductivity[i] = ctd->conductivity_salinity[i];
+			else
+				salinity[i] = ctd->conductivity_salinity[i];
+			temperature[i] = ctd->temperature[i];
+			depth[i] = ctd->pressure_depth[i];
+			soundspeed[i] = ctd->sound_velocity[i];
+		}
+	}
+
+	/* else failure */
+	else {
+		*nctd = 0;
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       kind:       %d\n", *kind);
+	}
+	if (verbose >= 2 && *error == MB_ERROR_NO_ERROR) {
+		fprintf(stderr, "dbg2       nctd:          %d\n", *nctd);
+		for (i = 0; i < *nctd; i++) {
+			fprintf(stderr, "dbg2       time_d:        %f\n", time_d[i]);
+			fprintf(stderr, "dbg2       conductivity:  %f\n", conductivity[i]);
+			fprintf(stderr, "dbg2       temperature:   %f\n", temperature[i]);
+			fprintf(stderr, "dbg2       depth:         %f\n", depth[i]);
+			fprintf(stderr, "dbg2       salinity:      %f\n", salinity[i]);
+			fprintf(stderr, "dbg2       soundspeed:    %f\n", soundspeed[i]);
+		}
+	}
+	if (verbose >= 2) {
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_ancilliarysensor(int verbose, void *mbio_ptr, void *store_ptr, int *kind, int *nsamples, double *time_d,
+                                   double *sensor1, double *sensor2, double *sensor3, double *sensor4, double *sensor5,
+                                   double *sensor6, double *sensor7, double *sensor8, int *error) {
+	char *function_name = "mbsys_reson7k_ancilliarysensor";
+	struct mb_io_struct *mb_io_ptr;
+	struct mbsys_reson7k_struct *store;
+	s7k_header *header;
+	s7kr_bluefin *bluefin;
+	s7k_bluefin_environmental *environmental;
+	int status = MB_SUCCESS;
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mb_ptr:     %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+	}
+
+	/* get mbio descriptor */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+
+	/* get pointer to raw data structure */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+
+	/* get data kind */
+	*kind = store->kind;
+
+	/* extract ctd data from bluefin environmental SSV record */
+	if (*kind == MB_DATA_SSV) {
+		bluefin = &(store->bluefin);
+		header = &(bluefin->header);
+
+		*nsamples = 0;
+		for (i = 0; i < bluefin->number_frames; i++) {
+			environmental = &(bluefin->environmental[i]);
+			time_d[*nsamples] = environmental->sensor_time_sec + 0.000000001 * environmental->sensor_time_nsec;
+			sensor1[*nsamples] = -5.0 + ((double)environmental->sensor1) / 6553.6;
+			sensor2[*nsamples] = -5.0 + ((double)environmental->sensor2) / 6553.6;
+			sensor3[*nsamples] = -5.0 + ((double)environmental->sensor3) / 6553.6;
+			sensor4[*nsamples] = -5.0 + ((double)environmental->sensor4) / 6553.6;
+			sensor5[*nsamples] = -5.0 + ((double)environmental->sensor5) / 6553.6;
+			sensor6[*nsamples] = -5.0 + ((double)environmental->sensor6) / 6553.6;
+			sensor7[*nsamples] = -5.0 + ((double)environmental->sensor7) / 6553.6;
+			sensor8[*nsamples] = -5.0 + ((double)environmental->sensor8) / 6553.6;
+			(*nsamples)++;
+		}
+	}
+
+	/* else failure */
+	else {
+		*nsamples = 0;
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       kind:       %d\n", *kind);
+	}
+	if (verbose >= 2 && *error == MB_ERROR_NO_ERROR) {
+		fprintf(stderr, "dbg2       nsamples:   %d\n", *nsamples);
+		for (i = 0; i < *nsamples; i++) {
+			fprintf(stderr, "dbg2       time_d:        %f\n", time_d[i]);
+			fprintf(stderr, "dbg2       sensor1:       %f\n", sensor1[i]);
+			fprintf(stderr, "dbg2       sensor2:       %f\n", sensor2[i]);
+			fprintf(stderr, "dbg2       sensor3:       %f\n", sensor3[i]);
+			fprintf(stderr, "dbg2       sensor4:       %f\n", sensor4[i]);
+			fprintf(stderr, "dbg2       sensor5:       %f\n", sensor5[i]);
+			fprintf(stderr, "dbg2       sensor6:       %f\n", sensor6[i]);
+			fprintf(stderr, "dbg2       sensor7:       %f\n", sensor7[i]);
+			fprintf(stderr, "dbg2       sensor8:       %f\n", sensor8[i]);
+		}
+	}
+	if (verbose >= 2) {
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_copy(int verbose, void *mbio_ptr, void *store_ptr, void *copy_ptr, int *error) {
+	char *function_name = "mbsys_reson7k_copy";
+	int status = MB_SUCCESS;
+	struct mb_io_struct *mb_io_ptr;
+	struct mbsys_reson7k_struct *store;
+	struct mbsys_reson7k_struct *copy;
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       copy_ptr:   %p\n", (void *)copy_ptr);
+	}
+
+	/* get mbio descriptor */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+
+	/* get data structure pointers */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+	copy = (struct mbsys_reson7k_struct *)copy_ptr;
+
+	/* copy over structures - the variable length arrays of the larger
+	    payloads are shared with the copy rather than duplicated, and are
+	    only duplicated when either store is modified */
+
+	/* Type of data record */
+	copy->kind = store->kind; /* MB-System record ID */
+	copy->type = store->type; /* Reson record ID */
+
+	/* MB-System time stamp */
+	copy->time_d = store->time_d;
+	for (i = 0; i < 7; i++)
+		copy->time_i[i] = store->time_i[i];
+
+	/* Reference point information (record 1000) */
+	/*  Note: these offsets should be zero for submersible vehicles */
+	copy->reference = store->reference;
+
+	/* Sensor uncalibrated offset position information (record 1001) */
+	copy->sensoruncal = store->sensoruncal;
+
+	/* Sensor calibrated offset position information (record 1002) */
+	copy->sensorcal = store->sensorcal;
+
+	/* Position (record 1003) */
+	copy->position = store->position;
+
+	/* Attitude (record 1004) */
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_share_payload(verbose, store_ptr, copy_ptr, R7KSHARE_Attitude, error);
+
+	/* Tide (record 1005) */
+	copy->tide = store->tide;
+
+	/* Altitude (record 1006) */
+	copy->altitude = store->altitude;
+
+	/* Motion over ground (record 1007) */
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_share_payload(verbose, store_ptr, copy_ptr, R7KSHARE_Motion, error);
+
+	/* Depth (record 1008) */
+	copy->depth = store->depth;
+
+	/* Sound velocity profile (record 1009) */
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_share_payload(verbose, store_ptr, copy_ptr, R7KSHARE_Svp, error);
+
+	/* CTD (record 1010) */
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_share_payload(verbose, store_ptr, copy_ptr, R7KSHARE_Ctd, error);
+
+	/* Geodesy (record 1011) */
+	copy->geodesy = store->geodesy;
+
+	/* Edgetech FS-DW low frequency sidescan (record 3000) */
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_share_payload(verbose, store_ptr, copy_ptr, R7KSHARE_FsdwssLo, error);
+
+	/* Edgetech FS-DW high frequency sidescan (record 3000) */
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_share_payload(verbose, store_ptr, copy_ptr, R7KSHARE_FsdwssHi, error);
+
+	/* Edgetech FS-DW subbottom (record 3001) */
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_share_payload(verbose, store_ptr, copy_ptr, R7KSHARE_Fsdwsb, error);
+
+	/* Bluefin Environmental Data Frame (can be included in record 3100) */
+	copy->bluefin = store->bluefin;
+
+	/* Reson 7k volatile sonar settings (record 7000) */
+	copy->volatilesettings = store->volatilesettings;
+
+	/* Reson 7k configuration (record 7001) */
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_share_payload(verbose, store_ptr, copy_ptr, R7KSHARE_Configuration, error);
+
+	/* Reson 7k beam geometry (record 7004) */
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_share_payload(verbose, store_ptr, copy_ptr, R7KSHARE_BeamGeometry, error);
+
+	/* Reson 7k calibration (record 7005) */
+	copy->calibration = store->calibration;
+
+	/* Reson 7k bathymetry (record 7006) */
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_share_payload(verbose, store_ptr, copy_ptr, R7KSHARE_Bathymetry, error);
+
+	/* Reson 7k backscatter imagery data (record 7007) */
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_share_payload(verbose, store_ptr, copy_ptr, R7KSHARE_Backscatter, error);
+
+	/* Reson 7k beam data (record 7008) */
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_share_payload(verbose, store_ptr, copy_ptr, R7KSHARE_Beam, error);
+
+	/* Reson 7k vertical depth (record 7009) */
+	copy->verticaldepth = store->verticaldepth;
+
+	/* Reson 7k tvg data (record 7010) */
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_share_payload(verbose, store_ptr, copy_ptr, R7KSHARE_Tvg, error);
+
+	/* Reson 7k image data (record 7011) */
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_share_payload(verbose, store_ptr, copy_ptr, R7KSHARE_Image, error);
+
+	/* Reson 7k system event (record 7051) */
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_share_payload(verbose, store_ptr, copy_ptr, R7KSHARE_SystemEventMessage, error);
+
+	/* Reson 7k file header (record 7200) */
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_share_payload(verbose, store_ptr, copy_ptr, R7KSHARE_FileHeader, error);
+
+	/* raw record pass-through */
+	for (i = 0; i < R7KRAW_NUM; i++) {
+		if (status == MB_SUCCESS)
+			status = mbsys_reson7k_share_payload(verbose, store_ptr, copy_ptr, R7KSHARE_RawRecord + i, error);
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_makess_grid(int verbose, void *mbio_ptr, void *store_ptr, int source, int hires, int pixel_size_set,
+                              double *pixel_size, int swath_width_set, double *swath_width, int pixel_int, s7k_sidescangrid *grid,
+                              int *error) {
+	char *function_name = "mbsys_reson7k_makess_grid";
+	int status = MB_SUCCESS;
+	struct mb_io_struct *mb_io_ptr;
+	struct mbsys_reson7k_struct *store;
+	s7kr_volatilesettings *volatilesettings;
+	s7kr_beamgeometry *beamgeometry;
+	s7kr_bathymetry *bathymetry;
+	s7kr_backscatter *backscatter;
+	s7kr_beam *beam;
+	s7kr_v2snippet *v2snippet;
+	s7kr_calibratedsnippet *calibratedsnippet;
+	s7kr_compressedwatercolumn *compressedwatercolumn;
+	s7kr_bluefin *bluefin;
+	s7kr_soundvelocity *soundvelocity;
+	int nss;
+	int *ss_cnt;
+	double *ss;
+	double *ssacrosstrack;
+	double *ssalongtrack;
+	int gridded;
+	int nbathsort;
+	double *bathsort;
+	double bathmedian;
+	char *beamflag;
+	double pixel_size_calc;
+	double ss_spacing;
+	double soundspeed;
+	int iminxtrack;
+	double minxtrack;
+	double maxxtrack;
+	int nrangetable;
+	double *rangetable;
+	double *acrosstracktable, acrosstracktablemin;
+	double *alongtracktable;
+	s7k_makessscratch *scratch;
+	struct mbsys_reson7k_struct *ostore;
+	struct mbsys_reson7k_makesswork_struct work[MBSYS_RESON7K_MAKESS_THREADS_MAX];
+#ifdef MBSYS_RESON7K_PTHREADS
+	pthread_t threads[MBSYS_RESON7K_MAKESS_THREADS_MAX];
+	int nstarted;
+#endif
+	int nthreads, nsnippet, nlist;
+	u32 begin_sample, end_sample;
+	u32 hash;
+	unsigned char *bytes;
+	double *footcos, *footsint;
+	double angle;
+	int nalloc;
+	int irangenadir, irange;
+	int found;
+	int pixel_int_use;
+	int sample_start, sample_end;
+	double range, xtrackss, ltrackss, factor, beamwidth;
+	mb_u_char *data_uchar;
+	unsigned short *data_ushort;
+	unsigned int *data_uint;
+	int first, last, k1, k2;
+	int i, j, k, kk, l, m;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:         %d\n", verbose);
+		fprintf(stderr, "dbg2       mbio_ptr:        %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       store_ptr:       %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       source:          %d\n", source);
+		fprintf(stderr, "dbg2       hires:           %d\n", hires);
+		fprintf(stderr, "dbg2       pixel_size_set:  %d\n", pixel_size_set);
+		fprintf(stderr, "dbg2       pixel_size:      %f\n", *pixel_size);
+		fprintf(stderr, "dbg2       swath_width_set: %d\n", swath_width_set);
+		fprintf(stderr, "dbg2       swath_width:     %f\n", *swath_width);
+		fprintf(stderr, "dbg2       pixel_int:       %d\n", pixel_int);
+		fprintf(stderr, "dbg2       grid:            %p\n", (void *)grid);
+	}
+
+	/* get mbio descriptor */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+
+	/* get data structure pointer */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+	volatilesettings = (s7kr_volatilesettings *)&store->volatilesettings;
+	beamgeometry = (s7kr_beamgeometry *)&store->beamgeometry;
+	bathymetry = (s7kr_bathymetry *)&store->bathymetry;
+	backscatter = (s7kr_backscatter *)&store->backscatter;
+	v2snippet = (s7kr_v2snippet *)&store->v2snippet;
+	calibratedsnippet = (s7kr_calibratedsnippet *)&store->calibratedsnippet;
+	compressedwatercolumn = (s7kr_compressedwatercolumn *)&store->compressedwatercolumn;
+	beam = (s7kr_beam *)&store->beam;
+	bluefin = (s7kr_bluefin *)&store->bluefin;
+	soundvelocity = (s7kr_soundvelocity *)&store->soundvelocity;
+
+	/* get the scratch arrays held by the internal store of this mbio
+	    handle, growing them if this ping has more beams than any before */
+	ostore = (struct mbsys_reson7k_struct *)mb_io_ptr->store_data;
+	scratch = &(ostore->makessscratch);
+	if (scratch->nalloc < bathymetry->number_beams || scratch->nalloc < MBSYS_RESON7K_MAX_BEAMS) {
+		nalloc = MAX(bathymetry->number_beams, MBSYS_RESON7K_MAX_BEAMS);
+		status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(double), (void **)&(scratch->bathsort), error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(char), (void **)&(scratch->beamflag), error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(double), (void **)&(scratch->rangetable), error);
+		if (status == MB_SUCCESS)
+			status =
+			    mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(double), (void **)&(scratch->acrosstracktable), error);
+		if (status == MB_SUCCESS)
+			status =
+			    mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(double), (void **)&(scratch->alongtracktable), error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(double), (void **)&(scratch->footcos), error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(double), (void **)&(scratch->footsint), error);
+		if (status == MB_SUCCESS)
+			scratch->nalloc = nalloc;
+		else
+			scratch->nalloc = 0;
+		scratch->footvalid = MB_NO;
+	}
+	bathsort = scratch->bathsort;
+	beamflag = scratch->beamflag;
+	rangetable = scratch->rangetable;
+	acrosstracktable = scratch->acrosstracktable;
+	alongtracktable = scratch->alongtracktable;
+	grid->npixels = 0;
+	grid->source = R7KRECID_None;
+	gridded = MB_NO;
+
+	/* if necessary pick a source for the backscatter */
+	if (store->kind == MB_DATA_DATA && source == R7KRECID_None) {
+		if (store->read_mask & R7KREAD_CalibratedSnippet)
+			source = R7KRECID_7kCalibratedSnippetData;
+		else if (store->read_mask & R7KREAD_V2Snippet)
+			source = R7KRECID_7kV2SnippetData;
+		else if (store->read_mask & R7KREAD_Beam)
+			source = R7KRECID_7kBeamData;
+		else if (store->read_mask & R7KREAD_CompressedWaterColumn)
+			source = R7KRECID_7kCompressedWaterColumn;
+		else if (store->read_mask & R7KREAD_Backscatter)
+			source = R7KRECID_7kBackscatterImageData;
+	}
+
+	/* calculate sidescan from the desired source data if it is available */
+	if (status == MB_SUCCESS && store->kind == MB_DATA_DATA &&
+	    ((source == R7KRECID_7kV2SnippetData && (store->read_mask & R7KREAD_V2Snippet)) ||
+	     (source == R7KRECID_7kCalibratedSnippetData && (store->read_mask & R7KREAD_CalibratedSnippet)) ||
+	     (source == R7KRECID_7kBeamData && (store->read_mask & R7KREAD_Beam)) ||
+	     (source == R7KRECID_7kCompressedWaterColumn && (store->read_mask & R7KREAD_CompressedWaterColumn)) ||
+	     (source == R7KRECID_7kBackscatterImageData && (store->read_mask & R7KREAD_Backscatter)))) {
+		/* get beamflags - only use snippets from good beams */
+		for (i = 0; i < bathymetry->number_beams; i++) {
+			/* beamflagging scheme:
+			    Reson quality flags use bits 0-3
+			        bit 0: brightness test
+			        bit 1: colinearity test
+			        bit 2: amplitude pick
+			        bit 3: phase pick
+			    Early MB scheme (through 2007) - use bits 0-5
+			        null: 0
+			        flagged: 2
+			        good: 15
+			        amplitude: +16
+			        phase: +32
+			    Current MB scheme (>= 2008) - use bits 4-7
+			        - bits 0-3 left in original values
+			        - beam valid if bit 4 or 5 are set
+			        - beam flagged if bit 6 or 7 set
+			        bit 4: on = amplitude
+			        bit 5: on = phase
+			        bit 6: on = auto flag
+			        bit 7: on = manual flag */
+			if (bathymetry->quality[i] == 0) {
+				beamflag[i] = MB_FLAG_NULL;
+			}
+			else if (bathymetry->quality[i] & 64) {
+				beamflag[i] = MB_FLAG_FLAG + MB_FLAG_FILTER;
+			}
+			else if (bathymetry->quality[i] & 128) {
+				beamflag[i] = MB_FLAG_FLAG + MB_FLAG_MANUAL;
+			}
+			else if (bathymetry->quality[i] & 240) {
+				beamflag[i] = MB_FLAG_NONE;
+			}
+			else if ((bathymetry->quality[i] & 3) == 3) {
+				beamflag[i] = MB_FLAG_NONE;
+			}
+			else if ((bathymetry->quality[i] & 15) == 0) {
+				beamflag[i] = MB_FLAG_NULL;
+			}
+			else if ((bathymetry->quality[i] & 3) == 0) {
+				beamflag[i] = MB_FLAG_FLAG + MB_FLAG_FILTER;
+			}
+			else {
+				beamflag[i] = MB_FLAG_FLAG + MB_FLAG_MANUAL;
+			}
+		}
+
+		/* get beam angle size */
+		beamwidth = 2.0 * RTD * volatilesettings->receive_width;
+
+		/* get the cosines and absolute sines of the beam angles used for
+		    the beam footprints - these are held in the scratch arrays and
+		    recalculated only when the beam angles change, as identified by
+		    a hash of the angles (FNV-1a); the footprints themselves depend
+		    on the ranges and so are calculated for each ping */
+		footcos = NULL;
+		footsint = NULL;
+		if (beamgeometry->number_beams >= bathymetry->number_beams) {
+			hash = 2166136261u;
+			bytes = (unsigned char *)beamgeometry->angle_acrosstrack;
+			for (i = 0; i < (int)(bathymetry->number_beams * sizeof(f32)); i++)
+				hash = (hash ^ bytes[i]) * 16777619u;
+			if (scratch->footvalid == MB_NO || scratch->foothash != hash || scratch->footnbeams != bathymetry->number_beams) {
+				for (i = 0; i < bathymetry->number_beams; i++) {
+					angle = RTD * beamgeometry->angle_acrosstrack[i];
+					scratch->footcos[i] = cos(DTR * angle);
+					scratch->footsint[i] = fabs(sin(DTR * angle));
+				}
+				scratch->footvalid = MB_YES;
+				scratch->foothash = hash;
+				scratch->footnbeams = bathymetry->number_beams;
+			}
+			footcos = scratch->footcos;
+			footsint = scratch->footsint;
+		}
+
+		/* get soundspeed */
+		if (volatilesettings->sound_velocity > 0.0)
+			soundspeed = volatilesettings->sound_velocity;
+		else if (soundvelocity->soundvelocity > 0.0)
+			soundspeed = soundvelocity->soundvelocity;
+		else if (bluefin->environmental[0].sound_speed > 0.0)
+			soundspeed = bluefin->environmental[0].sound_speed;
 		else
-			factor = (float)mb_segytraceheader_ptr->coord_scalar / 3600.0;
-		fsdwchannel->number_samples = mb_segytraceheader_ptr->nsamps;
-		fsdwchannel->sample_interval = mb_segytraceheader_ptr->si_micros;
-		time_j[0] = mb_segytraceheader_ptr->year;
-		time_j[1] = mb_segytraceheader_ptr->day_of_yr;
-		time_j[2] = 60 * mb_segytraceheader_ptr->hour + mb_segytraceheader_ptr->min;
-		time_j[3] = mb_segytraceheader_ptr->sec;
-		time_j[4] = 1000 * mb_segytraceheader_ptr->mils;
-		mb_get_itime(verbose, time_j, store->time_i);
-		mb_get_time(verbose, store->time_i, &(store->time_d));
-		header->s7kTime.Year = time_j[0];
-		header->s7kTime.Day = time_j[1];
-		header->s7kTime.Seconds = 0.000001 * store->time_i[6] + store->time_i[5];
-		header->s7kTime.Hours = store->time_i[3];
-		header->s7kTime.Minutes = store->time_i[4];
+			soundspeed = 1500.0;
+
+		/* get raw pixel size */
+		ss_spacing = 0.5 * soundspeed / volatilesettings->sample_rate;
+
+		/* 7042 samples may be downsampled, and the 8 bit dB samples are
+		    converted back to linear magnitudes by table */
+		if (source == R7KRECID_7kCompressedWaterColumn && compressedwatercolumn->sample_rate > 0.0)
+			ss_spacing = 0.5 * soundspeed / compressedwatercolumn->sample_rate;
+
+		/* get median depth relative to the sonar and check for min max xtrack */
+		nbathsort = 0;
+		minxtrack = 0.0;
+		maxxtrack = 0.0;
+		iminxtrack = bathymetry->number_beams / 2;
+		found = MB_NO;
+		for (i = 0; i < bathymetry->number_beams; i++) {
+			if (mb_beam_ok(beamflag[i])) {
+				bathsort[nbathsort] = bathymetry->depth[i] + bathymetry->vehicle_height;
+				nbathsort++;
+
+				if (found == MB_NO || fabs(bathymetry->acrosstrack[i]) < minxtrack) {
+					minxtrack = fabs(bathymetry->acrosstrack[i]);
+					iminxtrack = i;
+					found = MB_YES;
+				}
+
+				maxxtrack = MAX(fabs(bathymetry->acrosstrack[i]), maxxtrack);
+			}
+		}
+
+		/* set number of pixels and the pixel size - for the MB-System
+		    sidescan the number of pixels is fixed by the number of beams,
+		    while for high resolution sidescan it follows from the requested
+		    pixel size and acrosstrack swath width (m), defaulting to the raw
+		    sample spacing and the width of the bathymetry */
+		if (hires == MB_YES) {
+			if ((*pixel_size) <= 0.0)
+				(*pixel_size) = ss_spacing;
+			if ((*swath_width) <= 0.0)
+				(*swath_width) = 2.1 * maxxtrack;
+			nss = (int)ceil((*swath_width) / (*pixel_size));
+			if (nss > MBSYS_RESON7K_HIRES_MAX_PIXELS) {
+				nss = MBSYS_RESON7K_HIRES_MAX_PIXELS;
+				(*pixel_size) = (*swath_width) / nss;
+			}
+		}
+		else {
+			nss = MIN(4 * bathymetry->number_beams, MBSYS_RESON7K_MAX_PIXELS);
+
+			/* get sidescan pixel size */
+			if (swath_width_set == MB_NO && bathymetry->number_beams > 0) {
+				(*swath_width) = MAX(fabs(RTD * beamgeometry->angle_acrosstrack[0]),
+				                     fabs(RTD * beamgeometry->angle_acrosstrack[bathymetry->number_beams - 1]));
+			}
+			if (pixel_size_set == MB_NO && nbathsort > 0) {
+				/* calculate pixel size implied using swath width and nadir altitude -
+				    only the median depth is needed, so it is selected rather than
+				    sorting all the depths */
+				bathmedian = mbsys_reson7k_select(bathsort, nbathsort, nbathsort / 2);
+				pixel_size_calc = 2.1 * tan(DTR * (*swath_width)) * bathmedian / nss;
+
+				/* use pixel size based on actual swath width if that is larger than the first value */
+				pixel_size_calc = MAX(pixel_size_calc, 2.1 * maxxtrack / nss);
+
+				/* make sure the pixel size is at least equivalent to a 0.1 degree nadir beamwidth */
+				pixel_size_calc = MAX(pixel_size_calc, bathmedian * sin(DTR * 0.1));
+
+				/* if the pixel size appears to be changing in size, moderate the change */
+				if ((*pixel_size) <= 0.0)
+					(*pixel_size) = pixel_size_calc;
+				else if (0.95 * (*pixel_size) > pixel_size_calc)
+					(*pixel_size) = 0.95 * (*pixel_size);
+				else if (1.05 * (*pixel_size) < pixel_size_calc)
+					(*pixel_size) = 1.05 * (*pixel_size);
+				else
+					(*pixel_size) = pixel_size_calc;
+			}
+		}
+
+		/* get the pixel arrays of the grid, growing them if needed */
+		nss = MAX(nss, 0);
+		if (grid->nalloc < nss) {
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nss * sizeof(double), (void **)&(grid->ss), error);
+			if (status == MB_SUCCESS)
+				status = mb_reallocd(verbose, __FILE__, __LINE__, nss * sizeof(double), (void **)&(grid->ssacrosstrack), error);
+			if (status == MB_SUCCESS)
+				status = mb_reallocd(verbose, __FILE__, __LINE__, nss * sizeof(double), (void **)&(grid->ssalongtrack), error);
+			if (status == MB_SUCCESS)
+				status = mb_reallocd(verbose, __FILE__, __LINE__, nss * sizeof(int), (void **)&(grid->ss_cnt), error);
+			if (status == MB_SUCCESS)
+				grid->nalloc = nss;
+			else
+				grid->nalloc = 0;
+		}
+		if (status == MB_SUCCESS)
+			gridded = MB_YES;
+	}
+
+	/* bin the source data into the pixels of the grid */
+	if (gridded == MB_YES) {
+		ss = grid->ss;
+		ssacrosstrack = grid->ssacrosstrack;
+		ssalongtrack = grid->ssalongtrack;
+		ss_cnt = grid->ss_cnt;
+
+		/* get pixel interpolation */
+		pixel_int_use = pixel_int + 1;
+
+		/* zero the sidescan - only the nss pixels in use */
+		for (i = 0; i < nss; i++) {
+			ss[i] = 0.0;
+			ssacrosstrack[i] = (*pixel_size) * (double)(i - (nss / 2));
+			ssalongtrack[i] = 0.0;
+			ss_cnt[i] = 0;
+		}
+
+		/* loop over raw backscatter or sidescan from the desired source,
+		 * 	putting each raw sample into the binning arrays */
+
+		/* snippets are used from calibrated snippet data (error_flag = 0
+		   is calibrated, error_flag = 1 is uncalibrated snippet data and
+		   error_flag > 1 indicates a problem), v2 snippet data, old
+		   snippet data, or windows about the bottom detections cut from
+		   compressed water column data */
+		nsnippet = -1;
+		if (source == R7KRECID_7kCalibratedSnippetData && calibratedsnippet->error_flag < 3)
+			nsnippet = calibratedsnippet->number_beams;
+		else if (source == R7KRECID_7kV2SnippetData && v2snippet->error_flag == MB_NO)
+			nsnippet = v2snippet->number_beams;
+		else if (source == R7KRECID_7kBeamData)
+			nsnippet = beam->number_beams;
+		else if (source == R7KRECID_7kCompressedWaterColumn && compressedwatercolumn->sample_rate > 0.0)
+			nsnippet = MIN(compressedwatercolumn->number_beams, compressedwatercolumn->nalloc);
+
+		/* bin the snippets in contiguous slices of beams - the first slice
+		    is summed directly into the sidescan, and each of the others into
+		    histograms of its own that are then added in, so the sums may
+		    differ from a single thread in the last bits; in the deterministic
+		    mode the other slices instead list their samples, and the lists
+		    are summed in beam order, giving exactly the single thread result */
+		if (nsnippet >= 0) {
+			nthreads = MAX(1, MIN(ostore->makess_threads, nsnippet / MBSYS_RESON7K_MAKESS_THREADS_BEAMS));
+#ifndef MBSYS_RESON7K_PTHREADS
+			nthreads = 1;
+#endif
+			for (l = 0; l < nthreads; l++) {
+				work[l].store = store;
+				work[l].source = source;
+				work[l].beamflag = beamflag;
+				work[l].soundspeed = soundspeed;
+				work[l].beamwidth = beamwidth;
+				work[l].footsin = sin(DTR * beamwidth);
+				work[l].footcos = footcos;
+				work[l].footsint = footsint;
+				work[l].ss_spacing = ss_spacing;
+				work[l].pixel_size = *pixel_size;
+				work[l].nss = nss;
+				work[l].istart = (l * nsnippet) / nthreads;
+				work[l].iend = ((l + 1) * nsnippet) / nthreads;
+				work[l].ss = ss;
+				work[l].ssalongtrack = ssalongtrack;
+				work[l].ss_cnt = ss_cnt;
+				work[l].nlistalloc = 0;
+				work[l].nlist = 0;
+				work[l].listpixel = NULL;
+				work[l].listamplitude = NULL;
+				work[l].listalongtrack = NULL;
+			}
+
+			/* get the histograms, or the lists sized by the snippet lengths,
+			    of the slices after the first - if these cannot be allocated
+			    a single thread is used */
+			if (nthreads > 1 && ostore->makess_deterministic == MB_YES) {
+				nlist = 0;
+				for (l = 1; l < nthreads; l++) {
+					for (i = work[l].istart; i < work[l].iend; i++) {
+						if (source == R7KRECID_7kCalibratedSnippetData) {
+							begin_sample = calibratedsnippet->calibratedsnippettimeseries[i].begin_sample;
+							end_sample = calibratedsnippet->calibratedsnippettimeseries[i].end_sample;
+						}
+						else if (source == R7KRECID_7kV2SnippetData) {
+							begin_sample = v2snippet->snippettimeseries[i].begin_sample;
+							end_sample = v2snippet->snippettimeseries[i].end_sample;
+						}
+						else if (source == R7KRECID_7kCompressedWaterColumn) {
+							begin_sample = 0;
+							end_sample = compressedwatercolumn->compressedwatercolumndata[i].samples;
+						}
+						else {
+							begin_sample = beam->snippets[i].begin_sample;
+							end_sample = beam->snippets[i].end_sample;
+						}
+						if (end_sample >= begin_sample)
+							work[l].nlistalloc += end_sample - begin_sample + 1;
+					}
+					nlist += work[l].nlistalloc;
+				}
+				if (scratch->nlistalloc < nlist) {
+					status = mb_reallocd(verbose, __FILE__, __LINE__, nlist * sizeof(int), (void **)&(scratch->listpixel), error);
+					if (status == MB_SUCCESS)
+						status = mb_reallocd(verbose, __FILE__, __LINE__, nlist * sizeof(double),
+						                     (void **)&(scratch->listamplitude), error);
+					if (status == MB_SUCCESS)
+						status = mb_reallocd(verbose, __FILE__, __LINE__, nlist * sizeof(double),
+						                     (void **)&(scratch->listalongtrack), error);
+					if (status == MB_SUCCESS)
+						scratch->nlistalloc = nlist;
+					else
+						scratch->nlistalloc = 0;
+				}
+				if (status == MB_SUCCESS) {
+					nlist = 0;
+					for (l = 1; l < nthreads; l++) {
+						work[l].listpixel = &(scratch->listpixel[nlist]);
+						work[l].listamplitude = &(scratch->listamplitude[nlist]);
+						work[l].listalongtrack = &(scratch->listalongtrack[nlist]);
+						nlist += work[l].nlistalloc;
+					}
+				}
+			}
+			else if (nthreads > 1) {
+				if (scratch->nthreadalloc < (nthreads - 1) * nss) {
+					nalloc = (nthreads - 1) * nss;
+					status =
+					    mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(double), (void **)&(scratch->threadss), error);
+					if (status == MB_SUCCESS)
+						status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(double),
+						                     (void **)&(scratch->threadssalongtrack), error);
+					if (status == MB_SUCCESS)
+						status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(int), (void **)&(scratch->threadsscnt),
+						                     error);
+					if (status == MB_SUCCESS)
+						scratch->nthreadalloc = nalloc;
+					else
+						scratch->nthreadalloc = 0;
+				}
+				if (status == MB_SUCCESS) {
+					for (l = 1; l < nthreads; l++) {
+						work[l].ss = &(scratch->threadss[(l - 1) * nss]);
+						work[l].ssalongtrack = &(scratch->threadssalongtrack[(l - 1) * nss]);
+						work[l].ss_cnt = &(scratch->threadsscnt[(l - 1) * nss]);
+						for (k = 0; k < nss; k++) {
+							work[l].ss[k] = 0.0;
+							work[l].ssalongtrack[k] = 0.0;
+							work[l].ss_cnt[k] = 0;
+						}
+					}
+				}
+			}
+			if (status != MB_SUCCESS) {
+				nthreads = 1;
+				work[0].iend = nsnippet;
+				status = MB_SUCCESS;
+				*error = MB_ERROR_NO_ERROR;
+			}
+
+#ifdef MBSYS_RESON7K_PTHREADS
+			for (nstarted = 1; nstarted < nthreads; nstarted++) {
+				if (pthread_create(&threads[nstarted], NULL, mbsys_reson7k_makess_slice, (void *)&work[nstarted]) != 0)
+					break;
+			}
+			for (l = nstarted; l < nthreads; l++)
+				mbsys_reson7k_makess_slice((void *)&work[l]);
+			mbsys_reson7k_makess_slice((void *)&work[0]);
+			for (l = 1; l < nstarted; l++)
+				pthread_join(threads[l], NULL);
+#else
+			for (l = 0; l < nthreads; l++)
+				mbsys_reson7k_makess_slice((void *)&work[l]);
+#endif
+
+			/* add the other slices into the sidescan in beam order */
+			for (l = 1; l < nthreads; l++) {
+				if (work[l].listpixel != NULL) {
+					for (m = 0; m < work[l].nlist; m++) {
+						kk = work[l].listpixel[m];
+						ss[kk] += work[l].listamplitude[m];
+						ssalongtrack[kk] += work[l].listalongtrack[m];
+						ss_cnt[kk]++;
+					}
+				}
+				else {
+					for (k = 0; k < nss; k++) {
+						ss[k] += work[l].ss[k];
+						ssalongtrack[k] += work[l].ssalongtrack[k];
+						ss_cnt[k] += work[l].ss_cnt[k];
+					}
+				}
+			}
+		}
+
+		/* use backscatter record - basically a pseudosidescan */
+		else if (source == R7KRECID_7kBackscatterImageData) {
+			/* get acrosstrack distance versus range table from bathymetry */
+			nrangetable = 0;
+			irangenadir = 0;
+			for (i = 0; i < bathymetry->number_beams; i++) {
+				if (mb_beam_ok(beamflag[i])) {
+					rangetable[nrangetable] = bathymetry->range[i];
+					acrosstracktable[nrangetable] = bathymetry->acrosstrack[i];
+					alongtracktable[nrangetable] = bathymetry->alongtrack[i];
+					if (nrangetable == 0 || fabs(acrosstracktable[nrangetable]) < acrosstracktablemin) {
+						irangenadir = nrangetable;
+						acrosstracktablemin = fabs(acrosstracktable[nrangetable]);
+					}
+					nrangetable++;
+				}
+			}
+
+			/* lay out port side */
+			data_uchar = (mb_u_char *)backscatter->port_data;
+			data_ushort = (unsigned short *)backscatter->port_data;
+			data_uint = (unsigned int *)backscatter->port_data;
+			sample_start = rangetable[irangenadir] * volatilesettings->sample_rate;
+			sample_end = MIN(rangetable[0] * volatilesettings->sample_rate, backscatter->number_samples - 1);
+			irange = irangenadir;
+			for (i = sample_start; i < sample_end; i++) {
+				range = ((double)i) / ((double)volatilesettings->sample_rate);
+				found = MB_NO;
+				for (j = irange; j > 0 && found == MB_NO; j--) {
+					if (range >= rangetable[j] && range < rangetable[j - 1]) {
+						irange = j;
+						found = MB_YES;
+					}
+				}
+				factor = (range - rangetable[irange]) / (rangetable[irange - 1] - rangetable[irange]);
+				xtrackss = acrosstracktable[irange] + factor * (acrosstracktable[irange - 1] - acrosstracktable[irange]);
+				ltrackss = alongtracktable[irange] + factor * (alongtracktable[irange - 1] - alongtracktable[irange]);
+				kk = nss / 2 + (int)(xtrackss / (*pixel_size));
+				if (kk >= 0 && kk < nss) {
+					if (backscatter->sample_size == 1)
+						ss[kk] += (double)data_uchar[i];
+					else if (backscatter->sample_size == 2)
+						ss[kk] += (double)data_ushort[i];
+					else
+						ss[kk] += (double)data_uint[i];
+					ssalongtrack[kk] += ltrackss;
+					ss_cnt[kk]++;
+				}
+			}
+
+			/* lay out starboard side */
+			data_uchar = (mb_u_char *)backscatter->stbd_data;
+			data_ushort = (unsigned short *)backscatter->stbd_data;
+			data_uint = (unsigned int *)backscatter->stbd_data;
+			sample_start = rangetable[irangenadir] * volatilesettings->sample_rate;
+			sample_end = MIN(rangetable[nrangetable - 1] * volatilesettings->sample_rate, backscatter->number_samples - 1);
+			irange = irangenadir;
+			for (i = sample_start; i < sample_end; i++) {
+				range = ((double)i) / ((double)volatilesettings->sample_rate);
+				found = MB_NO;
+				for (j = irange; j < nrangetable - 1 && found == MB_NO; j++) {
+					if (range >= rangetable[j] && range < rangetable[j + 1]) {
+						irange = j;
+						found = MB_YES;
+					}
+				}
+				factor = (range - rangetable[irange]) / (rangetable[irange + 1] - rangetable[irange]);
+				xtrackss = acrosstracktable[irange] + factor * (acrosstracktable[irange + 1] - acrosstracktable[irange]);
+				ltrackss = alongtracktable[irange] + factor * (alongtracktable[irange + 1] - alongtracktable[irange]);
+				kk = nss / 2 + (int)(xtrackss / (*pixel_size));
+				if (kk >= 0 && kk < nss) {
+					if (backscatter->sample_size == 1)
+						ss[kk] += (double)data_uchar[i];
+					else if (backscatter->sample_size == 2)
+						ss[kk] += (double)data_ushort[i];
+					else
+						ss[kk] += (double)data_uint[i];
+					ssalongtrack[kk] += ltrackss;
+					ss_cnt[kk]++;
+				}
+			}
+		}
+
+		/* average the sidescan */
+		first = nss;
+		last = -1;
+		for (k = 0; k < nss; k++) {
+			if (ss_cnt[k] > 0) {
+				ss[k] /= ss_cnt[k];
+				ssalongtrack[k] /= ss_cnt[k];
+				first = MIN(first, k);
+				last = k;
+			}
+			else
+				ss[k] = MB_SIDESCAN_NULL;
+		}
+
+		/* interpolate the sidescan - each gap between pixels k1 and k2 no
+		    wider than pixel_int_use is filled in one pass, with the same
+		    arithmetic as a pixel by pixel search for k2 */
+		k1 = first;
+		for (k2 = first + 1; k2 <= last; k2++) {
+			if (ss_cnt[k2] > 0) {
+				if (k2 - k1 > 1 && k2 - k1 <= pixel_int_use) {
+					for (k = k1 + 1; k < k2; k++) {
+						ss[k] = ss[k1] + (ss[k2] - ss[k1]) * ((double)(k - k1)) / ((double)(k2 - k1));
+						ssalongtrack[k] =
+						    ssalongtrack[k1] + (ssalongtrack[k2] - ssalongtrack[k1]) * ((double)(k - k1)) / ((double)(k2 - k1));
+					}
+				}
+				k1 = k2;
+			}
+		}
+
+		/* return the sidescan in the grid */
+		grid->npixels = nss;
+		grid->pixel_size = *pixel_size;
+		grid->source = source;
+		grid->inadir = iminxtrack;
+
+		/* print debug statements */
+		if (verbose >= 2) {
+			fprintf(stderr, "\ndbg2  Sidescan regenerated in <%s>\n", function_name);
+			fprintf(stderr, "dbg2       pixels_ss:  %d\n", nss);
+			for (i = 0; i < nss; i++)
+				fprintf(stderr, "dbg2       pixel:%4d  cnt:%3d  ss:%10f  xtrack:%10f  ltrack:%10f\n", i, ss_cnt[i], ss[i],
+				        ssacrosstrack[i], ssalongtrack[i]);
+		}
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return value:\n");
+		fprintf(stderr, "dbg2       pixel_size:      %f\n", *pixel_size);
+		fprintf(stderr, "dbg2       swath_width:     %f\n", *swath_width);
+		fprintf(stderr, "dbg2       error:           %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:          %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_makess(int verbose, void *mbio_ptr, void *store_ptr, int source, int pixel_size_set, double *pixel_size,
+                         int swath_width_set, double *swath_width, int pixel_int, int *error) {
+	char *function_name = "mbsys_reson7k_makess";
+	int status = MB_SUCCESS;
+	struct mb_io_struct *mb_io_ptr;
+	struct mbsys_reson7k_struct *store;
+	struct mbsys_reson7k_struct *ostore;
+	s7kr_reference *reference;
+	s7kr_bathymetry *bathymetry;
+	s7kr_processedsidescan *processedsidescan;
+	s7k_sidescangrid *grid;
+	int nss;
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:         %d\n", verbose);
+		fprintf(stderr, "dbg2       mbio_ptr:        %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       store_ptr:       %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       source:          %d\n", source);
+		fprintf(stderr, "dbg2       pixel_size_set:  %d\n", pixel_size_set);
+		fprintf(stderr, "dbg2       pixel_size:      %f\n", *pixel_size);
+		fprintf(stderr, "dbg2       swath_width_set: %d\n", swath_width_set);
+		fprintf(stderr, "dbg2       swath_width:     %f\n", *swath_width);
+		fprintf(stderr, "dbg2       pixel_int:       %d\n", pixel_int);
+	}
+
+	/* get mbio descriptor */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+
+	/* get data structure pointers */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+	ostore = (struct mbsys_reson7k_struct *)mb_io_ptr->store_data;
+	reference = (s7kr_reference *)&store->reference;
+	bathymetry = (s7kr_bathymetry *)&store->bathymetry;
+	processedsidescan = (s7kr_processedsidescan *)&store->processedsidescan;
+
+	/* make the sidescan in the grid of the internal store, with the number
+	    of pixels limited to the MB-System sidescan */
+	grid = &(ostore->makessscratch.grid);
+	status = mbsys_reson7k_makess_grid(verbose, mbio_ptr, store_ptr, source, MB_NO, pixel_size_set, pixel_size, swath_width_set,
+	                                   swath_width, pixel_int, grid, error);
+
+	if (status == MB_SUCCESS && grid->source != R7KRECID_None) {
+		nss = grid->npixels;
+
+		/* embed the sidescan into the processed sidescan record - pixels
+		    beyond nss that were in use for the previous ping are zeroed */
+		for (i = nss; i < MIN(processedsidescan->number_pixels, MBSYS_RESON7K_MAX_PIXELS); i++) {
+			processedsidescan->sidescan[i] = 0.0;
+			processedsidescan->alongtrack[i] = 0.0;
+		}
+		store->read_mask |= R7KREAD_ProcessedSidescan;
+		mbsys_reson7k_rawrecord_modified(verbose, store_ptr, R7KRECID_ProcessedSidescan, error);
+		processedsidescan->header = bathymetry->header;
+		processedsidescan->header.Offset = R7KRECID_ProcessedSidescan;
+		processedsidescan->header.Size =
+		    MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE + R7KHDRSIZE_ProcessedSidescan + nss * 8;
+		processedsidescan->header.OptionalDataOffset = 0;
+		processedsidescan->header.OptionalDataIdentifier = 0;
+		processedsidescan->header.RecordType = R7KRECID_ProcessedSidescan;
+		processedsidescan->serial_number = bathymetry->serial_number;
+		processedsidescan->ping_number = bathymetry->ping_number;
+		processedsidescan->multi_ping = bathymetry->multi_ping;
+		processedsidescan->recordversion = 1;
+		processedsidescan->ss_source = grid->source;
+		processedsidescan->number_pixels = nss;
+		processedsidescan->ss_type = MB_SIDESCAN_LINEAR;
+		processedsidescan->pixelwidth = *pixel_size;
+		processedsidescan->sonardepth = -bathymetry->vehicle_height + reference->water_z;
+		processedsidescan->altitude = bathymetry->depth[grid->inadir] - processedsidescan->sonardepth;
+		for (i = 0; i < nss; i++) {
+			processedsidescan->sidescan[i] = grid->ss[i];
+			processedsidescan->alongtrack[i] = grid->ssalongtrack[i];
+		}
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return value:\n");
+		fprintf(stderr, "dbg2       pixel_size:      %f\n", *pixel_size);
+		fprintf(stderr, "dbg2       swath_width:     %f\n", *swath_width);
+		fprintf(stderr, "dbg2       error:           %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:          %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_makess_hires(int verbose, void *mbio_ptr, void *store_ptr, int source, double *pixel_size,
+                               double *swath_width, int pixel_int, int *npixels, double **ss, double **ssacrosstrack,
+                               double **ssalongtrack, int *error) {
+	char *function_name = "mbsys_reson7k_makess_hires";
+	int status = MB_SUCCESS;
+	struct mb_io_struct *mb_io_ptr;
+	struct mbsys_reson7k_struct *ostore;
+	s7k_sidescangrid *grid;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:         %d\n", verbose);
+		fprintf(stderr, "dbg2       mbio_ptr:        %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       store_ptr:       %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       source:          %d\n", source);
+		fprintf(stderr, "dbg2       pixel_size:      %f\n", *pixel_size);
+		fprintf(stderr, "dbg2       swath_width:     %f\n", *swath_width);
+		fprintf(stderr, "dbg2       pixel_int:       %d\n", pixel_int);
+	}
+
+	/* get mbio descriptor */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+	ostore = (struct mbsys_reson7k_struct *)mb_io_ptr->store_data;
+
+	/* make the sidescan in the high resolution grid of the internal store -
+	    the arrays returned belong to this mbio handle and are valid until
+	    the next call */
+	grid = &(ostore->makessscratch.hiresgrid);
+	status = mbsys_reson7k_makess_grid(verbose, mbio_ptr, store_ptr, source, MB_YES, MB_YES, pixel_size, MB_YES, swath_width,
+	                                   pixel_int, grid, error);
+	if (status == MB_SUCCESS && grid->source != R7KRECID_None) {
+		*npixels = grid->npixels;
+		*ss = grid->ss;
+		*ssacrosstrack = grid->ssacrosstrack;
+		*ssalongtrack = grid->ssalongtrack;
+	}
+	else {
+		*npixels = 0;
+		*ss = NULL;
+		*ssacrosstrack = NULL;
+		*ssalongtrack = NULL;
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return value:\n");
+		fprintf(stderr, "dbg2       pixel_size:      %f\n", *pixel_size);
+		fprintf(stderr, "dbg2       swath_width:     %f\n", *swath_width);
+		fprintf(stderr, "dbg2       npixels:         %d\n", *npixels);
+		fprintf(stderr, "dbg2       ss:              %p\n", (void *)*ss);
+		fprintf(stderr, "dbg2       ssacrosstrack:   %p\n", (void *)*ssacrosstrack);
+		fprintf(stderr, "dbg2       ssalongtrack:    %p\n", (void *)*ssalongtrack);
+		fprintf(stderr, "dbg2       error:           %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:          %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_free_sidescangrid(int verbose, s7k_sidescangrid *grid, int *error) {
+	char *function_name = "mbsys_reson7k_free_sidescangrid";
+	int status = MB_SUCCESS;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       grid:       %p\n", (void *)grid);
+	}
+
+	/* deallocate the pixel arrays */
+	grid->nalloc = 0;
+	grid->npixels = 0;
+	if (grid->ss != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(grid->ss), error);
+	if (grid->ssacrosstrack != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(grid->ssacrosstrack), error);
+	if (grid->ssalongtrack != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(grid->ssalongtrack), error);
+	if (grid->ss_cnt != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(grid->ss_cnt), error);
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+void *mbsys_reson7k_makess_slice(void *work_ptr) {
+	struct mbsys_reson7k_makesswork_struct *work;
+	s7kr_volatilesettings *volatilesettings;
+	s7kr_beamgeometry *beamgeometry;
+	s7kr_bathymetry *bathymetry;
+	s7kr_snippet *snippet;
+	s7kr_beam *beam;
+	s7kr_v2snippettimeseries *snippettimeseries;
+	s7kr_calibratedsnippettimeseries *calibratedsnippettimeseries;
+	s7kr_compressedwatercolumn *compressedwatercolumn;
+	s7k_compressedwatercolumndata *compressedwatercolumndata;
+	u8 *sample;
+	int samplesize, offset;
+	int nsample_use, sample_start, sample_detect, sample_end;
+	double angle, xtrack, xtrackss, range, beam_foot, sint, ss_spacing_use;
+	double amplitude, alongtrack;
+	mb_u_char *data_uchar;
+	unsigned short *data_ushort;
+	unsigned int *data_uint;
+	int ibeam;
+	int i, k, kk;
+
+	work = (struct mbsys_reson7k_makesswork_struct *)work_ptr;
+	volatilesettings = &(work->store->volatilesettings);
+	beamgeometry = &(work->store->beamgeometry);
+	bathymetry = &(work->store->bathymetry);
+	beam = &(work->store->beam);
+	compressedwatercolumn = &(work->store->compressedwatercolumn);
+	calibratedsnippettimeseries = NULL;
+	snippettimeseries = NULL;
+	compressedwatercolumndata = NULL;
+	snippet = NULL;
+	data_uchar = NULL;
+	data_ushort = NULL;
+	data_uint = NULL;
+	work->nlist = 0;
+
+	/* 7042 samples are 8 bit dB, or 16 or 32 bit linear magnitudes, followed
+	    by phase unless stripped - sample k is at k + offset, counting the
+	    receive delay held in the first sample if present */
+	if (compressedwatercolumn->flags & R7KWC_32BIT)
+		samplesize = (compressedwatercolumn->flags & R7KWC_MAGNITUDEONLY) ? 4 : 5;
+	else if (compressedwatercolumn->flags & R7KWC_8BITDB)
+		samplesize = (compressedwatercolumn->flags & R7KWC_MAGNITUDEONLY) ? 1 : 2;
+	else
+		samplesize = (compressedwatercolumn->flags & R7KWC_MAGNITUDEONLY) ? 2 : 4;
+	offset = ((compressedwatercolumn->flags & R7KWC_RXDELAY) ? 1 : 0) - (int)compressedwatercolumn->first_sample;
+
+	for (i = work->istart; i < work->iend; i++) {
+		if (work->source == R7KRECID_7kCalibratedSnippetData) {
+			calibratedsnippettimeseries = &(work->store->calibratedsnippet.calibratedsnippettimeseries[i]);
+			ibeam = calibratedsnippettimeseries->beam_number;
+		}
+		else if (work->source == R7KRECID_7kV2SnippetData) {
+			snippettimeseries = &(work->store->v2snippet.snippettimeseries[i]);
+			ibeam = snippettimeseries->beam_number;
+		}
+		else if (work->source == R7KRECID_7kCompressedWaterColumn) {
+			compressedwatercolumndata = &(compressedwatercolumn->compressedwatercolumndata[i]);
+			ibeam = compressedwatercolumndata->beam_number;
+		}
+		else {
+			snippet = &(beam->snippets[i]);
+			ibeam = snippet->beam_number;
+		}
+
+		/* only use snippets from non-null and unflagged beams */
+		/* note: errors have been observed in data produced by a Reson
+		    simulator in which the detect_sample was
+		    was outside the range of begin_sample to end_sample
+		    - the current code effectively ignores this case because
+		    sample_end < sample_start, so no samples are processed. */
+		if (ibeam < bathymetry->number_beams && mb_beam_ok(work->beamflag[ibeam])) {
+			xtrack = bathymetry->acrosstrack[ibeam];
+			range = 0.5 * work->soundspeed * bathymetry->range[ibeam];
+			if (work->footcos != NULL) {
+				beam_foot = range * work->footsin / work->footcos[ibeam];
+				sint = work->footsint[ibeam];
+			}
+			else {
+				angle = RTD * beamgeometry->angle_acrosstrack[ibeam];
+				beam_foot = range * sin(DTR * work->beamwidth) / cos(DTR * angle);
+				sint = fabs(sin(DTR * angle));
+			}
+			nsample_use = beam_foot / work->ss_spacing;
+			if (sint < nsample_use * work->ss_spacing / beam_foot)
+				ss_spacing_use = beam_foot / nsample_use;
+			else
+				ss_spacing_use = work->ss_spacing / sint;
+			if (work->source == R7KRECID_7kCalibratedSnippetData) {
+				sample_detect = (int)calibratedsnippettimeseries->detect_sample;
+				sample_start = MAX((sample_detect - (nsample_use / 2)), (int)calibratedsnippettimeseries->begin_sample);
+				sample_end = MIN((sample_detect + (nsample_use / 2)), (int)calibratedsnippettimeseries->end_sample);
+				alongtrack = bathymetry->alongtrack[i];
+			}
+			else if (work->source == R7KRECID_7kV2SnippetData) {
+				sample_detect = (int)snippettimeseries->detect_sample;
+				sample_start = MAX((sample_detect - (nsample_use / 2)), (int)snippettimeseries->begin_sample);
+				sample_end = MIN((sample_detect + (nsample_use / 2)), (int)snippettimeseries->end_sample);
+				alongtrack = bathymetry->alongtrack[i];
+			}
+			else if (work->source == R7KRECID_7kCompressedWaterColumn) {
+				sample_detect = compressedwatercolumn->sample_rate * bathymetry->range[ibeam];
+				sample_start = MAX((sample_detect - (nsample_use / 2)), (int)compressedwatercolumn->first_sample);
+				sample_end = MIN((sample_detect + (nsample_use / 2)), (int)compressedwatercolumndata->samples - 1 - offset);
+				alongtrack = bathymetry->alongtrack[ibeam];
+			}
+			else {
+				sample_detect = volatilesettings->sample_rate * bathymetry->range[ibeam];
+				sample_start = MAX(sample_detect - (nsample_use / 2), snippet->begin_sample);
+				sample_end = MIN(sample_detect + (nsample_use / 2), snippet->end_sample);
+				alongtrack = bathymetry->alongtrack[ibeam];
+				if ((beam->sample_type & 15) == 3)
+					data_uint = (unsigned int *)snippet->amplitude;
+				else if ((beam->sample_type & 15) == 2)
+					data_ushort = (unsigned short *)snippet->amplitude;
+				else
+					data_uchar = (mb_u_char *)snippet->amplitude;
+			}
+			for (k = sample_start; k <= sample_end; k++) {
+				if (xtrack < 0.0)
+					xtrackss = xtrack - ss_spacing_use * (k - sample_detect);
+				else
+					xtrackss = xtrack + ss_spacing_use * (k - sample_detect);
+				kk = work->nss / 2 + (int)(xtrackss / work->pixel_size);
+				kk = MIN(MAX(0, kk), work->nss - 1);
+				if (work->source == R7KRECID_7kCalibratedSnippetData)
+					amplitude =
+					    (double)calibratedsnippettimeseries->amplitude[k - (int)calibratedsnippettimeseries->begin_sample];
+				else if (work->source == R7KRECID_7kV2SnippetData)
+					amplitude = (double)snippettimeseries->amplitude[k - (int)snippettimeseries->begin_sample];
+				else if (work->source == R7KRECID_7kCompressedWaterColumn) {
+					sample = &(compressedwatercolumndata->sample[(k + offset) * samplesize]);
+					if (compressedwatercolumn->flags & R7KWC_32BIT)
+						amplitude = (double)((u32)sample[0] | ((u32)sample[1] << 8) | ((u32)sample[2] << 16) |
+						                     ((u32)sample[3] << 24));
+					else if (compressedwatercolumn->flags & R7KWC_8BITDB)
+						amplitude = mbsys_reson7k_dblinear[sample[0]];
+					else
+						amplitude = (double)((u32)sample[0] | ((u32)sample[1] << 8));
+				}
+				else if ((beam->sample_type & 15) == 3)
+					amplitude = (double)data_uint[k - snippet->begin_sample];
+				else if ((beam->sample_type & 15) == 2)
+					amplitude = (double)data_ushort[k - snippet->begin_sample];
+				else
+					amplitude = (double)data_uchar[k - snippet->begin_sample];
+				if (work->listpixel == NULL) {
+					work->ss[kk] += amplitude;
+					work->ssalongtrack[kk] += alongtrack;
+					work->ss_cnt[kk]++;
+				}
+				else if (work->nlist < work->nlistalloc) {
+					work->listpixel[work->nlist] = kk;
+					work->listamplitude[work->nlist] = amplitude;
+					work->listalongtrack[work->nlist] = alongtrack;
+					work->nlist++;
+				}
+			}
+		}
+	}
+
+	return (NULL);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_set_makessthreads(int verbose, void *mbio_ptr, int nthreads, int deterministic, int *error) {
+	char *function_name = "mbsys_reson7k_set_makessthreads";
+	int status = MB_SUCCESS;
+	struct mb_io_struct *mb_io_ptr;
+	struct mbsys_reson7k_struct *store;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:       %d\n", verbose);
+		fprintf(stderr, "dbg2       mbio_ptr:      %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       nthreads:      %d\n", nthreads);
+		fprintf(stderr, "dbg2       deterministic: %d\n", deterministic);
+	}
+
+	/* get mbio descriptor - the setting belongs to the file whose sidescan is made */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+	store = (struct mbsys_reson7k_struct *)mb_io_ptr->store_data;
+
+	/* the threads are only used if built with MBSYS_RESON7K_PTHREADS */
+	store->makess_threads = MAX(1, MIN(nthreads, MBSYS_RESON7K_MAKESS_THREADS_MAX));
+	store->makess_deterministic = (deterministic == MB_YES ? MB_YES : MB_NO);
+	*error = MB_ERROR_NO_ERROR;
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:         %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:        %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_rawrecord_index(int recordid) {
+	int index;
+
+	/* ping records each have their own slot, everything else shares one */
+	switch (recordid) {
+	case R7KRECID_7kVolatileSonarSettings:
+		index = R7KRAW_VolatileSonarSettings;
+		break;
+	case R7KRECID_7kMatchFilter:
+		index = R7KRAW_MatchFilter;
+		break;
+	case R7KRECID_7kBeamGeometry:
+		index = R7KRAW_BeamGeometry;
+		break;
+	case R7KRECID_7kRemoteControlSonarSettings:
+		index = R7KRAW_RemoteControlSonarSettings;
+		break;
+	case R7KRECID_7kBathymetricData:
+		index = R7KRAW_BathymetricData;
+		break;
+	case R7KRECID_ProcessedSidescan:
+		index = R7KRAW_ProcessedSidescan;
+		break;
+	case R7KRECID_7kBackscatterImageData:
+		index = R7KRAW_BackscatterImageData;
+		break;
+	case R7KRECID_7kBeamData:
+		index = R7KRAW_BeamData;
+		break;
+	case R7KRECID_7kVerticalDepth:
+		index = R7KRAW_VerticalDepth;
+		break;
+	case R7KRECID_7kTVGData:
+		index = R7KRAW_TVGData;
+		break;
+	case R7KRECID_7kImageData:
+		index = R7KRAW_ImageData;
+		break;
+	case R7KRECID_7kV2PingMotion:
+		index = R7KRAW_PingMotion;
+		break;
+	case R7KRECID_7kV2DetectionSetup:
+		index = R7KRAW_DetectionSetup;
+		break;
+	case R7KRECID_7kV2BeamformedData:
+		index = R7KRAW_BeamformedData;
+		break;
+	case R7KRECID_7kV2Detection:
+		index = R7KRAW_Detection;
+		break;
+	case R7KRECID_7kV2RawDetection:
+		index = R7KRAW_RawDetection;
+		break;
+	case R7KRECID_7kV2SnippetData:
+		index = R7KRAW_SnippetData;
+		break;
+	case R7KRECID_7kCalibratedSnippetData:
+		index = R7KRAW_CalibratedSnippetData;
+		break;
+	case R7KRECID_7kCompressedWaterColumn:
+		index = R7KRAW_CompressedWaterColumn;
+		break;
+	default:
+		index = R7KRAW_Other;
+		break;
+	}
+
+	return (index);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_rawrecord_id(int index) {
+	int recordid;
+
+	/* the ping record of each slot, i.e. of each bit of the ping record registry */
+	switch (index) {
+	case R7KRAW_VolatileSonarSettings:
+		recordid = R7KRECID_7kVolatileSonarSettings;
+		break;
+	case R7KRAW_MatchFilter:
+		recordid = R7KRECID_7kMatchFilter;
+		break;
+	case R7KRAW_BeamGeometry:
+		recordid = R7KRECID_7kBeamGeometry;
+		break;
+	case R7KRAW_RemoteControlSonarSettings:
+		recordid = R7KRECID_7kRemoteControlSonarSettings;
+		break;
+	case R7KRAW_BathymetricData:
+		recordid = R7KRECID_7kBathymetricData;
+		break;
+	case R7KRAW_ProcessedSidescan:
+		recordid = R7KRECID_ProcessedSidescan;
+		break;
+	case R7KRAW_BackscatterImageData:
+		recordid = R7KRECID_7kBackscatterImageData;
+		break;
+	case R7KRAW_BeamData:
+		recordid = R7KRECID_7kBeamData;
+		break;
+	case R7KRAW_VerticalDepth:
+		recordid = R7KRECID_7kVerticalDepth;
+		break;
+	case R7KRAW_TVGData:
+		recordid = R7KRECID_7kTVGData;
+		break;
+	case R7KRAW_ImageData:
+		recordid = R7KRECID_7kImageData;
+		break;
+	case R7KRAW_PingMotion:
+		recordid = R7KRECID_7kV2PingMotion;
+		break;
+	case R7KRAW_DetectionSetup:
+		recordid = R7KRECID_7kV2DetectionSetup;
+		break;
+	case R7KRAW_BeamformedData:
+		recordid = R7KRECID_7kV2BeamformedData;
+		break;
+	case R7KRAW_Detection:
+		recordid = R7KRECID_7kV2Detection;
+		break;
+	case R7KRAW_RawDetection:
+		recordid = R7KRECID_7kV2RawDetection;
+		break;
+	case R7KRAW_SnippetData:
+		recordid = R7KRECID_7kV2SnippetData;
+		break;
+	case R7KRAW_CalibratedSnippetData:
+		recordid = R7KRECID_7kCalibratedSnippetData;
+		break;
+	case R7KRAW_CompressedWaterColumn:
+		recordid = R7KRECID_7kCompressedWaterColumn;
+		break;
+	default:
+		recordid = R7KRECID_None;
+		break;
+	}
+
+	return (recordid);
+}
+/*--------------------------------------------------------------------*/
+u32 mbsys_reson7k_pingcomplete_mask(int deviceid) {
+	u32 mask;
+
+	/* a suggested completion mask for mbsys_reson7k_set_pingcomplete() -
+	    the T-series sonars log raw detections without the legacy 7k ping
+	    records, any other sonar is treated as a 7k series multibeam. The
+	    T-series mask ends at the 7027 raw detections, so callers whose
+	    sonars also log 7028 snippets or 7042 water column add those bits */
+	switch (deviceid) {
+	case R7KDEVID_SeaBatT20:
+	case R7KDEVID_SeaBatT20Dual:
+	case R7KDEVID_SeaBatT50:
+	case R7KDEVID_SeaBatT50Dual:
+		mask = R7KREAD_COMPLETE_TSERIES;
+		break;
+	default:
+		mask = R7KREAD_COMPLETE_7K;
+		break;
+	}
+
+	return (mask);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_rawrecord_save(int verbose, void *store_ptr, int recordid, char *buffer, int size, int *error) {
+	char *function_name = "mbsys_reson7k_rawrecord_save";
+	int status = MB_SUCCESS;
+	struct mbsys_reson7k_struct *store;
+	s7k_rawrecord *rawrecord;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       recordid:   %d\n", recordid);
+		fprintf(stderr, "dbg2       buffer:     %p\n", (void *)buffer);
+		fprintf(stderr, "dbg2       size:       %d\n", size);
+	}
+
+	/* get data structure pointer */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+	rawrecord = &(store->rawrecord[mbsys_reson7k_rawrecord_index(recordid)]);
+
+	/* bytes shared with copies of this store are left to the copies */
+	status = mbsys_reson7k_unshare_payload(verbose, store_ptr, R7KSHARE_RawRecord + mbsys_reson7k_rawrecord_index(recordid),
+	                                       MB_NO, error);
+
+	/* allocate memory if necessary */
+	if (rawrecord->nalloc < size) {
+		status = mb_reallocd(verbose, __FILE__, __LINE__, size, (void **)&(rawrecord->buffer), error);
+		if (status == MB_SUCCESS) {
+			rawrecord->nalloc = size;
+		}
+		else {
+			rawrecord->nalloc = 0;
+		}
+	}
+
+	/* keep a copy of the record bytes */
+	if (status == MB_SUCCESS) {
+		memcpy(rawrecord->buffer, buffer, (size_t)size);
+		rawrecord->recordid = recordid;
+		rawrecord->modified = MB_NO;
+		rawrecord->size = size;
+	}
+	else {
+		rawrecord->recordid = R7KRECID_None;
+		rawrecord->modified = MB_NO;
+		rawrecord->size = 0;
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_rawrecord_modified(int verbose, void *store_ptr, int recordid, int *error) {
+	char *function_name = "mbsys_reson7k_rawrecord_modified";
+	int status = MB_SUCCESS;
+	struct mbsys_reson7k_struct *store;
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       recordid:   %d\n", recordid);
+	}
+
+	/* get data structure pointer */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+
+	/* R7KRECID_None marks every record as modified */
+	if (recordid == R7KRECID_None) {
+		for (i = 0; i < R7KRAW_NUM; i++)
+			store->rawrecord[i].modified = MB_YES;
+	}
+	else {
+		store->rawrecord[mbsys_reson7k_rawrecord_index(recordid)].modified = MB_YES;
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_set_compresswatercolumn(int verbose, void *mbio_ptr, int compress, unsigned int flags, int *error) {
+	char *function_name = "mbsys_reson7k_set_compresswatercolumn";
+	int status = MB_SUCCESS;
+	struct mb_io_struct *mb_io_ptr;
+	struct mbsys_reson7k_struct *store;
+	unsigned int divisor;
+	unsigned int downsample;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       compress:   %d\n", compress);
+		fprintf(stderr, "dbg2       flags:      0x%x\n", flags);
+	}
+
+	/* get mbio descriptor - the setting belongs to the output file so it
+	    is held in the internal store rather than in the store being written */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+	store = (struct mbsys_reson7k_struct *)mb_io_ptr->store_data;
+
+	/* check the flags - the downsampling divisor must be 2-16 if a
+	    downsampling type is specified */
+	divisor = (flags & R7KWC_DIVISOR_MASK) >> R7KWC_DIVISOR_SHIFT;
+	downsample = flags & R7KWC_DOWNSAMPLE_MASK;
+	if ((flags & ~R7KWC_SUPPORTED) != 0 || downsample > R7KWC_DOWNSAMPLE_AVERAGE
+		|| (downsample != R7KWC_DOWNSAMPLE_NONE && divisor < 2)) {
+		status = MB_FAILURE;
+		*error = MB_ERROR_BAD_PARAMETER;
+	}
+
+	/* set the output option */
+	else {
+		store->compresswatercolumn = (compress == MB_YES ? MB_YES : MB_NO);
+		if (downsample == R7KWC_DOWNSAMPLE_NONE)
+			flags &= ~R7KWC_DIVISOR_MASK;
+		store->compresswatercolumn_flags = flags;
+		*error = MB_ERROR_NO_ERROR;
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_set_encodethreads(int verbose, void *mbio_ptr, int nthreads, int *error) {
+	char *function_name = "mbsys_reson7k_set_encodethreads";
+	int status = MB_SUCCESS;
+	struct mb_io_struct *mb_io_ptr;
+	struct mbsys_reson7k_struct *store;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       nthreads:   %d\n", nthreads);
+	}
+
+	/* get mbio descriptor - the setting belongs to the output file */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+	store = (struct mbsys_reson7k_struct *)mb_io_ptr->store_data;
+
+	/* there can be no more threads than records in a ping */
+	store->encode_threads = MAX(1, MIN(nthreads, R7KRAW_Other));
+	*error = MB_ERROR_NO_ERROR;
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_set_writequeue(int verbose, void *mbio_ptr, int depth, int *error) {
+	char *function_name = "mbsys_reson7k_set_writequeue";
+	int status = MB_SUCCESS;
+	struct mb_io_struct *mb_io_ptr;
+	struct mbsys_reson7k_struct *store;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       depth:      %d\n", depth);
+	}
+
+	/* get mbio descriptor - the setting belongs to the output file */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+	store = (struct mbsys_reson7k_struct *)mb_io_ptr->store_data;
+
+	/* the queue is set up when the first ping is written and keeps its
+	    depth until the file is closed. While the queue is in use the ping
+	    records of each store written are handed over to the queue, and the
+	    store is left with those of a ping written earlier for the next
+	    read - the caller must not expect to write the same ping twice */
+	if (store->writequeue != NULL) {
+		status = MB_FAILURE;
+		*error = MB_ERROR_BAD_PARAMETER;
+	}
+	else {
+		store->writequeue_depth = MAX(0, MIN(depth, MBSYS_RESON7K_WRITEQUEUE_MAX));
+		*error = MB_ERROR_NO_ERROR;
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_free_encodeping(int verbose, s7k_encodeping *encodeping, int *error) {
+	char *function_name = "mbsys_reson7k_free_encodeping";
+	int status = MB_SUCCESS;
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       encodeping: %p\n", (void *)encodeping);
+	}
+
+	/* free the encoding buffers and the 7042 scratch arrays */
+	encodeping->nrecord = 0;
+	for (i = 0; i < R7KRAW_Other; i++) {
+		encodeping->encodebuffer[i].recordid = R7KRECID_None;
+		encodeping->encodebuffer[i].size = 0;
+		encodeping->encodebuffer[i].nalloc = 0;
+		if (encodeping->encodebuffer[i].buffer != NULL)
+			status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(encodeping->encodebuffer[i].buffer), error);
+	}
+	encodeping->nbottom = 0;
+	if (encodeping->bottom != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(encodeping->bottom), error);
+	encodeping->nsample = 0;
+	if (encodeping->magnitude != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(encodeping->magnitude), error);
+	if (encodeping->phase != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(encodeping->phase), error);
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_storesize(int verbose, void *store_ptr, size_t *size, size_t *resident, int *error) {
+	char *function_name = "mbsys_reson7k_storesize";
+	int status = MB_SUCCESS;
+	struct mbsys_reson7k_struct *store;
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+	}
+
+	/* get data structure pointer */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+
+	/* the fixed size of the store */
+	*size = sizeof(struct mbsys_reson7k_struct);
+
+	/* add the buffers held by the store - raw records, encode buffers,
+	    the file catalog, scratch arrays and the per-beam arrays - arrays
+	    shared with copies of the store are not counted */
+	*resident = *size;
+	for (i = 0; i < R7KRAW_NUM; i++)
+		if (store->sharecount[R7KSHARE_RawRecord + i] == NULL)
+			*resident += store->rawrecord[i].nalloc;
+	for (i = 0; i < R7KRAW_Other; i++)
+		*resident += store->encodeping.encodebuffer[i].nalloc;
+	*resident += store->encodeping.nbottom * sizeof(int);
+	*resident += store->encodeping.nsample * (sizeof(unsigned short) + sizeof(short));
+	*resident += store->filecatalogrecord.nalloc * sizeof(s7kr_filecatalogrecorddata);
+	*resident += store->filecatalogwrite.fileheader_nalloc;
+	*resident += store->fileindex.nalloc * (sizeof(u64) + sizeof(int) + 2 * sizeof(double));
+	if (store->sharecount[R7KSHARE_BeamGeometry] == NULL)
+		*resident += store->beamgeometry.nalloc * 4 * sizeof(f32);
+	if (store->sharecount[R7KSHARE_Bathymetry] == NULL)
+		*resident += store->bathymetry.nalloc * (9 * sizeof(f32) + sizeof(u8));
+	*resident += store->v2detectionsetup.nalloc * (sizeof(u16) + 2 * sizeof(f32) + 6 * sizeof(u32));
+	*resident += store->v2detection.nalloc * 6 * sizeof(f32);
+	*resident += store->v2rawdetection.nalloc * (sizeof(u16) + 3 * sizeof(f32) + 2 * sizeof(u32));
+	*resident += store->makessscratch.nalloc * (6 * sizeof(double) + sizeof(char));
+	*resident += store->makessscratch.nthreadalloc * (2 * sizeof(double) + sizeof(int));
+	*resident += (store->makessscratch.grid.nalloc + store->makessscratch.hiresgrid.nalloc) * (3 * sizeof(double) + sizeof(int));
+	*resident += store->makessscratch.nlistalloc * (2 * sizeof(double) + sizeof(int));
+	*resident += store->beamattitude.nalloc * (14 * sizeof(double) + 2 * sizeof(int));
+	*resident += store->attitudeseries.nalloc * (6 * sizeof(double) + sizeof(int));
+	for (i = 0; i < MBSYS_RESON7K_TSERIES_NUM; i++) {
+		*resident += store->tseries[i].nalloc * (1 + store->tseries[i].nfield) * sizeof(double);
+		if (store->tseries_preprocess[i].shared == MB_NO)
+			*resident += store->tseries_preprocess[i].nalloc * (1 + store->tseries_preprocess[i].nfield) * sizeof(double);
+	}
+	*resident += store->raytable.nalloc * (4 * sizeof(double)) + store->raytable.nangle * sizeof(int);
+	if (store->sharecount[R7KSHARE_Configuration] == NULL) {
+		*resident += store->configuration.nalloc * sizeof(s7k_device);
+		for (i = 0; i < store->configuration.nalloc; i++)
+			*resident += store->configuration.device[i].info_alloc;
+	}
+	if (store->sharecount[R7KSHARE_FileHeader] == NULL)
+		*resident += store->fileheader.nalloc * sizeof(s7kr_subsystem);
+	*resident += store->s7kr_watercolumn.nalloc * (sizeof(s7k_wcd) + 2 * sizeof(f32) + sizeof(u32));
+	for (i = 0; i < store->s7kr_watercolumn.nalloc; i++)
+		*resident += store->s7kr_watercolumn.wcd[i].nalloc * (sizeof(u16) + 2 * sizeof(u32));
+	*resident += store->detectionsetup.nalloc * (sizeof(u16) + 6 * sizeof(f32) + 2 * sizeof(u32));
+	*resident += store->beamformed.nalloc * sizeof(s7k_amplitudephase);
+	for (i = 0; i < store->beamformed.nalloc; i++)
+		*resident += store->beamformed.amplitudephase[i].nalloc * (sizeof(u16) + sizeof(i16));
+	*resident += store->vernierprocessingdataraw.nalloc * sizeof(s7k_anglemagnitude);
+	for (i = 0; i < store->vernierprocessingdataraw.nalloc; i++)
+		*resident += store->vernierprocessingdataraw.anglemagnitude[i].nalloc * (sizeof(i16) + 5 * sizeof(u16));
+	*resident += store->rawdetection.nalloc * (sizeof(s7k_rawdetectiondata) + 5 * sizeof(f32));
+	*resident += store->snippet.nalloc * (sizeof(s7k_snippettimeseries) + 2 * sizeof(f32) + sizeof(u32));
+	for (i = 0; i < store->snippet.nalloc; i++)
+		*resident += store->snippet.snippettimeseries[i].nalloc;
+	*resident += store->vernierprocessingdatafiltered.nalloc * sizeof(s7k_vernierprocessingdatasoundings);
+	*resident += store->compressedbeamformedmagnitude.nalloc * sizeof(s7k_beamformedmagnitude);
+	for (i = 0; i < store->compressedbeamformedmagnitude.nalloc; i++)
+		*resident += store->compressedbeamformedmagnitude.beamformedmagnitude[i].nalloc;
+	*resident += store->compressedwatercolumn.nalloc * sizeof(s7k_compressedwatercolumndata);
+	for (i = 0; i < store->compressedwatercolumn.nalloc; i++)
+		*resident += store->compressedwatercolumn.compressedwatercolumndata[i].nalloc;
+	*resident += store->segmentedrawdetection.nalloc * sizeof(s7k_segmentedrawdetectiondata);
+	*resident += store->systemevents.nalloc * sizeof(s7k_systemeventsdata);
+	*resident += store->subscriptions.nalloc * sizeof(s7k_subscriptionsdata);
+	*resident += store->snippetbackscatteringstrength.nalloc
+	             * (sizeof(s7k_snippetbackscatteringstrengthdata) + 2 * sizeof(f32) + sizeof(u32));
+	for (i = 0; i < store->snippetbackscatteringstrength.nalloc; i++)
+		*resident += 2 * store->snippetbackscatteringstrength.snippetbackscatteringstrengthdata[i].nalloc;
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       size:       %zu\n", *size);
+		fprintf(stderr, "dbg2       resident:   %zu\n", *resident);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
 
-		/* get max data value */
-		datamax = 0.0;
-		for (i = 0; i < mb_segytraceheader_ptr->nsamps; i++) {
-			if (fabs(segydata[i]) > datamax)
-				datamax = fabs(segydata[i]);
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_share_payload(int verbose, void *store_ptr, void *copy_ptr, int payload, int *error) {
+	char *function_name = "mbsys_reson7k_share_payload";
+	int status = MB_SUCCESS;
+	struct mbsys_reson7k_struct *store;
+	struct mbsys_reson7k_struct *copy;
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       copy_ptr:   %p\n", (void *)copy_ptr);
+		fprintf(stderr, "dbg2       payload:    %d\n", payload);
+	}
+
+	/* get data structure pointers */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+	copy = (struct mbsys_reson7k_struct *)copy_ptr;
+
+	/* drop whatever arrays the copy held for this payload */
+	status = mbsys_reson7k_release_payload(verbose, copy_ptr, payload, error);
+
+	/* the first copy of a payload starts its reference count */
+	if (status == MB_SUCCESS && store->sharecount[payload] == NULL) {
+		status = mb_mallocd(verbose, __FILE__, __LINE__, sizeof(atomic_int), (void **)&(store->sharecount[payload]), error);
+		if (status == MB_SUCCESS)
+			atomic_init(store->sharecount[payload], 1);
+	}
+
+	/* the copy references the arrays of the store */
+	if (status == MB_SUCCESS) {
+		switch (payload) {
+		case R7KSHARE_Attitude:
+			copy->attitude = store->attitude;
+			break;
+		case R7KSHARE_Motion:
+			copy->motion = store->motion;
+			break;
+		case R7KSHARE_Svp:
+			copy->svp = store->svp;
+			break;
+		case R7KSHARE_Ctd:
+			copy->ctd = store->ctd;
+			break;
+		case R7KSHARE_FsdwssLo:
+			copy->fsdwsslo = store->fsdwsslo;
+			break;
+		case R7KSHARE_FsdwssHi:
+			copy->fsdwsshi = store->fsdwsshi;
+			break;
+		case R7KSHARE_Fsdwsb:
+			copy->fsdwsb = store->fsdwsb;
+			break;
+		case R7KSHARE_Configuration:
+			copy->configuration = store->configuration;
+			break;
+		case R7KSHARE_BeamGeometry:
+			copy->beamgeometry = store->beamgeometry;
+			break;
+		case R7KSHARE_Bathymetry:
+			copy->bathymetry = store->bathymetry;
+			break;
+		case R7KSHARE_Backscatter:
+			copy->backscatter = store->backscatter;
+			break;
+		case R7KSHARE_Beam:
+			copy->beam = store->beam;
+			break;
+		case R7KSHARE_Tvg:
+			copy->tvg = store->tvg;
+			break;
+		case R7KSHARE_Image:
+			copy->image = store->image;
+			break;
+		case R7KSHARE_SystemEventMessage:
+			copy->systemeventmessage = store->systemeventmessage;
+			break;
+		case R7KSHARE_FileHeader:
+			copy->fileheader = store->fileheader;
+			break;
+		default:
+			i = payload - R7KSHARE_RawRecord;
+			copy->rawrecord[i] = store->rawrecord[i];
+			break;
 		}
-		if (datamax > 0.0) {
-			fsdwsegyheader->weightingFactor = (short)(log(datamax) / MB_LN_2) - 15;
+		atomic_fetch_add(store->sharecount[payload], 1);
+		copy->sharecount[payload] = store->sharecount[payload];
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		if (store->sharecount[payload] != NULL)
+			fprintf(stderr, "dbg2       sharecount: %d\n", atomic_load(store->sharecount[payload]));
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_unshare_payload(int verbose, void *store_ptr, int payload, int preserve, int *error) {
+	char *function_name = "mbsys_reson7k_unshare_payload";
+	int status = MB_SUCCESS;
+	s7k_duplicate duplicate;
+	struct mbsys_reson7k_struct *store;
+	s7kr_attitude *attitude;
+	s7kr_motion *motion;
+	s7kr_svp *svp;
+	s7kr_ctd *ctd;
+	s7kr_fsdwss *fsdwss;
+	s7kr_fsdwsb *fsdwsb;
+	s7kr_configuration *configuration;
+	s7kr_beamgeometry *beamgeometry;
+	s7kr_bathymetry *bathymetry;
+	s7kr_backscatter *backscatter;
+	s7kr_beam *beam;
+	s7kr_tvg *tvg;
+	s7kr_image *image;
+	s7kr_systemeventmessage *systemeventmessage;
+	s7kr_fileheader *fileheader;
+	s7k_rawrecord *rawrecord;
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       payload:    %d\n", payload);
+		fprintf(stderr, "dbg2       preserve:   %d\n", preserve);
+	}
+
+	/* get data structure pointer */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+
+	/* nothing to do unless the arrays are still referenced by another store -
+	    only a store holding a reference can share it, so a count of one
+	    cannot grow while it is checked */
+	if (store->sharecount[payload] != NULL && atomic_load(store->sharecount[payload]) <= 1) {
+		status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->sharecount[payload]), error);
+	}
+
+	/* if the record is about to be overwritten just let go of the shared
+	    arrays - the record is emptied and reallocated as it is read, unless
+	    the other stores let go of them first and they are ours after all */
+	else if (store->sharecount[payload] != NULL && preserve == MB_NO) {
+		if (atomic_fetch_sub(store->sharecount[payload], 1) == 1)
+			status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->sharecount[payload]), error);
+		else {
+			store->sharecount[payload] = NULL;
+			status = mbsys_reson7k_clear_payload(verbose, store_ptr, payload, MB_NO, error);
 		}
-		else
-			fsdwsegyheader->weightingFactor = 0;
-		weight = pow(2.0, (double)fsdwsegyheader->weightingFactor);
-		fsdwchannel->bytespersample = 2;
+	}
 
-		/* make sure enough memory is allocated for channel data */
-		data_size = fsdwchannel->bytespersample * fsdwchannel->number_samples;
-		if (fsdwchannel->data_alloc < data_size) {
-			status = mb_reallocd(verbose, __FILE__, __LINE__, data_size, (void **)&(fsdwchannel->data), error);
-			if (status == MB_SUCCESS) {
-				fsdwchannel->data_alloc = data_size;
-			}
-			else {
-				fsdwchannel->data_alloc = 0;
-				fsdwchannel->number_samples = 0;
+	/* otherwise give this store its own copy of the arrays - the reference
+	    is held while they are copied so that no other store can take them
+	    over, and the arrays replaced are freed if the other stores let go
+	    of them meanwhile */
+	else if (store->sharecount[payload] != NULL) {
+		duplicate.status = MB_SUCCESS;
+		duplicate.nshared = 0;
+		switch (payload) {
+		case R7KSHARE_Attitude:
+			attitude = &store->attitude;
+			mbsys_reson7k_duplicate_array(verbose, attitude->nalloc * sizeof(u16), (void **)&(attitude->delta_time), &duplicate,
+			                              error);
+			mbsys_reson7k_duplicate_array(verbose, attitude->nalloc * sizeof(f32), (void **)&(attitude->roll), &duplicate,
+			                              error);
+			mbsys_reson7k_duplicate_array(verbose, attitude->nalloc * sizeof(f32), (void **)&(attitude->pitch), &duplicate,
+			                              error);
+			mbsys_reson7k_duplicate_array(verbose, attitude->nalloc * sizeof(f32), (void **)&(attitude->heave), &duplicate,
+			                              error);
+			mbsys_reson7k_duplicate_array(verbose, attitude->nalloc * sizeof(f32), (void **)&(attitude->heading), &duplicate,
+			                              error);
+			break;
+		case R7KSHARE_Motion:
+			motion = &store->motion;
+			mbsys_reson7k_duplicate_array(verbose, motion->nalloc * sizeof(f32), (void **)&(motion->x), &duplicate, error);
+			mbsys_reson7k_duplicate_array(verbose, motion->nalloc * sizeof(f32), (void **)&(motion->y), &duplicate, error);
+			mbsys_reson7k_duplicate_array(verbose, motion->nalloc * sizeof(f32), (void **)&(motion->z), &duplicate, error);
+			mbsys_reson7k_duplicate_array(verbose, motion->nalloc * sizeof(f32), (void **)&(motion->xa), &duplicate, error);
+			mbsys_reson7k_duplicate_array(verbose, motion->nalloc * sizeof(f32), (void **)&(motion->ya), &duplicate, error);
+			mbsys_reson7k_duplicate_array(verbose, motion->nalloc * sizeof(f32), (void **)&(motion->za), &duplicate, error);
+			break;
+		case R7KSHARE_Svp:
+			svp = &store->svp;
+			mbsys_reson7k_duplicate_array(verbose, svp->nalloc * sizeof(f32), (void **)&(svp->depth), &duplicate, error);
+			mbsys_reson7k_duplicate_array(verbose, svp->nalloc * sizeof(f32), (void **)&(svp->sound_velocity), &duplicate,
+			                              error);
+			break;
+		case R7KSHARE_Ctd:
+			ctd = &store->ctd;
+			mbsys_reson7k_duplicate_array(verbose, ctd->nalloc * sizeof(f32), (void **)&(ctd->conductivity_salinity),
+			                              &duplicate, error);
+			mbsys_reson7k_duplicate_array(verbose, ctd->nalloc * sizeof(f32), (void **)&(ctd->temperature), &duplicate, error);
+			mbsys_reson7k_duplicate_array(verbose, ctd->nalloc * sizeof(f32), (void **)&(ctd->pressure_depth), &duplicate,
+			                              error);
+			mbsys_reson7k_duplicate_array(verbose, ctd->nalloc * sizeof(f32), (void **)&(ctd->sound_velocity), &duplicate,
+			                              error);
+			mbsys_reson7k_duplicate_array(verbose, ctd->nalloc * sizeof(f32), (void **)&(ctd->absorption), &duplicate, error);
+			break;
+		case R7KSHARE_FsdwssLo:
+		case R7KSHARE_FsdwssHi:
+			if (payload == R7KSHARE_FsdwssLo)
+				fsdwss = &store->fsdwsslo;
+			else
+				fsdwss = &store->fsdwsshi;
+			for (i = 0; i < 2; i++)
+				mbsys_reson7k_duplicate_array(verbose, fsdwss->channel[i].data_alloc, (void **)&(fsdwss->channel[i].data),
+				                              &duplicate, error);
+			break;
+		case R7KSHARE_Fsdwsb:
+			fsdwsb = &store->fsdwsb;
+			mbsys_reson7k_duplicate_array(verbose, fsdwsb->channel.data_alloc, (void **)&(fsdwsb->channel.data), &duplicate,
+			                              error);
+			break;
+		case R7KSHARE_Configuration:
+			configuration = &store->configuration;
+			mbsys_reson7k_duplicate_array(verbose, configuration->nalloc * sizeof(s7k_device),
+			                              (void **)&(configuration->device), &duplicate, error);
+			if (configuration->device == NULL)
+				configuration->nalloc = 0;
+			for (i = 0; i < configuration->nalloc; i++)
+				mbsys_reson7k_duplicate_array(verbose, configuration->device[i].info_alloc,
+				                              (void **)&(configuration->device[i].info), &duplicate, error);
+			break;
+		case R7KSHARE_BeamGeometry:
+			beamgeometry = &store->beamgeometry;
+			mbsys_reson7k_duplicate_array(verbose, beamgeometry->nalloc * sizeof(f32),
+			                              (void **)&(beamgeometry->angle_alongtrack), &duplicate, error);
+			mbsys_reson7k_duplicate_array(verbose, beamgeometry->nalloc * sizeof(f32),
+			                              (void **)&(beamgeometry->angle_acrosstrack), &duplicate, error);
+			mbsys_reson7k_duplicate_array(verbose, beamgeometry->nalloc * sizeof(f32),
+			                              (void **)&(beamgeometry->beamwidth_alongtrack), &duplicate, error);
+			mbsys_reson7k_duplicate_array(verbose, beamgeometry->nalloc * sizeof(f32),
+			                              (void **)&(beamgeometry->beamwidth_acrosstrack), &duplicate, error);
+			break;
+		case R7KSHARE_Bathymetry:
+			bathymetry = &store->bathymetry;
+			mbsys_reson7k_duplicate_array(verbose, bathymetry->nalloc * sizeof(f32), (void **)&(bathymetry->range), &duplicate,
+			                              error);
+			mbsys_reson7k_duplicate_array(verbose, bathymetry->nalloc * sizeof(u8), (void **)&(bathymetry->quality), &duplicate,
+			                              error);
+			mbsys_reson7k_duplicate_array(verbose, bathymetry->nalloc * sizeof(f32), (void **)&(bathymetry->intensity),
+			                              &duplicate, error);
+			mbsys_reson7k_duplicate_array(verbose, bathymetry->nalloc * sizeof(f32), (void **)&(bathymetry->min_depth_gate),
+			                              &duplicate, error);
+			mbsys_reson7k_duplicate_array(verbose, bathymetry->nalloc * sizeof(f32), (void **)&(bathymetry->max_depth_gate),
+			                              &duplicate, error);
+			mbsys_reson7k_duplicate_array(verbose, bathymetry->nalloc * sizeof(f32), (void **)&(bathymetry->depth), &duplicate,
+			                              error);
+			mbsys_reson7k_duplicate_array(verbose, bathymetry->nalloc * sizeof(f32), (void **)&(bathymetry->alongtrack),
+			                              &duplicate, error);
+			mbsys_reson7k_duplicate_array(verbose, bathymetry->nalloc * sizeof(f32), (void **)&(bathymetry->acrosstrack),
+			                              &duplicate, error);
+			mbsys_reson7k_duplicate_array(verbose, bathymetry->nalloc * sizeof(f32), (void **)&(bathymetry->pointing_angle),
+			                              &duplicate, error);
+			mbsys_reson7k_duplicate_array(verbose, bathymetry->nalloc * sizeof(f32), (void **)&(bathymetry->azimuth_angle),
+			                              &duplicate, error);
+			break;
+		case R7KSHARE_Backscatter:
+			backscatter = &store->backscatter;
+			mbsys_reson7k_duplicate_array(verbose, backscatter->nalloc, (void **)&(backscatter->port_data), &duplicate, error);
+			mbsys_reson7k_duplicate_array(verbose, backscatter->nalloc, (void **)&(backscatter->stbd_data), &duplicate, error);
+			break;
+		case R7KSHARE_Beam:
+			beam = &store->beam;
+			for (i = 0; i < MBSYS_RESON7K_MAX_RECEIVERS; i++) {
+				mbsys_reson7k_duplicate_array(verbose, beam->snippets[i].nalloc_amp, (void **)&(beam->snippets[i].amplitude),
+				                              &duplicate, error);
+				mbsys_reson7k_duplicate_array(verbose, beam->snippets[i].nalloc_phase, (void **)&(beam->snippets[i].phase),
+				                              &duplicate, error);
 			}
+			break;
+		case R7KSHARE_Tvg:
+			tvg = &store->tvg;
+			mbsys_reson7k_duplicate_array(verbose, tvg->nalloc, (void **)&(tvg->tvg), &duplicate, error);
+			break;
+		case R7KSHARE_Image:
+			image = &store->image;
+			mbsys_reson7k_duplicate_array(verbose, image->nalloc, (void **)&(image->image), &duplicate, error);
+			break;
+		case R7KSHARE_SystemEventMessage:
+			systemeventmessage = &store->systemeventmessage;
+			mbsys_reson7k_duplicate_array(verbose, systemeventmessage->message_alloc, (void **)&(systemeventmessage->message),
+			                              &duplicate, error);
+			break;
+		case R7KSHARE_FileHeader:
+			fileheader = &store->fileheader;
+			mbsys_reson7k_duplicate_array(verbose, fileheader->nalloc * sizeof(s7kr_subsystem), (void **)&(fileheader->subsystem),
+			                              &duplicate, error);
+			break;
+		default:
+			rawrecord = &store->rawrecord[payload - R7KSHARE_RawRecord];
+			mbsys_reson7k_duplicate_array(verbose, rawrecord->nalloc, (void **)&(rawrecord->buffer), &duplicate, error);
+			break;
 		}
 
-		/* copy over the data */
-		if (fsdwchannel->data_alloc >= data_size) {
-			shortptr = (short *)fsdwchannel->data;
-			for (i = 0; i < fsdwchannel->number_samples; i++) {
-				shortptr[i] = (short)(segydata[i] * weight);
-			}
+		/* let go of the shared arrays */
+		if (atomic_fetch_sub(store->sharecount[payload], 1) == 1) {
+			for (i = 0; i < duplicate.nshared; i++)
+				mb_freed(verbose, __FILE__, __LINE__, (void **)&(duplicate.shared[i]), error);
+			mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->sharecount[payload]), error);
 		}
+		store->sharecount[payload] = NULL;
 
-		/* done translating values */
+		/* on failure free whatever was duplicated and leave the record empty */
+		if (duplicate.status != MB_SUCCESS) {
+			mbsys_reson7k_clear_payload(verbose, store_ptr, payload, MB_YES, error);
+			*error = MB_ERROR_MEMORY_FAIL;
+			status = MB_FAILURE;
+		}
 	}
 
-	/* deal with comment */
-	else if (kind == MB_DATA_COMMENT) {
-		/* set status */
-		*error = MB_ERROR_COMMENT;
-		status = MB_FAILURE;
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
 	}
 
-	/* deal with other record type */
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_release_payload(int verbose, void *store_ptr, int payload, int *error) {
+	char *function_name = "mbsys_reson7k_release_payload";
+	int status = MB_SUCCESS;
+	struct mbsys_reson7k_struct *store;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       payload:    %d\n", payload);
+	}
+
+	/* get data structure pointer */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+
+	/* arrays still referenced by other stores are left to them - whichever
+	    store lets go of the last reference frees them */
+	if (store->sharecount[payload] != NULL && atomic_fetch_sub(store->sharecount[payload], 1) > 1) {
+		store->sharecount[payload] = NULL;
+		status = mbsys_reson7k_clear_payload(verbose, store_ptr, payload, MB_NO, error);
+	}
+
+	/* otherwise this store holds the last reference and frees the arrays */
 	else {
-		/* set status */
-		*error = MB_ERROR_OTHER;
-		status = MB_FAILURE;
+		if (store->sharecount[payload] != NULL)
+			status = mb_freed(verbose, __FILE__, __LINE__, (void **)&(store->sharecount[payload]), error);
+		status = mbsys_reson7k_clear_payload(verbose, store_ptr, payload, MB_YES, error);
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_clear_payload(int verbose, void *store_ptr, int payload, int freearrays, int *error) {
+	char *function_name = "mbsys_reson7k_clear_payload";
+	int status = MB_SUCCESS;
+	struct mbsys_reson7k_struct *store;
+	s7kr_attitude *attitude;
+	s7kr_motion *motion;
+	s7kr_svp *svp;
+	s7kr_ctd *ctd;
+	s7kr_fsdwss *fsdwss;
+	s7kr_fsdwsb *fsdwsb;
+	s7kr_configuration *configuration;
+	s7kr_beamgeometry *beamgeometry;
+	s7kr_bathymetry *bathymetry;
+	s7kr_backscatter *backscatter;
+	s7kr_beam *beam;
+	s7kr_tvg *tvg;
+	s7kr_image *image;
+	s7kr_systemeventmessage *systemeventmessage;
+	s7kr_fileheader *fileheader;
+	s7k_rawrecord *rawrecord;
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       payload:    %d\n", payload);
+		fprintf(stderr, "dbg2       freearrays: %d\n", freearrays);
+	}
+
+	/* get data structure pointer */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+
+	/* empty the record, freeing the arrays only if this store owns them */
+	switch (payload) {
+	case R7KSHARE_Attitude:
+		attitude = &store->attitude;
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(attitude->delta_time), error);
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(attitude->roll), error);
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(attitude->pitch), error);
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(attitude->heave), error);
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(attitude->heading), error);
+		attitude->n = 0;
+		attitude->nalloc = 0;
+		break;
+	case R7KSHARE_Motion:
+		motion = &store->motion;
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(motion->x), error);
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(motion->y), error);
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(motion->z), error);
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(motion->xa), error);
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(motion->ya), error);
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(motion->za), error);
+		motion->n = 0;
+		motion->nalloc = 0;
+		break;
+	case R7KSHARE_Svp:
+		svp = &store->svp;
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(svp->depth), error);
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(svp->sound_velocity), error);
+		svp->n = 0;
+		svp->nalloc = 0;
+		break;
+	case R7KSHARE_Ctd:
+		ctd = &store->ctd;
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(ctd->conductivity_salinity), error);
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(ctd->temperature), error);
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(ctd->pressure_depth), error);
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(ctd->sound_velocity), error);
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(ctd->absorption), error);
+		ctd->n = 0;
+		ctd->nalloc = 0;
+		break;
+	case R7KSHARE_FsdwssLo:
+	case R7KSHARE_FsdwssHi:
+		if (payload == R7KSHARE_FsdwssLo)
+			fsdwss = &store->fsdwsslo;
+		else
+			fsdwss = &store->fsdwsshi;
+		for (i = 0; i < 2; i++) {
+			mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(fsdwss->channel[i].data), error);
+			fsdwss->channel[i].number_samples = 0;
+			fsdwss->channel[i].data_alloc = 0;
+		}
+		break;
+	case R7KSHARE_Fsdwsb:
+		fsdwsb = &store->fsdwsb;
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(fsdwsb->channel.data), error);
+		fsdwsb->channel.number_samples = 0;
+		fsdwsb->channel.data_alloc = 0;
+		break;
+	case R7KSHARE_Configuration:
+		configuration = &store->configuration;
+		for (i = 0; i < configuration->nalloc; i++) {
+			mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(configuration->device[i].info), error);
+			configuration->device[i].info_length = 0;
+			configuration->device[i].info_alloc = 0;
+		}
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(configuration->device), error);
+		configuration->number_devices = 0;
+		configuration->nalloc = 0;
+		break;
+	case R7KSHARE_BeamGeometry:
+		beamgeometry = &store->beamgeometry;
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(beamgeometry->angle_alongtrack), error);
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(beamgeometry->angle_acrosstrack), error);
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(beamgeometry->beamwidth_alongtrack), error);
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(beamgeometry->beamwidth_acrosstrack), error);
+		beamgeometry->number_beams = 0;
+		beamgeometry->nalloc = 0;
+		break;
+	case R7KSHARE_Bathymetry:
+		bathymetry = &store->bathymetry;
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(bathymetry->range), error);
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(bathymetry->quality), error);
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(bathymetry->intensity), error);
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(bathymetry->min_depth_gate), error);
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(bathymetry->max_depth_gate), error);
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(bathymetry->depth), error);
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(bathymetry->alongtrack), error);
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(bathymetry->acrosstrack), error);
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(bathymetry->pointing_angle), error);
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(bathymetry->azimuth_angle), error);
+		bathymetry->number_beams = 0;
+		bathymetry->nalloc = 0;
+		break;
+	case R7KSHARE_Backscatter:
+		backscatter = &store->backscatter;
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(backscatter->port_data), error);
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(backscatter->stbd_data), error);
+		backscatter->number_samples = 0;
+		backscatter->nalloc = 0;
+		break;
+	case R7KSHARE_Beam:
+		beam = &store->beam;
+		for (i = 0; i < MBSYS_RESON7K_MAX_RECEIVERS; i++) {
+			mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(beam->snippets[i].amplitude), error);
+			mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(beam->snippets[i].phase), error);
+			beam->snippets[i].begin_sample = 0;
+			beam->snippets[i].end_sample = 0;
+			beam->snippets[i].nalloc_amp = 0;
+			beam->snippets[i].nalloc_phase = 0;
+		}
+		beam->number_beams = 0;
+		break;
+	case R7KSHARE_Tvg:
+		tvg = &store->tvg;
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(tvg->tvg), error);
+		tvg->n = 0;
+		tvg->nalloc = 0;
+		break;
+	case R7KSHARE_Image:
+		image = &store->image;
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(image->image), error);
+		image->width = 0;
+		image->height = 0;
+		image->nalloc = 0;
+		break;
+	case R7KSHARE_SystemEventMessage:
+		systemeventmessage = &store->systemeventmessage;
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(systemeventmessage->message), error);
+		systemeventmessage->message_length = 0;
+		systemeventmessage->message_alloc = 0;
+		break;
+	case R7KSHARE_FileHeader:
+		fileheader = &store->fileheader;
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(fileheader->subsystem), error);
+		fileheader->number_subsystems = 0;
+		fileheader->nalloc = 0;
+		break;
+	default:
+		rawrecord = &store->rawrecord[payload - R7KSHARE_RawRecord];
+		mbsys_reson7k_clear_array(verbose, freearrays, (void **)&(rawrecord->buffer), error);
+		rawrecord->recordid = R7KRECID_None;
+		rawrecord->modified = MB_NO;
+		rawrecord->size = 0;
+		rawrecord->nalloc = 0;
+		break;
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_clear_array(int verbose, int freearray, void **array, int *error) {
+	int status = MB_SUCCESS;
+
+	/* free the array if owned, otherwise just forget it */
+	if (freearray == MB_YES && *array != NULL)
+		status = mb_freed(verbose, __FILE__, __LINE__, array, error);
+	*array = NULL;
+
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_duplicate_array(int verbose, size_t size, void **array, s7k_duplicate *duplicate, int *error) {
+	int status = MB_SUCCESS;
+	void *shared;
+
+	/* replace the shared array with a copy of its first size bytes, listing
+	    the array replaced - the pointer is left NULL if the copy cannot be
+	    made */
+	shared = *array;
+	*array = NULL;
+	if (shared != NULL && duplicate->nshared < MBSYS_RESON7K_DUPLICATE_MAX)
+		duplicate->shared[duplicate->nshared++] = shared;
+	if (shared != NULL && size > 0) {
+		status = mb_mallocd(verbose, __FILE__, __LINE__, size, array, error);
+		if (status == MB_SUCCESS)
+			memcpy(*array, shared, size);
+		else
+			duplicate->status = MB_FAILURE;
+	}
+
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_set_storepool(int verbose, int npool, int *error) {
+	char *function_name = "mbsys_reson7k_set_storepool";
+	int status = MB_SUCCESS;
+	void *store_ptr;
+	int done;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       npool:      %d\n", npool);
+	}
+
+	/* set the number of released stores kept for reuse - zero, the
+	    default, turns the pool off */
+	mbsys_reson7k_storepool_acquire();
+	mbsys_reson7k_storepool_max = MAX(0, MIN(npool, MBSYS_RESON7K_STOREPOOL_MAX));
+	mbsys_reson7k_storepool_release();
+
+	/* free any pooled stores beyond the new limit one at a time, outside
+	    the lock */
+	done = MB_NO;
+	while (done == MB_NO) {
+		store_ptr = NULL;
+		mbsys_reson7k_storepool_acquire();
+		if (mbsys_reson7k_storepool_n > mbsys_reson7k_storepool_max) {
+			mbsys_reson7k_storepool_n--;
+			store_ptr = (void *)mbsys_reson7k_storepool[mbsys_reson7k_storepool_n];
+			mbsys_reson7k_storepool[mbsys_reson7k_storepool_n] = NULL;
+		}
+		mbsys_reson7k_storepool_release();
+		if (store_ptr != NULL)
+			status = mbsys_reson7k_freestore(verbose, &store_ptr, error);
+		else
+			done = MB_YES;
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       npool:      %d\n", mbsys_reson7k_storepool_max);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_free_storepool(int verbose, int *error) {
+	char *function_name = "mbsys_reson7k_free_storepool";
+	int status = MB_SUCCESS;
+	void *store_ptr;
+	int nfree;
+	int done;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+	}
+
+	/* free every pooled store one at a time, outside the lock - the limit
+	    is kept so that stores released later are pooled again. Programs
+	    that enable the pool call this before checking mb_memory_list() */
+	nfree = 0;
+	done = MB_NO;
+	while (done == MB_NO) {
+		store_ptr = NULL;
+		mbsys_reson7k_storepool_acquire();
+		if (mbsys_reson7k_storepool_n > 0) {
+			mbsys_reson7k_storepool_n--;
+			store_ptr = (void *)mbsys_reson7k_storepool[mbsys_reson7k_storepool_n];
+			mbsys_reson7k_storepool[mbsys_reson7k_storepool_n] = NULL;
+		}
+		mbsys_reson7k_storepool_release();
+		if (store_ptr != NULL) {
+			status = mbsys_reson7k_freestore(verbose, &store_ptr, error);
+			nfree++;
+		}
+		else
+			done = MB_YES;
 	}
 
 	/* print output debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       seq_num:           %d\n", mb_segytraceheader_ptr->seq_num);
-		fprintf(stderr, "dbg2       seq_reel:          %d\n", mb_segytraceheader_ptr->seq_reel);
-		fprintf(stderr, "dbg2       shot_num:          %d\n", mb_segytraceheader_ptr->shot_num);
-		fprintf(stderr, "dbg2       shot_tr:           %d\n", mb_segytraceheader_ptr->shot_tr);
-		fprintf(stderr, "dbg2       espn:              %d\n", mb_segytraceheader_ptr->espn);
-		fprintf(stderr, "dbg2       rp_num:            %d\n", mb_segytraceheader_ptr->rp_num);
-		fprintf(stderr, "dbg2       rp_tr:             %d\n", mb_segytraceheader_ptr->rp_tr);
-		fprintf(stderr, "dbg2       trc_id:            %d\n", mb_segytraceheader_ptr->trc_id);
-		fprintf(stderr, "dbg2       num_vstk:          %d\n", mb_segytraceheader_ptr->num_vstk);
-		fprintf(stderr, "dbg2       cdp_fold:          %d\n", mb_segytraceheader_ptr->cdp_fold);
-		fprintf(stderr, "dbg2       use:               %d\n", mb_segytraceheader_ptr->use);
-		fprintf(stderr, "dbg2       range:             %d\n", mb_segytraceheader_ptr->range);
-		fprintf(stderr, "dbg2       grp_elev:          %d\n", mb_segytraceheader_ptr->grp_elev);
-		fprintf(stderr, "dbg2       src_elev:          %d\n", mb_segytraceheader_ptr->src_elev);
-		fprintf(stderr, "dbg2       src_depth:         %d\n", mb_segytraceheader_ptr->src_depth);
-		fprintf(stderr, "dbg2       grp_datum:         %d\n", mb_segytraceheader_ptr->grp_datum);
-		fprintf(stderr, "dbg2       src_datum:         %d\n", mb_segytraceheader_ptr->src_datum);
-		fprintf(stderr, "dbg2       src_wbd:           %d\n", mb_segytraceheader_ptr->src_wbd);
-		fprintf(stderr, "dbg2       grp_wbd:           %d\n", mb_segytraceheader_ptr->grp_wbd);
-		fprintf(stderr, "dbg2       elev_scalar:       %d\n", mb_segytraceheader_ptr->elev_scalar);
-		fprintf(stderr, "dbg2       coord_scalar:      %d\n", mb_segytraceheader_ptr->coord_scalar);
-		fprintf(stderr, "dbg2       src_long:          %d\n", mb_segytraceheader_ptr->src_long);
-		fprintf(stderr, "dbg2       src_lat:           %d\n", mb_segytraceheader_ptr->src_lat);
-		fprintf(stderr, "dbg2       grp_long:          %d\n", mb_segytraceheader_ptr->grp_long);
-		fprintf(stderr, "dbg2       grp_lat:           %d\n", mb_segytraceheader_ptr->grp_lat);
-		fprintf(stderr, "dbg2       coord_units:       %d\n", mb_segytraceheader_ptr->coord_units);
-		fprintf(stderr, "dbg2       wvel:              %d\n", mb_segytraceheader_ptr->wvel);
-		fprintf(stderr, "dbg2       sbvel:             %d\n", mb_segytraceheader_ptr->sbvel);
-		fprintf(stderr, "dbg2       src_up_vel:        %d\n", mb_segytraceheader_ptr->src_up_vel);
-		fprintf(stderr, "dbg2       grp_up_vel:        %d\n", mb_segytraceheader_ptr->grp_up_vel);
-		fprintf(stderr, "dbg2       src_static:        %d\n", mb_segytraceheader_ptr->src_static);
-		fprintf(stderr, "dbg2       grp_static:        %d\n", mb_segytraceheader_ptr->grp_static);
-		fprintf(stderr, "dbg2       tot_static:        %d\n", mb_segytraceheader_ptr->tot_static);
-		fprintf(stderr, "dbg2       laga:              %d\n", mb_segytraceheader_ptr->laga);
-		fprintf(stderr, "dbg2       delay_mils:        %d\n", mb_segytraceheader_ptr->delay_mils);
-		fprintf(stderr, "dbg2       smute_mils:        %d\n", mb_segytraceheader_ptr->smute_mils);
-		fprintf(stderr, "dbg2       emute_mils:        %d\n", mb_segytraceheader_ptr->emute_mils);
-		fprintf(stderr, "dbg2       nsamps:            %d\n", mb_segytraceheader_ptr->nsamps);
-		fprintf(stderr, "dbg2       si_micros:         %d\n", mb_segytraceheader_ptr->si_micros);
-		for (i = 0; i < 19; i++)
-			fprintf(stderr, "dbg2       other_1[%2d]:       %d\n", i, mb_segytraceheader_ptr->other_1[i]);
-		fprintf(stderr, "dbg2       year:              %d\n", mb_segytraceheader_ptr->year);
-		fprintf(stderr, "dbg2       day_of_yr:         %d\n", mb_segytraceheader_ptr->day_of_yr);
-		fprintf(stderr, "dbg2       hour:              %d\n", mb_segytraceheader_ptr->hour);
-		fprintf(stderr, "dbg2       min:               %d\n", mb_segytraceheader_ptr->min);
-		fprintf(stderr, "dbg2       sec:               %d\n", mb_segytraceheader_ptr->sec);
-		fprintf(stderr, "dbg2       mils:              %d\n", mb_segytraceheader_ptr->mils);
-		fprintf(stderr, "dbg2       tr_weight:         %d\n", mb_segytraceheader_ptr->tr_weight);
-		for (i = 0; i < 5; i++)
-			fprintf(stderr, "dbg2       other_2[%2d]:       %d\n", i, mb_segytraceheader_ptr->other_2[i]);
-		fprintf(stderr, "dbg2       delay:             %f\n", mb_segytraceheader_ptr->delay);
-		fprintf(stderr, "dbg2       smute_sec:         %f\n", mb_segytraceheader_ptr->smute_sec);
-		fprintf(stderr, "dbg2       emute_sec:         %f\n", mb_segytraceheader_ptr->emute_sec);
-		fprintf(stderr, "dbg2       si_secs:           %f\n", mb_segytraceheader_ptr->si_secs);
-		fprintf(stderr, "dbg2       wbt_secs:          %f\n", mb_segytraceheader_ptr->wbt_secs);
-		fprintf(stderr, "dbg2       end_of_rp:         %d\n", mb_segytraceheader_ptr->end_of_rp);
-		fprintf(stderr, "dbg2       dummy1:            %f\n", mb_segytraceheader_ptr->dummy1);
-		fprintf(stderr, "dbg2       dummy2:            %f\n", mb_segytraceheader_ptr->dummy2);
-		fprintf(stderr, "dbg2       dummy3:            %f\n", mb_segytraceheader_ptr->dummy3);
-		fprintf(stderr, "dbg2       dummy4:            %f\n", mb_segytraceheader_ptr->dummy4);
-		fprintf(stderr, "dbg2       soundspeed:        %f\n", mb_segytraceheader_ptr->soundspeed);
-		fprintf(stderr, "dbg2       distance:          %f\n", mb_segytraceheader_ptr->distance);
-		fprintf(stderr, "dbg2       roll:              %f\n", mb_segytraceheader_ptr->roll);
-		fprintf(stderr, "dbg2       pitch:             %f\n", mb_segytraceheader_ptr->pitch);
-		fprintf(stderr, "dbg2       heading:           %f\n", mb_segytraceheader_ptr->heading);
-		fprintf(stderr, "dbg2       error:             %d\n", *error);
+		fprintf(stderr, "dbg2       nfree:      %d\n", nfree);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
-		fprintf(stderr, "dbg2       status:            %d\n", status);
+		fprintf(stderr, "dbg2       status:     %d\n", status);
 	}
 
 	/* return status */
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_ctd(int verbose, void *mbio_ptr, void *store_ptr, int *kind, int *nctd, double *time_d, double *conductivity,
-                      double *temperature, double *depth, double *salinity, double *soundspeed, int *error) {
-	char *function_name = "mbsys_reson7k_ctd";
+void mbsys_reson7k_storepool_acquire(void) {
+	while (atomic_flag_test_and_set_explicit(&mbsys_reson7k_storepool_lock, memory_order_acquire))
+		;
+}
+/*--------------------------------------------------------------------*/
+void mbsys_reson7k_storepool_release(void) {
+	atomic_flag_clear_explicit(&mbsys_reson7k_storepool_lock, memory_order_release);
+}
+/*--------------------------------------------------------------------*/
+void mbsys_reson7k_dblinear_init(void) {
+	int i;
+
+	for (i = 0; i < 256; i++)
+		mbsys_reson7k_dblinear[i] = pow(10.0, ((double)i) / 20.0);
+	mbsys_reson7k_dblinear_set = MB_YES;
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_set_pingcomplete(int verbose, void *mbio_ptr, unsigned int mask, int *error) {
+	char *function_name = "mbsys_reson7k_set_pingcomplete";
+	int status = MB_SUCCESS;
 	struct mb_io_struct *mb_io_ptr;
 	struct mbsys_reson7k_struct *store;
-	s7k_header *header;
-	s7kr_bluefin *bluefin;
-	s7k_bluefin_environmental *environmental;
-	s7kr_ctd *ctd;
-	int status = MB_SUCCESS;
-	int time_j[5];
-	int time_i[7];
-	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -9356,103 +15463,388 @@ int mbsys_reson7k_ctd(int verbose, void *mbio_ptr, void *store_ptr, int *kind, i
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
-		fprintf(stderr, "dbg2       mb_ptr:     %p\n", (void *)mbio_ptr);
-		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       mask:       0x%x\n", mask);
 	}
 
-	/* get mbio descriptor */
+	/* get mbio descriptor - the setting belongs to the input file so it
+	    is held in the internal store */
 	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+	store = (struct mbsys_reson7k_struct *)mb_io_ptr->store_data;
 
-	/* get pointer to raw data structure */
-	store = (struct mbsys_reson7k_struct *)store_ptr;
-
-	/* get data kind */
-	*kind = store->kind;
+	/* check the mask - only ping records can complete a ping */
+	if ((mask & ~R7KREAD_ALL) != 0) {
+		status = MB_FAILURE;
+		*error = MB_ERROR_BAD_PARAMETER;
+	}
 
-	/* extract ctd data from bluefin environmental SSV record */
-	if (*kind == MB_DATA_SSV) {
-		bluefin = &(store->bluefin);
-		header = &(bluefin->header);
+	/* set the completion rule - zero, the default, turns it off so that a
+	    ping ends when the first record of the next ping is read */
+	else {
+		store->pingcomplete_mask = mask;
+		*error = MB_ERROR_NO_ERROR;
+	}
 
-		*nctd = 0;
-		for (i = 0; i < bluefin->number_frames; i++) {
-			environmental = &(bluefin->environmental[i]);
-			if (environmental->ctd_time > 0.0 && *nctd < MB_CTD_MAX) {
-				/* get time_d if needed */
-				if (environmental->ctd_time < 10000.0) {
-					time_j[0] = environmental->s7kTime.Year;
-					time_j[1] = environmental->s7kTime.Day;
-					time_j[2] = 60 * environmental->s7kTime.Hours + environmental->s7kTime.Minutes;
-					time_j[3] = (int)environmental->s7kTime.Seconds;
-					time_j[4] = (int)(1000000 * (environmental->s7kTime.Seconds - time_j[3]));
-					mb_get_itime(verbose, time_j, time_i);
-					mb_get_time(verbose, time_i, &environmental->ctd_time);
-				}
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
 
-				/* get values */
-				time_d[*nctd] = environmental->ctd_time;
-				conductivity[*nctd] = environmental->conductivity;
-				temperature[*nctd] = environmental->temperature;
-				depth[*nctd] = environmental->pressure;
-				salinity[*nctd] = environmental->salinity;
-				soundspeed[*nctd] = environmental->sound_speed;
-				(*nctd)++;
-			}
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_interp_bracket(int nd, double *xd, int n, double *xs, int *jd, int *index, double *weight) {
+	int k;
+	int j;
+
+	/* find the samples bracketing each time in one sweep - the search starts
+	    from the bracket of the previous time, so times that are close together
+	    or in order cost only a few comparisons each, and times outside the
+	    series are clamped to its ends as in mb_linear_interp() */
+	if (nd < 2) {
+		for (j = 0; j < n; j++) {
+			index[j] = 0;
+			weight[j] = 0.0;
+		}
+		*jd = 0;
+		return (MB_SUCCESS);
+	}
+	k = MAX(0, MIN(*jd, nd - 2));
+	for (j = 0; j < n; j++) {
+		if (xs[j] <= xd[0]) {
+			index[j] = 0;
+			weight[j] = 0.0;
+		}
+		else if (xs[j] >= xd[nd - 1]) {
+			index[j] = nd - 2;
+			weight[j] = 1.0;
+		}
+		else {
+			while (xs[j] < xd[k])
+				k--;
+			while (xs[j] >= xd[k + 1])
+				k++;
+			index[j] = k;
+			weight[j] = (xs[j] - xd[k]) / (xd[k + 1] - xd[k]);
 		}
 	}
+	*jd = k;
 
-	/* extract ctd data from CTD record */
-	else if (*kind == MB_DATA_CTD) {
-		ctd = &(store->ctd);
-		header = &(ctd->header);
+	return (MB_SUCCESS);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_interp_beamattitude(int verbose, void *preprocess_pars_ptr, int nbeams, s7k_beamattitude *beamattitude,
+                                      int *jattitude, int *jheading, int *error) {
+	char *function_name = "mbsys_reson7k_interp_beamattitude";
+	int status = MB_SUCCESS;
+	struct mb_preprocess_struct *pars;
+	int *index;
+	double *weight;
+	double *roll, *pitch, *heave, *heading;
+	double *yd;
+	double dheading;
+	int k;
+	int j;
 
-		/* get time */
-		time_j[0] = header->s7kTime.Year;
-		time_j[1] = header->s7kTime.Day;
-		time_j[2] = 60 * header->s7kTime.Hours + header->s7kTime.Minutes;
-		time_j[3] = (int)header->s7kTime.Seconds;
-		time_j[4] = (int)(1000000 * (header->s7kTime.Seconds - time_j[3]));
-		mb_get_itime(verbose, time_j, time_i);
-		mb_get_time(verbose, time_i, &time_d[0]);
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:              %d\n", verbose);
+		fprintf(stderr, "dbg2       preprocess_pars_ptr:  %p\n", (void *)preprocess_pars_ptr);
+		fprintf(stderr, "dbg2       nbeams:               %d\n", nbeams);
+		fprintf(stderr, "dbg2       beamattitude:         %p\n", (void *)beamattitude);
+		fprintf(stderr, "dbg2       jattitude:            %d\n", *jattitude);
+		fprintf(stderr, "dbg2       jheading:             %d\n", *jheading);
+	}
 
-		*nctd = MIN(ctd->n, MB_CTD_MAX);
-		for (i = 0; i < *nctd; i++) {
-			time_d[i] = time_d[0];
-			if (ctd->sample_rate > 0.0)
-				time_d[i] += i * (1.0 / ctd->sample_rate);
-			if (ctd->conductivity_flag == 0)
-				conductivity[i] = ctd->conductivity_salinity[i];
-			else
-				salinity[i] = ctd->conductivity_salinity[i];
-			temperature[i] = ctd->temperature[i];
-			depth[i] = ctd->pressure_depth[i];
-			soundspeed[i] = ctd->sound_velocity[i];
+	/* get preprocessing parameters and scratch arrays */
+	pars = (struct mb_preprocess_struct *)preprocess_pars_ptr;
+	index = beamattitude->index;
+	weight = beamattitude->weight;
+	roll = beamattitude->roll;
+	pitch = beamattitude->pitch;
+	heave = beamattitude->heave;
+	heading = beamattitude->heading;
+	nbeams = MIN(nbeams, beamattitude->nalloc);
+
+	/* interpolate roll, pitch and heave - the times are bracketed once for
+	    the attitude series and the interpolation loops are simple enough
+	    for the compiler to vectorize */
+	if (pars->n_attitude > 0) {
+		mbsys_reson7k_interp_bracket(pars->n_attitude, pars->attitude_time_d, nbeams, beamattitude->time_d, jattitude,
+		                             index, weight);
+		k = MIN(1, pars->n_attitude - 1);
+		yd = pars->attitude_roll;
+		for (j = 0; j < nbeams; j++)
+			roll[j] = yd[index[j]] + weight[j] * (yd[index[j] + k] - yd[index[j]]);
+		yd = pars->attitude_pitch;
+		for (j = 0; j < nbeams; j++)
+			pitch[j] = yd[index[j]] + weight[j] * (yd[index[j] + k] - yd[index[j]]);
+		yd = pars->attitude_heave;
+		for (j = 0; j < nbeams; j++)
+			heave[j] = yd[index[j]] + weight[j] * (yd[index[j] + k] - yd[index[j]]);
+	}
+	else {
+		for (j = 0; j < nbeams; j++) {
+			roll[j] = 0.0;
+			pitch[j] = 0.0;
+			heave[j] = 0.0;
 		}
 	}
 
-	/* else failure */
+	/* interpolate heading, taking the shorter way around the circle as
+	    mb_linear_interp_heading() does */
+	if (pars->n_heading > 0) {
+		mbsys_reson7k_interp_bracket(pars->n_heading, pars->heading_time_d, nbeams, beamattitude->time_d, jheading, index,
+		                             weight);
+		k = MIN(1, pars->n_heading - 1);
+		yd = pars->heading_heading;
+		for (j = 0; j < nbeams; j++) {
+			dheading = yd[index[j] + k] - yd[index[j]];
+			if (dheading > 180.0)
+				dheading -= 360.0;
+			else if (dheading < -180.0)
+				dheading += 360.0;
+			heading[j] = yd[index[j]] + weight[j] * dheading;
+			if (heading[j] < 0.0)
+				heading[j] += 360.0;
+			else if (heading[j] >= 360.0)
+				heading[j] -= 360.0;
+		}
+	}
 	else {
-		*nctd = 0;
+		for (j = 0; j < nbeams; j++)
+			heading[j] = 0.0;
 	}
 
 	/* print output debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       kind:       %d\n", *kind);
+		fprintf(stderr, "dbg2       jattitude:  %d\n", *jattitude);
+		fprintf(stderr, "dbg2       jheading:   %d\n", *jheading);
+		for (j = 0; j < nbeams; j++)
+			fprintf(stderr, "dbg2       beam:%d time_d:%f roll:%f pitch:%f heave:%f heading:%f\n", j, beamattitude->time_d[j],
+			        roll[j], pitch[j], heave[j], heading[j]);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
 	}
-	if (verbose >= 2 && *error == MB_ERROR_NO_ERROR) {
-		fprintf(stderr, "dbg2       nctd:          %d\n", *nctd);
-		for (i = 0; i < *nctd; i++) {
-			fprintf(stderr, "dbg2       time_d:        %f\n", time_d[i]);
-			fprintf(stderr, "dbg2       conductivity:  %f\n", conductivity[i]);
-			fprintf(stderr, "dbg2       temperature:   %f\n", temperature[i]);
-			fprintf(stderr, "dbg2       depth:         %f\n", depth[i]);
-			fprintf(stderr, "dbg2       salinity:      %f\n", salinity[i]);
-			fprintf(stderr, "dbg2       soundspeed:    %f\n", soundspeed[i]);
-		}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_alloc_beamattitude(int verbose, s7k_beamattitude *beamattitude, int nbeams, int *error) {
+	char *function_name = "mbsys_reson7k_alloc_beamattitude";
+	int status = MB_SUCCESS;
+	double **arrays[14];
+	int narrays;
+	int i;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:       %d\n", verbose);
+		fprintf(stderr, "dbg2       beamattitude:  %p\n", (void *)beamattitude);
+		fprintf(stderr, "dbg2       nbeams:        %d\n", nbeams);
+	}
+
+	/* grow the scratch arrays if this ping has more beams than any before */
+	if (beamattitude->nalloc < nbeams) {
+		narrays = 0;
+		arrays[narrays++] = &(beamattitude->time_d);
+		arrays[narrays++] = &(beamattitude->weight);
+		arrays[narrays++] = &(beamattitude->roll);
+		arrays[narrays++] = &(beamattitude->pitch);
+		arrays[narrays++] = &(beamattitude->heave);
+		arrays[narrays++] = &(beamattitude->heading);
+		arrays[narrays++] = &(beamattitude->tx_steer);
+		arrays[narrays++] = &(beamattitude->rx_steer);
+		arrays[narrays++] = &(beamattitude->range);
+		arrays[narrays++] = &(beamattitude->azimuth);
+		arrays[narrays++] = &(beamattitude->depression);
+		arrays[narrays++] = &(beamattitude->acrosstrack);
+		arrays[narrays++] = &(beamattitude->alongtrack);
+		arrays[narrays++] = &(beamattitude->depth);
+		status = mb_reallocd(verbose, __FILE__, __LINE__, nbeams * sizeof(int), (void **)&(beamattitude->index), error);
+		if (status == MB_SUCCESS)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nbeams * sizeof(int), (void **)&(beamattitude->beamid), error);
+		for (i = 0; i < narrays && status == MB_SUCCESS; i++)
+			status = mb_reallocd(verbose, __FILE__, __LINE__, nbeams * sizeof(double), (void **)arrays[i], error);
+		if (status == MB_SUCCESS)
+			beamattitude->nalloc = nbeams;
+		else
+			beamattitude->nalloc = 0;
+	}
+
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       nalloc:     %d\n", beamattitude->nalloc);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
 	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_beam_geometry(int verbose, mb_3D_orientation tx_align, mb_3D_orientation tx_orientation,
+                                mb_3D_orientation rx_align, double reference_heading, double soundspeed, int nbeams,
+                                int nthreads, s7k_beamattitude *beamattitude, int *error) {
+	char *function_name = "mbsys_reson7k_beam_geometry";
+	int status = MB_SUCCESS;
+	struct mbsys_reson7k_geometrywork_struct work[MBSYS_RESON7K_PREPROCESS_THREADS_MAX];
+#ifdef MBSYS_RESON7K_PTHREADS
+	pthread_t threads[MBSYS_RESON7K_PREPROCESS_THREADS_MAX];
+	int nstarted;
+#endif
+	double *azimuth, *depression;
+	double rotation[3][3];
+	double croll, sroll, cpitch, spitch, cheading, sheading;
+	double tvec[3], rxvec[3], bvec[3];
+	int j, k, l;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:              %d\n", verbose);
+		fprintf(stderr, "dbg2       tx_align:             %f %f %f\n", tx_align.roll, tx_align.pitch, tx_align.heading);
+		fprintf(stderr, "dbg2       tx_orientation:       %f %f %f\n", tx_orientation.roll, tx_orientation.pitch,
+		        tx_orientation.heading);
+		fprintf(stderr, "dbg2       rx_align:             %f %f %f\n", rx_align.roll, rx_align.pitch, rx_align.heading);
+		fprintf(stderr, "dbg2       reference_heading:    %f\n", reference_heading);
+		fprintf(stderr, "dbg2       soundspeed:           %f\n", soundspeed);
+		fprintf(stderr, "dbg2       nbeams:               %d\n", nbeams);
+		fprintf(stderr, "dbg2       nthreads:             %d\n", nthreads);
+		fprintf(stderr, "dbg2       beamattitude:         %p\n", (void *)beamattitude);
+	}
+
+	/* The transmit and receive arrays lie along the vessel x (forward) and
+	    y (starboard) axes, rotated by their mounting angles and then by the
+	    vessel attitude (roll about x positive starboard down, pitch about y
+	    positive bow up, heading about z relative to the reference heading,
+	    z down). A beam steered by tx_steer and rx_steer lies on the cone
+	    about each array axis, b.t = sin(tx_steer) and b.r = sin(rx_steer),
+	    and the downward solution of the two is the beam direction. The
+	    mounting rotations and the transmit array axis are computed once per
+	    ping; only the receive array axis changes from beam to beam.
+	    This batch calculation is only used if built with
+	    MBSYS_RESON7K_BATCH_GEOMETRY - by default each beam is calculated
+	    by mb_beaudoin() as before, in the same thread slices. */
+	azimuth = beamattitude->azimuth;
+	depression = beamattitude->depression;
+	nbeams = MIN(nbeams, beamattitude->nalloc);
+
+	/* transmit array axis for the ping */
+	tvec[0] = 1.0;
+	tvec[1] = 0.0;
+	tvec[2] = 0.0;
+	for (l = 0; l < 2; l++) {
+		if (l == 0) {
+			croll = cos(DTR * tx_align.roll);
+			sroll = sin(DTR * tx_align.roll);
+			cpitch = cos(DTR * tx_align.pitch);
+			spitch = sin(DTR * tx_align.pitch);
+			cheading = cos(DTR * tx_align.heading);
+			sheading = sin(DTR * tx_align.heading);
+		}
+		else {
+			croll = cos(DTR * tx_orientation.roll);
+			sroll = sin(DTR * tx_orientation.roll);
+			cpitch = cos(DTR * tx_orientation.pitch);
+			spitch = sin(DTR * tx_orientation.pitch);
+			cheading = cos(DTR * (tx_orientation.heading - reference_heading));
+			sheading = sin(DTR * (tx_orientation.heading - reference_heading));
+		}
+		rotation[0][0] = cheading * cpitch;
+		rotation[0][1] = cheading * spitch * sroll - sheading * croll;
+		rotation[0][2] = cheading * spitch * croll + sheading * sroll;
+		rotation[1][0] = sheading * cpitch;
+		rotation[1][1] = sheading * spitch * sroll + cheading * croll;
+		rotation[1][2] = sheading * spitch * croll - cheading * sroll;
+		rotation[2][0] = -spitch;
+		rotation[2][1] = cpitch * sroll;
+		rotation[2][2] = cpitch * croll;
+		for (k = 0; k < 3; k++)
+			bvec[k] = rotation[k][0] * tvec[0] + rotation[k][1] * tvec[1] + rotation[k][2] * tvec[2];
+		for (k = 0; k < 3; k++)
+			tvec[k] = bvec[k];
+	}
+
+	/* receive array axis in the vessel frame */
+	croll = cos(DTR * rx_align.roll);
+	sroll = sin(DTR * rx_align.roll);
+	cpitch = cos(DTR * rx_align.pitch);
+	spitch = sin(DTR * rx_align.pitch);
+	cheading = cos(DTR * rx_align.heading);
+	sheading = sin(DTR * rx_align.heading);
+	rxvec[0] = cheading * spitch * sroll - sheading * croll;
+	rxvec[1] = sheading * spitch * sroll + cheading * croll;
+	rxvec[2] = cpitch * sroll;
+
+	/* calculate the beams in contiguous slices - each beam is calculated
+	    the same way whichever thread it is given to, and each thread writes
+	    only the beams of its own slice, so the results do not depend on the
+	    number of threads */
+	nthreads = MAX(1, MIN(nthreads, MBSYS_RESON7K_PREPROCESS_THREADS_MAX));
+	nthreads = MAX(1, MIN(nthreads, nbeams / MBSYS_RESON7K_PREPROCESS_THREADS_BEAMS));
+	for (l = 0; l < nthreads; l++) {
+		work[l].beamattitude = beamattitude;
+#ifdef MBSYS_RESON7K_BATCH_GEOMETRY
+		work[l].batch = MB_YES;
+#else
+		work[l].batch = MB_NO;
+#endif
+		work[l].tx_align = tx_align;
+		work[l].tx_orientation = tx_orientation;
+		work[l].rx_align = rx_align;
+		for (k = 0; k < 3; k++) {
+			work[l].tvec[k] = tvec[k];
+			work[l].rxvec[k] = rxvec[k];
+		}
+		work[l].reference_heading = reference_heading;
+		work[l].soundspeed = soundspeed;
+		work[l].jstart = (l * nbeams) / nthreads;
+		work[l].jend = ((l + 1) * nbeams) / nthreads;
+	}
+#ifdef MBSYS_RESON7K_PTHREADS
+	for (nstarted = 1; nstarted < nthreads; nstarted++) {
+		if (pthread_create(&threads[nstarted], NULL, mbsys_reson7k_beam_geometry_slice, (void *)&work[nstarted]) != 0)
+			break;
+	}
+	for (l = nstarted; l < nthreads; l++)
+		mbsys_reson7k_beam_geometry_slice((void *)&work[l]);
+	mbsys_reson7k_beam_geometry_slice((void *)&work[0]);
+	for (l = 1; l < nstarted; l++)
+		pthread_join(threads[l], NULL);
+#else
+	for (l = 0; l < nthreads; l++)
+		mbsys_reson7k_beam_geometry_slice((void *)&work[l]);
+#endif
+
+	/* print output debug statements */
 	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		for (j = 0; j < nbeams; j++)
+			fprintf(stderr, "dbg2       beam:%d azimuth:%f depression:%f acrosstrack:%f alongtrack:%f depth:%f\n", j,
+			        azimuth[j], depression[j], beamattitude->acrosstrack[j], beamattitude->alongtrack[j],
+			        beamattitude->depth[j]);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:     %d\n", status);
@@ -9462,84 +15854,151 @@ int mbsys_reson7k_ctd(int verbose, void *mbio_ptr, void *store_ptr, int *kind, i
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_ancilliarysensor(int verbose, void *mbio_ptr, void *store_ptr, int *kind, int *nsamples, double *time_d,
-                                   double *sensor1, double *sensor2, double *sensor3, double *sensor4, double *sensor5,
-                                   double *sensor6, double *sensor7, double *sensor8, int *error) {
-	char *function_name = "mbsys_reson7k_ancilliarysensor";
-	struct mb_io_struct *mb_io_ptr;
-	struct mbsys_reson7k_struct *store;
-	s7k_header *header;
-	s7kr_bluefin *bluefin;
-	s7k_bluefin_environmental *environmental;
+void *mbsys_reson7k_beam_geometry_slice(void *work_ptr) {
+	struct mbsys_reson7k_geometrywork_struct *work;
+	s7k_beamattitude *beamattitude;
+	mb_3D_orientation rx_orientation;
+	double beamAzimuth, beamDepression;
+	double croll, sroll, cpitch, spitch, cheading, sheading;
+	double *tvec, *rxvec;
+	double rvec[3], nvec[3], bvec[3];
+	double asteer, csteer, dot, den, alpha, beta, gamma;
+	double rr;
+	int error = MB_ERROR_NO_ERROR;
+	int j;
+
+	work = (struct mbsys_reson7k_geometrywork_struct *)work_ptr;
+	beamattitude = work->beamattitude;
+	tvec = work->tvec;
+	rxvec = work->rxvec;
+
+	/* calculate beam angles for raytracing using Jon Beaudoin's code - the
+	    transmit orientation is that of the ping and the receive orientation
+	    that at the bottom return time of each beam */
+	for (j = work->jstart; j < work->jend && work->batch == MB_NO; j++) {
+		rx_orientation.roll = beamattitude->roll[j];
+		rx_orientation.pitch = beamattitude->pitch[j];
+		rx_orientation.heading = beamattitude->heading[j];
+		mb_beaudoin(0, work->tx_align, work->tx_orientation, beamattitude->tx_steer[j], work->rx_align, rx_orientation,
+		            beamattitude->rx_steer[j], work->reference_heading, &beamAzimuth, &beamDepression, &error);
+		beamattitude->depression[j] = beamDepression;
+		beamattitude->azimuth[j] = beamAzimuth;
+		rr = 0.5 * work->soundspeed * beamattitude->range[j];
+		beamattitude->acrosstrack[j] = rr * cos(DTR * beamDepression) * sin(DTR * beamAzimuth);
+		beamattitude->alongtrack[j] = rr * cos(DTR * beamDepression) * cos(DTR * beamAzimuth);
+		beamattitude->depth[j] = rr * sin(DTR * beamDepression);
+	}
+
+	/* otherwise loop over the beams of this slice with the batch kernel */
+	for (j = work->jstart; j < work->jend && work->batch == MB_YES; j++) {
+		/* receive array axis at the bottom return time of this beam */
+		croll = cos(DTR * beamattitude->roll[j]);
+		sroll = sin(DTR * beamattitude->roll[j]);
+		cpitch = cos(DTR * beamattitude->pitch[j]);
+		spitch = sin(DTR * beamattitude->pitch[j]);
+		cheading = cos(DTR * (beamattitude->heading[j] - work->reference_heading));
+		sheading = sin(DTR * (beamattitude->heading[j] - work->reference_heading));
+		rvec[0] = cheading * cpitch * rxvec[0] + (cheading * spitch * sroll - sheading * croll) * rxvec[1]
+		          + (cheading * spitch * croll + sheading * sroll) * rxvec[2];
+		rvec[1] = sheading * cpitch * rxvec[0] + (sheading * spitch * sroll + cheading * croll) * rxvec[1]
+		          + (sheading * spitch * croll - cheading * sroll) * rxvec[2];
+		rvec[2] = -spitch * rxvec[0] + cpitch * sroll * rxvec[1] + cpitch * croll * rxvec[2];
+
+		/* intersection of the transmit and receive cones */
+		asteer = sin(DTR * beamattitude->tx_steer[j]);
+		csteer = sin(DTR * beamattitude->rx_steer[j]);
+		dot = tvec[0] * rvec[0] + tvec[1] * rvec[1] + tvec[2] * rvec[2];
+		den = MAX(1.0 - dot * dot, 1.0e-12);
+		alpha = (asteer - csteer * dot) / den;
+		beta = (csteer - asteer * dot) / den;
+		nvec[0] = tvec[1] * rvec[2] - tvec[2] * rvec[1];
+		nvec[1] = tvec[2] * rvec[0] - tvec[0] * rvec[2];
+		nvec[2] = tvec[0] * rvec[1] - tvec[1] * rvec[0];
+		gamma = sqrt(MAX(0.0, (1.0 - alpha * alpha - beta * beta - 2.0 * alpha * beta * dot) / den));
+		if (nvec[2] < 0.0)
+			gamma = -gamma;
+		bvec[0] = alpha * tvec[0] + beta * rvec[0] + gamma * nvec[0];
+		bvec[1] = alpha * tvec[1] + beta * rvec[1] + gamma * nvec[1];
+		bvec[2] = alpha * tvec[2] + beta * rvec[2] + gamma * nvec[2];
+
+		/* beam angles and position relative to the sonar */
+		beamattitude->depression[j] = RTD * asin(MAX(-1.0, MIN(1.0, bvec[2])));
+		beamattitude->azimuth[j] = RTD * atan2(bvec[1], bvec[0]);
+		rr = 0.5 * work->soundspeed * beamattitude->range[j];
+		beamattitude->acrosstrack[j] = rr * bvec[1];
+		beamattitude->alongtrack[j] = rr * bvec[0];
+		beamattitude->depth[j] = rr * bvec[2];
+	}
+
+	return (NULL);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_beam_geometry_check(int verbose, mb_3D_orientation tx_align, mb_3D_orientation tx_orientation,
+                                      mb_3D_orientation rx_align, double reference_heading, int nbeams,
+                                      s7k_beamattitude *beamattitude, int *mismatch, double *diffmax, int *error) {
+	char *function_name = "mbsys_reson7k_beam_geometry_check";
 	int status = MB_SUCCESS;
-	int i;
+	mb_3D_orientation rx_orientation;
+	double beamAzimuth, beamDepression;
+	double bvec[3];
+	double diff;
+	int check[3];
+	int ncheck;
+	int j, l;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
-		fprintf(stderr, "dbg2       mb_ptr:     %p\n", (void *)mbio_ptr);
-		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
-	}
-
-	/* get mbio descriptor */
-	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
-
-	/* get pointer to raw data structure */
-	store = (struct mbsys_reson7k_struct *)store_ptr;
-
-	/* get data kind */
-	*kind = store->kind;
-
-	/* extract ctd data from bluefin environmental SSV record */
-	if (*kind == MB_DATA_SSV) {
-		bluefin = &(store->bluefin);
-		header = &(bluefin->header);
-
-		*nsamples = 0;
-		for (i = 0; i < bluefin->number_frames; i++) {
-			environmental = &(bluefin->environmental[i]);
-			time_d[*nsamples] = environmental->sensor_time_sec + 0.000000001 * environmental->sensor_time_nsec;
-			sensor1[*nsamples] = -5.0 + ((double)environmental->sensor1) / 6553.6;
-			sensor2[*nsamples] = -5.0 + ((double)environmental->sensor2) / 6553.6;
-			sensor3[*nsamples] = -5.0 + ((double)environmental->sensor3) / 6553.6;
-			sensor4[*nsamples] = -5.0 + ((double)environmental->sensor4) / 6553.6;
-			sensor5[*nsamples] = -5.0 + ((double)environmental->sensor5) / 6553.6;
-			sensor6[*nsamples] = -5.0 + ((double)environmental->sensor6) / 6553.6;
-			sensor7[*nsamples] = -5.0 + ((double)environmental->sensor7) / 6553.6;
-			sensor8[*nsamples] = -5.0 + ((double)environmental->sensor8) / 6553.6;
-			(*nsamples)++;
-		}
-	}
-
-	/* else failure */
-	else {
-		*nsamples = 0;
+		fprintf(stderr, "dbg2       verbose:              %d\n", verbose);
+		fprintf(stderr, "dbg2       tx_align:             %f %f %f\n", tx_align.roll, tx_align.pitch, tx_align.heading);
+		fprintf(stderr, "dbg2       tx_orientation:       %f %f %f\n", tx_orientation.roll, tx_orientation.pitch,
+		        tx_orientation.heading);
+		fprintf(stderr, "dbg2       rx_align:             %f %f %f\n", rx_align.roll, rx_align.pitch, rx_align.heading);
+		fprintf(stderr, "dbg2       reference_heading:    %f\n", reference_heading);
+		fprintf(stderr, "dbg2       nbeams:               %d\n", nbeams);
+		fprintf(stderr, "dbg2       beamattitude:         %p\n", (void *)beamattitude);
+	}
+
+	/* compare the beam directions calculated by mbsys_reson7k_beam_geometry()
+	    with those of mb_beaudoin() for the first, centre and last beams - the
+	    outer beams are the most steered and the centre beam the least */
+	*mismatch = MB_NO;
+	*diffmax = 0.0;
+	nbeams = MIN(nbeams, beamattitude->nalloc);
+	ncheck = 0;
+	if (nbeams > 0) {
+		check[ncheck++] = 0;
+		if (nbeams > 2)
+			check[ncheck++] = nbeams / 2;
+		if (nbeams > 1)
+			check[ncheck++] = nbeams - 1;
+	}
+	for (l = 0; l < ncheck && status == MB_SUCCESS; l++) {
+		j = check[l];
+		rx_orientation.roll = beamattitude->roll[j];
+		rx_orientation.pitch = beamattitude->pitch[j];
+		rx_orientation.heading = beamattitude->heading[j];
+		status = mb_beaudoin(verbose, tx_align, tx_orientation, beamattitude->tx_steer[j], rx_align, rx_orientation,
+		                     beamattitude->rx_steer[j], reference_heading, &beamAzimuth, &beamDepression, error);
+		bvec[0] = cos(DTR * beamDepression) * cos(DTR * beamAzimuth)
+		          - cos(DTR * beamattitude->depression[j]) * cos(DTR * beamattitude->azimuth[j]);
+		bvec[1] = cos(DTR * beamDepression) * sin(DTR * beamAzimuth)
+		          - cos(DTR * beamattitude->depression[j]) * sin(DTR * beamattitude->azimuth[j]);
+		bvec[2] = sin(DTR * beamDepression) - sin(DTR * beamattitude->depression[j]);
+		diff = RTD * sqrt(bvec[0] * bvec[0] + bvec[1] * bvec[1] + bvec[2] * bvec[2]);
+		*diffmax = MAX(diff, *diffmax);
+		if (diff > MBSYS_RESON7K_BEAUDOIN_TOLERANCE)
+			*mismatch = MB_YES;
 	}
 
 	/* print output debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
 		fprintf(stderr, "dbg2  Return values:\n");
-		fprintf(stderr, "dbg2       kind:       %d\n", *kind);
-	}
-	if (verbose >= 2 && *error == MB_ERROR_NO_ERROR) {
-		fprintf(stderr, "dbg2       nsamples:   %d\n", *nsamples);
-		for (i = 0; i < *nsamples; i++) {
-			fprintf(stderr, "dbg2       time_d:        %f\n", time_d[i]);
-			fprintf(stderr, "dbg2       sensor1:       %f\n", sensor1[i]);
-			fprintf(stderr, "dbg2       sensor2:       %f\n", sensor2[i]);
-			fprintf(stderr, "dbg2       sensor3:       %f\n", sensor3[i]);
-			fprintf(stderr, "dbg2       sensor4:       %f\n", sensor4[i]);
-			fprintf(stderr, "dbg2       sensor5:       %f\n", sensor5[i]);
-			fprintf(stderr, "dbg2       sensor6:       %f\n", sensor6[i]);
-			fprintf(stderr, "dbg2       sensor7:       %f\n", sensor7[i]);
-			fprintf(stderr, "dbg2       sensor8:       %f\n", sensor8[i]);
-		}
-	}
-	if (verbose >= 2) {
+		fprintf(stderr, "dbg2       mismatch:   %d\n", *mismatch);
+		fprintf(stderr, "dbg2       diffmax:    %g\n", *diffmax);
 		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
 		fprintf(stderr, "dbg2       status:     %d\n", status);
@@ -9549,28 +16008,11 @@ int mbsys_reson7k_ancilliarysensor(int verbose, void *mbio_ptr, void *store_ptr,
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_copy(int verbose, void *mbio_ptr, void *store_ptr, void *copy_ptr, int *error) {
-	char *function_name = "mbsys_reson7k_copy";
+int mbsys_reson7k_set_preprocessthreads(int verbose, void *mbio_ptr, int nthreads, int *error) {
+	char *function_name = "mbsys_reson7k_set_preprocessthreads";
 	int status = MB_SUCCESS;
 	struct mb_io_struct *mb_io_ptr;
 	struct mbsys_reson7k_struct *store;
-	struct mbsys_reson7k_struct *copy;
-	s7kr_attitude *attitude;
-	s7kr_motion *motion;
-	s7kr_svp *svp;
-	s7kr_ctd *ctd;
-	s7kr_fsdwss *fsdwsslo;
-	s7kr_fsdwss *fsdwsshi;
-	s7kr_fsdwsb *fsdwsb;
-	s7kr_configuration *configuration;
-	s7kr_backscatter *backscatter;
-	s7kr_beam *beam;
-	s7kr_tvg *tvg;
-	s7kr_image *image;
-	s7kr_systemeventmessage *systemeventmessage;
-	int nalloc;
-	char *charptr, *copycharptr;
-	int i, j;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
@@ -9579,433 +16021,218 @@ int mbsys_reson7k_copy(int verbose, void *mbio_ptr, void *store_ptr, void *copy_
 		fprintf(stderr, "dbg2  Input arguments:\n");
 		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
 		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
-		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
-		fprintf(stderr, "dbg2       copy_ptr:   %p\n", (void *)copy_ptr);
+		fprintf(stderr, "dbg2       nthreads:   %d\n", nthreads);
 	}
 
-	/* get mbio descriptor */
+	/* get mbio descriptor - the setting belongs to the file being preprocessed */
 	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+	store = (struct mbsys_reson7k_struct *)mb_io_ptr->store_data;
 
-	/* get data structure pointers */
-	store = (struct mbsys_reson7k_struct *)store_ptr;
-	copy = (struct mbsys_reson7k_struct *)copy_ptr;
-
-	/* copy over structures, allocating memory where necessary */
-
-	/* Type of data record */
-	copy->kind = store->kind; /* MB-System record ID */
-	copy->type = store->type; /* Reson record ID */
-
-	/* MB-System time stamp */
-	copy->time_d = store->time_d;
-	for (i = 0; i < 7; i++)
-		copy->time_i[i] = store->time_i[i];
-
-	/* Reference point information (record 1000) */
-	/*  Note: these offsets should be zero for submersible vehicles */
-	copy->reference = store->reference;
-
-	/* Sensor uncalibrated offset position information (record 1001) */
-	copy->sensoruncal = store->sensoruncal;
-
-	/* Sensor calibrated offset position information (record 1002) */
-	copy->sensorcal = store->sensorcal;
-
-	/* Position (record 1003) */
-	copy->position = store->position;
-
-	/* Attitude (record 1004) */
-	attitude = &copy->attitude;
-	copy->attitude = store->attitude;
-	copy->attitude.nalloc = attitude->nalloc;
-	copy->attitude.pitch = attitude->pitch;
-	copy->attitude.roll = attitude->roll;
-	copy->attitude.heading = attitude->heading;
-	copy->attitude.heave = attitude->heave;
-	if (status == MB_SUCCESS && copy->attitude.nalloc < copy->attitude.n * sizeof(float)) {
-		copy->attitude.nalloc = copy->attitude.n * sizeof(float);
-		if (status == MB_SUCCESS)
-			status = mb_reallocd(verbose, __FILE__, __LINE__, copy->attitude.nalloc, (void **)&(copy->attitude.pitch), error);
-		if (status == MB_SUCCESS)
-			status = mb_reallocd(verbose, __FILE__, __LINE__, copy->attitude.nalloc, (void **)&(copy->attitude.roll), error);
-		if (status == MB_SUCCESS)
-			status = mb_reallocd(verbose, __FILE__, __LINE__, copy->attitude.nalloc, (void **)&(copy->attitude.heading), error);
-		if (status == MB_SUCCESS)
-			status = mb_reallocd(verbose, __FILE__, __LINE__, copy->attitude.nalloc, (void **)&(copy->attitude.heave), error);
-		if (status != MB_SUCCESS) {
-			copy->attitude.n = 0;
-			copy->attitude.nalloc = 0;
-		}
-	}
-	if (status == MB_SUCCESS) {
-		for (i = 0; i < copy->attitude.n; i++) {
-			copy->attitude.pitch[i] = store->attitude.pitch[i];
-			copy->attitude.roll[i] = store->attitude.roll[i];
-			copy->attitude.heading[i] = store->attitude.heading[i];
-			copy->attitude.heave[i] = store->attitude.heave[i];
-		}
-	}
-
-	/* Tide (record 1005) */
-	copy->tide = store->tide;
-
-	/* Altitude (record 1006) */
-	copy->altitude = store->altitude;
-
-	/* Motion over ground (record 1007) */
-	motion = &copy->motion;
-	copy->motion = store->motion;
-	copy->motion.nalloc = motion->nalloc;
-	copy->motion.x = motion->x;
-	copy->motion.y = motion->y;
-	copy->motion.z = motion->z;
-	copy->motion.xa = motion->xa;
-	copy->motion.ya = motion->ya;
-	copy->motion.za = motion->za;
-	if (status == MB_SUCCESS && copy->motion.nalloc < copy->motion.n * sizeof(float)) {
-		copy->motion.nalloc = copy->motion.n * sizeof(float);
-		if (status == MB_SUCCESS)
-			status = mb_reallocd(verbose, __FILE__, __LINE__, copy->motion.nalloc, (void **)&(copy->motion.x), error);
-		if (status == MB_SUCCESS)
-			status = mb_reallocd(verbose, __FILE__, __LINE__, copy->motion.nalloc, (void **)&(copy->motion.y), error);
-		if (status == MB_SUCCESS)
-			status = mb_reallocd(verbose, __FILE__, __LINE__, copy->motion.nalloc, (void **)&(copy->motion.z), error);
-		if (status == MB_SUCCESS)
-			status = mb_reallocd(verbose, __FILE__, __LINE__, copy->motion.nalloc, (void **)&(copy->motion.xa), error);
-		if (status == MB_SUCCESS)
-			status = mb_reallocd(verbose, __FILE__, __LINE__, copy->motion.nalloc, (void **)&(copy->motion.ya), error);
-		if (status == MB_SUCCESS)
-			status = mb_reallocd(verbose, __FILE__, __LINE__, copy->motion.nalloc, (void **)&(copy->motion.za), error);
-		if (status != MB_SUCCESS) {
-			copy->motion.n = 0;
-			copy->motion.nalloc = 0;
-		}
-	}
-	if (status == MB_SUCCESS) {
-		for (i = 0; i < copy->motion.n; i++) {
-			copy->motion.x[i] = store->motion.x[i];
-			copy->motion.y[i] = store->motion.y[i];
-			copy->motion.z[i] = store->motion.z[i];
-			copy->motion.xa[i] = store->motion.xa[i];
-			copy->motion.ya[i] = store->motion.ya[i];
-			copy->motion.za[i] = store->motion.za[i];
-		}
-	}
-
-	/* Depth (record 1008) */
-	copy->depth = store->depth;
-
-	/* Sound velocity profile (record 1009) */
-	svp = &copy->svp;
-	copy->svp = store->svp;
-	copy->svp.nalloc = svp->nalloc;
-	copy->svp.depth = svp->depth;
-	copy->svp.sound_velocity = svp->sound_velocity;
-	if (status == MB_SUCCESS && copy->svp.nalloc < copy->svp.n * sizeof(float)) {
-		copy->svp.nalloc = copy->svp.n * sizeof(float);
-		if (status == MB_SUCCESS)
-			status = mb_reallocd(verbose, __FILE__, __LINE__, copy->svp.nalloc, (void **)&(copy->svp.depth), error);
-		if (status == MB_SUCCESS)
-			status = mb_reallocd(verbose, __FILE__, __LINE__, copy->svp.nalloc, (void **)&(copy->svp.sound_velocity), error);
-		if (status != MB_SUCCESS) {
-			copy->svp.n = 0;
-			copy->svp.nalloc = 0;
-		}
-	}
-	if (status == MB_SUCCESS) {
-		for (i = 0; i < copy->svp.n; i++) {
-			copy->svp.depth[i] = store->svp.depth[i];
-			copy->svp.sound_velocity[i] = store->svp.sound_velocity[i];
-		}
-	}
-
-	/* CTD (record 1010) */
-	ctd = &copy->ctd;
-	copy->ctd = store->ctd;
-	copy->ctd.nalloc = ctd->nalloc;
-	copy->ctd.conductivity_salinity = ctd->conductivity_salinity;
-	copy->ctd.temperature = ctd->temperature;
-	copy->ctd.pressure_depth = ctd->pressure_depth;
-	copy->ctd.sound_velocity = ctd->sound_velocity;
-	copy->ctd.absorption = ctd->absorption;
-	if (status == MB_SUCCESS && copy->ctd.nalloc < copy->ctd.n * sizeof(float)) {
-		copy->ctd.nalloc = copy->ctd.n * sizeof(float);
-		if (status == MB_SUCCESS)
-			status =
-			    mb_reallocd(verbose, __FILE__, __LINE__, copy->ctd.nalloc, (void **)&(copy->ctd.conductivity_salinity), error);
-		if (status == MB_SUCCESS)
-			status = mb_reallocd(verbose, __FILE__, __LINE__, copy->ctd.nalloc, (void **)&(copy->ctd.temperature), error);
-		if (status == MB_SUCCESS)
-			status = mb_reallocd(verbose, __FILE__, __LINE__, copy->ctd.nalloc, (void **)&(copy->ctd.pressure_depth), error);
-		if (status == MB_SUCCESS)
-			status = mb_reallocd(verbose, __FILE__, __LINE__, copy->ctd.nalloc, (void **)&(copy->ctd.sound_velocity), error);
-		if (status == MB_SUCCESS)
-			status = mb_reallocd(verbose, __FILE__, __LINE__, copy->ctd.nalloc, (void **)&(copy->ctd.absorption), error);
-		if (status != MB_SUCCESS) {
-			copy->ctd.n = 0;
-			copy->ctd.nalloc = 0;
-		}
-	}
-	if (status == MB_SUCCESS) {
-		for (i = 0; i < copy->ctd.n; i++) {
-			copy->ctd.conductivity_salinity[i] = store->ctd.conductivity_salinity[i];
-			copy->ctd.temperature[i] = store->ctd.temperature[i];
-			copy->ctd.pressure_depth[i] = store->ctd.pressure_depth[i];
-			copy->ctd.sound_velocity[i] = store->ctd.sound_velocity[i];
-			copy->ctd.absorption[i] = store->ctd.absorption[i];
-		}
-	}
-
-	/* Geodesy (record 1011) */
-	copy->geodesy = store->geodesy;
-
-	/* Edgetech FS-DW low frequency sidescan (record 3000) */
-	fsdwsslo = &copy->fsdwsslo;
-	copy->fsdwsslo = store->fsdwsslo;
-	for (j = 0; j < 2; j++) {
-		copy->fsdwsslo.channel[j].data_alloc = fsdwsslo->channel[j].data_alloc;
-		copy->fsdwsslo.channel[j].data = fsdwsslo->channel[j].data;
-		if (status == MB_SUCCESS && copy->fsdwsslo.channel[j].data_alloc <
-		                                copy->fsdwsslo.channel[j].number_samples * copy->fsdwsslo.channel[j].bytespersample) {
-			copy->fsdwsslo.channel[j].data_alloc =
-			    copy->fsdwsslo.channel[j].number_samples * copy->fsdwsslo.channel[j].bytespersample;
-			if (status == MB_SUCCESS)
-				status = mb_reallocd(verbose, __FILE__, __LINE__, store->fsdwsslo.channel[j].data_alloc,
-				                     (void **)&(copy->fsdwsslo.channel[j].data), error);
-			if (status != MB_SUCCESS) {
-				copy->fsdwsslo.channel[j].data_alloc = 0;
-				copy->fsdwsslo.channel[j].number_samples = 0;
-			}
-		}
-		if (status == MB_SUCCESS) {
-			for (i = 0; i < copy->fsdwsslo.channel[j].data_alloc; i++) {
-				copy->fsdwsslo.channel[j].data[i] = store->fsdwsslo.channel[j].data[i];
-			}
-		}
-	}
-
-	/* Edgetech FS-DW high frequency sidescan (record 3000) */
-	fsdwsshi = &copy->fsdwsshi;
-	copy->fsdwsshi = store->fsdwsshi;
-	for (j = 0; j < 2; j++) {
-		copy->fsdwsshi.channel[j].data_alloc = fsdwsshi->channel[j].data_alloc;
-		copy->fsdwsshi.channel[j].data = fsdwsshi->channel[j].data;
-		if (status == MB_SUCCESS && copy->fsdwsshi.channel[j].data_alloc <
-		                                copy->fsdwsshi.channel[j].number_samples * copy->fsdwsshi.channel[j].bytespersample) {
-			copy->fsdwsshi.channel[j].data_alloc =
-			    copy->fsdwsshi.channel[j].number_samples * copy->fsdwsshi.channel[j].bytespersample;
-			if (status == MB_SUCCESS)
-				status = mb_reallocd(verbose, __FILE__, __LINE__, store->fsdwsshi.channel[j].data_alloc,
-				                     (void **)&(copy->fsdwsshi.channel[j].data), error);
-			if (status != MB_SUCCESS) {
-				copy->fsdwsshi.channel[j].data_alloc = 0;
-				copy->fsdwsshi.channel[j].number_samples = 0;
-			}
-		}
-		if (status == MB_SUCCESS) {
-			for (i = 0; i < copy->fsdwsshi.channel[j].data_alloc; i++) {
-				copy->fsdwsshi.channel[j].data[i] = store->fsdwsshi.channel[j].data[i];
-			}
-		}
-	}
+	/* the threads are only used if built with MBSYS_RESON7K_PTHREADS */
+	store->preprocess_threads = MAX(1, MIN(nthreads, MBSYS_RESON7K_PREPROCESS_THREADS_MAX));
+	*error = MB_ERROR_NO_ERROR;
 
-	/* Edgetech FS-DW subbottom (record 3001) */
-	fsdwsb = &copy->fsdwsb;
-	copy->fsdwsb = store->fsdwsb;
-	copy->fsdwsb.channel.data_alloc = fsdwsb->channel.data_alloc;
-	copy->fsdwsb.channel.data = fsdwsb->channel.data;
-	if (status == MB_SUCCESS &&
-	    copy->fsdwsb.channel.data_alloc < copy->fsdwsb.channel.number_samples * copy->fsdwsb.channel.bytespersample) {
-		copy->fsdwsb.channel.data_alloc = copy->fsdwsb.channel.number_samples * copy->fsdwsb.channel.bytespersample;
-		if (status == MB_SUCCESS)
-			status = mb_reallocd(verbose, __FILE__, __LINE__, store->fsdwsb.channel.data_alloc,
-			                     (void **)&(copy->fsdwsb.channel.data), error);
-		if (status != MB_SUCCESS) {
-			copy->fsdwsb.channel.data_alloc = 0;
-			copy->fsdwsb.channel.number_samples = 0;
-		}
-	}
-	if (status == MB_SUCCESS) {
-		for (i = 0; i < copy->fsdwsb.channel.data_alloc; i++) {
-			copy->fsdwsb.channel.data[i] = store->fsdwsb.channel.data[i];
-		}
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
 	}
 
-	/* Bluefin Environmental Data Frame (can be included in record 3100) */
-	copy->bluefin = store->bluefin;
-
-	/* Reson 7k volatile sonar settings (record 7000) */
-	copy->volatilesettings = store->volatilesettings;
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_raytable_update(int verbose, s7k_raytable *raytable, s7kr_svp *svp, double soundspeed, double draft,
+                                  int *error) {
+	char *function_name = "mbsys_reson7k_raytable_update";
+	int status = MB_SUCCESS;
+	u32 hash;
+	unsigned char *bytes;
+	double zlast, clast, z, c, cmean;
+	double p, sinangle, cosangle, ds;
+	int nlayer, nalloc;
+	int i, k, l;
 
-	/* Reson 7k configuration (record 7001) */
-	configuration = &copy->configuration;
-	copy->configuration = store->configuration;
-	for (j = 0; j < MBSYS_RESON7K_MAX_DEVICE; j++) {
-		copy->configuration.device[j].info_alloc = configuration->device[j].info_alloc;
-		copy->configuration.device[j].info = configuration->device[j].info;
-		if (status == MB_SUCCESS && copy->configuration.device[j].info_alloc < copy->configuration.device[j].info_length) {
-			copy->configuration.device[j].info_alloc = copy->configuration.device[j].info_length;
-			if (status == MB_SUCCESS)
-				status = mb_reallocd(verbose, __FILE__, __LINE__, copy->configuration.device[j].info_alloc,
-				                     (void **)&(copy->configuration.device[j].info), error);
-			if (status != MB_SUCCESS) {
-				copy->configuration.device[j].info_alloc = 0;
-				copy->configuration.device[j].info_length = 0;
-			}
-		}
-		if (status == MB_SUCCESS) {
-			for (i = 0; i < copy->configuration.device[j].info_length; i++) {
-				copy->configuration.device[j].info[i] = store->configuration.device[j].info[i];
-			}
-		}
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       raytable:   %p\n", (void *)raytable);
+		fprintf(stderr, "dbg2       svp:        %p\n", (void *)svp);
+		fprintf(stderr, "dbg2       svp->n:     %d\n", svp->n);
+		fprintf(stderr, "dbg2       soundspeed: %f\n", soundspeed);
+		fprintf(stderr, "dbg2       draft:      %f\n", draft);
 	}
 
-	/* Reson 7k beam geometry (record 7004) */
-	copy->beamgeometry = store->beamgeometry;
-
-	/* Reson 7k calibration (record 7005) */
-	copy->calibration = store->calibration;
-
-	/* Reson 7k bathymetry (record 7006) */
-	copy->bathymetry = store->bathymetry;
-
-	/* Reson 7k backscatter imagery data (record 7007) */
-	backscatter = &copy->backscatter;
-	copy->backscatter = store->backscatter;
-	copy->backscatter.nalloc = backscatter->nalloc;
-	copy->backscatter.port_data = backscatter->port_data;
-	copy->backscatter.stbd_data = backscatter->stbd_data;
-	if (status == MB_SUCCESS && copy->backscatter.nalloc < copy->backscatter.number_samples * copy->backscatter.sample_size) {
-		copy->backscatter.nalloc = copy->backscatter.number_samples * copy->backscatter.sample_size;
-		if (status == MB_SUCCESS)
-			status = mb_reallocd(verbose, __FILE__, __LINE__, copy->backscatter.nalloc, (void **)&(copy->backscatter.port_data),
-			                     error);
-		if (status == MB_SUCCESS)
-			status = mb_reallocd(verbose, __FILE__, __LINE__, copy->backscatter.nalloc, (void **)&(copy->backscatter.stbd_data),
+	/* hash the profile (FNV-1a) */
+	hash = 2166136261u;
+	bytes = (unsigned char *)svp->depth;
+	for (i = 0; i < (int)(svp->n * sizeof(f32)); i++)
+		hash = (hash ^ bytes[i]) * 16777619u;
+	bytes = (unsigned char *)svp->sound_velocity;
+	for (i = 0; i < (int)(svp->n * sizeof(f32)); i++)
+		hash = (hash ^ bytes[i]) * 16777619u;
+
+	/* rebuild the table only if the profile, transducer depth or sound
+	    speed at the transducer have changed */
+	if (raytable->valid == MB_NO || raytable->svp_hash != hash || raytable->svp_n != (int)svp->n
+	    || fabs(raytable->draft - draft) > MBSYS_RESON7K_RAYTABLE_DRAFTTOLERANCE
+	    || fabs(raytable->soundspeed - soundspeed) > MBSYS_RESON7K_RAYTABLE_SOUNDSPEEDTOLERANCE) {
+		raytable->valid = MB_NO;
+		raytable->svp_hash = hash;
+		raytable->svp_n = svp->n;
+		raytable->soundspeed = soundspeed;
+		raytable->draft = draft;
+
+		/* allocate a boundary for the transducer and for each profile sample */
+		raytable->nangle = MBSYS_RESON7K_RAYTABLE_NANGLE;
+		nalloc = raytable->nangle * (svp->n + 1);
+		if (raytable->nalloc < nalloc) {
+			status = mb_reallocd(verbose, __FILE__, __LINE__, raytable->nangle * sizeof(int), (void **)&(raytable->nvalid),
 			                     error);
-		if (status != MB_SUCCESS) {
-			copy->backscatter.nalloc = 0;
-			copy->backscatter.number_samples = 0;
-		}
-	}
-	if (status == MB_SUCCESS) {
-		for (i = 0; i < copy->backscatter.number_samples; i++) {
-			copy->backscatter.port_data[i] = store->backscatter.port_data[i];
-			copy->backscatter.stbd_data[i] = store->backscatter.stbd_data[i];
-		}
-	}
-
-	/* Reson 7k beam data (record 7008) */
-	beam = &copy->beam;
-	copy->beam = store->beam;
-	for (i = 0; i < MBSYS_RESON7K_MAX_RECEIVERS; i++) {
-		copy->beam.snippets[i].nalloc_amp = beam->snippets[i].nalloc_amp;
-		copy->beam.snippets[i].nalloc_phase = beam->snippets[i].nalloc_phase;
-		copy->beam.snippets[i].amplitude = beam->snippets[i].amplitude;
-		copy->beam.snippets[i].phase = beam->snippets[i].phase;
-		if (status == MB_SUCCESS && (copy->beam.snippets[i].nalloc_amp < store->beam.snippets[i].nalloc_amp ||
-		                             copy->beam.snippets[i].nalloc_phase < store->beam.snippets[i].nalloc_phase)) {
-			copy->beam.snippets[i].nalloc_amp = store->beam.snippets[i].nalloc_amp;
 			if (status == MB_SUCCESS)
-				status = mb_reallocd(verbose, __FILE__, __LINE__, copy->beam.snippets[i].nalloc_amp,
-				                     (void **)&(copy->beam.snippets[i].amplitude), error);
-			copy->beam.snippets[i].nalloc_phase = store->beam.snippets[i].nalloc_phase;
+				status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(double), (void **)&(raytable->time), error);
+			if (status == MB_SUCCESS)
+				status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(double), (void **)&(raytable->xx), error);
 			if (status == MB_SUCCESS)
-				status = mb_reallocd(verbose, __FILE__, __LINE__, copy->beam.snippets[i].nalloc_phase,
-				                     (void **)&(copy->beam.snippets[i].phase), error);
-			if (status != MB_SUCCESS) {
-				copy->beam.snippets[i].nalloc_amp = 0;
-				copy->beam.snippets[i].nalloc_phase = 0;
-				copy->beam.snippets[i].end_sample = 0;
-				copy->beam.snippets[i].begin_sample = 0;
-			}
+				status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(double), (void **)&(raytable->zz), error);
+			if (status == MB_SUCCESS)
+				status = mb_reallocd(verbose, __FILE__, __LINE__, nalloc * sizeof(double), (void **)&(raytable->speed), error);
+			if (status == MB_SUCCESS)
+				raytable->nalloc = nalloc;
+			else
+				raytable->nalloc = 0;
 		}
+
+		/* trace a ray for each takeoff angle through layers of constant
+		    sound speed between the transducer and each profile sample below
+		    it - the ray parameter is set by the sound speed at the transducer */
 		if (status == MB_SUCCESS) {
-			copycharptr = (char *)(copy->beam.snippets[i].amplitude);
-			charptr = (char *)(store->beam.snippets[i].amplitude);
-			for (j = 0; j < copy->beam.snippets[i].nalloc_amp; j++)
-				copycharptr[j] = charptr[j];
-			copycharptr = (char *)(copy->beam.snippets[i].phase);
-			charptr = (char *)(store->beam.snippets[i].phase);
-			for (j = 0; j < copy->beam.snippets[i].nalloc_phase; j++)
-				copycharptr[j] = charptr[j];
+			raytable->nlayer = svp->n + 1;
+			for (k = 0; k < raytable->nangle; k++) {
+				l = k * raytable->nlayer;
+				p = sin(DTR * 90.0 * k / (raytable->nangle - 1)) / soundspeed;
+				raytable->time[l] = 0.0;
+				raytable->xx[l] = 0.0;
+				raytable->zz[l] = 0.0;
+				raytable->speed[l] = soundspeed;
+				nlayer = 1;
+				zlast = draft;
+				clast = soundspeed;
+				for (i = 0; i < (int)svp->n; i++) {
+					z = svp->depth[i];
+					c = svp->sound_velocity[i];
+					if (z <= zlast || c <= 0.0)
+						continue;
+					cmean = 0.5 * (clast + c);
+					sinangle = p * cmean;
+					if (sinangle >= 1.0)
+						break;
+					cosangle = sqrt(1.0 - sinangle * sinangle);
+					ds = (z - zlast) / cosangle;
+					raytable->speed[l + nlayer - 1] = cmean;
+					raytable->time[l + nlayer] = raytable->time[l + nlayer - 1] + ds / cmean;
+					raytable->xx[l + nlayer] = raytable->xx[l + nlayer - 1] + ds * sinangle;
+					raytable->zz[l + nlayer] = z - draft;
+					raytable->speed[l + nlayer] = c;
+					nlayer++;
+					zlast = z;
+					clast = c;
+				}
+				raytable->nvalid[k] = nlayer;
+			}
+			raytable->valid = MB_YES;
 		}
 	}
 
-	/* Reson 7k vertical depth (record 7009) */
-	copy->verticaldepth = store->verticaldepth;
-
-	/* Reson 7k tvg data (record 7010) */
-	tvg = &copy->tvg;
-	copy->tvg = store->tvg;
-	copy->tvg.nalloc = tvg->nalloc;
-	copy->tvg.tvg = tvg->tvg;
-	nalloc = tvg->n * sizeof(float);
-	if (status == MB_SUCCESS && copy->tvg.nalloc < nalloc) {
-		copy->tvg.nalloc = nalloc;
-		if (status == MB_SUCCESS)
-			status = mb_reallocd(verbose, __FILE__, __LINE__, copy->tvg.nalloc, (void **)&(copy->tvg.tvg), error);
-		if (status != MB_SUCCESS) {
-			copy->tvg.nalloc = 0;
-			copy->tvg.n = 0;
-		}
-	}
-	if (status == MB_SUCCESS) {
-		copycharptr = (char *)(copy->tvg.tvg);
-		charptr = (char *)(store->tvg.tvg);
-		for (j = 0; j < nalloc; j++)
-			copycharptr[j] = charptr[j];
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       valid:      %d\n", raytable->valid);
+		fprintf(stderr, "dbg2       svp_hash:   %u\n", raytable->svp_hash);
+		fprintf(stderr, "dbg2       nangle:     %d\n", raytable->nangle);
+		fprintf(stderr, "dbg2       nlayer:     %d\n", raytable->nlayer);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
 	}
 
-	/* Reson 7k image data (record 7011) */
-	image = &copy->image;
-	copy->image = store->image;
-	copy->image.nalloc = image->nalloc;
-	copy->image.image = image->image;
-	nalloc = image->width * image->height * image->color_depth;
-	if (status == MB_SUCCESS && copy->image.nalloc < nalloc) {
-		copy->image.nalloc = nalloc;
-		if (status == MB_SUCCESS)
-			status = mb_reallocd(verbose, __FILE__, __LINE__, copy->image.nalloc, (void **)&(copy->image.image), error);
-		if (status != MB_SUCCESS) {
-			copy->image.nalloc = 0;
-			copy->image.width = 0;
-			copy->image.height = 0;
-			copy->image.color_depth = 0;
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_raytable_lookup(s7k_raytable *raytable, double angle, double traveltime, double *xx, double *zz) {
+	double dangle, fangle, dt, sinangle, cosangle;
+	double x[2], z[2];
+	int k[2];
+	int lo, hi, mid, l, n;
+	int m;
+
+	/* bracket the takeoff angle - angles to port and starboard are alike */
+	dangle = 90.0 / (raytable->nangle - 1);
+	fangle = MIN(fabs(angle), 90.0) / dangle;
+	k[0] = MIN((int)fangle, raytable->nangle - 2);
+	k[1] = k[0] + 1;
+	fangle -= k[0];
+
+	/* for each of the two angles find the layer reached at the travel time
+	    and go on along the ray from its top boundary - past the deepest
+	    boundary the ray continues at the last sound speed */
+	for (m = 0; m < 2; m++) {
+		l = k[m] * raytable->nlayer;
+		n = raytable->nvalid[k[m]];
+		lo = 0;
+		hi = n - 1;
+		while (hi > lo) {
+			mid = (lo + hi + 1) / 2;
+			if (raytable->time[l + mid] <= traveltime)
+				lo = mid;
+			else
+				hi = mid - 1;
 		}
-	}
-	if (status == MB_SUCCESS) {
-		copycharptr = (char *)(copy->image.image);
-		charptr = (char *)(store->image.image);
-		for (j = 0; j < nalloc; j++)
-			copycharptr[j] = charptr[j];
+		dt = traveltime - raytable->time[l + lo];
+		sinangle = MIN(1.0, sin(DTR * dangle * k[m]) * raytable->speed[l + lo] / raytable->soundspeed);
+		cosangle = sqrt(1.0 - sinangle * sinangle);
+		x[m] = raytable->xx[l + lo] + dt * raytable->speed[l + lo] * sinangle;
+		z[m] = raytable->zz[l + lo] + dt * raytable->speed[l + lo] * cosangle;
 	}
 
-	/* Reson 7k system event (record 7051) */
-	systemeventmessage = &copy->systemeventmessage;
-	copy->systemeventmessage = store->systemeventmessage;
-	copy->systemeventmessage.message_alloc = systemeventmessage->message_alloc;
-	copy->systemeventmessage.message = systemeventmessage->message;
-	if (status == MB_SUCCESS && copy->systemeventmessage.message_alloc < copy->systemeventmessage.message_length) {
-		copy->systemeventmessage.message_alloc = copy->systemeventmessage.message_length;
-		if (status == MB_SUCCESS)
-			status = mb_reallocd(verbose, __FILE__, __LINE__, copy->systemeventmessage.message_alloc,
-			                     (void **)&(copy->systemeventmessage.message), error);
-		if (status != MB_SUCCESS) {
-			copy->systemeventmessage.event_id = 0;
-			copy->systemeventmessage.message_alloc = 0;
-			copy->systemeventmessage.message_length = 0;
-			copy->systemeventmessage.event_identifier = 0;
-		}
-	}
-	if (status == MB_SUCCESS) {
-		for (i = 0; i < copy->systemeventmessage.message_length; i++) {
-			copy->systemeventmessage.message[i] = store->systemeventmessage.message[i];
-		}
+	/* interpolate between the two angles */
+	*xx = x[0] + fangle * (x[1] - x[0]);
+	*zz = z[0] + fangle * (z[1] - z[0]);
+
+	return (MB_SUCCESS);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_set_raytrace(int verbose, void *mbio_ptr, int raytrace, int *error) {
+	char *function_name = "mbsys_reson7k_set_raytrace";
+	int status = MB_SUCCESS;
+	struct mb_io_struct *mb_io_ptr;
+	struct mbsys_reson7k_struct *store;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)mbio_ptr);
+		fprintf(stderr, "dbg2       raytrace:   %d\n", raytrace);
 	}
 
-	/* Reson 7k file header (record 7200) */
-	copy->fileheader = store->fileheader;
+	/* get mbio descriptor - the setting belongs to the file being preprocessed */
+	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
+	store = (struct mbsys_reson7k_struct *)mb_io_ptr->store_data;
+
+	/* set the option - the table is built when first needed */
+	store->raytrace = (raytrace == MB_YES ? MB_YES : MB_NO);
+	*error = MB_ERROR_NO_ERROR;
 
 	/* print output debug statements */
 	if (verbose >= 2) {
@@ -10020,572 +16247,829 @@ int mbsys_reson7k_copy(int verbose, void *mbio_ptr, void *store_ptr, void *copy_
 	return (status);
 }
 /*--------------------------------------------------------------------*/
-int mbsys_reson7k_makess(int verbose, void *mbio_ptr, void *store_ptr, int source, int pixel_size_set, double *pixel_size,
-                         int swath_width_set, double *swath_width, int pixel_int, int *error) {
-	char *function_name = "mbsys_reson7k_makess";
+int mbsys_reson7k_swap_ping(int verbose, void *store_ptr, void *other_ptr, int *error) {
+	char *function_name = "mbsys_reson7k_swap_ping";
 	int status = MB_SUCCESS;
-	struct mb_io_struct *mb_io_ptr;
 	struct mbsys_reson7k_struct *store;
-	s7kr_reference *reference;
-	s7kr_volatilesettings *volatilesettings;
-	s7kr_beamgeometry *beamgeometry;
-	s7kr_bathymetry *bathymetry;
-	s7kr_backscatter *backscatter;
-	s7kr_snippet *snippet;
-	s7kr_beam *beam;
-	s7kr_v2snippettimeseries *snippettimeseries;
-	s7kr_v2snippet *v2snippet;
-	s7kr_calibratedsnippettimeseries *calibratedsnippettimeseries;
-	s7kr_calibratedsnippet *calibratedsnippet;
-	s7kr_processedsidescan *processedsidescan;
-	s7kr_bluefin *bluefin;
-	s7kr_soundvelocity *soundvelocity;
-	int nss;
-	int ss_cnt[MBSYS_RESON7K_MAX_PIXELS];
-	double ss[MBSYS_RESON7K_MAX_PIXELS];
-	double ssacrosstrack[MBSYS_RESON7K_MAX_PIXELS];
-	double ssalongtrack[MBSYS_RESON7K_MAX_PIXELS];
-	int nbathsort;
-	double bathsort[MBSYS_RESON7K_MAX_BEAMS];
-	char beamflag[MBSYS_RESON7K_MAX_BEAMS];
-	double pixel_size_calc;
-	double ss_spacing, ss_spacing_use;
-	double soundspeed;
-	int iminxtrack;
-	double minxtrack;
-	double maxxtrack;
-	int nrangetable;
-	double rangetable[MBSYS_RESON7K_MAX_BEAMS];
-	double acrosstracktable[MBSYS_RESON7K_MAX_BEAMS], acrosstracktablemin;
-	double alongtracktable[MBSYS_RESON7K_MAX_BEAMS];
-	int irangenadir, irange;
-	int found;
-	int pixel_int_use;
-	int nsample, nsample_use, sample_start, sample_detect, sample_end;
-	double angle, altitude, xtrack, xtrackss, ltrackss, factor;
-	double range, beam_foot, beamwidth, sint;
-	mb_u_char *data_uchar;
-	unsigned short *data_ushort;
-	unsigned int *data_uint;
-	int first, last, k1, k2;
-	int ibeam;
-	int i, j, k, kk;
+	struct mbsys_reson7k_struct *other;
+	s7kr_volatilesettings volatilesettings;
+	s7kr_matchfilter matchfilter;
+	s7kr_beamgeometry beamgeometry;
+	s7kr_remotecontrolsettings remotecontrolsettings;
+	s7kr_bathymetry bathymetry;
+	s7kr_processedsidescan processedsidescan;
+	s7kr_backscatter backscatter;
+	s7kr_beam beam;
+	s7kr_verticaldepth verticaldepth;
+	s7kr_tvg tvg;
+	s7kr_image image;
+	s7kr_v2pingmotion v2pingmotion;
+	s7kr_v2detectionsetup v2detectionsetup;
+	s7kr_v2beamformed v2beamformed;
+	s7kr_v2detection v2detection;
+	s7kr_v2rawdetection v2rawdetection;
+	s7kr_v2snippet v2snippet;
+	s7kr_calibratedsnippet calibratedsnippet;
+	s7kr_compressedwatercolumn compressedwatercolumn;
+	s7k_rawrecord rawrecord;
+	atomic_int *sharecount;
+	u32 read_mask;
+	int current_ping_number;
+	int sharepayload[6];
+	int i;
 
 	/* print input debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
 		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
 		fprintf(stderr, "dbg2  Input arguments:\n");
-		fprintf(stderr, "dbg2       verbose:         %d\n", verbose);
-		fprintf(stderr, "dbg2       mbio_ptr:        %p\n", (void *)mbio_ptr);
-		fprintf(stderr, "dbg2       store_ptr:       %p\n", (void *)store_ptr);
-		fprintf(stderr, "dbg2       source:          %d\n", source);
-		fprintf(stderr, "dbg2       pixel_size_set:  %d\n", pixel_size_set);
-		fprintf(stderr, "dbg2       pixel_size:      %f\n", *pixel_size);
-		fprintf(stderr, "dbg2       swath_width_set: %d\n", swath_width_set);
-		fprintf(stderr, "dbg2       swath_width:     %f\n", *swath_width);
-		fprintf(stderr, "dbg2       pixel_int:       %d\n", pixel_int);
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       other_ptr:  %p\n", (void *)other_ptr);
 	}
 
-	/* get mbio descriptor */
-	mb_io_ptr = (struct mb_io_struct *)mbio_ptr;
-
-	/* get data structure pointer */
+	/* get data structure pointers */
 	store = (struct mbsys_reson7k_struct *)store_ptr;
-	reference = (s7kr_reference *)&store->reference;
-	volatilesettings = (s7kr_volatilesettings *)&store->volatilesettings;
-	beamgeometry = (s7kr_beamgeometry *)&store->beamgeometry;
-	bathymetry = (s7kr_bathymetry *)&store->bathymetry;
-	backscatter = (s7kr_backscatter *)&store->backscatter;
-	v2snippet = (s7kr_v2snippet *)&store->v2snippet;
-	calibratedsnippet = (s7kr_calibratedsnippet *)&store->calibratedsnippet;
-	beam = (s7kr_beam *)&store->beam;
-	processedsidescan = (s7kr_processedsidescan *)&store->processedsidescan;
-	bluefin = (s7kr_bluefin *)&store->bluefin;
-	soundvelocity = (s7kr_soundvelocity *)&store->soundvelocity;
+	other = (struct mbsys_reson7k_struct *)other_ptr;
+
+	/* exchange the ping records and their arrays between the two stores -
+	    nothing is copied, so a ping being read into one store can continue
+	    in the other */
+	volatilesettings = store->volatilesettings;
+	store->volatilesettings = other->volatilesettings;
+	other->volatilesettings = volatilesettings;
+	matchfilter = store->matchfilter;
+	store->matchfilter = other->matchfilter;
+	other->matchfilter = matchfilter;
+	beamgeometry = store->beamgeometry;
+	store->beamgeometry = other->beamgeometry;
+	other->beamgeometry = beamgeometry;
+	remotecontrolsettings = store->remotecontrolsettings;
+	store->remotecontrolsettings = other->remotecontrolsettings;
+	other->remotecontrolsettings = remotecontrolsettings;
+	bathymetry = store->bathymetry;
+	store->bathymetry = other->bathymetry;
+	other->bathymetry = bathymetry;
+	processedsidescan = store->processedsidescan;
+	store->processedsidescan = other->processedsidescan;
+	other->processedsidescan = processedsidescan;
+	backscatter = store->backscatter;
+	store->backscatter = other->backscatter;
+	other->backscatter = backscatter;
+	beam = store->beam;
+	store->beam = other->beam;
+	other->beam = beam;
+	verticaldepth = store->verticaldepth;
+	store->verticaldepth = other->verticaldepth;
+	other->verticaldepth = verticaldepth;
+	tvg = store->tvg;
+	store->tvg = other->tvg;
+	other->tvg = tvg;
+	image = store->image;
+	store->image = other->image;
+	other->image = image;
+	v2pingmotion = store->v2pingmotion;
+	store->v2pingmotion = other->v2pingmotion;
+	other->v2pingmotion = v2pingmotion;
+	v2detectionsetup = store->v2detectionsetup;
+	store->v2detectionsetup = other->v2detectionsetup;
+	other->v2detectionsetup = v2detectionsetup;
+	v2beamformed = store->v2beamformed;
+	store->v2beamformed = other->v2beamformed;
+	other->v2beamformed = v2beamformed;
+	v2detection = store->v2detection;
+	store->v2detection = other->v2detection;
+	other->v2detection = v2detection;
+	v2rawdetection = store->v2rawdetection;
+	store->v2rawdetection = other->v2rawdetection;
+	other->v2rawdetection = v2rawdetection;
+	v2snippet = store->v2snippet;
+	store->v2snippet = other->v2snippet;
+	other->v2snippet = v2snippet;
+	calibratedsnippet = store->calibratedsnippet;
+	store->calibratedsnippet = other->calibratedsnippet;
+	other->calibratedsnippet = calibratedsnippet;
+	compressedwatercolumn = store->compressedwatercolumn;
+	store->compressedwatercolumn = other->compressedwatercolumn;
+	other->compressedwatercolumn = compressedwatercolumn;
+
+	/* exchange the ping record pass-through buffers */
+	for (i = 0; i < R7KRAW_Other; i++) {
+		rawrecord = store->rawrecord[i];
+		store->rawrecord[i] = other->rawrecord[i];
+		other->rawrecord[i] = rawrecord;
+		sharecount = store->sharecount[R7KSHARE_RawRecord + i];
+		store->sharecount[R7KSHARE_RawRecord + i] = other->sharecount[R7KSHARE_RawRecord + i];
+		other->sharecount[R7KSHARE_RawRecord + i] = sharecount;
+	}
+
+	/* the reference counts of shared ping payloads go with the arrays */
+	sharepayload[0] = R7KSHARE_BeamGeometry;
+	sharepayload[1] = R7KSHARE_Bathymetry;
+	sharepayload[2] = R7KSHARE_Backscatter;
+	sharepayload[3] = R7KSHARE_Beam;
+	sharepayload[4] = R7KSHARE_Tvg;
+	sharepayload[5] = R7KSHARE_Image;
+	for (i = 0; i < 6; i++) {
+		sharecount = store->sharecount[sharepayload[i]];
+		store->sharecount[sharepayload[i]] = other->sharecount[sharepayload[i]];
+		other->sharecount[sharepayload[i]] = sharecount;
+	}
+
+	/* exchange the ping record registry */
+	read_mask = store->read_mask;
+	store->read_mask = other->read_mask;
+	other->read_mask = read_mask;
+	current_ping_number = store->current_ping_number;
+	store->current_ping_number = other->current_ping_number;
+	other->current_ping_number = current_ping_number;
 
-	/* if necessary pick a source for the backscatter */
-	if (store->kind == MB_DATA_DATA && source == R7KRECID_None) {
-		if (store->read_calibratedsnippet == MB_YES)
-			source = R7KRECID_7kCalibratedSnippetData;
-		else if (store->read_v2snippet == MB_YES)
-			source = R7KRECID_7kV2SnippetData;
-		else if (store->read_beam == MB_YES)
-			source = R7KRECID_7kBeamData;
-		else if (store->read_backscatter == MB_YES)
-			source = R7KRECID_7kBackscatterImageData;
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
 	}
 
-	/* calculate sidescan from the desired source data if it is available */
-	if (store->kind == MB_DATA_DATA && ((source == R7KRECID_7kV2SnippetData && store->read_v2snippet == MB_YES) ||
-	                                    (source == R7KRECID_7kCalibratedSnippetData && store->read_calibratedsnippet == MB_YES) ||
-	                                    (source == R7KRECID_7kBeamData && store->read_beam == MB_YES) ||
-	                                    (source == R7KRECID_7kBackscatterImageData && store->read_backscatter == MB_YES))) {
-		/* get beamflags - only use snippets from good beams */
-		for (i = 0; i < bathymetry->number_beams; i++) {
-			/* beamflagging scheme:
-			    Reson quality flags use bits 0-3
-			        bit 0: brightness test
-			        bit 1: colinearity test
-			        bit 2: amplitude pick
-			        bit 3: phase pick
-			    Early MB scheme (through 2007) - use bits 0-5
-			        null: 0
-			        flagged: 2
-			        good: 15
-			        amplitude: +16
-			        phase: +32
-			    Current MB scheme (>= 2008) - use bits 4-7
-			        - bits 0-3 left in original values
-			        - beam valid if bit 4 or 5 are set
-			        - beam flagged if bit 6 or 7 set
-			        bit 4: on = amplitude
-			        bit 5: on = phase
-			        bit 6: on = auto flag
-			        bit 7: on = manual flag */
-			if (bathymetry->quality[i] == 0) {
-				beamflag[i] = MB_FLAG_NULL;
-			}
-			else if (bathymetry->quality[i] & 64) {
-				beamflag[i] = MB_FLAG_FLAG + MB_FLAG_FILTER;
-			}
-			else if (bathymetry->quality[i] & 128) {
-				beamflag[i] = MB_FLAG_FLAG + MB_FLAG_MANUAL;
-			}
-			else if (bathymetry->quality[i] & 240) {
-				beamflag[i] = MB_FLAG_NONE;
-			}
-			else if ((bathymetry->quality[i] & 3) == 3) {
-				beamflag[i] = MB_FLAG_NONE;
-			}
-			else if ((bathymetry->quality[i] & 15) == 0) {
-				beamflag[i] = MB_FLAG_NULL;
-			}
-			else if ((bathymetry->quality[i] & 3) == 0) {
-				beamflag[i] = MB_FLAG_FLAG + MB_FLAG_FILTER;
-			}
-			else {
-				beamflag[i] = MB_FLAG_FLAG + MB_FLAG_MANUAL;
-			}
-		}
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_carry_records(int verbose, void *store_ptr, void *copy_ptr, int *error) {
+	char *function_name = "mbsys_reson7k_carry_records";
+	int status = MB_SUCCESS;
+	struct mbsys_reson7k_struct *store;
+	struct mbsys_reson7k_struct *copy;
+	s7kr_customattitude customattitude;
+	s7kr_surveyline surveyline;
+	s7kr_sonarpipeenvironment sonarpipeenvironment;
+	s7kr_v2firmwarehardwareconfiguration v2firmwarehardwareconfiguration;
+	s7kr_v2bite v2bite;
+	size_t size;
+	int sharepayload[] = {R7KSHARE_Attitude,      R7KSHARE_Motion,        R7KSHARE_Svp,
+	                      R7KSHARE_Ctd,           R7KSHARE_FsdwssLo,      R7KSHARE_FsdwssHi,
+	                      R7KSHARE_Fsdwsb,        R7KSHARE_Configuration, R7KSHARE_SystemEventMessage,
+	                      R7KSHARE_FileHeader,    R7KSHARE_RawRecord + R7KRAW_Other};
+	int nsharepayload = sizeof(sharepayload) / sizeof(int);
+	int i;
 
-		/* get beam angle size */
-		beamwidth = 2.0 * RTD * volatilesettings->receive_width;
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       store_ptr:  %p\n", (void *)store_ptr);
+		fprintf(stderr, "dbg2       copy_ptr:   %p\n", (void *)copy_ptr);
+	}
 
-		/* get soundspeed */
-		if (volatilesettings->sound_velocity > 0.0)
-			soundspeed = volatilesettings->sound_velocity;
-		else if (soundvelocity->soundvelocity > 0.0)
-			soundspeed = soundvelocity->soundvelocity;
-		else if (bluefin->environmental[0].sound_speed > 0.0)
-			soundspeed = bluefin->environmental[0].sound_speed;
-		else
-			soundspeed = 1500.0;
+	/* get data structure pointers */
+	store = (struct mbsys_reson7k_struct *)store_ptr;
+	copy = (struct mbsys_reson7k_struct *)copy_ptr;
 
-		/* get raw pixel size */
-		ss_spacing = 0.5 * soundspeed / volatilesettings->sample_rate;
+	/* give the copy the latest of every record that is not part of a ping,
+	    as it would hold them had it read the records itself - the ping
+	    records are left alone */
 
-		/* get median depth relative to the sonar and check for min max xtrack */
-		nbathsort = 0;
-		minxtrack = 0.0;
-		maxxtrack = 0.0;
-		iminxtrack = bathymetry->number_beams / 2;
-		found = MB_NO;
-		for (i = 0; i < bathymetry->number_beams; i++) {
-			if (mb_beam_ok(beamflag[i])) {
-				bathsort[nbathsort] = bathymetry->depth[i] + bathymetry->vehicle_height;
-				nbathsort++;
+	/* records without arrays are copied */
+	copy->reference = store->reference;
+	copy->sensoruncal = store->sensoruncal;
+	copy->sensorcal = store->sensorcal;
+	copy->position = store->position;
+	copy->tide = store->tide;
+	copy->altitude = store->altitude;
+	copy->depth = store->depth;
+	copy->geodesy = store->geodesy;
+	copy->rollpitchheave = store->rollpitchheave;
+	copy->heading = store->heading;
+	copy->navigation = store->navigation;
+	copy->pantilt = store->pantilt;
+	copy->sonarinstallationids = store->sonarinstallationids;
+	copy->bluefin = store->bluefin;
+	copy->calibration = store->calibration;
+	copy->v27kcenterversion = store->v27kcenterversion;
+	copy->v28kwetendversion = store->v28kwetendversion;
+	copy->installation = store->installation;
+
+	/* the arrays of the larger records are shared */
+	for (i = 0; i < nsharepayload && status == MB_SUCCESS; i++)
+		status = mbsys_reson7k_share_payload(verbose, store_ptr, copy_ptr, sharepayload[i], error);
+
+	/* the other records with arrays are copied into the arrays of the copy,
+	    grown as needed - the arrays are emptied if they cannot be grown */
+	customattitude = copy->customattitude;
+	copy->customattitude = store->customattitude;
+	copy->customattitude.pitch = customattitude.pitch;
+	copy->customattitude.roll = customattitude.roll;
+	copy->customattitude.heading = customattitude.heading;
+	copy->customattitude.heave = customattitude.heave;
+	copy->customattitude.pitchrate = customattitude.pitchrate;
+	copy->customattitude.rollrate = customattitude.rollrate;
+	copy->customattitude.headingrate = customattitude.headingrate;
+	copy->customattitude.heaverate = customattitude.heaverate;
+	size = store->customattitude.nalloc * sizeof(f32);
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_carry_array(verbose, size, store->customattitude.pitch, (void **)&(copy->customattitude.pitch),
+		                                   error);
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_carry_array(verbose, size, store->customattitude.roll, (void **)&(copy->customattitude.roll),
+		                                   error);
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_carry_array(verbose, size, store->customattitude.heading,
+		                                   (void **)&(copy->customattitude.heading), error);
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_carry_array(verbose, size, store->customattitude.heave, (void **)&(copy->customattitude.heave),
+		                                   error);
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_carry_array(verbose, size, store->customattitude.pitchrate,
+		                                   (void **)&(copy->customattitude.pitchrate), error);
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_carry_array(verbose, size, store->customattitude.rollrate,
+		                                   (void **)&(copy->customattitude.rollrate), error);
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_carry_array(verbose, size, store->customattitude.headingrate,
+		                                   (void **)&(copy->customattitude.headingrate), error);
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_carry_array(verbose, size, store->customattitude.heaverate,
+		                                   (void **)&(copy->customattitude.heaverate), error);
+	if (status == MB_FAILURE) {
+		copy->customattitude.n = 0;
+		copy->customattitude.nalloc = 0;
+	}
+
+	/* the survey line arrays are the size allocated by the reader */
+	surveyline = copy->surveyline;
+	copy->surveyline = store->surveyline;
+	copy->surveyline.latitude = surveyline.latitude;
+	copy->surveyline.longitude = surveyline.longitude;
+	size = store->surveyline.nalloc * sizeof(float);
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_carry_array(verbose, size, store->surveyline.latitude, (void **)&(copy->surveyline.latitude),
+		                                   error);
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_carry_array(verbose, size, store->surveyline.longitude, (void **)&(copy->surveyline.longitude),
+		                                   error);
+	if (status == MB_FAILURE) {
+		copy->surveyline.n = 0;
+		copy->surveyline.nalloc = 0;
+	}
+
+	sonarpipeenvironment = copy->sonarpipeenvironment;
+	copy->sonarpipeenvironment = store->sonarpipeenvironment;
+	copy->sonarpipeenvironment.x = sonarpipeenvironment.x;
+	copy->sonarpipeenvironment.y = sonarpipeenvironment.y;
+	copy->sonarpipeenvironment.z = sonarpipeenvironment.z;
+	copy->sonarpipeenvironment.angle = sonarpipeenvironment.angle;
+	copy->sonarpipeenvironment.sample_number = sonarpipeenvironment.sample_number;
+	size = store->sonarpipeenvironment.nalloc * sizeof(f32);
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_carry_array(verbose, size, store->sonarpipeenvironment.x, (void **)&(copy->sonarpipeenvironment.x),
+		                                   error);
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_carry_array(verbose, size, store->sonarpipeenvironment.y, (void **)&(copy->sonarpipeenvironment.y),
+		                                   error);
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_carry_array(verbose, size, store->sonarpipeenvironment.z, (void **)&(copy->sonarpipeenvironment.z),
+		                                   error);
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_carry_array(verbose, size, store->sonarpipeenvironment.angle,
+		                                   (void **)&(copy->sonarpipeenvironment.angle), error);
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_carry_array(verbose, size, store->sonarpipeenvironment.sample_number,
+		                                   (void **)&(copy->sonarpipeenvironment.sample_number), error);
+	if (status == MB_FAILURE) {
+		copy->sonarpipeenvironment.n = 0;
+		copy->sonarpipeenvironment.nalloc = 0;
+	}
+
+	v2firmwarehardwareconfiguration = copy->v2firmwarehardwareconfiguration;
+	copy->v2firmwarehardwareconfiguration = store->v2firmwarehardwareconfiguration;
+	copy->v2firmwarehardwareconfiguration.info = v2firmwarehardwareconfiguration.info;
+	size = store->v2firmwarehardwareconfiguration.info_alloc;
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_carry_array(verbose, size, store->v2firmwarehardwareconfiguration.info,
+		                                   (void **)&(copy->v2firmwarehardwareconfiguration.info), error);
+	if (status == MB_FAILURE) {
+		copy->v2firmwarehardwareconfiguration.info_length = 0;
+		copy->v2firmwarehardwareconfiguration.info_alloc = 0;
+	}
+
+	v2bite = copy->v2bite;
+	copy->v2bite = store->v2bite;
+	copy->v2bite.reports = v2bite.reports;
+	size = store->v2bite.nalloc;
+	if (status == MB_SUCCESS)
+		status = mbsys_reson7k_carry_array(verbose, size, store->v2bite.reports, (void **)&(copy->v2bite.reports), error);
+	if (status == MB_FAILURE) {
+		copy->v2bite.number_reports = 0;
+		copy->v2bite.nalloc = 0;
+	}
 
-				if (found == MB_NO || fabs(bathymetry->acrosstrack[i]) < minxtrack) {
-					minxtrack = fabs(bathymetry->acrosstrack[i]);
-					iminxtrack = i;
-					found = MB_YES;
-				}
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
+
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_carry_array(int verbose, size_t size, void *array, void **copy, int *error) {
+	int status = MB_SUCCESS;
+
+	/* make the first size bytes of the array of the copy those of array,
+	    reallocating the array of the copy to that size */
+	if (array != NULL && size > 0) {
+		status = mb_reallocd(verbose, __FILE__, __LINE__, size, copy, error);
+		if (status == MB_SUCCESS)
+			memcpy(*copy, array, size);
+	}
 
-				maxxtrack = MAX(fabs(bathymetry->acrosstrack[i]), maxxtrack);
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_preprocess_pipeline(int verbose, void *imbio_ptr, void *ombio_ptr, void *platform_ptr,
+                                      void *preprocess_pars_ptr, int nworkers, int *nread, int *nwritten, int *error) {
+	char *function_name = "mbsys_reson7k_preprocess_pipeline";
+	int status = MB_SUCCESS;
+	int read_status = MB_SUCCESS;
+	int read_error = MB_ERROR_NO_ERROR;
+	int slot_error = MB_ERROR_NO_ERROR;
+	struct mb_io_struct *imb_io_ptr;
+	struct mb_io_struct *omb_io_ptr;
+	struct mbsys_reson7k_struct *store;
+#ifdef MBSYS_RESON7K_PTHREADS
+	struct mbsys_reson7k_struct *istore;
+	struct mbsys_reson7k_struct *qstore;
+	struct mbsys_reson7k_pipeline_struct pipeline;
+	struct mbsys_reson7k_pipelineworker_struct worker[MBSYS_RESON7K_PIPELINE_WORKERS_MAX];
+	struct mbsys_reson7k_struct *wstore;
+	pthread_t writer_thread;
+	pthread_t worker_threads[MBSYS_RESON7K_PIPELINE_WORKERS_MAX];
+	int nstarted = 0;
+	int nwait;
+	int i, j, k;
+#endif
+	int threaded = MB_NO;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:             %d\n", verbose);
+		fprintf(stderr, "dbg2       imbio_ptr:           %p\n", (void *)imbio_ptr);
+		fprintf(stderr, "dbg2       ombio_ptr:           %p\n", (void *)ombio_ptr);
+		fprintf(stderr, "dbg2       platform_ptr:        %p\n", (void *)platform_ptr);
+		fprintf(stderr, "dbg2       preprocess_pars_ptr: %p\n", (void *)preprocess_pars_ptr);
+		fprintf(stderr, "dbg2       nworkers:            %d\n", nworkers);
+	}
+
+	/* get mbio descriptors */
+	imb_io_ptr = (struct mb_io_struct *)imbio_ptr;
+	omb_io_ptr = (struct mb_io_struct *)ombio_ptr;
+	*nread = 0;
+	*nwritten = 0;
+
+	/* get the store records are read into */
+	store = NULL;
+	status = mbsys_reson7k_alloc(verbose, imbio_ptr, (void **)&store, error);
+
+#ifdef MBSYS_RESON7K_PTHREADS
+	/* set up the ring of stores between the stages */
+	pipeline.nslot = 0;
+	if (status == MB_SUCCESS && nworkers > 0) {
+		istore = (struct mbsys_reson7k_struct *)imb_io_ptr->store_data;
+		nworkers = MIN(nworkers, MBSYS_RESON7K_PIPELINE_WORKERS_MAX);
+		pipeline.verbose = verbose;
+		pipeline.imbio_ptr = imbio_ptr;
+		pipeline.ombio_ptr = ombio_ptr;
+		pipeline.platform_ptr = platform_ptr;
+		pipeline.preprocess_pars_ptr = preprocess_pars_ptr;
+		pipeline.nslot = 2 * nworkers + 2;
+		for (k = 0; k < pipeline.nslot; k++) {
+			pipeline.slot_store[k] = NULL;
+			if (status == MB_SUCCESS)
+				status = mbsys_reson7k_alloc(verbose, imbio_ptr, (void **)&(pipeline.slot_store[k]), error);
+			atomic_init(&(pipeline.slot_state[k]), MBSYS_RESON7K_PIPELINE_FREE);
+			pipeline.slot_status[k] = MB_SUCCESS;
+			pipeline.slot_error[k] = MB_ERROR_NO_ERROR;
+		}
+		atomic_init(&pipeline.nread, 0);
+		atomic_init(&pipeline.nclaim, 0);
+		atomic_init(&pipeline.nwritten, 0);
+		atomic_init(&pipeline.eof, MB_NO);
+		atomic_init(&pipeline.abort, MB_NO);
+		pipeline.status = MB_SUCCESS;
+		pipeline.error = MB_ERROR_NO_ERROR;
+
+		/* load the ancillary series once - the workers only read them */
+		if (status == MB_SUCCESS)
+			status = mbsys_reson7k_preprocess_tseries(verbose, imbio_ptr, preprocess_pars_ptr, error);
+
+		/* give each worker its own copy of the input descriptor with its
+		    own internal store carrying the preprocessing settings - the
+		    workers leave the sidescan to the writer */
+		for (i = 0; i < nworkers; i++) {
+			worker[i].pipeline = &pipeline;
+			worker[i].mbio_ptr = NULL;
+			if (status == MB_SUCCESS)
+				status = mbsys_reson7k_pipeline_mbio(verbose, imbio_ptr, &(worker[i].mbio_ptr), error);
+			if (status == MB_SUCCESS) {
+				wstore = (struct mbsys_reson7k_struct *)worker[i].mbio_ptr->store_data;
+				wstore->preprocess_threads = istore->preprocess_threads;
+				wstore->makess_threads = istore->makess_threads;
+				wstore->makess_deterministic = istore->makess_deterministic;
+				wstore->raytrace = istore->raytrace;
+				wstore->preprocess_makess = MB_NO;
+				for (j = 0; j < MBSYS_RESON7K_TSERIES_NUM && status == MB_SUCCESS; j++)
+					status = mbsys_reson7k_tseries_share(verbose, &(wstore->tseries_preprocess[j]),
+					                                     &(istore->tseries_preprocess[j]), error);
 			}
 		}
 
-		/* set number of pixels */
-		nss = MIN(4 * bathymetry->number_beams, MBSYS_RESON7K_MAX_PIXELS);
-
-		/* get sidescan pixel size */
-		if (swath_width_set == MB_NO && bathymetry->number_beams > 0) {
-			(*swath_width) = MAX(fabs(RTD * beamgeometry->angle_acrosstrack[0]),
-			                     fabs(RTD * beamgeometry->angle_acrosstrack[bathymetry->number_beams - 1]));
+		/* give the writer its copy of the input descriptor - the pixel size
+		    and swath width of the sidescan carry over from ping to ping in
+		    its saved values, starting from those of the input descriptor */
+		pipeline.wmbio_ptr = NULL;
+		if (status == MB_SUCCESS)
+			status = mbsys_reson7k_pipeline_mbio(verbose, imbio_ptr, &(pipeline.wmbio_ptr), error);
+		if (status == MB_SUCCESS) {
+			wstore = (struct mbsys_reson7k_struct *)pipeline.wmbio_ptr->store_data;
+			wstore->makess_threads = istore->makess_threads;
+			wstore->makess_deterministic = istore->makess_deterministic;
 		}
-		if (pixel_size_set == MB_NO && nbathsort > 0) {
-			/* calculate pixel size implied using swath width and nadir altitude */
-			qsort((void *)bathsort, nbathsort, sizeof(double), (void *)mb_double_compare);
-			pixel_size_calc = 2.1 * tan(DTR * (*swath_width)) * bathsort[nbathsort / 2] / nss;
-
-			/* use pixel size based on actual swath width if that is larger than the first value */
-			pixel_size_calc = MAX(pixel_size_calc, 2.1 * maxxtrack / nss);
 
-			/* make sure the pixel size is at least equivalent to a 0.1 degree nadir beamwidth */
-			pixel_size_calc = MAX(pixel_size_calc, bathsort[nbathsort / 2] * sin(DTR * 0.1));
-
-			/* if the pixel size appears to be changing in size, moderate the change */
-			if ((*pixel_size) <= 0.0)
-				(*pixel_size) = pixel_size_calc;
-			else if (0.95 * (*pixel_size) > pixel_size_calc)
-				(*pixel_size) = 0.95 * (*pixel_size);
-			else if (1.05 * (*pixel_size) < pixel_size_calc)
-				(*pixel_size) = 1.05 * (*pixel_size);
-			else
-				(*pixel_size) = pixel_size_calc;
+		/* start the writer, then the workers - without workers the reader
+		    also preprocesses, and without the writer nothing is threaded */
+		if (status == MB_SUCCESS
+		    && pthread_create(&writer_thread, NULL, mbsys_reson7k_pipeline_write, (void *)&pipeline) == 0) {
+			threaded = MB_YES;
+			for (nstarted = 0; nstarted < nworkers; nstarted++) {
+				if (pthread_create(&worker_threads[nstarted], NULL, mbsys_reson7k_pipeline_preprocess,
+				                   (void *)&worker[nstarted]) != 0)
+					break;
+			}
 		}
+	}
 
-		/* get pixel interpolation */
-		pixel_int_use = pixel_int + 1;
-
-		/* zero the sidescan */
-		for (i = 0; i < MBSYS_RESON7K_MAX_PIXELS; i++) {
-			ss[i] = 0.0;
-			ssacrosstrack[i] = 0.0;
-			ssalongtrack[i] = 0.0;
-			ss_cnt[i] = 0;
-		}
-		for (i = 0; i < nss; i++) {
-			ssacrosstrack[i] = (*pixel_size) * (double)(i - (nss / 2));
-			;
+	/* read records and pass them down the pipeline - the store just read
+	    is exchanged for the free store of the next slot, and a ping still
+	    being read and the latest of every record that is not part of a
+	    ping are carried over to the store the reader continues with */
+	while (status == MB_SUCCESS && threaded == MB_YES) {
+		read_status = (*imb_io_ptr->mb_io_read_ping)(verbose, imbio_ptr, (void *)store, &read_error);
+		if (read_status == MB_FAILURE && read_error > MB_ERROR_NO_ERROR)
+			break;
+		else if (read_status == MB_FAILURE)
+			continue;
+		(*nread)++;
+
+		/* wait for the writer to release the next slot */
+		k = atomic_load(&pipeline.nread) % pipeline.nslot;
+		nwait = 0;
+		while (atomic_load(&pipeline.abort) == MB_NO
+		       && atomic_load(&(pipeline.slot_state[k])) != MBSYS_RESON7K_PIPELINE_FREE)
+			mbsys_reson7k_pipeline_wait(&nwait);
+		if (atomic_load(&pipeline.abort) == MB_YES)
+			break;
+
+		/* queue the record */
+		qstore = store;
+		store = pipeline.slot_store[k];
+		pipeline.slot_store[k] = qstore;
+		if (qstore->kind != MB_DATA_DATA)
+			mbsys_reson7k_swap_ping(verbose, (void *)qstore, (void *)store, error);
+		status = mbsys_reson7k_carry_records(verbose, (void *)qstore, (void *)store, error);
+		pipeline.slot_status[k] = MB_SUCCESS;
+		pipeline.slot_error[k] = MB_ERROR_NO_ERROR;
+		if (nstarted == 0 && qstore->kind == MB_DATA_DATA)
+			pipeline.slot_status[k] = mbsys_reson7k_preprocess(verbose, imbio_ptr, (void *)qstore, platform_ptr,
+			                                                   preprocess_pars_ptr, &(pipeline.slot_error[k]));
+		atomic_store(&(pipeline.slot_state[k]), (nstarted == 0 ? MBSYS_RESON7K_PIPELINE_DONE : MBSYS_RESON7K_PIPELINE_READ));
+		atomic_fetch_add(&pipeline.nread, 1);
+	}
+
+	/* let the workers and the writer drain the pipeline */
+	if (threaded == MB_YES) {
+		atomic_store(&pipeline.eof, MB_YES);
+		for (i = 0; i < nstarted; i++)
+			pthread_join(worker_threads[i], NULL);
+		pthread_join(writer_thread, NULL);
+		*nwritten = atomic_load(&pipeline.nwritten);
+		if (status == MB_SUCCESS) {
+			status = pipeline.status;
+			*error = pipeline.error;
 		}
+	}
 
-		/* loop over raw backscatter or sidescan from the desired source,
-		 * 	putting each raw sample into the binning arrays */
-
-		/* use calibrated snippet data
-		   error_flag = 0 is calibrated snippet data
-		   error_flag = 1 is uncalibrated snippet data
-		   error_flag > 1 indicates a problem */
-		if (source == R7KRECID_7kCalibratedSnippetData && calibratedsnippet->error_flag < 3) {
-			for (i = 0; i < calibratedsnippet->number_beams; i++) {
-				calibratedsnippettimeseries =
-				    (s7kr_calibratedsnippettimeseries *)&(calibratedsnippet->calibratedsnippettimeseries[i]);
-				ibeam = calibratedsnippettimeseries->beam_number;
-
-				/* only use snippets from non-null and unflagged beams */
-				/* note: errors have been observed in data produced by a Reson
-				    simulator in which the detect_sample was
-				    was outside the range of begin_sample to end_sample
-				    - the current code effectively ignores this case because
-				    sample_end < sample_start, so no samples are processed. */
-				if (mb_beam_ok(beamflag[ibeam])) {
-					nsample = calibratedsnippettimeseries->end_sample - calibratedsnippettimeseries->begin_sample + 1;
-					altitude = bathymetry->depth[ibeam] + bathymetry->vehicle_height;
-					xtrack = bathymetry->acrosstrack[ibeam];
-					range = 0.5 * soundspeed * bathymetry->range[ibeam];
-					angle = RTD * beamgeometry->angle_acrosstrack[ibeam];
-					beam_foot = range * sin(DTR * beamwidth) / cos(DTR * angle);
-					sint = fabs(sin(DTR * angle));
-					nsample_use = beam_foot / ss_spacing;
-					if (sint < nsample_use * ss_spacing / beam_foot)
-						ss_spacing_use = beam_foot / nsample_use;
-					else
-						ss_spacing_use = ss_spacing / sint;
-					/* fprintf(stderr, "spacing: %f %f n:%d sint:%f angle:%f range:%f foot:%f factor:%f\n",
-					ss_spacing, ss_spacing_use,
-					nsample_use, sint, angle, range, beam_foot,
-					nsample_use * ss_spacing / beam_foot); */
-					sample_start = MAX(((int)calibratedsnippettimeseries->detect_sample - (nsample_use / 2)),
-					                   (int)calibratedsnippettimeseries->begin_sample);
-					sample_end = MIN(((int)calibratedsnippettimeseries->detect_sample + (nsample_use / 2)),
-					                 (int)calibratedsnippettimeseries->end_sample);
-					/* fprintf(stderr,"beam:%d snippet samples: b:%d d:%d e:%d   start:%d end:%d\n",
-					ibeam,calibratedsnippettimeseries->begin_sample,calibratedsnippettimeseries->detect_sample,calibratedsnippettimeseries->end_sample,sample_start,sample_end);
-				  */
-					for (k = sample_start; k <= sample_end; k++) {
-						if (xtrack < 0.0)
-							xtrackss = xtrack - ss_spacing_use * (k - (int)calibratedsnippettimeseries->detect_sample);
-						else
-							xtrackss = xtrack + ss_spacing_use * (k - (int)calibratedsnippettimeseries->detect_sample);
-						kk = nss / 2 + (int)(xtrackss / (*pixel_size));
-						kk = MIN(MAX(0, kk), nss - 1);
-						ss[kk] +=
-						    (double)calibratedsnippettimeseries->amplitude[k - (int)calibratedsnippettimeseries->begin_sample];
-						ssalongtrack[kk] += bathymetry->alongtrack[i];
-						ss_cnt[kk]++;
-						/* fprintf(stderr,"k:%d detect:%d xtrack:%f xtrackss:%f kk:%d ss:%f ss_cnt:%d\n",
-						k,snippettimeseries->detect_sample,xtrack,xtrackss,kk,ss[kk],ss_cnt[kk]); */
-					}
-				}
+	/* release the ring - the sidescan settings made by the writer are
+	    returned to the input descriptor */
+	if (pipeline.nslot > 0) {
+		if (pipeline.wmbio_ptr != NULL) {
+			if (threaded == MB_YES && nstarted > 0) {
+				imb_io_ptr->saved1 = pipeline.wmbio_ptr->saved1;
+				imb_io_ptr->saved2 = pipeline.wmbio_ptr->saved2;
 			}
+			mbsys_reson7k_deall(verbose, imbio_ptr, &(pipeline.wmbio_ptr->store_data), &slot_error);
+			mb_freed(verbose, __FILE__, __LINE__, (void **)&(pipeline.wmbio_ptr), &slot_error);
 		}
-
-		/* use v2 snippet data */
-		else if (source == R7KRECID_7kV2SnippetData && v2snippet->error_flag == MB_NO) {
-			for (i = 0; i < v2snippet->number_beams; i++) {
-				snippettimeseries = (s7kr_v2snippettimeseries *)&(v2snippet->snippettimeseries[i]);
-				ibeam = snippettimeseries->beam_number;
-
-				/* only use snippets from non-null and unflagged beams */
-				/* note: errors have been observed in data produced by a Reson
-				    simulator in which the detect_sample was
-				    was outside the range of begin_sample to end_sample
-				    - the current code effectively ignores this case because
-				    sample_end < sample_start, so no samples are processed. */
-				if (mb_beam_ok(beamflag[ibeam])) {
-					nsample = snippettimeseries->end_sample - snippettimeseries->begin_sample + 1;
-					altitude = bathymetry->depth[ibeam] + bathymetry->vehicle_height;
-					xtrack = bathymetry->acrosstrack[ibeam];
-					range = 0.5 * soundspeed * bathymetry->range[ibeam];
-					angle = RTD * beamgeometry->angle_acrosstrack[ibeam];
-					beam_foot = range * sin(DTR * beamwidth) / cos(DTR * angle);
-					sint = fabs(sin(DTR * angle));
-					nsample_use = beam_foot / ss_spacing;
-					if (sint < nsample_use * ss_spacing / beam_foot)
-						ss_spacing_use = beam_foot / nsample_use;
-					else
-						ss_spacing_use = ss_spacing / sint;
-					/* fprintf(stderr, "spacing: %f %f n:%d sint:%f angle:%f range:%f foot:%f factor:%f\n",
-					ss_spacing, ss_spacing_use,
-					nsample_use, sint, angle, range, beam_foot,
-					nsample_use * ss_spacing / beam_foot); */
-					sample_start =
-					    MAX(((int)snippettimeseries->detect_sample - (nsample_use / 2)), (int)snippettimeseries->begin_sample);
-					sample_end =
-					    MIN(((int)snippettimeseries->detect_sample + (nsample_use / 2)), (int)snippettimeseries->end_sample);
-					/* fprintf(stderr,"beam:%d snippet samples: b:%d d:%d e:%d   start:%d end:%d\n",
-					ibeam,snippettimeseries->begin_sample,snippettimeseries->detect_sample,snippettimeseries->end_sample,sample_start,sample_end);
-				  */
-					for (k = sample_start; k <= sample_end; k++) {
-						if (xtrack < 0.0)
-							xtrackss = xtrack - ss_spacing_use * (k - (int)snippettimeseries->detect_sample);
-						else
-							xtrackss = xtrack + ss_spacing_use * (k - (int)snippettimeseries->detect_sample);
-						kk = nss / 2 + (int)(xtrackss / (*pixel_size));
-						kk = MIN(MAX(0, kk), nss - 1);
-						ss[kk] += (double)snippettimeseries->amplitude[k - (int)snippettimeseries->begin_sample];
-						ssalongtrack[kk] += bathymetry->alongtrack[i];
-						ss_cnt[kk]++;
-						/* fprintf(stderr,"k:%d detect:%d xtrack:%f xtrackss:%f kk:%d ss:%f ss_cnt:%d\n",
-						k,snippettimeseries->detect_sample,xtrack,xtrackss,kk,ss[kk],ss_cnt[kk]); */
-					}
-				}
+		for (i = 0; i < nworkers; i++) {
+			if (worker[i].mbio_ptr != NULL) {
+				mbsys_reson7k_deall(verbose, imbio_ptr, &(worker[i].mbio_ptr->store_data), &slot_error);
+				mb_freed(verbose, __FILE__, __LINE__, (void **)&(worker[i].mbio_ptr), &slot_error);
 			}
 		}
+		for (k = 0; k < pipeline.nslot; k++) {
+			if (pipeline.slot_store[k] != NULL)
+				mbsys_reson7k_deall(verbose, imbio_ptr, (void **)&(pipeline.slot_store[k]), &slot_error);
+		}
+	}
+#endif
 
-		/* use old snippet data */
-		else if (source == R7KRECID_7kBeamData) {
-			for (i = 0; i < beam->number_beams; i++) {
-				snippet = (s7kr_snippet *)&(beam->snippets[i]);
-				ibeam = snippet->beam_number;
-
-				/* only use snippets from non-null and unflagged beams */
-				if (mb_beam_ok(beamflag[ibeam])) {
-					nsample = snippet->end_sample - snippet->begin_sample + 1;
-					altitude = bathymetry->depth[ibeam] + bathymetry->vehicle_height;
-					xtrack = bathymetry->acrosstrack[ibeam];
-					range = 0.5 * soundspeed * bathymetry->range[ibeam];
-					angle = RTD * beamgeometry->angle_acrosstrack[ibeam];
-					beam_foot = range * sin(DTR * beamwidth) / cos(DTR * angle);
-					sint = fabs(sin(DTR * angle));
-					nsample_use = beam_foot / ss_spacing;
-					if (sint < nsample_use * ss_spacing / beam_foot)
-						ss_spacing_use = beam_foot / nsample_use;
-					else
-						ss_spacing_use = ss_spacing / sint;
-					/* fprintf(stderr, "spacing: %f %f xtrack:%f altitude:%f n:%d sint:%f angle:%f range:%f foot:%f factor:%f\n",
-					ss_spacing, ss_spacing_use,
-					xtrack,altitude,
-					nsample_use, sint, angle, range, beam_foot,
-					nsample_use * ss_spacing / beam_foot); */
-					sample_detect = volatilesettings->sample_rate * bathymetry->range[ibeam];
-					sample_start = MAX(sample_detect - (nsample_use / 2), snippet->begin_sample);
-					sample_end = MIN(sample_detect + (nsample_use / 2), snippet->end_sample);
-					if ((beam->sample_type & 15) == 3)
-						data_uint = (unsigned int *)snippet->amplitude;
-					else if ((beam->sample_type & 15) == 2)
-						data_ushort = (unsigned short *)snippet->amplitude;
-					else
-						data_uchar = (mb_u_char *)snippet->amplitude;
-					for (k = sample_start; k <= sample_end; k++) {
-						if (xtrack < 0.0)
-							xtrackss = xtrack - ss_spacing_use * (k - sample_detect);
-						else
-							xtrackss = xtrack + ss_spacing_use * (k - sample_detect);
-						kk = nss / 2 + (int)(xtrackss / (*pixel_size));
-						kk = MIN(MAX(0, kk), nss - 1);
-						if ((beam->sample_type & 15) == 3)
-							ss[kk] += (double)data_uint[k - snippet->begin_sample];
-						else if ((beam->sample_type & 15) == 2)
-							ss[kk] += (double)data_ushort[k - snippet->begin_sample];
-						else
-							ss[kk] += (double)data_uchar[k - snippet->begin_sample];
-						ssalongtrack[kk] += bathymetry->alongtrack[ibeam];
-						ss_cnt[kk]++;
-						/* fprintf(stderr,"ibeam:%d k:%d kk:%d ss_cnt:%d ss:%f xtrackss:%f %f ssalongtrack:%f \n",
-						ibeam,k,kk,ss_cnt[kk],ss[kk], xtrackss, (k-nss/2)*(*pixel_size), ssalongtrack[kk]); */
-					}
-				}
-			}
+	/* without threads read, preprocess and write each record in turn */
+	while (status == MB_SUCCESS && threaded == MB_NO) {
+		read_status = (*imb_io_ptr->mb_io_read_ping)(verbose, imbio_ptr, (void *)store, &read_error);
+		if (read_status == MB_FAILURE && read_error > MB_ERROR_NO_ERROR)
+			break;
+		else if (read_status == MB_FAILURE)
+			continue;
+		(*nread)++;
+		if (store->kind == MB_DATA_DATA) {
+			status = mbsys_reson7k_preprocess(verbose, imbio_ptr, (void *)store, platform_ptr, preprocess_pars_ptr, &slot_error);
+			if (status == MB_FAILURE && slot_error < MB_ERROR_NO_ERROR)
+				status = MB_SUCCESS;
+			else if (status == MB_FAILURE)
+				*error = slot_error;
 		}
+		if (status == MB_SUCCESS)
+			status = (*omb_io_ptr->mb_io_write_ping)(verbose, ombio_ptr, (void *)store, error);
+		if (status == MB_SUCCESS)
+			(*nwritten)++;
+	}
 
-		/* use backscatter record - basically a pseudosidescan */
-		else if (source == R7KRECID_7kBackscatterImageData) {
-			/* get acrosstrack distance versus range table from bathymetry */
-			nrangetable = 0;
-			irangenadir = 0;
-			for (i = 0; i < bathymetry->number_beams; i++) {
-				if (mb_beam_ok(beamflag[i])) {
-					rangetable[nrangetable] = bathymetry->range[i];
-					acrosstracktable[nrangetable] = bathymetry->acrosstrack[i];
-					alongtracktable[nrangetable] = bathymetry->alongtrack[i];
-					if (nrangetable == 0 || fabs(acrosstracktable[nrangetable]) < acrosstracktablemin) {
-						irangenadir = nrangetable;
-						acrosstracktablemin = fabs(acrosstracktable[nrangetable]);
-					}
-					nrangetable++;
-				}
-			}
+	/* reaching the end of the input is success */
+	if (status == MB_SUCCESS && read_status == MB_FAILURE && read_error != MB_ERROR_EOF) {
+		status = MB_FAILURE;
+		*error = read_error;
+	}
+	else if (status == MB_SUCCESS)
+		*error = MB_ERROR_NO_ERROR;
 
-			/* lay out port side */
-			data_uchar = (mb_u_char *)backscatter->port_data;
-			data_ushort = (unsigned short *)backscatter->port_data;
-			data_uint = (unsigned int *)backscatter->port_data;
-			sample_start = rangetable[irangenadir] * volatilesettings->sample_rate;
-			sample_end = MIN(rangetable[0] * volatilesettings->sample_rate, backscatter->number_samples - 1);
-			irange = irangenadir;
-			for (i = sample_start; i < sample_end; i++) {
-				range = ((double)i) / ((double)volatilesettings->sample_rate);
-				found = MB_NO;
-				for (j = irange; j > 0 && found == MB_NO; j--) {
-					if (range >= rangetable[j] && range < rangetable[j - 1]) {
-						irange = j;
-						found = MB_YES;
-					}
-				}
-				factor = (range - rangetable[irange]) / (rangetable[irange - 1] - rangetable[irange]);
-				xtrackss = acrosstracktable[irange] + factor * (acrosstracktable[irange - 1] - acrosstracktable[irange]);
-				ltrackss = alongtracktable[irange] + factor * (alongtracktable[irange - 1] - alongtracktable[irange]);
-				kk = nss / 2 + (int)(xtrackss / (*pixel_size));
-				if (kk >= 0 && kk < nss) {
-					if (backscatter->sample_size == 1)
-						ss[kk] += (double)data_uchar[i];
-					else if (backscatter->sample_size == 2)
-						ss[kk] += (double)data_ushort[i];
-					else
-						ss[kk] += (double)data_uint[i];
-					ssalongtrack[kk] += ltrackss;
-					ss_cnt[kk]++;
-				}
-			}
+	/* release the read store */
+	if (store != NULL)
+		mbsys_reson7k_deall(verbose, imbio_ptr, (void **)&store, &slot_error);
 
-			/* lay out starboard side */
-			data_uchar = (mb_u_char *)backscatter->stbd_data;
-			data_ushort = (unsigned short *)backscatter->stbd_data;
-			data_uint = (unsigned int *)backscatter->stbd_data;
-			sample_start = rangetable[irangenadir] * volatilesettings->sample_rate;
-			sample_end = MIN(rangetable[nrangetable - 1] * volatilesettings->sample_rate, backscatter->number_samples - 1);
-			irange = irangenadir;
-			for (i = sample_start; i < sample_end; i++) {
-				range = ((double)i) / ((double)volatilesettings->sample_rate);
-				found = MB_NO;
-				for (j = irange; j < nrangetable - 1 && found == MB_NO; j++) {
-					if (range >= rangetable[j] && range < rangetable[j + 1]) {
-						irange = j;
-						found = MB_YES;
-					}
-				}
-				factor = (range - rangetable[irange]) / (rangetable[irange + 1] - rangetable[irange]);
-				xtrackss = acrosstracktable[irange] + factor * (acrosstracktable[irange + 1] - acrosstracktable[irange]);
-				ltrackss = alongtracktable[irange] + factor * (alongtracktable[irange + 1] - alongtracktable[irange]);
-				kk = nss / 2 + (int)(xtrackss / (*pixel_size));
-				if (kk >= 0 && kk < nss) {
-					if (backscatter->sample_size == 1)
-						ss[kk] += (double)data_uchar[i];
-					else if (backscatter->sample_size == 2)
-						ss[kk] += (double)data_ushort[i];
-					else
-						ss[kk] += (double)data_uint[i];
-					ssalongtrack[kk] += ltrackss;
-					ss_cnt[kk]++;
-				}
-			}
-		}
+	/* print output debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       nread:      %d\n", *nread);
+		fprintf(stderr, "dbg2       nwritten:   %d\n", *nwritten);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
+		fprintf(stderr, "dbg2  Return status:\n");
+		fprintf(stderr, "dbg2       status:     %d\n", status);
+	}
 
-		/* average the sidescan */
-		first = nss;
-		last = -1;
-		for (k = 0; k < nss; k++) {
-			if (ss_cnt[k] > 0) {
-				ss[k] /= ss_cnt[k];
-				ssalongtrack[k] /= ss_cnt[k];
-				first = MIN(first, k);
-				last = k;
-			}
-			else
-				ss[k] = MB_SIDESCAN_NULL;
+	/* return status */
+	return (status);
+}
+/*--------------------------------------------------------------------*/
+#ifdef MBSYS_RESON7K_PTHREADS
+void *mbsys_reson7k_pipeline_preprocess(void *work_ptr) {
+	struct mbsys_reson7k_pipelineworker_struct *worker;
+	struct mbsys_reson7k_pipeline_struct *pipeline;
+	struct mbsys_reson7k_struct *store;
+	int status;
+	int error;
+	int eof;
+	int nwait = 0;
+	int n, k;
+
+	worker = (struct mbsys_reson7k_pipelineworker_struct *)work_ptr;
+	pipeline = worker->pipeline;
+
+	/* claim the records in the order read and preprocess the pings - the
+	    end of the input is checked before the records read so that no
+	    record read before it is missed */
+	while (atomic_load(&pipeline->abort) == MB_NO) {
+		eof = atomic_load(&pipeline->eof);
+		n = atomic_load(&pipeline->nclaim);
+		if (n >= atomic_load(&pipeline->nread)) {
+			if (eof == MB_YES)
+				break;
+			mbsys_reson7k_pipeline_wait(&nwait);
+			continue;
 		}
+		if (!atomic_compare_exchange_weak(&pipeline->nclaim, &n, n + 1))
+			continue;
+		nwait = 0;
+		k = n % pipeline->nslot;
+		atomic_store(&(pipeline->slot_state[k]), MBSYS_RESON7K_PIPELINE_BUSY);
+		store = pipeline->slot_store[k];
 
-		/* interpolate the sidescan */
-		k1 = first;
-		k2 = first;
-		for (k = first + 1; k < last; k++) {
-			if (ss_cnt[k] <= 0) {
-				if (k2 <= k) {
-					k2 = k + 1;
-					while (k2 < last && ss_cnt[k2] <= 0)
-						k2++;
-				}
-				if (k2 - k1 <= pixel_int_use) {
-					ss[k] = ss[k1] + (ss[k2] - ss[k1]) * ((double)(k - k1)) / ((double)(k2 - k1));
-					ssacrosstrack[k] = (k - nss / 2) * (*pixel_size);
-					ssalongtrack[k] =
-					    ssalongtrack[k1] + (ssalongtrack[k2] - ssalongtrack[k1]) * ((double)(k - k1)) / ((double)(k2 - k1));
-				}
-			}
-			else {
-				k1 = k;
-			}
-		}
+		status = MB_SUCCESS;
+		error = MB_ERROR_NO_ERROR;
+		if (store->kind == MB_DATA_DATA)
+			status = mbsys_reson7k_preprocess(pipeline->verbose, (void *)worker->mbio_ptr, (void *)store,
+			                                  pipeline->platform_ptr, pipeline->preprocess_pars_ptr, &error);
 
-		/* embed the sidescan into the processed sidescan record */
-		store->read_processedsidescan = MB_YES;
-		processedsidescan->header = bathymetry->header;
-		processedsidescan->header.Offset = R7KRECID_ProcessedSidescan;
-		processedsidescan->header.Size =
-		    MBSYS_RESON7K_RECORDHEADER_SIZE + MBSYS_RESON7K_RECORDTAIL_SIZE + R7KHDRSIZE_ProcessedSidescan + nss * 8;
-		processedsidescan->header.OptionalDataOffset = 0;
-		processedsidescan->header.OptionalDataIdentifier = 0;
-		processedsidescan->header.RecordType = R7KRECID_ProcessedSidescan;
-		processedsidescan->serial_number = bathymetry->serial_number;
-		processedsidescan->ping_number = bathymetry->ping_number;
-		processedsidescan->multi_ping = bathymetry->multi_ping;
-		processedsidescan->recordversion = 1;
-		processedsidescan->ss_source = source;
-		processedsidescan->number_pixels = nss;
-		processedsidescan->ss_type = MB_SIDESCAN_LINEAR;
-		processedsidescan->pixelwidth = *pixel_size;
-		processedsidescan->sonardepth = -bathymetry->vehicle_height + reference->water_z;
-		processedsidescan->altitude = bathymetry->depth[iminxtrack] - processedsidescan->sonardepth;
-		for (i = 0; i < MBSYS_RESON7K_MAX_PIXELS; i++) {
-			processedsidescan->sidescan[i] = ss[i];
-			processedsidescan->alongtrack[i] = ssalongtrack[i];
+		pipeline->slot_status[k] = status;
+		pipeline->slot_error[k] = error;
+		atomic_store(&(pipeline->slot_state[k]), MBSYS_RESON7K_PIPELINE_DONE);
+	}
+
+	return (NULL);
+}
+/*--------------------------------------------------------------------*/
+void *mbsys_reson7k_pipeline_write(void *work_ptr) {
+	struct mbsys_reson7k_pipeline_struct *pipeline;
+	struct mb_io_struct *omb_io_ptr;
+	struct mb_io_struct *wmb_io_ptr;
+	struct mbsys_reson7k_struct *store;
+	int status;
+	int error;
+	int nwait;
+	int n, k;
+
+	pipeline = (struct mbsys_reson7k_pipeline_struct *)work_ptr;
+	omb_io_ptr = (struct mb_io_struct *)pipeline->ombio_ptr;
+	wmb_io_ptr = pipeline->wmbio_ptr;
+
+	/* write the records in the order read as they are preprocessed, making
+	    the sidescan left by the workers first so that the pixel size and
+	    swath width follow the pings as without threads - pings that failed
+	    to preprocess with a nonfatal error are written as read */
+	while (MB_YES) {
+		n = atomic_load(&pipeline->nwritten);
+		k = n % pipeline->nslot;
+		nwait = 0;
+		while (atomic_load(&(pipeline->slot_state[k])) != MBSYS_RESON7K_PIPELINE_DONE) {
+			if (atomic_load(&pipeline->eof) == MB_YES && n >= atomic_load(&pipeline->nread))
+				break;
+			mbsys_reson7k_pipeline_wait(&nwait);
+		}
+		if (atomic_load(&(pipeline->slot_state[k])) != MBSYS_RESON7K_PIPELINE_DONE)
+			break;
+
+		store = pipeline->slot_store[k];
+		status = pipeline->slot_status[k];
+		error = pipeline->slot_error[k];
+		if (store->makess_source != R7KRECID_None) {
+			error = MB_ERROR_NO_ERROR;
+			status = mbsys_reson7k_makess(pipeline->verbose, (void *)wmb_io_ptr, (void *)store, store->makess_source, MB_NO,
+			                              (double *)&wmb_io_ptr->saved1, MB_NO, (double *)&wmb_io_ptr->saved2, MB_YES, &error);
+			store->makess_source = R7KRECID_None;
+		}
+		if (status == MB_SUCCESS || error < MB_ERROR_NO_ERROR) {
+			error = MB_ERROR_NO_ERROR;
+			status = (*omb_io_ptr->mb_io_write_ping)(pipeline->verbose, pipeline->ombio_ptr, (void *)store, &error);
 		}
 
-		/* print debug statements */
-		if (verbose >= 2) {
-			fprintf(stderr, "\ndbg2  Sidescan regenerated in <%s>\n", function_name);
-			fprintf(stderr, "dbg2       pixels_ss:  %d\n", nss);
-			for (i = 0; i < nss; i++)
-				fprintf(stderr, "dbg2       pixel:%4d  cnt:%3d  ss:%10f  xtrack:%10f  ltrack:%10f\n", i, ss_cnt[i], ss[i],
-				        ssacrosstrack[i], ssalongtrack[i]);
+		/* stop every stage on failure, otherwise hand the slot back */
+		if (status == MB_FAILURE) {
+			pipeline->status = status;
+			pipeline->error = error;
+			atomic_store(&pipeline->abort, MB_YES);
+			break;
 		}
+		atomic_store(&(pipeline->slot_state[k]), MBSYS_RESON7K_PIPELINE_FREE);
+		atomic_store(&pipeline->nwritten, n + 1);
+	}
+
+	return (NULL);
+}
+/*--------------------------------------------------------------------*/
+void mbsys_reson7k_pipeline_wait(int *nwait) {
+	struct timespec sleep;
+
+	/* yield to the other stages for a while, then sleep between polls so
+	    that a stage waiting on a slow one does not keep a processor busy */
+	if (*nwait < MBSYS_RESON7K_PIPELINE_SPIN) {
+		(*nwait)++;
+		sched_yield();
+	}
+	else {
+		sleep.tv_sec = 0;
+		sleep.tv_nsec = 1000 * MBSYS_RESON7K_PIPELINE_SLEEP;
+		nanosleep(&sleep, NULL);
+	}
+}
+/*--------------------------------------------------------------------*/
+int mbsys_reson7k_pipeline_mbio(int verbose, void *imbio_ptr, struct mb_io_struct **mbio_ptr, int *error) {
+	char *function_name = "mbsys_reson7k_pipeline_mbio";
+	int status = MB_SUCCESS;
+	struct mb_io_struct *imb_io_ptr;
+	void *store_ptr = NULL;
+
+	/* print input debug statements */
+	if (verbose >= 2) {
+		fprintf(stderr, "\ndbg2  MBIO function <%s> called\n", function_name);
+		fprintf(stderr, "dbg2  Revision id: %s\n", svn_id);
+		fprintf(stderr, "dbg2  Input arguments:\n");
+		fprintf(stderr, "dbg2       verbose:    %d\n", verbose);
+		fprintf(stderr, "dbg2       imbio_ptr:  %p\n", (void *)imbio_ptr);
+	}
+
+	/* get mbio descriptor */
+	imb_io_ptr = (struct mb_io_struct *)imbio_ptr;
+
+	/* make a descriptor for a pipeline stage holding only what preprocessing
+	    and the sidescan use - its own internal store, and the beam widths
+	    and the saved pixel size and swath width of the input descriptor -
+	    so that no file, buffer or save pointer of the input descriptor is
+	    reachable from another thread */
+	*mbio_ptr = NULL;
+	status = mb_mallocd(verbose, __FILE__, __LINE__, sizeof(struct mb_io_struct), (void **)mbio_ptr, error);
+	if (status == MB_SUCCESS) {
+		memset(*mbio_ptr, 0, sizeof(struct mb_io_struct));
+		(*mbio_ptr)->beamwidth_xtrack = imb_io_ptr->beamwidth_xtrack;
+		(*mbio_ptr)->beamwidth_ltrack = imb_io_ptr->beamwidth_ltrack;
+		(*mbio_ptr)->saved1 = imb_io_ptr->saved1;
+		(*mbio_ptr)->saved2 = imb_io_ptr->saved2;
+		status = mbsys_reson7k_alloc(verbose, imbio_ptr, &store_ptr, error);
+		if (status == MB_SUCCESS)
+			(*mbio_ptr)->store_data = store_ptr;
+		else
+			mb_freed(verbose, __FILE__, __LINE__, (void **)mbio_ptr, error);
 	}
 
 	/* print output debug statements */
 	if (verbose >= 2) {
 		fprintf(stderr, "\ndbg2  MBIO function <%s> completed\n", function_name);
-		fprintf(stderr, "dbg2  Return value:\n");
-		fprintf(stderr, "dbg2       pixel_size:      %f\n", *pixel_size);
-		fprintf(stderr, "dbg2       swath_width:     %f\n", *swath_width);
-		fprintf(stderr, "dbg2       error:           %d\n", *error);
+		fprintf(stderr, "dbg2  Return values:\n");
+		fprintf(stderr, "dbg2       mbio_ptr:   %p\n", (void *)*mbio_ptr);
+		fprintf(stderr, "dbg2       error:      %d\n", *error);
 		fprintf(stderr, "dbg2  Return status:\n");
-		fprintf(stderr, "dbg2       status:          %d\n", status);
+		fprintf(stderr, "dbg2       status:     %d\n", status);
 	}
 
 	/* return status */
 	return (status);
 }
+#endif
+/*--------------------------------------------------------------------*/
+double mbsys_reson7k_select(double *values, int n, int k) {
+	double pivot, value;
+	int left, right, i, j;
+
+	/* partially order the values so that values[k] is the value that would
+	    be there after sorting (Hoare's selection) - expected O(n), compared
+	    with O(n log n) for a full sort */
+	left = 0;
+	right = n - 1;
+	while (right > left) {
+		/* use the median of three values as the pivot */
+		i = (left + right) / 2;
+		if (values[i] < values[left]) {
+			value = values[i];
+			values[i] = values[left];
+			values[left] = value;
+		}
+		if (values[right] < values[left]) {
+			value = values[right];
+			values[right] = values[left];
+			values[left] = value;
+		}
+		if (values[right] < values[i]) {
+			value = values[right];
+			values[right] = values[i];
+			values[i] = value;
+		}
+		pivot = values[i];
+
+		/* partition about the pivot */
+		i = left;
+		j = right;
+		while (i <= j) {
+			while (values[i] < pivot)
+				i++;
+			while (values[j] > pivot)
+				j--;
+			if (i <= j) {
+				value = values[i];
+				values[i] = values[j];
+				values[j] = value;
+				i++;
+				j--;
+			}
+		}
+
+		/* continue in the part holding k */
+		if (k <= j)
+			right = j;
+		else if (k >= i)
+			left = i;
+		else
+			break;
+	}
+
+	return (values[k]);
+}
 /*--------------------------------------------------------------------*/
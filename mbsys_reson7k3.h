@@ -77,6 +77,7 @@
 #include "mb_define.h"
 #include stdint.h
 #endif
+#include <stdatomic.h>
 
 /*---------------------------------------------------------------*/
 /* Record ID definitions */
@@ -251,6 +252,7 @@
 #define R7KHDRSIZE_7kMB2Status 2088
 #define R7KHDRSIZE_7kFileHeader 44
 #define R7KRDTSIZE_7kFileHeader 272
+#define R7KOPTSIZE_7kFileHeader 12
 #define R7KHDRSIZE_7kFileCatalogRecord 14
 #define R7KRDTSIZE_7kFileCatalogRecord 48
 #define R7KHDRSIZE_7kTimeMessage 16
@@ -347,9 +349,245 @@
 #define MBSYS_RESON7K_BUFFER_STARTSIZE 32768
 #define MBSYS_RESON7K_MAX_DEVICE 71
 #define MBSYS_RESON7K_MAX_RECEIVERS 1024
-#define MBSYS_RESON7K_MAX_BEAMS 1024
+#define MBSYS_RESON7K_MAX_BEAMS 1024 /* Initial beam capacity - the beam arrays grow beyond this as needed */
 #define MBSYS_RESON7K_MAX_PIXELS 4096
 
+/* Released stores kept per process for reuse by mbsys_reson7k_alloc() -
+   none unless a limit up to the maximum is set with
+   mbsys_reson7k_set_storepool(); pooled stores are freed with
+   mbsys_reson7k_free_storepool() */
+#define MBSYS_RESON7K_STOREPOOL_DEFAULT 0
+#define MBSYS_RESON7K_STOREPOOL_MAX 1024
+
+/* Largest difference in beam direction (degrees) allowed between the batch
+   beam angle calculation of mbsys_reson7k_beam_geometry() and mb_beaudoin()
+   by mbsys_reson7k_beam_geometry_check() */
+#define MBSYS_RESON7K_BEAUDOIN_TOLERANCE 0.001
+
+/* Threads calculating beam angles in preprocessing - at most the maximum,
+   and no more than one for each MBSYS_RESON7K_PREPROCESS_THREADS_BEAMS beams */
+#define MBSYS_RESON7K_PREPROCESS_THREADS_MAX 16
+#define MBSYS_RESON7K_PREPROCESS_THREADS_BEAMS 64
+
+/* Threads binning snippets into sidescan in mbsys_reson7k_makess() - at most
+   the maximum, and no more than one for each MBSYS_RESON7K_MAKESS_THREADS_BEAMS
+   snippets */
+#define MBSYS_RESON7K_MAKESS_THREADS_MAX 16
+#define MBSYS_RESON7K_MAKESS_THREADS_BEAMS 32
+
+/* Threads extracting pings in mbsys_reson7k_extract_batch() - at most the
+   maximum, and no more than one for each MBSYS_RESON7K_BATCH_THREADS_PINGS
+   pings */
+#define MBSYS_RESON7K_BATCH_THREADS_MAX 16
+#define MBSYS_RESON7K_BATCH_THREADS_PINGS 8
+
+/* Pings held by the ordered write queue of an output file - at most the
+   maximum, set with mbsys_reson7k_set_writequeue() */
+#define MBSYS_RESON7K_WRITEQUEUE_MAX 16
+
+/* Attitude fields present in a series returned by
+   mbsys_reson7k_extract_attitude() */
+#define MBSYS_RESON7K_ATTITUDE_ROLL 0x01
+#define MBSYS_RESON7K_ATTITUDE_PITCH 0x02
+#define MBSYS_RESON7K_ATTITUDE_HEAVE 0x04
+#define MBSYS_RESON7K_ATTITUDE_HEADING 0x08
+#define MBSYS_RESON7K_ATTITUDE_RPH 0x07
+
+/* Ancillary time series held by each mbio descriptor for interpolation at
+   ping times (see mbsys_reson7k_tseries_add()) - each is a ring buffer of up
+   to MBSYS_RESON7K_TSERIES_MAX samples, allocated in steps of at least
+   MBSYS_RESON7K_TSERIES_ALLOC samples, with up to
+   MBSYS_RESON7K_TSERIES_FIELDS values per sample */
+#define MBSYS_RESON7K_TSERIES_NAV 0        /* longitude, latitude, speed */
+#define MBSYS_RESON7K_TSERIES_HEADING 1    /* heading */
+#define MBSYS_RESON7K_TSERIES_ATTITUDE 2   /* roll, pitch, heave */
+#define MBSYS_RESON7K_TSERIES_ALTITUDE 3   /* altitude */
+#define MBSYS_RESON7K_TSERIES_SONARDEPTH 4 /* sonar depth */
+#define MBSYS_RESON7K_TSERIES_NUM 5
+#define MBSYS_RESON7K_TSERIES_FIELDS 3
+#define MBSYS_RESON7K_TSERIES_MAX 65536
+#define MBSYS_RESON7K_TSERIES_ALLOC 1024
+
+/* Interpolation of the values of a time series */
+#define MBSYS_RESON7K_TSERIES_LINEAR 0    /* linear */
+#define MBSYS_RESON7K_TSERIES_AZIMUTH 1   /* shorter way round, 0 to 360 degrees */
+#define MBSYS_RESON7K_TSERIES_LONGITUDE 2 /* shorter way round, -180 to 180 degrees */
+
+/* Time windows of an input file (see mbr_reson7kr_open_window()) - reading
+   starts MBSYS_RESON7K_WINDOW_MARGIN seconds before the window, or earlier
+   if needed to include the last navigation, heading, attitude and sonar
+   depth records before it, looking back at most
+   MBSYS_RESON7K_WINDOW_LOOKBACK seconds */
+#define MBSYS_RESON7K_WINDOW_MARGIN 10.0
+#define MBSYS_RESON7K_WINDOW_LOOKBACK 600.0
+
+/* Source of the record index of an input file */
+#define MBSYS_RESON7K_FILEINDEX_NONE 0    /* not loaded */
+#define MBSYS_RESON7K_FILEINDEX_CATALOG 1 /* read from the 7300 file catalog */
+#define MBSYS_RESON7K_FILEINDEX_SCAN 2    /* built by scanning the record headers */
+
+/* Columnar sounding export (see mbsys_reson7k_columnar_open()) - a little
+   endian file holding a 32 byte header, chunks of up to chunk_pings survey
+   pings with each column stored contiguously at an 8 byte aligned offset,
+   a footer index and a 24 byte trailer. The header holds the magic, the
+   version, the number of columns, the beams per ping and the pings per
+   chunk. The footer holds the number of chunks and columns, then for each
+   chunk its offset and number of pings followed, for each column, by the
+   offset, size, number of values and the minimum and maximum values. Only
+   beams that are not null are counted in the statistics. The trailer holds
+   the footer offset, the footer size and the magic again. Ping columns hold
+   one value per ping and beam columns hold beams_per_ping values per ping */
+#define MBSYS_RESON7K_COLUMNAR_MAGIC "MB7KCOLS"
+#define MBSYS_RESON7K_COLUMNAR_VERSION 1
+#define MBSYS_RESON7K_COLUMNAR_HEADER_SIZE 32
+#define MBSYS_RESON7K_COLUMNAR_TRAILER_SIZE 24
+#define MBSYS_RESON7K_COLUMNAR_CHUNK_SIZE 16
+#define MBSYS_RESON7K_COLUMNAR_ENTRY_SIZE 40
+#define MBSYS_RESON7K_COLUMNAR_CHUNK_PINGS 1024
+#define MBSYS_RESON7K_COLUMN_TIME 0        /* f64 ping time (epoch seconds) */
+#define MBSYS_RESON7K_COLUMN_NAVLON 1      /* f64 longitude (degrees) */
+#define MBSYS_RESON7K_COLUMN_NAVLAT 2      /* f64 latitude (degrees) */
+#define MBSYS_RESON7K_COLUMN_HEADING 3     /* f64 heading (degrees) */
+#define MBSYS_RESON7K_COLUMN_NBATH 4       /* i32 number of beams */
+#define MBSYS_RESON7K_COLUMN_BEAMFLAG 5    /* u8 beam flags */
+#define MBSYS_RESON7K_COLUMN_BATH 6        /* f64 depth (m) */
+#define MBSYS_RESON7K_COLUMN_ACROSSTRACK 7 /* f64 acrosstrack distance (m) */
+#define MBSYS_RESON7K_COLUMN_ALONGTRACK 8  /* f64 alongtrack distance (m) */
+#define MBSYS_RESON7K_COLUMN_AMP 9         /* f64 intensity (dB) */
+#define MBSYS_RESON7K_COLUMN_UNCERTAINTY 10 /* f64 detection uncertainty */
+#define MBSYS_RESON7K_COLUMN_NUM 11
+
+/* Largest number of pixels of high resolution sidescan made by
+   mbsys_reson7k_makess_hires() - the pixel size is increased if the
+   swath would need more */
+#define MBSYS_RESON7K_HIRES_MAX_PIXELS 262144
+
+/* Ray tracing tables - takeoff angles from 0 to 90 degrees in steps of
+   90 / (MBSYS_RESON7K_RAYTABLE_NANGLE - 1) degrees, rebuilt when the SVP
+   changes or when the transducer depth or sound speed differ from those of
+   the table by more than the tolerances */
+#define MBSYS_RESON7K_RAYTABLE_NANGLE 361
+#define MBSYS_RESON7K_RAYTABLE_DRAFTTOLERANCE 0.1
+#define MBSYS_RESON7K_RAYTABLE_SOUNDSPEEDTOLERANCE 0.1
+
+/* Read - preprocess - write pipeline - the records read are queued in a
+   ring of 2 * nworkers + 2 stores between the reader, the preprocessing
+   workers and the writer (see mbsys_reson7k_preprocess_pipeline()) */
+#define MBSYS_RESON7K_PIPELINE_WORKERS_MAX 16
+#define MBSYS_RESON7K_PIPELINE_SLOTS_MAX (2 * MBSYS_RESON7K_PIPELINE_WORKERS_MAX + 2)
+#define MBSYS_RESON7K_PIPELINE_FREE 0
+#define MBSYS_RESON7K_PIPELINE_READ 1
+#define MBSYS_RESON7K_PIPELINE_BUSY 2
+#define MBSYS_RESON7K_PIPELINE_DONE 3
+/* Number of times a pipeline stage yields while waiting on another stage
+   before it sleeps between polls, and the sleep in microseconds */
+#define MBSYS_RESON7K_PIPELINE_SPIN 64
+#define MBSYS_RESON7K_PIPELINE_SLEEP 100
+
+/* Ancillary scan - the time series arrays of the preprocessing parameters
+   are grown by at least this many samples at a time */
+#define MBSYS_RESON7K_SCAN_ALLOC 4096
+
+/* Raw record pass-through slots - the bytes of each ping record and of
+   the most recent non-ping record are kept as read so that records not
+   modified by the application can be written back verbatim */
+#define R7KRAW_VolatileSonarSettings 0
+#define R7KRAW_MatchFilter 1
+#define R7KRAW_BeamGeometry 2
+#define R7KRAW_RemoteControlSonarSettings 3
+#define R7KRAW_BathymetricData 4
+#define R7KRAW_ProcessedSidescan 5
+#define R7KRAW_BackscatterImageData 6
+#define R7KRAW_BeamData 7
+#define R7KRAW_VerticalDepth 8
+#define R7KRAW_TVGData 9
+#define R7KRAW_ImageData 10
+#define R7KRAW_PingMotion 11
+#define R7KRAW_DetectionSetup 12
+#define R7KRAW_BeamformedData 13
+#define R7KRAW_Detection 14
+#define R7KRAW_RawDetection 15
+#define R7KRAW_SnippetData 16
+#define R7KRAW_CalibratedSnippetData 17
+#define R7KRAW_CompressedWaterColumn 18
+#define R7KRAW_Other 19
+#define R7KRAW_NUM 20
+
+/* Payloads with variable length arrays that a store may share with its
+   copies - mbsys_reson7k_copy() makes the copy reference the arrays of
+   these records, and the arrays are only duplicated when one of the
+   stores holding them is modified */
+#define R7KSHARE_Attitude 0
+#define R7KSHARE_Motion 1
+#define R7KSHARE_Svp 2
+#define R7KSHARE_Ctd 3
+#define R7KSHARE_FsdwssLo 4
+#define R7KSHARE_FsdwssHi 5
+#define R7KSHARE_Fsdwsb 6
+#define R7KSHARE_Configuration 7
+#define R7KSHARE_BeamGeometry 8
+#define R7KSHARE_Bathymetry 9
+#define R7KSHARE_Backscatter 10
+#define R7KSHARE_Beam 11
+#define R7KSHARE_Tvg 12
+#define R7KSHARE_Image 13
+#define R7KSHARE_SystemEventMessage 14
+#define R7KSHARE_FileHeader 15
+#define R7KSHARE_RawRecord 16 /* First of R7KRAW_NUM raw record slots */
+#define R7KSHARE_NUM (R7KSHARE_RawRecord + R7KRAW_NUM)
+
+/* Ping record registry - bit R7KRAW_* of the read_mask of a store is set
+   once the corresponding record of the current ping has been read, so the
+   bits are in the order the records of a ping are written */
+#define R7KREAD_VolatileSettings (1u << R7KRAW_VolatileSonarSettings)
+#define R7KREAD_MatchFilter (1u << R7KRAW_MatchFilter)
+#define R7KREAD_BeamGeometry (1u << R7KRAW_BeamGeometry)
+#define R7KREAD_RemoteControlSettings (1u << R7KRAW_RemoteControlSonarSettings)
+#define R7KREAD_Bathymetry (1u << R7KRAW_BathymetricData)
+#define R7KREAD_ProcessedSidescan (1u << R7KRAW_ProcessedSidescan)
+#define R7KREAD_Backscatter (1u << R7KRAW_BackscatterImageData)
+#define R7KREAD_Beam (1u << R7KRAW_BeamData)
+#define R7KREAD_VerticalDepth (1u << R7KRAW_VerticalDepth)
+#define R7KREAD_Tvg (1u << R7KRAW_TVGData)
+#define R7KREAD_Image (1u << R7KRAW_ImageData)
+#define R7KREAD_V2PingMotion (1u << R7KRAW_PingMotion)
+#define R7KREAD_V2DetectionSetup (1u << R7KRAW_DetectionSetup)
+#define R7KREAD_V2Beamformed (1u << R7KRAW_BeamformedData)
+#define R7KREAD_V2Detection (1u << R7KRAW_Detection)
+#define R7KREAD_V2RawDetection (1u << R7KRAW_RawDetection)
+#define R7KREAD_V2Snippet (1u << R7KRAW_SnippetData)
+#define R7KREAD_CalibratedSnippet (1u << R7KRAW_CalibratedSnippetData)
+#define R7KREAD_CompressedWaterColumn (1u << R7KRAW_CompressedWaterColumn)
+#define R7KREAD_ALL ((1u << R7KRAW_Other) - 1)
+
+/* Ping complete masks - if one is set with mbsys_reson7k_set_pingcomplete()
+   a ping is returned as soon as all of the records of the mask are read,
+   rather than when the first record of the next ping arrives (see
+   mbsys_reson7k_pingcomplete_mask() for the masks suggested per sonar) */
+#define R7KREAD_SETTINGS (R7KREAD_VolatileSettings | R7KREAD_MatchFilter | R7KREAD_BeamGeometry | R7KREAD_RemoteControlSettings)
+#define R7KREAD_OPTIONAL_7K (R7KREAD_ProcessedSidescan | R7KREAD_Tvg | R7KREAD_CalibratedSnippet | R7KREAD_CompressedWaterColumn)
+#define R7KREAD_COMPLETE_7K (R7KREAD_ALL & ~R7KREAD_OPTIONAL_7K)
+#define R7KREAD_COMPLETE_TSERIES (R7KREAD_SETTINGS | R7KREAD_V2DetectionSetup | R7KREAD_V2RawDetection)
+
+/* 7042 compressed water column flag bits supported when 7018 beamformed
+   data are converted on output (see s7kr_compressedwatercolumn) */
+#define R7KWC_CLIPBOTTOM 0x0001
+#define R7KWC_MAGNITUDEONLY 0x0002
+#define R7KWC_8BITDB 0x0004
+#define R7KWC_DIVISOR_MASK 0x00F0
+#define R7KWC_DIVISOR_SHIFT 4
+#define R7KWC_DOWNSAMPLE_MASK 0x0F00
+#define R7KWC_DOWNSAMPLE_NONE 0x0000
+#define R7KWC_DOWNSAMPLE_MIDDLE 0x0100
+#define R7KWC_DOWNSAMPLE_PEAK 0x0200
+#define R7KWC_DOWNSAMPLE_AVERAGE 0x0300
+#define R7KWC_SUPPORTED (R7KWC_CLIPBOTTOM | R7KWC_MAGNITUDEONLY | R7KWC_8BITDB | R7KWC_DIVISOR_MASK | R7KWC_DOWNSAMPLE_MASK)
+
+/* further 7042 flag bits recognized when 7042 records are read */
+#define R7KWC_32BIT 0x1000
+#define R7KWC_SEGMENTNUMBERS 0x4000
+#define R7KWC_RXDELAY 0x8000
+
 /*---------------------------------------------------------------*/
 
 /* Data type definitions */ 
@@ -991,7 +1229,8 @@ typedef struct s7kr_configuration_struct {
 	s7k_header header;
 	u64 serial_number;                           /* Sonar serial number */
 	u64 number_devices;                          /* Number of devices */
-	s7k_device device[MBSYS_RESON7K_MAX_DEVICE]; /* Device configuration information */
+	u32 nalloc;                                  /* Number of devices allocated */
+	s7k_device *device;                          /* Device configuration information */
 } s7kr_configuration;
 
 /* Reson 7k match filter (record 7002) */
@@ -1030,10 +1269,11 @@ typedef struct s7kr_beamgeometry_struct {
 	s7k_header header;
 	u64 serial_number;                                  /* Sonar serial number */
 	u32 number_beams;                                   /* Number of receiver beams */
-	f32 angle_alongtrack[MBSYS_RESON7K_MAX_BEAMS];      /* Receiver beam X direction angle (radians) */
-	f32 angle_acrosstrack[MBSYS_RESON7K_MAX_BEAMS];     /* Receiver beam Y direction angle (radians) */
-	f32 beamwidth_alongtrack[MBSYS_RESON7K_MAX_BEAMS];  /* Receiver beamwidth X (radians) */
-	f32 beamwidth_acrosstrack[MBSYS_RESON7K_MAX_BEAMS]; /* Receiver beamwidth Y (radians) */
+	u32 nalloc;                                         /* Number of beams allocated */
+	f32 *angle_alongtrack;                              /* Receiver beam X direction angle (radians) */
+	f32 *angle_acrosstrack;                             /* Receiver beam Y direction angle (radians) */
+	f32 *beamwidth_alongtrack;                          /* Receiver beamwidth X (radians) */
+	f32 *beamwidth_acrosstrack;                         /* Receiver beamwidth Y (radians) */
 	f32 tx_delay;                                       /* Tx delay for the beam in fractional samples,
 	                                                         zero when not applicable.
 	                                                         Up to now Tx Delay is only supported for the
@@ -1052,6 +1292,7 @@ typedef struct s7kr_bathymetry_struct {
 	                           0 = no multi-ping
 	                          >0 = sequence number of ping in the multi-ping sequence */
 	u32 number_beams;    /* Number of receiver beams */
+	u32 nalloc;          /* Number of beams allocated */
 	u8 layer_comp_flag;  /* Bit field:
 	                           Bit   0: Layer compensation
 	                           0 = off
@@ -1064,8 +1305,8 @@ typedef struct s7kr_bathymetry_struct {
 	                           0 = measured
 	                           1 = manually entered */
 	f32 sound_velocity;  /* Sound veocity at the sonar (m/sec) */
-	f32 range[MBSYS_RESON7K_MAX_BEAMS];  /* Two way travel time (seconds) */
-	u8 quality[MBSYS_RESON7K_MAX_BEAMS]; /* Beam quality bitfield:
+	f32 *range;          /* Two way travel time (seconds) */
+	u8 *quality;         /* Beam quality bitfield:
 	                                           Bit 0: Brightness test
 	                                           1 - Pass
 	                                           0 - Fail
@@ -1083,11 +1324,11 @@ typedef struct s7kr_bathymetry_struct {
 	                                           1 - Fail
 	                                           0 - Pass
 	                                           Bit 6-7: Reserved */
-	f32 intensity[MBSYS_RESON7K_MAX_BEAMS];       /* Intensity: Bottom reflectivity. This is a relative
+	f32 *intensity;                               /* Intensity: Bottom reflectivity. This is a relative
 	                                                 value (not calibrated) */
-	f32 min_depth_gate[MBSYS_RESON7K_MAX_BEAMS];  /* Minimum two-way travel time to filter point
+	f32 *min_depth_gate;                          /* Minimum two-way travel time to filter point
 	                                                 for each beam (minimum depth gate) */
-	f32 max_depth_gate[MBSYS_RESON7K_MAX_BEAMS];  /* Maximum two-way travel time to filter point
+	f32 *max_depth_gate;                          /* Maximum two-way travel time to filter point
 	                                                 for each beam (maximum depth gate) */
 	u32 optionaldata;                             /* Flag indicating if bathymetry calculated and
 	                                                 values below filled in
@@ -1111,11 +1352,11 @@ typedef struct s7kr_bathymetry_struct {
 	f32 pitch;                                /* Pitch at transmit time */
 	f32 heave;                                /* Heave at transmit time in m*/
 	f32 vehicle_depth ;                       /* Vehicle depth at transmit time in m */
-	f32 depth[MBSYS_RESON7K_MAX_BEAMS];       /* Depth releative to chart datum in meters */
-	f32 alongtrack[MBSYS_RESON7K_MAX_BEAMS];  /* Alongtrack distance in meters */
-	f32 acrosstrack[MBSYS_RESON7K_MAX_BEAMS];    /* Acrosstrack distance in meters */
-	f32 pointing_angle[MBSYS_RESON7K_MAX_BEAMS]; /* Pointing angle from vertical in radians */
-	f32 azimuth_angle[MBSYS_RESON7K_MAX_BEAMS];  /* Azimuth angle in radians */
+	f32 *depth;                               /* Depth releative to chart datum in meters */
+	f32 *alongtrack;                          /* Alongtrack distance in meters */
+	f32 *acrosstrack;                         /* Acrosstrack distance in meters */
+	f32 *pointing_angle;                      /* Pointing angle from vertical in radians */
+	f32 *azimuth_angle;                       /* Azimuth angle in radians */
 } s7kr_bathymetry;
 
 /* Reson 7k Side Scan Data (record 7007) */
@@ -1215,7 +1456,8 @@ typedef struct s7kr_watercolumn_struct {
 	                        Bit 12-14: Beamforming flag
 	                        0 - Beam formed data
 	                        1 - Element data*/
-	s7k_wcd wcd[MBSYS_RESON7K_MAX_BEAMS]; /* Device configuration information */
+	u32 nalloc;          /* Number of beams allocated */
+	s7k_wcd *wcd;        /* Sample descriptors for each beam */
 	u32 optionaldata;    /* Optional data */
 	f32 frequency;       /* Ping frequency in Hz */
 	f64 latitude;        /* Latitude of vessel reference point in Radians -pi/2 to pi/2,
@@ -1223,9 +1465,9 @@ typedef struct s7kr_watercolumn_struct {
 	f64 longitude;       /* Longitude of vessel reference point in Radians -pi/2 to pi/2,
 	                        west negative */
 	f32 heading;         /* Heading of vessel at transmit time in radians */
-	f32 beam_alongtrack[MBSYS_RESON7K_MAX_BEAMS];   /* Along track distance in vessel grid in meters */
-	f32 beam_acrosstrack[MBSYS_RESON7K_MAX_BEAMS];  /* Across track distance in vessel grid in meters */
-	u32 center_sample[MBSYS_RESON7K_MAX_BEAMS];     /* Sample number at detection point of beam */
+	f32 *beam_alongtrack;  /* Along track distance in vessel grid in meters */
+	f32 *beam_acrosstrack; /* Across track distance in vessel grid in meters */
+	u32 *center_sample;    /* Sample number at detection point of beam */
 } s7kr_watercolumn;
 
 /* Reson 7k tvg data (record 7010) */
@@ -1354,13 +1596,14 @@ typedef struct s7kr_detectionsetup_struct {
 	f32 depth_gate_tilt;             /* Angle in radians (positive to starboard) */
 	f32 nadir_depth;                 /* Nadir depth used mb MB2 */
 	u32 reserved[13];                /* Reserved for future use */
-	u16 beam_descriptor[MBSYS_RESON7K_MAX_BEAMS];
+	u32 nalloc;                      /* Number of detection points allocated */
+	u16 *beam_descriptor;
 	                                   /* Beam number the detection is taken from */
-	f32 detection_point[MBSYS_RESON7K_MAX_BEAMS];
+	f32 *detection_point;
 	                                   /* Non-corrected fractional sample number with
 	                                      the reference to the receiver's acoustic center 
 	                                      with the zero sample at the transmit time */
-	u32 flags[MBSYS_RESON7K_MAX_BEAMS];
+	u32 *flags;
 	                                   /* Bit field:
 	                                      Bit 0: 1 = automatic limits valid
 	                                      Bit 1: 1 = User-defined limits valid
@@ -1375,19 +1618,19 @@ typedef struct s7kr_detectionsetup_struct {
 	                                      Bit 16-19: Detection priority number for detections
 	                                      within the same beam (Multi-detect only). Value zero is
 	                                      highest priority */
-	f32 auto_limits_min_sample[MBSYS_RESON7K_MAX_BEAMS];
+	f32 *auto_limits_min_sample;
 	                                      /* Minimum sample number for automatic limits */
-	f32 auto_limits_max_sample[MBSYS_RESON7K_MAX_BEAMS];
+	f32 *auto_limits_max_sample;
 	                                      /* Maximum sample number for automatic limits */
-	f32 user_limits_min_sample[MBSYS_RESON7K_MAX_BEAMS];
+	f32 *user_limits_min_sample;
 	                                      /* Minimum sample number for user-defined limits */
-	f32 user_limits_max_sample[MBSYS_RESON7K_MAX_BEAMS];
+	f32 *user_limits_max_sample;
 	                                      /* Maximum sample number for user-defined limits */
-	u32 quality[MBSYS_RESON7K_MAX_BEAMS]; /* Bit field:
+	u32 *quality;                         /* Bit field:
 	                                         Bit 0: 1 = Brightness filter passed
 	                                         Bit 1: 1 = Colinearity filter passed
 	                                         Bit 2-31: Reserved for future use */
-	f32 uncertainty[MBSYS_RESON7K_MAX_BEAMS];
+	f32 *uncertainty;
 	                                      /* Detection uncertainty represented as an error 
 	                                         normalized to the detection point */
 } s7kr_detectionsetup;
@@ -1412,7 +1655,8 @@ typedef struct s7kr_beamformed_struct {
 	u16 beams_number;    /* Total number of beams or elements in record */
 	u32 n;               /* Number of samples in each beam in this record */
 	u32 reserved[8];     /* Reserved for future use */
-	s7k_amplitudephase amplitudephase[MBSYS_RESON7K_MAX_BEAMS];
+	u32 nalloc;          /* Number of beams allocated */
+	s7k_amplitudephase *amplitudephase;
 	                     /* amplitude and phase data for each beam */
 } s7kr_beamformed;
 
@@ -1465,7 +1709,8 @@ typedef struct s7kr_vernierprocessingdataraw_struct {
 	                            normally -45 degrees (in radians) */
 	f32 elevation_coverage;  /* Normally 90 degrees (in radians) */
 	u32 reserved[4];         /* Reserved */
-	s7k_anglemagnitude anglemagnitude[MBSYS_RESON7K_MAX_BEAMS];
+	u32 nalloc;              /* Number of beams allocated */
+	s7k_anglemagnitude *anglemagnitude;
 	                         /* Angle and magnitude data for each beam plus 
 	                            additional records */
 } s7kr_vernierprocessingdataraw;
@@ -1562,7 +1807,6 @@ typedef struct s7kr_v38kwetendversion_struct {
 
 /* Reson 7k raw detection data (part of Record 7027) */
 typedef struct s7kr_rawdetectiondata_struct {
-	s7k_header header;
 	u16 beam_descriptor;             /* Beam number the detection is taken from */
 	f32 detection_point;             /* Non-corrected fractional sample number with
 	                                      the reference to the receiver's
@@ -1630,7 +1874,8 @@ typedef struct s7kr_rawdetection_struct {
 	f32 applied_roll;         /* Roll value (in radians) applied to gates; 
 	                             zero if roll stabilization is ON. */
 	u32 reserved[15];         /* Reserved */
-	s7k_rawdetectiondata rawdetectiondata[MBSYS_RESON7K_MAX_BEAMS];
+	u32 nalloc;               /* Number of detection points allocated */
+	s7k_rawdetectiondata *rawdetectiondata;
 	u32 optionaldata;                             /* Flag indicating if bathymetry calculated and
 	                                                 values below filled in
 	                                                    0 = No
@@ -1653,11 +1898,11 @@ typedef struct s7kr_rawdetection_struct {
 	f32 pitch;                                /* Pitch at transmit time */
 	f32 heave;                                /* Heave at transmit time in m*/
 	f32 vehicle_depth ;                       /* Vehicle depth at transmit time in m */
-	f32 depth[MBSYS_RESON7K_MAX_BEAMS];       /* Depth releative to chart datum in meters */
-	f32 alongtrack[MBSYS_RESON7K_MAX_BEAMS];  /* Alongtrack distance in meters */
-	f32 acrosstrack[MBSYS_RESON7K_MAX_BEAMS];    /* Acrosstrack distance in meters */
-	f32 pointing_angle[MBSYS_RESON7K_MAX_BEAMS]; /* Pointing angle from vertical in radians */
-	f32 azimuth_angle[MBSYS_RESON7K_MAX_BEAMS];  /* Azimuth angle in radians */
+	f32 *depth;                               /* Depth releative to chart datum in meters */
+	f32 *alongtrack;                          /* Alongtrack distance in meters */
+	f32 *acrosstrack;                         /* Acrosstrack distance in meters */
+	f32 *pointing_angle;                      /* Pointing angle from vertical in radians */
+	f32 *azimuth_angle;                       /* Azimuth angle in radians */
 } s7kr_rawdetection;
 
 /* Reson 7k snippet data (part of record 7028) */
@@ -1695,7 +1940,8 @@ typedef struct s7kr_snippet_struct {
 	                         Bit 0: 0 = 16 bit snippets
 	                         1 = 32 bit snippets */
 	u32 reserved[6];    /* Reserved for future use */
-	s7k_snippettimeseries snippettimeseries[MBSYS_RESON7K_MAX_BEAMS];
+	u32 nalloc;         /* Number of beams allocated */
+	s7k_snippettimeseries *snippettimeseries;
 	/* Snippet time series for each beam */
 	u32 optionaldata;    /* Optional data */
 	f32 frequency;       /* Ping frequency in Hz */
@@ -1704,14 +1950,13 @@ typedef struct s7kr_snippet_struct {
 	f64 longitude;       /* Longitude of vessel reference point in Radians -pi/2 to pi/2,
 	                        west negative */
 	f32 heading;         /* Heading of vessel at transmit time in radians */
-	f32 beam_alongtrack[MBSYS_RESON7K_MAX_BEAMS];   /* Along track distance in vessel grid in meters */
-	f32 beam_acrosstrack[MBSYS_RESON7K_MAX_BEAMS];  /* Across track distance in vessel grid in meters */
-	u32 center_sample[MBSYS_RESON7K_MAX_BEAMS];     /* Sample number at detection point of beam */
+	f32 *beam_alongtrack;  /* Along track distance in vessel grid in meters */
+	f32 *beam_acrosstrack; /* Across track distance in vessel grid in meters */
+	u32 *center_sample;    /* Sample number at detection point of beam */
 } s7kr_snippet;
 
 /* Reson 7k vernier Processing Data Filtered (part of record 7029) */
 typedef struct s7kr_vernierprocessingdatasoundings_struct {
-	s7k_header header;
 	f32 beam_angle;     /* Sounding horizontal angle (radians) */
 	u32 sample;         /* Sounding sample number (convert to range using sample
 	                         rate and sound velocity */
@@ -1732,7 +1977,8 @@ typedef struct s7kr_vernierprocessingdatafiltered_struct {
 	f32 min_angle;        /* Minimum elevation angle in all soundings (radians) */
 	f32 max_angle;        /* Maximum elevation angle in all soundings (radians) */
 	u16 repeat_size;      /* Size of sounding repeat blocks following (bytes) */
-	s7k_vernierprocessingdatasoundings vernierprocessingdatasoundings[MBSYS_RESON7K_MAX_BEAMS]
+	u32 nalloc;           /* Number of soundings allocated */
+	s7k_vernierprocessingdatasoundings *vernierprocessingdatasoundings;
 } s7kr_vernierprocessingdatafiltered;
 
 /* Reson 7k sonar installation parameters (record 7030) */
@@ -1798,7 +2044,6 @@ typedef struct s7kr_bitesummary_struct {
 
 /* Reson 7k Compressed Beamformed Magnitude Data (part of Record 7041) */
 typedef struct s7kr_beamformedmagnitude_struct {
-	s7k_header header;
 	u32 beam;          /* Identification for the beam */
 	u32 samples;       /* Total number of samples recorded ofr this beam */
 	u32 nalloc;        /* Bytes allocated to hold amplitude time series */
@@ -1831,24 +2076,24 @@ typedef struct s7kr_compressedbeamformedmagnitude_struct {
 	                         Bit 9-15: Reserved */
 	f32 sample_rate;   /* Sampling rate for the data */
 	u32 reserved;      /* Reserved */
-	s7k_beamformedmagnitude beamformedmagnitude[MBSYS_RESON7K_MAX_BEAMS];
+	u32 nalloc;        /* Number of beams allocated */
+	s7k_beamformedmagnitude *beamformedmagnitude;
 } s7kr_compressedbeamformedmagnitude;
 
 /* Reson 7k Compressed Water Column Data (part of Record 7042) */
 typedef struct s7kr_compressedwatercolumndata_struct {
-	s7k_header header;
 	u16 beam_number;    /* Beam Number for this data. */
 	u8 segment_number;  /* Segment number for this beam. Optional field, see ‘Bit 14’ of Flags. */
 	u32 samples;        /* Number of samples included for this beam. */
 	u32 nalloc;         /* Bytes allocated to hold the time series */
-	u64 *sample;        /* Each “Sample” may be one of the following, depending on the Flags bits:
+	u8 *sample;         /* Each “Sample” may be one of the following, depending on the Flags bits:
 	                       A) 16 bit Mag & 16bit Phase (32 bits total)
 	                       B) 16 bit Mag (16 bits total, no phase)
 	                       C) 8 bit Mag & 8 bit Phase (16 bits total)
 	                       D) 8 bit Mag (8 bits total, no phase)
 	                       E) 32 bit Mag & 8 bit Phase(40 bits total)
 	                       F) 32 bit Mag(32 bits total, no phase) */
-} s7kr_compressedwatercolumndata;
+} s7k_compressedwatercolumndata;
 
 /* Reson 7k Compressed Water Column Data (Record 7042) */
 typedef struct s7kr_compressedwatercolumn_struct {
@@ -1860,7 +2105,7 @@ typedef struct s7kr_compressedwatercolumn_struct {
 	                           >0 = sequence number of ping in the multi-ping sequence */
 	u16 number_beams;        /* Total number of beams in ping record */
 	u32 samples;             /*  */
-	u32 compressed-samples;  /* Number of samples (maximum over all beams if Flags bit 0 set 
+	u32 compressed_samples;  /* Number of samples (maximum over all beams if Flags bit 0 set 
 	                            [samples per beam varies]. Otherwise same as Samples(N) )
 	                            When all beams come with the same number of samples 
 	                            'Compressed Samples' is the same as 'Samples(N)' for each 
@@ -1902,15 +2147,15 @@ typedef struct s7kr_compressedwatercolumn_struct {
 	f32 sample_rate;         /* Effective sample rate after downsampling, if specified. */
 	f32 compression_factor;  /* Factor used in magnitude compression. */
 	u32 reserved;            /* Zero. Reserved for future use. */
-	s7k_compressedwatercolumndata compressedwatercolumndata
+	u32 nalloc;              /* Number of beams allocated */
+	s7k_compressedwatercolumndata *compressedwatercolumndata;
 } s7kr_compressedwatercolumn;
 
 /* Reson 7k Segmented Raw Detection Data (part of Record 7047) */
 typedef struct s7kr_segmentedrawdetectiondata_struct {
-	s7k_header header;    /* Number of the Segment descriptor */
-	u16 segment_number;   /* Applied transmitter along steering angle, in radians */
-	f32 tx_angle_along;   /* Applied transmitter across steering angle, in radians */
-	f32 tx_angle_across;  /* Transmit delay in seconds */
+	u16 segment_number;   /* Number of the Segment descriptor */
+	f32 tx_angle_along;   /* Applied transmitter along steering angle, in radians */
+	f32 tx_angle_across;  /* Applied transmitter across steering angle, in radians */
 	f32 tx_delay;         /* Transmit delay in seconds */
 	f32 frequency;        /* Hz */
 	u32 pulse_type;       /* BIT FIELD
@@ -2009,7 +2254,8 @@ typedef struct s7kr_segmentedrawdetection_struct {
 	f32 sound_velocity;      /* Sound velocity at the transducer in meters/second */
 	f32 rx_delay;            /* Delay between start of first Tx pulse and start of sample 
 	                            data recoding in fractional samples. */
-	s7k_segmentedrawdetectiondata segmentedrawdetectiondata;
+	u32 nalloc;              /* Number of Rx detection points allocated */
+	s7k_segmentedrawdetectiondata *segmentedrawdetectiondata;
 } s7kr_segmentedrawdetection;
 
 /* Reson 7k Calibrated Beam Data (Record 7048) */
@@ -2044,7 +2290,6 @@ typedef struct s7kr_calibratedbeam_struct {
 
 /* Reson 7k System Events (part of Record 7050) */
 typedef struct s7kr_systemeventsdata_struct {
-	s7k_header header;
 	u16 event_type;
 	u16 event_id;
 	u32 device_id;
@@ -2059,7 +2304,8 @@ typedef struct s7kr_systemevents_struct {
 	s7k_header header;
 	u64 serial_number;
 	u32 number_events;
-	s7k_systemeventsdata systemeventsdata;
+	u32 nalloc;             /* Number of events allocated */
+	s7k_systemeventsdata *systemeventsdata;
 } s7kr_systemevents;
 
 /* Reson 7k System Event Message (record 7051) */
@@ -2080,7 +2326,6 @@ typedef struct s7kr_systemeventmessage_struct {
 
 /* Reson 7k RDR Recording Status (part of Record 7052) */
 typedef struct s7kr_rdrrecordingstatusdata_struct {
-	s7k_header header;
 	u32 threshold_length;
 	u32 threshold_value_array;
 	u32 included_records;
@@ -2132,7 +2377,6 @@ typedef struct s7kr_rdrrecordingstatus_struct {
 
 /* Reson 7k Subscriptions (part of Record 7053) */
 typedef struct s7kr_subscriptionsdata_struct {
-	s7k_header header;
 	u32 address;           /* IP Address (little endian data order) */
 	u16 port;              /* Port number */
 	u16 type;              /* 0 - UPD; 1 - TCP */
@@ -2145,7 +2389,8 @@ typedef struct s7kr_subscriptionsdata_struct {
 typedef struct s7kr_subscriptions_struct {
 	s7k_header header;
 	i32 subscriptions; /* Number of subscriptions */
-	s7k_subscriptionsdata subscriptionsdata;
+	u32 nalloc;        /* Number of subscriptions allocated */
+	s7k_subscriptionsdata *subscriptionsdata;
 } s7kr_subscriptions;
 
 /* Reson 7k System Events (Record 7054) */
@@ -2269,7 +2514,6 @@ typedef struct s7kr_calibratedsidescan_struct {
 
 /* Reson 7k Snippet Backscattering Strength (part of Record 7058) */
 typedef struct s7kr_snippetbackscatteringstrengthdata_struct {
-	s7k_header header;
 	u16 beam_number;    /* Beam or element number */
 	u32 begin_sample;   /* First sample number in beam from transmitter and outward */
 	u32 bottom_sample;  /* Bottom detection point in beam from transmitter and outward */
@@ -2316,8 +2560,8 @@ typedef struct s7kr_snippetbackscatteringstrength_struct {
 	f32 absorption;     /* Absorption value in dB/km. Only valid when 
 	                       control flag bit 8 is set */
 	u32 reserved[6];  /* Reserved for future use */
-	s7k_snippetbackscatteringstrengthdata 
-	                     snippetbackscatteringstrengthdata[MBSYS_RESON7K_MAX_BEAMS];
+	u32 nalloc;         /* Number of beams allocated */
+	s7k_snippetbackscatteringstrengthdata *snippetbackscatteringstrengthdata;
 	/* Snippet time series for each beam */
 	u32 optionaldata;    /* Optional data */
 	f32 frequency;       /* Ping frequency in Hz */
@@ -2326,9 +2570,9 @@ typedef struct s7kr_snippetbackscatteringstrength_struct {
 	f64 longitude;       /* Longitude of vessel reference point in Radians -pi/2 to pi/2,
 	                        west negative */
 	f32 heading;         /* Heading of vessel at transmit time in radians */
-	f32 beam_alongtrack[MBSYS_RESON7K_MAX_BEAMS];   /* Along track distance in vessel grid in meters */
-	f32 beam_acrosstrack[MBSYS_RESON7K_MAX_BEAMS];  /* Across track distance in vessel grid in meters */
-	u32 center_sample[MBSYS_RESON7K_MAX_BEAMS];     /* Sample number at detection point of beam */
+	f32 *beam_alongtrack;  /* Along track distance in vessel grid in meters */
+	f32 *beam_acrosstrack; /* Across track distance in vessel grid in meters */
+	u32 *center_sample;    /* Sample number at detection point of beam */
 } s7kr_snippetbackscatteringstrength;
 
 /* Reson 7k MB2 Specific Status (Record 7059) */
@@ -2496,12 +2740,15 @@ typedef struct s7kr_fileheader_struct {
 	c8 recording_version[16];  /* Recording program version number - null terminated string */
 	c8 user_defined_name[64];  /* User defined name - null terminated string */
 	c8 notes[128];             /* Notes - null terminated string */
-	s7k_subsystem subsystem[MBSYS_RESON7K_MAX_DEVICE];
+	u32 nalloc;                /* Number of subsystems allocated */
+	s7kr_subsystem *subsystem; /* Subsystems of the devices */
+	u32 optionaldata;          /* Optional data */
+	u32 catalog_size;          /* Size of the file catalog record in bytes */
+	u64 catalog_offset;        /* File offset of the file catalog record */
 } s7kr_fileheader;
 
 /* Reson 7k File Catalog Record (part of Record 7300) */
 typedef struct s7kr_filecatalogrecorddata_struct {
-	s7k_header header;
 	u32 size;                   /* Record size in bytes */
 	u64 offset;                 /* File offset */
 	u16 record_type;            /* Record type identifier */
@@ -2520,7 +2767,8 @@ typedef struct s7kr_filecatalogrecord_struct {
 	u16 version;         /* 1 */
 	u32 records_n;       /* Number of records in the file */
 	u32 reserved;        /* Reserved */
-	s7k_filecatalogrecorddata filecatalogrecorddata;
+	u32 nalloc;          /* Number of records allocated */
+	s7kr_filecatalogrecorddata *filecatalogrecorddata;
 } s7kr_filecatalogrecord;
 
 /* Reson 7k Time Message (Record 7400) */
@@ -2993,6 +3241,241 @@ typedef struct s7kr_spreadingloss_struct {
 	f32 spreadingloss; /* dB (0 - 60) */
 } s7kr_spreadingloss;
 
+/* Raw record bytes as read (MB-System internal, not part of the format) */
+typedef struct s7k_rawrecord_struct {
+	int recordid; /* Record type of the bytes held, R7KRECID_None if empty */
+	int modified; /* MB_YES if the parsed record has been changed since it was read */
+	int size;     /* Number of bytes held, from sync pattern through checksum */
+	int nalloc;   /* Number of bytes allocated */
+	char *buffer; /* Record bytes */
+} s7k_rawrecord;
+
+/* Arrays of a shared payload replaced by copies while unsharing it
+   (MB-System internal, not part of the format) - the arrays replaced are
+   freed if every other store let go of them while they were copied */
+#define MBSYS_RESON7K_DUPLICATE_MAX (2 * MBSYS_RESON7K_MAX_RECEIVERS + 16)
+typedef struct s7k_duplicate_struct {
+	int status;                                /* MB_FAILURE if an array could not be copied */
+	int nshared;                               /* Number of arrays replaced */
+	void *shared[MBSYS_RESON7K_DUPLICATE_MAX]; /* Arrays replaced */
+} s7k_duplicate;
+
+/* Encoded ping record awaiting output (MB-System internal, not part of the format) */
+typedef struct s7k_encodebuffer_struct {
+	int recordid; /* Record type encoded, R7KRECID_None if passed through unchanged */
+	int status;   /* Status returned by the encoder */
+	int error;    /* Error returned by the encoder */
+	int size;     /* Number of bytes encoded */
+	int nalloc;   /* Number of bytes allocated */
+	char *buffer; /* Encoded record */
+} s7k_encodebuffer;
+
+/* Ping records being encoded for output (MB-System internal, not part of the format) */
+typedef struct s7k_encodeping_struct {
+	int nrecord;                                 /* Number of ping records to write */
+	int recordids[R7KRAW_Other];                 /* Record types in output order */
+	s7k_encodebuffer encodebuffer[R7KRAW_Other]; /* Encoded records, sized exactly before encoding */
+	u32 flags;                                   /* R7KWC_* compression of 7042 output */
+	int nbottom;                                 /* Number of beams allocated in bottom */
+	int *bottom;                                 /* Last sample kept in each beam of 7042 output */
+	int nsample;                                 /* Number of samples allocated in magnitude and phase */
+	unsigned short *magnitude;                   /* Downsampled magnitudes of one beam of 7042 output */
+	short *phase;                                /* Downsampled phases of one beam of 7042 output */
+} s7k_encodeping;
+
+/* Sidescan pixels made by mbsys_reson7k_makess() and
+   mbsys_reson7k_makess_hires() - held by the internal store of each mbio
+   handle and grown to the largest number of pixels made */
+typedef struct s7k_sidescangrid_struct {
+	int nalloc;             /* Number of pixels allocated */
+	int npixels;            /* Number of pixels made */
+	int source;             /* Record the sidescan was made from */
+	int inadir;             /* Beam closest to nadir */
+	double pixel_size;      /* Pixel size (m) */
+	double *ss;             /* Sidescan values */
+	double *ssacrosstrack;  /* Acrosstrack distances of the pixels (m) */
+	double *ssalongtrack;   /* Alongtrack distances of the pixels (m) */
+	int *ss_cnt;            /* Number of samples binned into each pixel */
+} s7k_sidescangrid;
+
+/* Columns of pings filled by mbsys_reson7k_extract_batch() - allocated by
+   the caller, with npingsalloc values in each ping column and
+   npingsalloc * nbeamsalloc values in each beam column, ping i holding
+   beams i * nbeamsalloc onwards. The optional columns are skipped if NULL.
+   The navigation and heading of survey pings are those given by calling
+   mbsys_reson7k_extract() on each ping in turn */
+typedef struct s7k_pingbatch_struct {
+	int npingsalloc;         /* Number of pings allocated */
+	int nbeamsalloc;         /* Number of beams allocated for each ping */
+	int npings;              /* Number of pings filled */
+	int *kind;               /* Data kind of each record */
+	double *time_d;          /* Ping times (epoch seconds) */
+	double *navlon;          /* Longitudes (degrees) */
+	double *navlat;          /* Latitudes (degrees) */
+	double *speed;           /* Speeds (km/hr) */
+	double *heading;         /* Headings (degrees) */
+	int *nbath;              /* Number of beams of each ping */
+	char *beamflag;          /* Beam flags */
+	double *bath;            /* Depths (m) */
+	double *bathacrosstrack; /* Acrosstrack distances (m) */
+	double *bathalongtrack;  /* Alongtrack distances (m) */
+	double *amp;             /* Amplitudes (dB) */
+	double *ttimes;          /* Optional two way travel times (seconds) */
+	int *detects;            /* Optional detection types */
+	double *uncertainty;     /* Optional detection uncertainties */
+	double *transmit_gain;   /* Optional transmit power of each ping (dB) */
+	double *pulse_length;    /* Optional pulse length of each ping (usec) */
+	double *receive_gain;    /* Optional receive gain of each ping (dB) */
+} s7k_pingbatch;
+
+/* Columnar sounding export being written (MB-System internal) - survey
+   pings are extracted into the batch until a chunk is full, and the index
+   of the chunks written is held for the footer */
+typedef struct s7k_columnar_struct {
+	FILE *fp;               /* Export file */
+	u64 offset;             /* Number of bytes written */
+	int nbeamsalloc;        /* Beams per ping */
+	int chunk_pings;        /* Pings per chunk */
+	int nthreads;           /* Threads extracting and encoding */
+	s7k_pingbatch batch;    /* Columns of the chunk being filled */
+	void **ping_ptrs;       /* Survey pings listed for extraction */
+	int nchunk;             /* Number of chunks written */
+	int nchunkalloc;        /* Number of chunks allocated in the index */
+	u64 *chunk_offset;      /* File offset of each chunk */
+	int *chunk_npings;      /* Number of pings in each chunk */
+	u64 *column_offset;     /* File offset of each column of each chunk */
+	u64 *column_size;       /* Size of each column of each chunk */
+	int *column_nvalues;    /* Number of values in the statistics */
+	double *column_min;     /* Minimum value of each column of each chunk */
+	double *column_max;     /* Maximum value of each column of each chunk */
+	size_t nbufferalloc;    /* Number of bytes allocated to buffer */
+	char *buffer;           /* Encoded chunk */
+} s7k_columnar;
+
+/* Per-beam scratch arrays used in sidescan generation - held by the
+   internal store of each mbio handle and grown to the largest ping seen */
+typedef struct s7k_makessscratch_struct {
+	int nalloc;                 /* Number of beams allocated */
+	double *bathsort;           /* Depths of good beams for the median */
+	char *beamflag;             /* Beam flags derived from the quality values */
+	double *rangetable;         /* Travel times of good beams */
+	double *acrosstracktable;   /* Acrosstrack distances of good beams */
+	double *alongtracktable;    /* Alongtrack distances of good beams */
+	int footvalid;              /* MB_YES if the footprint table is current */
+	u32 foothash;               /* Hash of the beam angles of the table */
+	int footnbeams;             /* Number of beams in the table */
+	double *footcos;            /* Cosines of the acrosstrack beam angles */
+	double *footsint;           /* Absolute sines of the acrosstrack beam angles */
+	s7k_sidescangrid grid;      /* Pixels of the MB-System sidescan */
+	s7k_sidescangrid hiresgrid; /* Pixels of the high resolution sidescan */
+	int nthreadalloc;           /* Number of thread histogram pixels allocated */
+	double *threadss;           /* Sidescan sums of threads after the first */
+	double *threadssalongtrack; /* Alongtrack sums of threads after the first */
+	int *threadsscnt;           /* Sample counts of threads after the first */
+	int nlistalloc;             /* Number of listed samples allocated */
+	int *listpixel;             /* Pixels of samples listed by threads */
+	double *listamplitude;      /* Amplitudes of samples listed by threads */
+	double *listalongtrack;     /* Alongtrack distances of listed samples */
+} s7k_makessscratch;
+
+/* Scratch arrays for per beam attitude interpolation and beam angle
+   calculation (MB-System internal) */
+typedef struct s7k_beamattitude_struct {
+	int nalloc;          /* Number of beams allocated */
+	double *time_d;      /* Bottom return times of the beams (epoch seconds) */
+	int *index;          /* Sample preceding each time in the series interpolated */
+	int *beamid;         /* Bathymetry beam number of each detection */
+	double *weight;      /* Weight of the following sample for each time */
+	double *roll;        /* Roll at each time (degrees) */
+	double *pitch;       /* Pitch at each time (degrees) */
+	double *heave;       /* Heave at each time (meters) */
+	double *heading;     /* Heading at each time (degrees) */
+	double *tx_steer;    /* Transmit steering angle of each beam (degrees) */
+	double *rx_steer;    /* Receive steering angle of each beam (degrees) */
+	double *range;       /* Two way travel time of each beam (seconds) */
+	double *azimuth;     /* Beam azimuth relative to the reference heading (degrees) */
+	double *depression;  /* Beam depression below horizontal (degrees) */
+	double *acrosstrack; /* Acrosstrack distance from the sonar (meters) */
+	double *alongtrack;  /* Alongtrack distance from the sonar (meters) */
+	double *depth;       /* Depth below the sonar (meters) */
+} s7k_beamattitude;
+
+/* Scratch arrays for the attitude series of one record, and for the
+   heading interpolated at the attitude times of a time window
+   (MB-System internal) */
+typedef struct s7k_attitudeseries_struct {
+	int nalloc;      /* Number of samples allocated */
+	double *time_d;  /* Sample times (epoch seconds) */
+	double *roll;    /* Roll (degrees) */
+	double *pitch;   /* Pitch (degrees) */
+	double *heave;   /* Heave (meters) */
+	double *heading; /* Heading (degrees) */
+	int *index;      /* Heading sample preceding each time */
+	double *weight;  /* Weight of the following heading sample */
+} s7k_attitudeseries;
+
+/* Ancillary time series (MB-System internal) - samples are appended in time
+   order into a ring buffer whose oldest sample is overwritten once nmax are
+   held, and the bracket found by the last lookup is kept so that lookups at
+   increasing times cost only a few comparisons each */
+typedef struct s7k_tseries_struct {
+	int nfield;                                  /* Number of values per sample */
+	int field[MBSYS_RESON7K_TSERIES_FIELDS];     /* Interpolation of each value */
+	int nmax;                                    /* Maximum number of samples held */
+	int nalloc;                                  /* Number of samples allocated */
+	int n;                                       /* Number of samples held */
+	int head;                                    /* Ring position of the oldest sample */
+	int cursor;                                  /* Start of the last bracket, counted from the oldest sample */
+	double *time_d;                              /* Sample times (epoch seconds) */
+	double *value[MBSYS_RESON7K_TSERIES_FIELDS]; /* Sample values */
+	double *source;                              /* Time array the series was last loaded from */
+	int nsource;                                 /* Number of samples in that array */
+	int ndropped;                                /* Samples not later than the last held, so not added */
+	int shared;                                  /* If MB_YES the arrays belong to another series and
+	                                                are only read */
+} s7k_tseries;
+
+/* Ray tracing table for an SVP (MB-System internal) - for each takeoff
+   angle of a grid the one way travel time, horizontal distance and depth
+   below the transducer at each layer boundary of the profile */
+typedef struct s7k_raytable_struct {
+	int valid;         /* MB_YES if the table holds the SVP described below */
+	u32 svp_hash;      /* Hash of the SVP depths and sound velocities */
+	int svp_n;         /* Number of SVP samples */
+	double soundspeed; /* Sound speed at the transducer (m/s) */
+	double draft;      /* Transducer depth (meters) */
+	int nangle;        /* Number of takeoff angles, 0 to 90 degrees */
+	int nlayer;        /* Number of layer boundaries traced for each angle */
+	int nalloc;        /* Number of table entries allocated */
+	int *nvalid;       /* Number of boundaries reached by each angle */
+	double *time;      /* One way travel time to each boundary (seconds) */
+	double *xx;        /* Horizontal distance at each boundary (meters) */
+	double *zz;        /* Depth below the transducer of each boundary (meters) */
+	double *speed;     /* Sound speed of the layer below each boundary (m/s) */
+} s7k_raytable;
+
+/* File catalog bookkeeping while writing (MB-System internal, not part of the format) */
+typedef struct s7k_filecatalogwrite_struct {
+	u64 offset;            /* Number of bytes written to the output file */
+	u64 fileheader_offset; /* File offset of the first 7200 record written */
+	int fileheader_size;   /* Size of the first 7200 record written, 0 if none */
+	int fileheader_nalloc; /* Number of bytes allocated to fileheader */
+	char *fileheader;      /* Bytes of the first 7200 record written */
+} s7k_filecatalogwrite;
+
+/* Record index of an input file (MB-System internal) - the records in file
+   order with the latest time of any record up to each, so that the first
+   record at or after a time can be found by bisection */
+typedef struct s7k_fileindex_struct {
+	int source;       /* MBSYS_RESON7K_FILEINDEX_* */
+	int n;            /* Number of records indexed */
+	int nalloc;       /* Number of records allocated */
+	u64 *offset;      /* File offset of each record */
+	int *recordid;    /* Record type identifier of each record */
+	double *time_d;   /* Time of each record (epoch seconds) */
+	double *time_max; /* Latest time of the records up to each one (epoch seconds) */
+} s7k_fileindex;
+
 /* internal data structure */
 struct mbsys_reson7k_struct {
 	/* Type of data record */
@@ -3004,21 +3487,7 @@ struct mbsys_reson7k_struct {
 
 	/* ping record id's */
 	int current_ping_number;
-	int read_volatilesettings;
-	int read_matchfilter;
-	int read_beamgeometry;
-	int read_remotecontrolsettings;
-	int read_bathymetry;
-	int read_sidescan;
-	int read_tvg;
-	int read_image;
-	int read_pingmotion;
-	int read_detectionsetup;
-	int read_beamformed;
-	int read_rawdetection;
-	int read_snippet;
-	int read_calibratedsidescan;
-	int read_snippetbackscatteringstrength;
+	u32 read_mask; /* R7KREAD_* bits of the ping records read */
 
 	/* MB-System time stamp */
 	double time_d;
@@ -3169,8 +3638,8 @@ struct mbsys_reson7k_struct {
 	/* Reson 7k Calibrated Beam Data (Record 7048) */
 	s7kr_calibratedbeam calibratedbeam;
 
-	/* Reson 7k System Events (part of Record 7050) */
-	s7kr_systemeventsdata systemeventsdata;
+	/* Reson 7k System Events (Record 7050) */
+	s7kr_systemevents systemevents;
 
 	/* Reson 7k system event (record 7051) */
 	s7kr_systemeventmessage systemeventmessage;
@@ -3235,6 +3704,85 @@ struct mbsys_reson7k_struct {
 	/* Reson 7k Spreading Loss (record 7612) */
 	s7kr_spreadingloss spreadingloss;
 
+	/* Raw record pass-through - ping records indexed by R7KRAW_*,
+	    the last non-ping record read in R7KRAW_Other */
+	s7k_rawrecord rawrecord[R7KRAW_NUM];
+
+	/* Reference counts of payloads shared with copies of this store,
+	    indexed by R7KSHARE_* - NULL while this store holds the only
+	    reference to the arrays of a payload. The counts are atomic since
+	    stores sharing a payload may be held by different threads */
+	atomic_int *sharecount[R7KSHARE_NUM];
+
+	/* File catalog bookkeeping for the output file - the records written
+	    are listed in filecatalogrecord and emitted as a 7300 record on close */
+	s7k_filecatalogwrite filecatalogwrite;
+
+	/* Record index of the input file and the time window being read - if
+	    window is MB_YES pings before window_start are skipped and the first
+	    ping after window_end ends the file */
+	s7k_fileindex fileindex;
+	int window;
+	double window_start;
+	double window_end;
+
+	/* Ping completion rule on input - if nonzero, a ping is returned once
+	    the R7KREAD_* records of this mask are read; if zero, the default,
+	    a ping ends when the next ping begins (see mbsys_reson7k_set_pingcomplete) */
+	u32 pingcomplete_mask;
+
+	/* Water column compression on output - if set, 7018 beamformed data
+	    are written as 7042 compressed water column using the R7KWC_* flags */
+	int compresswatercolumn;
+	u32 compresswatercolumn_flags;
+
+	/* Ping records encoded before being written in order - the buffers of
+	    encodeping are sized exactly on the calling thread, and the records
+	    of a ping are then encoded by up to encode_threads threads if built
+	    with MBR_RESON7KR_PTHREADS. If writequeue_depth is nonzero the pings
+	    written are instead handed to the queue in writequeue, encoded there
+	    by a pool of encode_threads threads while the caller carries on, and
+	    written to the file in order (see mbsys_reson7k_set_writequeue) */
+	int encode_threads;
+	s7k_encodeping encodeping;
+	int writequeue_depth;
+	void *writequeue;
+
+	/* Beam angles calculated in preprocessing by up to preprocess_threads
+	    threads if built with MBSYS_RESON7K_PTHREADS, with mb_beaudoin() for
+	    each beam unless built with MBSYS_RESON7K_BATCH_GEOMETRY - if preprocess_makess
+	    is MB_NO the sidescan is not regenerated, and the source it would
+	    have been made from is left in makess_source of the ping for the
+	    stage that writes the pings in order */
+	int preprocess_threads;
+	int preprocess_makess;
+	int makess_source;
+
+	/* Ray tracing through the SVP in preprocessing - if set, bathymetry is
+	    calculated from the ray table of the current SVP instead of along
+	    straight rays, and the table is rebuilt only when the SVP changes */
+	int raytrace;
+	s7k_raytable raytable;
+
+	/* Sidescan generation - snippets are binned by up to makess_threads
+	    threads if built with MBSYS_RESON7K_PTHREADS, and if makess_deterministic
+	    is set the result is exactly that of a single thread */
+	int makess_threads;
+	int makess_deterministic;
+	s7k_makessscratch makessscratch;
+
+	/* Scratch arrays for per beam attitude interpolation in preprocessing */
+	s7k_beamattitude beamattitude;
+
+	/* Scratch arrays for attitude series appended to the interpolation
+	    buffers of the mbio descriptor one record at a time */
+	s7k_attitudeseries attitudeseries;
+
+	/* Ancillary time series appended by the reader, and loaded from the
+	    series passed to mbsys_reson7k_preprocess() */
+	s7k_tseries tseries[MBSYS_RESON7K_TSERIES_NUM];
+	s7k_tseries tseries_preprocess[MBSYS_RESON7K_TSERIES_NUM];
+
 	/* record counting variables */
 	int nrec_read;
 	int nrec_write;
@@ -3323,12 +3871,19 @@ int mbsys_reson7k_heading_alloc(int verbose, void *mbio_ptr, void *store_ptr, in
 int mbsys_reson7k_ssv_alloc(int verbose, void *mbio_ptr, void *store_ptr, int *error);
 int mbsys_reson7k_tlt_alloc(int verbose, void *mbio_ptr, void *store_ptr, int *error);
 int mbsys_reson7k_deall(int verbose, void *mbio_ptr, void **store_ptr, int *error);
+int mbsys_reson7k_initstore(int verbose, void *store_ptr, int *error);
+int mbsys_reson7k_zerostore(int verbose, void *store_ptr, int keeparrays, int *error);
+int mbsys_reson7k_resetstore(int verbose, void *store_ptr, int *error);
+int mbsys_reson7k_freestore(int verbose, void **store_ptr, int *error);
+int mbsys_reson7k_set_storepool(int verbose, int npool, int *error);
+int mbsys_reson7k_free_storepool(int verbose, int *error);
 int mbsys_reson7k_zero_ss(int verbose, void *store_ptr, int *error);
 int mbsys_reson7k_dimensions(int verbose, void *mbio_ptr, void *store_ptr, int *kind, int *nbath, int *namp, int *nss,
                              int *error);
 int mbsys_reson7k_pingnumber(int verbose, void *mbio_ptr, int *pingnumber, int *error);
 int mbsys_reson7k_sonartype(int verbose, void *mbio_ptr, void *store_ptr, int *sonartype, int *error);
 int mbsys_reson7k_sidescantype(int verbose, void *mbio_ptr, void *store_ptr, int *ss_type, int *error);
+int mbsys_reson7k_preprocess_tseries(int verbose, void *mbio_ptr, void *preprocess_pars_ptr, int *error);
 int mbsys_reson7k_preprocess(int verbose, void *mbio_ptr, void *store_ptr, void *platform_ptr, void *preprocess_pars_ptr,
                              int *error);
 int mbsys_reson7k_extract_platform(int verbose, void *mbio_ptr, void *store_ptr, int *kind, void **platform_ptr, int *error);
@@ -3346,6 +3901,13 @@ int mbsys_reson7k_ttimes(int verbose, void *mbio_ptr, void *store_ptr, int *kind
 int mbsys_reson7k_detects(int verbose, void *mbio_ptr, void *store_ptr, int *kind, int *nbeams, int *detects, int *error);
 int mbsys_reson7k_gains(int verbose, void *mbio_ptr, void *store_ptr, int *kind, double *transmit_gain, double *pulse_length,
                         double *receive_gain, int *error);
+int mbsys_reson7k_extract_batch(int verbose, void *mbio_ptr, int npings, void **store_ptrs, int nthreads, s7k_pingbatch *batch,
+                                int *error);
+int mbsys_reson7k_columnar_open(int verbose, char *path, int nbeamsalloc, int chunk_pings, int nthreads, void **columnar_ptr,
+                                int *error);
+int mbsys_reson7k_columnar_write(int verbose, void *mbio_ptr, void *columnar_ptr, int npings, void **store_ptrs, int *error);
+int mbsys_reson7k_columnar_flush(int verbose, void *columnar_ptr, int *error);
+int mbsys_reson7k_columnar_close(int verbose, void **columnar_ptr, int *error);
 int mbsys_reson7k_extract_altitude(int verbose, void *mbio_ptr, void *store_ptr, int *kind, double *transducer_depth,
                                    double *altitude, int *error);
 int mbsys_reson7k_extract_nav(int verbose, void *mbio_ptr, void *store_ptr, int *kind, int time_i[7], double *time_d,
@@ -3354,6 +3916,29 @@ int mbsys_reson7k_extract_nav(int verbose, void *mbio_ptr, void *store_ptr, int
 int mbsys_reson7k_extract_nnav(int verbose, void *mbio_ptr, void *store_ptr, int nmax, int *kind, int *n, int *time_i,
                                double *time_d, double *navlon, double *navlat, double *speed, double *heading, double *draft,
                                double *roll, double *pitch, double *heave, int *error);
+int mbsys_reson7k_extract_attitude(int verbose, void *mbio_ptr, void *store_ptr, int *kind, int nmax, int *n, int *fieldmask,
+                                   double *time_d, double *roll, double *pitch, double *heave, double *heading, int *error);
+int mbsys_reson7k_extract_attitude_window(int verbose, void *mbio_ptr, double time_start, double time_end, int nmax, int *n,
+                                          double *time_d, double *roll, double *pitch, double *heave, double *heading,
+                                          int *error);
+int mbsys_reson7k_attitude_append(int verbose, void *mbio_ptr, int n, int fieldmask, double *time_d, double *roll,
+                                  double *pitch, double *heave, double *heading, int *error);
+int mbsys_reson7k_attitude_append_record(int verbose, void *mbio_ptr, void *store_ptr, int *error);
+int mbsys_reson7k_alloc_attitudeseries(int verbose, s7k_attitudeseries *attitudeseries, int n, int *error);
+int mbsys_reson7k_tseries_setup(int verbose, s7k_tseries *tseries, int id, int *error);
+int mbsys_reson7k_tseries_free(int verbose, s7k_tseries *tseries, int *error);
+int mbsys_reson7k_tseries_append(int verbose, s7k_tseries *tseries, int n, double *time_d, double **values, int *error);
+int mbsys_reson7k_tseries_share(int verbose, s7k_tseries *tseries, s7k_tseries *source_tseries, int *error);
+int mbsys_reson7k_tseries_add(int verbose, void *mbio_ptr, int id, double time_d, double value0, double value1, double value2,
+                              int *error);
+int mbsys_reson7k_tseries_load(int verbose, s7k_tseries *tseries, int n, double *time_d, double *value0, double *value1,
+                               double *value2, int *error);
+int mbsys_reson7k_tseries_locate(s7k_tseries *tseries, double time_d);
+int mbsys_reson7k_tseries_interp(int verbose, s7k_tseries *tseries, double time_d, double *values, int *error);
+int mbsys_reson7k_tseries_speed(int verbose, s7k_tseries *tseries, double time_d, double *speed, int *error);
+int mbsys_reson7k_tseries_nav(int verbose, s7k_tseries *tseries, double time_d, double heading, double speed, double *navlon,
+                              double *navlat, double *speed_out, int *error);
+int mbsys_reson7k_alloc_fileindex(int verbose, s7k_fileindex *fileindex, int n, int *error);
 int mbsys_reson7k_insert_nav(int verbose, void *mbio_ptr, void *store_ptr, int time_i[7], double time_d, double navlon,
                              double navlat, double speed, double heading, double draft, double roll, double pitch, double heave,
                              int *error);
@@ -3375,6 +3960,57 @@ int mbsys_reson7k_copy(int verbose, void *mbio_ptr, void *store_ptr, void *copy_
 int mbsys_reson7k_checkheader(s7k_header header);
 int mbsys_reson7k_makess(int verbose, void *mbio_ptr, void *store_ptr, int source, int pixel_size_set, double *pixel_size,
                          int swath_width_set, double *swath_width, int pixel_int, int *error);
+int mbsys_reson7k_makess_grid(int verbose, void *mbio_ptr, void *store_ptr, int source, int hires, int pixel_size_set,
+                              double *pixel_size, int swath_width_set, double *swath_width, int pixel_int, s7k_sidescangrid *grid,
+                              int *error);
+int mbsys_reson7k_makess_hires(int verbose, void *mbio_ptr, void *store_ptr, int source, double *pixel_size,
+                               double *swath_width, int pixel_int, int *npixels, double **ss, double **ssacrosstrack,
+                               double **ssalongtrack, int *error);
+int mbsys_reson7k_free_sidescangrid(int verbose, s7k_sidescangrid *grid, int *error);
+int mbsys_reson7k_set_makessthreads(int verbose, void *mbio_ptr, int nthreads, int deterministic, int *error);
+int mbsys_reson7k_rawrecord_index(int recordid);
+int mbsys_reson7k_rawrecord_id(int index);
+u32 mbsys_reson7k_pingcomplete_mask(int deviceid);
+int mbsys_reson7k_set_pingcomplete(int verbose, void *mbio_ptr, unsigned int mask, int *error);
+int mbsys_reson7k_interp_bracket(int nd, double *xd, int n, double *xs, int *jd, int *index, double *weight);
+double mbsys_reson7k_select(double *values, int n, int k);
+int mbsys_reson7k_alloc_beamattitude(int verbose, s7k_beamattitude *beamattitude, int nbeams, int *error);
+int mbsys_reson7k_interp_beamattitude(int verbose, void *preprocess_pars_ptr, int nbeams, s7k_beamattitude *beamattitude,
+                                      int *jattitude, int *jheading, int *error);
+int mbsys_reson7k_beam_geometry(int verbose, mb_3D_orientation tx_align, mb_3D_orientation tx_orientation,
+                                mb_3D_orientation rx_align, double reference_heading, double soundspeed, int nbeams,
+                                int nthreads, s7k_beamattitude *beamattitude, int *error);
+int mbsys_reson7k_beam_geometry_check(int verbose, mb_3D_orientation tx_align, mb_3D_orientation tx_orientation,
+                                      mb_3D_orientation rx_align, double reference_heading, int nbeams,
+                                      s7k_beamattitude *beamattitude, int *mismatch, double *diffmax, int *error);
+int mbsys_reson7k_set_preprocessthreads(int verbose, void *mbio_ptr, int nthreads, int *error);
+int mbsys_reson7k_raytable_update(int verbose, s7k_raytable *raytable, s7kr_svp *svp, double soundspeed, double draft,
+                                  int *error);
+int mbsys_reson7k_raytable_lookup(s7k_raytable *raytable, double angle, double traveltime, double *xx, double *zz);
+int mbsys_reson7k_set_raytrace(int verbose, void *mbio_ptr, int raytrace, int *error);
+int mbsys_reson7k_swap_ping(int verbose, void *store_ptr, void *other_ptr, int *error);
+
+/* Ancillary only first pass over an input file (in mbr_reson7k3.c) */
+int mbr_reson7kr_scan_ancillary(int verbose, void *mbio_ptr, void *preprocess_pars_ptr, int *nrecord, int *error);
+int mbsys_reson7k_preprocess_pipeline(int verbose, void *imbio_ptr, void *ombio_ptr, void *platform_ptr,
+                                      void *preprocess_pars_ptr, int nworkers, int *nread, int *nwritten, int *error);
+int mbsys_reson7k_rawrecord_save(int verbose, void *store_ptr, int recordid, char *buffer, int size, int *error);
+int mbsys_reson7k_rawrecord_modified(int verbose, void *store_ptr, int recordid, int *error);
+int mbsys_reson7k_set_compresswatercolumn(int verbose, void *mbio_ptr, int compress, unsigned int flags, int *error);
+int mbsys_reson7k_set_encodethreads(int verbose, void *mbio_ptr, int nthreads, int *error);
+int mbsys_reson7k_set_writequeue(int verbose, void *mbio_ptr, int depth, int *error);
+int mbsys_reson7k_free_encodeping(int verbose, s7k_encodeping *encodeping, int *error);
+int mbsys_reson7k_alloc_beamgeometry(int verbose, s7kr_beamgeometry *beamgeometry, int nbeams, int *error);
+int mbsys_reson7k_alloc_bathymetry(int verbose, s7kr_bathymetry *bathymetry, int nbeams, int *error);
+int mbsys_reson7k_storesize(int verbose, void *store_ptr, size_t *size, size_t *resident, int *error);
+int mbsys_reson7k_share_payload(int verbose, void *store_ptr, void *copy_ptr, int payload, int *error);
+int mbsys_reson7k_unshare_payload(int verbose, void *store_ptr, int payload, int preserve, int *error);
+int mbsys_reson7k_release_payload(int verbose, void *store_ptr, int payload, int *error);
+int mbsys_reson7k_clear_payload(int verbose, void *store_ptr, int payload, int freearrays, int *error);
+int mbsys_reson7k_clear_array(int verbose, int freearray, void **array, int *error);
+int mbsys_reson7k_duplicate_array(int verbose, size_t size, void **array, s7k_duplicate *duplicate, int *error);
+int mbsys_reson7k_carry_records(int verbose, void *store_ptr, void *copy_ptr, int *error);
+int mbsys_reson7k_carry_array(int verbose, size_t size, void *array, void **copy, int *error);
 int mbsys_reson7k_print_header(int verbose, s7k_header *header, int *error);
 int mbsys_reson7k_print_reference(int verbose, s7kr_reference *reference, int *error);
 int mbsys_reson7k_print_sensoruncal(int verbose, s7kr_sensoruncal *sensoruncal, int *error);